@@ -0,0 +1,14 @@
+struct FragmentInput {
+  @location(0) color: vec4<f32>
+}
+
+struct FragmentOutput {
+  @location(0) ldr_out_color: vec4<f32>
+}
+
+@stage(fragment)
+fn main(frag: FragmentInput) -> FragmentOutput {
+  var out: FragmentOutput;
+  out.ldr_out_color = vec4<f32>(frag.color.rgb, 1.);
+  return out;
+}
@@ -0,0 +1,89 @@
+// Immediate mode debug primitives (see render::DebugDrawList) - every
+//  primitive is a line list expanded from its instance data here, so there is
+//  no geometry vertex buffer. Each entry point has its own pipeline.
+
+struct VertexOutput {
+  @builtin(position) frag_coord: vec4<f32>,
+  @location(0) color: vec4<f32>
+}
+
+struct CameraParamsUbo {
+  mat_view: mat4x4<f32>,
+  mat_proj: mat4x4<f32>
+}
+
+@group(0) @binding(0) var<uniform> cameraParams: CameraParamsUbo;
+
+fn to_clip(world_pos: vec3<f32>) -> vec4<f32> {
+  return cameraParams.mat_proj * cameraParams.mat_view * vec4<f32>(world_pos, 1.);
+}
+
+//
+// Lines - 2 vertices per instance
+//
+struct LineInstance {
+  @location(0) start: vec3<f32>,
+  @location(1) end: vec3<f32>,
+  @location(2) color: vec4<f32>
+}
+
+@stage(vertex)
+fn line_main(@builtin(vertex_index) vertex_index: u32, line: LineInstance) -> VertexOutput {
+  var out: VertexOutput;
+  out.frag_coord = to_clip(select(line.start, line.end, vertex_index == 1u));
+  out.color = line.color;
+  return out;
+}
+
+//
+// Circles in the XZ plane - 2 vertices per segment, 32 segments per instance
+//  (DebugDrawList::kCircleSegments)
+//
+struct CircleInstance {
+  @location(0) center: vec3<f32>,
+  @location(1) radius: f32,
+  @location(2) color: vec4<f32>
+}
+
+@stage(vertex)
+fn circle_main(@builtin(vertex_index) vertex_index: u32, circle: CircleInstance) -> VertexOutput {
+  let point = vertex_index / 2u + vertex_index % 2u;
+  let angle = f32(point) * 6.28318530718 / 32.;
+
+  var out: VertexOutput;
+  out.frag_coord = to_clip(circle.center + vec3<f32>(cos(angle), 0., sin(angle)) * circle.radius);
+  out.color = circle.color;
+  return out;
+}
+
+//
+// Axis aligned wireframe boxes - 12 edges, 2 vertices per edge
+//
+struct BoxInstance {
+  @location(0) center: vec3<f32>,
+  @location(1) half_extents: vec3<f32>,
+  @location(2) color: vec4<f32>
+}
+
+@stage(vertex)
+fn box_main(@builtin(vertex_index) vertex_index: u32, box: BoxInstance) -> VertexOutput {
+  // Edges 0-3 run along X, 4-7 along Y, 8-11 along Z - the edge index within
+  //  its group picks the corner on the other two axes
+  let edge = vertex_index / 2u;
+  let axis = edge / 4u;
+  let a = f32(edge & 1u) * 2. - 1.;
+  let b = f32((edge >> 1u) & 1u) * 2. - 1.;
+  let t = f32(vertex_index % 2u) * 2. - 1.;
+
+  var corner = vec3<f32>(a, b, t);
+  if (axis == 0u) {
+    corner = vec3<f32>(t, a, b);
+  } else if (axis == 1u) {
+    corner = vec3<f32>(a, t, b);
+  }
+
+  var out: VertexOutput;
+  out.frag_coord = to_clip(box.center + corner * box.half_extents);
+  out.color = box.color;
+  return out;
+}
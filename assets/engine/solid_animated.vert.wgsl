@@ -6,7 +6,8 @@ struct VertexInput {
   @location(4) mat_world_2: vec4<f32>,
   @location(5) mat_world_3: vec4<f32>,
   @location(6) bone_weights: vec4<f32>,
-  @location(7) bone_indices: vec4<u32>
+  @location(7) bone_indices: vec4<u32>,
+  @location(8) skin_palette_offset: u32
 }
 
 struct VertexOutput {
@@ -40,12 +41,21 @@ struct CameraParamsUbo {
   mat_proj: mat4x4<f32>
 }
 
-struct SkinMatricesUbo {
-  data: array<mat4x4<f32>, 80>
+// Top three rows of an affine skin matrix (the last is always 0, 0, 0, 1)
+struct SkinMatrix {
+  row_0: vec4<f32>,
+  row_1: vec4<f32>,
+  row_2: vec4<f32>
+}
+
+// Every animated instance's skin matrices for this frame - bone indices are
+//  relative to the instance's skin_palette_offset
+struct SkinPalette {
+  data: array<SkinMatrix>
 }
 
 @group(0) binding(0) var<uniform> cameraParams: CameraParamsUbo;
-@group(3) binding(0) var<uniform> skinMatrices: SkinMatricesUbo;
+@group(3) binding(0) var<storage, read> skinPalette: SkinPalette;
 
 @stage(vertex)
 fn main(vertex: VertexInput) -> VertexOutput {
@@ -57,11 +67,20 @@ fn main(vertex: VertexInput) -> VertexOutput {
     vertex.mat_world_2,
     vertex.mat_world_3);
 
-  let skin_transform: mat4x4<f32> =
-    vertex.bone_weights.x * skinMatrices.data[vertex.bone_indices.x] +
-    vertex.bone_weights.y * skinMatrices.data[vertex.bone_indices.y] +
-    vertex.bone_weights.z * skinMatrices.data[vertex.bone_indices.z] +
-    vertex.bone_weights.w * skinMatrices.data[vertex.bone_indices.w];
+  let bone_indices = vertex.bone_indices + vec4<u32>(vertex.skin_palette_offset);
+  let w = vertex.bone_weights;
+  let s0 = skinPalette.data[bone_indices.x];
+  let s1 = skinPalette.data[bone_indices.y];
+  let s2 = skinPalette.data[bone_indices.z];
+  let s3 = skinPalette.data[bone_indices.w];
+
+  let row_0 = w.x * s0.row_0 + w.y * s1.row_0 + w.z * s2.row_0 + w.w * s3.row_0;
+  let row_1 = w.x * s0.row_1 + w.y * s1.row_1 + w.z * s2.row_1 + w.w * s3.row_1;
+  let row_2 = w.x * s0.row_2 + w.y * s1.row_2 + w.z * s2.row_2 + w.w * s3.row_2;
+
+  // Rows in, so build the transpose and flip it back to column major
+  let skin_transform: mat4x4<f32> = transpose(mat4x4<f32>(
+    row_0, row_1, row_2, vec4<f32>(0., 0., 0., 1.)));
   
   out.world_pos = (mat_world * skin_transform * vec4<f32>(vertex.position, 1.)).xyz;
   out.world_normal = (mat_world * skin_transform *
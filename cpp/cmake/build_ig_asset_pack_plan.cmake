@@ -46,6 +46,11 @@ function (build_ig_asset_pack_plan)
   foreach (TARGET_OUTFILE IN LISTS BIGPP_TARGET_OUTPUT_FILES)
     get_filename_component(out_abs "${tool_output_directory}/${TARGET_OUTFILE}" ABSOLUTE)
     list(APPEND target_outputs "${out_abs}")
+
+    # Indexed copy of each pack, written next to it (see igasset/indexed_igpack.h)
+    get_filename_component(out_dir "${out_abs}" DIRECTORY)
+    get_filename_component(out_name "${out_abs}" NAME_WLE)
+    list(APPEND target_byproducts "${out_dir}/${out_name}.igpack2")
   endforeach ()
 
   foreach (TARGET_INFILE IN LISTS BIGPP_INFILES)
@@ -55,6 +60,7 @@ function (build_ig_asset_pack_plan)
 
   add_custom_command(
     OUTPUT ${target_outputs}
+    BYPRODUCTS ${target_byproducts}
     COMMAND igpack-gen --input_asset_path_root=${tool_input_directory}
                        --output_asset_path_root=${tool_output_directory}
                        --input_plan_file=${plan_abs}
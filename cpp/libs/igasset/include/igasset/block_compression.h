@@ -0,0 +1,58 @@
+#ifndef LIB_IGASSET_BLOCK_COMPRESSION_H
+#define LIB_IGASSET_BLOCK_COMPRESSION_H
+
+/**
+ * BC1 / BC3 (a.k.a. DXT1 / DXT5) texture block encoding and decoding.
+ *
+ * Both formats store 4x4 texel blocks: BC1 as two RGB565 endpoints plus 2-bit
+ *  indices (8 bytes), BC3 as a BC1 color block plus a separate 8-bit alpha
+ *  block with two endpoints and 3-bit indices (16 bytes).
+ *
+ * Encoding is offline (igpack-gen) - endpoints are fit along the principal
+ *  axis of each block's colors. Decoding is the CPU fallback for devices that
+ *  cannot sample BC textures directly.
+ */
+
+#include <igasset/image_data.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace indigo::asset {
+
+enum class BlockFormat {
+  BC1_RGB,
+  BC3_RGBA,
+};
+
+class BlockCompression {
+ public:
+  static constexpr uint32_t kBlockDim = 4u;
+
+  static uint32_t bytes_per_block(BlockFormat format);
+  static uint32_t blocks_across(uint32_t texels) {
+    return (texels + kBlockDim - 1u) / kBlockDim;
+  }
+  static size_t encoded_size(BlockFormat format, uint32_t width,
+                             uint32_t height);
+
+  static void encode_bc1_block(const RgbaPixel texels[16], uint8_t* out);
+  static void encode_bc3_block(const RgbaPixel texels[16], uint8_t* out);
+  static void decode_bc1_block(const uint8_t* block, RgbaPixel texels[16]);
+  static void decode_bc3_block(const uint8_t* block, RgbaPixel texels[16]);
+
+  /**
+   * Encode a whole image, blocks in row-major order. Partial blocks along the
+   *  right/bottom edges repeat the edge texels.
+   */
+  static void encode_image(BlockFormat format, const RgbaPixel* pixels,
+                           uint32_t width, uint32_t height, uint8_t* out);
+
+  /** Decode a whole image encoded by encode_image (or any BC1/BC3 data) */
+  static void decode_image(BlockFormat format, const uint8_t* blocks,
+                           uint32_t width, uint32_t height, RgbaPixel* out);
+};
+
+}  // namespace indigo::asset
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef LIB_IGASSET_COMPRESSED_TEXTURE_H
+#define LIB_IGASSET_COMPRESSED_TEXTURE_H
+
+/**
+ * CompressedTexture - read side of a CompressedTextureDef asset (see
+ *  CompressedTextureEncoder).
+ *
+ * Each mip level is BC1/BC3 block data laid out the way a GPU texture upload
+ *  expects it (rows of blocks, see CompressedMip), so devices that support BC
+ *  formats upload it as-is. transcode_to_rgba is the CPU fallback for the
+ *  ones that do not.
+ *
+ * Like RawMesh, uncompressed textures point into the asset's payload, and LZ4
+ *  textures are decompressed once into a single buffer.
+ */
+
+#include <igasset/block_compression.h>
+#include <igasset/image_data.h>
+#include <igasset/indexed_igpack.h>
+#include <igcore/either.h>
+#include <igcore/raw_buffer.h>
+
+#include <memory>
+#include <string>
+
+namespace indigo::asset {
+
+enum class CompressedTextureResult {
+  Ok = 0,
+  WrongAssetType,
+  DecompressFailed,
+  SizeMismatch,
+  BadMipLevel,
+};
+std::string to_string(CompressedTextureResult rsl);
+
+struct CompressedMip {
+  // Logical size of the mip level, in texels
+  uint32_t Width;
+  uint32_t Height;
+
+  uint32_t BlocksWide;
+  uint32_t BlocksHigh;
+  uint32_t BytesPerRow;
+
+  const uint8_t* Data;
+  size_t Size;
+};
+
+class CompressedTexture {
+ public:
+  /** "asset" must hold a CompressedTextureDef - it is kept alive */
+  static core::Either<std::shared_ptr<const CompressedTexture>,
+                      CompressedTextureResult>
+  Create(std::shared_ptr<const IgpackAsset> asset);
+
+  //
+  // Mip chain layout helpers (shared with CompressedTextureEncoder)
+  //
+  static uint32_t mip_extent(uint32_t base_extent, uint32_t mip_level);
+  static uint32_t full_mip_count(uint32_t width, uint32_t height);
+  static size_t mip_chain_size(BlockFormat format, uint32_t width,
+                               uint32_t height, uint32_t mip_count);
+
+  BlockFormat format() const { return format_; }
+  bool is_srgb() const;
+  uint32_t width() const;
+  uint32_t height() const;
+  uint32_t mip_count() const;
+
+  /** True if the block data points into the asset payload */
+  bool is_zero_copy() const { return decompressed_.size() == 0u; }
+
+  /** Total bytes of block data across all mips (what stays resident) */
+  size_t data_size() const { return data_size_; }
+
+  CompressedMip mip(uint32_t mip_level) const;
+
+  /** CPU decode of one mip level - fallback for devices without BC support */
+  core::Either<RgbaImage, CompressedTextureResult> transcode_to_rgba(
+      uint32_t mip_level) const;
+
+  CompressedTexture(std::shared_ptr<const IgpackAsset> asset,
+                    core::RawBuffer decompressed, const uint8_t* data,
+                    size_t data_size);
+
+ private:
+  std::shared_ptr<const IgpackAsset> asset_;
+  core::RawBuffer decompressed_;
+
+  BlockFormat format_;
+  const uint8_t* data_;
+  size_t data_size_;
+};
+
+}  // namespace indigo::asset
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef LIB_IGASSET_COMPRESSED_TEXTURE_ENCODER_H
+#define LIB_IGASSET_COMPRESSED_TEXTURE_ENCODER_H
+
+#include <igasset/image_data.h>
+#include <igasset/proto/igasset.pb.h>
+#include <igcore/either.h>
+
+/**
+ * CompressedTextureEncoder - bakes an RGBA8 image into a CompressedTextureDef:
+ *  mip chain generation, BC1/BC3 block encoding (see BlockCompression) and LZ4
+ *  supercompression over the block data.
+ *
+ * Mips are a 2x2 box filter, done in linear space for sRGB textures. The base
+ *  level must be a multiple of 4 texels on each side (a WebGPU requirement for
+ *  BC textures) - smaller mip levels are padded to whole blocks.
+ */
+
+namespace indigo::asset {
+
+enum class CompressedTextureEncoderResult {
+  Ok = 0,
+  NoData,
+  NotBlockAligned,
+};
+
+class CompressedTextureEncoder {
+ public:
+  struct EncodeSettings {
+    EncodeSettings();
+
+    // Pick BC3 if any texel is not fully opaque, BC1 otherwise. If false,
+    //  "Format" is used as given.
+    bool AutoFormat;
+    pb::CompressedTextureDef::Format Format;
+
+    bool IsSrgb;
+    bool GenerateMips;
+
+    pb::CompressedTextureDef::Supercompression Supercompression;
+  };
+
+ public:
+  static core::Either<pb::CompressedTextureDef, CompressedTextureEncoderResult>
+  encode(const RgbaImage& image, EncodeSettings settings = EncodeSettings());
+
+  /** Next mip level down (half size, rounding down) - exposed for testing */
+  static RgbaImage downsample(const RgbaImage& image, bool is_srgb);
+};
+
+}  // namespace indigo::asset
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef LIB_IGASSET_DECODED_ASSET_CACHE_H
+#define LIB_IGASSET_DECODED_ASSET_CACHE_H
+
+/**
+ * DecodedAssetCache - persistent on-disk cache of decoded asset data (Draco
+ *  vertex/index arrays, PNG pixels), so that native clients only pay for
+ *  decoding an asset the first time they see it.
+ *
+ * Entries are content addressed: the key is a hash of the encoded asset bytes,
+ *  the asset name and the version of the decoder that produced the entry, so
+ *  rebuilt packs and decoder changes miss instead of serving stale data. Each
+ *  entry is one file in the cache directory, memory mapped when read.
+ *
+ * The directory is kept under a size budget by evicting the least recently
+ *  used entries - reading an entry bumps its file modification time, so
+ *  recency survives between runs.
+ *
+ * Web builds cannot map files, so every read misses - don't create one there.
+ */
+
+#include <igcore/maybe.h>
+#include <igplatform/mapped_file.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace indigo::asset {
+
+struct DecodedAssetKey {
+  // See DecodedAssetCache::content_hash
+  uint64_t ContentHash;
+  std::string AssetName;
+  uint32_t DecoderVersion;
+};
+
+struct DecodedAssetCacheHeader {
+  char Magic[4];
+  uint32_t Version;
+  uint32_t DecoderVersion;
+  uint32_t NameSize;
+  uint64_t ContentHash;
+  uint64_t PayloadOffset;
+  uint64_t PayloadSize;
+};
+static_assert(sizeof(DecodedAssetCacheHeader) == 40);
+
+class DecodedAssetCache {
+ public:
+  static constexpr char kMagic[4] = {'I', 'G', 'D', 'C'};
+  static constexpr uint32_t kVersion = 1u;
+  static constexpr uint64_t kBlobAlignment = 16u;
+  static constexpr const char* kFileExtension = ".igdc";
+
+  /** Cached data, pointing into a mapped cache file that it keeps alive */
+  struct Entry {
+    std::shared_ptr<const core::MappedFile> File;
+    const uint8_t* Data;
+    size_t Size;
+  };
+
+  /**
+   * Open (creating if needed) the cache in "directory", and evict entries
+   *  until it fits in "max_size_bytes". Returns nullptr if the directory
+   *  cannot be created.
+   */
+  static std::shared_ptr<DecodedAssetCache> Create(std::string directory,
+                                                   uint64_t max_size_bytes);
+
+  /** 64-bit hash of encoded asset bytes - fast, stable, not cryptographic */
+  static uint64_t content_hash(const uint8_t* data, size_t size);
+
+  /** Empty on a miss, or if the entry on disk is malformed */
+  core::Maybe<Entry> read(const DecodedAssetKey& key);
+
+  /**
+   * Store decoded data for "key", replacing any existing entry. Safe to call
+   *  from any thread - entries bigger than the whole budget are not stored.
+   */
+  bool write(const DecodedAssetKey& key, const uint8_t* data, size_t size);
+
+  uint64_t size_bytes() const;
+  uint64_t max_size_bytes() const { return max_size_bytes_; }
+  size_t entry_count() const;
+
+  DecodedAssetCache(std::filesystem::path directory, uint64_t max_size_bytes);
+
+ private:
+  struct TrackedFile {
+    std::string FileName;
+    uint64_t Size;
+  };
+
+  std::string file_name_for(const DecodedAssetKey& key) const;
+
+  // mut_ must be held for all of these
+  void scan_directory_locked();
+  void touch_locked(const std::string& file_name);
+  void track_locked(const std::string& file_name, uint64_t size);
+  void evict_locked();
+
+  std::filesystem::path directory_;
+  uint64_t max_size_bytes_;
+
+  mutable std::mutex mut_;
+
+  // Least recently used first
+  std::list<TrackedFile> lru_;
+  std::unordered_map<std::string, std::list<TrackedFile>::iterator> files_;
+  uint64_t size_bytes_;
+};
+
+}  // namespace indigo::asset
+
+#endif
@@ -9,6 +9,9 @@
 #include <igcore/vector.h>
 #include <ozz/animation/runtime/skeleton.h>
 
+#include <memory>
+#include <string>
+
 namespace indigo::asset {
 enum class DracoDecoderResult {
   Ok = 0,
@@ -53,8 +56,62 @@ class DracoDecoder {
   core::Either<core::PodVector<uint32_t>, DracoDecoderResult> get_index_data()
       const;
 
+  //
+  // Direct decode - write vertex data straight into caller-owned memory (e.g.
+  //  an interleaved staging buffer for a GPU upload), "stride" bytes apart.
+  //  "dest" points at the first vertex's field, and must have room for
+  //  num_vertices() of them (num_indices() for index data).
+  //
+  uint32_t num_vertices() const;
+  uint32_t num_indices() const;
+
+  DracoDecoderResult write_pos_norm_data(
+      void* dest, size_t stride = sizeof(PositionNormalVertexData)) const;
+
+  DracoDecoderResult write_texcoord_data(
+      void* dest, size_t stride = sizeof(TexcoordVertexData)) const;
+
+  DracoDecoderResult write_skeletal_animation_vertices(
+      const ozz::animation::Skeleton& ozz_skeleton, void* dest,
+      size_t stride = sizeof(SkeletalAnimationVertexData)) const;
+
+  DracoDecoderResult write_index_data(uint32_t* dest) const;
+
+  //
+  // Decoded form - the vertex/index arrays that the methods above produce,
+  //  stored in a single blob (e.g. in a DecodedAssetCache) so that a later
+  //  run can skip the Draco decode. Bone data is not included, add it with
+  //  add_bone_data as usual. Bump kDecodedVersion whenever the blob layout or
+  //  the decoded output changes.
+  //
+  static constexpr uint32_t kDecodedVersion = 1u;
+
+  std::string serialize_decoded() const;
+
+  /** "data" is not copied - "owner" must keep it alive */
+  DracoDecoderResult load_decoded(std::shared_ptr<const void> owner,
+                                  const uint8_t* data, size_t size);
+
  private:
+  struct DecodedArrays {
+    std::shared_ptr<const void> Owner;
+    uint32_t NumVertices;
+    uint32_t NumIndices;
+
+    // Null if the source mesh did not have that attribute
+    const PositionNormalVertexData* PosNorm;
+    const TexcoordVertexData* Texcoords;
+    const SkeletalAnimationVertexData* Skin;
+    const uint32_t* Indices;
+  };
+
+  // Bone weights and (un-mapped) Draco bone indices
+  DracoDecoderResult write_skin_data(void* dest, size_t stride) const;
+
+  // Exactly one of these is set once something has been decoded or loaded
   std::unique_ptr<draco::Mesh> mesh_;
+  std::unique_ptr<DecodedArrays> decoded_;
+
   int num_bones_;
   indigo::core::Vector<BoneData> bone_data_;
 };
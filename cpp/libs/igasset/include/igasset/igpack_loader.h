@@ -4,18 +4,37 @@
 /**
  * Igpack loader - loads an Indigo asset pack, and exposes other promises that
  * can be used to extract individual assets from it.
+ *
+ * Native builds memory map the indexed (*.igpack2) pack next to the requested
+ * igpack file if there is one, and only read the assets that are extracted.
+ * Otherwise (web builds, packs generated by older tools) the whole protobuf
+ * pack is read and parsed up front.
+ *
+ * In streaming mode, the loader reads the indexed pack's table of contents
+ * first and then fetches assets one byte range at a time, in priority order.
+ * Each extract_* promise resolves as soon as its own asset has arrived, instead
+ * of waiting on the whole pack.
+ *
+ * With a DecodedAssetCache attached, Draco geometry and PNG images are decoded
+ * once and then served out of the (memory mapped) cache on later runs.
  */
 
+#include <igasset/compressed_texture.h>
+#include <igasset/decoded_asset_cache.h>
 #include <igasset/draco_decoder.h>
 #include <igasset/image_data.h>
+#include <igasset/indexed_igpack.h>
+#include <igasset/raw_mesh.h>
 #include <igasset/proto/igasset.pb.h>
 #include <igasync/promise.h>
 #include <igcore/either.h>
 #include <igcore/raw_buffer.h>
 #include <ignav/detour_navmesh.h>
+#include <igplatform/ranged_file_reader.h>
 #include <ozz/animation/runtime/animation.h>
 #include <ozz/animation/runtime/skeleton.h>
 
+#include <map>
 #include <string>
 
 namespace indigo::asset {
@@ -31,10 +50,51 @@ class IgpackLoader {
   };
 
  public:
+  /** Either pack format - indexed packs are copied out of "raw_data" */
   IgpackLoader(const core::RawBuffer& raw_data);
   IgpackLoader(std::string file_name,
                std::shared_ptr<core::TaskList> file_load_task_list);
 
+  struct StreamingParams {
+    // Per-asset read priority (lower is read first), overriding the default
+    //  for the asset's type (see default_stream_priority)
+    std::map<std::string, int32_t> PriorityHints;
+
+    // Reader for the indexed pack - defaults to the platform reader for the
+    //  *.igpack2 file next to "file_name"
+    std::shared_ptr<core::RangedFileReader> Reader;
+
+    // Asset byte ranges requested at once
+    uint32_t MaxReadsInFlight = 4u;
+  };
+
+  /**
+   * Streaming mode - falls back to loading the whole protobuf pack at
+   *  "file_name" if the indexed pack cannot be read
+   */
+  IgpackLoader(std::string file_name,
+               std::shared_ptr<core::TaskList> file_load_task_list,
+               StreamingParams streaming_params);
+
+  /**
+   * Serve decoded Draco geometry and PNG images out of "cache" where it has
+   *  them, and store anything that does get decoded. Only applies to extract
+   *  calls made after this is set.
+   */
+  void set_decoded_asset_cache(std::shared_ptr<DecodedAssetCache> cache);
+
+  /** Shaders, then geometry/textures/navmeshes, then skeletons, then clips */
+  static int32_t default_stream_priority(pb::SingleAsset::AssetCase asset_type);
+
+  // Raw asset (still encoded) - keeps the bytes it points into alive
+  typedef core::Either<std::shared_ptr<const IgpackAsset>, IgpackExtractError>
+      ExtractRawAssetT;
+  typedef std::shared_ptr<core::Promise<ExtractRawAssetT>>
+      ExtractRawAssetPromiseT;
+  ExtractRawAssetPromiseT extract_raw_asset(
+      std::string asset_name,
+      std::shared_ptr<core::TaskList> extract_task_list) const;
+
   // Draco Geo
   typedef core::Either<std::shared_ptr<DracoDecoder>, IgpackExtractError>
       ExtractDracoBufferT;
@@ -44,6 +104,26 @@ class IgpackLoader {
       std::string asset_name,
       std::shared_ptr<core::TaskList> extract_task_list) const;
 
+  // Raw (pre-baked) mesh - zero-copy when the pack stores it uncompressed
+  typedef core::Either<std::shared_ptr<const RawMesh>, IgpackExtractError>
+      ExtractRawMeshT;
+  typedef std::shared_ptr<core::Promise<ExtractRawMeshT>>
+      ExtractRawMeshPromiseT;
+  ExtractRawMeshPromiseT extract_raw_mesh(
+      std::string asset_name,
+      std::shared_ptr<core::TaskList> extract_task_list) const;
+
+  // Block-compressed texture - mips are ready for upload as-is, or can be
+  //  transcoded to RGBA8 on the CPU (see CompressedTexture)
+  typedef core::Either<std::shared_ptr<const CompressedTexture>,
+                       IgpackExtractError>
+      ExtractCompressedTextureT;
+  typedef std::shared_ptr<core::Promise<ExtractCompressedTextureT>>
+      ExtractCompressedTexturePromiseT;
+  ExtractCompressedTexturePromiseT extract_compressed_texture(
+      std::string asset_name,
+      std::shared_ptr<core::TaskList> extract_task_list) const;
+
   // WGSL Source
   typedef core::Either<pb::WgslSource, IgpackExtractError> ExtractWgslShaderT;
   typedef std::shared_ptr<core::Promise<ExtractWgslShaderT>>
@@ -52,6 +132,15 @@ class IgpackLoader {
       std::string asset_name,
       std::shared_ptr<core::TaskList> extract_task_list) const;
 
+  // Terrain chunk layout - chunk bounds and the geo asset name of each LOD
+  typedef core::Either<pb::TerrainChunksDef, IgpackExtractError>
+      ExtractTerrainChunksDefT;
+  typedef std::shared_ptr<core::Promise<ExtractTerrainChunksDefT>>
+      ExtractTerrainChunksDefPromiseT;
+  ExtractTerrainChunksDefPromiseT extract_terrain_chunks_def(
+      std::string asset_name,
+      std::shared_ptr<core::TaskList> extract_task_list) const;
+
   // RGB Image
   typedef core::Either<RgbaImage, IgpackExtractError> ExtractRgbaImageDataT;
   typedef std::shared_ptr<core::Promise<ExtractRgbaImageDataT>>
@@ -88,9 +177,22 @@ class IgpackLoader {
       std::shared_ptr<core::TaskList> extract_task_list) const;
 
  private:
-  std::shared_ptr<
-      core::Promise<core::Either<pb::AssetPack, IgpackExtractError>>>
-      file_promise_;
+  class PackContents;
+  typedef core::Either<std::shared_ptr<const PackContents>, IgpackExtractError>
+      PackContentsT;
+
+  class StreamingState;
+
+  static std::shared_ptr<core::Promise<PackContentsT>> load_whole_pack(
+      std::string file_name, std::shared_ptr<core::TaskList> task_list);
+  static ExtractRawAssetT find_raw_asset(const PackContentsT& rsl,
+                                         const std::string& asset_name);
+
+  // Exactly one of these is set, depending on the load mode
+  std::shared_ptr<core::Promise<PackContentsT>> file_promise_;
+  std::shared_ptr<StreamingState> streaming_state_;
+
+  std::shared_ptr<DecodedAssetCache> decoded_asset_cache_;
 
   mutable std::map<std::string, ExtractWgslShaderPromiseT> wgsl_promises_;
 };
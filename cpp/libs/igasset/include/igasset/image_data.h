@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <string>
+#include <string_view>
 
 namespace indigo::asset {
 
@@ -23,7 +24,7 @@ struct GreyscaleImage {
   uint32_t Height;
 
   static core::Either<GreyscaleImage, ParseError> ParsePNG(
-      const std::string& raw_png_data);
+      std::string_view raw_png_data);
 };
 
 struct RgbPixel {
@@ -35,7 +36,7 @@ struct RgbImage {
   uint32_t Height;
 
   static core::Either<RgbImage, ParseError> ParsePNG(
-      const std::string& raw_png_data);
+      std::string_view raw_png_data);
 };
 
 struct RgbaPixel {
@@ -47,7 +48,7 @@ struct RgbaImage {
   uint32_t Height;
 
   static core::Either<RgbaImage, ParseError> ParsePNG(
-      const std::string& raw_png_data);
+      std::string_view raw_png_data);
 };
 
 }  // namespace indigo::asset
@@ -0,0 +1,131 @@
+#ifndef LIB_IGASSET_INDEXED_IGPACK_H
+#define LIB_IGASSET_INDEXED_IGPACK_H
+
+/**
+ * Indexed (v2) asset pack container.
+ *
+ * Same assets as a protobuf AssetPack, laid out so that a single asset can be
+ *  found and read without touching the rest of the file:
+ *
+ *  [Header][Table of contents][Name strings][Blobs...]
+ *
+ * The table of contents is sorted by asset name (binary searched on lookup).
+ *  Every asset has two 16-byte aligned blobs - a small serialized SingleAsset
+ *  with its bulk data field cleared ("meta"), and the bulk data itself
+ *  ("payload": Draco bytes, PNG bytes, Ozz archive, Detour data, raw mesh
+ *  data, texture blocks). Payloads are used in place, without a copy into a
+ *  protobuf message.
+ *
+ * All integers are little-endian.
+ */
+
+#include <igasset/proto/igasset.pb.h>
+#include <igcore/maybe.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace indigo::asset {
+
+struct IndexedIgpackHeader {
+  char Magic[4];
+  uint32_t Version;
+  uint32_t EntryCount;
+  uint32_t Reserved;
+  uint64_t StringTableOffset;
+  uint64_t StringTableSize;
+};
+static_assert(sizeof(IndexedIgpackHeader) == 32);
+
+struct IndexedIgpackTocEntry {
+  uint64_t MetaOffset;
+  uint64_t PayloadOffset;
+  uint64_t PayloadSize;
+  uint32_t NameOffset;
+  uint32_t NameSize;
+  uint32_t MetaSize;
+
+  // pb::SingleAsset::AssetCase
+  uint32_t AssetType;
+};
+static_assert(sizeof(IndexedIgpackTocEntry) == 40);
+
+/**
+ * Single asset read out of either pack format - "payload" is the asset's bulk
+ *  data, use it instead of the corresponding field of "asset()" (which is
+ *  empty for assets read from an indexed pack)
+ */
+class IgpackAsset {
+ public:
+  /** Asset held in an in-memory AssetPack - must outlive the IgpackAsset */
+  static IgpackAsset FromProto(const pb::SingleAsset& asset);
+
+  IgpackAsset(pb::SingleAsset meta, const uint8_t* payload,
+              size_t payload_size);
+
+  const pb::SingleAsset& asset() const;
+  const uint8_t* payload() const { return payload_; }
+  size_t payload_size() const { return payload_size_; }
+  std::string_view payload_view() const;
+
+ private:
+  IgpackAsset(const pb::SingleAsset* external_asset, const uint8_t* payload,
+              size_t payload_size);
+
+  const pb::SingleAsset* external_asset_;
+  pb::SingleAsset meta_;
+  const uint8_t* payload_;
+  size_t payload_size_;
+};
+
+class IndexedIgpack {
+ public:
+  static constexpr char kMagic[4] = {'I', 'G', 'P', '2'};
+  static constexpr uint32_t kVersion = 2u;
+  static constexpr uint64_t kBlobAlignment = 16u;
+
+  /** Indexed packs are written next to the protobuf pack they mirror */
+  static constexpr const char* kFileExtension = ".igpack2";
+  static std::string IndexedPathFor(const std::string& igpack_path);
+
+  static bool HasIndexedHeader(const uint8_t* data, size_t size);
+
+  /** Encode an asset pack in the indexed layout */
+  static std::string Serialize(const pb::AssetPack& asset_pack);
+
+  /**
+   * Validate the header and table of contents of an indexed pack (bounds, and
+   *  that entries are sorted by name). "data" is not copied - "owner" must
+   *  keep it alive (e.g. a core::MappedFile).
+   */
+  static core::Maybe<std::shared_ptr<IndexedIgpack>> Open(
+      std::shared_ptr<const void> owner, const uint8_t* data, size_t size);
+
+  uint32_t asset_count() const { return header_->EntryCount; }
+  std::string_view asset_name(uint32_t idx) const;
+
+  /** Table of contents entry for an asset, or nullptr if there is none */
+  const IndexedIgpackTocEntry* find_entry(std::string_view asset_name) const;
+
+  /** Decode an asset's metadata - empty if the meta blob is malformed */
+  core::Maybe<IgpackAsset> read_asset(const IndexedIgpackTocEntry& entry) const;
+
+  IndexedIgpack(std::shared_ptr<const void> owner, const uint8_t* data,
+                size_t size);
+
+ private:
+  std::shared_ptr<const void> owner_;
+  const uint8_t* data_;
+  size_t size_;
+
+  const IndexedIgpackHeader* header_;
+  const IndexedIgpackTocEntry* toc_;
+  const char* names_;
+};
+
+}  // namespace indigo::asset
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef LIB_IGASSET_RAW_MESH_H
+#define LIB_IGASSET_RAW_MESH_H
+
+/**
+ * RawMesh - read side of a RawMeshDef asset (see RawMeshEncoder).
+ *
+ * Vertex and index arrays are already in the layouts in vertex_formats.h, so
+ *  they can be handed straight to a GPU buffer upload. Uncompressed meshes
+ *  point into the asset's payload (e.g. the memory mapped pack) with no copy
+ *  at all, and LZ4 meshes are decompressed once into a single buffer.
+ */
+
+#include <igasset/indexed_igpack.h>
+#include <igasset/vertex_formats.h>
+#include <igcore/either.h>
+#include <igcore/pod_vector.h>
+#include <igcore/raw_buffer.h>
+#include <ozz/animation/runtime/skeleton.h>
+
+#include <memory>
+#include <string>
+
+namespace indigo::asset {
+
+enum class RawMeshResult {
+  Ok = 0,
+  WrongAssetType,
+  DecompressFailed,
+  SizeMismatch,
+  NoData,
+  BoneDataIncomplete,
+};
+std::string to_string(RawMeshResult rsl);
+
+class RawMesh {
+ public:
+  /** "asset" must hold a RawMeshDef - it is kept alive by the RawMesh */
+  static core::Either<std::shared_ptr<const RawMesh>, RawMeshResult> Create(
+      std::shared_ptr<const IgpackAsset> asset);
+
+  uint32_t num_vertices() const { return vertex_count_; }
+  uint32_t num_indices() const { return index_count_; }
+
+  /** True if the vertex/index arrays point into the asset payload */
+  bool is_zero_copy() const { return decompressed_.size() == 0u; }
+
+  const PositionNormalVertexData* pos_norm_data() const { return pos_norm_; }
+
+  /** nullptr if the mesh has no texcoords */
+  const TexcoordVertexData* texcoord_data() const { return texcoords_; }
+
+  /**
+   * nullptr if the mesh has no bone data. Bone indices are mesh bone indices
+   *  (into the asset's ozz_bone_names) - use get_skeletal_animation_vertices
+   *  to get indices into an Ozz skeleton.
+   */
+  const SkeletalAnimationVertexData* skeletal_animation_data() const {
+    return skeletal_;
+  }
+
+  const uint32_t* index_data() const { return indices_; }
+
+  //
+  // Skinning data remapped to an Ozz skeleton - same as DracoDecoder
+  //
+  RawMeshResult write_skeletal_animation_vertices(
+      const ozz::animation::Skeleton& ozz_skeleton, void* dest,
+      size_t stride = sizeof(SkeletalAnimationVertexData)) const;
+
+  core::Either<core::PodVector<SkeletalAnimationVertexData>, RawMeshResult>
+  get_skeletal_animation_vertices(
+      const ozz::animation::Skeleton& ozz_skeleton) const;
+
+  core::Either<core::PodVector<glm::mat4>, RawMeshResult> get_inv_bind_poses(
+      const ozz::animation::Skeleton& ozz_skeleton) const;
+
+  RawMesh(std::shared_ptr<const IgpackAsset> asset,
+          core::RawBuffer decompressed, const uint8_t* data);
+
+ private:
+  std::shared_ptr<const IgpackAsset> asset_;
+  core::RawBuffer decompressed_;
+
+  uint32_t vertex_count_;
+  uint32_t index_count_;
+  const PositionNormalVertexData* pos_norm_;
+  const TexcoordVertexData* texcoords_;
+  const SkeletalAnimationVertexData* skeletal_;
+  const uint32_t* indices_;
+};
+
+}  // namespace indigo::asset
+
+#endif
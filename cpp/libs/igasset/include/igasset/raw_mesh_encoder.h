@@ -0,0 +1,73 @@
+#ifndef LIB_IGASSET_RAW_MESH_ENCODER_H
+#define LIB_IGASSET_RAW_MESH_ENCODER_H
+
+#include <igasset/proto/igasset.pb.h>
+#include <igasset/vertex_formats.h>
+#include <igcore/either.h>
+#include <igcore/pod_vector.h>
+
+#include <vector>
+
+/**
+ * RawMeshEncoder - bakes a collection of vertices into a RawMeshDef, which
+ *  is stored in the same layouts the renderer uploads (see RawMesh).
+ *
+ * Same inputs as DracoEncoder. Bone data (names / inverse bind poses) is not
+ *  handled here - fill those fields of the output in the same way as for a
+ *  DracoGeometryDef.
+ */
+
+namespace indigo::asset {
+
+enum class RawMeshEncoderResult {
+  Ok = 0,
+  BadVertexCount,
+  BadTriangleIndexCount,
+  IndexOutOfRange,
+  NoData,
+};
+
+class RawMeshEncoder {
+ public:
+  struct EncodeSettings {
+    EncodeSettings();
+
+    // Float mantissa bits kept for positions and normal quaternions (23 is
+    //  lossless). Values are rounded, not re-laid out - zeroed low bits are
+    //  what makes the vertex data compressible.
+    uint8_t PositionMantissaBits;
+    uint8_t NormalMantissaBits;
+
+    // Vertex cache + vertex fetch reordering (see MeshOptimizer)
+    bool OptimizeVertexOrder;
+
+    pb::RawMeshDef::Codec Codec;
+  };
+
+ public:
+  RawMeshEncoder();
+
+  RawMeshEncoderResult add_pos_norm_data(
+      const core::PodVector<PositionNormalVertexData>& data);
+  RawMeshEncoderResult add_texcoord_data(
+      const core::PodVector<TexcoordVertexData>& data);
+  RawMeshEncoderResult add_skeletal_animation_data(
+      const core::PodVector<SkeletalAnimationVertexData>& data);
+  RawMeshEncoderResult add_index_data(const core::PodVector<uint32_t>& data);
+
+  core::Either<pb::RawMeshDef, RawMeshEncoderResult> encode(
+      EncodeSettings settings = EncodeSettings()) const;
+
+ private:
+  RawMeshEncoderResult validate_size(size_t size);
+
+  uint32_t vertex_count_;
+  std::vector<PositionNormalVertexData> pos_norm_;
+  std::vector<TexcoordVertexData> texcoords_;
+  std::vector<SkeletalAnimationVertexData> skeletal_;
+  std::vector<uint32_t> indices_;
+};
+
+}  // namespace indigo::asset
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef LIB_IGASSET_SHARED_ASSET_STORE_H
+#define LIB_IGASSET_SHARED_ASSET_STORE_H
+
+/**
+ * SharedAssetStore - process-wide store of immutable, already-extracted
+ *  assets, shared by everything in the process that needs the same asset
+ *  (e.g. every match running on a game server).
+ *
+ * Assets are keyed by igpack path, asset name and type, and handed out as
+ *  shared_ptr<const T>. The store only keeps weak references to loaded assets,
+ *  so an asset is freed once its last user lets go of it and is loaded again
+ *  by the next request. Requests for an asset that is still loading wait on
+ *  the load that is already in flight instead of starting another.
+ *
+ * Returned promises may be shared between callers - read the result (get /
+ *  on_success), never move it out (consume / then_consuming / move).
+ *
+ * Stored assets must be safe to read from many threads at once - per-user
+ *  mutable state (e.g. a dtNavMeshQuery, see DetourNavmesh::thread_query) has
+ *  to live outside of them. What each additional user costs is then one
+ *  shared_ptr plus whatever that per-user state is: for a match on the game
+ *  server, one query per simulation thread (~20KB at 512 nodes, ~80KB at 2048)
+ *  instead of a full copy of the navmesh tiles.
+ */
+
+#include <igasset/igpack_loader.h>
+#include <igasync/promise.h>
+#include <igasync/task_list.h>
+#include <igcore/either.h>
+#include <ignav/detour_navmesh.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <typeindex>
+
+namespace indigo::asset {
+
+class SharedAssetStore
+    : public std::enable_shared_from_this<SharedAssetStore> {
+ public:
+  template <typename T>
+  using AssetT =
+      core::Either<std::shared_ptr<const T>, IgpackLoader::IgpackExtractError>;
+  template <typename T>
+  using AssetPromiseT = std::shared_ptr<core::Promise<AssetT<T>>>;
+
+  /** Store shared by the whole process */
+  static std::shared_ptr<SharedAssetStore> Global();
+
+  /** Detour navmesh, shared read-only by every caller that asks for it */
+  AssetPromiseT<nav::DetourNavmesh> detour_navmesh(
+      std::string igpack_path, std::string asset_name,
+      std::shared_ptr<core::TaskList> task_list);
+
+  /**
+   * Get an asset, starting "load" only if the asset is neither loaded nor
+   *  already loading. Failed loads are not remembered - the next request for
+   *  the same asset tries again.
+   */
+  template <typename T>
+  AssetPromiseT<T> acquire(const std::string& igpack_path,
+                           const std::string& asset_name,
+                           std::function<AssetPromiseT<T>()> load,
+                           std::shared_ptr<core::TaskList> task_list) {
+    const Key key{igpack_path, asset_name, std::type_index(typeid(T))};
+
+    std::lock_guard<std::mutex> l(mut_);
+    Slot& slot = slots_[key];
+    if (slot.InFlight) {
+      return std::static_pointer_cast<core::Promise<AssetT<T>>>(slot.InFlight);
+    }
+
+    if (auto loaded = std::static_pointer_cast<const T>(slot.Loaded.lock())) {
+      return core::Promise<AssetT<T>>::immediate(
+          AssetT<T>(core::left(std::move(loaded))));
+    }
+
+    // Promise callbacks always run as tasks, never inline, so nothing below
+    //  can re-enter the store while mut_ is held
+    AssetPromiseT<T> promise = load();
+    slot.InFlight = promise;
+    loads_started_++;
+
+    std::weak_ptr<SharedAssetStore> weak_self = weak_from_this();
+    promise->on_success(
+        [weak_self, key](const AssetT<T>& rsl) {
+          auto self = weak_self.lock();
+          if (!self) {
+            return;
+          }
+          self->finish_load(key, rsl.is_left() ? rsl.get_left() : nullptr);
+        },
+        task_list);
+
+    return promise;
+  }
+
+  // Telemetry
+  uint64_t loads_started() const;
+  size_t live_asset_count() const;
+
+  SharedAssetStore();
+
+ private:
+  typedef std::tuple<std::string, std::string, std::type_index> Key;
+
+  struct Slot {
+    // Set while loading (a Promise<AssetT<T>>), cleared once it resolves
+    std::shared_ptr<void> InFlight;
+    std::weak_ptr<const void> Loaded;
+  };
+
+  void finish_load(const Key& key, std::shared_ptr<const void> asset);
+
+  mutable std::mutex mut_;
+  std::map<Key, Slot> slots_;
+  uint64_t loads_started_;
+};
+
+}  // namespace indigo::asset
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef LIB_IGASSET_TERRAIN_CHUNKER_H
+#define LIB_IGASSET_TERRAIN_CHUNKER_H
+
+/**
+ * Offline terrain preprocessing - splits one large terrain mesh into square
+ *  XZ chunks, and builds simplified LODs of every chunk.
+ *
+ * Triangles go to the chunk their centroid falls in (triangles are never
+ *  split, so chunk bounds may overlap slightly). LODs are built by vertex
+ *  clustering on a world-aligned grid: every vertex in a grid cell collapses
+ *  onto the one vertex nearest the cell's average position, and triangles
+ *  that collapse to a line or point are dropped. Coarser cells give fewer
+ *  triangles. Every LOD is then run through MeshOptimizer.
+ *
+ * No GPU or asset file types in here - see igpack-gen for the export step.
+ */
+
+#include <igasset/vertex_formats.h>
+#include <igcore/pod_vector.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace indigo::asset {
+
+struct TerrainChunkMesh {
+  core::PodVector<PositionNormalVertexData> vertices;
+  core::PodVector<uint32_t> indices;
+
+  uint32_t triangle_count() const {
+    return static_cast<uint32_t>(indices.size() / 3u);
+  }
+};
+
+struct TerrainChunk {
+  // Grid cell of the chunk (floor(x / chunk size), floor(z / chunk size))
+  int32_t gridX;
+  int32_t gridZ;
+
+  // Bounds of the full detail mesh - every LOD fits inside them
+  glm::vec3 boundsMin;
+  glm::vec3 boundsMax;
+
+  // Full detail first
+  std::vector<TerrainChunkMesh> lods;
+};
+
+class TerrainChunker {
+ public:
+  struct Params {
+    // XZ size of a chunk, in world units
+    float chunkSize;
+
+    // Clustering cell size of every LOD after the full detail one (e.g. two
+    //  entries for a total of three LODs) - should be increasing
+    std::vector<float> lodCellSizes;
+  };
+
+  /** Chunks are returned in (gridZ, gridX) order - empty chunks are skipped */
+  static std::vector<TerrainChunk> build(
+      const core::PodVector<PositionNormalVertexData>& vertices,
+      const core::PodVector<uint32_t>& indices, const Params& params);
+
+  /** Vertex clustering simplification of a single mesh (see above) */
+  static TerrainChunkMesh simplify(const TerrainChunkMesh& mesh,
+                                   float cell_size);
+};
+
+}  // namespace indigo::asset
+
+#endif
@@ -0,0 +1,413 @@
+#include <igasset/block_compression.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+struct Color3 {
+  float c[3];
+};
+
+uint16_t to_565(const Color3& color) {
+  auto quantize = [](float v, int max) {
+    int q = static_cast<int>(std::lround(v * max / 255.f));
+    return static_cast<uint16_t>(std::clamp(q, 0, max));
+  };
+
+  return static_cast<uint16_t>((quantize(color.c[0], 31) << 11) |
+                               (quantize(color.c[1], 63) << 5) |
+                               quantize(color.c[2], 31));
+}
+
+void from_565(uint16_t packed, int out[3]) {
+  int r = (packed >> 11) & 31;
+  int g = (packed >> 5) & 63;
+  int b = packed & 31;
+  out[0] = (r << 3) | (r >> 2);
+  out[1] = (g << 2) | (g >> 4);
+  out[2] = (b << 3) | (b >> 2);
+}
+
+// Four color palette - BC3 color blocks always use this mode, BC1 blocks use
+//  it when c0 > c1
+void four_color_palette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+  from_565(c0, palette[0]);
+  from_565(c1, palette[1]);
+  for (int i = 0; i < 3; i++) {
+    palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+    palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+  }
+}
+
+int color_distance_sq(const RgbaPixel& texel, const int color[3]) {
+  int d = 0;
+  for (int i = 0; i < 3; i++) {
+    int diff = static_cast<int>(texel.Color[i]) - color[i];
+    d += diff * diff;
+  }
+  return d;
+}
+
+// Pick the nearest palette entry for each texel - returns total error
+int choose_color_indices(const RgbaPixel texels[16], uint16_t c0,
+                         uint16_t c1, uint8_t indices[16]) {
+  int palette[4][3];
+  ::four_color_palette(c0, c1, palette);
+
+  int total_error = 0;
+  for (int t = 0; t < 16; t++) {
+    int best = 0;
+    int best_error = ::color_distance_sq(texels[t], palette[0]);
+    for (int p = 1; p < 4; p++) {
+      int error = ::color_distance_sq(texels[t], palette[p]);
+      if (error < best_error) {
+        best = p;
+        best_error = error;
+      }
+    }
+    indices[t] = static_cast<uint8_t>(best);
+    total_error += best_error;
+  }
+  return total_error;
+}
+
+// Least squares endpoints for a fixed set of palette indices, or false if the
+//  indices do not constrain both endpoints
+bool refine_endpoints(const RgbaPixel texels[16], const uint8_t indices[16],
+                      Color3* end0, Color3* end1) {
+  static constexpr float kWeight0[4] = {1.f, 0.f, 2.f / 3.f, 1.f / 3.f};
+
+  float aa = 0.f, ab = 0.f, bb = 0.f;
+  float ax[3] = {0.f, 0.f, 0.f};
+  float bx[3] = {0.f, 0.f, 0.f};
+  for (int t = 0; t < 16; t++) {
+    float a = kWeight0[indices[t]];
+    float b = 1.f - a;
+    aa += a * a;
+    ab += a * b;
+    bb += b * b;
+    for (int i = 0; i < 3; i++) {
+      ax[i] += a * texels[t].Color[i];
+      bx[i] += b * texels[t].Color[i];
+    }
+  }
+
+  float det = aa * bb - ab * ab;
+  if (std::abs(det) < 1e-6f) {
+    return false;
+  }
+
+  for (int i = 0; i < 3; i++) {
+    end0->c[i] = std::clamp((ax[i] * bb - bx[i] * ab) / det, 0.f, 255.f);
+    end1->c[i] = std::clamp((bx[i] * aa - ax[i] * ab) / det, 0.f, 255.f);
+  }
+  return true;
+}
+
+void write_color_block(uint16_t c0, uint16_t c1, const uint8_t indices[16],
+                       uint8_t* out) {
+  uint32_t index_bits = 0u;
+  for (int t = 0; t < 16; t++) {
+    index_bits |= static_cast<uint32_t>(indices[t]) << (2 * t);
+  }
+
+  out[0] = static_cast<uint8_t>(c0 & 0xFF);
+  out[1] = static_cast<uint8_t>(c0 >> 8);
+  out[2] = static_cast<uint8_t>(c1 & 0xFF);
+  out[3] = static_cast<uint8_t>(c1 >> 8);
+  for (int i = 0; i < 4; i++) {
+    out[4 + i] = static_cast<uint8_t>(index_bits >> (8 * i));
+  }
+}
+
+// Endpoints are always written with c0 > c1 (four color mode), so the block
+//  decodes the same as a BC1 block and as the color half of a BC3 block
+void encode_color_block(const RgbaPixel texels[16], uint8_t* out) {
+  Color3 mean{{0.f, 0.f, 0.f}};
+  for (int t = 0; t < 16; t++) {
+    for (int i = 0; i < 3; i++) {
+      mean.c[i] += texels[t].Color[i] / 16.f;
+    }
+  }
+
+  float cov[6] = {0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+  for (int t = 0; t < 16; t++) {
+    float d[3];
+    for (int i = 0; i < 3; i++) {
+      d[i] = texels[t].Color[i] - mean.c[i];
+    }
+    cov[0] += d[0] * d[0];
+    cov[1] += d[0] * d[1];
+    cov[2] += d[0] * d[2];
+    cov[3] += d[1] * d[1];
+    cov[4] += d[1] * d[2];
+    cov[5] += d[2] * d[2];
+  }
+
+  // Principal axis by power iteration
+  float axis[3] = {1.f, 1.f, 1.f};
+  for (int iter = 0; iter < 8; iter++) {
+    float next[3] = {
+        cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+        cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+        cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2],
+    };
+    float len = std::sqrt(next[0] * next[0] + next[1] * next[1] +
+                          next[2] * next[2]);
+    if (len < 1e-6f) {
+      break;
+    }
+    for (int i = 0; i < 3; i++) {
+      axis[i] = next[i] / len;
+    }
+  }
+
+  float min_t = 0.f, max_t = 0.f;
+  for (int t = 0; t < 16; t++) {
+    float proj = 0.f;
+    for (int i = 0; i < 3; i++) {
+      proj += (texels[t].Color[i] - mean.c[i]) * axis[i];
+    }
+    min_t = std::min(min_t, proj);
+    max_t = std::max(max_t, proj);
+  }
+
+  // Pull the endpoints in slightly - the interpolated colors cover the range
+  //  better than the extremes do
+  float inset = (max_t - min_t) / 16.f;
+  min_t += inset;
+  max_t -= inset;
+
+  Color3 end0, end1;
+  for (int i = 0; i < 3; i++) {
+    end0.c[i] = std::clamp(mean.c[i] + axis[i] * max_t, 0.f, 255.f);
+    end1.c[i] = std::clamp(mean.c[i] + axis[i] * min_t, 0.f, 255.f);
+  }
+
+  auto order = [](uint16_t* c0, uint16_t* c1) {
+    if (*c0 < *c1) {
+      std::swap(*c0, *c1);
+    }
+  };
+
+  uint16_t c0 = ::to_565(end0);
+  uint16_t c1 = ::to_565(end1);
+  order(&c0, &c1);
+
+  uint8_t indices[16];
+  if (c0 == c1) {
+    std::memset(indices, 0, sizeof(indices));
+    ::write_color_block(c0, c1, indices, out);
+    return;
+  }
+
+  int error = ::choose_color_indices(texels, c0, c1, indices);
+
+  Color3 refined0, refined1;
+  if (::refine_endpoints(texels, indices, &refined0, &refined1)) {
+    uint16_t r0 = ::to_565(refined0);
+    uint16_t r1 = ::to_565(refined1);
+    order(&r0, &r1);
+    if (r0 != r1) {
+      uint8_t refined_indices[16];
+      int refined_error =
+          ::choose_color_indices(texels, r0, r1, refined_indices);
+      if (refined_error < error) {
+        c0 = r0;
+        c1 = r1;
+        std::memcpy(indices, refined_indices, sizeof(indices));
+      }
+    }
+  }
+
+  ::write_color_block(c0, c1, indices, out);
+}
+
+void decode_color_block(const uint8_t* block, bool force_four_color,
+                        RgbaPixel texels[16]) {
+  uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+  uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+  uint32_t index_bits = block[4] | (block[5] << 8) | (block[6] << 16) |
+                        (static_cast<uint32_t>(block[7]) << 24);
+
+  int palette[4][3];
+  uint8_t alpha[4] = {255u, 255u, 255u, 255u};
+  if (c0 > c1 || force_four_color) {
+    ::four_color_palette(c0, c1, palette);
+  } else {
+    // Three colors plus transparent black
+    from_565(c0, palette[0]);
+    from_565(c1, palette[1]);
+    for (int i = 0; i < 3; i++) {
+      palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+      palette[3][i] = 0;
+    }
+    alpha[3] = 0u;
+  }
+
+  for (int t = 0; t < 16; t++) {
+    uint32_t idx = (index_bits >> (2 * t)) & 3u;
+    for (int i = 0; i < 3; i++) {
+      texels[t].Color[i] = static_cast<uint8_t>(palette[idx][i]);
+    }
+    texels[t].Color[3] = alpha[idx];
+  }
+}
+
+void alpha_palette(uint8_t a0, uint8_t a1, int palette[8]) {
+  palette[0] = a0;
+  palette[1] = a1;
+  if (a0 > a1) {
+    for (int i = 1; i < 7; i++) {
+      palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+    }
+  } else {
+    for (int i = 1; i < 5; i++) {
+      palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+    }
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+}
+
+void encode_alpha_block(const RgbaPixel texels[16], uint8_t* out) {
+  uint8_t a0 = 0u, a1 = 255u;
+  for (int t = 0; t < 16; t++) {
+    a0 = std::max(a0, texels[t].Color[3]);
+    a1 = std::min(a1, texels[t].Color[3]);
+  }
+
+  uint64_t index_bits = 0u;
+  if (a0 != a1) {
+    int palette[8];
+    ::alpha_palette(a0, a1, palette);
+    for (int t = 0; t < 16; t++) {
+      int best = 0;
+      int best_error = 256;
+      for (int p = 0; p < 8; p++) {
+        int error = std::abs(static_cast<int>(texels[t].Color[3]) - palette[p]);
+        if (error < best_error) {
+          best = p;
+          best_error = error;
+        }
+      }
+      index_bits |= static_cast<uint64_t>(best) << (3 * t);
+    }
+  }
+
+  out[0] = a0;
+  out[1] = a1;
+  for (int i = 0; i < 6; i++) {
+    out[2 + i] = static_cast<uint8_t>(index_bits >> (8 * i));
+  }
+}
+
+void decode_alpha_block(const uint8_t* block, RgbaPixel texels[16]) {
+  int palette[8];
+  ::alpha_palette(block[0], block[1], palette);
+
+  uint64_t index_bits = 0u;
+  for (int i = 0; i < 6; i++) {
+    index_bits |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+  }
+
+  for (int t = 0; t < 16; t++) {
+    texels[t].Color[3] =
+        static_cast<uint8_t>(palette[(index_bits >> (3 * t)) & 7u]);
+  }
+}
+
+}  // namespace
+
+uint32_t BlockCompression::bytes_per_block(BlockFormat format) {
+  return format == BlockFormat::BC1_RGB ? 8u : 16u;
+}
+
+size_t BlockCompression::encoded_size(BlockFormat format, uint32_t width,
+                                      uint32_t height) {
+  return static_cast<size_t>(blocks_across(width)) * blocks_across(height) *
+         bytes_per_block(format);
+}
+
+void BlockCompression::encode_bc1_block(const RgbaPixel texels[16],
+                                        uint8_t* out) {
+  ::encode_color_block(texels, out);
+}
+
+void BlockCompression::encode_bc3_block(const RgbaPixel texels[16],
+                                        uint8_t* out) {
+  ::encode_alpha_block(texels, out);
+  ::encode_color_block(texels, out + 8);
+}
+
+void BlockCompression::decode_bc1_block(const uint8_t* block,
+                                        RgbaPixel texels[16]) {
+  ::decode_color_block(block, false, texels);
+}
+
+void BlockCompression::decode_bc3_block(const uint8_t* block,
+                                        RgbaPixel texels[16]) {
+  ::decode_color_block(block + 8, true, texels);
+  ::decode_alpha_block(block, texels);
+}
+
+void BlockCompression::encode_image(BlockFormat format,
+                                    const RgbaPixel* pixels, uint32_t width,
+                                    uint32_t height, uint8_t* out) {
+  const uint32_t block_size = bytes_per_block(format);
+  const uint32_t blocks_x = blocks_across(width);
+  const uint32_t blocks_y = blocks_across(height);
+
+  RgbaPixel texels[16];
+  for (uint32_t by = 0; by < blocks_y; by++) {
+    for (uint32_t bx = 0; bx < blocks_x; bx++) {
+      for (uint32_t y = 0; y < kBlockDim; y++) {
+        uint32_t src_y = std::min(by * kBlockDim + y, height - 1u);
+        for (uint32_t x = 0; x < kBlockDim; x++) {
+          uint32_t src_x = std::min(bx * kBlockDim + x, width - 1u);
+          texels[y * kBlockDim + x] = pixels[src_y * width + src_x];
+        }
+      }
+
+      uint8_t* block = out + (by * blocks_x + bx) * block_size;
+      if (format == BlockFormat::BC1_RGB) {
+        encode_bc1_block(texels, block);
+      } else {
+        encode_bc3_block(texels, block);
+      }
+    }
+  }
+}
+
+void BlockCompression::decode_image(BlockFormat format, const uint8_t* blocks,
+                                    uint32_t width, uint32_t height,
+                                    RgbaPixel* out) {
+  const uint32_t block_size = bytes_per_block(format);
+  const uint32_t blocks_x = blocks_across(width);
+  const uint32_t blocks_y = blocks_across(height);
+
+  RgbaPixel texels[16];
+  for (uint32_t by = 0; by < blocks_y; by++) {
+    for (uint32_t bx = 0; bx < blocks_x; bx++) {
+      const uint8_t* block = blocks + (by * blocks_x + bx) * block_size;
+      if (format == BlockFormat::BC1_RGB) {
+        decode_bc1_block(block, texels);
+      } else {
+        decode_bc3_block(block, texels);
+      }
+
+      for (uint32_t y = 0; y < kBlockDim && by * kBlockDim + y < height; y++) {
+        for (uint32_t x = 0; x < kBlockDim && bx * kBlockDim + x < width;
+             x++) {
+          out[(by * kBlockDim + y) * width + bx * kBlockDim + x] =
+              texels[y * kBlockDim + x];
+        }
+      }
+    }
+  }
+}
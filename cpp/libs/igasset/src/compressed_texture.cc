@@ -0,0 +1,186 @@
+#include <igasset/compressed_texture.h>
+#include <igcore/log.h>
+#include <igcore/lz4.h>
+
+#include <algorithm>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+const char* kLogLabel = "CompressedTexture";
+
+BlockFormat to_block_format(pb::CompressedTextureDef::Format format) {
+  return format == pb::CompressedTextureDef::BC3_RGBA ? BlockFormat::BC3_RGBA
+                                                      : BlockFormat::BC1_RGB;
+}
+}  // namespace
+
+std::string indigo::asset::to_string(CompressedTextureResult rsl) {
+  switch (rsl) {
+    case CompressedTextureResult::Ok:
+      return "Ok";
+    case CompressedTextureResult::WrongAssetType:
+      return "WrongAssetType";
+    case CompressedTextureResult::DecompressFailed:
+      return "DecompressFailed";
+    case CompressedTextureResult::SizeMismatch:
+      return "SizeMismatch";
+    case CompressedTextureResult::BadMipLevel:
+      return "BadMipLevel";
+  }
+
+  return "<<CompressedTextureResult - Unknown>>";
+}
+
+uint32_t CompressedTexture::mip_extent(uint32_t base_extent,
+                                       uint32_t mip_level) {
+  if (mip_level >= 32u) {
+    return 1u;
+  }
+  return std::max(base_extent >> mip_level, 1u);
+}
+
+uint32_t CompressedTexture::full_mip_count(uint32_t width, uint32_t height) {
+  uint32_t largest = std::max(width, height);
+  uint32_t count = 1u;
+  while (largest > 1u) {
+    largest >>= 1u;
+    count++;
+  }
+  return count;
+}
+
+size_t CompressedTexture::mip_chain_size(BlockFormat format, uint32_t width,
+                                         uint32_t height, uint32_t mip_count) {
+  size_t size = 0u;
+  for (uint32_t i = 0; i < mip_count; i++) {
+    size += BlockCompression::encoded_size(format, mip_extent(width, i),
+                                           mip_extent(height, i));
+  }
+  return size;
+}
+
+core::Either<std::shared_ptr<const CompressedTexture>, CompressedTextureResult>
+CompressedTexture::Create(std::shared_ptr<const IgpackAsset> asset) {
+  if (asset->asset().asset_case() !=
+      pb::SingleAsset::kCompressedTextureDef) {
+    return core::right(CompressedTextureResult::WrongAssetType);
+  }
+
+  const pb::CompressedTextureDef& def = asset->asset().compressed_texture_def();
+  if (def.width() == 0u || def.height() == 0u || def.mip_count() == 0u ||
+      def.mip_count() > full_mip_count(def.width(), def.height())) {
+    core::Logger::err(kLogLabel)
+        << "Texture " << asset->asset().name() << " has invalid dimensions "
+        << def.width() << "x" << def.height() << " (" << def.mip_count()
+        << " mips)";
+    return core::right(CompressedTextureResult::SizeMismatch);
+  }
+
+  const size_t data_size =
+      mip_chain_size(::to_block_format(def.format()), def.width(),
+                     def.height(), def.mip_count());
+  if (def.uncompressed_size() != data_size) {
+    core::Logger::err(kLogLabel)
+        << "Texture " << asset->asset().name() << " should be " << data_size
+        << " bytes, but is " << def.uncompressed_size();
+    return core::right(CompressedTextureResult::SizeMismatch);
+  }
+
+  if (def.supercompression() == pb::CompressedTextureDef::NONE) {
+    if (asset->payload_size() != data_size) {
+      core::Logger::err(kLogLabel)
+          << "Texture " << asset->asset().name() << " payload is "
+          << asset->payload_size() << " bytes, expected " << data_size;
+      return core::right(CompressedTextureResult::SizeMismatch);
+    }
+
+    // Block data is all bytes - no alignment requirement, unlike RawMesh
+    const uint8_t* data = asset->payload();
+    return core::left(std::make_shared<const CompressedTexture>(
+        std::move(asset), core::RawBuffer(0u), data, data_size));
+  }
+
+  if (def.supercompression() != pb::CompressedTextureDef::LZ4) {
+    core::Logger::err(kLogLabel)
+        << "Unsupported supercompression " << def.supercompression()
+        << " for texture " << asset->asset().name();
+    return core::right(CompressedTextureResult::DecompressFailed);
+  }
+
+  core::RawBuffer decompressed(data_size);
+  if (!core::Lz4::decompress(asset->payload(), asset->payload_size(),
+                             decompressed.get(), data_size)) {
+    core::Logger::err(kLogLabel)
+        << "Failed to decompress texture " << asset->asset().name();
+    return core::right(CompressedTextureResult::DecompressFailed);
+  }
+
+  const uint8_t* data = decompressed.get();
+  return core::left(std::make_shared<const CompressedTexture>(
+      std::move(asset), std::move(decompressed), data, data_size));
+}
+
+CompressedTexture::CompressedTexture(std::shared_ptr<const IgpackAsset> asset,
+                                     core::RawBuffer decompressed,
+                                     const uint8_t* data, size_t data_size)
+    : asset_(std::move(asset)),
+      decompressed_(std::move(decompressed)),
+      format_(::to_block_format(
+          asset_->asset().compressed_texture_def().format())),
+      data_(data),
+      data_size_(data_size) {}
+
+bool CompressedTexture::is_srgb() const {
+  return asset_->asset().compressed_texture_def().is_srgb();
+}
+
+uint32_t CompressedTexture::width() const {
+  return asset_->asset().compressed_texture_def().width();
+}
+
+uint32_t CompressedTexture::height() const {
+  return asset_->asset().compressed_texture_def().height();
+}
+
+uint32_t CompressedTexture::mip_count() const {
+  return asset_->asset().compressed_texture_def().mip_count();
+}
+
+CompressedMip CompressedTexture::mip(uint32_t mip_level) const {
+  const uint32_t block_size = BlockCompression::bytes_per_block(format_);
+
+  const uint8_t* data = data_;
+  for (uint32_t i = 0; i < mip_level; i++) {
+    data += BlockCompression::encoded_size(format_, mip_extent(width(), i),
+                                           mip_extent(height(), i));
+  }
+
+  CompressedMip mip;
+  mip.Width = mip_extent(width(), mip_level);
+  mip.Height = mip_extent(height(), mip_level);
+  mip.BlocksWide = BlockCompression::blocks_across(mip.Width);
+  mip.BlocksHigh = BlockCompression::blocks_across(mip.Height);
+  mip.BytesPerRow = mip.BlocksWide * block_size;
+  mip.Data = data;
+  mip.Size = static_cast<size_t>(mip.BytesPerRow) * mip.BlocksHigh;
+  return mip;
+}
+
+core::Either<RgbaImage, CompressedTextureResult>
+CompressedTexture::transcode_to_rgba(uint32_t mip_level) const {
+  if (mip_level >= mip_count()) {
+    return core::right(CompressedTextureResult::BadMipLevel);
+  }
+
+  CompressedMip level = mip(mip_level);
+
+  const size_t pixel_count = static_cast<size_t>(level.Width) * level.Height;
+  core::PodVector<RgbaPixel> pixels(pixel_count);
+  pixels.resize(pixel_count);
+  BlockCompression::decode_image(format_, level.Data, level.Width,
+                                 level.Height, pixels.raw());
+
+  return core::left(RgbaImage{std::move(pixels), level.Width, level.Height});
+}
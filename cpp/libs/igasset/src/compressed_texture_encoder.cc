@@ -0,0 +1,174 @@
+#include <igasset/block_compression.h>
+#include <igasset/compressed_texture.h>
+#include <igasset/compressed_texture_encoder.h>
+#include <igcore/log.h>
+#include <igcore/lz4.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <string>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+const char* kLogLabel = "CompressedTextureEncoder";
+
+float srgb_to_linear(float v) {
+  return v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+}
+
+float linear_to_srgb(float v) {
+  return v <= 0.0031308f ? v * 12.92f
+                         : 1.055f * std::pow(v, 1.f / 2.4f) - 0.055f;
+}
+
+const std::array<float, 256>& srgb_table() {
+  static const std::array<float, 256> table = []() {
+    std::array<float, 256> t;
+    for (int i = 0; i < 256; i++) {
+      t[i] = ::srgb_to_linear(i / 255.f);
+    }
+    return t;
+  }();
+  return table;
+}
+
+uint8_t to_unorm8(float v) {
+  return static_cast<uint8_t>(
+      std::clamp(static_cast<int>(std::lround(v * 255.f)), 0, 255));
+}
+
+bool has_alpha(const RgbaImage& image) {
+  for (size_t i = 0; i < image.Pixels.size(); i++) {
+    if (image.Pixels[i].Color[3] != 255u) {
+      return true;
+    }
+  }
+  return false;
+}
+
+BlockFormat to_block_format(pb::CompressedTextureDef::Format format) {
+  return format == pb::CompressedTextureDef::BC3_RGBA ? BlockFormat::BC3_RGBA
+                                                      : BlockFormat::BC1_RGB;
+}
+}  // namespace
+
+CompressedTextureEncoder::EncodeSettings::EncodeSettings()
+    : AutoFormat(true),
+      Format(pb::CompressedTextureDef::BC1_RGB),
+      IsSrgb(true),
+      GenerateMips(true),
+      Supercompression(pb::CompressedTextureDef::LZ4) {}
+
+RgbaImage CompressedTextureEncoder::downsample(const RgbaImage& image,
+                                               bool is_srgb) {
+  const uint32_t width = std::max(image.Width / 2u, 1u);
+  const uint32_t height = std::max(image.Height / 2u, 1u);
+  const auto& to_linear = ::srgb_table();
+
+  core::PodVector<RgbaPixel> pixels(static_cast<size_t>(width) * height);
+  for (uint32_t y = 0; y < height; y++) {
+    const uint32_t y0 = std::min(y * 2u, image.Height - 1u);
+    const uint32_t y1 = std::min(y * 2u + 1u, image.Height - 1u);
+    for (uint32_t x = 0; x < width; x++) {
+      const uint32_t x0 = std::min(x * 2u, image.Width - 1u);
+      const uint32_t x1 = std::min(x * 2u + 1u, image.Width - 1u);
+      const RgbaPixel* src[4] = {
+          &image.Pixels[y0 * image.Width + x0],
+          &image.Pixels[y0 * image.Width + x1],
+          &image.Pixels[y1 * image.Width + x0],
+          &image.Pixels[y1 * image.Width + x1],
+      };
+
+      RgbaPixel out;
+      for (int c = 0; c < 4; c++) {
+        float sum = 0.f;
+        for (int s = 0; s < 4; s++) {
+          sum += (is_srgb && c < 3) ? to_linear[src[s]->Color[c]]
+                                    : src[s]->Color[c] / 255.f;
+        }
+        float avg = sum / 4.f;
+        out.Color[c] = ::to_unorm8((is_srgb && c < 3) ? ::linear_to_srgb(avg)
+                                                      : avg);
+      }
+      pixels.push_back(out);
+    }
+  }
+
+  return RgbaImage{std::move(pixels), width, height};
+}
+
+core::Either<pb::CompressedTextureDef, CompressedTextureEncoderResult>
+CompressedTextureEncoder::encode(const RgbaImage& image,
+                                 EncodeSettings settings) {
+  if (image.Width == 0u || image.Height == 0u ||
+      image.Pixels.size() != static_cast<size_t>(image.Width) * image.Height) {
+    core::Logger::err(kLogLabel) << "Input image has no (or mis-sized) data";
+    const CompressedTextureEncoderResult rsl =
+        CompressedTextureEncoderResult::NoData;
+    return core::right(rsl);
+  }
+
+  if (image.Width % BlockCompression::kBlockDim != 0u ||
+      image.Height % BlockCompression::kBlockDim != 0u) {
+    core::Logger::err(kLogLabel)
+        << "Image is " << image.Width << "x" << image.Height
+        << " - BC textures must be a multiple of 4 on each side";
+    const CompressedTextureEncoderResult rsl =
+        CompressedTextureEncoderResult::NotBlockAligned;
+    return core::right(rsl);
+  }
+
+  pb::CompressedTextureDef::Format pb_format = settings.Format;
+  if (settings.AutoFormat) {
+    pb_format = ::has_alpha(image) ? pb::CompressedTextureDef::BC3_RGBA
+                                   : pb::CompressedTextureDef::BC1_RGB;
+  }
+  const BlockFormat format = ::to_block_format(pb_format);
+
+  const uint32_t mip_count =
+      settings.GenerateMips
+          ? CompressedTexture::full_mip_count(image.Width, image.Height)
+          : 1u;
+
+  std::string blocks(CompressedTexture::mip_chain_size(
+                         format, image.Width, image.Height, mip_count),
+                     '\0');
+  uint8_t* out = reinterpret_cast<uint8_t*>(&blocks[0]);
+
+  // Each level is filtered from the one above it, so only one level is ever
+  //  held in memory in addition to the source image
+  std::unique_ptr<RgbaImage> level;
+  const RgbaImage* src = &image;
+  for (uint32_t mip = 0; mip < mip_count; mip++) {
+    if (mip > 0u) {
+      level = std::make_unique<RgbaImage>(downsample(*src, settings.IsSrgb));
+      src = level.get();
+    }
+
+    BlockCompression::encode_image(format, src->Pixels.raw(), src->Width,
+                                   src->Height, out);
+    out += BlockCompression::encoded_size(format, src->Width, src->Height);
+  }
+
+  pb::CompressedTextureDef def;
+  def.set_format(pb_format);
+  def.set_width(image.Width);
+  def.set_height(image.Height);
+  def.set_mip_count(mip_count);
+  def.set_is_srgb(settings.IsSrgb);
+  def.set_uncompressed_size(blocks.size());
+  def.set_supercompression(settings.Supercompression);
+
+  if (settings.Supercompression == pb::CompressedTextureDef::LZ4) {
+    def.set_data(core::Lz4::compress(
+        reinterpret_cast<const uint8_t*>(blocks.data()), blocks.size()));
+  } else {
+    def.set_data(std::move(blocks));
+  }
+
+  return core::left(std::move(def));
+}
@@ -0,0 +1,291 @@
+#include <igasset/decoded_asset_cache.h>
+#include <igcore/log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+const char* kLogLabel = "DecodedAssetCache";
+
+const uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ull;
+const uint64_t kFnvPrime = 0x100000001b3ull;
+
+uint64_t align_up(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1u) / alignment * alignment;
+}
+
+uint64_t hash_bytes(uint64_t hash, const uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+uint64_t hash_u64(uint64_t hash, uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    hash ^= static_cast<uint8_t>(value >> (i * 8));
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+}  // namespace
+
+std::shared_ptr<DecodedAssetCache> DecodedAssetCache::Create(
+    std::string directory, uint64_t max_size_bytes) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec || !std::filesystem::is_directory(directory, ec)) {
+    core::Logger::err(kLogLabel)
+        << "Could not create asset cache directory " << directory;
+    return nullptr;
+  }
+
+  auto cache = std::make_shared<DecodedAssetCache>(
+      std::filesystem::path(directory), max_size_bytes);
+
+  {
+    std::lock_guard<std::mutex> l(cache->mut_);
+    cache->scan_directory_locked();
+    cache->evict_locked();
+  }
+
+  core::Logger::log(kLogLabel)
+      << "Opened asset cache " << directory << " - " << cache->entry_count()
+      << " entries, " << cache->size_bytes() << " bytes";
+  return cache;
+}
+
+DecodedAssetCache::DecodedAssetCache(std::filesystem::path directory,
+                                     uint64_t max_size_bytes)
+    : directory_(std::move(directory)),
+      max_size_bytes_(max_size_bytes),
+      size_bytes_(0ull) {}
+
+uint64_t DecodedAssetCache::content_hash(const uint8_t* data, size_t size) {
+  // FNV-1a over 8-byte words instead of single bytes - this runs over every
+  //  encoded asset on every startup, so it needs to be much cheaper than the
+  //  decode it saves. The fold after each word keeps high bits mixing down.
+  uint64_t hash = ::hash_u64(kFnvOffsetBasis, size);
+
+  size_t i = 0u;
+  for (; i + 8u <= size; i += 8u) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    hash ^= word;
+    hash *= kFnvPrime;
+    hash ^= hash >> 32;
+  }
+
+  return ::hash_bytes(hash, data + i, size - i);
+}
+
+std::string DecodedAssetCache::file_name_for(
+    const DecodedAssetKey& key) const {
+  uint64_t hash = ::hash_u64(kFnvOffsetBasis, key.ContentHash);
+  hash = ::hash_u64(hash, key.DecoderVersion);
+  hash = ::hash_u64(hash, key.AssetName.size());
+  hash = ::hash_bytes(hash,
+                      reinterpret_cast<const uint8_t*>(key.AssetName.data()),
+                      key.AssetName.size());
+
+  std::ostringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << hash
+     << kFileExtension;
+  return ss.str();
+}
+
+core::Maybe<DecodedAssetCache::Entry> DecodedAssetCache::read(
+    const DecodedAssetKey& key) {
+  const std::string file_name = file_name_for(key);
+  auto file_rsl = core::MappedFile::Open((directory_ / file_name).string());
+  if (file_rsl.is_right()) {
+    return core::empty_maybe{};
+  }
+
+  std::shared_ptr<const core::MappedFile> file = file_rsl.left_move();
+  if (file->size() < sizeof(DecodedAssetCacheHeader)) {
+    return core::empty_maybe{};
+  }
+
+  DecodedAssetCacheHeader header{};
+  std::memcpy(&header, file->data(), sizeof(header));
+
+  // Same file name does not mean the same key - check everything, so that a
+  //  hash collision or a torn write is a miss instead of bad data
+  const uint64_t name_end =
+      sizeof(DecodedAssetCacheHeader) + static_cast<uint64_t>(header.NameSize);
+  if (std::memcmp(header.Magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.Version != kVersion ||
+      header.DecoderVersion != key.DecoderVersion ||
+      header.ContentHash != key.ContentHash ||
+      header.NameSize != key.AssetName.size() || name_end > file->size() ||
+      header.PayloadOffset < name_end ||
+      header.PayloadOffset > file->size() ||
+      header.PayloadSize > file->size() - header.PayloadOffset) {
+    return core::empty_maybe{};
+  }
+
+  if (std::memcmp(file->data() + sizeof(DecodedAssetCacheHeader),
+                  key.AssetName.data(), key.AssetName.size()) != 0) {
+    return core::empty_maybe{};
+  }
+
+  {
+    std::lock_guard<std::mutex> l(mut_);
+    touch_locked(file_name);
+  }
+
+  const uint8_t* data = file->data() + header.PayloadOffset;
+  const size_t size = static_cast<size_t>(header.PayloadSize);
+  return Entry{std::move(file), data, size};
+}
+
+bool DecodedAssetCache::write(const DecodedAssetKey& key, const uint8_t* data,
+                              size_t size) {
+  DecodedAssetCacheHeader header{};
+  std::memcpy(header.Magic, kMagic, sizeof(kMagic));
+  header.Version = kVersion;
+  header.DecoderVersion = key.DecoderVersion;
+  header.NameSize = static_cast<uint32_t>(key.AssetName.size());
+  header.ContentHash = key.ContentHash;
+  header.PayloadOffset =
+      ::align_up(sizeof(header) + key.AssetName.size(), kBlobAlignment);
+  header.PayloadSize = size;
+
+  const uint64_t file_size = header.PayloadOffset + size;
+  if (file_size > max_size_bytes_) {
+    return false;
+  }
+
+  const std::string file_name = file_name_for(key);
+  const std::filesystem::path path = directory_ / file_name;
+  const std::filesystem::path tmp_path = path.string() + ".tmp";
+
+  std::lock_guard<std::mutex> l(mut_);
+
+  // Written to the side and renamed into place, so readers (including other
+  //  running clients) never map a half-written entry
+  {
+    std::ofstream fout(tmp_path, std::ios::binary | std::ios::trunc);
+    const std::vector<char> padding(
+        header.PayloadOffset - sizeof(header) - key.AssetName.size(), '\0');
+    fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fout.write(key.AssetName.data(), key.AssetName.size());
+    fout.write(padding.data(), padding.size());
+    fout.write(reinterpret_cast<const char*>(data), size);
+    if (!fout) {
+      core::Logger::err(kLogLabel) << "Failed to write cache entry for "
+                                   << key.AssetName << " to " << tmp_path;
+      std::error_code ec;
+      std::filesystem::remove(tmp_path, ec);
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    core::Logger::err(kLogLabel) << "Failed to move cache entry into place at "
+                                 << path << " - " << ec.message();
+    std::filesystem::remove(tmp_path, ec);
+    return false;
+  }
+
+  track_locked(file_name, file_size);
+  evict_locked();
+  return true;
+}
+
+uint64_t DecodedAssetCache::size_bytes() const {
+  std::lock_guard<std::mutex> l(mut_);
+  return size_bytes_;
+}
+
+size_t DecodedAssetCache::entry_count() const {
+  std::lock_guard<std::mutex> l(mut_);
+  return files_.size();
+}
+
+void DecodedAssetCache::scan_directory_locked() {
+  struct ScannedFile {
+    std::string FileName;
+    uint64_t Size;
+    std::filesystem::file_time_type LastUsed;
+  };
+  std::vector<ScannedFile> scanned;
+
+  std::error_code ec;
+  for (const auto& dir_entry :
+       std::filesystem::directory_iterator(directory_, ec)) {
+    std::error_code entry_ec;
+    if (!dir_entry.is_regular_file(entry_ec) ||
+        dir_entry.path().extension() != kFileExtension) {
+      continue;
+    }
+
+    ScannedFile file{dir_entry.path().filename().string(),
+                     dir_entry.file_size(entry_ec),
+                     dir_entry.last_write_time(entry_ec)};
+    if (!entry_ec) {
+      scanned.push_back(std::move(file));
+    }
+  }
+
+  std::sort(scanned.begin(), scanned.end(),
+            [](const ScannedFile& a, const ScannedFile& b) {
+              return a.LastUsed < b.LastUsed;
+            });
+  for (const ScannedFile& file : scanned) {
+    track_locked(file.FileName, file.Size);
+  }
+}
+
+void DecodedAssetCache::touch_locked(const std::string& file_name) {
+  auto it = files_.find(file_name);
+  if (it != files_.end()) {
+    lru_.splice(lru_.end(), lru_, it->second);
+  }
+
+  std::error_code ec;
+  std::filesystem::last_write_time(
+      directory_ / file_name, std::filesystem::file_time_type::clock::now(),
+      ec);
+}
+
+void DecodedAssetCache::track_locked(const std::string& file_name,
+                                     uint64_t size) {
+  auto it = files_.find(file_name);
+  if (it != files_.end()) {
+    size_bytes_ -= it->second->Size;
+    lru_.erase(it->second);
+    files_.erase(it);
+  }
+
+  lru_.push_back(TrackedFile{file_name, size});
+  files_.emplace(file_name, std::prev(lru_.end()));
+  size_bytes_ += size;
+}
+
+void DecodedAssetCache::evict_locked() {
+  while (size_bytes_ > max_size_bytes_ && !lru_.empty()) {
+    const TrackedFile& oldest = lru_.front();
+
+    // Entries that are still mapped can't be removed on every platform - they
+    //  stop counting against the budget either way, and are picked up again
+    //  by the directory scan on the next run
+    std::error_code ec;
+    std::filesystem::remove(directory_ / oldest.FileName, ec);
+
+    size_bytes_ -= oldest.Size;
+    files_.erase(oldest.FileName);
+    lru_.pop_front();
+  }
+}
@@ -1,16 +1,108 @@
 #include <draco/compression/decode.h>
 #include <igasset/draco_decoder.h>
-#include <igcore/log.h>
 
+#include <cstddef>
+#include <cstring>
 #include <map>
+#include <vector>
 
 using namespace indigo;
 using namespace asset;
 
 namespace {
-const char* kLogLabel = "DracoDecoder";
-
 constexpr int kNormalQuatAttributeIndex = 1;
+
+static_assert(sizeof(draco::Mesh::Face) == 3 * sizeof(uint32_t),
+              "Draco faces are expected to be packed 32-bit index triangles");
+
+// Decoded blob layout: header, then each present vertex array (in flag
+//  order), then the index array. Every array element is a multiple of 4 bytes,
+//  so arrays stay 4-byte aligned if the blob is.
+struct DecodedHeader {
+  uint32_t NumVertices;
+  uint32_t NumIndices;
+  int32_t NumBones;
+  uint32_t Flags;
+};
+static_assert(sizeof(DecodedHeader) == 16);
+
+constexpr uint32_t kHasPosNorm = 0x1;
+constexpr uint32_t kHasTexcoords = 0x2;
+constexpr uint32_t kHasSkin = 0x4;
+
+static_assert(sizeof(PositionNormalVertexData) % 4 == 0 &&
+              sizeof(TexcoordVertexData) % 4 == 0 &&
+              sizeof(SkeletalAnimationVertexData) % 4 == 0);
+
+// Copy "count" tightly packed values of "value_size" bytes to "dest",
+//  "dest_stride" bytes apart
+void copy_strided(const void* src, size_t value_size, uint32_t count,
+                  uint8_t* dest, size_t dest_stride) {
+  if (dest_stride == value_size) {
+    std::memcpy(dest, src, value_size * count);
+    return;
+  }
+
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(src);
+  for (uint32_t i = 0; i < count; i++) {
+    std::memcpy(dest + i * dest_stride, in + i * value_size, value_size);
+  }
+}
+
+template <typename T>
+constexpr draco::DataType data_type_of();
+template <>
+constexpr draco::DataType data_type_of<float>() {
+  return draco::DataType::DT_FLOAT32;
+}
+template <>
+constexpr draco::DataType data_type_of<uint32_t>() {
+  return draco::DataType::DT_UINT32;
+}
+
+// Write "num_components" values of type T for every point of "attrib" to
+//  "dest", "dest_stride" bytes apart. Attributes that are already stored as
+//  tightly packed T values are copied as raw bytes (all at once if the point
+//  mapping is the identity), everything else goes through ConvertValue.
+template <typename T>
+void write_attribute(const draco::PointAttribute& attrib, uint32_t num_points,
+                     int num_components, uint8_t* dest, size_t dest_stride) {
+  const size_t value_size = sizeof(T) * num_components;
+  const bool is_packed =
+      attrib.data_type() == data_type_of<T>() &&
+      attrib.num_components() == num_components &&
+      static_cast<size_t>(attrib.byte_stride()) == value_size;
+
+  if (num_points == 0u) {
+    return;
+  }
+
+  if (is_packed && attrib.is_mapping_identity() &&
+      attrib.size() >= num_points) {
+    const uint8_t* src = attrib.GetAddress(draco::AttributeValueIndex(0));
+    if (dest_stride == value_size) {
+      std::memcpy(dest, src, value_size * num_points);
+      return;
+    }
+
+    for (uint32_t i = 0; i < num_points; i++) {
+      std::memcpy(dest + i * dest_stride, src + i * value_size, value_size);
+    }
+    return;
+  }
+
+  for (draco::PointIndex point_idx(0); point_idx < num_points; point_idx++) {
+    uint8_t* out = dest + point_idx.value() * dest_stride;
+    if (is_packed) {
+      std::memcpy(out, attrib.GetAddressOfMappedIndex(point_idx), value_size);
+      continue;
+    }
+
+    T value[4]{};
+    attrib.ConvertValue(attrib.mapped_index(point_idx), num_components, value);
+    std::memcpy(out, value, value_size);
+  }
+}
 }  // namespace
 
 std::string indigo::asset::to_string(DracoDecoderResult rsl) {
@@ -59,6 +151,8 @@ DracoDecoderResult DracoDecoder::decode(const core::RawBuffer& buffer) {
   }
 
   mesh_ = std::move(mesh_rsl).value();
+  decoded_ = nullptr;
+  num_bones_ = -1;
 
   // TODO (sessamekesh): Be a bit more scientific about this...
   const draco::PointAttribute* idx_attrib = nullptr;
@@ -103,8 +197,86 @@ DracoDecoderResult DracoDecoder::add_bone_data(std::string bone_name,
 
 core::Either<core::PodVector<PositionNormalVertexData>, DracoDecoderResult>
 DracoDecoder::get_pos_norm_data() const {
+  core::PodVector<PositionNormalVertexData> vertices(num_vertices());
+  vertices.resize(num_vertices());
+
+  const DracoDecoderResult rsl = write_pos_norm_data(vertices.raw());
+  if (rsl != DracoDecoderResult::Ok) {
+    return core::right(rsl);
+  }
+
+  return core::left(std::move(vertices));
+}
+
+core::Either<core::PodVector<TexcoordVertexData>, DracoDecoderResult>
+DracoDecoder::get_texcoord_data() const {
+  core::PodVector<TexcoordVertexData> vertices(num_vertices());
+  vertices.resize(num_vertices());
+
+  const DracoDecoderResult rsl = write_texcoord_data(vertices.raw());
+  if (rsl != DracoDecoderResult::Ok) {
+    return core::right(rsl);
+  }
+
+  return core::left(std::move(vertices));
+}
+
+core::Either<core::PodVector<uint32_t>, DracoDecoderResult>
+DracoDecoder::get_index_data() const {
+  core::PodVector<uint32_t> indices(num_indices());
+  indices.resize(num_indices());
+
+  const DracoDecoderResult rsl = write_index_data(indices.raw());
+  if (rsl != DracoDecoderResult::Ok) {
+    return core::right(rsl);
+  }
+
+  return core::left(std::move(indices));
+}
+
+core::Either<core::PodVector<SkeletalAnimationVertexData>, DracoDecoderResult>
+DracoDecoder::get_skeletal_animation_vertices(
+    const ozz::animation::Skeleton& ozz_skeleton) const {
+  core::PodVector<SkeletalAnimationVertexData> vertices(num_vertices());
+  vertices.resize(num_vertices());
+
+  const DracoDecoderResult rsl =
+      write_skeletal_animation_vertices(ozz_skeleton, vertices.raw());
+  if (rsl != DracoDecoderResult::Ok) {
+    return core::right(rsl);
+  }
+
+  return core::left(std::move(vertices));
+}
+
+uint32_t DracoDecoder::num_vertices() const {
+  if (decoded_) {
+    return decoded_->NumVertices;
+  }
+  return mesh_ ? mesh_->num_points() : 0u;
+}
+
+uint32_t DracoDecoder::num_indices() const {
+  if (decoded_) {
+    return decoded_->NumIndices;
+  }
+  return mesh_ ? mesh_->num_faces() * 3u : 0u;
+}
+
+DracoDecoderResult DracoDecoder::write_pos_norm_data(void* dest,
+                                                     size_t stride) const {
+  if (decoded_) {
+    if (decoded_->PosNorm == nullptr) {
+      return DracoDecoderResult::NoData;
+    }
+    ::copy_strided(decoded_->PosNorm, sizeof(PositionNormalVertexData),
+                   decoded_->NumVertices, reinterpret_cast<uint8_t*>(dest),
+                   stride);
+    return DracoDecoderResult::Ok;
+  }
+
   if (mesh_ == nullptr) {
-    return core::right(DracoDecoderResult::MeshDataMissing);
+    return DracoDecoderResult::MeshDataMissing;
   }
 
   auto pos_attrib =
@@ -114,169 +286,187 @@ DracoDecoder::get_pos_norm_data() const {
 
   if (!pos_attrib || pos_attrib->num_components() != 3 || !normal_attrib ||
       normal_attrib->num_components() != 4) {
-    return core::right(DracoDecoderResult::NoData);
+    return DracoDecoderResult::NoData;
   }
 
-  core::PodVector<PositionNormalVertexData> vertices(mesh_->num_points());
-
-  for (draco::PointIndex vert_idx(0); vert_idx < mesh_->num_points();
-       vert_idx++) {
-    PositionNormalVertexData vert{};
+  uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+  ::write_attribute<float>(*pos_attrib, mesh_->num_points(), 3,
+                           out + offsetof(PositionNormalVertexData, Position),
+                           stride);
+  ::write_attribute<float>(
+      *normal_attrib, mesh_->num_points(), 4,
+      out + offsetof(PositionNormalVertexData, NormalQuat), stride);
 
-    pos_attrib->ConvertValue(pos_attrib->mapped_index(vert_idx), 3,
-                             &vert.Position[0]);
-    normal_attrib->ConvertValue(normal_attrib->mapped_index(vert_idx), 4,
-                                &vert.NormalQuat[0]);
+  return DracoDecoderResult::Ok;
+}
 
-    vertices.push_back(vert);
+DracoDecoderResult DracoDecoder::write_texcoord_data(void* dest,
+                                                     size_t stride) const {
+  if (decoded_) {
+    if (decoded_->Texcoords == nullptr) {
+      return DracoDecoderResult::NoData;
+    }
+    ::copy_strided(decoded_->Texcoords, sizeof(TexcoordVertexData),
+                   decoded_->NumVertices, reinterpret_cast<uint8_t*>(dest),
+                   stride);
+    return DracoDecoderResult::Ok;
   }
 
-  return core::left<core::PodVector<PositionNormalVertexData>>(vertices);
-}
-
-core::Either<core::PodVector<TexcoordVertexData>, DracoDecoderResult>
-DracoDecoder::get_texcoord_data() const {
   if (mesh_ == nullptr) {
-    return core::right(DracoDecoderResult::MeshDataMissing);
+    return DracoDecoderResult::MeshDataMissing;
   }
 
   auto texcoord_attrib =
       mesh_->GetNamedAttribute(draco::GeometryAttribute::Type::TEX_COORD);
 
   if (!texcoord_attrib || texcoord_attrib->num_components() != 2) {
-    return core::right(DracoDecoderResult::NoData);
+    return DracoDecoderResult::NoData;
   }
 
-  core::PodVector<TexcoordVertexData> vertices(mesh_->num_points());
+  ::write_attribute<float>(
+      *texcoord_attrib, mesh_->num_points(), 2,
+      reinterpret_cast<uint8_t*>(dest) + offsetof(TexcoordVertexData, Texcoord),
+      stride);
 
-  for (draco::PointIndex vert_idx(0); vert_idx < mesh_->num_points();
-       vert_idx++) {
-    TexcoordVertexData vert{};
-
-    texcoord_attrib->ConvertValue(texcoord_attrib->mapped_index(vert_idx), 2,
-                                  &vert.Texcoord[0]);
+  return DracoDecoderResult::Ok;
+}
 
-    vertices.push_back(vert);
+DracoDecoderResult DracoDecoder::write_index_data(uint32_t* dest) const {
+  if (decoded_) {
+    std::memcpy(dest, decoded_->Indices,
+                sizeof(uint32_t) * decoded_->NumIndices);
+    return DracoDecoderResult::Ok;
   }
 
-  return core::left<core::PodVector<TexcoordVertexData>>(vertices);
-}
-
-core::Either<core::PodVector<uint32_t>, DracoDecoderResult>
-DracoDecoder::get_index_data() const {
   if (mesh_ == nullptr) {
-    return core::right(DracoDecoderResult::MeshDataMissing);
+    return DracoDecoderResult::MeshDataMissing;
   }
 
-  core::PodVector<uint32_t> result(mesh_->num_faces() * 3);
+  if (mesh_->num_faces() == 0u) {
+    return DracoDecoderResult::Ok;
+  }
 
-  for (draco::FaceIndex face_idx(0); face_idx < mesh_->num_faces();
-       face_idx++) {
-    auto face = mesh_->face(face_idx);
+  // Faces are stored contiguously as triangles of 32-bit point indices, which
+  //  is exactly the index buffer layout
+  std::memcpy(dest, &mesh_->face(draco::FaceIndex(0)),
+              sizeof(draco::Mesh::Face) * mesh_->num_faces());
 
-    if (face.size() != 3) {
-      core::Logger::log(kLogLabel) << "Skipping non-triangular face";
-      continue;
-    }
+  return DracoDecoderResult::Ok;
+}
 
-    for (auto idx : face) {
-      result.push_back((uint32_t)idx.value());
+DracoDecoderResult DracoDecoder::write_skin_data(void* dest,
+                                                 size_t stride) const {
+  if (decoded_) {
+    if (decoded_->Skin == nullptr) {
+      return DracoDecoderResult::NoData;
     }
+    ::copy_strided(decoded_->Skin, sizeof(SkeletalAnimationVertexData),
+                   decoded_->NumVertices, reinterpret_cast<uint8_t*>(dest),
+                   stride);
+    return DracoDecoderResult::Ok;
+  }
+
+  if (mesh_ == nullptr) {
+    return DracoDecoderResult::MeshDataMissing;
+  }
+
+  // TODO (sessamekesh): Grab this from the Draco asset instead, because these
+  // values are WRONG!
+  auto bone_weights_attrib =
+      mesh_->GetNamedAttribute(draco::GeometryAttribute::Type::GENERIC, 1);
+  auto bone_indices_attrib =
+      mesh_->GetNamedAttribute(draco::GeometryAttribute::Type::GENERIC, 2);
+
+  if (!bone_weights_attrib || !bone_indices_attrib ||
+      bone_weights_attrib->data_type() != draco::DataType::DT_FLOAT32 ||
+      bone_indices_attrib->data_type() != draco::DataType::DT_UINT32 ||
+      bone_weights_attrib->num_components() != 4 ||
+      bone_indices_attrib->num_components() != 4) {
+    return DracoDecoderResult::NoData;
   }
 
-  return core::left<core::PodVector<uint32_t>>(result);
+  uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+  ::write_attribute<float>(
+      *bone_weights_attrib, mesh_->num_points(), 4,
+      out + offsetof(SkeletalAnimationVertexData, BoneWeights), stride);
+  ::write_attribute<uint32_t>(
+      *bone_indices_attrib, mesh_->num_points(), 4,
+      out + offsetof(SkeletalAnimationVertexData, BoneIndices), stride);
+
+  return DracoDecoderResult::Ok;
 }
 
-core::Either<core::PodVector<SkeletalAnimationVertexData>, DracoDecoderResult>
-DracoDecoder::get_skeletal_animation_vertices(
-    const ozz::animation::Skeleton& ozz_skeleton) const {
+DracoDecoderResult DracoDecoder::write_skeletal_animation_vertices(
+    const ozz::animation::Skeleton& ozz_skeleton, void* dest,
+    size_t stride) const {
   //
   // Step 1: verify that skeleton data is loaded and correct
   //
   if (bone_data_.size() == 0) {
-    return core::right(DracoDecoderResult::BoneDataNotLoaded);
+    return DracoDecoderResult::BoneDataNotLoaded;
   }
 
   if (num_bones_ == 0 && bone_data_.size() == 0) {
-    return core::right(DracoDecoderResult::NoData);
+    return DracoDecoderResult::NoData;
   }
 
   if (num_bones_ != bone_data_.size()) {
-    return core::right(DracoDecoderResult::BoneDataIncomplete);
+    return DracoDecoderResult::BoneDataIncomplete;
   }
 
-  std::map<std::string, int> name_to_skeleton_index;
+  // Draco bone index -> ozz joint index, resolved once per bone instead of
+  //  once per vertex influence. Bones missing from the skeleton are only an
+  //  error if some vertex is actually influenced by one.
+  const uint32_t kMissingJoint = 0xFFFFFFFFu;
+  std::vector<uint32_t> bone_to_joint(bone_data_.size(), kMissingJoint);
   {
+    std::map<std::string, int> name_to_skeleton_index;
     auto joint_names = ozz_skeleton.joint_names();
 
     for (int i = 0; i < joint_names.size(); i++) {
       const char* joint_name = joint_names[i];
       name_to_skeleton_index.emplace(joint_name, i);
     }
-  }
-  std::function<int(std::string)> get_joint_index =
-      [&name_to_skeleton_index](std::string name) -> int {
-    auto idx_it = name_to_skeleton_index.find(name);
-    if (idx_it == name_to_skeleton_index.end()) {
-      return -1;
+
+    for (int i = 0; i < bone_data_.size(); i++) {
+      auto idx_it = name_to_skeleton_index.find(bone_data_[i].boneName);
+      if (idx_it != name_to_skeleton_index.end()) {
+        bone_to_joint[i] = idx_it->second;
+      }
     }
-    return idx_it->second;
-  };
+  }
 
   //
   // Step 2: Extract non-transformed skeleton data from Draco source
   //
-  if (mesh_ == nullptr) {
-    return core::right(DracoDecoderResult::MeshDataMissing);
-  }
-
-  // TODO (sessamekesh): Grab this from the Draco asset instead, because these
-  // values are WRONG!
-  auto bone_weights_attrib =
-      mesh_->GetNamedAttribute(draco::GeometryAttribute::Type::GENERIC, 1);
-  auto bone_indices_attrib =
-      mesh_->GetNamedAttribute(draco::GeometryAttribute::Type::GENERIC, 2);
-
-  if (bone_weights_attrib->data_type() != draco::DataType::DT_FLOAT32 ||
-      bone_indices_attrib->data_type() != draco::DataType::DT_UINT32 ||
-      bone_weights_attrib->num_components() != 4 ||
-      bone_indices_attrib->num_components() != 4) {
-    return core::right(DracoDecoderResult::NoData);
-  }
-
-  core::PodVector<SkeletalAnimationVertexData> vertices(mesh_->num_points());
-
-  for (draco::PointIndex vert_idx(0); vert_idx < mesh_->num_points();
-       vert_idx++) {
-    SkeletalAnimationVertexData vert{};
-
-    bone_weights_attrib->ConvertValue(
-        bone_weights_attrib->mapped_index(vert_idx), 4, &vert.BoneWeights[0]);
-    bone_indices_attrib->ConvertValue(
-        bone_indices_attrib->mapped_index(vert_idx), 4, &vert.BoneIndices[0]);
-
-    vertices.push_back(vert);
+  const DracoDecoderResult skin_rsl = write_skin_data(dest, stride);
+  if (skin_rsl != DracoDecoderResult::Ok) {
+    return skin_rsl;
   }
 
   //
   // Step 3: Transform all bone indices to transformed skeleton values
   //
-  for (int vert_idx = 0; vert_idx < vertices.size(); vert_idx++) {
-    for (int idx_idx = 0; idx_idx < 4; idx_idx++) {
-      int in_idx = vertices[vert_idx].BoneIndices[idx_idx];
-      std::string in_name = bone_data_[in_idx].boneName;
-      int out_idx = get_joint_index(in_name);
+  uint8_t* out_indices = reinterpret_cast<uint8_t*>(dest) +
+                         offsetof(SkeletalAnimationVertexData, BoneIndices);
+  for (uint32_t vert_idx = 0; vert_idx < num_vertices(); vert_idx++) {
+    uint32_t bone_indices[4];
+    uint8_t* vert_indices = out_indices + vert_idx * stride;
+    std::memcpy(bone_indices, vert_indices, sizeof(bone_indices));
 
-      if (out_idx < 0) {
-        return core::right(DracoDecoderResult::BoneDataIncomplete);
+    for (int idx_idx = 0; idx_idx < 4; idx_idx++) {
+      if (bone_indices[idx_idx] >= bone_to_joint.size() ||
+          bone_to_joint[bone_indices[idx_idx]] == kMissingJoint) {
+        return DracoDecoderResult::BoneDataIncomplete;
       }
-
-      vertices[vert_idx].BoneIndices[idx_idx] = out_idx;
+      bone_indices[idx_idx] = bone_to_joint[bone_indices[idx_idx]];
     }
+
+    std::memcpy(vert_indices, bone_indices, sizeof(bone_indices));
   }
 
   // Finished, return
-  return core::left(std::move(vertices));
+  return DracoDecoderResult::Ok;
 }
 
 core::Either<core::PodVector<glm::mat4>, DracoDecoderResult>
@@ -303,3 +493,103 @@ DracoDecoder::get_inv_bind_poses(
 
   return core::left(std::move(inv_bind_poses));
 }
+
+std::string DracoDecoder::serialize_decoded() const {
+  const uint32_t vertex_count = num_vertices();
+  const uint32_t index_count = num_indices();
+
+  ::DecodedHeader header{vertex_count, index_count, num_bones_, 0u};
+
+  std::string blob(sizeof(header) +
+                       static_cast<size_t>(vertex_count) *
+                           (sizeof(PositionNormalVertexData) +
+                            sizeof(TexcoordVertexData) +
+                            sizeof(SkeletalAnimationVertexData)) +
+                       sizeof(uint32_t) * index_count,
+                   '\0');
+  uint8_t* base = reinterpret_cast<uint8_t*>(&blob[0]);
+  size_t offset = sizeof(header);
+
+  // Attributes the mesh does not have are left out (and report NoData again
+  //  when loaded), instead of being stored as zeroes
+  if (write_pos_norm_data(base + offset) == DracoDecoderResult::Ok) {
+    header.Flags |= ::kHasPosNorm;
+    offset += sizeof(PositionNormalVertexData) * vertex_count;
+  }
+  if (write_texcoord_data(base + offset) == DracoDecoderResult::Ok) {
+    header.Flags |= ::kHasTexcoords;
+    offset += sizeof(TexcoordVertexData) * vertex_count;
+  }
+  if (write_skin_data(base + offset, sizeof(SkeletalAnimationVertexData)) ==
+      DracoDecoderResult::Ok) {
+    header.Flags |= ::kHasSkin;
+    offset += sizeof(SkeletalAnimationVertexData) * vertex_count;
+  }
+  if (index_count > 0u) {
+    write_index_data(reinterpret_cast<uint32_t*>(base + offset));
+    offset += sizeof(uint32_t) * index_count;
+  }
+
+  std::memcpy(base, &header, sizeof(header));
+  blob.resize(offset);
+  return blob;
+}
+
+DracoDecoderResult DracoDecoder::load_decoded(std::shared_ptr<const void> owner,
+                                              const uint8_t* data,
+                                              size_t size) {
+  if (data == nullptr || size < sizeof(::DecodedHeader) ||
+      reinterpret_cast<uintptr_t>(data) % alignof(uint32_t) != 0u) {
+    return DracoDecoderResult::DecodeFailed;
+  }
+
+  ::DecodedHeader header{};
+  std::memcpy(&header, data, sizeof(header));
+
+  const uint64_t vertex_count = header.NumVertices;
+  uint64_t expected_size = sizeof(header);
+  expected_size += sizeof(uint32_t) * static_cast<uint64_t>(header.NumIndices);
+  if (header.Flags & ::kHasPosNorm) {
+    expected_size += sizeof(PositionNormalVertexData) * vertex_count;
+  }
+  if (header.Flags & ::kHasTexcoords) {
+    expected_size += sizeof(TexcoordVertexData) * vertex_count;
+  }
+  if (header.Flags & ::kHasSkin) {
+    expected_size += sizeof(SkeletalAnimationVertexData) * vertex_count;
+  }
+  if (expected_size != size) {
+    return DracoDecoderResult::DecodeFailed;
+  }
+
+  auto decoded = std::make_unique<DecodedArrays>();
+  decoded->Owner = std::move(owner);
+  decoded->NumVertices = header.NumVertices;
+  decoded->NumIndices = header.NumIndices;
+
+  const uint8_t* cursor = data + sizeof(header);
+  decoded->PosNorm = nullptr;
+  if (header.Flags & ::kHasPosNorm) {
+    decoded->PosNorm =
+        reinterpret_cast<const PositionNormalVertexData*>(cursor);
+    cursor += sizeof(PositionNormalVertexData) * vertex_count;
+  }
+  decoded->Texcoords = nullptr;
+  if (header.Flags & ::kHasTexcoords) {
+    decoded->Texcoords = reinterpret_cast<const TexcoordVertexData*>(cursor);
+    cursor += sizeof(TexcoordVertexData) * vertex_count;
+  }
+  decoded->Skin = nullptr;
+  if (header.Flags & ::kHasSkin) {
+    decoded->Skin =
+        reinterpret_cast<const SkeletalAnimationVertexData*>(cursor);
+    cursor += sizeof(SkeletalAnimationVertexData) * vertex_count;
+  }
+  decoded->Indices = reinterpret_cast<const uint32_t*>(cursor);
+
+  mesh_ = nullptr;
+  decoded_ = std::move(decoded);
+  num_bones_ = header.NumBones;
+
+  return DracoDecoderResult::Ok;
+}
@@ -1,17 +1,191 @@
 #include <igasset/igpack_loader.h>
+#include <igasset/indexed_igpack.h>
 #include <igasset/proto_converters.h>
 #include <ignav/recast_compiler.h>
 #include <igplatform/file_promise.h>
+#include <igplatform/mapped_file.h>
 #include <ozz/base/io/archive.h>
 #include <ozz/base/io/stream.h>
 
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
 using namespace indigo;
 using namespace asset;
 
 namespace {
 const char* kLogLabel = "IgpackLoader";
+
+// Read-only ozz stream over asset bytes, so archives are deserialized straight
+//  out of the pack instead of being copied into an ozz::io::MemoryStream first
+class ConstMemoryStream : public ozz::io::Stream {
+ public:
+  ConstMemoryStream(const uint8_t* data, size_t size)
+      : data_(data), size_(size), cursor_(0u) {}
+
+  bool opened() const override { return true; }
+
+  size_t Read(void* buffer, size_t size) override {
+    size_t read_size = std::min(size, size_ - cursor_);
+    std::memcpy(buffer, data_ + cursor_, read_size);
+    cursor_ += read_size;
+    return read_size;
+  }
+
+  size_t Write(const void*, size_t) override { return 0u; }
+
+  int Seek(int offset, Origin origin) override {
+    int64_t base = origin == kSet       ? 0
+                   : origin == kCurrent ? static_cast<int64_t>(cursor_)
+                                        : static_cast<int64_t>(size_);
+    int64_t target = base + offset;
+    if (target < 0 || target > static_cast<int64_t>(size_)) {
+      return -1;
+    }
+    cursor_ = static_cast<size_t>(target);
+    return 0;
+  }
+
+  int Tell() const override { return static_cast<int>(cursor_); }
+
+  size_t Size() const override { return size_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t cursor_;
+};
+
+// Layout version of cached RGBA images (header, then pixels) - bump it if the
+//  layout or the PNG decode changes, so that older entries are ignored
+const uint32_t kRgbaImageCacheVersion = 1u;
+
+struct CachedRgbaImageHeader {
+  uint32_t Width;
+  uint32_t Height;
+};
+
+DecodedAssetKey decoded_asset_key(const std::string& asset_name,
+                                  const IgpackAsset& asset,
+                                  uint32_t decoder_version) {
+  return DecodedAssetKey{
+      DecodedAssetCache::content_hash(asset.payload(), asset.payload_size()),
+      asset_name, decoder_version};
 }
 
+// Cache writes go in their own task, so the extract promise that produced the
+//  data does not wait on the disk
+void schedule_cache_write(std::shared_ptr<DecodedAssetCache> cache,
+                          DecodedAssetKey key, std::string blob,
+                          const std::shared_ptr<core::TaskList>& task_list) {
+  auto shared_blob = std::make_shared<std::string>(std::move(blob));
+  task_list->add_task(core::Task::of(
+      [cache = std::move(cache), key = std::move(key), shared_blob]() {
+        cache->write(key, reinterpret_cast<const uint8_t*>(shared_blob->data()),
+                     shared_blob->size());
+      }));
+}
+
+bool load_cached_draco(DecodedAssetCache* cache, const DecodedAssetKey& key,
+                       DracoDecoder* decoder) {
+  auto entry = cache->read(key);
+  if (entry.is_empty()) {
+    return false;
+  }
+
+  const DecodedAssetCache::Entry& cached = entry.get();
+  return decoder->load_decoded(cached.File, cached.Data, cached.Size) ==
+         DracoDecoderResult::Ok;
+}
+
+core::Maybe<RgbaImage> read_cached_rgba_image(DecodedAssetCache* cache,
+                                              const DecodedAssetKey& key) {
+  auto entry = cache->read(key);
+  if (entry.is_empty() ||
+      entry.get().Size < sizeof(CachedRgbaImageHeader)) {
+    return core::empty_maybe{};
+  }
+
+  const DecodedAssetCache::Entry& cached = entry.get();
+  CachedRgbaImageHeader header{};
+  std::memcpy(&header, cached.Data, sizeof(header));
+
+  const size_t pixel_count = static_cast<size_t>(header.Width) * header.Height;
+  if (cached.Size != sizeof(header) + pixel_count * sizeof(RgbaPixel)) {
+    return core::empty_maybe{};
+  }
+
+  // RgbaImage owns its pixels, so this is one copy - still far cheaper than
+  //  inflating and un-filtering the PNG
+  core::PodVector<RgbaPixel> pixels(pixel_count);
+  pixels.resize(pixel_count);
+  std::memcpy(pixels.raw(), cached.Data + sizeof(header),
+              pixel_count * sizeof(RgbaPixel));
+
+  return RgbaImage{std::move(pixels), header.Width, header.Height};
+}
+
+std::string serialize_rgba_image(const RgbaImage& image) {
+  const CachedRgbaImageHeader header{image.Width, image.Height};
+  std::string blob(sizeof(header) + image.Pixels.size() * sizeof(RgbaPixel),
+                   '\0');
+  std::memcpy(&blob[0], &header, sizeof(header));
+  std::memcpy(&blob[sizeof(header)], image.Pixels.raw(),
+              image.Pixels.size() * sizeof(RgbaPixel));
+  return blob;
+}
+}  // namespace
+
+/**
+ * Loaded pack of either format - protobuf packs are parsed in full and indexed
+ *  by name, indexed packs are only read as assets are looked up
+ */
+class IgpackLoader::PackContents {
+ public:
+  explicit PackContents(pb::AssetPack asset_pack)
+      : asset_pack_(std::move(asset_pack)) {
+    for (int i = 0; i < asset_pack_.assets_size(); i++) {
+      asset_indices_.emplace(asset_pack_.assets(i).name(), i);
+    }
+  }
+
+  explicit PackContents(std::shared_ptr<IndexedIgpack> indexed_pack)
+      : indexed_pack_(std::move(indexed_pack)) {}
+
+  core::Either<IgpackAsset, IgpackExtractError> find(
+      const std::string& asset_name) const {
+    if (indexed_pack_) {
+      const IndexedIgpackTocEntry* entry =
+          indexed_pack_->find_entry(asset_name);
+      if (entry == nullptr) {
+        return core::right(IgpackExtractError::ResourceNotFound);
+      }
+
+      auto asset = indexed_pack_->read_asset(*entry);
+      if (asset.is_empty()) {
+        return core::right(IgpackExtractError::IgpackParseFailed);
+      }
+      return core::left(asset.move());
+    }
+
+    auto it = asset_indices_.find(asset_name);
+    if (it == asset_indices_.end()) {
+      return core::right(IgpackExtractError::ResourceNotFound);
+    }
+
+    return core::left(IgpackAsset::FromProto(asset_pack_.assets(it->second)));
+  }
+
+ private:
+  pb::AssetPack asset_pack_;
+  std::map<std::string, int> asset_indices_;
+
+  std::shared_ptr<IndexedIgpack> indexed_pack_;
+};
+
 std::string asset::to_string(IgpackLoader::IgpackExtractError error) {
 #ifdef IG_ENABLE_LOGGING
   switch (error) {
@@ -33,321 +207,800 @@ std::string asset::to_string(IgpackLoader::IgpackExtractError error) {
 #endif
 }
 
-IgpackLoader::IgpackLoader(
-    std::string file_name,
-    std::shared_ptr<core::TaskList> file_load_task_list) {
-  file_promise_ =
-      core::FilePromise::Create(file_name, file_load_task_list)
-          ->then<core::Either<pb::AssetPack, IgpackExtractError>>(
-              [](const auto& rsl)
-                  -> core::Either<pb::AssetPack, IgpackExtractError> {
-                if (rsl.is_right()) {
-                  return core::right(IgpackExtractError::FileLoadFailed);
-                }
-
-                const auto& buffer = rsl.get_left();
-
-                asset::pb::AssetPack asset_pack;
-                if (!asset_pack.ParseFromArray(buffer->get(), buffer->size())) {
-                  return core::right(IgpackExtractError::IgpackParseFailed);
-                }
-
-                return core::left(std::move(asset_pack));
+/**
+ * Streaming load of an indexed pack - table of contents first, then one byte
+ *  range per asset in priority order. Shared with every pending read and
+ *  extract call, so it outlives the IgpackLoader that started it.
+ */
+class IgpackLoader::StreamingState
+    : public std::enable_shared_from_this<StreamingState> {
+ public:
+  // Enough for the header and table of contents of any of our packs, so the
+  //  table of contents usually costs a single round trip
+  static constexpr uint64_t kTocPrefetchBytes = 16u * 1024u;
+
+  StreamingState(std::string file_name,
+                 std::shared_ptr<core::TaskList> task_list,
+                 StreamingParams params)
+      : file_name_(std::move(file_name)),
+        task_list_(std::move(task_list)),
+        params_(std::move(params)),
+        phase_(Phase::ReadingToc),
+        reads_in_flight_(0u) {
+    if (!params_.Reader) {
+      params_.Reader = core::RangedFileReader::Create(
+          IndexedIgpack::IndexedPathFor(file_name_), task_list_);
+    }
+    if (params_.MaxReadsInFlight == 0u) {
+      params_.MaxReadsInFlight = 1u;
+    }
+  }
+
+  void start() {
+    auto self = shared_from_this();
+    params_.Reader->read_range(0u, kTocPrefetchBytes)
+        ->on_success(
+            [self](const core::FilePromiseResultT& rsl) {
+              self->on_toc_prefix(rsl);
+            },
+            task_list_);
+  }
+
+  ExtractRawAssetPromiseT asset_promise(const std::string& asset_name) {
+    std::lock_guard<std::mutex> l(mut_);
+    auto it = promises_.find(asset_name);
+    if (it != promises_.end()) {
+      auto promise = it->second;
+      // Streamed before it was asked for - the caller owns the bytes now
+      if (phase_ == Phase::Streaming && promise->is_finished()) {
+        promises_.erase(it);
+
+        // ... so a later request reads it again
+        auto entry_it = entry_indices_.find(asset_name);
+        if (entry_it != entry_indices_.end()) {
+          delivered_[entry_it->second] = true;
+        }
+      }
+      return promise;
+    }
+
+    auto promise = core::Promise<ExtractRawAssetT>::create();
+    promises_.emplace(asset_name, promise);
+
+    auto entry_it = entry_indices_.find(asset_name);
+    if (phase_ == Phase::WholePack) {
+      forward_from_whole_pack(asset_name, promise);
+    } else if (phase_ == Phase::Streaming &&
+               entry_it == entry_indices_.end()) {
+      promise->resolve(core::right(IgpackExtractError::ResourceNotFound));
+    } else if (phase_ == Phase::Streaming) {
+      // Already handed out and released - read its range again
+      if (delivered_[entry_it->second]) {
+        delivered_[entry_it->second] = false;
+        unread_.push_back(entry_it->second);
+      }
+
+      // Requested assets jump ahead of unrequested ones at the same priority
+      pump();
+    }
+
+    return promise;
+  }
+
+ private:
+  enum class Phase {
+    ReadingToc,
+    Streaming,
+    WholePack,
+  };
+
+  struct AssetRead {
+    IndexedIgpackTocEntry Entry;
+    uint64_t Begin;
+    uint64_t End;
+    int32_t Priority;
+  };
+
+  struct StreamedAsset {
+    std::shared_ptr<core::RawBuffer> Bytes;
+    IgpackAsset Asset;
+  };
+
+  void on_toc_prefix(const core::FilePromiseResultT& rsl) {
+    if (rsl.is_right() ||
+        !IndexedIgpack::HasIndexedHeader(rsl.get_left()->get(),
+                                         rsl.get_left()->size())) {
+      fall_back_to_whole_pack();
+      return;
+    }
+
+    const auto& prefix = rsl.get_left();
+    IndexedIgpackHeader header{};
+    std::memcpy(&header, prefix->get(), sizeof(header));
+    uint64_t toc_end = header.StringTableOffset + header.StringTableSize;
+    if (header.Version != IndexedIgpack::kVersion ||
+        toc_end < sizeof(IndexedIgpackHeader) +
+                      static_cast<uint64_t>(header.EntryCount) *
+                          sizeof(IndexedIgpackTocEntry)) {
+      fall_back_to_whole_pack();
+      return;
+    }
+
+    if (toc_end <= prefix->size()) {
+      on_toc(header, prefix);
+      return;
+    }
+
+    // Unusually large table of contents - fetch the whole thing
+    auto self = shared_from_this();
+    params_.Reader->read_range(0u, toc_end)
+        ->on_success(
+            [self, header](const core::FilePromiseResultT& rsl) {
+              if (rsl.is_right() ||
+                  rsl.get_left()->size() <
+                      header.StringTableOffset + header.StringTableSize) {
+                self->fall_back_to_whole_pack();
+                return;
+              }
+              self->on_toc(header, rsl.get_left());
+            },
+            task_list_);
+  }
+
+  void on_toc(const IndexedIgpackHeader& header,
+              const std::shared_ptr<core::RawBuffer>& toc_bytes) {
+    std::lock_guard<std::mutex> l(mut_);
+
+    const auto* toc = reinterpret_cast<const IndexedIgpackTocEntry*>(
+        toc_bytes->get() + sizeof(IndexedIgpackHeader));
+    const char* names = reinterpret_cast<const char*>(toc_bytes->get()) +
+                        header.StringTableOffset;
+
+    for (uint32_t i = 0; i < header.EntryCount; i++) {
+      const IndexedIgpackTocEntry& entry = toc[i];
+      if (static_cast<uint64_t>(entry.NameOffset) + entry.NameSize >
+          header.StringTableSize) {
+        core::Logger::err(kLogLabel)
+            << "Streamed igpack " << file_name_ << " has a malformed TOC";
+        fall_back_to_whole_pack_locked();
+        return;
+      }
+
+      std::string name(names + entry.NameOffset, entry.NameSize);
+      auto priority_hint = params_.PriorityHints.find(name);
+
+      AssetRead read{};
+      read.Entry = entry;
+      read.Begin = std::min(entry.MetaOffset, entry.PayloadOffset);
+      read.End = std::max(entry.MetaOffset + entry.MetaSize,
+                          entry.PayloadOffset + entry.PayloadSize);
+      read.Priority = priority_hint != params_.PriorityHints.end()
+                          ? priority_hint->second
+                          : default_stream_priority(
+                                static_cast<pb::SingleAsset::AssetCase>(
+                                    entry.AssetType));
+
+      entry_indices_.emplace(name, static_cast<uint32_t>(reads_.size()));
+      unread_.push_back(static_cast<uint32_t>(reads_.size()));
+      read_names_.push_back(std::move(name));
+      reads_.push_back(read);
+      delivered_.push_back(false);
+    }
+
+    phase_ = Phase::Streaming;
+
+    for (auto& [name, promise] : promises_) {
+      if (entry_indices_.count(name) == 0) {
+        promise->resolve(core::right(IgpackExtractError::ResourceNotFound));
+      }
+    }
+
+    pump();
+  }
+
+  // Start reads until MaxReadsInFlight are pending - mut_ must be held
+  void pump() {
+    auto self = shared_from_this();
+    while (reads_in_flight_ < params_.MaxReadsInFlight && !unread_.empty()) {
+      auto next = std::min_element(
+          unread_.begin(), unread_.end(), [this](uint32_t a, uint32_t b) {
+            bool a_requested = promises_.count(read_names_[a]) > 0;
+            bool b_requested = promises_.count(read_names_[b]) > 0;
+            if (reads_[a].Priority != reads_[b].Priority) {
+              return reads_[a].Priority < reads_[b].Priority;
+            }
+            if (a_requested != b_requested) {
+              return a_requested;
+            }
+            return reads_[a].Begin < reads_[b].Begin;
+          });
+      uint32_t read_idx = *next;
+      unread_.erase(next);
+      reads_in_flight_++;
+
+      const AssetRead& read = reads_[read_idx];
+      params_.Reader->read_range(read.Begin, read.End - read.Begin)
+          ->on_success(
+              [self, read_idx](const core::FilePromiseResultT& rsl) {
+                self->on_asset_bytes(read_idx, rsl);
               },
-              file_load_task_list);
+              task_list_);
+    }
+  }
+
+  void on_asset_bytes(uint32_t read_idx, const core::FilePromiseResultT& rsl) {
+    ExtractRawAssetT asset_rsl = decode_asset(read_idx, rsl);
+
+    std::lock_guard<std::mutex> l(mut_);
+    reads_in_flight_--;
+
+    // Only assets nobody has asked for yet are held on to here - a requested
+    //  asset's bytes live exactly as long as its callers keep them
+    const std::string& name = read_names_[read_idx];
+    auto it = promises_.find(name);
+    if (it == promises_.end()) {
+      auto promise = core::Promise<ExtractRawAssetT>::create();
+      promise->resolve(std::move(asset_rsl));
+      promises_.emplace(name, std::move(promise));
+    } else {
+      it->second->resolve(std::move(asset_rsl));
+      promises_.erase(it);
+      delivered_[read_idx] = true;
+    }
+
+    pump();
+  }
+
+  ExtractRawAssetT decode_asset(uint32_t read_idx,
+                                const core::FilePromiseResultT& rsl) const {
+    const AssetRead& read = reads_[read_idx];
+    if (rsl.is_right() || rsl.get_left()->size() != read.End - read.Begin) {
+      core::Logger::err(kLogLabel) << "Failed to stream asset "
+                                   << read_names_[read_idx] << " from "
+                                   << file_name_;
+      return core::right(IgpackExtractError::FileLoadFailed);
+    }
+
+    const auto& bytes = rsl.get_left();
+    pb::SingleAsset meta;
+    const uint8_t* meta_bytes =
+        bytes->get() + (read.Entry.MetaOffset - read.Begin);
+    if (!meta.ParseFromArray(meta_bytes, read.Entry.MetaSize)) {
+      return core::right(IgpackExtractError::IgpackParseFailed);
+    }
+
+    auto streamed_asset = std::make_shared<StreamedAsset>(StreamedAsset{
+        bytes,
+        IgpackAsset(std::move(meta),
+                    bytes->get() + (read.Entry.PayloadOffset - read.Begin),
+                    read.Entry.PayloadSize)});
+    return core::left(std::shared_ptr<const IgpackAsset>(
+        streamed_asset, &streamed_asset->Asset));
+  }
+
+  void fall_back_to_whole_pack() {
+    std::lock_guard<std::mutex> l(mut_);
+    fall_back_to_whole_pack_locked();
+  }
+
+  void fall_back_to_whole_pack_locked() {
+    core::Logger::log(kLogLabel)
+        << "No indexed pack to stream for " << file_name_
+        << ", loading the whole pack instead";
+
+    phase_ = Phase::WholePack;
+    whole_pack_ = load_whole_pack(file_name_, task_list_);
+    for (auto& [name, promise] : promises_) {
+      forward_from_whole_pack(name, promise);
+    }
+  }
+
+  void forward_from_whole_pack(const std::string& asset_name,
+                               const ExtractRawAssetPromiseT& promise) {
+    whole_pack_->on_success(
+        [asset_name, promise](const PackContentsT& rsl) {
+          promise->resolve(find_raw_asset(rsl, asset_name));
+        },
+        task_list_);
+  }
+
+  std::string file_name_;
+  std::shared_ptr<core::TaskList> task_list_;
+  StreamingParams params_;
+
+  std::mutex mut_;
+  Phase phase_;
+
+  // Pending requests, and streamed assets waiting for their first request.
+  //  Entries are dropped once delivered so the pack is not held in memory.
+  std::map<std::string, ExtractRawAssetPromiseT> promises_;
+
+  // Streaming phase
+  std::vector<AssetRead> reads_;
+  std::vector<std::string> read_names_;
+  std::vector<bool> delivered_;
+  std::map<std::string, uint32_t> entry_indices_;
+  std::vector<uint32_t> unread_;
+  uint32_t reads_in_flight_;
+
+  // Whole pack phase
+  std::shared_ptr<core::Promise<PackContentsT>> whole_pack_;
+};
+
+std::shared_ptr<core::Promise<IgpackLoader::PackContentsT>>
+IgpackLoader::load_whole_pack(std::string file_name,
+                              std::shared_ptr<core::TaskList> task_list) {
+  auto rsl = core::Promise<PackContentsT>::create();
+
+  // Indexed pack first (if one was generated and the platform can map it),
+  //  whole protobuf pack as a fallback
+  task_list->add_task(core::Task::of([file_name, task_list, rsl]() {
+    auto mapped_file =
+        core::MappedFile::Open(IndexedIgpack::IndexedPathFor(file_name));
+    if (mapped_file.is_left()) {
+      auto file = mapped_file.left_move();
+      auto indexed_pack = IndexedIgpack::Open(file, file->data(), file->size());
+      if (indexed_pack.has_value()) {
+        rsl->resolve(core::left(std::shared_ptr<const PackContents>(
+            std::make_shared<PackContents>(indexed_pack.move()))));
+        return;
+      }
+    }
+
+    core::FilePromise::Create(file_name, task_list)
+        ->on_success(
+            [rsl](const core::FilePromiseResultT& file_rsl) {
+              if (file_rsl.is_right()) {
+                rsl->resolve(core::right(IgpackExtractError::FileLoadFailed));
+                return;
+              }
+
+              const auto& buffer = file_rsl.get_left();
+
+              asset::pb::AssetPack asset_pack;
+              if (!asset_pack.ParseFromArray(buffer->get(), buffer->size())) {
+                rsl->resolve(
+                    core::right(IgpackExtractError::IgpackParseFailed));
+                return;
+              }
+
+              rsl->resolve(core::left(std::shared_ptr<const PackContents>(
+                  std::make_shared<PackContents>(std::move(asset_pack)))));
+            },
+            task_list);
+  }));
+
+  return rsl;
+}
+
+IgpackLoader::ExtractRawAssetT IgpackLoader::find_raw_asset(
+    const PackContentsT& rsl, const std::string& asset_name) {
+  if (rsl.is_right()) {
+    return core::right(rsl.get_right());
+  }
+
+  const std::shared_ptr<const PackContents>& contents = rsl.get_left();
+  auto asset_rsl = contents->find(asset_name);
+  if (asset_rsl.is_right()) {
+    return core::right(asset_rsl.get_right());
+  }
+
+  // Payload points into the pack contents - keep them alive with the asset
+  auto holder = std::make_shared<
+      std::pair<std::shared_ptr<const PackContents>, IgpackAsset>>(
+      contents, asset_rsl.left_move());
+  return core::left(
+      std::shared_ptr<const IgpackAsset>(holder, &holder->second));
+}
+
+void IgpackLoader::set_decoded_asset_cache(
+    std::shared_ptr<DecodedAssetCache> cache) {
+  decoded_asset_cache_ = std::move(cache);
+}
+
+int32_t IgpackLoader::default_stream_priority(
+    pb::SingleAsset::AssetCase asset_type) {
+  switch (asset_type) {
+    case pb::SingleAsset::kWgslSource:
+      return 0;
+    case pb::SingleAsset::kDracoGeo:
+    case pb::SingleAsset::kRawMeshDef:
+    case pb::SingleAsset::kDetourNavmeshDef:
+    case pb::SingleAsset::kPngTextureDef:
+    case pb::SingleAsset::kCompressedTextureDef:
+    case pb::SingleAsset::kFlatTextureDef:
+    case pb::SingleAsset::kTerrainChunksDef:
+      return 1;
+    case pb::SingleAsset::kOzzSkeletonDef:
+      return 2;
+    case pb::SingleAsset::kOzzAnimationDef:
+      return 3;
+    default:
+      return 4;
+  }
+}
+
+IgpackLoader::IgpackLoader(std::string file_name,
+                           std::shared_ptr<core::TaskList> file_load_task_list)
+    : file_promise_(load_whole_pack(std::move(file_name),
+                                    std::move(file_load_task_list))) {}
+
+IgpackLoader::IgpackLoader(std::string file_name,
+                           std::shared_ptr<core::TaskList> file_load_task_list,
+                           StreamingParams streaming_params)
+    : streaming_state_(std::make_shared<StreamingState>(
+          std::move(file_name), std::move(file_load_task_list),
+          std::move(streaming_params))) {
+  streaming_state_->start();
 }
 
 IgpackLoader::IgpackLoader(const core::RawBuffer& raw_buffer) {
-  file_promise_ =
-      core::Promise<core::Either<pb::AssetPack, IgpackExtractError>>::create();
+  file_promise_ = core::Promise<PackContentsT>::create();
+
+  if (IndexedIgpack::HasIndexedHeader(raw_buffer.get(), raw_buffer.size())) {
+    auto owned_buffer = std::make_shared<core::RawBuffer>(raw_buffer.clone());
+    auto indexed_pack = IndexedIgpack::Open(
+        owned_buffer, owned_buffer->get(), owned_buffer->size());
+    if (indexed_pack.is_empty()) {
+      file_promise_->resolve(
+          core::right(IgpackExtractError::IgpackParseFailed));
+      return;
+    }
+
+    file_promise_->resolve(core::left(std::shared_ptr<const PackContents>(
+        std::make_shared<PackContents>(indexed_pack.move()))));
+    return;
+  }
 
   asset::pb::AssetPack asset_pack;
   if (!asset_pack.ParseFromArray(raw_buffer.get(), raw_buffer.size())) {
     file_promise_->resolve(core::right(IgpackExtractError::IgpackParseFailed));
+    return;
   }
 
-  file_promise_->resolve(core::left(std::move(asset_pack)));
+  file_promise_->resolve(core::left(std::shared_ptr<const PackContents>(
+      std::make_shared<PackContents>(std::move(asset_pack)))));
+}
+
+IgpackLoader::ExtractRawAssetPromiseT IgpackLoader::extract_raw_asset(
+    std::string asset_name,
+    std::shared_ptr<core::TaskList> extract_task_list) const {
+  if (streaming_state_) {
+    return streaming_state_->asset_promise(asset_name);
+  }
+
+  return file_promise_->then<ExtractRawAssetT>(
+      [asset_name](const PackContentsT& rsl) {
+        return find_raw_asset(rsl, asset_name);
+      },
+      extract_task_list);
 }
 
 IgpackLoader::ExtractDracoBufferPromiseT IgpackLoader::extract_draco_geo(
     std::string asset_name,
     std::shared_ptr<core::TaskList> extract_task_list) const {
-  return file_promise_->then<ExtractDracoBufferT>(
-      [asset_name](const core::Either<pb::AssetPack, IgpackExtractError>& rsl)
-          -> ExtractDracoBufferT {
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  return raw_asset_promise->then<ExtractDracoBufferT>(
+      [asset_name, cache = decoded_asset_cache_,
+       extract_task_list](const ExtractRawAssetT& rsl) -> ExtractDracoBufferT {
         if (rsl.is_right()) {
           return core::right(rsl.get_right());
         }
 
-        const auto& asset_pack = rsl.get_left();
-        for (int i = 0; i < asset_pack.assets_size(); i++) {
-          const auto& asset = asset_pack.assets(i);
-          if (asset.name() != asset_name) {
-            continue;
-          }
+        const IgpackAsset& igpack_asset = *rsl.get_left();
+        const pb::SingleAsset& asset = igpack_asset.asset();
+        if (!asset.has_draco_geo()) {
+          core::Logger::err(kLogLabel)
+              << "Resource " << asset_name << " is not a Draco resource";
+          return core::right(IgpackExtractError::WrongResourceType);
+        }
 
-          if (!asset.has_draco_geo()) {
-            core::Logger::err(kLogLabel)
-                << "Resource " << asset_name << " is not a Draco resource";
-            return core::right(IgpackExtractError::WrongResourceType);
-          }
+        auto decoder = std::make_shared<asset::DracoDecoder>();
+
+        DecodedAssetKey cache_key{};
+        bool cache_hit = false;
+        if (cache) {
+          cache_key = ::decoded_asset_key(asset_name, igpack_asset,
+                                          DracoDecoder::kDecodedVersion);
+          cache_hit =
+              ::load_cached_draco(cache.get(), cache_key, decoder.get());
+        }
 
-          auto decoder = std::make_shared<asset::DracoDecoder>();
-          const std::string& data = asset.draco_geo().data();
-          core::RawBuffer buffer((uint8_t*)&data[0], data.size(), false);
-          auto rsl = decoder->decode(buffer);
-          if (rsl != asset::DracoDecoderResult::Ok) {
+        if (!cache_hit) {
+          core::RawBuffer buffer(const_cast<uint8_t*>(igpack_asset.payload()),
+                                 igpack_asset.payload_size(), false);
+          auto decode_rsl = decoder->decode(buffer);
+          if (decode_rsl != asset::DracoDecoderResult::Ok) {
             core::Logger::err(kLogLabel)
                 << "Could not process Draco asset in " << asset_name << " - "
-                << ::to_string(rsl);
+                << ::to_string(decode_rsl);
             return core::right(IgpackExtractError::AssetExtractError);
           }
 
-          for (int bone_data_idx = 0;
-               bone_data_idx < asset.draco_geo().ozz_bone_names_size() &&
-               bone_data_idx < asset.draco_geo().inv_bind_pose_size();
-               bone_data_idx++) {
-            glm::mat4 inv_bind_pos{};
-            read_pb_mat4(inv_bind_pos,
-                         asset.draco_geo().inv_bind_pose(bone_data_idx));
-            decoder->add_bone_data(
-                asset.draco_geo().ozz_bone_names(bone_data_idx), inv_bind_pos);
+          if (cache) {
+            ::schedule_cache_write(cache, std::move(cache_key),
+                                   decoder->serialize_decoded(),
+                                   extract_task_list);
           }
+        }
 
-          return core::left(std::move(decoder));
+        for (int bone_data_idx = 0;
+             bone_data_idx < asset.draco_geo().ozz_bone_names_size() &&
+             bone_data_idx < asset.draco_geo().inv_bind_pose_size();
+             bone_data_idx++) {
+          glm::mat4 inv_bind_pos{};
+          read_pb_mat4(inv_bind_pos,
+                       asset.draco_geo().inv_bind_pose(bone_data_idx));
+          decoder->add_bone_data(
+              asset.draco_geo().ozz_bone_names(bone_data_idx), inv_bind_pos);
         }
 
-        // Asset was not found if returning here
-        return core::right(IgpackExtractError::ResourceNotFound);
+        return core::left(std::move(decoder));
       },
       extract_task_list);
 }
 
-IgpackLoader::ExtractWgslShaderPromiseT IgpackLoader::extract_wgsl_shader(
+IgpackLoader::ExtractRawMeshPromiseT IgpackLoader::extract_raw_mesh(
     std::string asset_name,
     std::shared_ptr<core::TaskList> extract_task_list) const {
-  auto existing_promise = wgsl_promises_.find(asset_name);
-  if (existing_promise != wgsl_promises_.end()) {
-    return existing_promise->second;
-  }
-
-  ExtractWgslShaderPromiseT rsl = file_promise_->then<ExtractWgslShaderT>(
-      [asset_name](const core::Either<pb::AssetPack, IgpackExtractError>& rsl)
-          -> ExtractWgslShaderT {
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  return raw_asset_promise->then<ExtractRawMeshT>(
+      [asset_name](const ExtractRawAssetT& rsl) -> ExtractRawMeshT {
         if (rsl.is_right()) {
           return core::right(rsl.get_right());
         }
 
-        const auto& asset_pack = rsl.get_left();
-        for (int i = 0; i < asset_pack.assets_size(); i++) {
-          const auto& asset = asset_pack.assets(i);
-          if (asset.name() != asset_name) {
-            continue;
-          }
-
-          if (!asset.has_wgsl_source()) {
+        auto mesh_rsl = RawMesh::Create(rsl.get_left());
+        if (mesh_rsl.is_right()) {
+          if (mesh_rsl.get_right() == RawMeshResult::WrongAssetType) {
             core::Logger::err(kLogLabel)
-                << "Resource " << asset_name << " is not a WGSL source";
+                << "Resource " << asset_name << " is not a raw mesh resource";
             return core::right(IgpackExtractError::WrongResourceType);
           }
 
-          return core::left(asset.wgsl_source());
-        }
-
-        core::Logger::err(kLogLabel)
-            << "WGSL resource " << asset_name << " not found!";
-        for (int i = 0; i < asset_pack.assets_size(); i++) {
           core::Logger::err(kLogLabel)
-              << "-- asset " << i << " : " << asset_pack.assets(i).name();
+              << "Could not process raw mesh asset in " << asset_name << " - "
+              << asset::to_string(mesh_rsl.get_right());
+          return core::right(IgpackExtractError::AssetExtractError);
         }
-        return core::right(IgpackLoader::IgpackExtractError::ResourceNotFound);
+
+        return core::left(mesh_rsl.left_move());
       },
       extract_task_list);
-  wgsl_promises_.insert({asset_name, rsl});
-  return rsl;
 }
 
-IgpackLoader::ExtractRgbaImagePromiseT IgpackLoader::extract_rgba_image(
+IgpackLoader::ExtractCompressedTexturePromiseT
+IgpackLoader::extract_compressed_texture(
     std::string asset_name,
     std::shared_ptr<core::TaskList> extract_task_list) const {
-  return file_promise_->then<ExtractRgbaImageDataT>(
-      [asset_name](const auto& rsl) -> ExtractRgbaImageDataT {
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  return raw_asset_promise->then<ExtractCompressedTextureT>(
+      [asset_name](const ExtractRawAssetT& rsl) -> ExtractCompressedTextureT {
         if (rsl.is_right()) {
           return core::right(rsl.get_right());
         }
 
-        const asset::pb::AssetPack& asset_pack = rsl.get_left();
-        for (int i = 0; i < asset_pack.assets_size(); i++) {
-          const auto& asset = asset_pack.assets(i);
-          if (asset.name() != asset_name) {
-            continue;
-          }
-
-          if (!asset.has_png_texture_def()) {
+        auto texture_rsl = CompressedTexture::Create(rsl.get_left());
+        if (texture_rsl.is_right()) {
+          if (texture_rsl.get_right() ==
+              CompressedTextureResult::WrongAssetType) {
             core::Logger::err(kLogLabel)
-                << "Resource " << asset_name << " is not a PNG image source";
+                << "Resource " << asset_name
+                << " is not a compressed texture resource";
             return core::right(IgpackExtractError::WrongResourceType);
           }
 
-          auto& png_texture_def = asset.png_texture_def();
+          core::Logger::err(kLogLabel)
+              << "Could not process compressed texture asset in "
+              << asset_name << " - "
+              << asset::to_string(texture_rsl.get_right());
+          return core::right(IgpackExtractError::AssetExtractError);
+        }
 
-          auto rgba_image_rsl = RgbaImage::ParsePNG(png_texture_def.data());
-          if (rgba_image_rsl.is_right()) {
+        return core::left(texture_rsl.left_move());
+      },
+      extract_task_list);
+}
+
+IgpackLoader::ExtractWgslShaderPromiseT IgpackLoader::extract_wgsl_shader(
+    std::string asset_name,
+    std::shared_ptr<core::TaskList> extract_task_list) const {
+  auto existing_promise = wgsl_promises_.find(asset_name);
+  if (existing_promise != wgsl_promises_.end()) {
+    return existing_promise->second;
+  }
+
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  ExtractWgslShaderPromiseT rsl = raw_asset_promise->then<ExtractWgslShaderT>(
+      [asset_name](const ExtractRawAssetT& rsl) -> ExtractWgslShaderT {
+        if (rsl.is_right()) {
+          if (rsl.get_right() == IgpackExtractError::ResourceNotFound) {
             core::Logger::err(kLogLabel)
-                << "Resource " << asset_name << " could not be decoded as PNG";
-            return core::right(IgpackExtractError::AssetExtractError);
+                << "WGSL resource " << asset_name << " not found!";
           }
+          return core::right(rsl.get_right());
+        }
 
-          return core::left(rgba_image_rsl.left_move());
+        const pb::SingleAsset& asset = rsl.get_left()->asset();
+        if (!asset.has_wgsl_source()) {
+          core::Logger::err(kLogLabel)
+              << "Resource " << asset_name << " is not a WGSL source";
+          return core::right(IgpackExtractError::WrongResourceType);
         }
 
-        return core::right(IgpackExtractError::ResourceNotFound);
+        return core::left(asset.wgsl_source());
       },
       extract_task_list);
+  wgsl_promises_.insert({asset_name, rsl});
+  return rsl;
 }
 
-IgpackLoader::ExtractDetourNavmeshPromiseT IgpackLoader::extract_detour_navmesh(
+IgpackLoader::ExtractTerrainChunksDefPromiseT
+IgpackLoader::extract_terrain_chunks_def(
     std::string asset_name,
     std::shared_ptr<core::TaskList> extract_task_list) const {
-  return file_promise_->then<ExtractDetourNavmeshDataT>(
-      [asset_name](const auto& rsl) -> ExtractDetourNavmeshDataT {
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  return raw_asset_promise->then<ExtractTerrainChunksDefT>(
+      [asset_name](const ExtractRawAssetT& rsl) -> ExtractTerrainChunksDefT {
         if (rsl.is_right()) {
           return core::right(rsl.get_right());
         }
 
-        const asset::pb::AssetPack& asset_pack = rsl.get_left();
-        for (int i = 0; i < asset_pack.assets_size(); i++) {
-          const auto& asset = asset_pack.assets(i);
-          if (asset.name() != asset_name) {
-            continue;
-          }
+        const pb::SingleAsset& asset = rsl.get_left()->asset();
+        if (!asset.has_terrain_chunks_def()) {
+          core::Logger::err(kLogLabel)
+              << "Resource " << asset_name << " is not a terrain chunks def";
+          return core::right(IgpackExtractError::WrongResourceType);
+        }
 
-          if (!asset.has_detour_navmesh_def()) {
-            core::Logger::err(kLogLabel) << "Resource " << asset_name
-                                         << " is not a Detour navmesh source";
-            return core::right(IgpackExtractError::WrongResourceType);
-          }
+        return core::left(asset.terrain_chunks_def());
+      },
+      extract_task_list);
+}
 
-          const auto& navmesh_def = asset.detour_navmesh_def();
+IgpackLoader::ExtractRgbaImagePromiseT IgpackLoader::extract_rgba_image(
+    std::string asset_name,
+    std::shared_ptr<core::TaskList> extract_task_list) const {
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  return raw_asset_promise->then<ExtractRgbaImageDataT>(
+      [asset_name, cache = decoded_asset_cache_, extract_task_list](
+          const ExtractRawAssetT& rsl) -> ExtractRgbaImageDataT {
+        if (rsl.is_right()) {
+          return core::right(rsl.get_right());
+        }
 
-          core::RawBuffer b(navmesh_def.raw_detour_data().size());
-          memcpy(b.get(), &navmesh_def.raw_detour_data()[0], b.size());
+        const IgpackAsset& igpack_asset = *rsl.get_left();
+        if (!igpack_asset.asset().has_png_texture_def()) {
+          core::Logger::err(kLogLabel)
+              << "Resource " << asset_name << " is not a PNG image source";
+          return core::right(IgpackExtractError::WrongResourceType);
+        }
 
-          auto navmesh_rsl =
-              nav::RecastCompiler::navmesh_from_raw(std::move(b));
-          if (navmesh_rsl.is_empty()) {
-            return core::right(IgpackExtractError::AssetExtractError);
+        DecodedAssetKey cache_key{};
+        if (cache) {
+          cache_key = ::decoded_asset_key(asset_name, igpack_asset,
+                                          ::kRgbaImageCacheVersion);
+          auto cached_image = ::read_cached_rgba_image(cache.get(), cache_key);
+          if (cached_image.has_value()) {
+            return core::left(cached_image.move());
           }
+        }
 
-          return core::left(navmesh_rsl.move());
+        auto rgba_image_rsl = RgbaImage::ParsePNG(igpack_asset.payload_view());
+        if (rgba_image_rsl.is_right()) {
+          core::Logger::err(kLogLabel)
+              << "Resource " << asset_name << " could not be decoded as PNG";
+          return core::right(IgpackExtractError::AssetExtractError);
         }
 
-        return core::right(IgpackExtractError::ResourceNotFound);
+        if (cache) {
+          ::schedule_cache_write(
+              cache, std::move(cache_key),
+              ::serialize_rgba_image(rgba_image_rsl.get_left()),
+              extract_task_list);
+        }
+
+        return core::left(rgba_image_rsl.left_move());
       },
       extract_task_list);
 }
 
-IgpackLoader::ExtractOzzSkeletonPromiseT IgpackLoader::extract_ozz_skeleton(
+IgpackLoader::ExtractDetourNavmeshPromiseT IgpackLoader::extract_detour_navmesh(
     std::string asset_name,
     std::shared_ptr<core::TaskList> extract_task_list) const {
-  return file_promise_->then<ExtractOzzSkeletonT>(
-      [asset_name](const auto& rsl) -> ExtractOzzSkeletonT {
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  return raw_asset_promise->then<ExtractDetourNavmeshDataT>(
+      [asset_name](const ExtractRawAssetT& rsl) -> ExtractDetourNavmeshDataT {
         if (rsl.is_right()) {
           return core::right(rsl.get_right());
         }
 
-        const asset::pb::AssetPack& asset_pack = rsl.get_left();
-        for (int i = 0; i < asset_pack.assets_size(); i++) {
-          const auto& asset = asset_pack.assets(i);
-          if (asset.name() != asset_name) {
-            continue;
-          }
-
-          if (!asset.has_ozz_skeleton_def()) {
-            core::Logger::err(kLogLabel) << "Resource " << asset_name
-                                         << " is not an Ozz skeleton source";
-            return core::right(IgpackExtractError::WrongResourceType);
-          }
-
-          const auto& ozz_skeleton_def = asset.ozz_skeleton_def();
-
-          // TODO (sessamekesh): write a Stream implementation that can read
-          // straight from proto bytes
-          ozz::io::MemoryStream stream;
-          stream.Write(ozz_skeleton_def.ozz_data().c_str(),
-                       ozz_skeleton_def.ozz_data().size());
-          stream.Seek(0, ozz::io::Stream::kSet);
-
-          ozz::io::IArchive archive(&stream);
-          if (!archive.TestTag<ozz::animation::Skeleton>()) {
-            core::Logger::err(kLogLabel)
-                << "Raw data does not contain an OZZ skeleton";
-            return core::right(IgpackExtractError::AssetExtractError);
-          }
+        const IgpackAsset& igpack_asset = *rsl.get_left();
+        if (!igpack_asset.asset().has_detour_navmesh_def()) {
+          core::Logger::err(kLogLabel) << "Resource " << asset_name
+                                       << " is not a Detour navmesh source";
+          return core::right(IgpackExtractError::WrongResourceType);
+        }
 
-          ozz::animation::Skeleton skeleton;
-          archive >> skeleton;
+        // Detour takes ownership of (and patches) the navmesh data, so this
+        //  is the one payload that has to be copied out of the pack
+        core::RawBuffer b(igpack_asset.payload_size());
+        memcpy(b.get(), igpack_asset.payload(), b.size());
 
-          return core::left(std::move(skeleton));
+        auto navmesh_rsl = nav::RecastCompiler::navmesh_from_raw(std::move(b));
+        if (navmesh_rsl.is_empty()) {
+          return core::right(IgpackExtractError::AssetExtractError);
         }
 
-        return core::right(IgpackExtractError::ResourceNotFound);
+        return core::left(navmesh_rsl.move());
       },
       extract_task_list);
 }
 
-IgpackLoader::ExtractOzzAnimationPromiseT IgpackLoader::extract_ozz_animation(
+IgpackLoader::ExtractOzzSkeletonPromiseT IgpackLoader::extract_ozz_skeleton(
     std::string asset_name,
     std::shared_ptr<core::TaskList> extract_task_list) const {
-  return file_promise_->then<ExtractOzzAnimationT>(
-      [asset_name](const auto& rsl) -> ExtractOzzAnimationT {
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  return raw_asset_promise->then<ExtractOzzSkeletonT>(
+      [asset_name](const ExtractRawAssetT& rsl) -> ExtractOzzSkeletonT {
         if (rsl.is_right()) {
           return core::right(rsl.get_right());
         }
 
-        const asset::pb::AssetPack& asset_pack = rsl.get_left();
-        for (int i = 0; i < asset_pack.assets_size(); i++) {
-          const auto& asset = asset_pack.assets(i);
-          if (asset.name() != asset_name) {
-            continue;
-          }
-
-          if (!asset.has_ozz_animation_def()) {
-            core::Logger::err(kLogLabel) << "Resource " << asset_name
-                                         << " is not an Ozz animation source";
-            return core::right(IgpackExtractError::WrongResourceType);
-          }
+        const IgpackAsset& igpack_asset = *rsl.get_left();
+        if (!igpack_asset.asset().has_ozz_skeleton_def()) {
+          core::Logger::err(kLogLabel) << "Resource " << asset_name
+                                       << " is not an Ozz skeleton source";
+          return core::right(IgpackExtractError::WrongResourceType);
+        }
 
-          const auto& ozz_animation_def = asset.ozz_animation_def();
+        ConstMemoryStream stream(igpack_asset.payload(),
+                                 igpack_asset.payload_size());
+        ozz::io::IArchive archive(&stream);
+        if (!archive.TestTag<ozz::animation::Skeleton>()) {
+          core::Logger::err(kLogLabel)
+              << "Raw data does not contain an OZZ skeleton";
+          return core::right(IgpackExtractError::AssetExtractError);
+        }
 
-          // TODO (sessamekesh): write a Stream implementation that can read
-          // straight from proto bytes
-          ozz::io::MemoryStream stream;
-          stream.Write(ozz_animation_def.data().c_str(),
-                       ozz_animation_def.data().size());
-          stream.Seek(0, ozz::io::Stream::kSet);
+        ozz::animation::Skeleton skeleton;
+        archive >> skeleton;
 
-          ozz::io::IArchive archive(&stream);
-          if (!archive.TestTag<ozz::animation::Animation>()) {
-            core::Logger::err(kLogLabel)
-                << "Raw data does not contain an OZZ animation";
-            return core::right(IgpackExtractError::AssetExtractError);
-          }
+        return core::left(std::move(skeleton));
+      },
+      extract_task_list);
+}
 
-          ozz::animation::Animation raw_animation;
-          archive >> raw_animation;
+IgpackLoader::ExtractOzzAnimationPromiseT IgpackLoader::extract_ozz_animation(
+    std::string asset_name,
+    std::shared_ptr<core::TaskList> extract_task_list) const {
+  auto raw_asset_promise = extract_raw_asset(asset_name, extract_task_list);
+  return raw_asset_promise->then<ExtractOzzAnimationT>(
+      [asset_name](const ExtractRawAssetT& rsl) -> ExtractOzzAnimationT {
+        if (rsl.is_right()) {
+          return core::right(rsl.get_right());
+        }
 
-          core::Vector<std::string> bone_names(
-              ozz_animation_def.ozz_bone_names_size());
-          for (const std::string& bone_name :
-               ozz_animation_def.ozz_bone_names()) {
-            bone_names.push_back(bone_name);
-          }
+        const IgpackAsset& igpack_asset = *rsl.get_left();
+        if (!igpack_asset.asset().has_ozz_animation_def()) {
+          core::Logger::err(kLogLabel) << "Resource " << asset_name
+                                       << " is not an Ozz animation source";
+          return core::right(IgpackExtractError::WrongResourceType);
+        }
 
-          return core::left(std::move(raw_animation));
+        ConstMemoryStream stream(igpack_asset.payload(),
+                                 igpack_asset.payload_size());
+        ozz::io::IArchive archive(&stream);
+        if (!archive.TestTag<ozz::animation::Animation>()) {
+          core::Logger::err(kLogLabel)
+              << "Raw data does not contain an OZZ animation";
+          return core::right(IgpackExtractError::AssetExtractError);
         }
 
-        return core::right(IgpackExtractError::ResourceNotFound);
+        ozz::animation::Animation raw_animation;
+        archive >> raw_animation;
+
+        return core::left(std::move(raw_animation));
       },
       extract_task_list);
 }
@@ -5,11 +5,12 @@ using namespace indigo;
 using namespace asset;
 
 core::Either<GreyscaleImage, ParseError> GreyscaleImage::ParsePNG(
-    const std::string& raw_png_data) {
+    std::string_view raw_png_data) {
   int width, height, num_channels;
   auto* img_data =
-      stbi_load_from_memory((uint8_t*)&raw_png_data[0], raw_png_data.size(),
-                            &width, &height, &num_channels, 1);
+      stbi_load_from_memory((const uint8_t*)raw_png_data.data(),
+                            raw_png_data.size(), &width, &height,
+                            &num_channels, 1);
 
   if (img_data == nullptr) {
     return core::right(ParseError::ParseFailed);
@@ -34,11 +35,12 @@ core::Either<GreyscaleImage, ParseError> GreyscaleImage::ParsePNG(
 }
 
 core::Either<RgbaImage, ParseError> RgbaImage::ParsePNG(
-    const std::string& raw_png_data) {
+    std::string_view raw_png_data) {
   int width, height, num_channels;
   uint8_t* img_data =
-      stbi_load_from_memory((uint8_t*)&raw_png_data[0], raw_png_data.size(),
-                            &width, &height, &num_channels, 0);
+      stbi_load_from_memory((const uint8_t*)raw_png_data.data(),
+                            raw_png_data.size(), &width, &height,
+                            &num_channels, 0);
 
   if (img_data == nullptr) {
     return core::right(ParseError::ParseFailed);
@@ -69,11 +71,12 @@ core::Either<RgbaImage, ParseError> RgbaImage::ParsePNG(
 }
 
 core::Either<RgbImage, ParseError> RgbImage::ParsePNG(
-    const std::string& raw_png_data) {
+    std::string_view raw_png_data) {
   int width, height, num_channels;
   auto* img_data =
-      stbi_load_from_memory((uint8_t*)&raw_png_data[0], raw_png_data.size(),
-                            &width, &height, &num_channels, 1);
+      stbi_load_from_memory((const uint8_t*)raw_png_data.data(),
+                            raw_png_data.size(), &width, &height,
+                            &num_channels, 1);
 
   if (img_data == nullptr) {
     return core::right(ParseError::ParseFailed);
@@ -0,0 +1,287 @@
+#include <igasset/indexed_igpack.h>
+#include <igcore/log.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+const char* kLogLabel = "IndexedIgpack";
+
+uint64_t align_up(uint64_t offset) {
+  return (offset + IndexedIgpack::kBlobAlignment - 1u) &
+         ~(IndexedIgpack::kBlobAlignment - 1u);
+}
+
+// Bulk data field of an asset - moved into the payload blob in indexed packs
+const std::string* payload_field(const pb::SingleAsset& asset) {
+  switch (asset.asset_case()) {
+    case pb::SingleAsset::kPngTextureDef:
+      return &asset.png_texture_def().data();
+    case pb::SingleAsset::kDracoGeo:
+      return &asset.draco_geo().data();
+    case pb::SingleAsset::kDetourNavmeshDef:
+      return &asset.detour_navmesh_def().raw_detour_data();
+    case pb::SingleAsset::kOzzSkeletonDef:
+      return &asset.ozz_skeleton_def().ozz_data();
+    case pb::SingleAsset::kOzzAnimationDef:
+      return &asset.ozz_animation_def().data();
+    case pb::SingleAsset::kRawMeshDef:
+      return &asset.raw_mesh_def().data();
+    case pb::SingleAsset::kCompressedTextureDef:
+      return &asset.compressed_texture_def().data();
+    default:
+      return nullptr;
+  }
+}
+
+std::string* mutable_payload_field(pb::SingleAsset* asset) {
+  switch (asset->asset_case()) {
+    case pb::SingleAsset::kPngTextureDef:
+      return asset->mutable_png_texture_def()->mutable_data();
+    case pb::SingleAsset::kDracoGeo:
+      return asset->mutable_draco_geo()->mutable_data();
+    case pb::SingleAsset::kDetourNavmeshDef:
+      return asset->mutable_detour_navmesh_def()->mutable_raw_detour_data();
+    case pb::SingleAsset::kOzzSkeletonDef:
+      return asset->mutable_ozz_skeleton_def()->mutable_ozz_data();
+    case pb::SingleAsset::kOzzAnimationDef:
+      return asset->mutable_ozz_animation_def()->mutable_data();
+    case pb::SingleAsset::kRawMeshDef:
+      return asset->mutable_raw_mesh_def()->mutable_data();
+    case pb::SingleAsset::kCompressedTextureDef:
+      return asset->mutable_compressed_texture_def()->mutable_data();
+    default:
+      return nullptr;
+  }
+}
+
+bool range_ok(uint64_t offset, uint64_t size, size_t total_size) {
+  return offset <= total_size && size <= total_size - offset;
+}
+}  // namespace
+
+//
+// IgpackAsset
+//
+IgpackAsset IgpackAsset::FromProto(const pb::SingleAsset& asset) {
+  const std::string* payload = ::payload_field(asset);
+  if (payload == nullptr) {
+    return IgpackAsset(&asset, nullptr, 0u);
+  }
+
+  return IgpackAsset(&asset,
+                     reinterpret_cast<const uint8_t*>(payload->data()),
+                     payload->size());
+}
+
+IgpackAsset::IgpackAsset(pb::SingleAsset meta, const uint8_t* payload,
+                         size_t payload_size)
+    : external_asset_(nullptr),
+      meta_(std::move(meta)),
+      payload_(payload),
+      payload_size_(payload_size) {}
+
+IgpackAsset::IgpackAsset(const pb::SingleAsset* external_asset,
+                         const uint8_t* payload, size_t payload_size)
+    : external_asset_(external_asset),
+      payload_(payload),
+      payload_size_(payload_size) {}
+
+const pb::SingleAsset& IgpackAsset::asset() const {
+  return external_asset_ ? *external_asset_ : meta_;
+}
+
+std::string_view IgpackAsset::payload_view() const {
+  return std::string_view(reinterpret_cast<const char*>(payload_),
+                          payload_size_);
+}
+
+//
+// IndexedIgpack
+//
+std::string IndexedIgpack::IndexedPathFor(const std::string& igpack_path) {
+  return std::filesystem::path(igpack_path)
+      .replace_extension(kFileExtension)
+      .string();
+}
+
+bool IndexedIgpack::HasIndexedHeader(const uint8_t* data, size_t size) {
+  return size >= sizeof(IndexedIgpackHeader) &&
+         std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+}
+
+std::string IndexedIgpack::Serialize(const pb::AssetPack& asset_pack) {
+  std::vector<int> order(asset_pack.assets_size());
+  for (int i = 0; i < asset_pack.assets_size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&asset_pack](int a, int b) {
+                     return asset_pack.assets(a).name() <
+                            asset_pack.assets(b).name();
+                   });
+
+  IndexedIgpackHeader header{};
+  std::memcpy(header.Magic, kMagic, sizeof(kMagic));
+  header.Version = kVersion;
+  header.EntryCount = static_cast<uint32_t>(order.size());
+
+  std::vector<IndexedIgpackTocEntry> toc(order.size());
+  std::string names;
+  for (size_t i = 0; i < order.size(); i++) {
+    const std::string& name = asset_pack.assets(order[i]).name();
+    toc[i].NameOffset = static_cast<uint32_t>(names.size());
+    toc[i].NameSize = static_cast<uint32_t>(name.size());
+    names += name;
+  }
+
+  header.StringTableOffset =
+      sizeof(IndexedIgpackHeader) + sizeof(IndexedIgpackTocEntry) * toc.size();
+  header.StringTableSize = names.size();
+
+  std::string blobs;
+  uint64_t blob_start = align_up(header.StringTableOffset + names.size());
+  auto append_blob = [&blobs, blob_start](std::string_view blob) -> uint64_t {
+    blobs.resize(align_up(blob_start + blobs.size()) - blob_start, '\0');
+    uint64_t offset = blob_start + blobs.size();
+    blobs.append(blob);
+    return offset;
+  };
+
+  for (size_t i = 0; i < order.size(); i++) {
+    pb::SingleAsset meta = asset_pack.assets(order[i]);
+    toc[i].AssetType = static_cast<uint32_t>(meta.asset_case());
+
+    std::string payload;
+    std::string* payload_field = ::mutable_payload_field(&meta);
+    if (payload_field != nullptr) {
+      payload.swap(*payload_field);
+    }
+
+    std::string meta_bin = meta.SerializeAsString();
+    toc[i].MetaOffset = append_blob(meta_bin);
+    toc[i].MetaSize = static_cast<uint32_t>(meta_bin.size());
+    toc[i].PayloadOffset = append_blob(payload);
+    toc[i].PayloadSize = payload.size();
+  }
+
+  std::string out;
+  out.reserve(blob_start + blobs.size());
+  out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.append(reinterpret_cast<const char*>(toc.data()),
+             sizeof(IndexedIgpackTocEntry) * toc.size());
+  out.append(names);
+  out.resize(blob_start, '\0');
+  out.append(blobs);
+
+  return out;
+}
+
+core::Maybe<std::shared_ptr<IndexedIgpack>> IndexedIgpack::Open(
+    std::shared_ptr<const void> owner, const uint8_t* data, size_t size) {
+  if (!HasIndexedHeader(data, size)) {
+    core::Logger::err(kLogLabel) << "Missing indexed igpack header";
+    return core::empty_maybe{};
+  }
+
+  IndexedIgpackHeader header{};
+  std::memcpy(&header, data, sizeof(header));
+  if (header.Version != kVersion) {
+    core::Logger::err(kLogLabel)
+        << "Unsupported indexed igpack version " << header.Version;
+    return core::empty_maybe{};
+  }
+
+  uint64_t toc_size =
+      static_cast<uint64_t>(header.EntryCount) * sizeof(IndexedIgpackTocEntry);
+  if (!::range_ok(sizeof(IndexedIgpackHeader), toc_size, size) ||
+      !::range_ok(header.StringTableOffset, header.StringTableSize, size)) {
+    core::Logger::err(kLogLabel) << "Indexed igpack table of contents is "
+                                    "larger than the file";
+    return core::empty_maybe{};
+  }
+
+  // Only the table of contents is checked here - blobs are not touched until
+  //  an asset is actually read, so opening a pack does not page it all in
+  const auto* toc = reinterpret_cast<const IndexedIgpackTocEntry*>(
+      data + sizeof(IndexedIgpackHeader));
+  const char* names =
+      reinterpret_cast<const char*>(data) + header.StringTableOffset;
+  std::string_view prev_name;
+  for (uint32_t i = 0; i < header.EntryCount; i++) {
+    if (!::range_ok(toc[i].NameOffset, toc[i].NameSize,
+                    header.StringTableSize) ||
+        !::range_ok(toc[i].MetaOffset, toc[i].MetaSize, size) ||
+        !::range_ok(toc[i].PayloadOffset, toc[i].PayloadSize, size)) {
+      core::Logger::err(kLogLabel)
+          << "Indexed igpack entry " << i << " is out of bounds";
+      return core::empty_maybe{};
+    }
+
+    // find_entry binary searches by name
+    std::string_view name(names + toc[i].NameOffset, toc[i].NameSize);
+    if (name < prev_name) {
+      core::Logger::err(kLogLabel)
+          << "Indexed igpack entry " << i << " is out of name order";
+      return core::empty_maybe{};
+    }
+    prev_name = name;
+  }
+
+  return std::make_shared<IndexedIgpack>(std::move(owner), data, size);
+}
+
+IndexedIgpack::IndexedIgpack(std::shared_ptr<const void> owner,
+                             const uint8_t* data, size_t size)
+    : owner_(std::move(owner)),
+      data_(data),
+      size_(size),
+      header_(reinterpret_cast<const IndexedIgpackHeader*>(data)),
+      toc_(reinterpret_cast<const IndexedIgpackTocEntry*>(
+          data + sizeof(IndexedIgpackHeader))),
+      names_(reinterpret_cast<const char*>(data) +
+             header_->StringTableOffset) {}
+
+std::string_view IndexedIgpack::asset_name(uint32_t idx) const {
+  return std::string_view(names_ + toc_[idx].NameOffset, toc_[idx].NameSize);
+}
+
+const IndexedIgpackTocEntry* IndexedIgpack::find_entry(
+    std::string_view asset_name) const {
+  uint32_t lo = 0u;
+  uint32_t hi = header_->EntryCount;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2u;
+    int cmp = this->asset_name(mid).compare(asset_name);
+    if (cmp == 0) {
+      return &toc_[mid];
+    }
+
+    if (cmp < 0) {
+      lo = mid + 1u;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return nullptr;
+}
+
+core::Maybe<IgpackAsset> IndexedIgpack::read_asset(
+    const IndexedIgpackTocEntry& entry) const {
+  pb::SingleAsset meta;
+  if (!meta.ParseFromArray(data_ + entry.MetaOffset, entry.MetaSize) ||
+      static_cast<uint32_t>(meta.asset_case()) != entry.AssetType) {
+    core::Logger::err(kLogLabel) << "Malformed metadata for indexed asset "
+                                 << meta.name();
+    return core::empty_maybe{};
+  }
+
+  return IgpackAsset(std::move(meta), data_ + entry.PayloadOffset,
+                     entry.PayloadSize);
+}
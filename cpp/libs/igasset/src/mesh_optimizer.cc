@@ -0,0 +1,219 @@
+#include <igasset/mesh_optimizer.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriScore = 0.75f;
+constexpr float kValenceBoostScale = 2.f;
+constexpr float kValenceBoostPower = 0.5f;
+
+constexpr uint32_t kCacheSize = MeshOptimizer::kMaxCacheSize;
+
+float vertex_score(int cache_position, uint32_t remaining_valence) {
+  if (remaining_valence == 0u) {
+    // No triangles left to emit that use this vertex
+    return -1.f;
+  }
+
+  float score = 0.f;
+  if (cache_position >= 0) {
+    if (cache_position < 3) {
+      // Used by the triangle just emitted - fixed score, so that the order of
+      //  that triangle's vertices does not matter
+      score = kLastTriScore;
+    } else {
+      const float scaler = 1.f / (kCacheSize - 3);
+      score = std::pow(1.f - (cache_position - 3) * scaler, kCacheDecayPower);
+    }
+  }
+
+  // Favor vertices with few triangles left, so that lone triangles are not
+  //  left behind to be picked up (with no cache reuse) at the end
+  score += kValenceBoostScale *
+           std::pow(static_cast<float>(remaining_valence), -kValenceBoostPower);
+  return score;
+}
+}  // namespace
+
+void MeshOptimizer::optimize_vertex_cache(uint32_t* indices,
+                                          size_t index_count,
+                                          uint32_t vertex_count) {
+  const size_t tri_count = index_count / 3u;
+  if (tri_count < 2u) {
+    return;
+  }
+
+  // Vertex -> triangle adjacency (CSR) - the first "remaining[v]" entries of a
+  //  vertex's range are the triangles that have not been emitted yet
+  std::vector<uint32_t> remaining(vertex_count, 0u);
+  for (size_t i = 0; i < tri_count * 3u; i++) {
+    remaining[indices[i]]++;
+  }
+
+  std::vector<uint32_t> adjacency_offset(vertex_count + 1u, 0u);
+  for (uint32_t v = 0; v < vertex_count; v++) {
+    adjacency_offset[v + 1u] = adjacency_offset[v] + remaining[v];
+  }
+
+  std::vector<uint32_t> adjacency(tri_count * 3u);
+  {
+    std::vector<uint32_t> fill(adjacency_offset.begin(),
+                               adjacency_offset.end() - 1);
+    for (size_t t = 0; t < tri_count; t++) {
+      for (int k = 0; k < 3; k++) {
+        uint32_t v = indices[t * 3u + k];
+        adjacency[fill[v]++] = static_cast<uint32_t>(t);
+      }
+    }
+  }
+
+  std::vector<int> cache_position(vertex_count, -1);
+  std::vector<float> vert_score(vertex_count);
+  for (uint32_t v = 0; v < vertex_count; v++) {
+    vert_score[v] = ::vertex_score(-1, remaining[v]);
+  }
+
+  std::vector<float> tri_score(tri_count);
+  std::vector<bool> emitted(tri_count, false);
+  for (size_t t = 0; t < tri_count; t++) {
+    tri_score[t] = vert_score[indices[t * 3u]] +
+                   vert_score[indices[t * 3u + 1u]] +
+                   vert_score[indices[t * 3u + 2u]];
+  }
+
+  std::vector<uint32_t> output(tri_count * 3u);
+  std::vector<uint32_t> cache;
+  std::vector<uint32_t> next_cache;
+  cache.reserve(kCacheSize + 3u);
+  next_cache.reserve(kCacheSize + 3u);
+
+  size_t scan_cursor = 0u;
+  size_t best_tri = 0u;
+  for (size_t t = 1; t < tri_count; t++) {
+    if (tri_score[t] > tri_score[best_tri]) {
+      best_tri = t;
+    }
+  }
+
+  for (size_t out_tri = 0; out_tri < tri_count; out_tri++) {
+    if (best_tri == tri_count) {
+      // Nothing adjacent to the cache - take the next triangle in input order
+      while (emitted[scan_cursor]) {
+        scan_cursor++;
+      }
+      best_tri = scan_cursor;
+    }
+
+    emitted[best_tri] = true;
+    const uint32_t* tri = indices + best_tri * 3u;
+    for (int k = 0; k < 3; k++) {
+      uint32_t v = tri[k];
+      output[out_tri * 3u + k] = v;
+
+      uint32_t begin = adjacency_offset[v];
+      uint32_t end = begin + remaining[v];
+      for (uint32_t a = begin; a < end; a++) {
+        if (adjacency[a] == best_tri) {
+          std::swap(adjacency[a], adjacency[end - 1u]);
+          remaining[v]--;
+          break;
+        }
+      }
+    }
+
+    // Emitted triangle goes to the front of the (LRU) cache
+    next_cache.clear();
+    for (int k = 0; k < 3; k++) {
+      if (std::find(next_cache.begin(), next_cache.end(), tri[k]) ==
+          next_cache.end()) {
+        next_cache.push_back(tri[k]);
+      }
+    }
+    for (uint32_t v : cache) {
+      if (std::find(next_cache.begin(), next_cache.end(), v) ==
+          next_cache.end()) {
+        next_cache.push_back(v);
+      }
+    }
+    cache.swap(next_cache);
+
+    for (size_t i = 0; i < cache.size(); i++) {
+      uint32_t v = cache[i];
+      cache_position[v] = i < kCacheSize ? static_cast<int>(i) : -1;
+      vert_score[v] = ::vertex_score(cache_position[v], remaining[v]);
+    }
+
+    // Only triangles touching the cache changed score - the best of them is
+    //  the next triangle to emit
+    best_tri = tri_count;
+    float best_score = -1.f;
+    for (uint32_t v : cache) {
+      uint32_t begin = adjacency_offset[v];
+      uint32_t end = begin + remaining[v];
+      for (uint32_t a = begin; a < end; a++) {
+        uint32_t t = adjacency[a];
+        const uint32_t* adj_tri = indices + t * 3u;
+        tri_score[t] = vert_score[adj_tri[0]] + vert_score[adj_tri[1]] +
+                       vert_score[adj_tri[2]];
+        if (tri_score[t] > best_score) {
+          best_score = tri_score[t];
+          best_tri = t;
+        }
+      }
+    }
+
+    if (cache.size() > kCacheSize) {
+      cache.resize(kCacheSize);
+    }
+  }
+
+  std::copy(output.begin(), output.end(), indices);
+}
+
+uint32_t MeshOptimizer::optimize_vertex_fetch(uint32_t* indices,
+                                              size_t index_count,
+                                              uint32_t vertex_count,
+                                              std::vector<uint32_t>* remap) {
+  remap->assign(vertex_count, kUnusedVertex);
+
+  uint32_t next_vertex = 0u;
+  for (size_t i = 0; i < index_count; i++) {
+    uint32_t& new_idx = (*remap)[indices[i]];
+    if (new_idx == kUnusedVertex) {
+      new_idx = next_vertex++;
+    }
+    indices[i] = new_idx;
+  }
+
+  return next_vertex;
+}
+
+float MeshOptimizer::average_cache_miss_ratio(const uint32_t* indices,
+                                              size_t index_count,
+                                              uint32_t vertex_count,
+                                              uint32_t cache_size) {
+  const size_t tri_count = index_count / 3u;
+  if (tri_count == 0u) {
+    return 0.f;
+  }
+
+  // FIFO cache - "cached_at[v]" is the miss count when v was last loaded
+  std::vector<size_t> cached_at(vertex_count, 0u);
+  std::vector<bool> ever_cached(vertex_count, false);
+  size_t misses = 0u;
+  for (size_t i = 0; i < tri_count * 3u; i++) {
+    uint32_t v = indices[i];
+    if (!ever_cached[v] || misses - cached_at[v] >= cache_size) {
+      ever_cached[v] = true;
+      cached_at[v] = misses;
+      misses++;
+    }
+  }
+
+  return static_cast<float>(misses) / tri_count;
+}
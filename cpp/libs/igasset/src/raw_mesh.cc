@@ -0,0 +1,225 @@
+#include <igasset/proto_converters.h>
+#include <igasset/raw_mesh.h>
+#include <igcore/log.h>
+#include <igcore/lz4.h>
+
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <vector>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+const char* kLogLabel = "RawMesh";
+
+size_t expected_size(const pb::RawMeshDef& def) {
+  size_t vertex_size = sizeof(PositionNormalVertexData);
+  if (def.has_texcoords()) {
+    vertex_size += sizeof(TexcoordVertexData);
+  }
+  if (def.has_bone_data()) {
+    vertex_size += sizeof(SkeletalAnimationVertexData);
+  }
+
+  return vertex_size * def.vertex_count() +
+         sizeof(uint32_t) * static_cast<size_t>(def.index_count());
+}
+
+// Vertex structs are all float/uint32 arrays - payloads are aligned far past
+//  this in practice, but a protobuf string is not guaranteed to be
+bool is_aligned(const uint8_t* data) {
+  return reinterpret_cast<uintptr_t>(data) % alignof(PositionNormalVertexData) ==
+         0u;
+}
+}  // namespace
+
+std::string indigo::asset::to_string(RawMeshResult rsl) {
+  switch (rsl) {
+    case RawMeshResult::Ok:
+      return "Ok";
+    case RawMeshResult::WrongAssetType:
+      return "WrongAssetType";
+    case RawMeshResult::DecompressFailed:
+      return "DecompressFailed";
+    case RawMeshResult::SizeMismatch:
+      return "SizeMismatch";
+    case RawMeshResult::NoData:
+      return "NoData";
+    case RawMeshResult::BoneDataIncomplete:
+      return "BoneDataIncomplete";
+  }
+
+  return "<<RawMeshResult - Unknown>>";
+}
+
+core::Either<std::shared_ptr<const RawMesh>, RawMeshResult> RawMesh::Create(
+    std::shared_ptr<const IgpackAsset> asset) {
+  if (asset->asset().asset_case() != pb::SingleAsset::kRawMeshDef) {
+    return core::right(RawMeshResult::WrongAssetType);
+  }
+
+  const pb::RawMeshDef& def = asset->asset().raw_mesh_def();
+  const size_t data_size = ::expected_size(def);
+  if (def.uncompressed_size() != data_size) {
+    core::Logger::err(kLogLabel)
+        << "Mesh " << asset->asset().name() << " should be " << data_size
+        << " bytes, but is " << def.uncompressed_size();
+    return core::right(RawMeshResult::SizeMismatch);
+  }
+
+  if (def.codec() == pb::RawMeshDef::NONE) {
+    if (asset->payload_size() != data_size) {
+      core::Logger::err(kLogLabel)
+          << "Mesh " << asset->asset().name() << " payload is "
+          << asset->payload_size() << " bytes, expected " << data_size;
+      return core::right(RawMeshResult::SizeMismatch);
+    }
+
+    if (::is_aligned(asset->payload())) {
+      const uint8_t* data = asset->payload();
+      return core::left(std::make_shared<const RawMesh>(
+          std::move(asset), core::RawBuffer(0u), data));
+    }
+
+    core::RawBuffer copy(data_size);
+    std::memcpy(copy.get(), asset->payload(), data_size);
+    const uint8_t* data = copy.get();
+    return core::left(std::make_shared<const RawMesh>(std::move(asset),
+                                                      std::move(copy), data));
+  }
+
+  if (def.codec() != pb::RawMeshDef::LZ4) {
+    core::Logger::err(kLogLabel) << "Unsupported codec " << def.codec()
+                                 << " for mesh " << asset->asset().name();
+    return core::right(RawMeshResult::DecompressFailed);
+  }
+
+  core::RawBuffer decompressed(data_size);
+  if (!core::Lz4::decompress(asset->payload(), asset->payload_size(),
+                             decompressed.get(), data_size)) {
+    core::Logger::err(kLogLabel)
+        << "Failed to decompress mesh " << asset->asset().name();
+    return core::right(RawMeshResult::DecompressFailed);
+  }
+
+  const uint8_t* data = decompressed.get();
+  return core::left(std::make_shared<const RawMesh>(
+      std::move(asset), std::move(decompressed), data));
+}
+
+RawMesh::RawMesh(std::shared_ptr<const IgpackAsset> asset,
+                 core::RawBuffer decompressed, const uint8_t* data)
+    : asset_(std::move(asset)),
+      decompressed_(std::move(decompressed)),
+      vertex_count_(asset_->asset().raw_mesh_def().vertex_count()),
+      index_count_(asset_->asset().raw_mesh_def().index_count()),
+      pos_norm_(nullptr),
+      texcoords_(nullptr),
+      skeletal_(nullptr),
+      indices_(nullptr) {
+  const pb::RawMeshDef& def = asset_->asset().raw_mesh_def();
+
+  pos_norm_ = reinterpret_cast<const PositionNormalVertexData*>(data);
+  data += sizeof(PositionNormalVertexData) * vertex_count_;
+
+  if (def.has_texcoords()) {
+    texcoords_ = reinterpret_cast<const TexcoordVertexData*>(data);
+    data += sizeof(TexcoordVertexData) * vertex_count_;
+  }
+
+  if (def.has_bone_data()) {
+    skeletal_ = reinterpret_cast<const SkeletalAnimationVertexData*>(data);
+    data += sizeof(SkeletalAnimationVertexData) * vertex_count_;
+  }
+
+  indices_ = reinterpret_cast<const uint32_t*>(data);
+}
+
+RawMeshResult RawMesh::write_skeletal_animation_vertices(
+    const ozz::animation::Skeleton& ozz_skeleton, void* dest,
+    size_t stride) const {
+  const pb::RawMeshDef& def = asset_->asset().raw_mesh_def();
+  if (skeletal_ == nullptr || def.ozz_bone_names_size() == 0) {
+    return RawMeshResult::NoData;
+  }
+
+  // Mesh bone index -> ozz joint index. Same as DracoDecoder, bones missing
+  //  from the skeleton only fail the mesh if a vertex references one.
+  const uint32_t kMissingJoint = 0xFFFFFFFFu;
+  std::vector<uint32_t> bone_to_joint(def.ozz_bone_names_size(),
+                                      kMissingJoint);
+  {
+    std::map<std::string, int> name_to_skeleton_index;
+    auto joint_names = ozz_skeleton.joint_names();
+    for (int i = 0; i < joint_names.size(); i++) {
+      name_to_skeleton_index.emplace(joint_names[i], i);
+    }
+
+    for (int i = 0; i < def.ozz_bone_names_size(); i++) {
+      auto idx_it = name_to_skeleton_index.find(def.ozz_bone_names(i));
+      if (idx_it != name_to_skeleton_index.end()) {
+        bone_to_joint[i] = idx_it->second;
+      }
+    }
+  }
+
+  uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+  for (uint32_t vert_idx = 0; vert_idx < vertex_count_; vert_idx++) {
+    SkeletalAnimationVertexData vert = skeletal_[vert_idx];
+    for (int idx_idx = 0; idx_idx < 4; idx_idx++) {
+      if (vert.BoneIndices[idx_idx] >= bone_to_joint.size() ||
+          bone_to_joint[vert.BoneIndices[idx_idx]] == kMissingJoint) {
+        return RawMeshResult::BoneDataIncomplete;
+      }
+      vert.BoneIndices[idx_idx] = bone_to_joint[vert.BoneIndices[idx_idx]];
+    }
+
+    std::memcpy(out + vert_idx * stride, &vert, sizeof(vert));
+  }
+
+  return RawMeshResult::Ok;
+}
+
+core::Either<core::PodVector<SkeletalAnimationVertexData>, RawMeshResult>
+RawMesh::get_skeletal_animation_vertices(
+    const ozz::animation::Skeleton& ozz_skeleton) const {
+  core::PodVector<SkeletalAnimationVertexData> out(vertex_count_);
+  out.resize(vertex_count_);
+
+  const RawMeshResult rsl =
+      write_skeletal_animation_vertices(ozz_skeleton, out.raw());
+  if (rsl != RawMeshResult::Ok) {
+    return core::right(rsl);
+  }
+
+  return core::left(std::move(out));
+}
+
+core::Either<core::PodVector<glm::mat4>, RawMeshResult>
+RawMesh::get_inv_bind_poses(
+    const ozz::animation::Skeleton& ozz_skeleton) const {
+  const pb::RawMeshDef& def = asset_->asset().raw_mesh_def();
+  if (def.ozz_bone_names_size() == 0 ||
+      def.ozz_bone_names_size() != def.inv_bind_pose_size()) {
+    return core::right(RawMeshResult::BoneDataIncomplete);
+  }
+
+  auto joint_names = ozz_skeleton.joint_names();
+
+  core::PodVector<glm::mat4> inv_bind_poses(joint_names.size());
+  inv_bind_poses.resize(joint_names.size());
+  for (int i = 0; i < joint_names.size(); i++) {
+    inv_bind_poses[i] = glm::mat4(1.f);
+
+    for (int j = 0; j < def.ozz_bone_names_size(); j++) {
+      if (def.ozz_bone_names(j) == joint_names[i]) {
+        read_pb_mat4(inv_bind_poses[i], def.inv_bind_pose(j));
+        break;
+      }
+    }
+  }
+
+  return core::left(std::move(inv_bind_poses));
+}
@@ -0,0 +1,197 @@
+#include <igasset/mesh_optimizer.h>
+#include <igasset/raw_mesh_encoder.h>
+#include <igcore/log.h>
+#include <igcore/lz4.h>
+
+#include <cstring>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+const char* kLogLabel = "RawMeshEncoder";
+
+// Round a float to the nearest value with only "mantissa_bits" bits of
+//  mantissa. Infinities/NaNs (and values that would round up to infinity) are
+//  left alone.
+float round_mantissa(float value, uint8_t mantissa_bits) {
+  if (mantissa_bits >= 23u) {
+    return value;
+  }
+
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  if ((bits & 0x7F800000u) == 0x7F800000u) {
+    return value;
+  }
+
+  const uint32_t dropped_bits = 23u - mantissa_bits;
+  const uint32_t round_bit = 1u << (dropped_bits - 1u);
+  uint32_t rounded = (bits + round_bit) & ~((1u << dropped_bits) - 1u);
+  if ((rounded & 0x7F800000u) == 0x7F800000u) {
+    return value;
+  }
+
+  float out;
+  std::memcpy(&out, &rounded, sizeof(out));
+  return out;
+}
+
+template <typename T>
+void append_bytes(std::string* out, const std::vector<T>& data) {
+  out->append(reinterpret_cast<const char*>(data.data()),
+              data.size() * sizeof(T));
+}
+}  // namespace
+
+RawMeshEncoder::EncodeSettings::EncodeSettings()
+    : PositionMantissaBits(16u),
+      NormalMantissaBits(12u),
+      OptimizeVertexOrder(true),
+      Codec(pb::RawMeshDef::LZ4) {}
+
+RawMeshEncoder::RawMeshEncoder() : vertex_count_(0u) {}
+
+RawMeshEncoderResult RawMeshEncoder::validate_size(size_t size) {
+  if (size == 0u) {
+    core::Logger::err(kLogLabel) << "Input vertex data has 0 points, cannot use";
+    return RawMeshEncoderResult::NoData;
+  }
+
+  if (vertex_count_ == 0u) {
+    vertex_count_ = static_cast<uint32_t>(size);
+  } else if (vertex_count_ != size) {
+    core::Logger::err(kLogLabel)
+        << "Mesh has " << vertex_count_ << " points - input data has " << size
+        << " points. Vertex count must match!";
+    return RawMeshEncoderResult::BadVertexCount;
+  }
+
+  return RawMeshEncoderResult::Ok;
+}
+
+RawMeshEncoderResult RawMeshEncoder::add_pos_norm_data(
+    const core::PodVector<PositionNormalVertexData>& data) {
+  auto size_rsl = validate_size(data.size());
+  if (size_rsl != RawMeshEncoderResult::Ok) {
+    return size_rsl;
+  }
+
+  pos_norm_.assign(data.raw(), data.raw() + data.size());
+  return RawMeshEncoderResult::Ok;
+}
+
+RawMeshEncoderResult RawMeshEncoder::add_texcoord_data(
+    const core::PodVector<TexcoordVertexData>& data) {
+  auto size_rsl = validate_size(data.size());
+  if (size_rsl != RawMeshEncoderResult::Ok) {
+    return size_rsl;
+  }
+
+  texcoords_.assign(data.raw(), data.raw() + data.size());
+  return RawMeshEncoderResult::Ok;
+}
+
+RawMeshEncoderResult RawMeshEncoder::add_skeletal_animation_data(
+    const core::PodVector<SkeletalAnimationVertexData>& data) {
+  auto size_rsl = validate_size(data.size());
+  if (size_rsl != RawMeshEncoderResult::Ok) {
+    return size_rsl;
+  }
+
+  skeletal_.assign(data.raw(), data.raw() + data.size());
+  return RawMeshEncoderResult::Ok;
+}
+
+RawMeshEncoderResult RawMeshEncoder::add_index_data(
+    const core::PodVector<uint32_t>& data) {
+  if (data.size() % 3 != 0) {
+    core::Logger::err(kLogLabel) << "Invalid number of triangle indices "
+                                 << data.size() << " - must be divisible by 3";
+    return RawMeshEncoderResult::BadTriangleIndexCount;
+  }
+
+  if (data.size() == 0) {
+    core::Logger::err(kLogLabel)
+        << "Cannot set triangles with empty index array";
+    return RawMeshEncoderResult::NoData;
+  }
+
+  indices_.assign(data.raw(), data.raw() + data.size());
+  return RawMeshEncoderResult::Ok;
+}
+
+core::Either<pb::RawMeshDef, RawMeshEncoderResult> RawMeshEncoder::encode(
+    EncodeSettings settings) const {
+  if (pos_norm_.size() == 0u || indices_.size() == 0u) {
+    core::Logger::err(kLogLabel)
+        << "Position/normal and index data are required to encode a mesh";
+    return core::right(RawMeshEncoderResult::NoData);
+  }
+
+  for (uint32_t idx : indices_) {
+    if (idx >= vertex_count_) {
+      core::Logger::err(kLogLabel) << "Index " << idx << " is out of range for "
+                                   << vertex_count_ << " vertices";
+      return core::right(RawMeshEncoderResult::IndexOutOfRange);
+    }
+  }
+
+  std::vector<uint32_t> indices = indices_;
+  std::vector<PositionNormalVertexData> pos_norm = pos_norm_;
+  std::vector<TexcoordVertexData> texcoords = texcoords_;
+  std::vector<SkeletalAnimationVertexData> skeletal = skeletal_;
+
+  if (settings.OptimizeVertexOrder) {
+    MeshOptimizer::optimize_vertex_cache(indices.data(), indices.size(),
+                                         vertex_count_);
+
+    std::vector<uint32_t> remap;
+    uint32_t new_vertex_count = MeshOptimizer::optimize_vertex_fetch(
+        indices.data(), indices.size(), vertex_count_, &remap);
+    pos_norm = MeshOptimizer::remap_vertices(pos_norm.data(), vertex_count_,
+                                             remap, new_vertex_count);
+    if (!texcoords.empty()) {
+      texcoords = MeshOptimizer::remap_vertices(
+          texcoords.data(), vertex_count_, remap, new_vertex_count);
+    }
+    if (!skeletal.empty()) {
+      skeletal = MeshOptimizer::remap_vertices(skeletal.data(), vertex_count_,
+                                               remap, new_vertex_count);
+    }
+  }
+
+  for (PositionNormalVertexData& v : pos_norm) {
+    for (int i = 0; i < 3; i++) {
+      v.Position[i] = ::round_mantissa(v.Position[i],
+                                       settings.PositionMantissaBits);
+    }
+    for (int i = 0; i < 4; i++) {
+      v.NormalQuat[i] =
+          ::round_mantissa(v.NormalQuat[i], settings.NormalMantissaBits);
+    }
+  }
+
+  std::string data;
+  ::append_bytes(&data, pos_norm);
+  ::append_bytes(&data, texcoords);
+  ::append_bytes(&data, skeletal);
+  ::append_bytes(&data, indices);
+
+  pb::RawMeshDef def;
+  def.set_vertex_count(static_cast<uint32_t>(pos_norm.size()));
+  def.set_index_count(static_cast<uint32_t>(indices.size()));
+  def.set_has_texcoords(!texcoords.empty());
+  def.set_has_bone_data(!skeletal.empty());
+  def.set_uncompressed_size(data.size());
+  def.set_codec(settings.Codec);
+
+  if (settings.Codec == pb::RawMeshDef::LZ4) {
+    def.set_data(core::Lz4::compress(
+        reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+  } else {
+    def.set_data(std::move(data));
+  }
+
+  return core::left(std::move(def));
+}
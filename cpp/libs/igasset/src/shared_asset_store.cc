@@ -0,0 +1,77 @@
+#include <igasset/shared_asset_store.h>
+#include <igcore/log.h>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+const char* kLogLabel = "SharedAssetStore";
+}  // namespace
+
+std::shared_ptr<SharedAssetStore> SharedAssetStore::Global() {
+  static std::shared_ptr<SharedAssetStore> store =
+      std::make_shared<SharedAssetStore>();
+  return store;
+}
+
+SharedAssetStore::SharedAssetStore() : loads_started_(0ull) {}
+
+SharedAssetStore::AssetPromiseT<nav::DetourNavmesh>
+SharedAssetStore::detour_navmesh(std::string igpack_path,
+                                 std::string asset_name,
+                                 std::shared_ptr<core::TaskList> task_list) {
+  return acquire<nav::DetourNavmesh>(
+      igpack_path, asset_name,
+      [igpack_path, asset_name, task_list]() {
+        core::Logger::log(kLogLabel)
+            << "Loading shared navmesh " << igpack_path << ":" << asset_name;
+
+        IgpackLoader loader(igpack_path, task_list);
+        return loader.extract_detour_navmesh(asset_name, task_list)
+            ->then_consuming<AssetT<nav::DetourNavmesh>>(
+                [](IgpackLoader::ExtractDetourNavmeshDataT rsl)
+                    -> AssetT<nav::DetourNavmesh> {
+                  if (rsl.is_right()) {
+                    return core::right(rsl.get_right());
+                  }
+                  return core::left(std::shared_ptr<const nav::DetourNavmesh>(
+                      std::make_shared<nav::DetourNavmesh>(rsl.left_move())));
+                },
+                task_list);
+      },
+      task_list);
+}
+
+void SharedAssetStore::finish_load(const Key& key,
+                                   std::shared_ptr<const void> asset) {
+  std::lock_guard<std::mutex> l(mut_);
+  auto it = slots_.find(key);
+  if (it == slots_.end()) {
+    return;
+  }
+
+  if (asset == nullptr) {
+    slots_.erase(it);
+    return;
+  }
+
+  it->second.InFlight = nullptr;
+  it->second.Loaded = asset;
+}
+
+uint64_t SharedAssetStore::loads_started() const {
+  std::lock_guard<std::mutex> l(mut_);
+  return loads_started_;
+}
+
+size_t SharedAssetStore::live_asset_count() const {
+  std::lock_guard<std::mutex> l(mut_);
+
+  size_t count = 0u;
+  for (const auto& [key, slot] : slots_) {
+    if (!slot.Loaded.expired()) {
+      count++;
+    }
+  }
+  return count;
+}
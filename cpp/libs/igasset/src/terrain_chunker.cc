@@ -0,0 +1,190 @@
+#include <igasset/mesh_optimizer.h>
+#include <igasset/terrain_chunker.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+typedef std::tuple<int32_t, int32_t, int32_t> CellKey;
+
+CellKey cell_of(const glm::vec3& p, float cell_size) {
+  return CellKey{static_cast<int32_t>(std::floor(p.x / cell_size)),
+                 static_cast<int32_t>(std::floor(p.y / cell_size)),
+                 static_cast<int32_t>(std::floor(p.z / cell_size))};
+}
+
+/**
+ * Vertex cache + fetch ordering - also drops vertices that no triangle uses
+ *  any more
+ */
+void optimize(TerrainChunkMesh& mesh) {
+  const uint32_t vertex_count = static_cast<uint32_t>(mesh.vertices.size());
+  if (mesh.indices.size() == 0) {
+    mesh.vertices.resize(0);
+    return;
+  }
+
+  MeshOptimizer::optimize_vertex_cache(mesh.indices.raw(), mesh.indices.size(),
+                                       vertex_count);
+
+  std::vector<uint32_t> remap;
+  uint32_t new_vertex_count = MeshOptimizer::optimize_vertex_fetch(
+      mesh.indices.raw(), mesh.indices.size(), vertex_count, &remap);
+  auto remapped = MeshOptimizer::remap_vertices(
+      mesh.vertices.raw(), vertex_count, remap, new_vertex_count);
+
+  core::PodVector<PositionNormalVertexData> vertices(new_vertex_count);
+  for (uint32_t i = 0; i < new_vertex_count; i++) {
+    vertices.push_back(remapped[i]);
+  }
+  mesh.vertices = std::move(vertices);
+}
+
+}  // namespace
+
+std::vector<TerrainChunk> TerrainChunker::build(
+    const core::PodVector<PositionNormalVertexData>& vertices,
+    const core::PodVector<uint32_t>& indices, const Params& params) {
+  struct ChunkBuilder {
+    TerrainChunkMesh mesh;
+
+    // Source vertex -> chunk vertex
+    std::unordered_map<uint32_t, uint32_t> vertexMap;
+  };
+
+  // Ordered by (z, x), so output is deterministic
+  std::map<std::pair<int32_t, int32_t>, ChunkBuilder> builders;
+
+  for (int i = 0; i + 2 < indices.size(); i += 3) {
+    const glm::vec3 centroid = (vertices[indices[i]].Position +
+                                vertices[indices[i + 1]].Position +
+                                vertices[indices[i + 2]].Position) /
+                               3.f;
+    const int32_t grid_x =
+        static_cast<int32_t>(std::floor(centroid.x / params.chunkSize));
+    const int32_t grid_z =
+        static_cast<int32_t>(std::floor(centroid.z / params.chunkSize));
+
+    ChunkBuilder& builder = builders[{grid_z, grid_x}];
+    for (int v = 0; v < 3; v++) {
+      const uint32_t src_idx = indices[i + v];
+      auto it = builder.vertexMap.find(src_idx);
+      if (it == builder.vertexMap.end()) {
+        const uint32_t chunk_idx =
+            static_cast<uint32_t>(builder.mesh.vertices.size());
+        builder.mesh.vertices.push_back(vertices[src_idx]);
+        it = builder.vertexMap.emplace(src_idx, chunk_idx).first;
+      }
+      builder.mesh.indices.push_back(it->second);
+    }
+  }
+
+  std::vector<TerrainChunk> chunks;
+  chunks.reserve(builders.size());
+  for (auto& [grid, builder] : builders) {
+    TerrainChunk chunk{};
+    chunk.gridZ = grid.first;
+    chunk.gridX = grid.second;
+
+    const auto& chunk_vertices = builder.mesh.vertices;
+    chunk.boundsMin = chunk_vertices[0].Position;
+    chunk.boundsMax = chunk_vertices[0].Position;
+    for (int i = 1; i < chunk_vertices.size(); i++) {
+      chunk.boundsMin = glm::min(chunk.boundsMin, chunk_vertices[i].Position);
+      chunk.boundsMax = glm::max(chunk.boundsMax, chunk_vertices[i].Position);
+    }
+
+    chunk.lods.reserve(params.lodCellSizes.size() + 1u);
+    for (float cell_size : params.lodCellSizes) {
+      chunk.lods.push_back(simplify(builder.mesh, cell_size));
+    }
+    ::optimize(builder.mesh);
+    chunk.lods.insert(chunk.lods.begin(), std::move(builder.mesh));
+
+    chunks.push_back(std::move(chunk));
+  }
+
+  return chunks;
+}
+
+TerrainChunkMesh TerrainChunker::simplify(const TerrainChunkMesh& mesh,
+                                          float cell_size) {
+  const uint32_t vertex_count = static_cast<uint32_t>(mesh.vertices.size());
+
+  //
+  // Cluster - average position of every occupied cell
+  //
+  struct Cell {
+    glm::vec3 positionSum;
+    uint32_t count;
+    uint32_t representative;
+    float representativeDistSq;
+  };
+
+  std::map<CellKey, uint32_t> cell_indices;
+  std::vector<Cell> cells;
+  std::vector<uint32_t> vertex_cell(vertex_count);
+  for (uint32_t i = 0; i < vertex_count; i++) {
+    const glm::vec3& p = mesh.vertices[i].Position;
+    auto it = cell_indices.find(::cell_of(p, cell_size));
+    if (it == cell_indices.end()) {
+      it = cell_indices
+               .emplace(::cell_of(p, cell_size),
+                        static_cast<uint32_t>(cells.size()))
+               .first;
+      cells.push_back(Cell{glm::vec3(0.f), 0u, i, 0.f});
+    }
+    vertex_cell[i] = it->second;
+    cells[it->second].positionSum += p;
+    cells[it->second].count++;
+  }
+
+  //
+  // Pick the real vertex nearest each cell's average - keeps a true height
+  //  sample and normal instead of a blend
+  //
+  for (uint32_t i = 0; i < vertex_count; i++) {
+    Cell& cell = cells[vertex_cell[i]];
+    const glm::vec3 avg = cell.positionSum / static_cast<float>(cell.count);
+    const glm::vec3 d = mesh.vertices[i].Position - avg;
+    const float dist_sq = glm::dot(d, d);
+    if (cell.representative == i || dist_sq < cell.representativeDistSq) {
+      cell.representative = i;
+      cell.representativeDistSq = dist_sq;
+    }
+  }
+
+  TerrainChunkMesh out;
+  std::vector<uint32_t> cell_vertex(cells.size(), 0xFFFFFFFFu);
+  auto out_vertex = [&](uint32_t src_idx) {
+    const uint32_t cell_idx = vertex_cell[src_idx];
+    if (cell_vertex[cell_idx] == 0xFFFFFFFFu) {
+      cell_vertex[cell_idx] = static_cast<uint32_t>(out.vertices.size());
+      out.vertices.push_back(mesh.vertices[cells[cell_idx].representative]);
+    }
+    return cell_vertex[cell_idx];
+  };
+
+  for (int i = 0; i + 2 < mesh.indices.size(); i += 3) {
+    const uint32_t a = vertex_cell[mesh.indices[i]];
+    const uint32_t b = vertex_cell[mesh.indices[i + 1]];
+    const uint32_t c = vertex_cell[mesh.indices[i + 2]];
+    if (a == b || b == c || a == c) {
+      continue;
+    }
+
+    out.indices.push_back(out_vertex(mesh.indices[i]));
+    out.indices.push_back(out_vertex(mesh.indices[i + 1]));
+    out.indices.push_back(out_vertex(mesh.indices[i + 2]));
+  }
+
+  ::optimize(out);
+  return out;
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <igasset/block_compression.h>
+#include <igasset/compressed_texture.h>
+#include <igasset/compressed_texture_encoder.h>
+#include <igasset/indexed_igpack.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+// Smooth gradients with a little per-texel noise - roughly what real albedo
+//  textures look like to a block encoder
+RgbaImage make_image(uint32_t width, uint32_t height, bool with_alpha) {
+  core::PodVector<RgbaPixel> pixels(static_cast<size_t>(width) * height);
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      uint32_t noise = (x * 7u + y * 13u) % 5u;
+      RgbaPixel p;
+      p.Color[0] = static_cast<uint8_t>((x * 255u) / width);
+      p.Color[1] = static_cast<uint8_t>((y * 255u) / height);
+      p.Color[2] = static_cast<uint8_t>(96u + noise);
+      p.Color[3] =
+          with_alpha ? static_cast<uint8_t>(((x + y) * 255u) / (width + height))
+                     : 255u;
+      pixels.push_back(p);
+    }
+  }
+
+  return RgbaImage{std::move(pixels), width, height};
+}
+
+double mean_abs_error(const RgbaImage& a, const RgbaImage& b, int channel) {
+  double sum = 0.;
+  for (size_t i = 0; i < a.Pixels.size(); i++) {
+    sum += std::abs(static_cast<int>(a.Pixels[i].Color[channel]) -
+                    static_cast<int>(b.Pixels[i].Color[channel]));
+  }
+  return sum / a.Pixels.size();
+}
+
+pb::SingleAsset encode_asset(
+    const RgbaImage& image, CompressedTextureEncoder::EncodeSettings settings) {
+  auto rsl = CompressedTextureEncoder::encode(image, settings);
+  EXPECT_TRUE(rsl.is_left());
+
+  pb::SingleAsset asset;
+  asset.set_name("texture");
+  *asset.mutable_compressed_texture_def() = rsl.left_move();
+  return asset;
+}
+
+// "asset" must outlive the texture (see IgpackAsset::FromProto)
+std::shared_ptr<const CompressedTexture> open(const pb::SingleAsset& asset) {
+  auto rsl = CompressedTexture::Create(
+      std::make_shared<const IgpackAsset>(IgpackAsset::FromProto(asset)));
+  EXPECT_TRUE(rsl.is_left());
+  return rsl.is_left() ? rsl.get_left() : nullptr;
+}
+
+}  // namespace
+
+TEST(CompressedTextureTest, DecodesReferenceBc1Block) {
+  // c0 = pure red, c1 = pure blue (565), indices 0,1,2,3 repeating
+  const uint8_t block[8] = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4};
+
+  RgbaPixel texels[16];
+  BlockCompression::decode_bc1_block(block, texels);
+
+  EXPECT_EQ(texels[0].Color[0], 255u);
+  EXPECT_EQ(texels[0].Color[2], 0u);
+  EXPECT_EQ(texels[1].Color[0], 0u);
+  EXPECT_EQ(texels[1].Color[2], 255u);
+  EXPECT_EQ(texels[2].Color[0], 170u);
+  EXPECT_EQ(texels[2].Color[2], 85u);
+  EXPECT_EQ(texels[3].Color[0], 85u);
+  EXPECT_EQ(texels[3].Color[2], 170u);
+  for (int i = 0; i < 16; i++) {
+    EXPECT_EQ(texels[i].Color[1], 0u);
+    EXPECT_EQ(texels[i].Color[3], 255u);
+  }
+}
+
+TEST(CompressedTextureTest, SolidBlocksRoundTrip) {
+  RgbaPixel texels[16];
+  for (auto& t : texels) {
+    t = RgbaPixel{{255u, 0u, 255u, 128u}};
+  }
+
+  uint8_t block[16];
+  BlockCompression::encode_bc3_block(texels, block);
+
+  RgbaPixel decoded[16];
+  BlockCompression::decode_bc3_block(block, decoded);
+  for (const auto& t : decoded) {
+    EXPECT_EQ(t.Color[0], 255u);
+    EXPECT_EQ(t.Color[1], 0u);
+    EXPECT_EQ(t.Color[2], 255u);
+    EXPECT_EQ(t.Color[3], 128u);
+  }
+}
+
+TEST(CompressedTextureTest, Bc1RoundTripStaysClose) {
+  RgbaImage image = ::make_image(64u, 32u, false);
+
+  CompressedTextureEncoder::EncodeSettings settings;
+  settings.GenerateMips = false;
+  settings.Supercompression = pb::CompressedTextureDef::NONE;
+  pb::SingleAsset asset = ::encode_asset(image, settings);
+  auto texture = ::open(asset);
+  ASSERT_NE(texture, nullptr);
+
+  EXPECT_EQ(texture->format(), BlockFormat::BC1_RGB);
+  EXPECT_TRUE(texture->is_zero_copy());
+  EXPECT_EQ(texture->data_size(), (64u / 4u) * (32u / 4u) * 8u);
+
+  auto rgba = texture->transcode_to_rgba(0u);
+  ASSERT_TRUE(rgba.is_left());
+  const RgbaImage& decoded = rgba.get_left();
+  ASSERT_EQ(decoded.Width, 64u);
+  ASSERT_EQ(decoded.Height, 32u);
+  // Red and green vary independently within each block, which a BC1 color
+  //  line cannot represent exactly - this is close to the worst case
+  for (int c = 0; c < 3; c++) {
+    EXPECT_LT(::mean_abs_error(image, decoded, c), 6.0) << "channel " << c;
+  }
+}
+
+TEST(CompressedTextureTest, AlphaPicksBc3AndRoundTripsAlpha) {
+  RgbaImage image = ::make_image(32u, 32u, true);
+
+  pb::SingleAsset asset =
+      ::encode_asset(image, CompressedTextureEncoder::EncodeSettings());
+  auto texture = ::open(asset);
+  ASSERT_NE(texture, nullptr);
+  EXPECT_EQ(texture->format(), BlockFormat::BC3_RGBA);
+  EXPECT_FALSE(texture->is_zero_copy());
+
+  auto rgba = texture->transcode_to_rgba(0u);
+  ASSERT_TRUE(rgba.is_left());
+  EXPECT_LT(::mean_abs_error(image, rgba.get_left(), 3), 2.0);
+}
+
+TEST(CompressedTextureTest, MipChainLayout) {
+  RgbaImage image = ::make_image(16u, 8u, false);
+
+  CompressedTextureEncoder::EncodeSettings settings;
+  settings.IsSrgb = false;
+  pb::SingleAsset asset = ::encode_asset(image, settings);
+  auto texture = ::open(asset);
+  ASSERT_NE(texture, nullptr);
+
+  // 16x8, 8x4, 4x2, 2x1, 1x1
+  ASSERT_EQ(texture->mip_count(), 5u);
+  const uint32_t expected_blocks[5][2] = {
+      {4u, 2u}, {2u, 1u}, {1u, 1u}, {1u, 1u}, {1u, 1u}};
+
+  size_t offset = 0u;
+  for (uint32_t i = 0; i < texture->mip_count(); i++) {
+    CompressedMip mip = texture->mip(i);
+    EXPECT_EQ(mip.Width, std::max(16u >> i, 1u));
+    EXPECT_EQ(mip.Height, std::max(8u >> i, 1u));
+    EXPECT_EQ(mip.BlocksWide, expected_blocks[i][0]);
+    EXPECT_EQ(mip.BlocksHigh, expected_blocks[i][1]);
+    EXPECT_EQ(mip.BytesPerRow, mip.BlocksWide * 8u);
+    EXPECT_EQ(mip.Data, texture->mip(0u).Data + offset);
+    offset += mip.Size;
+  }
+  EXPECT_EQ(offset, texture->data_size());
+
+  auto last = texture->transcode_to_rgba(4u);
+  ASSERT_TRUE(last.is_left());
+  EXPECT_EQ(last.get_left().Pixels.size(), 1u);
+  EXPECT_TRUE(texture->transcode_to_rgba(5u).is_right());
+}
+
+TEST(CompressedTextureTest, SrgbDownsampleAveragesInLinearSpace) {
+  core::PodVector<RgbaPixel> pixels(4u);
+  pixels.push_back(RgbaPixel{{0u, 0u, 0u, 255u}});
+  pixels.push_back(RgbaPixel{{255u, 255u, 255u, 255u}});
+  pixels.push_back(RgbaPixel{{0u, 0u, 0u, 0u}});
+  pixels.push_back(RgbaPixel{{255u, 255u, 255u, 255u}});
+  RgbaImage image{std::move(pixels), 2u, 2u};
+
+  RgbaImage srgb = CompressedTextureEncoder::downsample(image, true);
+  RgbaImage linear = CompressedTextureEncoder::downsample(image, false);
+  ASSERT_EQ(srgb.Width, 1u);
+  ASSERT_EQ(srgb.Height, 1u);
+
+  // 50% linear gray is ~188 in sRGB - alpha is never gamma corrected
+  EXPECT_NEAR(srgb.Pixels[0].Color[0], 188, 1);
+  EXPECT_NEAR(linear.Pixels[0].Color[0], 128, 1);
+  EXPECT_NEAR(srgb.Pixels[0].Color[3], 191, 1);
+}
+
+TEST(CompressedTextureTest, RejectsUnalignedImages) {
+  RgbaImage image = ::make_image(10u, 8u, false);
+  auto rsl = CompressedTextureEncoder::encode(image);
+  ASSERT_TRUE(rsl.is_right());
+  EXPECT_EQ(rsl.get_right(), CompressedTextureEncoderResult::NotBlockAligned);
+}
+
+TEST(CompressedTextureTest, UncompressedTextureIsReadInPlaceFromIndexedPack) {
+  RgbaImage image = ::make_image(16u, 16u, false);
+
+  CompressedTextureEncoder::EncodeSettings settings;
+  settings.Supercompression = pb::CompressedTextureDef::NONE;
+  auto encode_rsl = CompressedTextureEncoder::encode(image, settings);
+  ASSERT_TRUE(encode_rsl.is_left());
+
+  pb::AssetPack pack;
+  pb::SingleAsset* asset = pack.add_assets();
+  asset->set_name("texture");
+  *asset->mutable_compressed_texture_def() = encode_rsl.left_move();
+  auto bytes = std::make_shared<std::string>(IndexedIgpack::Serialize(pack));
+
+  auto indexed_pack = IndexedIgpack::Open(
+      bytes, reinterpret_cast<const uint8_t*>(bytes->data()), bytes->size());
+  ASSERT_TRUE(indexed_pack.has_value());
+  const auto* entry = indexed_pack.get()->find_entry("texture");
+  ASSERT_NE(entry, nullptr);
+  auto igpack_asset = indexed_pack.get()->read_asset(*entry);
+  ASSERT_TRUE(igpack_asset.has_value());
+
+  auto rsl = CompressedTexture::Create(
+      std::make_shared<const IgpackAsset>(igpack_asset.move()));
+  ASSERT_TRUE(rsl.is_left());
+  EXPECT_TRUE(rsl.get_left()->is_zero_copy());
+  EXPECT_EQ(rsl.get_left()->mip(0u).Data,
+            reinterpret_cast<const uint8_t*>(bytes->data()) +
+                entry->PayloadOffset);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <igasset/decoded_asset_cache.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+class DecodedAssetCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    cache_dir_ = (std::filesystem::temp_directory_path() /
+                  ::testing::UnitTest::GetInstance()
+                      ->current_test_info()
+                      ->name())
+                     .string() +
+                 "_igdc";
+    std::filesystem::remove_all(cache_dir_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(cache_dir_); }
+
+  static DecodedAssetKey key(std::string asset_name, uint64_t content_hash = 1u,
+                             uint32_t decoder_version = 1u) {
+    return DecodedAssetKey{content_hash, std::move(asset_name),
+                           decoder_version};
+  }
+
+  static bool write(DecodedAssetCache* cache, const DecodedAssetKey& key,
+                    const std::string& data) {
+    return cache->write(key, reinterpret_cast<const uint8_t*>(data.data()),
+                        data.size());
+  }
+
+  static std::string read(DecodedAssetCache* cache,
+                          const DecodedAssetKey& key) {
+    auto entry = cache->read(key);
+    if (entry.is_empty()) {
+      return "<miss>";
+    }
+    return std::string(reinterpret_cast<const char*>(entry.get().Data),
+                       entry.get().Size);
+  }
+
+  std::string cache_dir_;
+};
+
+}  // namespace
+
+TEST_F(DecodedAssetCacheTest, WrittenEntriesReadBack) {
+  auto cache = DecodedAssetCache::Create(cache_dir_, 1024u * 1024u);
+  ASSERT_NE(cache, nullptr);
+
+  EXPECT_EQ(read(cache.get(), key("terrainGeo")), "<miss>");
+  ASSERT_TRUE(write(cache.get(), key("terrainGeo"), "decoded terrain"));
+
+  auto entry = cache->read(key("terrainGeo"));
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(entry.get().Data) %
+                DecodedAssetCache::kBlobAlignment,
+            0u);
+  EXPECT_EQ(read(cache.get(), key("terrainGeo")), "decoded terrain");
+
+  // Entries are replaced in place, not duplicated
+  ASSERT_TRUE(write(cache.get(), key("terrainGeo"), "re-decoded"));
+  EXPECT_EQ(read(cache.get(), key("terrainGeo")), "re-decoded");
+  EXPECT_EQ(cache->entry_count(), 1u);
+}
+
+TEST_F(DecodedAssetCacheTest, AnyKeyChangeMisses) {
+  auto cache = DecodedAssetCache::Create(cache_dir_, 1024u * 1024u);
+  ASSERT_NE(cache, nullptr);
+  ASSERT_TRUE(write(cache.get(), key("terrainGeo", 5u, 2u), "decoded"));
+
+  EXPECT_EQ(read(cache.get(), key("terrainGeo", 5u, 2u)), "decoded");
+  EXPECT_EQ(read(cache.get(), key("terrainGeo", 6u, 2u)), "<miss>");
+  EXPECT_EQ(read(cache.get(), key("terrainGeo", 5u, 3u)), "<miss>");
+  EXPECT_EQ(read(cache.get(), key("terrainGeo2", 5u, 2u)), "<miss>");
+}
+
+TEST_F(DecodedAssetCacheTest, EvictsLeastRecentlyUsedEntries) {
+  const std::string blob(1000u, 'x');
+
+  // Room for exactly three entries (header, name and padding included)
+  auto cache = DecodedAssetCache::Create(cache_dir_, 3u * 1048u);
+  ASSERT_NE(cache, nullptr);
+  ASSERT_TRUE(write(cache.get(), key("a"), blob));
+  ASSERT_TRUE(write(cache.get(), key("b"), blob));
+  ASSERT_TRUE(write(cache.get(), key("c"), blob));
+  ASSERT_EQ(cache->size_bytes(), 3u * 1048u);
+
+  // "a" is now more recently used than "b"
+  ASSERT_EQ(read(cache.get(), key("a")), blob);
+  ASSERT_TRUE(write(cache.get(), key("d"), blob));
+
+  EXPECT_EQ(cache->entry_count(), 3u);
+  EXPECT_EQ(read(cache.get(), key("a")), blob);
+  EXPECT_EQ(read(cache.get(), key("b")), "<miss>");
+  EXPECT_EQ(read(cache.get(), key("c")), blob);
+  EXPECT_EQ(read(cache.get(), key("d")), blob);
+
+  // Too big to ever fit - not stored, nothing else evicted for it
+  EXPECT_FALSE(write(cache.get(), key("huge"), std::string(4000u, 'x')));
+  EXPECT_EQ(cache->entry_count(), 3u);
+}
+
+TEST_F(DecodedAssetCacheTest, EntriesPersistAcrossRuns) {
+  {
+    auto cache = DecodedAssetCache::Create(cache_dir_, 1024u * 1024u);
+    ASSERT_NE(cache, nullptr);
+    ASSERT_TRUE(write(cache.get(), key("terrainGeo"), "decoded terrain"));
+    ASSERT_TRUE(write(cache.get(), key("grass"), "decoded grass"));
+  }
+
+  auto cache = DecodedAssetCache::Create(cache_dir_, 1024u * 1024u);
+  ASSERT_NE(cache, nullptr);
+  EXPECT_EQ(cache->entry_count(), 2u);
+  EXPECT_EQ(read(cache.get(), key("terrainGeo")), "decoded terrain");
+
+  // A smaller budget on the next run trims the directory on open
+  cache = nullptr;
+  auto small_cache = DecodedAssetCache::Create(cache_dir_, 100u);
+  ASSERT_NE(small_cache, nullptr);
+  EXPECT_EQ(small_cache->entry_count(), 1u);
+  EXPECT_LE(small_cache->size_bytes(), 100u);
+}
+
+TEST_F(DecodedAssetCacheTest, ContentHashCoversEveryByte) {
+  std::string data(37u, 'q');
+  const uint64_t base_hash = DecodedAssetCache::content_hash(
+      reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+  // Every position, including the bytes after the last whole 8-byte word
+  for (size_t i = 0; i < data.size(); i++) {
+    std::string changed = data;
+    changed[i] = 'r';
+    EXPECT_NE(DecodedAssetCache::content_hash(
+                  reinterpret_cast<const uint8_t*>(changed.data()),
+                  changed.size()),
+              base_hash)
+        << "byte " << i;
+  }
+
+  EXPECT_NE(DecodedAssetCache::content_hash(
+                reinterpret_cast<const uint8_t*>(data.data()), 36u),
+            base_hash);
+}
@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include <igasset/igpack_loader.h>
+#include <igasset/indexed_igpack.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+// Records the order ranges are requested in, reads go to the real file
+class RecordingRangedReader : public core::RangedFileReader {
+ public:
+  RecordingRangedReader(std::shared_ptr<core::RangedFileReader> reader)
+      : reader_(std::move(reader)) {}
+
+  std::shared_ptr<core::FilePromiseT> read_range(uint64_t offset,
+                                                 uint64_t size) override {
+    offsets.push_back(offset);
+    return reader_->read_range(offset, size);
+  }
+
+  std::vector<uint64_t> offsets;
+
+ private:
+  std::shared_ptr<core::RangedFileReader> reader_;
+};
+
+class IgpackLoaderStreamingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    task_list_ = std::make_shared<core::TaskList>();
+    igpack_path_ = (std::filesystem::temp_directory_path() /
+                    ::testing::UnitTest::GetInstance()
+                        ->current_test_info()
+                        ->name())
+                       .string() +
+                   ".igpack";
+
+    // Written in the opposite order to the default stream priority
+    add_asset("walkClip")->mutable_ozz_animation_def()->set_data("clip");
+    add_asset("ybotSkeleton")->mutable_ozz_skeleton_def()->set_ozz_data("skl");
+    add_asset("terrainGeo")->mutable_draco_geo()->set_data("geo");
+    auto* shader = add_asset("terrainVs")->mutable_wgsl_source();
+    shader->set_shader_source("fn main() {}");
+    shader->set_entry_point("main");
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(igpack_path_);
+    std::filesystem::remove(IndexedIgpack::IndexedPathFor(igpack_path_));
+  }
+
+  pb::SingleAsset* add_asset(std::string name) {
+    auto* asset = asset_pack_.add_assets();
+    asset->set_name(std::move(name));
+    return asset;
+  }
+
+  void write_packs(bool write_indexed_pack) {
+    std::ofstream(igpack_path_, std::ios::binary)
+        << asset_pack_.SerializeAsString();
+    if (write_indexed_pack) {
+      std::ofstream(IndexedIgpack::IndexedPathFor(igpack_path_),
+                    std::ios::binary)
+          << IndexedIgpack::Serialize(asset_pack_);
+    }
+  }
+
+  void run_tasks() {
+    while (task_list_->execute_next()) {
+    }
+  }
+
+  std::shared_ptr<core::TaskList> task_list_;
+  std::string igpack_path_;
+  pb::AssetPack asset_pack_;
+};
+
+}  // namespace
+
+TEST_F(IgpackLoaderStreamingTest, ResolvesAssetsFromIndexedPack) {
+  write_packs(true);
+
+  IgpackLoader loader(igpack_path_, task_list_,
+                      IgpackLoader::StreamingParams{});
+  auto shader_promise = loader.extract_wgsl_shader("terrainVs", task_list_);
+  auto geo_promise = loader.extract_raw_asset("terrainGeo", task_list_);
+  run_tasks();
+
+  ASSERT_TRUE(shader_promise->is_finished());
+  ASSERT_TRUE(shader_promise->unsafe_sync_get().is_left());
+  EXPECT_EQ(shader_promise->unsafe_sync_get().get_left().shader_source(),
+            "fn main() {}");
+
+  ASSERT_TRUE(geo_promise->is_finished());
+  const auto& geo_rsl = geo_promise->unsafe_sync_get();
+  ASSERT_TRUE(geo_rsl.is_left());
+  EXPECT_TRUE(geo_rsl.get_left()->asset().has_draco_geo());
+  EXPECT_EQ(geo_rsl.get_left()->payload_view(), "geo");
+}
+
+TEST_F(IgpackLoaderStreamingTest, ReadsAssetsInPriorityOrder) {
+  write_packs(true);
+
+  auto reader = std::make_shared<RecordingRangedReader>(
+      core::RangedFileReader::Create(
+          IndexedIgpack::IndexedPathFor(igpack_path_), task_list_));
+  IgpackLoader::StreamingParams params{};
+  params.Reader = reader;
+  params.MaxReadsInFlight = 1u;
+  params.PriorityHints["ybotSkeleton"] = -1;
+
+  IgpackLoader loader(igpack_path_, task_list_, params);
+  auto clip_promise = loader.extract_raw_asset("walkClip", task_list_);
+  run_tasks();
+  ASSERT_TRUE(clip_promise->is_finished());
+
+  auto indexed_bin = IndexedIgpack::Serialize(asset_pack_);
+  auto indexed_pack = IndexedIgpack::Open(
+      nullptr, reinterpret_cast<const uint8_t*>(indexed_bin.data()),
+      indexed_bin.size());
+  ASSERT_TRUE(indexed_pack.has_value());
+  auto offset_of = [&indexed_pack](const std::string& name) {
+    return indexed_pack.get()->find_entry(name)->MetaOffset;
+  };
+
+  // Table of contents, then hinted skeleton, shader, terrain, animation
+  ASSERT_EQ(reader->offsets.size(), 5u);
+  EXPECT_EQ(reader->offsets[0], 0u);
+  EXPECT_EQ(reader->offsets[1], offset_of("ybotSkeleton"));
+  EXPECT_EQ(reader->offsets[2], offset_of("terrainVs"));
+  EXPECT_EQ(reader->offsets[3], offset_of("terrainGeo"));
+  EXPECT_EQ(reader->offsets[4], offset_of("walkClip"));
+}
+
+TEST_F(IgpackLoaderStreamingTest, MissingAssetIsNotFound) {
+  write_packs(true);
+
+  IgpackLoader loader(igpack_path_, task_list_,
+                      IgpackLoader::StreamingParams{});
+  auto early_promise = loader.extract_raw_asset("notInPack", task_list_);
+  run_tasks();
+  auto late_promise = loader.extract_raw_asset("alsoNotInPack", task_list_);
+  run_tasks();
+
+  ASSERT_TRUE(early_promise->is_finished());
+  ASSERT_TRUE(early_promise->unsafe_sync_get().is_right());
+  EXPECT_EQ(early_promise->unsafe_sync_get().get_right(),
+            IgpackLoader::IgpackExtractError::ResourceNotFound);
+
+  ASSERT_TRUE(late_promise->is_finished());
+  ASSERT_TRUE(late_promise->unsafe_sync_get().is_right());
+  EXPECT_EQ(late_promise->unsafe_sync_get().get_right(),
+            IgpackLoader::IgpackExtractError::ResourceNotFound);
+}
+
+TEST_F(IgpackLoaderStreamingTest, FallsBackToWholePackWithoutIndexedPack) {
+  write_packs(false);
+
+  IgpackLoader loader(igpack_path_, task_list_,
+                      IgpackLoader::StreamingParams{});
+  auto shader_promise = loader.extract_wgsl_shader("terrainVs", task_list_);
+  run_tasks();
+
+  ASSERT_TRUE(shader_promise->is_finished());
+  ASSERT_TRUE(shader_promise->unsafe_sync_get().is_left());
+  EXPECT_EQ(shader_promise->unsafe_sync_get().get_left().entry_point(),
+            "main");
+}
+
+TEST_F(IgpackLoaderStreamingTest, LoaderCanBeDroppedBeforeReadsFinish) {
+  write_packs(true);
+
+  IgpackLoader::ExtractRawAssetPromiseT clip_promise;
+  {
+    IgpackLoader loader(igpack_path_, task_list_,
+                        IgpackLoader::StreamingParams{});
+    clip_promise = loader.extract_raw_asset("walkClip", task_list_);
+  }
+  run_tasks();
+
+  ASSERT_TRUE(clip_promise->is_finished());
+  ASSERT_TRUE(clip_promise->unsafe_sync_get().is_left());
+  EXPECT_EQ(clip_promise->unsafe_sync_get().get_left()->payload_view(),
+            "clip");
+}
+
+TEST_F(IgpackLoaderStreamingTest, DeliveredAssetsAreNotHeldByTheLoader) {
+  write_packs(true);
+
+  auto reader = std::make_shared<RecordingRangedReader>(
+      core::RangedFileReader::Create(
+          IndexedIgpack::IndexedPathFor(igpack_path_), task_list_));
+  IgpackLoader::StreamingParams params{};
+  params.Reader = reader;
+
+  IgpackLoader loader(igpack_path_, task_list_, params);
+  auto geo_promise = loader.extract_raw_asset("terrainGeo", task_list_);
+  run_tasks();
+
+  // Streamed before it was requested, then handed over on request
+  auto clip_promise = loader.extract_raw_asset("walkClip", task_list_);
+  ASSERT_TRUE(clip_promise->is_finished());
+
+  std::weak_ptr<const IgpackAsset> geo_asset =
+      geo_promise->unsafe_sync_get().get_left();
+  std::weak_ptr<const IgpackAsset> clip_asset =
+      clip_promise->unsafe_sync_get().get_left();
+  geo_promise = nullptr;
+  clip_promise = nullptr;
+  EXPECT_TRUE(geo_asset.expired());
+  EXPECT_TRUE(clip_asset.expired());
+
+  // Asking again reads the asset's range again
+  size_t read_count = reader->offsets.size();
+  auto geo_again = loader.extract_raw_asset("terrainGeo", task_list_);
+  run_tasks();
+
+  ASSERT_TRUE(geo_again->is_finished());
+  ASSERT_TRUE(geo_again->unsafe_sync_get().is_left());
+  EXPECT_EQ(geo_again->unsafe_sync_get().get_left()->payload_view(), "geo");
+  EXPECT_EQ(reader->offsets.size(), read_count + 1u);
+
+  // ... including one that was streamed before it was first requested
+  auto clip_again = loader.extract_raw_asset("walkClip", task_list_);
+  run_tasks();
+
+  ASSERT_TRUE(clip_again->is_finished());
+  ASSERT_TRUE(clip_again->unsafe_sync_get().is_left());
+  EXPECT_EQ(clip_again->unsafe_sync_get().get_left()->payload_view(), "clip");
+  EXPECT_EQ(reader->offsets.size(), read_count + 2u);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <igasset/indexed_igpack.h>
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+std::string make_indexed_pack() {
+  pb::AssetPack asset_pack;
+
+  // Added out of name order - Serialize sorts the table of contents
+  for (const char* name : {"walkClip", "terrainGeo", "ybotSkeleton"}) {
+    auto* asset = asset_pack.add_assets();
+    asset->set_name(name);
+    asset->mutable_draco_geo()->set_data(name);
+  }
+
+  return IndexedIgpack::Serialize(asset_pack);
+}
+
+core::Maybe<std::shared_ptr<IndexedIgpack>> open(const std::string& bin) {
+  return IndexedIgpack::Open(
+      nullptr, reinterpret_cast<const uint8_t*>(bin.data()), bin.size());
+}
+
+}  // namespace
+
+TEST(IndexedIgpackTest, FindsEveryAsset) {
+  std::string bin = ::make_indexed_pack();
+  auto pack = ::open(bin);
+  ASSERT_TRUE(pack.has_value());
+
+  for (const char* name : {"terrainGeo", "walkClip", "ybotSkeleton"}) {
+    const IndexedIgpackTocEntry* entry = pack.get()->find_entry(name);
+    ASSERT_NE(entry, nullptr) << name;
+
+    auto asset = pack.get()->read_asset(*entry);
+    ASSERT_TRUE(asset.has_value()) << name;
+    EXPECT_EQ(asset.get().payload_view(), name);
+  }
+
+  EXPECT_EQ(pack.get()->find_entry("notInPack"), nullptr);
+}
+
+TEST(IndexedIgpackTest, RejectsUnsortedTableOfContents) {
+  std::string bin = ::make_indexed_pack();
+
+  // Swap the first and last entries - still in bounds, but lookups would miss
+  IndexedIgpackTocEntry first{}, last{};
+  char* toc = bin.data() + sizeof(IndexedIgpackHeader);
+  std::memcpy(&first, toc, sizeof(first));
+  std::memcpy(&last, toc + 2u * sizeof(last), sizeof(last));
+  std::memcpy(toc, &last, sizeof(last));
+  std::memcpy(toc + 2u * sizeof(first), &first, sizeof(first));
+
+  EXPECT_TRUE(::open(bin).is_empty());
+}
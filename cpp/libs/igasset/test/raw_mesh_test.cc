@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+#include <igasset/indexed_igpack.h>
+#include <igasset/mesh_optimizer.h>
+#include <igasset/raw_mesh.h>
+#include <igasset/raw_mesh_encoder.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+struct GridMesh {
+  core::PodVector<PositionNormalVertexData> pos_norm;
+  core::PodVector<TexcoordVertexData> texcoords;
+  core::PodVector<uint32_t> indices;
+};
+
+// (size x size) quad grid, with triangles in shuffled order so that there is
+//  something for the vertex cache optimization to do
+GridMesh make_grid(uint32_t size) {
+  GridMesh mesh;
+  const uint32_t row = size + 1u;
+  for (uint32_t y = 0; y < row; y++) {
+    for (uint32_t x = 0; x < row; x++) {
+      PositionNormalVertexData v{};
+      v.Position = glm::vec3(x * 0.37f, 0.1f * (x % 3), y * 0.41f);
+      v.NormalQuat = glm::vec4(0.f, 0.f, 0.f, 1.f);
+      mesh.pos_norm.push_back(v);
+
+      TexcoordVertexData uv{};
+      uv.Texcoord = glm::vec2(x / float(size), y / float(size));
+      mesh.texcoords.push_back(uv);
+    }
+  }
+
+  std::vector<std::array<uint32_t, 3>> tris;
+  for (uint32_t y = 0; y < size; y++) {
+    for (uint32_t x = 0; x < size; x++) {
+      uint32_t i = y * row + x;
+      tris.push_back({i, i + row, i + 1u});
+      tris.push_back({i + 1u, i + row, i + row + 1u});
+    }
+  }
+  std::shuffle(tris.begin(), tris.end(), std::mt19937(1234u));
+  for (const auto& tri : tris) {
+    mesh.indices.push_back(tri[0]);
+    mesh.indices.push_back(tri[1]);
+    mesh.indices.push_back(tri[2]);
+  }
+
+  return mesh;
+}
+
+typedef std::array<std::tuple<float, float, float>, 3> TriPositions;
+
+// Triangles by vertex position, rotated to a canonical start vertex (winding
+//  is kept) and sorted, so meshes can be compared regardless of ordering
+std::vector<TriPositions> triangle_set(const PositionNormalVertexData* verts,
+                                       const uint32_t* indices,
+                                       uint32_t index_count) {
+  std::vector<TriPositions> tris;
+  for (uint32_t i = 0; i < index_count; i += 3u) {
+    TriPositions tri;
+    for (int k = 0; k < 3; k++) {
+      const glm::vec3& p = verts[indices[i + k]].Position;
+      tri[k] = std::make_tuple(p.x, p.y, p.z);
+    }
+    std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()),
+                tri.end());
+    tris.push_back(tri);
+  }
+  std::sort(tris.begin(), tris.end());
+  return tris;
+}
+
+pb::SingleAsset encode_asset(const GridMesh& mesh,
+                             RawMeshEncoder::EncodeSettings settings) {
+  RawMeshEncoder encoder;
+  EXPECT_EQ(encoder.add_pos_norm_data(mesh.pos_norm), RawMeshEncoderResult::Ok);
+  EXPECT_EQ(encoder.add_texcoord_data(mesh.texcoords),
+            RawMeshEncoderResult::Ok);
+  EXPECT_EQ(encoder.add_index_data(mesh.indices), RawMeshEncoderResult::Ok);
+
+  auto rsl = encoder.encode(settings);
+  EXPECT_TRUE(rsl.is_left());
+
+  pb::SingleAsset asset;
+  asset.set_name("gridMesh");
+  *asset.mutable_raw_mesh_def() = rsl.left_move();
+  return asset;
+}
+
+}  // namespace
+
+TEST(RawMeshTest, LosslessSettingsRoundTripExactly) {
+  GridMesh mesh = ::make_grid(4u);
+
+  RawMeshEncoder::EncodeSettings settings;
+  settings.PositionMantissaBits = 23u;
+  settings.NormalMantissaBits = 23u;
+  settings.OptimizeVertexOrder = false;
+  settings.Codec = pb::RawMeshDef::NONE;
+  pb::SingleAsset asset = ::encode_asset(mesh, settings);
+
+  auto rsl = RawMesh::Create(
+      std::make_shared<const IgpackAsset>(IgpackAsset::FromProto(asset)));
+  ASSERT_TRUE(rsl.is_left());
+  auto raw_mesh = rsl.get_left();
+
+  ASSERT_EQ(raw_mesh->num_vertices(), mesh.pos_norm.size());
+  ASSERT_EQ(raw_mesh->num_indices(), mesh.indices.size());
+  ASSERT_NE(raw_mesh->texcoord_data(), nullptr);
+  EXPECT_EQ(raw_mesh->skeletal_animation_data(), nullptr);
+
+  EXPECT_EQ(std::memcmp(raw_mesh->pos_norm_data(), mesh.pos_norm.raw(),
+                        mesh.pos_norm.raw_size()),
+            0);
+  EXPECT_EQ(std::memcmp(raw_mesh->texcoord_data(), mesh.texcoords.raw(),
+                        mesh.texcoords.raw_size()),
+            0);
+  EXPECT_EQ(std::memcmp(raw_mesh->index_data(), mesh.indices.raw(),
+                        mesh.indices.raw_size()),
+            0);
+}
+
+TEST(RawMeshTest, UncompressedMeshIsReadInPlaceFromIndexedPack) {
+  GridMesh mesh = ::make_grid(4u);
+
+  RawMeshEncoder::EncodeSettings settings;
+  settings.Codec = pb::RawMeshDef::NONE;
+
+  pb::AssetPack pack;
+  *pack.add_assets() = ::encode_asset(mesh, settings);
+  auto bytes = std::make_shared<std::string>(IndexedIgpack::Serialize(pack));
+
+  auto indexed_pack = IndexedIgpack::Open(
+      bytes, reinterpret_cast<const uint8_t*>(bytes->data()), bytes->size());
+  ASSERT_TRUE(indexed_pack.has_value());
+  const auto* entry = indexed_pack.get()->find_entry("gridMesh");
+  ASSERT_NE(entry, nullptr);
+  auto igpack_asset = indexed_pack.get()->read_asset(*entry);
+  ASSERT_TRUE(igpack_asset.has_value());
+
+  auto rsl =
+      RawMesh::Create(std::make_shared<const IgpackAsset>(igpack_asset.move()));
+  ASSERT_TRUE(rsl.is_left());
+  auto raw_mesh = rsl.get_left();
+  EXPECT_TRUE(raw_mesh->is_zero_copy());
+  EXPECT_EQ(reinterpret_cast<const uint8_t*>(raw_mesh->pos_norm_data()),
+            reinterpret_cast<const uint8_t*>(bytes->data()) +
+                entry->PayloadOffset);
+}
+
+TEST(RawMeshTest, OptimizedLz4MeshKeepsTriangles) {
+  GridMesh mesh = ::make_grid(16u);
+
+  RawMeshEncoder::EncodeSettings lossless_settings;
+  lossless_settings.PositionMantissaBits = 23u;
+  lossless_settings.NormalMantissaBits = 23u;
+  lossless_settings.Codec = pb::RawMeshDef::LZ4;
+  pb::SingleAsset asset = ::encode_asset(mesh, lossless_settings);
+  EXPECT_LT(asset.raw_mesh_def().data().size(),
+            asset.raw_mesh_def().uncompressed_size());
+
+  auto rsl = RawMesh::Create(
+      std::make_shared<const IgpackAsset>(IgpackAsset::FromProto(asset)));
+  ASSERT_TRUE(rsl.is_left());
+  auto raw_mesh = rsl.get_left();
+  EXPECT_FALSE(raw_mesh->is_zero_copy());
+
+  EXPECT_EQ(::triangle_set(raw_mesh->pos_norm_data(), raw_mesh->index_data(),
+                           raw_mesh->num_indices()),
+            ::triangle_set(mesh.pos_norm.raw(), mesh.indices.raw(),
+                           static_cast<uint32_t>(mesh.indices.size())));
+
+  // Vertex fetch order - indices first reference vertices in order
+  uint32_t next_new_vertex = 0u;
+  for (uint32_t i = 0; i < raw_mesh->num_indices(); i++) {
+    uint32_t idx = raw_mesh->index_data()[i];
+    ASSERT_LE(idx, next_new_vertex);
+    if (idx == next_new_vertex) {
+      next_new_vertex++;
+    }
+  }
+}
+
+TEST(RawMeshTest, QuantizedPositionsStayClose) {
+  GridMesh mesh = ::make_grid(8u);
+
+  RawMeshEncoder::EncodeSettings settings;
+  settings.PositionMantissaBits = 10u;
+  settings.OptimizeVertexOrder = false;
+  pb::SingleAsset asset = ::encode_asset(mesh, settings);
+
+  auto rsl = RawMesh::Create(
+      std::make_shared<const IgpackAsset>(IgpackAsset::FromProto(asset)));
+  ASSERT_TRUE(rsl.is_left());
+  auto raw_mesh = rsl.get_left();
+
+  for (uint32_t i = 0; i < raw_mesh->num_vertices(); i++) {
+    for (int c = 0; c < 3; c++) {
+      float expected = mesh.pos_norm[i].Position[c];
+      EXPECT_NEAR(raw_mesh->pos_norm_data()[i].Position[c], expected,
+                  std::abs(expected) / 1024.f);
+    }
+  }
+}
+
+TEST(RawMeshTest, RejectsBadAssets) {
+  GridMesh mesh = ::make_grid(4u);
+  pb::SingleAsset asset =
+      ::encode_asset(mesh, RawMeshEncoder::EncodeSettings());
+
+  pb::SingleAsset truncated = asset;
+  truncated.mutable_raw_mesh_def()->mutable_data()->resize(
+      asset.raw_mesh_def().data().size() / 2u);
+  auto truncated_rsl = RawMesh::Create(
+      std::make_shared<const IgpackAsset>(IgpackAsset::FromProto(truncated)));
+  ASSERT_TRUE(truncated_rsl.is_right());
+  EXPECT_EQ(truncated_rsl.get_right(), RawMeshResult::DecompressFailed);
+
+  pb::SingleAsset wrong_count = asset;
+  wrong_count.mutable_raw_mesh_def()->set_vertex_count(
+      asset.raw_mesh_def().vertex_count() + 1u);
+  auto wrong_count_rsl = RawMesh::Create(
+      std::make_shared<const IgpackAsset>(IgpackAsset::FromProto(wrong_count)));
+  ASSERT_TRUE(wrong_count_rsl.is_right());
+  EXPECT_EQ(wrong_count_rsl.get_right(), RawMeshResult::SizeMismatch);
+
+  pb::SingleAsset not_a_mesh;
+  not_a_mesh.mutable_draco_geo()->set_data("geo");
+  auto not_a_mesh_rsl = RawMesh::Create(
+      std::make_shared<const IgpackAsset>(IgpackAsset::FromProto(not_a_mesh)));
+  ASSERT_TRUE(not_a_mesh_rsl.is_right());
+  EXPECT_EQ(not_a_mesh_rsl.get_right(), RawMeshResult::WrongAssetType);
+}
+
+TEST(MeshOptimizerTest, VertexCacheOptimizationReducesCacheMisses) {
+  GridMesh mesh = ::make_grid(32u);
+  const uint32_t vertex_count = static_cast<uint32_t>(mesh.pos_norm.size());
+
+  float shuffled_acmr = MeshOptimizer::average_cache_miss_ratio(
+      mesh.indices.raw(), mesh.indices.size(), vertex_count);
+  MeshOptimizer::optimize_vertex_cache(mesh.indices.raw(), mesh.indices.size(),
+                                       vertex_count);
+  float optimized_acmr = MeshOptimizer::average_cache_miss_ratio(
+      mesh.indices.raw(), mesh.indices.size(), vertex_count);
+
+  EXPECT_GT(shuffled_acmr, 2.f);
+  EXPECT_LT(optimized_acmr, 1.f);
+}
+
+TEST(MeshOptimizerTest, VertexFetchOptimizationDropsUnusedVertices) {
+  std::vector<uint32_t> indices = {4u, 2u, 0u, 0u, 2u, 5u};
+  std::vector<uint32_t> remap;
+
+  uint32_t new_vertex_count =
+      MeshOptimizer::optimize_vertex_fetch(indices.data(), indices.size(), 6u,
+                                           &remap);
+
+  EXPECT_EQ(new_vertex_count, 4u);
+  EXPECT_EQ(indices, (std::vector<uint32_t>{0u, 1u, 2u, 2u, 1u, 3u}));
+  EXPECT_EQ(remap, (std::vector<uint32_t>{2u, MeshOptimizer::kUnusedVertex, 1u,
+                                          MeshOptimizer::kUnusedVertex, 0u,
+                                          3u}));
+}
@@ -0,0 +1,355 @@
+#include <DetourAlloc.h>
+#include <gtest/gtest.h>
+#include <igasset/shared_asset_store.h>
+#include <ignav/recast_compiler.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+// Stand-in asset for tests of the store itself - tracks how many bytes of it
+//  are alive, so tests can tell when it is freed
+struct FakeNavmesh {
+  static constexpr size_t kSizeBytes = 4u * 1024u * 1024u;
+  static std::atomic<int64_t> LiveBytes;
+
+  FakeNavmesh() : tiles(kSizeBytes, 0u) { LiveBytes += kSizeBytes; }
+  FakeNavmesh(const FakeNavmesh&) = delete;
+  ~FakeNavmesh() { LiveBytes -= kSizeBytes; }
+
+  std::vector<uint8_t> tiles;
+};
+std::atomic<int64_t> FakeNavmesh::LiveBytes{0};
+
+// Live bytes allocated through Detour - navmesh tiles and bookkeeping, and
+//  navmesh queries
+struct DetourAllocCounter {
+  static std::mutex Mut;
+  static std::unordered_map<void*, size_t> Live;
+  static int64_t LiveBytes;
+
+  static void* alloc(size_t size, dtAllocHint) {
+    void* ptr = malloc(size);
+    std::lock_guard<std::mutex> l(Mut);
+    Live[ptr] = size;
+    LiveBytes += static_cast<int64_t>(size);
+    return ptr;
+  }
+
+  static void free(void* ptr) {
+    {
+      std::lock_guard<std::mutex> l(Mut);
+      auto it = Live.find(ptr);
+      if (it != Live.end()) {
+        LiveBytes -= static_cast<int64_t>(it->second);
+        Live.erase(it);
+      }
+    }
+    ::free(ptr);
+  }
+
+  static int64_t live_bytes() {
+    std::lock_guard<std::mutex> l(Mut);
+    return LiveBytes;
+  }
+};
+std::mutex DetourAllocCounter::Mut;
+std::unordered_map<void*, size_t> DetourAllocCounter::Live;
+int64_t DetourAllocCounter::LiveBytes = 0;
+
+// Small but real navmesh - a flat 40x40 square, built the same way
+//  igpack-gen builds the arena navmesh (default Recast parameters)
+core::Maybe<nav::DetourNavmesh> build_test_navmesh() {
+  const float cs = nav::kDefaultCellSize;
+  const float ch = nav::kDefaultCellHeight;
+  nav::RecastCompiler compiler(
+      cs, ch, nav::kDefaultMaxSlopeDegrees,
+      (int)floorf(nav::kDefaultWalkableClimb / ch),
+      (int)ceilf(nav::kDefaultWalkableHeight / ch),
+      nav::kDefaultAgentRadius / cs,
+      (int)floorf(nav::kDefaultMinRegionArea / (cs * cs)),
+      (int)ceilf(nav::kDefaultMergeRegionArea / (cs * cs)),
+      nav::kDefaultMaxContourError,
+      (int)ceilf(nav::kDefaultMaxEdgeLength / cs),
+      nav::kDefaultDetailSampleDistance, nav::kDefaultDetailMaxError);
+
+  core::PodVector<glm::vec3> vertices(4);
+  vertices.push_back(glm::vec3(0.f, 0.f, 0.f));
+  vertices.push_back(glm::vec3(40.f, 0.f, 0.f));
+  vertices.push_back(glm::vec3(40.f, 0.f, 40.f));
+  vertices.push_back(glm::vec3(0.f, 0.f, 40.f));
+  core::PodVector<uint32_t> indices(6);
+  for (uint32_t idx : {0u, 2u, 1u, 0u, 3u, 2u}) {
+    indices.push_back(idx);
+  }
+  compiler.add_walkable_triangles(vertices, indices);
+
+  auto recast_raw = compiler.build_recast();
+  if (recast_raw.is_empty()) {
+    return core::empty_maybe{};
+  }
+  auto raw = compiler.build_raw(recast_raw.get());
+  if (raw.is_empty()) {
+    return core::empty_maybe{};
+  }
+
+  return nav::RecastCompiler::navmesh_from_raw(raw.move());
+}
+
+// Lets every match thread finish its setup before any of them exit (which
+//  frees their thread queries)
+class MatchBarrier {
+ public:
+  explicit MatchBarrier(int count) : remaining_(count), released_(false) {}
+
+  void arrive_and_wait() {
+    std::unique_lock<std::mutex> l(mut_);
+    remaining_--;
+    arrived_cv_.notify_all();
+    release_cv_.wait(l, [this]() { return released_; });
+  }
+
+  void wait_for_all() {
+    std::unique_lock<std::mutex> l(mut_);
+    arrived_cv_.wait(l, [this]() { return remaining_ == 0; });
+  }
+
+  void release() {
+    std::lock_guard<std::mutex> l(mut_);
+    released_ = true;
+    release_cv_.notify_all();
+  }
+
+ private:
+  std::mutex mut_;
+  std::condition_variable arrived_cv_;
+  std::condition_variable release_cv_;
+  int remaining_;
+  bool released_;
+};
+
+// What one server match does with the shared navmesh every tick - both
+//  queries the simulation uses (player_nav_system, locomotion), from its own
+//  simulation thread
+bool run_match_queries(const nav::DetourNavmesh& navmesh) {
+  dtNavMeshQuery* nav_query = navmesh.thread_query(512);
+  dtNavMeshQuery* path_query = navmesh.thread_query(2048);
+  if (nav_query == nullptr || path_query == nullptr) {
+    return false;
+  }
+
+  dtQueryFilter filter;
+  const float extents[3] = {2.f, 4.f, 2.f};
+  const float start[3] = {5.f, 0.f, 5.f};
+  const float end[3] = {35.f, 0.f, 35.f};
+  dtPolyRef start_ref = 0, end_ref = 0;
+  float start_nearest[3] = {}, end_nearest[3] = {};
+  if (dtStatusFailed(nav_query->findNearestPoly(start, extents, &filter,
+                                                &start_ref, start_nearest)) ||
+      dtStatusFailed(nav_query->findNearestPoly(end, extents, &filter,
+                                                &end_ref, end_nearest)) ||
+      start_ref == 0 || end_ref == 0) {
+    return false;
+  }
+
+  dtPolyRef path[64];
+  int path_count = 0;
+  if (dtStatusFailed(path_query->findPath(start_ref, end_ref, start_nearest,
+                                          end_nearest, &filter, path,
+                                          &path_count, 64))) {
+    return false;
+  }
+  return path_count > 0 && path[path_count - 1] == end_ref;
+}
+
+typedef SharedAssetStore::AssetT<nav::DetourNavmesh> NavmeshAssetT;
+typedef SharedAssetStore::AssetPromiseT<nav::DetourNavmesh>
+    NavmeshAssetPromiseT;
+
+typedef SharedAssetStore::AssetT<FakeNavmesh> FakeAssetT;
+typedef SharedAssetStore::AssetPromiseT<FakeNavmesh> FakeAssetPromiseT;
+
+class SharedAssetStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    task_list_ = std::make_shared<core::TaskList>();
+    store_ = std::make_shared<SharedAssetStore>();
+  }
+
+  void TearDown() override { EXPECT_EQ(FakeNavmesh::LiveBytes, 0); }
+
+  // Loads that only finish when the test resolves them
+  FakeAssetPromiseT acquire(const std::string& name = "pve-arena-navmesh") {
+    return store_->acquire<FakeNavmesh>(
+        "resources/terrain-pve.igpack", name,
+        [this]() {
+          auto promise = core::Promise<FakeAssetT>::create();
+          pending_loads_.push_back(promise);
+          return promise;
+        },
+        task_list_);
+  }
+
+  void finish_pending_loads(bool succeed) {
+    for (auto& promise : pending_loads_) {
+      if (succeed) {
+        std::shared_ptr<const FakeNavmesh> navmesh =
+            std::make_shared<FakeNavmesh>();
+        promise->resolve(core::left(std::move(navmesh)));
+      } else {
+        const auto error = IgpackLoader::IgpackExtractError::ResourceNotFound;
+        promise->resolve(core::right(error));
+      }
+    }
+    pending_loads_.clear();
+    run_tasks();
+  }
+
+  void run_tasks() {
+    while (task_list_->execute_next()) {
+    }
+  }
+
+  std::shared_ptr<core::TaskList> task_list_;
+  std::shared_ptr<SharedAssetStore> store_;
+  std::vector<std::shared_ptr<core::Promise<FakeAssetT>>> pending_loads_;
+};
+
+}  // namespace
+
+TEST_F(SharedAssetStoreTest, FiftyMatchesShareOneNavmesh) {
+  const int kMatchCount = 50;
+  dtAllocSetCustom(DetourAllocCounter::alloc, DetourAllocCounter::free);
+
+  // Every match starts at once, from its own thread, before the load is done
+  std::vector<std::shared_ptr<core::Promise<NavmeshAssetT>>> pending_loads;
+  std::vector<NavmeshAssetPromiseT> requests(kMatchCount);
+  {
+    std::vector<std::thread> match_threads;
+    for (int i = 0; i < kMatchCount; i++) {
+      // Loads start under the store's lock, so pending_loads is safe here
+      match_threads.emplace_back([this, &requests, &pending_loads, i]() {
+        requests[i] = store_->acquire<nav::DetourNavmesh>(
+            "resources/terrain-pve.igpack", "pve-arena-navmesh",
+            [&pending_loads]() {
+              auto promise = core::Promise<NavmeshAssetT>::create();
+              pending_loads.push_back(promise);
+              return promise;
+            },
+            task_list_);
+      });
+    }
+    for (auto& t : match_threads) {
+      t.join();
+    }
+  }
+
+  EXPECT_EQ(store_->loads_started(), 1u);
+  ASSERT_EQ(pending_loads.size(), 1u);
+
+  auto navmesh_rsl = ::build_test_navmesh();
+  ASSERT_TRUE(navmesh_rsl.has_value());
+  std::shared_ptr<const nav::DetourNavmesh> loaded =
+      std::make_shared<nav::DetourNavmesh>(navmesh_rsl.move());
+  pending_loads[0]->resolve(core::left(std::move(loaded)));
+  pending_loads.clear();
+  run_tasks();
+
+  std::vector<std::shared_ptr<const nav::DetourNavmesh>> matches;
+  for (const auto& request : requests) {
+    ASSERT_TRUE(request->is_finished());
+    ASSERT_TRUE(request->unsafe_sync_get().is_left());
+    matches.push_back(request->unsafe_sync_get().get_left());
+  }
+  requests.clear();
+  for (const auto& match : matches) {
+    EXPECT_EQ(match.get(), matches[0].get());
+  }
+  EXPECT_EQ(store_->live_asset_count(), 1u);
+
+  const int64_t navmesh_bytes = DetourAllocCounter::live_bytes();
+
+  // Every match runs its queries on its own thread, and holds onto them (as a
+  //  simulation thread would) until all of them are measured
+  std::atomic<int> failed_matches{0};
+  MatchBarrier barrier(kMatchCount);
+  std::vector<std::thread> match_threads;
+  for (int i = 0; i < kMatchCount; i++) {
+    match_threads.emplace_back([&matches, &failed_matches, &barrier, i]() {
+      if (!::run_match_queries(*matches[i])) {
+        failed_matches++;
+      }
+      barrier.arrive_and_wait();
+    });
+  }
+  barrier.wait_for_all();
+  const int64_t running_bytes = DetourAllocCounter::live_bytes();
+  barrier.release();
+  for (auto& t : match_threads) {
+    t.join();
+  }
+  EXPECT_EQ(failed_matches, 0);
+
+  // Each match pays for its handle and its thread queries - never for a copy
+  //  of the navmesh
+  const int64_t bytes_per_match =
+      (running_bytes - navmesh_bytes) / kMatchCount +
+      static_cast<int64_t>(sizeof(std::shared_ptr<const nav::DetourNavmesh>));
+  RecordProperty("navmesh_bytes", std::to_string(navmesh_bytes));
+  RecordProperty("navmesh_bytes_per_match", std::to_string(bytes_per_match));
+  EXPECT_GT(bytes_per_match, 0);
+  EXPECT_LT(bytes_per_match, 200 * 1024);
+
+  // Thread queries go with their threads, the navmesh with its last match
+  EXPECT_EQ(DetourAllocCounter::live_bytes(), navmesh_bytes);
+  matches.clear();
+  EXPECT_EQ(store_->live_asset_count(), 0u);
+  EXPECT_EQ(DetourAllocCounter::live_bytes(), 0);
+
+  dtAllocSetCustom(nullptr, nullptr);
+}
+
+TEST_F(SharedAssetStoreTest, ReleasedAssetsAreLoadedAgain) {
+  auto first = acquire();
+  finish_pending_loads(true);
+  first = nullptr;
+  EXPECT_EQ(store_->live_asset_count(), 0u);
+
+  auto second = acquire();
+  EXPECT_EQ(store_->loads_started(), 2u);
+  finish_pending_loads(true);
+  ASSERT_TRUE(second->unsafe_sync_get().is_left());
+}
+
+TEST_F(SharedAssetStoreTest, DifferentAssetsLoadSeparately) {
+  auto arena = acquire("pve-arena-navmesh");
+  auto lobby = acquire("lobby-navmesh");
+  EXPECT_EQ(store_->loads_started(), 2u);
+  finish_pending_loads(true);
+
+  EXPECT_NE(arena->unsafe_sync_get().get_left(),
+            lobby->unsafe_sync_get().get_left());
+  EXPECT_EQ(store_->live_asset_count(), 2u);
+}
+
+TEST_F(SharedAssetStoreTest, FailedLoadsAreRetried) {
+  auto failed = acquire();
+  auto also_failed = acquire();
+  finish_pending_loads(false);
+  EXPECT_TRUE(failed->unsafe_sync_get().is_right());
+  EXPECT_TRUE(also_failed->unsafe_sync_get().is_right());
+
+  auto retry = acquire();
+  EXPECT_EQ(store_->loads_started(), 2u);
+  finish_pending_loads(true);
+  EXPECT_TRUE(retry->unsafe_sync_get().is_left());
+}
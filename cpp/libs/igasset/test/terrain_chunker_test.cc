@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <igasset/terrain_chunker.h>
+
+#include <cmath>
+#include <set>
+
+using namespace indigo;
+using namespace asset;
+
+namespace {
+
+struct Heightfield {
+  core::PodVector<PositionNormalVertexData> vertices;
+  core::PodVector<uint32_t> indices;
+};
+
+// (quads x quads) grid of "spacing" sized quads starting at the origin, with
+//  gentle rolling hills
+Heightfield make_heightfield(uint32_t quads, float spacing) {
+  Heightfield hf;
+  const uint32_t row = quads + 1u;
+  for (uint32_t z = 0; z < row; z++) {
+    for (uint32_t x = 0; x < row; x++) {
+      PositionNormalVertexData v{};
+      v.Position = glm::vec3(x * spacing,
+                             std::sin(x * 0.3f) + std::cos(z * 0.2f),
+                             z * spacing);
+      v.NormalQuat = glm::vec4(0.f, 0.f, 0.f, 1.f);
+      hf.vertices.push_back(v);
+    }
+  }
+
+  for (uint32_t z = 0; z < quads; z++) {
+    for (uint32_t x = 0; x < quads; x++) {
+      const uint32_t i = z * row + x;
+      hf.indices.push_back(i);
+      hf.indices.push_back(i + row);
+      hf.indices.push_back(i + 1u);
+
+      hf.indices.push_back(i + 1u);
+      hf.indices.push_back(i + row);
+      hf.indices.push_back(i + row + 1u);
+    }
+  }
+
+  return hf;
+}
+
+}  // namespace
+
+TEST(TerrainChunker, SplitsIntoGridChunksKeepingEveryTriangle) {
+  // 64x64 units, 16 unit chunks -> 4x4 chunks
+  auto hf = ::make_heightfield(64u, 1.f);
+  auto chunks = TerrainChunker::build(hf.vertices, hf.indices,
+                                      TerrainChunker::Params{16.f, {}});
+
+  ASSERT_EQ(chunks.size(), 16u);
+
+  uint32_t total_triangles = 0u;
+  std::set<std::pair<int32_t, int32_t>> cells;
+  for (const auto& chunk : chunks) {
+    ASSERT_EQ(chunk.lods.size(), 1u);
+    total_triangles += chunk.lods[0].triangle_count();
+    cells.insert({chunk.gridX, chunk.gridZ});
+
+    // Every vertex inside the chunk's bounds, bounds near the chunk's cell
+    for (int i = 0; i < chunk.lods[0].vertices.size(); i++) {
+      const glm::vec3& p = chunk.lods[0].vertices[i].Position;
+      EXPECT_GE(p.x, chunk.boundsMin.x);
+      EXPECT_LE(p.x, chunk.boundsMax.x);
+      EXPECT_GE(p.z, chunk.boundsMin.z);
+      EXPECT_LE(p.z, chunk.boundsMax.z);
+    }
+    EXPECT_GE(chunk.boundsMin.x, chunk.gridX * 16.f - 1.f);
+    EXPECT_LE(chunk.boundsMax.x, (chunk.gridX + 1) * 16.f + 1.f);
+
+    for (int i = 0; i < chunk.lods[0].indices.size(); i++) {
+      EXPECT_LT(chunk.lods[0].indices[i], chunk.lods[0].vertices.size());
+    }
+  }
+
+  EXPECT_EQ(total_triangles, 64u * 64u * 2u);
+  EXPECT_EQ(cells.size(), 16u);
+}
+
+TEST(TerrainChunker, ChunksAreInRowOrder) {
+  auto hf = ::make_heightfield(32u, 1.f);
+  auto chunks = TerrainChunker::build(hf.vertices, hf.indices,
+                                      TerrainChunker::Params{16.f, {}});
+
+  ASSERT_EQ(chunks.size(), 4u);
+  EXPECT_EQ(chunks[0].gridX, 0);
+  EXPECT_EQ(chunks[0].gridZ, 0);
+  EXPECT_EQ(chunks[1].gridX, 1);
+  EXPECT_EQ(chunks[1].gridZ, 0);
+  EXPECT_EQ(chunks[2].gridX, 0);
+  EXPECT_EQ(chunks[2].gridZ, 1);
+}
+
+TEST(TerrainChunker, LodsGetCoarser) {
+  auto hf = ::make_heightfield(32u, 0.5f);
+  auto chunks = TerrainChunker::build(hf.vertices, hf.indices,
+                                      TerrainChunker::Params{8.f, {1.f, 2.f}});
+
+  ASSERT_FALSE(chunks.empty());
+  for (const auto& chunk : chunks) {
+    ASSERT_EQ(chunk.lods.size(), 3u);
+    EXPECT_LT(chunk.lods[1].triangle_count(), chunk.lods[0].triangle_count());
+    EXPECT_LT(chunk.lods[2].triangle_count(), chunk.lods[1].triangle_count());
+    EXPECT_GT(chunk.lods[2].triangle_count(), 0u);
+
+    for (uint32_t lod = 1u; lod < 3u; lod++) {
+      const auto& mesh = chunk.lods[lod];
+      for (int i = 0; i < mesh.vertices.size(); i++) {
+        // Simplified vertices are real vertices of the full detail mesh
+        const glm::vec3& p = mesh.vertices[i].Position;
+        EXPECT_GE(p.x, chunk.boundsMin.x);
+        EXPECT_LE(p.x, chunk.boundsMax.x);
+        EXPECT_GE(p.y, chunk.boundsMin.y);
+        EXPECT_LE(p.y, chunk.boundsMax.y);
+      }
+      for (int i = 0; i < mesh.indices.size(); i++) {
+        EXPECT_LT(mesh.indices[i], mesh.vertices.size());
+      }
+    }
+  }
+}
+
+TEST(TerrainChunker, SimplifyDropsDegenerateTriangles) {
+  auto hf = ::make_heightfield(4u, 1.f);
+  TerrainChunkMesh mesh{hf.vertices, hf.indices};
+
+  // Cells much bigger than the mesh - everything collapses
+  auto collapsed = TerrainChunker::simplify(mesh, 100.f);
+  EXPECT_EQ(collapsed.triangle_count(), 0u);
+  EXPECT_EQ(collapsed.vertices.size(), 0u);
+
+  // Cells smaller than the vertex spacing - nothing changes
+  auto unchanged = TerrainChunker::simplify(mesh, 0.25f);
+  EXPECT_EQ(unchanged.triangle_count(), mesh.triangle_count());
+  EXPECT_EQ(unchanged.vertices.size(), mesh.vertices.size());
+
+  for (int i = 0; i + 2 < unchanged.indices.size(); i += 3) {
+    EXPECT_NE(unchanged.indices[i], unchanged.indices[i + 1]);
+    EXPECT_NE(unchanged.indices[i + 1], unchanged.indices[i + 2]);
+    EXPECT_NE(unchanged.indices[i], unchanged.indices[i + 2]);
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef _LIB_IGASYNC_TASK_GROUP_H_
+#define _LIB_IGASYNC_TASK_GROUP_H_
+
+#include <igasync/task_list.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * TaskGroup - fork/join for a batch of short tasks that the calling thread
+ *  has to wait on (e.g. culling or preparing render passes mid-frame).
+ *
+ * Tasks are held on a TaskList that belongs to the group, not on the shared
+ *  task list - the calling thread only ever executes tasks of its own group
+ *  while it waits, so it never picks up unrelated (and possibly long running)
+ *  work from the shared list in the middle of a frame. Executor threads join
+ *  in through one helper task per group task on the shared list; helpers that
+ *  run after the group is drained do nothing.
+ */
+
+namespace indigo::core {
+
+class TaskGroup {
+ public:
+  TaskGroup();
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void add(std::function<void()> fn);
+
+  /**
+   * Execute every added task - on the calling thread, and on whichever threads
+   *  execute "any_thread" (if not null) - and return once all of them are done
+   */
+  void run_and_wait(const std::shared_ptr<TaskList>& any_thread);
+
+ private:
+  void finish_one();
+
+  std::shared_ptr<TaskList> tasks_;
+  uint32_t task_count_;
+
+  std::mutex m_;
+  std::condition_variable done_cv_;
+  uint32_t remaining_;
+};
+
+}  // namespace indigo::core
+
+#endif
@@ -0,0 +1,48 @@
+#include <igasync/task_group.h>
+
+using namespace indigo;
+using namespace core;
+
+TaskGroup::TaskGroup()
+    : tasks_(std::make_shared<TaskList>()), task_count_(0u), remaining_(0u) {}
+
+void TaskGroup::add(std::function<void()> fn) {
+  {
+    std::lock_guard l(m_);
+    remaining_++;
+  }
+  task_count_++;
+
+  tasks_->add_task(Task::of([this, fn = std::move(fn)]() {
+    fn();
+    finish_one();
+  }));
+}
+
+void TaskGroup::run_and_wait(const std::shared_ptr<TaskList>& any_thread) {
+  // The calling thread takes one task itself, so one fewer helper is needed
+  if (any_thread != nullptr) {
+    for (uint32_t i = 1; i < task_count_; i++) {
+      any_thread->add_task(
+          Task::of([tasks = tasks_]() { tasks->execute_next(); }));
+    }
+  }
+  task_count_ = 0u;
+
+  while (tasks_->execute_next()) {
+  }
+
+  // Everything is started - wait for tasks still running on other threads
+  std::unique_lock l(m_);
+  done_cv_.wait(l, [this]() { return remaining_ == 0u; });
+}
+
+void TaskGroup::finish_one() {
+  // Notify while holding the lock - the waiting thread may destroy the group
+  //  as soon as it can see the last task finish
+  std::lock_guard l(m_);
+  remaining_--;
+  if (remaining_ == 0u) {
+    done_cv_.notify_all();
+  }
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <igasync/task_group.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace indigo;
+using namespace core;
+
+TEST(TaskGroup, RunsEveryTaskWithoutATaskList) {
+  std::vector<int> results(8, 0);
+
+  TaskGroup group;
+  for (int i = 0; i < results.size(); i++) {
+    group.add([&results, i]() { results[i] = i + 1; });
+  }
+  group.run_and_wait(nullptr);
+
+  for (int i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i], i + 1);
+  }
+}
+
+TEST(TaskGroup, DoesNotRunUnrelatedTasksWhileWaiting) {
+  auto any_thread = std::make_shared<TaskList>();
+  bool ran_unrelated = false;
+  any_thread->add_task(Task::of([&ran_unrelated]() { ran_unrelated = true; }));
+
+  // No executor threads - the calling thread has to do everything itself
+  int ran_count = 0;
+  TaskGroup group;
+  for (int i = 0; i < 4; i++) {
+    group.add([&ran_count]() { ran_count++; });
+  }
+  group.run_and_wait(any_thread);
+
+  EXPECT_EQ(ran_count, 4);
+  EXPECT_FALSE(ran_unrelated);
+
+  // Helpers left on the shared list after the group is done are harmless
+  while (any_thread->execute_next()) {
+  }
+  EXPECT_TRUE(ran_unrelated);
+  EXPECT_EQ(ran_count, 4);
+}
+
+TEST(TaskGroup, WaitsForTasksRunningOnOtherThreads) {
+  auto any_thread = std::make_shared<TaskList>();
+  std::atomic_bool is_done(false);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < 4; i++) {
+    workers.emplace_back([any_thread, &is_done]() {
+      while (!is_done) {
+        if (!any_thread->execute_next()) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (int frame = 0; frame < 100; frame++) {
+    std::vector<std::atomic_int> results(16);
+    TaskGroup group;
+    for (int i = 0; i < results.size(); i++) {
+      group.add([&results, i]() { results[i] = i + 1; });
+    }
+    group.run_and_wait(any_thread);
+
+    for (int i = 0; i < results.size(); i++) {
+      ASSERT_EQ(results[i], i + 1);
+    }
+  }
+
+  is_done = true;
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
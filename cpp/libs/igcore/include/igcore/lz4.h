@@ -0,0 +1,35 @@
+#ifndef _LIB_IGCORE_LZ4_H_
+#define _LIB_IGCORE_LZ4_H_
+
+/**
+ * LZ4 block format compression (no frame header - callers store the
+ *  uncompressed size themselves). Output is readable by LZ4_decompress_safe,
+ *  and any LZ4 block can be read by Lz4::decompress.
+ *
+ * Compression is a plain greedy single-pass match search - asset packs are
+ *  compressed once offline, so it favours simplicity over ratio. Decompression
+ *  is the part that runs in clients, and validates all lengths/offsets against
+ *  the input and output buffers.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace indigo::core {
+
+class Lz4 {
+ public:
+  static std::string compress(const uint8_t* data, size_t size);
+
+  /**
+   * Decompress "src" into exactly "dst_size" bytes at "dst" - false if the
+   *  block is malformed or does not decompress to exactly dst_size bytes
+   */
+  static bool decompress(const uint8_t* src, size_t src_size, uint8_t* dst,
+                         size_t dst_size);
+};
+
+}  // namespace indigo::core
+
+#endif
@@ -75,6 +75,10 @@ class PodVector : public IVec<T> {
   }
 
   PodVector<T> &operator=(PodVector<T> &&o) {
+    if (this == &o) {
+      return *this;
+    }
+    delete[] data_;
     this->data_ = o.data_;
     this->size_ = o.size_;
     this->capacity_ = o.capacity_;
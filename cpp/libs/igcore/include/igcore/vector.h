@@ -40,6 +40,10 @@ class Vector : public IVec<T> {
   }
 
   Vector<T>& operator=(Vector<T>&& o) {
+    if (this == &o) {
+      return *this;
+    }
+    delete[] data_;
     this->data_ = o.data_;
     this->size_ = o.size_;
     this->capacity_ = o.capacity_;
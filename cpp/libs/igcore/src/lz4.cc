@@ -0,0 +1,185 @@
+#include <igcore/lz4.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+constexpr size_t kMinMatch = 4u;
+
+// Format constraints - the last 5 bytes are always literals, and the last
+//  match starts at least 12 bytes before the end of the block
+constexpr size_t kLastLiterals = 5u;
+constexpr size_t kMatchFindLimit = 12u;
+
+constexpr size_t kMaxOffset = 0xFFFFu;
+constexpr uint32_t kHashLog = 16u;
+constexpr uint32_t kNoPosition = 0xFFFFFFFFu;
+
+uint32_t read32(const uint8_t* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+uint32_t hash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32u - kHashLog);
+}
+
+void write_length(std::string& out, size_t length) {
+  while (length >= 255u) {
+    out.push_back(static_cast<char>(255u));
+    length -= 255u;
+  }
+  out.push_back(static_cast<char>(length));
+}
+
+void write_literals(std::string& out, const uint8_t* literals, size_t length,
+                    uint8_t match_nibble) {
+  uint8_t lit_nibble = length >= 15u ? 15u : static_cast<uint8_t>(length);
+  out.push_back(static_cast<char>((lit_nibble << 4) | match_nibble));
+  if (length >= 15u) {
+    ::write_length(out, length - 15u);
+  }
+  out.append(reinterpret_cast<const char*>(literals), length);
+}
+
+bool read_length(const uint8_t* src, size_t src_size, size_t* ip,
+                 size_t* length) {
+  uint8_t b;
+  do {
+    if (*ip >= src_size) {
+      return false;
+    }
+    b = src[(*ip)++];
+    *length += b;
+  } while (b == 255u);
+  return true;
+}
+}  // namespace
+
+std::string Lz4::compress(const uint8_t* data, size_t size) {
+  std::string out;
+  out.reserve(size + size / 255u + 16u);
+
+  size_t anchor = 0u;
+  if (size > kMatchFindLimit) {
+    std::vector<uint32_t> table(size_t{1} << kHashLog, kNoPosition);
+    const size_t match_start_limit = size - kMatchFindLimit;
+    const size_t match_end_limit = size - kLastLiterals;
+
+    size_t ip = 0u;
+    while (ip <= match_start_limit) {
+      uint32_t sequence = ::read32(data + ip);
+      uint32_t& slot = table[::hash(sequence)];
+      size_t candidate = slot;
+      slot = static_cast<uint32_t>(ip);
+
+      if (candidate == kNoPosition || ip - candidate > kMaxOffset ||
+          ::read32(data + candidate) != sequence) {
+        ip++;
+        continue;
+      }
+
+      while (ip > anchor && candidate > 0u &&
+             data[ip - 1u] == data[candidate - 1u]) {
+        ip--;
+        candidate--;
+      }
+
+      size_t match_length = kMinMatch;
+      while (ip + match_length < match_end_limit &&
+             data[candidate + match_length] == data[ip + match_length]) {
+        match_length++;
+      }
+
+      size_t extra_match = match_length - kMinMatch;
+      ::write_literals(out, data + anchor, ip - anchor,
+                       extra_match >= 15u ? 15u
+                                          : static_cast<uint8_t>(extra_match));
+      size_t offset = ip - candidate;
+      out.push_back(static_cast<char>(offset & 0xFFu));
+      out.push_back(static_cast<char>(offset >> 8));
+      if (extra_match >= 15u) {
+        ::write_length(out, extra_match - 15u);
+      }
+
+      ip += match_length;
+      anchor = ip;
+
+      // Positions inside the match are skipped - index one near its end so
+      //  that a following repeat can still be found
+      if (ip <= match_start_limit) {
+        size_t near_end = ip - 2u;
+        table[::hash(::read32(data + near_end))] =
+            static_cast<uint32_t>(near_end);
+      }
+    }
+  }
+
+  ::write_literals(out, data + anchor, size - anchor, 0u);
+  return out;
+}
+
+bool Lz4::decompress(const uint8_t* src, size_t src_size, uint8_t* dst,
+                     size_t dst_size) {
+  size_t ip = 0u;
+  size_t op = 0u;
+
+  while (true) {
+    if (ip >= src_size) {
+      return false;
+    }
+
+    uint8_t token = src[ip++];
+    size_t literal_length = token >> 4;
+    if (literal_length == 15u &&
+        !::read_length(src, src_size, &ip, &literal_length)) {
+      return false;
+    }
+
+    if (literal_length > src_size - ip || literal_length > dst_size - op) {
+      return false;
+    }
+    std::memcpy(dst + op, src + ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    // The last sequence is literals only
+    if (ip == src_size) {
+      return op == dst_size;
+    }
+
+    if (src_size - ip < 2u) {
+      return false;
+    }
+    size_t offset = src[ip] | (static_cast<size_t>(src[ip + 1u]) << 8);
+    ip += 2u;
+    if (offset == 0u || offset > op) {
+      return false;
+    }
+
+    size_t match_length = token & 0x0Fu;
+    if (match_length == 15u &&
+        !::read_length(src, src_size, &ip, &match_length)) {
+      return false;
+    }
+    match_length += kMinMatch;
+    if (match_length > dst_size - op) {
+      return false;
+    }
+
+    const uint8_t* match = dst + op - offset;
+    if (offset >= match_length) {
+      std::memcpy(dst + op, match, match_length);
+    } else {
+      // Overlapping match - repeats the last "offset" bytes
+      for (size_t i = 0u; i < match_length; i++) {
+        dst[op + i] = match[i];
+      }
+    }
+    op += match_length;
+  }
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <igcore/lz4.h>
+
+#include <random>
+#include <string>
+
+using namespace indigo::core;
+
+namespace {
+std::string round_trip(const std::string& input) {
+  std::string compressed = Lz4::compress(
+      reinterpret_cast<const uint8_t*>(input.data()), input.size());
+
+  std::string output(input.size(), '\0');
+  EXPECT_TRUE(Lz4::decompress(
+      reinterpret_cast<const uint8_t*>(compressed.data()), compressed.size(),
+      reinterpret_cast<uint8_t*>(&output[0]), output.size()));
+  return output;
+}
+}  // namespace
+
+TEST(Lz4, RoundTripsEmptyAndShortInputs) {
+  EXPECT_EQ(::round_trip(""), "");
+  EXPECT_EQ(::round_trip("a"), "a");
+  EXPECT_EQ(::round_trip("aaaaaaaaaaaaa"), "aaaaaaaaaaaaa");
+}
+
+TEST(Lz4, CompressesRepetitiveData) {
+  std::string input;
+  for (int i = 0; i < 1000; i++) {
+    input += "indigo-asset-" + std::to_string(i % 7);
+  }
+
+  std::string compressed = Lz4::compress(
+      reinterpret_cast<const uint8_t*>(input.data()), input.size());
+  EXPECT_LT(compressed.size(), input.size() / 10u);
+  EXPECT_EQ(::round_trip(input), input);
+}
+
+TEST(Lz4, RoundTripsLongRunsAndRandomData) {
+  std::mt19937 rng(1234u);
+  std::string input(300000u, '\0');
+  for (size_t i = 0; i < input.size(); i++) {
+    // Mix of incompressible stretches, long runs and short repeats
+    size_t section = (i / 10000u) % 3u;
+    input[i] = section == 0u   ? static_cast<char>(rng())
+               : section == 1u ? 'x'
+                               : static_cast<char>('a' + i % 5u);
+  }
+
+  EXPECT_EQ(::round_trip(input), input);
+}
+
+TEST(Lz4, DecodesReferenceBlock) {
+  // Hand-assembled block for "abcabcabcabcabcabcabcabcabc" - 3 literals, a
+  //  19 byte overlapping match at offset 3, then 5 trailing literals
+  const uint8_t block[] = {0x3F, 'a', 'b', 'c', 0x03, 0x00, 0x00,
+                           0x50, 'b', 'c', 'a', 'b', 'c'};
+  std::string output(27u, '\0');
+  ASSERT_TRUE(Lz4::decompress(block, sizeof(block),
+                              reinterpret_cast<uint8_t*>(&output[0]),
+                              output.size()));
+  EXPECT_EQ(output, "abcabcabcabcabcabcabcabcabc");
+}
+
+TEST(Lz4, RejectsMalformedBlocks) {
+  std::string input(1000u, 'z');
+  std::string compressed = Lz4::compress(
+      reinterpret_cast<const uint8_t*>(input.data()), input.size());
+  std::string output(input.size(), '\0');
+  uint8_t* dst = reinterpret_cast<uint8_t*>(&output[0]);
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(compressed.data());
+
+  // Truncated input, wrong output size
+  EXPECT_FALSE(Lz4::decompress(src, compressed.size() - 1u, dst, 1000u));
+  EXPECT_FALSE(Lz4::decompress(src, compressed.size(), dst, 999u));
+
+  // Match offset pointing before the start of the output
+  const uint8_t bad_offset[] = {0x10, 'a', 0x05, 0x00, 0x00};
+  EXPECT_FALSE(Lz4::decompress(bad_offset, sizeof(bad_offset), dst, 1000u));
+}
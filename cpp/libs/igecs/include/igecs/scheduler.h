@@ -7,6 +7,7 @@
 #include <igecs/world_view.h>
 
 #include <chrono>
+#include <string>
 
 namespace indigo::igecs {
 
@@ -40,6 +41,7 @@ class Scheduler {
 
       Builder& main_thread_only();
       Builder& with_decl(WorldView::Decl decl);
+      Builder& with_name(std::string name);
       Builder& depends_on(const Node& node);
 
       /** Callback consumes a WorldView, and returns an EmptyPromiseRsl */
@@ -57,6 +59,7 @@ class Scheduler {
       bool is_built_;
       NodeId node_id_;
       bool is_main_thread_only_;
+      std::string name_;
       WorldView::Decl world_view_decl_;
       indigo::core::PodVector<NodeId> dependency_ids_;
       Scheduler::Builder& b_;
@@ -69,13 +72,20 @@ class Scheduler {
 
    private:
     Node(WorldView::Decl wv_decl, bool main_thread_only, NodeId id,
-         indigo::core::PodVector<NodeId> dependency_ids,
+         std::string name, indigo::core::PodVector<NodeId> dependency_ids,
          std::function<std::shared_ptr<indigo::core::Promise<
              indigo::core::EmptyPromiseRsl>>(WorldView* wv)>
              cb);
 
     NodeId id_;
     bool main_thread_only_;
+    std::string name_;
+
+    // Profiling - only written by the thread executing this node, and only
+    //  read after the owning Scheduler::execute call returns
+    uint32_t run_count_;
+    std::chrono::high_resolution_clock::duration total_run_time_;
+
     WorldView::Decl wv_decl_;
     std::function<std::shared_ptr<
         indigo::core::Promise<indigo::core::EmptyPromiseRsl>>(WorldView* wv)>
@@ -106,6 +116,19 @@ class Scheduler {
   void execute(std::shared_ptr<indigo::core::TaskList> any_thread_task_list,
                entt::registry* world);
 
+  /**
+   * Per-node timing, accumulated across every "execute" call since the last
+   *  reset. Only the synchronous part of each node callback is measured - time
+   *  spent waiting on a returned promise is not attributed to the node.
+   */
+  struct NodeProfile {
+    std::string name;
+    uint32_t runCount;
+    std::chrono::high_resolution_clock::duration totalRunTime;
+  };
+  indigo::core::Vector<NodeProfile> profile() const;
+  void reset_profile();
+
  private:
   Scheduler(Builder b);
 
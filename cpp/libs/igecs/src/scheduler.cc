@@ -28,6 +28,12 @@ Scheduler::Node::Builder& Scheduler::Node::Builder::with_decl(
   return *this;
 }
 
+Scheduler::Node::Builder& Scheduler::Node::Builder::with_name(
+    std::string name) {
+  name_ = std::move(name);
+  return *this;
+}
+
 Scheduler::Node::Builder& Scheduler::Node::Builder::depends_on(
     const Scheduler::Node& node) {
   if (!dependency_ids_.contains(node.id_)) {
@@ -42,9 +48,13 @@ Scheduler::Node Scheduler::Node::Builder::build(
         cb) {
   assert(!is_built_ && "[IgECS::Scheduler] Node is already built");
 
-  auto node =
-      Scheduler::Node(std::move(world_view_decl_), is_main_thread_only_,
-                      node_id_, std::move(dependency_ids_), std::move(cb));
+  if (name_.empty()) {
+    name_ = "node_" + std::to_string(node_id_.id);
+  }
+
+  auto node = Scheduler::Node(std::move(world_view_decl_),
+                              is_main_thread_only_, node_id_, std::move(name_),
+                              std::move(dependency_ids_), std::move(cb));
   b_.nodes_.push_back(node);
 
   is_built_ = true;
@@ -66,16 +76,21 @@ Scheduler::Node Scheduler::Node::Builder::build(void (*cb)(WorldView* wv)) {
 Scheduler::Node::Node()
     : id_(NodeId{0}),
       main_thread_only_(false),
+      run_count_(0u),
+      total_run_time_(0),
       wv_decl_(WorldView::Decl::Thin()) {}
 
 Scheduler::Node::Node(
     WorldView::Decl wv_decl, bool main_thread_only, NodeId id,
-    indigo::core::PodVector<NodeId> dependency_ids,
+    std::string name, indigo::core::PodVector<NodeId> dependency_ids,
     std::function<std::shared_ptr<
         indigo::core::Promise<indigo::core::EmptyPromiseRsl>>(WorldView* wv)>
         cb)
     : id_(id),
       main_thread_only_(main_thread_only),
+      name_(std::move(name)),
+      run_count_(0u),
+      total_run_time_(0),
       wv_decl_(std::move(wv_decl)),
       cb_(std::move(cb)),
       dependency_ids_(std::move(dependency_ids)) {}
@@ -88,8 +103,12 @@ Scheduler::Node::schedule(entt::registry* world,
   std::shared_ptr<core::TaskList> tl =
       main_thread_only_ ? main_thread : any_thread;
   tl->add_task(core::Task::of([this, world, rsl, any_thread]() {
+    auto start = std::chrono::high_resolution_clock::now();
     auto wv = wv_decl_.create(world);
-    cb_(&wv)->on_success([rsl](const auto&) { rsl->resolve({}); }, any_thread);
+    auto cb_rsl = cb_(&wv);
+    total_run_time_ += std::chrono::high_resolution_clock::now() - start;
+    run_count_++;
+    cb_rsl->on_success([rsl](const auto&) { rsl->resolve({}); }, any_thread);
   }));
 
   return rsl;
@@ -384,3 +403,20 @@ void Scheduler::execute(
     }
   }
 }
+
+indigo::core::Vector<Scheduler::NodeProfile> Scheduler::profile() const {
+  indigo::core::Vector<NodeProfile> profile(nodes_.size());
+  for (int i = 0; i < nodes_.size(); i++) {
+    profile.push_back(NodeProfile{nodes_[i].name_, nodes_[i].run_count_,
+                                  nodes_[i].total_run_time_});
+  }
+  return profile;
+}
+
+void Scheduler::reset_profile() {
+  for (int i = 0; i < nodes_.size(); i++) {
+    nodes_[i].run_count_ = 0u;
+    nodes_[i].total_run_time_ =
+        std::chrono::high_resolution_clock::duration(0);
+  }
+}
@@ -128,6 +128,48 @@ TEST(IgECS_Scheduler, ExecutesWithDependencies) {
   EXPECT_TRUE(n2_ran);
 }
 
+TEST(IgECS_Scheduler, ProfilesNodeExecution) {
+  Scheduler::Builder sb;
+
+  Scheduler::Node n1 =
+      sb.add_node()
+          .with_name("WriteFoo")
+          .with_decl(::write_foo_decl())
+          .build([](WorldView*) { return core::immediateEmptyPromise(); });
+
+  Scheduler::Node n2 =
+      sb.add_node()
+          .with_decl(::read_foo_decl())
+          .depends_on(n1)
+          .build([](WorldView*) { return core::immediateEmptyPromise(); });
+
+  Scheduler scheduler = sb.build();
+
+  entt::registry world;
+  scheduler.execute(nullptr, &world);
+  scheduler.execute(nullptr, &world);
+
+  auto profile = scheduler.profile();
+  ASSERT_EQ(profile.size(), 2);
+
+  bool found_named = false;
+  for (int i = 0; i < profile.size(); i++) {
+    EXPECT_EQ(profile[i].runCount, 2u);
+    EXPECT_FALSE(profile[i].name.empty());
+    if (profile[i].name == "WriteFoo") {
+      found_named = true;
+    }
+  }
+  EXPECT_TRUE(found_named);
+
+  scheduler.reset_profile();
+  auto reset_profile = scheduler.profile();
+  for (int i = 0; i < reset_profile.size(); i++) {
+    EXPECT_EQ(reset_profile[i].runCount, 0u);
+    EXPECT_EQ(reset_profile[i].totalRunTime.count(), 0);
+  }
+}
+
 TEST(IgECS_Scheduler, SuccessfullyBuildsWithCorrectDepChaining) {
   Scheduler::Builder sb;
 
@@ -0,0 +1,173 @@
+/**
+ * InstanceBufferStore microbenchmark - records a fixed number of instances
+ *  spread across a fixed number of keys every frame, and measures the CPU
+ *  cost of batching them and uploading them to the GPU.
+ *
+ * Runs against Dawn's Null backend, so the numbers are the CPU side of the
+ *  store only (bookkeeping + WebGPU validation/staging of the upload), and do
+ *  not depend on the GPU or driver of the machine.
+ *
+ * iggpu-instance-buffer-store-benchmark --instances 10000 --keys 200
+ */
+
+#include <dawn/dawn_proc.h>
+#include <dawn/native/DawnNative.h>
+#include <igcore/log.h>
+#include <iggpu/instance_buffer_store.h>
+
+#include <CLI/CLI.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+
+using namespace indigo;
+using namespace core;
+using namespace iggpu;
+
+namespace {
+const char* kLogLabel = "instance-buffer-store-benchmark";
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct BenchmarkKey {
+  uint32_t slot;
+  uint32_t generation;
+
+  uint32_t get_slot() const { return slot; }
+  uint32_t get_generation() const { return generation; }
+  int get_lifetime() const { return 10; }
+};
+
+// Same size as a world transform, which is what the solid static pipeline
+//  and debug geo pipelines instance
+struct BenchmarkInstance {
+  float matWorld[16];
+};
+
+wgpu::Device create_null_device(
+    const std::unique_ptr<dawn_native::Instance>& instance) {
+  instance->DiscoverDefaultAdapters();
+
+  for (const dawn_native::Adapter& adapter : instance->GetAdapters()) {
+    wgpu::AdapterProperties adapter_properties{};
+    adapter.GetProperties(&adapter_properties);
+    if (adapter_properties.backendType != wgpu::BackendType::Null) {
+      continue;
+    }
+
+    wgpu::DeviceDescriptor device_desc{};
+    device_desc.label = "NullBenchmarkDevice";
+    WGPUDevice raw_device = adapter.CreateDevice(&device_desc);
+    if (!raw_device) {
+      return nullptr;
+    }
+
+    DawnProcTable procs = dawn_native::GetProcs();
+    dawnProcSetProcs(&procs);
+    return wgpu::Device::Acquire(raw_device);
+  }
+
+  return nullptr;
+}
+
+double elapsed_us(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+      .count();
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  CLI::App app{"InstanceBufferStore benchmark (Dawn Null backend)"};
+
+  uint32_t instance_count = 10000u;
+  uint32_t key_count = 200u;
+  uint32_t frame_count = 1000u;
+  uint32_t warmup_frame_count = 50u;
+  uint32_t seed = 1337u;
+
+  app.add_option("-i,--instances", instance_count, "Instances per frame");
+  app.add_option("-k,--keys", key_count, "Distinct keys per frame");
+  app.add_option("-n,--frames", frame_count, "Measured frame count");
+  app.add_option("--warmup_frames", warmup_frame_count,
+                 "Frames to run before measurement starts");
+  app.add_option("--seed", seed, "Instance-to-key assignment RNG seed");
+
+  CLI11_PARSE(app, argc, argv);
+
+  if (key_count == 0u) {
+    key_count = 1u;
+  }
+
+  auto instance = std::make_unique<dawn_native::Instance>();
+  wgpu::Device device = ::create_null_device(instance);
+  if (!device) {
+    Logger::err(kLogLabel) << "No Null backend adapter - was Dawn built with "
+                              "DAWN_ENABLE_NULL?";
+    return -1;
+  }
+
+  // Instances are recorded in a fixed, shuffled key order (the way an ECS
+  //  view walks entities), not grouped by key
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<uint32_t> key_dist(0u, key_count - 1u);
+  PodVector<uint32_t> instance_keys(instance_count);
+  for (uint32_t i = 0; i < instance_count; i++) {
+    instance_keys.push_back(key_dist(rng));
+  }
+
+  BenchmarkInstance instance_data{};
+  for (int i = 0; i < 16; i++) {
+    instance_data.matWorld[i] = (i % 5 == 0) ? 1.f : 0.f;
+  }
+
+  InstanceBufferStore<BenchmarkKey, BenchmarkInstance> store;
+
+  double record_us = 0.;
+  double finalize_us = 0.;
+  uint32_t draw_count = 0u;
+  for (uint32_t frame = 0; frame < warmup_frame_count + frame_count;
+       frame++) {
+    const bool measure = frame >= warmup_frame_count;
+
+    auto record_start = Clock::now();
+    store.begin_frame();
+    for (int i = 0; i < instance_keys.size(); i++) {
+      store.add_instance(BenchmarkKey{instance_keys[i], 1u}, instance_data);
+    }
+    double frame_record_us = ::elapsed_us(record_start);
+
+    uint32_t frame_draw_count = 0u;
+    auto finalize_start = Clock::now();
+    store.finalize(device, [&frame_draw_count](const BenchmarkKey&,
+                                               const wgpu::Buffer&, uint64_t,
+                                               uint32_t) {
+      frame_draw_count++;
+    });
+    double frame_finalize_us = ::elapsed_us(finalize_start);
+
+    // Let Dawn retire the staged writes, the same as a real frame would
+    device.Tick();
+
+    if (measure) {
+      record_us += frame_record_us;
+      finalize_us += frame_finalize_us;
+      draw_count += frame_draw_count;
+    }
+  }
+
+  const double frames = frame_count > 0u ? frame_count : 1.;
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Instances: " << instance_count << ", keys: " << key_count
+            << ", frames: " << frame_count << "\n";
+  std::cout << "  record:   " << record_us / frames << "us/frame\n";
+  std::cout << "  finalize: " << finalize_us / frames << "us/frame\n";
+  std::cout << "  total:    " << (record_us + finalize_us) / frames
+            << "us/frame\n";
+  std::cout << "  draws:    " << draw_count / frames << "/frame\n";
+  std::cout << "  buffer:   " << store.capacity() << " instances ("
+            << store.capacity() * sizeof(BenchmarkInstance) << " bytes)\n";
+
+  return 0;
+}
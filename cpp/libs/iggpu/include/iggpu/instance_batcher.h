@@ -0,0 +1,195 @@
+#ifndef LIBS_IGGPU_INCLUDE_IGGPU_INSTANCE_BATCHER_H
+#define LIBS_IGGPU_INCLUDE_IGGPU_INSTANCE_BATCHER_H
+
+#include <igcore/pod_vector.h>
+#include <igcore/vector.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace indigo::iggpu {
+
+/**
+ * CPU half of InstanceBufferStore - groups instances by key, and packs every
+ *  key's instances back to back into one frame buffer. No GPU types in here,
+ *  so the bookkeeping can be tested and benchmarked on its own.
+ *
+ * Start a frame with "begin_frame", "add_instance" for every instance, then
+ *  "pack" - after that, "packed_instances" holds every instance of the frame
+ *  and "for_each_batch" gives each key's range in it.
+ *
+ * Requirements:
+ * 1. KeyT must have a "uint32_t get_slot() const" method - a small, dense
+ *    index used for O(1) lookup (ReadonlyResourceRegistry<>::Key::
+ *    get_raw_index() works well)
+ * 2. KeyT must have a "uint32_t get_generation() const" method - tells apart
+ *    keys that use the same slot at different times (ReadonlyResourceRegistry<>
+ *    ::Key::get_raw_key() works well)
+ * 3. KeyT must be copyable and default constructible
+ * 4. KeyT must have an "int get_lifetime() const" method
+ *    This lifetime method determines how many frames a key can be inactive
+ *    before the memory is cleared - this helps reclaim memory use without
+ *    completely discarding buffers. A negative number indicates the buffers
+ *    should not be kept after finalization.
+ * 5. InstanceT must be a POD type that can be stored in a contiguous GPU buffer
+ */
+template <typename KeyT, typename InstanceT>
+class InstanceBatcher {
+ public:
+  static constexpr uint32_t kMinCapacity = 64u;
+
+  /** Geometric growth, so a slowly growing scene re-allocates O(log n) times */
+  static uint32_t grow_capacity(uint32_t capacity, uint32_t required) {
+    if (capacity >= required) {
+      return capacity;
+    }
+
+    uint32_t new_capacity = capacity < kMinCapacity ? kMinCapacity : capacity;
+    while (new_capacity < required) {
+      new_capacity *= 2u;
+    }
+    return new_capacity;
+  }
+
+  InstanceBatcher() : slot_entries_(16), packed_instances_(kMinCapacity) {}
+
+  void begin_frame() {
+    // Drop keys that have gone too long without being used - this includes
+    //  keys that asked to not be kept past their frame (negative lifetime)
+    for (int i = 0; i < entries_.size(); i++) {
+      if (entries_[i].deadFrameCount >= entries_[i].frameLifetime) {
+        remove_entry(i--);
+      }
+    }
+
+    for (int i = 0; i < entries_.size(); i++) {
+      entries_[i].instanceCache.resize(0);
+    }
+    packed_instances_.resize(0);
+  }
+
+  void add_instance(const KeyT& key, const InstanceT& instance) {
+    get_entry(key).instanceCache.push_back(instance);
+  }
+
+  /**
+   * Lay out every active key's instances in "packed_instances", and age keys
+   *  that had no instances this frame (they are dropped in "begin_frame" once
+   *  past their lifetime)
+   */
+  void pack() {
+    uint32_t total_instances = 0u;
+    for (int i = 0; i < entries_.size(); i++) {
+      total_instances +=
+          static_cast<uint32_t>(entries_[i].instanceCache.size());
+    }
+
+    packed_instances_.resize(total_instances);
+    uint32_t next_offset = 0u;
+    for (int i = 0; i < entries_.size(); i++) {
+      Entry& entry = entries_[i];
+      entry.packedOffset = next_offset;
+
+      const uint32_t count =
+          static_cast<uint32_t>(entry.instanceCache.size());
+      if (count == 0u) {
+        entry.deadFrameCount++;
+        continue;
+      }
+
+      entry.deadFrameCount = 0;
+      std::memcpy(packed_instances_.raw() + next_offset,
+                  entry.instanceCache.raw(), entry.instanceCache.raw_size());
+      next_offset += count;
+    }
+  }
+
+  /** Every instance added this frame, grouped by key (valid after "pack") */
+  const core::PodVector<InstanceT>& packed_instances() const {
+    return packed_instances_;
+  }
+
+  /**
+   * Invoke "cb(key, first_instance, num_instances)" for every key that had
+   *  instances this frame (valid after "pack")
+   */
+  template <typename CbT>
+  void for_each_batch(CbT&& cb) const {
+    for (int i = 0; i < entries_.size(); i++) {
+      const Entry& entry = entries_[i];
+      if (entry.instanceCache.size() == 0) {
+        continue;
+      }
+      cb(entry.key, entry.packedOffset,
+         static_cast<uint32_t>(entry.instanceCache.size()));
+    }
+  }
+
+  /** Keys tracked, including inactive ones that have not been dropped yet */
+  uint32_t key_count() const { return static_cast<uint32_t>(entries_.size()); }
+
+ private:
+  static constexpr uint32_t kNoEntry = 0xFFFFFFFFu;
+
+  struct Entry {
+    KeyT key;
+    uint32_t slot;
+    uint32_t generation;
+    int frameLifetime;
+    int deadFrameCount;
+    uint32_t packedOffset;
+    core::PodVector<InstanceT> instanceCache;
+  };
+
+  Entry& get_entry(const KeyT& key) {
+    const uint32_t slot = key.get_slot();
+    const uint32_t generation = key.get_generation();
+
+    if (slot >= slot_entries_.size()) {
+      const uint32_t old_size = static_cast<uint32_t>(slot_entries_.size());
+      slot_entries_.resize(slot + 1u);
+      for (uint32_t i = old_size; i <= slot; i++) {
+        slot_entries_[i] = kNoEntry;
+      }
+    }
+
+    const uint32_t entry_idx = slot_entries_[slot];
+    if (entry_idx != kNoEntry) {
+      Entry& entry = entries_[entry_idx];
+      if (entry.generation != generation) {
+        // Same slot, new key - the old key is gone for good, so its instance
+        //  memory goes to the new one
+        entry.key = key;
+        entry.generation = generation;
+        entry.frameLifetime = key.get_lifetime();
+        entry.deadFrameCount = 0;
+        entry.instanceCache.resize(0);
+      }
+      return entry;
+    }
+
+    slot_entries_[slot] = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(Entry{key, slot, generation, key.get_lifetime(), 0, 0u,
+                             core::PodVector<InstanceT>(4)});
+    return entries_.last();
+  }
+
+  void remove_entry(int entry_idx) {
+    slot_entries_[entries_[entry_idx].slot] = kNoEntry;
+
+    const int last_idx = static_cast<int>(entries_.size()) - 1;
+    if (entry_idx != last_idx) {
+      slot_entries_[entries_[last_idx].slot] =
+          static_cast<uint32_t>(entry_idx);
+    }
+    entries_.delete_at(entry_idx, false);
+  }
+
+  core::Vector<Entry> entries_;
+  core::PodVector<uint32_t> slot_entries_;
+  core::PodVector<InstanceT> packed_instances_;
+};
+
+}  // namespace indigo::iggpu
+
+#endif
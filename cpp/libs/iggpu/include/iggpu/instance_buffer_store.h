@@ -3,11 +3,11 @@
 
 #include <igcore/pod_vector.h>
 #include <igcore/vector.h>
+#include <iggpu/instance_batcher.h>
 #include <iggpu/util.h>
 #include <webgpu/webgpu_cpp.h>
 
 #include <functional>
-#include <string>
 
 namespace indigo::iggpu {
 
@@ -17,112 +17,82 @@ namespace indigo::iggpu {
  *
  * Start a frame with "begin", which resets all instance buffers.
  * For each instance that should be rendered, "record" them as a
- * key:instance pair. This populates underlying contiguous buffers. Once
- * recording is finished, run the "finalize" command, which creates/updates
- * GPU resources with the appropriate instance buffers, and invokes a
- * callback for each key/instance buffer pair.
+ * key:instance pair. Once recording is finished, run the "finalize" command,
+ * which uploads every key's instances into one shared GPU buffer (one write
+ * per frame), and invokes a callback for each key with its byte offset into
+ * that buffer.
  *
- * Requirements:
- * 1. KeyT must have a "std::string get_key() const" method
- * 2. KeyT must be copyable (ideally a list of ReadonlyResourceRegistry<>::Key)
- * 3. KeyT must have an "int get_lifetime() const" method
- *    This lifetime method determines how many frames a key can be inactive
- *    before the memory is cleared - this helps reclaim memory use without
- *    completely discarding buffers. A negative number indicates the buffers
- *    should not be kept after finalization.
- * 4. InstanceT must be a POD type that can be stored in a contiguous GPU buffer
+ * The shared buffer grows geometrically, and is re-used every frame - queue
+ * writes are staged by WebGPU, so overwriting last frame's instances is safe.
+ *
+ * "pack" may be called ahead of "finalize" to do the CPU side of batching
+ * without touching the device (e.g. on a worker thread) - otherwise
+ * "finalize" packs on its own.
+ *
+ * See InstanceBatcher for KeyT and InstanceT requirements.
  */
 template <typename KeyT, typename InstanceT>
 class InstanceBufferStore {
  public:
+  InstanceBufferStore() : capacity_(0u), is_packed_(false) {}
+
   void begin_frame() {
-    for (int i = 0; i < gpu_resource_pairs_.size(); i++) {
-      gpu_resource_pairs_[i].instanceCache.resize(0);
-    }
+    batcher_.begin_frame();
+    is_packed_ = false;
   }
 
-  void add_instance(KeyT key, InstanceT instance) {
-    get_resource(key).instanceCache.push_back(instance);
+  void add_instance(const KeyT& key, const InstanceT& instance) {
+    batcher_.add_instance(key, instance);
+  }
+
+  void pack() {
+    if (!is_packed_) {
+      batcher_.pack();
+      is_packed_ = true;
+    }
   }
 
   void finalize(
       const wgpu::Device& device,
       std::function<void(const KeyT& key, const wgpu::Buffer& instance_buffer,
-                         uint32_t num_instances)>
+                         uint64_t offset, uint32_t num_instances)>
           cb) {
-    for (int i = 0; i < gpu_resource_pairs_.size(); i++) {
-      auto& resource = gpu_resource_pairs_[i];
-      // Skip dead resources for this frame (no instances added/drawn)
-      if (resource.instanceCache.size() == 0) {
-        resource.deadFrameCount++;
-        continue;
-      }
-
-      if (gpu_resource_pairs_[i].gpuResources.buffer == nullptr ||
-          resource.gpuResources.bufferCapacity <
-              resource.instanceCache.size()) {
-        // Case 1: create a new instance buffer on the GPU
-        resource.gpuResources.buffer = iggpu::buffer_from_data(
-            device, resource.instanceCache, wgpu::BufferUsage::Vertex);
-        resource.gpuResources.bufferCapacity = resource.instanceCache.size();
-      } else {
-        // Case 2: re-use the existing buffer, uploading new data
-        device.GetQueue().WriteBuffer(resource.gpuResources.buffer, 0,
-                                      &resource.instanceCache[0],
-                                      resource.instanceCache.raw_size());
-      }
-
-      cb(resource.key, resource.gpuResources.buffer,
-         resource.instanceCache.size());
+    pack();
+
+    const auto& instances = batcher_.packed_instances();
+    if (instances.size() == 0) {
+      return;
     }
 
-    // Delete all resources that have gone too long without being used. This
-    //  includes any resources that were marked as needing to be deleted after
-    //  no dead frames.
-    // Must be done outside of above loop because some resources may mark
-    //  themselves as -1 right off the bat
-    for (int i = 0; i < gpu_resource_pairs_.size(); i++) {
-      if (gpu_resource_pairs_[i].deadFrameCount >=
-          gpu_resource_pairs_[i].frameLifetime) {
-        gpu_resource_pairs_.delete_at(i--, false);
-      }
+    const uint32_t instance_count = static_cast<uint32_t>(instances.size());
+    if (buffer_ == nullptr || capacity_ < instance_count) {
+      capacity_ = InstanceBatcher<KeyT, InstanceT>::grow_capacity(
+          capacity_, instance_count);
+      buffer_ = iggpu::create_empty_buffer(
+          device, capacity_ * sizeof(InstanceT), wgpu::BufferUsage::Vertex);
     }
+
+    device.GetQueue().WriteBuffer(buffer_, 0, instances.raw(),
+                                  instances.raw_size());
+
+    batcher_.for_each_batch([this, &cb](const KeyT& key,
+                                        uint32_t first_instance,
+                                        uint32_t num_instances) {
+      cb(key, buffer_,
+         static_cast<uint64_t>(first_instance) * sizeof(InstanceT),
+         num_instances);
+    });
   }
 
- private:
-  /** GPU resource and capacity metadata */
-  struct GpuInstanceBufferRecord {
-    wgpu::Buffer buffer;
-    int bufferCapacity;
-  };
-
-  /** Entry in a list of resources */
-  struct IBKeyValuePair {
-    std::string keyString;
-    KeyT key;
-    int frameLifetime;
-    int deadFrameCount;
-    GpuInstanceBufferRecord gpuResources;
-    indigo::core::PodVector<InstanceT> instanceCache;
-  };
-
-  indigo::core::Vector<IBKeyValuePair> gpu_resource_pairs_;
+  const InstanceBatcher<KeyT, InstanceT>& batcher() const { return batcher_; }
+  uint32_t capacity() const { return capacity_; }
 
  private:
-  IBKeyValuePair& get_resource(KeyT key) {
-    std::string key_string = key.get_key();
-    for (int i = 0; i < gpu_resource_pairs_.size(); i++) {
-      if (gpu_resource_pairs_[i].keyString == key_string) {
-        return gpu_resource_pairs_[i];
-      }
-    }
+  InstanceBatcher<KeyT, InstanceT> batcher_;
 
-    gpu_resource_pairs_.push_back(
-        IBKeyValuePair{key_string, key, key.get_lifetime(), 0,
-                       GpuInstanceBufferRecord{nullptr, 0},
-                       indigo::core::PodVector<InstanceT>(4)});
-    return gpu_resource_pairs_.last();
-  }
+  wgpu::Buffer buffer_;
+  uint32_t capacity_;
+  bool is_packed_;
 };
 
 }  // namespace indigo::iggpu
@@ -18,6 +18,10 @@ struct PipelineBuilder {
 
   std::string vsEntryPoint;
   std::string fsEntryPoint;
+
+  // See RenderPipelineCache::key_of
+  uint64_t vsSourceHash;
+  uint64_t fsSourceHash;
 };
 
 }  // namespace indigo::iggpu
@@ -0,0 +1,184 @@
+#ifndef LIBS_IGGPU_INCLUDE_IGGPU_PIPELINE_CACHE_H
+#define LIBS_IGGPU_INCLUDE_IGGPU_PIPELINE_CACHE_H
+
+#include <igasync/promise.h>
+#include <igcore/maybe.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace indigo::iggpu {
+
+/**
+ * Pipelines shared by key - everyone asking for the same key (shader sources,
+ *  vertex layout, target formats, see RenderPipelineCache) gets the same
+ *  pipeline, so identical pipelines are only ever built once per app.
+ *
+ * "get_or_create" returns the cached pipeline, or builds one on the spot
+ *  (blocking the calling thread). "get_or_create_async" starts a build without
+ *  waiting on it, and hands out the same promise to anyone asking for the same
+ *  key while it is in flight. "get_if_ready" never blocks - render code should
+ *  skip (or use a placeholder for) anything whose pipeline is not ready yet.
+ *
+ * Time spent on the calling thread building pipelines (or starting async
+ *  builds) is reported in Stats. Entries are never evicted - except for failed
+ *  async builds, which are forgotten so that a later call can try again.
+ *
+ * No GPU types in here, so caching can be tested on its own - PipelineT is
+ *  whatever the creation callbacks hand back, and should be a cheap handle.
+ */
+template <typename PipelineT>
+class PipelineCache {
+ public:
+  struct Stats {
+    uint32_t syncCreateCount;
+    uint32_t asyncCreateCount;
+    uint32_t cacheHitCount;
+    double blockingMs;
+  };
+
+  // Called exactly once with the built pipeline (or empty if the build
+  //  failed), from any thread. Waiters on a failed build get a default
+  //  constructed PipelineT (a null handle).
+  typedef std::function<void(core::Maybe<PipelineT>)> ResolveFn;
+
+  PipelineCache() : state_(std::make_shared<State>()) {}
+
+  template <typename CreateFnT>
+  PipelineT get_or_create(uint64_t key, CreateFnT&& create_fn) {
+    {
+      std::lock_guard l(state_->mut);
+      auto it = state_->entries.find(key);
+      if (it != state_->entries.end() && it->second.pipeline.has_value()) {
+        state_->stats.cacheHitCount++;
+        return it->second.pipeline.get();
+      }
+    }
+
+    // Not built yet (or still building asynchronously) - build it here. An
+    //  in-flight async build still resolves its own promise later.
+    auto start = std::chrono::high_resolution_clock::now();
+    PipelineT pipeline = create_fn();
+    double elapsed_ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::high_resolution_clock::now() - start)
+                            .count();
+
+    std::lock_guard l(state_->mut);
+    state_->stats.syncCreateCount++;
+    state_->stats.blockingMs += elapsed_ms;
+
+    Entry& entry = state_->entries[key];
+    if (entry.pipeline.has_value()) {
+      return entry.pipeline.get();
+    }
+    entry.pipeline = PipelineT(pipeline);
+    return pipeline;
+  }
+
+  /** "start_fn" is given a ResolveFn, and should kick off the build with it */
+  template <typename StartFnT>
+  std::shared_ptr<core::Promise<PipelineT>> get_or_create_async(
+      uint64_t key, StartFnT&& start_fn) {
+    std::shared_ptr<core::Promise<PipelineT>> promise;
+    {
+      std::lock_guard l(state_->mut);
+      Entry& entry = state_->entries[key];
+      if (entry.promise != nullptr) {
+        state_->stats.cacheHitCount++;
+        return entry.promise;
+      }
+
+      promise = core::Promise<PipelineT>::create();
+      entry.promise = promise;
+
+      if (entry.pipeline.has_value()) {
+        state_->stats.cacheHitCount++;
+        promise->resolve(entry.pipeline.get());
+        return promise;
+      }
+
+      state_->stats.asyncCreateCount++;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    start_fn(ResolveFn([state = state_, key,
+                        promise](core::Maybe<PipelineT> pipeline) {
+      if (pipeline.is_empty()) {
+        {
+          std::lock_guard l(state->mut);
+          auto it = state->entries.find(key);
+          if (it != state->entries.end() && it->second.promise == promise &&
+              it->second.pipeline.is_empty()) {
+            state->entries.erase(it);
+          }
+        }
+        promise->resolve(PipelineT{});
+        return;
+      }
+
+      {
+        std::lock_guard l(state->mut);
+        Entry& entry = state->entries[key];
+        if (!entry.pipeline.has_value()) {
+          entry.pipeline = PipelineT(pipeline.get());
+        }
+      }
+      promise->resolve(pipeline.move());
+    }));
+    double elapsed_ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::high_resolution_clock::now() - start)
+                            .count();
+
+    std::lock_guard l(state_->mut);
+    state_->stats.blockingMs += elapsed_ms;
+    return promise;
+  }
+
+  core::Maybe<PipelineT> get_if_ready(uint64_t key) const {
+    std::lock_guard l(state_->mut);
+    auto it = state_->entries.find(key);
+    if (it == state_->entries.end() || it->second.pipeline.is_empty()) {
+      return core::empty_maybe{};
+    }
+    return it->second.pipeline;
+  }
+
+  /** Built, or being built asynchronously */
+  bool contains(uint64_t key) const {
+    std::lock_guard l(state_->mut);
+    return state_->entries.count(key) > 0;
+  }
+
+  uint32_t size() const {
+    std::lock_guard l(state_->mut);
+    return static_cast<uint32_t>(state_->entries.size());
+  }
+
+  Stats stats() const {
+    std::lock_guard l(state_->mut);
+    return state_->stats;
+  }
+
+ private:
+  struct Entry {
+    core::Maybe<PipelineT> pipeline;
+    std::shared_ptr<core::Promise<PipelineT>> promise;
+  };
+
+  // Shared with in-flight async builds, which may outlive the cache
+  struct State {
+    mutable std::mutex mut;
+    std::unordered_map<uint64_t, Entry> entries;
+    Stats stats{};
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace indigo::iggpu
+
+#endif
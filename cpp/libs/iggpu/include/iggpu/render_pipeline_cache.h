@@ -0,0 +1,73 @@
+#ifndef LIBS_IGGPU_INCLUDE_IGGPU_RENDER_PIPELINE_CACHE_H
+#define LIBS_IGGPU_INCLUDE_IGGPU_RENDER_PIPELINE_CACHE_H
+
+#include <iggpu/pipeline_cache.h>
+#include <webgpu/webgpu_cpp.h>
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace indigo::iggpu {
+
+/**
+ * WebGPU render pipelines, shared across scenes (see PipelineCache).
+ *
+ * Async creation goes through Device::CreateRenderPipelineAsync - so the
+ *  shader compile happens off of the frame. Native Dawn only delivers the
+ *  result on Device::Tick, which the app should call once per frame.
+ *
+ * A failed async build is logged and resolves to a null pipeline, but is not
+ *  cached - the next request for the same key builds it again.
+ */
+class RenderPipelineCache {
+ public:
+  typedef PipelineCache<wgpu::RenderPipeline>::Stats Stats;
+
+  // Async build handle - poll "key" with get_if_ready, or wait on "promise"
+  struct Pending {
+    uint64_t key;
+    std::shared_ptr<core::Promise<wgpu::RenderPipeline>> promise;
+  };
+
+  // Stable hash of WGSL source, see key_of
+  static uint64_t hash_source(const std::string& wgsl_src);
+
+  /**
+   * Hash of everything in "desc" that makes two pipelines different - shader
+   *  modules are opaque, so the caller passes hashes of the WGSL sources they
+   *  were built from instead (hash_source).
+   *
+   * Explicit pipeline layouts are opaque too - callers that set "desc.layout"
+   *  must pass an id that is the same for every equivalent layout (e.g. a hash
+   *  of its bind group layout entries). Leave it 0 for the automatic layout.
+   */
+  static uint64_t key_of(const wgpu::RenderPipelineDescriptor& desc,
+                         uint64_t vs_src_hash, uint64_t fs_src_hash,
+                         uint64_t layout_id = 0u);
+
+  // "desc" only needs to live for the duration of the call
+  wgpu::RenderPipeline get_or_create(const wgpu::Device& device,
+                                     const wgpu::RenderPipelineDescriptor& desc,
+                                     uint64_t key);
+  Pending get_or_create_async(const wgpu::Device& device,
+                              const wgpu::RenderPipelineDescriptor& desc,
+                              uint64_t key);
+
+  core::Maybe<wgpu::RenderPipeline> get_if_ready(uint64_t key) const {
+    return cache_.get_if_ready(key);
+  }
+
+  uint32_t size() const { return cache_.size(); }
+  Stats stats() const { return cache_.stats(); }
+
+ private:
+  PipelineCache<wgpu::RenderPipeline> cache_;
+};
+
+std::ostream& operator<<(std::ostream& o,
+                         const RenderPipelineCache::Stats& stats);
+
+}  // namespace indigo::iggpu
+
+#endif
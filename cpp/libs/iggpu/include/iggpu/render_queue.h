@@ -0,0 +1,140 @@
+#ifndef LIBS_IGGPU_INCLUDE_IGGPU_RENDER_QUEUE_H
+#define LIBS_IGGPU_INCLUDE_IGGPU_RENDER_QUEUE_H
+
+#include <igcore/pod_vector.h>
+
+#include <cstdint>
+
+namespace indigo::iggpu {
+
+/**
+ * 64 bit draw sort key, from most to least significant:
+ *  pipeline (8 bits) | material (24 bits) | geometry (32 bits)
+ *
+ * Sorting by key puts every draw of a pipeline together, then every draw of
+ *  a material within that, then every draw of a geometry - so binds change
+ *  as rarely as possible, and equal keys can be drawn as one instanced call.
+ *
+ * Materials and geometry should be small, dense ids (ReadonlyResourceRegistry
+ *  <>::Key::get_raw_index() works well) - material ids are truncated to 24
+ *  bits, and pipeline ids to 8.
+ */
+struct RenderSortKey {
+  static constexpr uint32_t kGeometryBits = 32u;
+  static constexpr uint32_t kMaterialBits = 24u;
+  static constexpr uint32_t kPipelineBits = 8u;
+
+  static constexpr uint64_t kGeometryMask = 0x00000000FFFFFFFFull;
+  static constexpr uint64_t kMaterialMask = 0x00FFFFFF00000000ull;
+  static constexpr uint64_t kPipelineMask = 0xFF00000000000000ull;
+
+  static uint64_t make(uint32_t pipeline, uint32_t material,
+                       uint32_t geometry) {
+    return (static_cast<uint64_t>(pipeline & 0xFFu) << 56u) |
+           (static_cast<uint64_t>(material & 0xFFFFFFu) << 32u) |
+           static_cast<uint64_t>(geometry);
+  }
+
+  static uint32_t pipeline(uint64_t key) {
+    return static_cast<uint32_t>(key >> 56u);
+  }
+  static uint32_t material(uint64_t key) {
+    return static_cast<uint32_t>((key & kMaterialMask) >> 32u);
+  }
+  static uint32_t geometry(uint64_t key) {
+    return static_cast<uint32_t>(key & kGeometryMask);
+  }
+};
+
+/**
+ * CPU side draw ordering - collects one sort key per draw item, radix sorts
+ *  them, and merges runs of equal keys into batches that can each be issued
+ *  as a single instanced draw. No GPU types in here, so ordering and merging
+ *  can be tested and benchmarked on their own.
+ *
+ * Start a frame with "begin_frame", "add" a key for every item (the returned
+ *  index is the item's position in the caller's own per-item data), then
+ *  "sort". After that, "sorted_item" maps sorted positions back to item
+ *  indices, and "for_each_batch" walks the merged batches in draw order.
+ *
+ * Sorting is stable - items with equal keys keep the order they were added
+ *  in. Memory is kept between frames, so a warmed up queue does not allocate.
+ */
+class RenderQueue {
+ public:
+  struct Batch {
+    uint64_t sortKey;
+
+    // Range of sorted positions (see sorted_item) drawn by this batch
+    uint32_t firstItem;
+    uint32_t numItems;
+
+    // Which parts of the key differ from the previous batch - callers should
+    //  only re-bind the parts that changed. A pipeline change flags everything
+    //  (as does the first batch), a material change leaves geometry alone.
+    bool pipelineChanged;
+    bool materialChanged;
+    bool geometryChanged;
+  };
+
+  RenderQueue(uint32_t size_hint = 64u);
+
+  void begin_frame();
+  uint32_t add(uint64_t sort_key);
+  void sort();
+
+  uint32_t size() const { return static_cast<uint32_t>(entries_.size()); }
+
+  // Item index (as returned by "add") at a sorted position (valid after sort)
+  uint32_t sorted_item(uint32_t sorted_idx) const {
+    return entries_[sorted_idx].itemIdx;
+  }
+  uint64_t sorted_key(uint32_t sorted_idx) const {
+    return entries_[sorted_idx].sortKey;
+  }
+
+  /** Invoke "cb(const Batch&)" for every batch, in draw order (after sort) */
+  template <typename CbT>
+  void for_each_batch(CbT&& cb) const {
+    const uint32_t count = size();
+    uint32_t batch_start = 0u;
+    uint64_t last_key = 0u;
+    for (uint32_t i = 1u; i <= count; i++) {
+      if (i < count && entries_[i].sortKey == entries_[batch_start].sortKey) {
+        continue;
+      }
+
+      const uint64_t key = entries_[batch_start].sortKey;
+      const bool is_first = batch_start == 0u;
+      const uint64_t changed = key ^ last_key;
+
+      Batch batch{};
+      batch.sortKey = key;
+      batch.firstItem = batch_start;
+      batch.numItems = i - batch_start;
+      batch.pipelineChanged =
+          is_first || (changed & RenderSortKey::kPipelineMask) != 0u;
+      batch.materialChanged = batch.pipelineChanged ||
+                              (changed & RenderSortKey::kMaterialMask) != 0u;
+      batch.geometryChanged = batch.pipelineChanged ||
+                              (changed & RenderSortKey::kGeometryMask) != 0u;
+      cb(batch);
+
+      last_key = key;
+      batch_start = i;
+    }
+  }
+
+ private:
+  struct Entry {
+    uint64_t sortKey;
+    uint32_t itemIdx;
+  };
+
+  core::PodVector<Entry> entries_;
+  core::PodVector<Entry> scratch_;
+};
+
+}  // namespace indigo::iggpu
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef LIBS_IGGPU_INCLUDE_IGGPU_UNIFORM_ARENA_H
+#define LIBS_IGGPU_INCLUDE_IGGPU_UNIFORM_ARENA_H
+
+#include <igcore/pod_vector.h>
+
+#include <cstdint>
+#include <functional>
+
+namespace indigo::iggpu {
+
+/**
+ * CPU side staging for many small uniform blocks that live in one GPU buffer.
+ *
+ * Every uniform block gets an "allocate"d slot, aligned so its offset can be
+ *  used directly as a bind group (or dynamic) offset. Systems write through
+ *  "get_mutable" / "write", which marks the slot dirty (like core::Dirtyable),
+ *  and "flush" hands the smallest range covering every dirty slot to a single
+ *  write callback - so however many uniforms changed, the frame costs at most
+ *  one queue write.
+ *
+ * Capacity is fixed up front - bind groups hold on to the GPU buffer, so it
+ *  can never be re-created under them. No GPU types in here, so staging and
+ *  flushing can be tested on their own (see UniformStagingBuffer).
+ */
+class UniformArena {
+ public:
+  // WebGPU minUniformBufferOffsetAlignment default limit
+  static constexpr uint32_t kDefaultAlignment = 256u;
+
+  struct Allocation {
+    uint32_t offset;
+    uint32_t size;
+
+    bool is_valid() const { return size > 0u; }
+  };
+
+  struct FlushStats {
+    uint32_t queueWrites;
+    uint32_t bytesWritten;
+  };
+
+  typedef std::function<void(uint32_t offset, const uint8_t* data,
+                             uint32_t size)>
+      WriteFn;
+
+  UniformArena(uint32_t capacity, uint32_t alignment = kDefaultAlignment);
+
+  // Zero initialized, and dirty until the next flush. Returns an invalid
+  //  allocation if the arena is full.
+  Allocation allocate(uint32_t size);
+
+  template <typename T>
+  Allocation allocate() {
+    return allocate(sizeof(T));
+  }
+
+  template <typename T>
+  T& get_mutable(const Allocation& allocation) {
+    mark_dirty(allocation);
+    return *reinterpret_cast<T*>(&data_[allocation.offset]);
+  }
+
+  template <typename T>
+  const T& get_immutable(const Allocation& allocation) const {
+    return *reinterpret_cast<const T*>(&data_[allocation.offset]);
+  }
+
+  void write(const Allocation& allocation, const void* data, uint32_t size);
+  void mark_dirty(const Allocation& allocation);
+
+  bool is_dirty() const { return dirty_begin_ < dirty_end_; }
+
+  // Invokes "write_fn" at most once, then cleans every slot
+  FlushStats flush(const WriteFn& write_fn);
+
+  // Stats of the most recent flush - one queue write at most per frame
+  const FlushStats& last_flush_stats() const { return last_flush_stats_; }
+
+  uint32_t capacity() const { return capacity_; }
+  uint32_t alignment() const { return alignment_; }
+
+  // Bytes handed out so far (including alignment padding)
+  uint32_t size() const { return next_offset_; }
+
+ private:
+  uint32_t capacity_;
+  uint32_t alignment_;
+  uint32_t next_offset_;
+  uint32_t dirty_begin_;
+  uint32_t dirty_end_;
+  FlushStats last_flush_stats_;
+
+  core::PodVector<uint8_t> data_;
+};
+
+}  // namespace indigo::iggpu
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef LIBS_IGGPU_INCLUDE_IGGPU_UNIFORM_STAGING_BUFFER_H
+#define LIBS_IGGPU_INCLUDE_IGGPU_UNIFORM_STAGING_BUFFER_H
+
+#include <iggpu/uniform_arena.h>
+#include <iggpu/util.h>
+#include <webgpu/webgpu_cpp.h>
+
+#include <memory>
+
+namespace indigo::iggpu {
+
+/**
+ * One uniform GPU buffer shared by many uniform blocks (see UniformArena).
+ *
+ * Allocate every block up front with "StagedUbo", write to them as needed
+ *  during the frame, and "flush" once per frame before rendering - dirty
+ *  blocks go up in a single queue write.
+ */
+class UniformStagingBuffer {
+ public:
+  UniformStagingBuffer(const wgpu::Device& device, uint32_t capacity)
+      : arena_(capacity),
+        buffer_(create_empty_buffer(device, arena_.capacity(),
+                                    wgpu::BufferUsage::Uniform)) {}
+  UniformStagingBuffer(const UniformStagingBuffer&) = delete;
+  UniformStagingBuffer& operator=(const UniformStagingBuffer&) = delete;
+
+  UniformArena& arena() { return arena_; }
+  const UniformArena& arena() const { return arena_; }
+  const wgpu::Buffer& buffer() const { return buffer_; }
+
+  UniformArena::FlushStats flush(const wgpu::Device& device) {
+    return arena_.flush(
+        [this, &device](uint32_t offset, const uint8_t* data, uint32_t size) {
+          device.GetQueue().WriteBuffer(buffer_, offset, data, size);
+        });
+  }
+
+ private:
+  UniformArena arena_;
+  wgpu::Buffer buffer_;
+};
+
+/**
+ * Typed uniform block inside a UniformStagingBuffer - same accessors as
+ *  UboBase, but bind it with "offset" and flush the staging buffer instead of
+ *  syncing each block.
+ */
+template <typename T>
+class StagedUbo {
+ public:
+  StagedUbo() : staging_(nullptr), allocation_{0u, 0u} {}
+  StagedUbo(std::shared_ptr<UniformStagingBuffer> staging)
+      : staging_(staging),
+        allocation_(staging->arena().template allocate<T>()) {}
+
+  T& get_mutable() {
+    return staging_->arena().template get_mutable<T>(allocation_);
+  }
+  const T& get_immutable() const {
+    return staging_->arena().template get_immutable<T>(allocation_);
+  }
+
+  uint32_t size() const { return sizeof(T); }
+  uint32_t offset() const { return allocation_.offset; }
+  bool is_valid() const {
+    return staging_ != nullptr && allocation_.is_valid();
+  }
+
+  const wgpu::Buffer& buffer() const { return staging_->buffer(); }
+
+ private:
+  std::shared_ptr<UniformStagingBuffer> staging_;
+  UniformArena::Allocation allocation_;
+};
+
+}  // namespace indigo::iggpu
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef LIB_IGGPU_UTIL_H
 #define LIB_IGGPU_UTIL_H
 
+#include <igasset/compressed_texture.h>
 #include <igasync/promise.h>
 #include <igcore/either.h>
 #include <igcore/pod_vector.h>
@@ -85,6 +86,17 @@ Texture create_empty_texture_2d(const wgpu::Device& device, uint32_t width,
                                 wgpu::TextureFormat format,
                                 wgpu::TextureUsage usage);
 
+/**
+ * Create a texture with every mip level of "texture" uploaded. BC1/BC3 block
+ *  data is uploaded as-is - if the device was not created with the BC texture
+ *  compression feature ("bc_supported" false), mips are transcoded to RGBA8
+ *  on the CPU first.
+ */
+Texture create_texture_2d_from_compressed(
+    const wgpu::Device& device, const asset::CompressedTexture& texture,
+    bool bc_supported,
+    wgpu::TextureUsage usage = wgpu::TextureUsage::TextureBinding);
+
 wgpu::TextureViewDescriptor view_desc_of(const iggpu::Texture& texture);
 
 wgpu::VertexAttribute vertex_attribute(uint32_t shader_location,
@@ -1,4 +1,5 @@
 #include <iggpu/pipeline_builder.h>
+#include <iggpu/render_pipeline_cache.h>
 #include <iggpu/util.h>
 
 using namespace indigo;
@@ -7,7 +8,11 @@ using namespace iggpu;
 PipelineBuilder PipelineBuilder::Create(
     const wgpu::Device& device, const indigo::asset::pb::WgslSource& vs_src,
     const indigo::asset::pb::WgslSource& fs_src) {
-  return PipelineBuilder{create_shader_module(device, vs_src.shader_source()),
-                         create_shader_module(device, fs_src.shader_source()),
-                         vs_src.entry_point(), fs_src.entry_point()};
+  return PipelineBuilder{
+      create_shader_module(device, vs_src.shader_source()),
+      create_shader_module(device, fs_src.shader_source()),
+      vs_src.entry_point(),
+      fs_src.entry_point(),
+      RenderPipelineCache::hash_source(vs_src.shader_source()),
+      RenderPipelineCache::hash_source(fs_src.shader_source())};
 }
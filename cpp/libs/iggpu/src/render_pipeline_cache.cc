@@ -0,0 +1,198 @@
+#include <igcore/log.h>
+#include <iggpu/render_pipeline_cache.h>
+
+#include <cstring>
+#include <type_traits>
+
+using namespace indigo;
+using namespace iggpu;
+
+namespace {
+const char* kLogLabel = "RenderPipelineCache";
+
+// 64-bit FNV-1a - stable across runs, so keys can be logged and compared
+const uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ull;
+const uint64_t kFnvPrime = 0x100000001b3ull;
+
+uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+template <typename T>
+uint64_t hash_value(uint64_t hash, const T& value) {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Only hash plain values (enums, integers, flags)");
+  return ::hash_bytes(hash, &value, sizeof(T));
+}
+
+uint64_t hash_string(uint64_t hash, const char* str) {
+  if (str == nullptr) {
+    return ::hash_value(hash, 0u);
+  }
+  size_t len = strlen(str);
+  hash = ::hash_value(hash, len);
+  return ::hash_bytes(hash, str, len);
+}
+
+uint64_t hash_stencil_face(uint64_t hash, const wgpu::StencilFaceState& face) {
+  hash = ::hash_value(hash, face.compare);
+  hash = ::hash_value(hash, face.failOp);
+  hash = ::hash_value(hash, face.depthFailOp);
+  return ::hash_value(hash, face.passOp);
+}
+
+uint64_t hash_constants(uint64_t hash, const wgpu::ConstantEntry* constants,
+                        size_t count) {
+  hash = ::hash_value(hash, count);
+  for (size_t i = 0; i < count; i++) {
+    hash = ::hash_string(hash, constants[i].key);
+    hash = ::hash_value(hash, constants[i].value);
+  }
+  return hash;
+}
+
+uint64_t hash_blend_component(uint64_t hash,
+                              const wgpu::BlendComponent& component) {
+  hash = ::hash_value(hash, component.operation);
+  hash = ::hash_value(hash, component.srcFactor);
+  return ::hash_value(hash, component.dstFactor);
+}
+
+struct AsyncCreateRequest {
+  PipelineCache<wgpu::RenderPipeline>::ResolveFn resolve;
+  std::string label;
+};
+
+void on_pipeline_created(WGPUCreatePipelineAsyncStatus status,
+                         WGPURenderPipeline pipeline, const char* message,
+                         void* userdata) {
+  std::unique_ptr<AsyncCreateRequest> request(
+      static_cast<AsyncCreateRequest*>(userdata));
+
+  if (status != WGPUCreatePipelineAsyncStatus_Success || pipeline == nullptr) {
+    core::Logger::err(kLogLabel)
+        << "Failed to create pipeline " << request->label << ": "
+        << (message ? message : "(no message)");
+    request->resolve(core::empty_maybe{});
+    return;
+  }
+
+  request->resolve(wgpu::RenderPipeline::Acquire(pipeline));
+}
+
+}  // namespace
+
+uint64_t RenderPipelineCache::hash_source(const std::string& wgsl_src) {
+  uint64_t hash = ::hash_value(kFnvOffsetBasis, wgsl_src.size());
+  return ::hash_bytes(hash, wgsl_src.data(), wgsl_src.size());
+}
+
+uint64_t RenderPipelineCache::key_of(const wgpu::RenderPipelineDescriptor& desc,
+                                     uint64_t vs_src_hash, uint64_t fs_src_hash,
+                                     uint64_t layout_id) {
+  uint64_t hash = kFnvOffsetBasis;
+
+  // Explicit layouts are opaque (and their addresses are reused once freed) -
+  //  the caller identifies them by "layout_id" instead
+  hash = ::hash_value(hash, static_cast<bool>(desc.layout));
+  hash = ::hash_value(hash, layout_id);
+
+  // Vertex stage
+  hash = ::hash_value(hash, vs_src_hash);
+  hash = ::hash_string(hash, desc.vertex.entryPoint);
+  hash = ::hash_constants(hash, desc.vertex.constants,
+                          desc.vertex.constantCount);
+  hash = ::hash_value(hash, desc.vertex.bufferCount);
+  for (uint32_t i = 0; i < desc.vertex.bufferCount; i++) {
+    const wgpu::VertexBufferLayout& buffer = desc.vertex.buffers[i];
+    hash = ::hash_value(hash, buffer.arrayStride);
+    hash = ::hash_value(hash, buffer.stepMode);
+    hash = ::hash_value(hash, buffer.attributeCount);
+    for (uint32_t a = 0; a < buffer.attributeCount; a++) {
+      hash = ::hash_value(hash, buffer.attributes[a].format);
+      hash = ::hash_value(hash, buffer.attributes[a].offset);
+      hash = ::hash_value(hash, buffer.attributes[a].shaderLocation);
+    }
+  }
+
+  // Fixed function state
+  hash = ::hash_value(hash, desc.primitive.topology);
+  hash = ::hash_value(hash, desc.primitive.stripIndexFormat);
+  hash = ::hash_value(hash, desc.primitive.frontFace);
+  hash = ::hash_value(hash, desc.primitive.cullMode);
+
+  hash = ::hash_value(hash, desc.depthStencil != nullptr);
+  if (desc.depthStencil) {
+    const wgpu::DepthStencilState& ds = *desc.depthStencil;
+    hash = ::hash_value(hash, ds.format);
+    hash = ::hash_value(hash, ds.depthWriteEnabled);
+    hash = ::hash_value(hash, ds.depthCompare);
+    hash = ::hash_stencil_face(hash, ds.stencilFront);
+    hash = ::hash_stencil_face(hash, ds.stencilBack);
+    hash = ::hash_value(hash, ds.stencilReadMask);
+    hash = ::hash_value(hash, ds.stencilWriteMask);
+    hash = ::hash_value(hash, ds.depthBias);
+    hash = ::hash_value(hash, ds.depthBiasSlopeScale);
+    hash = ::hash_value(hash, ds.depthBiasClamp);
+  }
+
+  hash = ::hash_value(hash, desc.multisample.count);
+  hash = ::hash_value(hash, desc.multisample.mask);
+  hash = ::hash_value(hash, desc.multisample.alphaToCoverageEnabled);
+
+  // Fragment stage and targets
+  hash = ::hash_value(hash, desc.fragment != nullptr);
+  if (desc.fragment) {
+    const wgpu::FragmentState& fs = *desc.fragment;
+    hash = ::hash_value(hash, fs_src_hash);
+    hash = ::hash_string(hash, fs.entryPoint);
+    hash = ::hash_constants(hash, fs.constants, fs.constantCount);
+    hash = ::hash_value(hash, fs.targetCount);
+    for (uint32_t i = 0; i < fs.targetCount; i++) {
+      const wgpu::ColorTargetState& target = fs.targets[i];
+      hash = ::hash_value(hash, target.format);
+      hash = ::hash_value(hash, target.writeMask);
+      hash = ::hash_value(hash, target.blend != nullptr);
+      if (target.blend) {
+        hash = ::hash_blend_component(hash, target.blend->color);
+        hash = ::hash_blend_component(hash, target.blend->alpha);
+      }
+    }
+  }
+
+  return hash;
+}
+
+wgpu::RenderPipeline RenderPipelineCache::get_or_create(
+    const wgpu::Device& device, const wgpu::RenderPipelineDescriptor& desc,
+    uint64_t key) {
+  return cache_.get_or_create(
+      key, [&device, &desc]() { return device.CreateRenderPipeline(&desc); });
+}
+
+RenderPipelineCache::Pending RenderPipelineCache::get_or_create_async(
+    const wgpu::Device& device, const wgpu::RenderPipelineDescriptor& desc,
+    uint64_t key) {
+  auto promise = cache_.get_or_create_async(
+      key, [&device, &desc](
+               PipelineCache<wgpu::RenderPipeline>::ResolveFn resolve) {
+        auto* request = new AsyncCreateRequest{
+            std::move(resolve), desc.label ? desc.label : "(unlabeled)"};
+        device.CreateRenderPipelineAsync(&desc, ::on_pipeline_created,
+                                         request);
+      });
+  return Pending{key, std::move(promise)};
+}
+
+std::ostream& iggpu::operator<<(std::ostream& o,
+                                const RenderPipelineCache::Stats& stats) {
+  return o << stats.syncCreateCount << " created blocking, "
+           << stats.asyncCreateCount << " created async, "
+           << stats.cacheHitCount << " cache hits, " << stats.blockingMs
+           << "ms blocking the calling thread";
+}
@@ -0,0 +1,77 @@
+#include <iggpu/render_queue.h>
+
+#include <cstring>
+
+using namespace indigo;
+using namespace iggpu;
+
+namespace {
+constexpr uint32_t kRadixBits = 8u;
+constexpr uint32_t kRadixBuckets = 1u << kRadixBits;
+constexpr uint32_t kRadixPasses = 64u / kRadixBits;
+}  // namespace
+
+RenderQueue::RenderQueue(uint32_t size_hint)
+    : entries_(size_hint), scratch_(size_hint) {}
+
+void RenderQueue::begin_frame() { entries_.resize(0); }
+
+uint32_t RenderQueue::add(uint64_t sort_key) {
+  const uint32_t item_idx = static_cast<uint32_t>(entries_.size());
+  entries_.push_back(Entry{sort_key, item_idx});
+  return item_idx;
+}
+
+void RenderQueue::sort() {
+  const uint32_t count = size();
+  if (count < 2u) {
+    return;
+  }
+
+  // LSD radix sort, one byte per pass - every histogram is built in a single
+  //  read of the keys up front
+  uint32_t histograms[kRadixPasses][kRadixBuckets];
+  std::memset(histograms, 0, sizeof(histograms));
+  for (uint32_t i = 0u; i < count; i++) {
+    const uint64_t key = entries_[i].sortKey;
+    for (uint32_t pass = 0u; pass < kRadixPasses; pass++) {
+      histograms[pass][(key >> (pass * kRadixBits)) & (kRadixBuckets - 1u)]++;
+    }
+  }
+
+  scratch_.resize(count);
+  Entry* src = entries_.raw();
+  Entry* dst = scratch_.raw();
+
+  for (uint32_t pass = 0u; pass < kRadixPasses; pass++) {
+    uint32_t* histogram = histograms[pass];
+    const uint32_t shift = pass * kRadixBits;
+
+    // Every key has the same byte here (usually the case for pipeline and
+    //  high material / geometry bits) - the pass would not move anything
+    if (histogram[(src[0].sortKey >> shift) & (kRadixBuckets - 1u)] == count) {
+      continue;
+    }
+
+    uint32_t offset = 0u;
+    for (uint32_t bucket = 0u; bucket < kRadixBuckets; bucket++) {
+      const uint32_t bucket_count = histogram[bucket];
+      histogram[bucket] = offset;
+      offset += bucket_count;
+    }
+
+    for (uint32_t i = 0u; i < count; i++) {
+      const uint32_t bucket = (src[i].sortKey >> shift) & (kRadixBuckets - 1u);
+      dst[histogram[bucket]++] = src[i];
+    }
+
+    Entry* tmp = src;
+    src = dst;
+    dst = tmp;
+  }
+
+  // Odd number of passes actually ran - results live in the scratch buffer
+  if (src != entries_.raw()) {
+    std::memcpy(entries_.raw(), src, count * sizeof(Entry));
+  }
+}
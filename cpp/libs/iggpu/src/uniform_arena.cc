@@ -0,0 +1,84 @@
+#include <igcore/log.h>
+#include <iggpu/uniform_arena.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace indigo;
+using namespace iggpu;
+
+namespace {
+uint32_t align_up(uint32_t value, uint32_t alignment) {
+  return (value + alignment - 1u) / alignment * alignment;
+}
+
+// WebGPU queue writes must have 4 byte aligned offsets and sizes
+const uint32_t kWriteAlignment = 4u;
+}  // namespace
+
+UniformArena::UniformArena(uint32_t capacity, uint32_t alignment)
+    : capacity_(::align_up(capacity, ::kWriteAlignment)),
+      alignment_(alignment),
+      next_offset_(0u),
+      dirty_begin_(0xFFFFFFFFu),
+      dirty_end_(0u),
+      last_flush_stats_{0u, 0u},
+      data_(capacity_) {
+  data_.resize(capacity_);
+  std::memset(&data_[0], 0x00, capacity_);
+}
+
+UniformArena::Allocation UniformArena::allocate(uint32_t size) {
+  const uint32_t offset = ::align_up(next_offset_, alignment_);
+  if (size == 0u || offset + size > capacity_) {
+    core::Logger::err("UniformArena")
+        << "Cannot allocate " << size << " bytes - " << next_offset_ << "/"
+        << capacity_ << " bytes already in use";
+    return Allocation{0u, 0u};
+  }
+
+  next_offset_ = offset + size;
+
+  Allocation allocation{offset, size};
+  mark_dirty(allocation);
+  return allocation;
+}
+
+void UniformArena::write(const Allocation& allocation, const void* data,
+                         uint32_t size) {
+  if (size > allocation.size) {
+    core::Logger::err("UniformArena")
+        << "Cannot write " << size << " bytes into a " << allocation.size
+        << " byte allocation";
+    return;
+  }
+
+  std::memcpy(&data_[allocation.offset], data, size);
+  mark_dirty(allocation);
+}
+
+void UniformArena::mark_dirty(const Allocation& allocation) {
+  if (!allocation.is_valid()) {
+    return;
+  }
+
+  dirty_begin_ = std::min(dirty_begin_, allocation.offset);
+  dirty_end_ = std::min(
+      capacity_, std::max(dirty_end_, ::align_up(allocation.offset +
+                                                     allocation.size,
+                                                 ::kWriteAlignment)));
+}
+
+UniformArena::FlushStats UniformArena::flush(const WriteFn& write_fn) {
+  last_flush_stats_ = FlushStats{0u, 0u};
+
+  if (is_dirty()) {
+    const uint32_t size = dirty_end_ - dirty_begin_;
+    write_fn(dirty_begin_, &data_[dirty_begin_], size);
+    last_flush_stats_ = FlushStats{1u, size};
+  }
+
+  dirty_begin_ = 0xFFFFFFFFu;
+  dirty_end_ = 0u;
+  return last_flush_stats_;
+}
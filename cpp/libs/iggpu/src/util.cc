@@ -5,6 +5,8 @@ using namespace indigo;
 using namespace iggpu;
 
 namespace {
+const char* kLogLabel = "iggpu";
+
 #ifndef __EMSCRIPTEN__
 class ShaderModuleChecker {
  public:
@@ -177,6 +179,70 @@ Texture iggpu::create_empty_texture_2d(const wgpu::Device& device,
   return tex;
 }
 
+Texture iggpu::create_texture_2d_from_compressed(
+    const wgpu::Device& device, const asset::CompressedTexture& texture,
+    bool bc_supported, wgpu::TextureUsage usage) {
+  wgpu::TextureFormat format;
+  if (!bc_supported) {
+    format = texture.is_srgb() ? wgpu::TextureFormat::RGBA8UnormSrgb
+                               : wgpu::TextureFormat::RGBA8Unorm;
+  } else if (texture.format() == asset::BlockFormat::BC1_RGB) {
+    format = texture.is_srgb() ? wgpu::TextureFormat::BC1RGBAUnormSrgb
+                               : wgpu::TextureFormat::BC1RGBAUnorm;
+  } else {
+    format = texture.is_srgb() ? wgpu::TextureFormat::BC3RGBAUnormSrgb
+                               : wgpu::TextureFormat::BC3RGBAUnorm;
+  }
+
+  Texture tex = create_empty_texture_2d(
+      device, texture.width(), texture.height(), texture.mip_count(), format,
+      usage | wgpu::TextureUsage::CopyDst);
+
+  wgpu::Queue queue = device.GetQueue();
+  for (uint32_t mip_level = 0; mip_level < texture.mip_count(); mip_level++) {
+    wgpu::ImageCopyTexture dest{};
+    dest.texture = tex.GpuTexture;
+    dest.mipLevel = mip_level;
+    dest.aspect = wgpu::TextureAspect::All;
+
+    if (!bc_supported) {
+      auto rgba_rsl = texture.transcode_to_rgba(mip_level);
+      if (rgba_rsl.is_right()) {
+        core::Logger::err(kLogLabel)
+            << "Failed to transcode mip " << mip_level << " - "
+            << asset::to_string(rgba_rsl.get_right());
+        continue;
+      }
+
+      const asset::RgbaImage& image = rgba_rsl.get_left();
+      wgpu::TextureDataLayout layout{};
+      layout.offset = 0u;
+      layout.bytesPerRow = image.Width * sizeof(asset::RgbaPixel);
+      layout.rowsPerImage = image.Height;
+
+      wgpu::Extent3D size{image.Width, image.Height, 1u};
+      queue.WriteTexture(&dest, image.Pixels.raw(), image.Pixels.raw_size(),
+                         &layout, &size);
+      continue;
+    }
+
+    // Copies of block-compressed mips cover whole blocks, even where the mip
+    //  itself is smaller than a block
+    asset::CompressedMip mip = texture.mip(mip_level);
+    wgpu::TextureDataLayout layout{};
+    layout.offset = 0u;
+    layout.bytesPerRow = mip.BytesPerRow;
+    layout.rowsPerImage = mip.BlocksHigh;
+
+    wgpu::Extent3D size{mip.BlocksWide * asset::BlockCompression::kBlockDim,
+                        mip.BlocksHigh * asset::BlockCompression::kBlockDim,
+                        1u};
+    queue.WriteTexture(&dest, mip.Data, mip.Size, &layout, &size);
+  }
+
+  return tex;
+}
+
 wgpu::TextureViewDescriptor iggpu::view_desc_of(const iggpu::Texture& texture) {
   wgpu::TextureViewDescriptor vd{};
   vd.arrayLayerCount = 1;
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <iggpu/instance_batcher.h>
+
+#include <map>
+
+using namespace indigo;
+using namespace iggpu;
+
+struct TestKey {
+  uint32_t Slot;
+  uint32_t Generation;
+  int Lifetime;
+
+  uint32_t get_slot() const { return Slot; }
+  uint32_t get_generation() const { return Generation; }
+  int get_lifetime() const { return Lifetime; }
+};
+
+struct TestInstance {
+  uint32_t KeySlot;
+  uint32_t Value;
+};
+
+typedef InstanceBatcher<TestKey, TestInstance> TestBatcher;
+
+struct BatchRecord {
+  uint32_t Generation;
+  uint32_t FirstInstance;
+  uint32_t NumInstances;
+};
+
+std::map<uint32_t, BatchRecord> get_batches(const TestBatcher& batcher) {
+  std::map<uint32_t, BatchRecord> batches;
+  batcher.for_each_batch([&batches](const TestKey& key, uint32_t first,
+                                    uint32_t count) {
+    batches[key.Slot] = BatchRecord{key.Generation, first, count};
+  });
+  return batches;
+}
+
+TEST(InstanceBatcher, PacksInstancesByKey) {
+  TestBatcher batcher;
+
+  batcher.begin_frame();
+  batcher.add_instance(TestKey{0, 1, 5}, TestInstance{0, 10});
+  batcher.add_instance(TestKey{3, 2, 5}, TestInstance{3, 20});
+  batcher.add_instance(TestKey{0, 1, 5}, TestInstance{0, 11});
+  batcher.add_instance(TestKey{3, 2, 5}, TestInstance{3, 21});
+  batcher.add_instance(TestKey{0, 1, 5}, TestInstance{0, 12});
+  batcher.pack();
+
+  const auto& packed = batcher.packed_instances();
+  ASSERT_EQ(packed.size(), 5);
+  EXPECT_EQ(batcher.key_count(), 2u);
+
+  auto batches = get_batches(batcher);
+  ASSERT_EQ(batches.size(), 2u);
+  EXPECT_EQ(batches[0].NumInstances, 3u);
+  EXPECT_EQ(batches[3].NumInstances, 2u);
+
+  // Each key's range holds exactly its own instances, in insertion order
+  for (const auto& [slot, batch] : batches) {
+    for (uint32_t i = 0; i < batch.NumInstances; i++) {
+      const TestInstance& instance = packed[batch.FirstInstance + i];
+      EXPECT_EQ(instance.KeySlot, slot);
+      EXPECT_EQ(instance.Value, (slot == 0u ? 10u : 20u) + i);
+    }
+  }
+}
+
+TEST(InstanceBatcher, SkipsKeysWithoutInstancesThisFrame) {
+  TestBatcher batcher;
+
+  batcher.begin_frame();
+  batcher.add_instance(TestKey{0, 1, 5}, TestInstance{0, 1});
+  batcher.add_instance(TestKey{1, 2, 5}, TestInstance{1, 1});
+  batcher.pack();
+
+  batcher.begin_frame();
+  batcher.add_instance(TestKey{1, 2, 5}, TestInstance{1, 2});
+  batcher.pack();
+
+  auto batches = get_batches(batcher);
+  ASSERT_EQ(batches.size(), 1u);
+  EXPECT_EQ(batches[1].FirstInstance, 0u);
+  EXPECT_EQ(batches[1].NumInstances, 1u);
+  EXPECT_EQ(batcher.packed_instances().size(), 1);
+
+  // Inactive key is still tracked until its lifetime runs out
+  EXPECT_EQ(batcher.key_count(), 2u);
+}
+
+TEST(InstanceBatcher, DropsKeysAfterLifetime) {
+  TestBatcher batcher;
+
+  batcher.begin_frame();
+  batcher.add_instance(TestKey{0, 1, 2}, TestInstance{0, 1});
+  batcher.add_instance(TestKey{1, 2, 100}, TestInstance{1, 1});
+  batcher.pack();
+
+  for (int frame = 0; frame < 2; frame++) {
+    batcher.begin_frame();
+    batcher.add_instance(TestKey{1, 2, 100}, TestInstance{1, 1});
+    batcher.pack();
+    EXPECT_EQ(batcher.key_count(), 2u);
+  }
+
+  batcher.begin_frame();
+  EXPECT_EQ(batcher.key_count(), 1u);
+
+  // Swapped-in entry is still found through its slot
+  batcher.add_instance(TestKey{1, 2, 100}, TestInstance{1, 7});
+  batcher.pack();
+  EXPECT_EQ(batcher.key_count(), 1u);
+  auto batches = get_batches(batcher);
+  ASSERT_EQ(batches.size(), 1u);
+  EXPECT_EQ(batches[1].NumInstances, 1u);
+  EXPECT_EQ(batcher.packed_instances()[0].Value, 7u);
+}
+
+TEST(InstanceBatcher, NegativeLifetimeLastsOneFrame) {
+  TestBatcher batcher;
+
+  batcher.begin_frame();
+  batcher.add_instance(TestKey{4, 1, -1}, TestInstance{4, 1});
+  batcher.pack();
+
+  // Still drawn the frame it was added...
+  EXPECT_EQ(get_batches(batcher).size(), 1u);
+
+  // ... but not kept around
+  batcher.begin_frame();
+  EXPECT_EQ(batcher.key_count(), 0u);
+}
+
+TEST(InstanceBatcher, ReusedSlotReplacesOldKey) {
+  TestBatcher batcher;
+
+  batcher.begin_frame();
+  batcher.add_instance(TestKey{2, 1, 5}, TestInstance{2, 1});
+  batcher.pack();
+
+  // Registry resource was removed, and a new one re-used its slot
+  batcher.begin_frame();
+  batcher.add_instance(TestKey{2, 9, 5}, TestInstance{2, 2});
+  batcher.pack();
+
+  EXPECT_EQ(batcher.key_count(), 1u);
+  auto batches = get_batches(batcher);
+  ASSERT_EQ(batches.size(), 1u);
+  EXPECT_EQ(batches[2].Generation, 9u);
+  EXPECT_EQ(batches[2].NumInstances, 1u);
+}
+
+TEST(InstanceBatcher, GrowsCapacityGeometrically) {
+  EXPECT_EQ(TestBatcher::grow_capacity(0u, 1u), TestBatcher::kMinCapacity);
+  EXPECT_EQ(TestBatcher::grow_capacity(64u, 64u), 64u);
+  EXPECT_EQ(TestBatcher::grow_capacity(64u, 65u), 128u);
+  EXPECT_EQ(TestBatcher::grow_capacity(128u, 1000u), 1024u);
+
+  // One-at-a-time growth only re-allocates a handful of times
+  uint32_t capacity = 0u;
+  uint32_t reallocations = 0u;
+  for (uint32_t required = 1u; required <= 10000u; required++) {
+    uint32_t new_capacity = TestBatcher::grow_capacity(capacity, required);
+    if (new_capacity != capacity) {
+      reallocations++;
+      capacity = new_capacity;
+    }
+  }
+  EXPECT_LE(reallocations, 9u);
+}
+
+TEST(InstanceBatcher, ManyKeysManyInstances) {
+  const uint32_t kKeyCount = 200u;
+  const uint32_t kInstanceCount = 10000u;
+
+  TestBatcher batcher;
+  for (int frame = 0; frame < 3; frame++) {
+    batcher.begin_frame();
+    for (uint32_t i = 0; i < kInstanceCount; i++) {
+      const uint32_t slot = (i * 7u) % kKeyCount;
+      batcher.add_instance(TestKey{slot, slot + 1u, 5}, TestInstance{slot, i});
+    }
+    batcher.pack();
+
+    ASSERT_EQ(batcher.packed_instances().size(), kInstanceCount);
+    EXPECT_EQ(batcher.key_count(), kKeyCount);
+
+    uint32_t total = 0u;
+    uint32_t expected_first = 0u;
+    batcher.for_each_batch([&](const TestKey& key, uint32_t first,
+                               uint32_t count) {
+      EXPECT_EQ(first, expected_first);
+      expected_first += count;
+      total += count;
+      for (uint32_t j = 0; j < count; j++) {
+        EXPECT_EQ(batcher.packed_instances()[first + j].KeySlot, key.Slot);
+      }
+    });
+    EXPECT_EQ(total, kInstanceCount);
+  }
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <iggpu/pipeline_cache.h>
+
+#include <vector>
+
+using namespace indigo;
+using namespace iggpu;
+
+namespace {
+
+// Stand-in for a GPU pipeline - every build gets a new id
+struct FakePipeline {
+  uint32_t id;
+};
+
+struct FakePipelineFactory {
+  uint32_t nextId = 1u;
+  uint32_t buildCount = 0u;
+
+  FakePipeline operator()() {
+    buildCount++;
+    return FakePipeline{nextId++};
+  }
+};
+
+}  // namespace
+
+TEST(PipelineCache, SameKeyBuildsOnce) {
+  PipelineCache<FakePipeline> cache;
+  FakePipelineFactory factory;
+
+  FakePipeline a = cache.get_or_create(1u, factory);
+  FakePipeline b = cache.get_or_create(1u, factory);
+  FakePipeline c = cache.get_or_create(2u, factory);
+
+  EXPECT_EQ(a.id, b.id);
+  EXPECT_NE(a.id, c.id);
+  EXPECT_EQ(factory.buildCount, 2u);
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.syncCreateCount, 2u);
+  EXPECT_EQ(stats.asyncCreateCount, 0u);
+  EXPECT_EQ(stats.cacheHitCount, 1u);
+  EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(PipelineCache, AsyncIsNotReadyUntilResolved) {
+  PipelineCache<FakePipeline> cache;
+  std::vector<PipelineCache<FakePipeline>::ResolveFn> pending;
+
+  auto promise = cache.get_or_create_async(
+      7u, [&pending](PipelineCache<FakePipeline>::ResolveFn resolve) {
+        pending.push_back(std::move(resolve));
+      });
+
+  EXPECT_TRUE(cache.contains(7u));
+  EXPECT_TRUE(cache.get_if_ready(7u).is_empty());
+  EXPECT_FALSE(promise->is_finished());
+
+  ASSERT_EQ(pending.size(), 1u);
+  pending[0](FakePipeline{42u});
+
+  ASSERT_TRUE(cache.get_if_ready(7u).has_value());
+  EXPECT_EQ(cache.get_if_ready(7u).get().id, 42u);
+  ASSERT_TRUE(promise->is_finished());
+  EXPECT_EQ(promise->unsafe_sync_get().id, 42u);
+}
+
+TEST(PipelineCache, InFlightAsyncBuildsAreShared) {
+  PipelineCache<FakePipeline> cache;
+  std::vector<PipelineCache<FakePipeline>::ResolveFn> pending;
+  auto start_fn = [&pending](PipelineCache<FakePipeline>::ResolveFn resolve) {
+    pending.push_back(std::move(resolve));
+  };
+
+  // Two scenes asking for the same pipeline before it finishes building
+  auto first = cache.get_or_create_async(3u, start_fn);
+  auto second = cache.get_or_create_async(3u, start_fn);
+
+  EXPECT_EQ(first, second);
+  ASSERT_EQ(pending.size(), 1u);
+
+  pending[0](FakePipeline{9u});
+
+  // Blocking callers afterwards get the async result without a rebuild
+  FakePipelineFactory factory;
+  EXPECT_EQ(cache.get_or_create(3u, factory).id, 9u);
+  EXPECT_EQ(factory.buildCount, 0u);
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.asyncCreateCount, 1u);
+  EXPECT_EQ(stats.syncCreateCount, 0u);
+  EXPECT_EQ(stats.cacheHitCount, 2u);
+}
+
+TEST(PipelineCache, AsyncAfterSyncBuildResolvesImmediately) {
+  PipelineCache<FakePipeline> cache;
+  FakePipelineFactory factory;
+  FakePipeline built = cache.get_or_create(5u, factory);
+
+  bool started = false;
+  auto promise = cache.get_or_create_async(
+      5u, [&started](PipelineCache<FakePipeline>::ResolveFn) {
+        started = true;
+      });
+
+  EXPECT_FALSE(started);
+  ASSERT_TRUE(promise->is_finished());
+  EXPECT_EQ(promise->unsafe_sync_get().id, built.id);
+}
+
+TEST(PipelineCache, ResolvingAfterCacheIsGoneIsSafe) {
+  PipelineCache<FakePipeline>::ResolveFn resolve;
+  std::shared_ptr<core::Promise<FakePipeline>> promise;
+
+  {
+    PipelineCache<FakePipeline> cache;
+    promise = cache.get_or_create_async(
+        1u, [&resolve](PipelineCache<FakePipeline>::ResolveFn r) {
+          resolve = std::move(r);
+        });
+  }
+
+  resolve(FakePipeline{11u});
+  ASSERT_TRUE(promise->is_finished());
+  EXPECT_EQ(promise->unsafe_sync_get().id, 11u);
+}
+
+TEST(PipelineCache, FailedAsyncBuildIsNotCached) {
+  PipelineCache<FakePipeline> cache;
+  std::vector<PipelineCache<FakePipeline>::ResolveFn> pending;
+  auto start_fn = [&pending](PipelineCache<FakePipeline>::ResolveFn resolve) {
+    pending.push_back(std::move(resolve));
+  };
+
+  auto failed = cache.get_or_create_async(4u, start_fn);
+  ASSERT_EQ(pending.size(), 1u);
+  pending[0](core::empty_maybe{});
+
+  // Waiters still hear back, with a null pipeline
+  ASSERT_TRUE(failed->is_finished());
+  EXPECT_EQ(failed->unsafe_sync_get().id, 0u);
+  EXPECT_FALSE(cache.contains(4u));
+  EXPECT_TRUE(cache.get_if_ready(4u).is_empty());
+
+  // ... and the next request builds it again
+  auto retried = cache.get_or_create_async(4u, start_fn);
+  EXPECT_NE(retried, failed);
+  ASSERT_EQ(pending.size(), 2u);
+  pending[1](FakePipeline{13u});
+
+  ASSERT_TRUE(cache.get_if_ready(4u).has_value());
+  EXPECT_EQ(cache.get_if_ready(4u).get().id, 13u);
+  EXPECT_EQ(retried->unsafe_sync_get().id, 13u);
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.asyncCreateCount, 2u);
+  EXPECT_EQ(stats.cacheHitCount, 0u);
+}
+
+TEST(PipelineCache, FailedAsyncBuildFallsBackToBlockingBuild) {
+  PipelineCache<FakePipeline> cache;
+  PipelineCache<FakePipeline>::ResolveFn resolve;
+  cache.get_or_create_async(
+      6u, [&resolve](PipelineCache<FakePipeline>::ResolveFn r) {
+        resolve = std::move(r);
+      });
+  resolve(core::empty_maybe{});
+
+  FakePipelineFactory factory;
+  EXPECT_NE(cache.get_or_create(6u, factory).id, 0u);
+  EXPECT_EQ(factory.buildCount, 1u);
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <iggpu/render_queue.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace indigo;
+using namespace iggpu;
+
+namespace {
+
+std::vector<RenderQueue::Batch> get_batches(const RenderQueue& queue) {
+  std::vector<RenderQueue::Batch> batches;
+  queue.for_each_batch(
+      [&batches](const RenderQueue::Batch& b) { batches.push_back(b); });
+  return batches;
+}
+
+}  // namespace
+
+TEST(RenderQueue, SortKeyRoundTrips) {
+  uint64_t key = RenderSortKey::make(3u, 0x123456u, 0xDEADBEEFu);
+
+  EXPECT_EQ(RenderSortKey::pipeline(key), 3u);
+  EXPECT_EQ(RenderSortKey::material(key), 0x123456u);
+  EXPECT_EQ(RenderSortKey::geometry(key), 0xDEADBEEFu);
+}
+
+TEST(RenderQueue, SortsPipelineThenMaterialThenGeometry) {
+  RenderQueue queue;
+  queue.begin_frame();
+
+  queue.add(RenderSortKey::make(1u, 0u, 0u));  // 0
+  queue.add(RenderSortKey::make(0u, 2u, 0u));  // 1
+  queue.add(RenderSortKey::make(0u, 1u, 5u));  // 2
+  queue.add(RenderSortKey::make(0u, 1u, 2u));  // 3
+  queue.sort();
+
+  ASSERT_EQ(queue.size(), 4u);
+  EXPECT_EQ(queue.sorted_item(0), 3u);
+  EXPECT_EQ(queue.sorted_item(1), 2u);
+  EXPECT_EQ(queue.sorted_item(2), 1u);
+  EXPECT_EQ(queue.sorted_item(3), 0u);
+}
+
+TEST(RenderQueue, SortIsStableForEqualKeys) {
+  RenderQueue queue;
+  queue.begin_frame();
+
+  uint64_t a = RenderSortKey::make(0u, 1u, 1u);
+  uint64_t b = RenderSortKey::make(0u, 0u, 1u);
+  queue.add(a);  // 0
+  queue.add(b);  // 1
+  queue.add(a);  // 2
+  queue.add(b);  // 3
+  queue.add(a);  // 4
+  queue.sort();
+
+  EXPECT_EQ(queue.sorted_item(0), 1u);
+  EXPECT_EQ(queue.sorted_item(1), 3u);
+  EXPECT_EQ(queue.sorted_item(2), 0u);
+  EXPECT_EQ(queue.sorted_item(3), 2u);
+  EXPECT_EQ(queue.sorted_item(4), 4u);
+}
+
+TEST(RenderQueue, MergesEqualKeysIntoBatches) {
+  RenderQueue queue;
+  queue.begin_frame();
+
+  // 500 characters with two meshes each, same as the game client
+  uint64_t base_key = RenderSortKey::make(0u, 0u, 0u);
+  uint64_t joints_key = RenderSortKey::make(0u, 1u, 1u);
+  for (uint32_t i = 0; i < 500u; i++) {
+    queue.add(joints_key);
+    queue.add(base_key);
+  }
+  queue.sort();
+
+  auto batches = ::get_batches(queue);
+  ASSERT_EQ(batches.size(), 2u);
+
+  EXPECT_EQ(batches[0].sortKey, base_key);
+  EXPECT_EQ(batches[0].firstItem, 0u);
+  EXPECT_EQ(batches[0].numItems, 500u);
+
+  EXPECT_EQ(batches[1].sortKey, joints_key);
+  EXPECT_EQ(batches[1].firstItem, 500u);
+  EXPECT_EQ(batches[1].numItems, 500u);
+
+  for (uint32_t i = 0; i < 500u; i++) {
+    EXPECT_EQ(queue.sorted_item(i), i * 2u + 1u);
+    EXPECT_EQ(queue.sorted_item(500u + i), i * 2u);
+  }
+}
+
+TEST(RenderQueue, FlagsOnlyChangedBinds) {
+  RenderQueue queue;
+  queue.begin_frame();
+
+  queue.add(RenderSortKey::make(0u, 0u, 0u));
+  queue.add(RenderSortKey::make(0u, 0u, 1u));
+  queue.add(RenderSortKey::make(0u, 1u, 1u));
+  queue.add(RenderSortKey::make(1u, 1u, 1u));
+  queue.sort();
+
+  auto batches = ::get_batches(queue);
+  ASSERT_EQ(batches.size(), 4u);
+
+  // First batch binds everything
+  EXPECT_TRUE(batches[0].pipelineChanged);
+  EXPECT_TRUE(batches[0].materialChanged);
+  EXPECT_TRUE(batches[0].geometryChanged);
+
+  // New geometry, same material
+  EXPECT_FALSE(batches[1].pipelineChanged);
+  EXPECT_FALSE(batches[1].materialChanged);
+  EXPECT_TRUE(batches[1].geometryChanged);
+
+  // New material, same geometry
+  EXPECT_FALSE(batches[2].pipelineChanged);
+  EXPECT_TRUE(batches[2].materialChanged);
+  EXPECT_FALSE(batches[2].geometryChanged);
+
+  // New pipeline re-binds everything under it
+  EXPECT_TRUE(batches[3].pipelineChanged);
+  EXPECT_TRUE(batches[3].materialChanged);
+  EXPECT_TRUE(batches[3].geometryChanged);
+}
+
+TEST(RenderQueue, MatchesStableSortOnRandomKeys) {
+  std::mt19937_64 rng(1337u);
+  std::uniform_int_distribution<uint32_t> pipeline(0u, 3u);
+  std::uniform_int_distribution<uint32_t> material(0u, 40u);
+  std::uniform_int_distribution<uint32_t> geometry(0u, 0xFFFFFFFFu);
+
+  RenderQueue queue;
+  std::vector<std::pair<uint64_t, uint32_t>> expected;
+
+  // Run a few frames on one queue, to make sure it resets between them
+  for (uint32_t frame = 0; frame < 3u; frame++) {
+    queue.begin_frame();
+    expected.clear();
+
+    for (uint32_t i = 0; i < 5000u + frame * 17u; i++) {
+      // Plenty of duplicate keys, so stability actually gets tested
+      uint64_t key = RenderSortKey::make(pipeline(rng), material(rng),
+                                         geometry(rng) % 64u);
+      expected.push_back({key, queue.add(key)});
+    }
+
+    queue.sort();
+    std::stable_sort(
+        expected.begin(), expected.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    ASSERT_EQ(queue.size(), expected.size());
+    for (uint32_t i = 0; i < queue.size(); i++) {
+      EXPECT_EQ(queue.sorted_key(i), expected[i].first);
+      EXPECT_EQ(queue.sorted_item(i), expected[i].second);
+    }
+
+    uint32_t batched_items = 0u;
+    uint64_t last_key = 0u;
+    for (const auto& batch : ::get_batches(queue)) {
+      EXPECT_EQ(batch.firstItem, batched_items);
+      if (batched_items > 0u) {
+        EXPECT_LT(last_key, batch.sortKey);
+      }
+      for (uint32_t i = 0; i < batch.numItems; i++) {
+        EXPECT_EQ(queue.sorted_key(batch.firstItem + i), batch.sortKey);
+      }
+      batched_items += batch.numItems;
+      last_key = batch.sortKey;
+    }
+    EXPECT_EQ(batched_items, queue.size());
+  }
+}
+
+TEST(RenderQueue, EmptyQueueHasNoBatches) {
+  RenderQueue queue;
+  queue.begin_frame();
+  queue.sort();
+
+  EXPECT_EQ(queue.size(), 0u);
+  EXPECT_TRUE(::get_batches(queue).empty());
+}
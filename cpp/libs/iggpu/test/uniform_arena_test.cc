@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <iggpu/uniform_arena.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace indigo;
+using namespace iggpu;
+
+namespace {
+
+struct CameraData {
+  float matView[16];
+  float matProj[16];
+};
+
+struct LightingData {
+  float lightDirection[3];
+  float ambientCoefficient;
+};
+
+struct Write {
+  uint32_t offset;
+  uint32_t size;
+  std::vector<uint8_t> data;
+};
+
+struct RecordingWriter {
+  std::vector<Write> writes;
+
+  UniformArena::WriteFn fn() {
+    return [this](uint32_t offset, const uint8_t* data, uint32_t size) {
+      writes.push_back(
+          Write{offset, size, std::vector<uint8_t>(data, data + size)});
+    };
+  }
+};
+
+}  // namespace
+
+TEST(UniformArena, AllocationsAreAligned) {
+  UniformArena arena(1024u);
+
+  auto camera = arena.allocate<CameraData>();
+  auto lighting = arena.allocate<LightingData>();
+  auto fs = arena.allocate(12u);
+
+  EXPECT_EQ(camera.offset, 0u);
+  EXPECT_EQ(lighting.offset, 256u);
+  EXPECT_EQ(fs.offset, 512u);
+  EXPECT_EQ(fs.size, 12u);
+  EXPECT_EQ(arena.size(), 524u);
+}
+
+TEST(UniformArena, FullArenaGivesInvalidAllocation) {
+  UniformArena arena(300u);
+
+  EXPECT_TRUE(arena.allocate<CameraData>().is_valid());
+  EXPECT_FALSE(arena.allocate<CameraData>().is_valid());
+  EXPECT_FALSE(arena.allocate(0u).is_valid());
+}
+
+TEST(UniformArena, FirstFlushUploadsEverythingOnce) {
+  UniformArena arena(1024u);
+  RecordingWriter writer;
+
+  arena.allocate<CameraData>();
+  arena.allocate<LightingData>();
+
+  auto stats = arena.flush(writer.fn());
+
+  ASSERT_EQ(writer.writes.size(), 1u);
+  EXPECT_EQ(writer.writes[0].offset, 0u);
+  EXPECT_EQ(writer.writes[0].size, 256u + sizeof(LightingData));
+  EXPECT_EQ(stats.queueWrites, 1u);
+  EXPECT_EQ(stats.bytesWritten, 256u + sizeof(LightingData));
+}
+
+TEST(UniformArena, CleanArenaDoesNotWrite) {
+  UniformArena arena(1024u);
+  RecordingWriter writer;
+
+  auto lighting = arena.allocate<LightingData>();
+  arena.flush(writer.fn());
+
+  for (int frame = 0; frame < 5; frame++) {
+    const auto& data = arena.get_immutable<LightingData>(lighting);
+    (void)data;
+    auto stats = arena.flush(writer.fn());
+    EXPECT_EQ(stats.queueWrites, 0u);
+  }
+
+  EXPECT_EQ(writer.writes.size(), 1u);
+  EXPECT_FALSE(arena.is_dirty());
+}
+
+TEST(UniformArena, DirtySlotsMergeIntoOneWrite) {
+  UniformArena arena(2048u);
+  RecordingWriter writer;
+
+  auto a = arena.allocate<LightingData>();
+  arena.allocate<LightingData>();
+  auto c = arena.allocate<LightingData>();
+  arena.allocate<LightingData>();
+  arena.flush(writer.fn());
+  writer.writes.clear();
+
+  arena.get_mutable<LightingData>(a).ambientCoefficient = 0.25f;
+  arena.get_mutable<LightingData>(c).ambientCoefficient = 0.75f;
+
+  auto stats = arena.flush(writer.fn());
+  EXPECT_EQ(stats.queueWrites, 1u);
+  ASSERT_EQ(writer.writes.size(), 1u);
+
+  // One contiguous range from the first dirty slot to the end of the last
+  const Write& w = writer.writes[0];
+  EXPECT_EQ(w.offset, a.offset);
+  EXPECT_EQ(w.size, c.offset + sizeof(LightingData) - a.offset);
+
+  LightingData uploaded_c{};
+  memcpy(&uploaded_c, &w.data[c.offset - w.offset], sizeof(LightingData));
+  EXPECT_EQ(uploaded_c.ambientCoefficient, 0.75f);
+  EXPECT_EQ(arena.last_flush_stats().bytesWritten, w.size);
+}
+
+TEST(UniformArena, SingleDirtySlotOnlyWritesItself) {
+  UniformArena arena(1024u);
+  RecordingWriter writer;
+
+  arena.allocate<CameraData>();
+  auto fs = arena.allocate(12u);
+  arena.flush(writer.fn());
+  writer.writes.clear();
+
+  float camera_pos[3] = {1.f, 2.f, 3.f};
+  arena.write(fs, camera_pos, sizeof(camera_pos));
+  arena.flush(writer.fn());
+
+  ASSERT_EQ(writer.writes.size(), 1u);
+  EXPECT_EQ(writer.writes[0].offset, fs.offset);
+  EXPECT_EQ(writer.writes[0].size, 12u);
+}
+
+TEST(UniformArena, WriteSizesAreFourByteAligned) {
+  UniformArena arena(1024u);
+  RecordingWriter writer;
+
+  auto odd = arena.allocate(6u);
+  arena.flush(writer.fn());
+
+  ASSERT_EQ(writer.writes.size(), 1u);
+  EXPECT_EQ(writer.writes[0].offset, odd.offset);
+  EXPECT_EQ(writer.writes[0].size, 8u);
+}
+
+TEST(UniformArena, OversizedWriteIsRejected) {
+  UniformArena arena(1024u);
+  RecordingWriter writer;
+
+  auto slot = arena.allocate(8u);
+  arena.flush(writer.fn());
+
+  float too_big[4] = {1.f, 2.f, 3.f, 4.f};
+  arena.write(slot, too_big, sizeof(too_big));
+
+  EXPECT_FALSE(arena.is_dirty());
+  EXPECT_EQ(arena.get_immutable<float>(slot), 0.f);
+}
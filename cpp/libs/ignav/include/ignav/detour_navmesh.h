@@ -2,6 +2,9 @@
 #define LIBS_IGNAV_INCLUDE_IGNAV_DETOUR_NAVMESH_H
 
 #include <DetourNavMesh.h>
+#include <DetourNavMeshQuery.h>
+
+#include <memory>
 
 namespace indigo::nav {
 
@@ -17,10 +20,25 @@ class DetourNavmesh {
   const dtNavMesh* operator->() const { return mesh_; }
   const dtNavMesh* raw() const { return mesh_; }
 
+  /**
+   * Query object for this navmesh that belongs to the calling thread - made on
+   *  first use and reused after that, so it is never shared between threads.
+   *
+   * A dtNavMesh is safe to read from any number of threads at once, but a
+   *  dtNavMeshQuery is not, so this is what lets one navmesh be shared by
+   *  every match on a server. Each query costs roughly 40 bytes per node (node
+   *  pool, hash and open list), so ~80KB for 2048 nodes.
+   */
+  dtNavMeshQuery* thread_query(int max_nodes) const;
+
   ~DetourNavmesh();
 
  private:
   dtNavMesh* mesh_;
+
+  // Per-thread queries hold weak references to this, so that they are
+  //  dropped (instead of reused) once the navmesh they were made for is gone
+  std::shared_ptr<const int> lifetime_token_;
 };
 
 }  // namespace indigo::nav
@@ -1,23 +1,91 @@
 #include <ignav/detour_navmesh.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 using namespace indigo;
 using namespace nav;
 
-DetourNavmesh::DetourNavmesh(dtNavMesh* mesh) : mesh_(mesh) {}
+namespace {
+
+struct ThreadQuery {
+  std::weak_ptr<const int> Navmesh;
+  const int* NavmeshToken;
+  int MaxNodes;
+  dtNavMeshQuery* Query;
+};
+
+// Frees its queries when the thread exits
+struct ThreadQueries {
+  ~ThreadQueries() {
+    for (ThreadQuery& q : Queries) {
+      dtFreeNavMeshQuery(q.Query);
+    }
+  }
+
+  std::vector<ThreadQuery> Queries;
+};
+
+thread_local ThreadQueries tThreadQueries;
+
+}  // namespace
+
+DetourNavmesh::DetourNavmesh(dtNavMesh* mesh)
+    : mesh_(mesh), lifetime_token_(std::make_shared<const int>(0)) {}
 
 DetourNavmesh::DetourNavmesh(DetourNavmesh&& o) noexcept
-    : mesh_(std::exchange(o.mesh_, nullptr)) {}
+    : mesh_(std::exchange(o.mesh_, nullptr)),
+      lifetime_token_(std::move(o.lifetime_token_)) {}
 
 DetourNavmesh& DetourNavmesh::operator=(DetourNavmesh&& o) noexcept {
   mesh_ = std::exchange(o.mesh_, nullptr);
+  lifetime_token_ = std::move(o.lifetime_token_);
   return *this;
 }
 
+dtNavMeshQuery* DetourNavmesh::thread_query(int max_nodes) const {
+  if (mesh_ == nullptr || !lifetime_token_) {
+    return nullptr;
+  }
+
+  auto& queries = tThreadQueries.Queries;
+
+  // Queries for navmeshes that have since been freed are dropped here rather
+  //  than when the navmesh goes, since they belong to other threads
+  queries.erase(std::remove_if(queries.begin(), queries.end(),
+                               [](const ThreadQuery& q) {
+                                 if (!q.Navmesh.expired()) {
+                                   return false;
+                                 }
+                                 dtFreeNavMeshQuery(q.Query);
+                                 return true;
+                               }),
+                queries.end());
+
+  for (const ThreadQuery& q : queries) {
+    if (q.NavmeshToken == lifetime_token_.get() && q.MaxNodes == max_nodes) {
+      return q.Query;
+    }
+  }
+
+  dtNavMeshQuery* query = dtAllocNavMeshQuery();
+  if (query == nullptr) {
+    return nullptr;
+  }
+  if (dtStatusFailed(query->init(mesh_, max_nodes))) {
+    dtFreeNavMeshQuery(query);
+    return nullptr;
+  }
+
+  queries.push_back(
+      ThreadQuery{lifetime_token_, lifetime_token_.get(), max_nodes, query});
+  return query;
+}
+
 DetourNavmesh::~DetourNavmesh() {
   if (mesh_ != nullptr) {
     dtFreeNavMesh(mesh_);
     mesh_ = nullptr;
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,47 @@
+#ifndef _LIB_IGPLATFORM_MAPPED_FILE_H_
+#define _LIB_IGPLATFORM_MAPPED_FILE_H_
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * Pages are only read from disk when they are first touched, so readers that
+ *  only look at a small part of a large file pay for that part alone. Only
+ *  available on native builds - web builds always fail to map, and should fall
+ *  back to FilePromise.
+ */
+
+#include <igcore/either.h>
+#include <igplatform/file_promise.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace indigo::core {
+
+class MappedFile {
+ public:
+  static Either<std::shared_ptr<MappedFile>, FileReadError> Open(
+      const std::string& file_name);
+
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  MappedFile(const uint8_t* data, size_t size, void* platform_handle);
+
+  const uint8_t* data_;
+  size_t size_;
+
+  // File mapping object on Windows, unused elsewhere
+  void* platform_handle_;
+};
+
+}  // namespace indigo::core
+
+#endif
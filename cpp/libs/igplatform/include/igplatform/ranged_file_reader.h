@@ -0,0 +1,35 @@
+#ifndef _LIB_IGPLATFORM_RANGED_FILE_READER_H_
+#define _LIB_IGPLATFORM_RANGED_FILE_READER_H_
+
+/**
+ * Reads byte ranges of a single file - HTTP range requests on web builds, and
+ *  plain file reads on native builds (which stand in for the network in tests
+ *  and benchmarks).
+ *
+ * Reads may complete in any order. A range that runs past the end of the file
+ *  resolves with the bytes that do exist.
+ */
+
+#include <igasync/task_list.h>
+#include <igplatform/file_promise.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace indigo::core {
+
+class RangedFileReader {
+ public:
+  static std::shared_ptr<RangedFileReader> Create(
+      const std::string& file_name, const std::shared_ptr<TaskList>& task_list);
+
+  virtual ~RangedFileReader() = default;
+
+  virtual std::shared_ptr<FilePromiseT> read_range(uint64_t offset,
+                                                   uint64_t size) = 0;
+};
+
+}  // namespace indigo::core
+
+#endif
@@ -0,0 +1,91 @@
+#include <igplatform/mapped_file.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace indigo;
+using namespace core;
+
+MappedFile::MappedFile(const uint8_t* data, size_t size, void* platform_handle)
+    : data_(data), size_(size), platform_handle_(platform_handle) {}
+
+#ifdef _WIN32
+
+Either<std::shared_ptr<MappedFile>, FileReadError> MappedFile::Open(
+    const std::string& file_name) {
+  HANDLE file = ::CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return right(FileReadError::FileNotFound);
+  }
+
+  LARGE_INTEGER file_size{};
+  if (!::GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+    ::CloseHandle(file);
+    return right(FileReadError::FileNotRead);
+  }
+
+  HANDLE mapping =
+      ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  // The mapping keeps the file open on its own
+  ::CloseHandle(file);
+  if (mapping == nullptr) {
+    return right(FileReadError::FileNotRead);
+  }
+
+  void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == nullptr) {
+    ::CloseHandle(mapping);
+    return right(FileReadError::FileNotRead);
+  }
+
+  return left(std::shared_ptr<MappedFile>(
+      new MappedFile(static_cast<const uint8_t*>(view),
+                     static_cast<size_t>(file_size.QuadPart), mapping)));
+}
+
+MappedFile::~MappedFile() {
+  ::UnmapViewOfFile(data_);
+  ::CloseHandle(static_cast<HANDLE>(platform_handle_));
+}
+
+#else
+
+Either<std::shared_ptr<MappedFile>, FileReadError> MappedFile::Open(
+    const std::string& file_name) {
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return right(FileReadError::FileNotFound);
+  }
+
+  struct stat file_stat {};
+  if (::fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    ::close(fd);
+    return right(FileReadError::FileNotRead);
+  }
+
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return right(FileReadError::FileNotRead);
+  }
+
+  return left(std::shared_ptr<MappedFile>(
+      new MappedFile(static_cast<const uint8_t*>(data), size, nullptr)));
+}
+
+MappedFile::~MappedFile() {
+  ::munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include <igplatform/ranged_file_reader.h>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+
+class FileRangedReader : public RangedFileReader {
+ public:
+  FileRangedReader(std::string file_name, std::shared_ptr<TaskList> task_list)
+      : file_name_(std::move(file_name)), task_list_(std::move(task_list)) {}
+
+  std::shared_ptr<FilePromiseT> read_range(uint64_t offset,
+                                           uint64_t size) override {
+    auto rsl = FilePromiseT::create("ReadFileRange");
+
+    task_list_->add_task(Task::of([rsl, file_name = file_name_, offset,
+                                   size]() {
+      std::ifstream fin(file_name, std::ios::binary | std::ios::ate);
+      if (!fin) {
+        rsl->resolve(core::right(FileReadError::FileNotFound));
+        return;
+      }
+
+      uint64_t file_size = static_cast<uint64_t>(fin.tellg());
+      if (offset > file_size) {
+        rsl->resolve(core::right(FileReadError::FileNotRead));
+        return;
+      }
+
+      uint64_t read_size = std::min(size, file_size - offset);
+      auto data = std::make_shared<RawBuffer>(read_size);
+      fin.seekg(offset, std::ios::beg);
+      if (!fin.read(reinterpret_cast<char*>(data->get()), read_size)) {
+        rsl->resolve(core::right(FileReadError::FileNotRead));
+        return;
+      }
+
+      rsl->resolve(core::left(std::move(data)));
+    }));
+
+    return rsl;
+  }
+
+ private:
+  std::string file_name_;
+  std::shared_ptr<TaskList> task_list_;
+};
+
+}  // namespace
+
+std::shared_ptr<RangedFileReader> RangedFileReader::Create(
+    const std::string& file_name, const std::shared_ptr<TaskList>& task_list) {
+  return std::make_shared<::FileRangedReader>(file_name, task_list);
+}
@@ -0,0 +1,15 @@
+#include <igplatform/mapped_file.h>
+
+using namespace indigo;
+using namespace core;
+
+MappedFile::MappedFile(const uint8_t* data, size_t size, void* platform_handle)
+    : data_(data), size_(size), platform_handle_(platform_handle) {}
+
+Either<std::shared_ptr<MappedFile>, FileReadError> MappedFile::Open(
+    const std::string& file_name) {
+  // No file system to map on the web - assets come in over fetch
+  return right(FileReadError::FileNotRead);
+}
+
+MappedFile::~MappedFile() {}
@@ -0,0 +1,86 @@
+#include <emscripten/fetch.h>
+#include <igplatform/ranged_file_reader.h>
+
+#include <cstring>
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+
+struct RangeRequest {
+  std::shared_ptr<FilePromiseT> fpp;
+};
+
+void em_range_fetch_success(emscripten_fetch_t* fetch) {
+  auto* r = reinterpret_cast<::RangeRequest*>(fetch->userData);
+
+  // 200 instead of 206 means the server ignored the range and sent everything
+  //  - the caller asked for a range it can index into, so treat it as a miss
+  if (fetch->status != 206) {
+    r->fpp->resolve(core::right(FileReadError::FileNotRead));
+  } else {
+    auto data = std::make_shared<RawBuffer>(fetch->numBytes);
+    memcpy(data->get(), fetch->data, fetch->numBytes);
+    r->fpp->resolve(core::left(std::move(data)));
+  }
+
+  delete r;
+  emscripten_fetch_close(fetch);
+}
+
+void em_range_fetch_error(emscripten_fetch_t* fetch) {
+  auto* r = reinterpret_cast<::RangeRequest*>(fetch->userData);
+
+  if (fetch->status == 404) {
+    r->fpp->resolve(core::right(FileReadError::FileNotFound));
+  } else {
+    r->fpp->resolve(core::right(FileReadError::FileNotRead));
+  }
+
+  delete r;
+  emscripten_fetch_close(fetch);
+}
+
+class FetchRangedReader : public RangedFileReader {
+ public:
+  FetchRangedReader(std::string file_name) : file_name_(std::move(file_name)) {}
+
+  std::shared_ptr<FilePromiseT> read_range(uint64_t offset,
+                                           uint64_t size) override {
+    auto rsl = FilePromiseT::create("ReadFileRange");
+    if (size == 0u) {
+      rsl->resolve(core::left(std::make_shared<RawBuffer>(0u)));
+      return rsl;
+    }
+
+    // emscripten_fetch copies the request headers, these only need to live
+    //  until it returns
+    std::string range = "bytes=" + std::to_string(offset) + "-" +
+                        std::to_string(offset + size - 1u);
+    const char* headers[] = {"Range", range.c_str(), nullptr};
+
+    emscripten_fetch_attr_t attr;
+    emscripten_fetch_attr_init(&attr);
+    strcpy(attr.requestMethod, "GET");
+    attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
+    attr.requestHeaders = headers;
+    attr.userData = new ::RangeRequest{rsl};
+    attr.onsuccess = em_range_fetch_success;
+    attr.onerror = em_range_fetch_error;
+
+    emscripten_fetch(&attr, file_name_.c_str());
+
+    return rsl;
+  }
+
+ private:
+  std::string file_name_;
+};
+
+}  // namespace
+
+std::shared_ptr<RangedFileReader> RangedFileReader::Create(
+    const std::string& file_name, const std::shared_ptr<TaskList>&) {
+  return std::make_shared<::FetchRangedReader>(file_name);
+}
@@ -0,0 +1,568 @@
+#include "animation_benchmark.h"
+
+#include <ecs/components/ozz_animation_components.h>
+#include <ecs/systems/batched_animation_system.h>
+#include <ecs/utils/ozz_animation_blend_utils.h>
+#include <igcore/pod_vector.h>
+#include <ozz/animation/offline/animation_builder.h>
+#include <ozz/animation/offline/raw_animation.h>
+#include <ozz/animation/offline/raw_skeleton.h>
+#include <ozz/animation/offline/skeleton_builder.h>
+#include <ozz/animation/runtime/local_to_model_job.h>
+#include <ozz/animation/runtime/sampling_job.h>
+#include <ozz/base/maths/quaternion.h>
+#include <render/solid_animated/skin_palette.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <iomanip>
+#include <random>
+
+using namespace sanctify;
+using namespace bench;
+using namespace indigo;
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+// Buffer size the one-entity-at-a-time loop used for every character
+//  (SolidAnimatedPipeline::kMaxBonesCount)
+constexpr uint32_t kLegacyBufferSize = 80u;
+constexpr uint32_t kLimbCount = 5u;
+constexpr float kKeysPerSecond = 30.f;
+constexpr uint32_t kBlendLayerCounts[] = {1u, 2u, 4u};
+
+typedef ReadonlyResourceRegistry<ozz::animation::Skeleton> SkeletonRegistry;
+typedef ReadonlyResourceRegistry<ozz::animation::Animation> AnimationRegistry;
+
+struct Crowd {
+  std::shared_ptr<SkeletonRegistry> skeletons;
+  std::shared_ptr<AnimationRegistry> animations;
+  SkeletonRegistry::Key skeletonKey;
+  std::vector<AnimationRegistry::Key> clipKeys;
+  std::vector<float> clipDurations;
+
+  // Not a real bind pose, just distinct invertible transforms per joint so
+  //  that palette packing does real math
+  std::vector<glm::mat4> invBindPoses;
+};
+
+void add_chain(ozz::animation::offline::RawSkeleton::Joint* parent,
+               uint32_t length, uint32_t* next_joint_id) {
+  if (length == 0u) {
+    return;
+  }
+
+  parent->children.resize(1u);
+  auto& joint = parent->children[0];
+  joint.name = ("joint_" + std::to_string((*next_joint_id)++)).c_str();
+  joint.transform = ozz::math::Transform::identity();
+  joint.transform.translation = ozz::math::Float3(0.f, 0.1f, 0.f);
+  ::add_chain(&joint, length - 1u, next_joint_id);
+}
+
+bool build_crowd(Crowd* crowd, const AnimationBenchmarkParams& params) {
+  crowd->skeletons = std::make_shared<SkeletonRegistry>();
+  crowd->animations = std::make_shared<AnimationRegistry>();
+
+  // Root plus a few limbs, roughly the shape of a humanoid rig
+  ozz::animation::offline::RawSkeleton raw_skeleton;
+  raw_skeleton.roots.resize(1u);
+  auto& root = raw_skeleton.roots[0];
+  root.name = "root";
+  root.transform = ozz::math::Transform::identity();
+
+  uint32_t next_joint_id = 1u;
+  const uint32_t limb_joints = params.jointCount - 1u;
+  root.children.resize(kLimbCount);
+  for (uint32_t i = 0; i < kLimbCount; i++) {
+    auto& limb = root.children[i];
+    limb.name = ("limb_" + std::to_string(i)).c_str();
+    limb.transform = ozz::math::Transform::identity();
+    next_joint_id++;
+
+    uint32_t length = limb_joints / kLimbCount - 1u +
+                      (i < limb_joints % kLimbCount ? 1u : 0u);
+    ::add_chain(&limb, length, &next_joint_id);
+  }
+
+  ozz::animation::offline::SkeletonBuilder skeleton_builder;
+  auto skeleton = skeleton_builder(raw_skeleton);
+  if (skeleton == nullptr) {
+    return false;
+  }
+  const int num_joints = skeleton->num_joints();
+  crowd->skeletonKey = crowd->skeletons->add_resource(std::move(*skeleton));
+
+  for (int joint = 0; joint < num_joints; joint++) {
+    glm::mat4 inv_bind(1.f);
+    inv_bind[0][0] = std::cos(joint * 0.1f);
+    inv_bind[0][1] = std::sin(joint * 0.1f);
+    inv_bind[1][0] = -std::sin(joint * 0.1f);
+    inv_bind[1][1] = std::cos(joint * 0.1f);
+    inv_bind[3] = glm::vec4(0.f, -0.1f * (joint % 16), 0.02f * joint, 1.f);
+    crowd->invBindPoses.push_back(inv_bind);
+  }
+
+  // Blend runs need a distinct clip per layer
+  const uint32_t clip_count =
+      std::max(params.clipCount, ecs::OzzAnimationBlendComponent::kMaxLayers);
+  for (uint32_t clip = 0; clip < clip_count; clip++) {
+    ozz::animation::offline::RawAnimation raw_animation;
+    raw_animation.duration = 0.8f + 0.4f * clip;
+    raw_animation.tracks.resize(num_joints);
+
+    const int key_count =
+        static_cast<int>(raw_animation.duration * kKeysPerSecond) + 1;
+    for (int joint = 0; joint < num_joints; joint++) {
+      auto& track = raw_animation.tracks[joint];
+      for (int k = 0; k < key_count; k++) {
+        const float t = raw_animation.duration * k / (key_count - 1);
+        const float angle =
+            0.4f * std::sin(6.2831853f * t / raw_animation.duration +
+                            joint * 0.37f + clip);
+        track.rotations.push_back(
+            {t, ozz::math::Quaternion::FromAxisAngle(
+                    ozz::math::Float3(0.f, 0.f, 1.f), angle)});
+      }
+    }
+
+    ozz::animation::offline::AnimationBuilder animation_builder;
+    auto animation = animation_builder(raw_animation);
+    if (animation == nullptr) {
+      return false;
+    }
+    crowd->clipDurations.push_back(raw_animation.duration);
+    crowd->clipKeys.push_back(crowd->animations->add_resource(
+        std::move(*animation)));
+  }
+
+  return true;
+}
+
+struct CrowdWorld {
+  entt::registry world;
+  std::vector<entt::entity> entities;
+  std::vector<uint32_t> clips;
+
+  // 0 for OzzAnimationStateComponent, otherwise OzzAnimationBlendComponent
+  //  layers per character - layer i plays clip (clips[e] + i)
+  uint32_t blendLayers = 0u;
+};
+
+void setup_world(CrowdWorld* w, const Crowd& crowd,
+                 const AnimationBenchmarkParams& params, bool cull) {
+  std::mt19937 rng(params.seed);
+  std::uniform_int_distribution<uint32_t> clip_dist(0u, params.clipCount - 1u);
+  std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+  for (uint32_t i = 0; i < params.characterCount; i++) {
+    const uint32_t clip = clip_dist(rng);
+    const float start_time = unit(rng) * crowd.clipDurations[clip];
+    const bool is_culled = unit(rng) < params.culledFraction;
+
+    auto e = w->world.create();
+    w->world.emplace<ecs::OzzAnimationStateComponent>(
+        e, crowd.skeletonKey, crowd.clipKeys[clip], start_time, 1.f);
+    if (cull && is_culled) {
+      w->world.emplace<ecs::OzzAnimationCulledTag>(e);
+    }
+    w->entities.push_back(e);
+    w->clips.push_back(clip);
+  }
+}
+
+// Every layer at equal weight - the most expensive case for a blend of
+//  "layer_count" clips
+void setup_blend_world(CrowdWorld* w, const Crowd& crowd,
+                       const AnimationBenchmarkParams& params,
+                       uint32_t layer_count) {
+  std::mt19937 rng(params.seed);
+  const uint32_t clip_count = static_cast<uint32_t>(crowd.clipKeys.size());
+  std::uniform_int_distribution<uint32_t> clip_dist(0u, clip_count - 1u);
+  std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+  w->blendLayers = layer_count;
+  for (uint32_t i = 0; i < params.characterCount; i++) {
+    const uint32_t base_clip = clip_dist(rng);
+
+    auto e = w->world.create();
+    auto& blend = w->world.emplace<ecs::OzzAnimationBlendComponent>(
+        e, crowd.skeletonKey);
+    for (uint32_t l = 0; l < layer_count; l++) {
+      const uint32_t clip = (base_clip + l) % clip_count;
+      ecs::OzzAnimationBlendUtil::set_layer_weight(
+          blend, crowd.clipKeys[clip], 1.f / layer_count);
+      blend.layers[l].animationTime = unit(rng) * crowd.clipDurations[clip];
+    }
+    w->entities.push_back(e);
+    w->clips.push_back(base_clip);
+  }
+}
+
+// Wrapped here instead of inside the systems under test, so that both worlds
+//  sample at bit-identical times
+void advance_time(CrowdWorld* w, const Crowd& crowd, float dt) {
+  if (w->blendLayers > 0u) {
+    const size_t clip_count = crowd.clipKeys.size();
+    for (size_t i = 0; i < w->entities.size(); i++) {
+      auto& blend =
+          w->world.get<ecs::OzzAnimationBlendComponent>(w->entities[i]);
+      for (uint32_t l = 0; l < blend.layerCount; l++) {
+        auto& layer = blend.layers[l];
+        const float duration =
+            crowd.clipDurations[(w->clips[i] + l) % clip_count];
+        layer.animationTime += dt;
+        if (layer.animationTime >= duration) {
+          layer.animationTime -= duration;
+        }
+      }
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < w->entities.size(); i++) {
+    auto& state =
+        w->world.get<ecs::OzzAnimationStateComponent>(w->entities[i]);
+    const float duration = crowd.clipDurations[w->clips[i]];
+    state.animationTime += dt;
+    if (state.animationTime >= duration) {
+      state.animationTime -= duration;
+    }
+  }
+}
+
+//
+// The one-entity-at-a-time loop BatchedOzzAnimationSystem replaced, kept
+//  here as the baseline
+//
+struct LegacyCpuBuffersComponent {
+  LegacyCpuBuffersComponent(uint32_t buffer_size)
+      : context(std::make_unique<ozz::animation::SamplingJob::Context>(
+            buffer_size)),
+        locals(buffer_size),
+        models(buffer_size) {
+    locals.resize(buffer_size);
+    models.resize(buffer_size);
+  }
+
+  std::unique_ptr<ozz::animation::SamplingJob::Context> context;
+  core::PodVector<ozz::math::SoaTransform> locals;
+  core::PodVector<ozz::math::Float4x4> models;
+};
+
+void legacy_update(entt::registry& world, const Crowd& crowd) {
+  auto view = world.view<ecs::OzzAnimationStateComponent>();
+  for (auto [e, animation_state] : view.each()) {
+    auto& buffers = world.get_or_emplace<LegacyCpuBuffersComponent>(
+        e, kLegacyBufferSize);
+
+    auto* skeleton = crowd.skeletons->get(animation_state.skeletonKey);
+    auto* animation = crowd.animations->get(animation_state.animationKey);
+    if (!skeleton || !animation) {
+      continue;
+    }
+
+    ozz::animation::SamplingJob sampling_job;
+    sampling_job.animation = animation;
+    sampling_job.context = buffers.context.get();
+    sampling_job.ratio =
+        (animation_state.animationTime * animation_state.animationTimeRatio) /
+        animation->duration();
+    sampling_job.output =
+        ozz::span(buffers.locals.raw(), buffers.locals.size());
+    if (!sampling_job.Run()) {
+      continue;
+    }
+
+    ozz::animation::LocalToModelJob ltm_job;
+    ltm_job.skeleton = skeleton;
+    ltm_job.input = ozz::span(buffers.locals.raw(), buffers.locals.size());
+    ltm_job.output = ozz::span(buffers.models.raw(), buffers.models.size());
+    ltm_job.Run();
+  }
+}
+
+uint32_t pack_palette(solid_animated::SkinPalette* palette,
+                      entt::registry& world, const Crowd& crowd) {
+  palette->reset();
+  uint32_t posed_characters = 0u;
+  auto view = world.view<const ecs::OzzAnimationPoseComponent>();
+  for (auto [e, pose] : view.each()) {
+    const uint32_t joint_count = std::min(
+        pose.numJoints, static_cast<uint32_t>(crowd.invBindPoses.size()));
+    palette->add(pose.models, crowd.invBindPoses.data(), joint_count);
+    posed_characters++;
+  }
+  return posed_characters;
+}
+
+// Packs every character of "w" and compares against model * inverse bind pose
+//  done in glm, one joint at a time
+float max_palette_error(CrowdWorld* w, const Crowd& crowd) {
+  solid_animated::SkinPalette palette;
+  float max_error = 0.f;
+  for (size_t i = 0; i < w->entities.size(); i++) {
+    const auto* pose =
+        w->world.try_get<ecs::OzzAnimationPoseComponent>(w->entities[i]);
+    if (!pose) {
+      continue;
+    }
+
+    const uint32_t joint_count = std::min(
+        pose->numJoints, static_cast<uint32_t>(crowd.invBindPoses.size()));
+    palette.reset();
+    palette.add(pose->models, crowd.invBindPoses.data(), joint_count);
+
+    for (uint32_t j = 0; j < joint_count; j++) {
+      glm::mat4 model;
+      std::memcpy(&model[0][0], &pose->models[j], sizeof(glm::mat4));
+      const glm::mat4 skin = model * crowd.invBindPoses[j];
+
+      const auto& packed = palette.matrices()[j];
+      for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 4; col++) {
+          max_error = std::max(
+              max_error, std::abs(packed.rows[row][col] - skin[col][row]));
+        }
+      }
+    }
+  }
+  return max_error;
+}
+
+float max_matrix_error(const ozz::math::Float4x4* a,
+                       const ozz::math::Float4x4* b, uint32_t count) {
+  float max_error = 0.f;
+  for (uint32_t i = 0; i < count; i++) {
+    const float* fa = reinterpret_cast<const float*>(&a[i]);
+    const float* fb = reinterpret_cast<const float*>(&b[i]);
+    for (int j = 0; j < 16; j++) {
+      max_error = std::max(max_error, std::abs(fa[j] - fb[j]));
+    }
+  }
+  return max_error;
+}
+
+double elapsed_ms(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+AnimationBenchmarkRun run_legacy(CrowdWorld* w, const Crowd& crowd,
+                                 const AnimationBenchmarkParams& params) {
+  AnimationBenchmarkRun run{};
+  run.name = "legacy_serial";
+
+  double total_ms = 0.;
+  for (uint32_t frame = 0; frame < params.frameCount; frame++) {
+    ::advance_time(w, crowd, params.frameSeconds);
+    auto start = Clock::now();
+    ::legacy_update(w->world, crowd);
+    total_ms += ::elapsed_ms(start);
+  }
+
+  run.msPerFrame = total_ms / params.frameCount;
+  run.usPerCharacter = run.msPerFrame * 1000. / params.characterCount;
+  run.uniqueSamplesPerFrame = params.characterCount;
+  run.sampledCharactersPerFrame = params.characterCount;
+  run.poseBytes = static_cast<uint64_t>(params.characterCount) *
+                  kLegacyBufferSize *
+                  (sizeof(ozz::math::SoaTransform) +
+                   sizeof(ozz::math::Float4x4));
+  return run;
+}
+
+AnimationBenchmarkRun run_batched(std::string name, CrowdWorld* w,
+                                  const Crowd& crowd,
+                                  const AnimationBenchmarkParams& params,
+                                  uint32_t worker_count, float share_hz) {
+  auto system_params = ecs::BatchedOzzAnimationSystem::DefaultParams();
+  system_params.workerThreadCount = worker_count;
+  system_params.shareSampleRateHz = share_hz;
+  ecs::BatchedOzzAnimationSystem system(crowd.skeletons, crowd.animations,
+                                        system_params);
+
+  AnimationBenchmarkRun run{};
+  run.name = std::move(name);
+
+  solid_animated::SkinPalette palette;
+
+  double total_ms = 0.;
+  double palette_ms = 0.;
+  uint64_t unique_samples = 0u;
+  uint64_t sampled_characters = 0u;
+  uint64_t packed_characters = 0u;
+  for (uint32_t frame = 0; frame < params.frameCount; frame++) {
+    ::advance_time(w, crowd, params.frameSeconds);
+    auto start = Clock::now();
+    system.update(w->world);
+    total_ms += ::elapsed_ms(start);
+
+    start = Clock::now();
+    packed_characters += ::pack_palette(&palette, w->world, crowd);
+    palette_ms += ::elapsed_ms(start);
+
+    const auto& stats = system.last_update_stats();
+    unique_samples += stats.uniqueSamples;
+    sampled_characters += stats.animatedEntities;
+    run.poseBytes = std::max(run.poseBytes, stats.poseArenaBytes);
+    run.paletteBytes =
+        std::max(run.paletteBytes, palette.matrices().raw_size());
+  }
+
+  if (packed_characters > 0u) {
+    run.paletteUsPerCharacter = palette_ms * 1000. / packed_characters;
+  }
+
+  run.msPerFrame = total_ms / params.frameCount;
+  run.usPerCharacter = run.msPerFrame * 1000. / params.characterCount;
+  run.uniqueSamplesPerFrame =
+      static_cast<double>(unique_samples) / params.frameCount;
+  run.sampledCharactersPerFrame =
+      static_cast<double>(sampled_characters) / params.frameCount;
+  return run;
+}
+
+}  // namespace
+
+AnimationBenchmarkResults AnimationBenchmark::Run(
+    AnimationBenchmarkParams params) {
+  AnimationBenchmarkResults results{};
+  results.params = params;
+
+  Crowd crowd{};
+  if (!::build_crowd(&crowd, params)) {
+    return results;
+  }
+
+  CrowdWorld legacy_world;
+  ::setup_world(&legacy_world, crowd, params, false);
+  results.runs.push_back(::run_legacy(&legacy_world, crowd, params));
+
+  CrowdWorld serial_world;
+  ::setup_world(&serial_world, crowd, params, false);
+  results.runs.push_back(
+      ::run_batched("batched_serial", &serial_world, crowd, params, 0u, 0.f));
+
+  results.maxPaletteError = ::max_palette_error(&serial_world, crowd);
+
+  // Same frames, same times - the old loop and the batched system must agree
+  const uint32_t joint_count = static_cast<uint32_t>(
+      crowd.skeletons->get(crowd.skeletonKey)->num_joints());
+  for (size_t i = 0; i < legacy_world.entities.size(); i++) {
+    const auto& legacy = legacy_world.world.get<LegacyCpuBuffersComponent>(
+        legacy_world.entities[i]);
+    const auto& pose = serial_world.world.get<ecs::OzzAnimationPoseComponent>(
+        serial_world.entities[i]);
+    results.maxModelError =
+        std::max(results.maxModelError,
+                 ::max_matrix_error(legacy.models.raw(), pose.models,
+                                    std::min(joint_count, pose.numJoints)));
+  }
+
+  {
+    CrowdWorld w;
+    ::setup_world(&w, crowd, params, false);
+    results.runs.push_back(::run_batched("batched_parallel", &w, crowd, params,
+                                         params.workerThreadCount, 0.f));
+  }
+  {
+    CrowdWorld w;
+    ::setup_world(&w, crowd, params, false);
+    results.runs.push_back(::run_batched("batched_parallel_shared", &w, crowd,
+                                         params, params.workerThreadCount,
+                                         params.shareSampleRateHz));
+  }
+  {
+    CrowdWorld w;
+    ::setup_world(&w, crowd, params, true);
+    results.runs.push_back(::run_batched("batched_parallel_shared_culled", &w,
+                                         crowd, params,
+                                         params.workerThreadCount,
+                                         params.shareSampleRateHz));
+  }
+
+  // Cost per active blend layer - unshared is the worst case (every layer of
+  //  every character sampled), shared is what a crowd on a few clips costs
+  for (uint32_t layer_count : kBlendLayerCounts) {
+    const std::string name = "blend_" + std::to_string(layer_count) + "_layer" +
+                             (layer_count > 1u ? "s" : "");
+    {
+      CrowdWorld w;
+      ::setup_blend_world(&w, crowd, params, layer_count);
+      results.runs.push_back(::run_batched(
+          name, &w, crowd, params, params.workerThreadCount, 0.f));
+    }
+    {
+      CrowdWorld w;
+      ::setup_blend_world(&w, crowd, params, layer_count);
+      results.runs.push_back(::run_batched(name + "_shared", &w, crowd, params,
+                                           params.workerThreadCount,
+                                           params.shareSampleRateHz));
+    }
+  }
+
+  return results;
+}
+
+void AnimationBenchmark::write_text(std::ostream& o,
+                                    const AnimationBenchmarkResults& results) {
+  const auto& p = results.params;
+  o << "Animation sampling: " << p.characterCount << " characters, "
+    << p.jointCount << " joints, " << p.clipCount << " clips, "
+    << p.frameCount << " frames, " << p.workerThreadCount
+    << " worker threads, sharing at " << p.shareSampleRateHz << "Hz, "
+    << p.culledFraction * 100.f << "% culled (culled run only)\n";
+  o << "  Blend runs play " << ecs::OzzAnimationBlendComponent::kMaxLayers
+    << "+ clips, every layer at equal weight\n";
+  o << std::fixed << std::setprecision(3);
+  for (const auto& run : results.runs) {
+    o << "  " << std::left << std::setw(32) << run.name << std::right
+      << std::setw(9) << run.msPerFrame << " ms/frame  " << std::setw(8)
+      << run.usPerCharacter << " us/character  " << std::setw(8)
+      << run.uniqueSamplesPerFrame << " samples/frame  " << std::setw(8)
+      << run.sampledCharactersPerFrame << " posed/frame  " << std::setw(10)
+      << run.poseBytes << " pose bytes  " << std::setw(8)
+      << run.paletteUsPerCharacter << " us/character palette  "
+      << std::setw(10) << run.paletteBytes << " palette bytes\n";
+  }
+  o << "  Max model matrix difference (legacy vs batched): "
+    << results.maxModelError << "\n";
+  o << "  Max skin palette difference (packed vs glm): "
+    << results.maxPaletteError << "\n";
+}
+
+void AnimationBenchmark::write_json(std::ostream& o,
+                                    const AnimationBenchmarkResults& results) {
+  const auto& p = results.params;
+  o << std::setprecision(6);
+  o << "{\n";
+  o << "  \"character_count\": " << p.characterCount << ",\n";
+  o << "  \"frame_count\": " << p.frameCount << ",\n";
+  o << "  \"frame_seconds\": " << p.frameSeconds << ",\n";
+  o << "  \"joint_count\": " << p.jointCount << ",\n";
+  o << "  \"clip_count\": " << p.clipCount << ",\n";
+  o << "  \"worker_thread_count\": " << p.workerThreadCount << ",\n";
+  o << "  \"share_sample_rate_hz\": " << p.shareSampleRateHz << ",\n";
+  o << "  \"culled_fraction\": " << p.culledFraction << ",\n";
+  o << "  \"seed\": " << p.seed << ",\n";
+  o << "  \"max_model_error\": " << results.maxModelError << ",\n";
+  o << "  \"max_palette_error\": " << results.maxPaletteError << ",\n";
+  o << "  \"runs\": [\n";
+  for (size_t i = 0; i < results.runs.size(); i++) {
+    const auto& run = results.runs[i];
+    o << "    {\"name\": \"" << run.name << "\", \"ms_per_frame\": "
+      << run.msPerFrame << ", \"us_per_character\": " << run.usPerCharacter
+      << ", \"unique_samples_per_frame\": " << run.uniqueSamplesPerFrame
+      << ", \"sampled_characters_per_frame\": "
+      << run.sampledCharactersPerFrame << ", \"pose_bytes\": " << run.poseBytes
+      << ", \"palette_us_per_character\": " << run.paletteUsPerCharacter
+      << ", \"palette_bytes\": " << run.paletteBytes << "}"
+      << (i + 1 < results.runs.size() ? "," : "") << "\n";
+  }
+  o << "  ]\n";
+  o << "}\n";
+}
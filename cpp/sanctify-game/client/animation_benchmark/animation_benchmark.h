@@ -0,0 +1,77 @@
+#ifndef SANCTIFY_GAME_CLIENT_ANIMATION_BENCHMARK_ANIMATION_BENCHMARK_H
+#define SANCTIFY_GAME_CLIENT_ANIMATION_BENCHMARK_ANIMATION_BENCHMARK_H
+
+/**
+ * CPU skeletal animation benchmark - runs the same crowd of animated
+ *  characters through the old one-entity-at-a-time sampling loop and through
+ *  BatchedOzzAnimationSystem in a few configurations, then packs the poses
+ *  into a SkinPalette.
+ *
+ * The skeleton and clips are generated (ybot-sized by default), so no asset
+ *  packs or GPU are needed.
+ */
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sanctify::bench {
+
+struct AnimationBenchmarkParams {
+  uint32_t characterCount;
+  uint32_t frameCount;
+  float frameSeconds;
+  uint32_t jointCount;
+  uint32_t clipCount;
+  uint32_t workerThreadCount;
+  float shareSampleRateHz;
+  float culledFraction;
+  uint32_t seed;
+};
+
+struct AnimationBenchmarkRun {
+  std::string name;
+
+  double msPerFrame;
+  double usPerCharacter;
+
+  // Averaged over measured frames
+  double uniqueSamplesPerFrame;
+  double sampledCharactersPerFrame;
+
+  // Pose memory - per-entity buffers for the old loop, frame arena otherwise
+  uint64_t poseBytes;
+
+  // Packing posed characters' skin matrices into a SkinPalette (batched runs
+  //  only), timed separately from sampling
+  double paletteUsPerCharacter;
+  uint64_t paletteBytes;
+};
+
+struct AnimationBenchmarkResults {
+  AnimationBenchmarkParams params;
+  std::vector<AnimationBenchmarkRun> runs;
+
+  // Largest model matrix difference between the old loop and the unshared
+  //  batched run - should be 0
+  float maxModelError;
+
+  // Largest difference between packed skin matrices and a glm reference
+  //  (model * inverse bind pose) - should be within float rounding
+  float maxPaletteError;
+};
+
+class AnimationBenchmark {
+ public:
+  static AnimationBenchmarkResults Run(AnimationBenchmarkParams params);
+
+  static void write_text(std::ostream& o,
+                         const AnimationBenchmarkResults& results);
+  static void write_json(std::ostream& o,
+                         const AnimationBenchmarkResults& results);
+};
+
+}  // namespace sanctify::bench
+
+#endif
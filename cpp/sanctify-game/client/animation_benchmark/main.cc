@@ -0,0 +1,94 @@
+#include <ecs/systems/batched_animation_system.h>
+#include <igcore/log.h>
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "animation_benchmark.h"
+
+using namespace indigo;
+using namespace core;
+using namespace sanctify;
+using namespace bench;
+
+namespace {
+const char* kLogLabel = "animation-benchmark";
+
+// Enough for the root and one joint per limb, and no more than the old
+//  per-entity buffers could hold
+constexpr uint32_t kMinJointCount = 6u;
+constexpr uint32_t kMaxJointCount = 80u;
+}  // namespace
+
+int main(int argc, char** argv) {
+  CLI::App app{"Sanctify CPU animation sampling benchmark"};
+
+  std::string json_out_path = "";
+  bool json_output = false;
+
+  AnimationBenchmarkParams params{};
+  params.characterCount = 500u;
+  params.frameCount = 600u;
+  params.frameSeconds = 1.f / 60.f;
+  params.jointCount = 65u;
+  params.clipCount = 2u;
+  params.workerThreadCount =
+      ecs::BatchedOzzAnimationSystem::DefaultParams().workerThreadCount;
+  params.shareSampleRateHz = 60.f;
+  params.culledFraction = 0.5f;
+  params.seed = 1337u;
+
+  app.add_option("-c,--characters", params.characterCount,
+                 "Animated character count");
+  app.add_option("-n,--frames", params.frameCount, "Measured frame count");
+  app.add_option("--frame_seconds", params.frameSeconds,
+                 "Animation time advanced per frame");
+  app.add_option("--joints", params.jointCount,
+                 "Joints in the generated skeleton (6-80, ybot has 65)");
+  app.add_option("--clips", params.clipCount,
+                 "Distinct clips played by the crowd");
+  app.add_option("-j,--workers", params.workerThreadCount,
+                 "Worker threads used by the parallel runs, in addition to "
+                 "the calling thread");
+  app.add_option("--share_hz", params.shareSampleRateHz,
+                 "Time quantization used to share samples between characters");
+  app.add_option("--culled_fraction", params.culledFraction,
+                 "Fraction of characters tagged as culled in the culled run");
+  app.add_option("--seed", params.seed, "Clip/start time RNG seed");
+  app.add_flag("--json", json_output, "Write results as JSON to stdout");
+  app.add_option("--json_out", json_out_path,
+                 "Write JSON results to this file (in addition to stdout)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  params.jointCount =
+      std::clamp(params.jointCount, kMinJointCount, kMaxJointCount);
+  params.clipCount = std::max(params.clipCount, 1u);
+  params.frameCount = std::max(params.frameCount, 1u);
+  params.characterCount = std::max(params.characterCount, 1u);
+
+  auto results = AnimationBenchmark::Run(params);
+  if (results.runs.empty()) {
+    Logger::err(kLogLabel) << "Failed to build benchmark skeleton/clips";
+    return -1;
+  }
+
+  if (json_output) {
+    AnimationBenchmark::write_json(std::cout, results);
+  } else {
+    AnimationBenchmark::write_text(std::cout, results);
+  }
+
+  if (json_out_path != "") {
+    std::ofstream fout(json_out_path);
+    if (!fout) {
+      Logger::err(kLogLabel) << "Could not open " << json_out_path;
+      return -1;
+    }
+    AnimationBenchmark::write_json(fout, results);
+  }
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include <igcore/log.h>
+#include <net/reconcile_net_state_system.h>
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "netsync_benchmark.h"
+
+using namespace indigo;
+using namespace core;
+using namespace sanctify;
+using namespace bench;
+
+namespace {
+const char* kLogLabel = "netsync-benchmark";
+}  // namespace
+
+int main(int argc, char** argv) {
+  CLI::App app{"Sanctify client netsync benchmark"};
+
+  std::string json_out_path = "";
+  bool json_output = false;
+
+  NetsyncBenchmarkParams params{};
+  params.entityCounts = {1000u, 5000u, 10000u};
+  params.seconds = 10.f;
+  params.tickHz = 60.f;
+  params.snapshotHz = 20.f;
+  params.latencySeconds = 0.05f;
+  params.interpolationDelaySeconds =
+      ReconcileNetStateSystem::kDefaultInterpolationDelaySeconds;
+  params.churnPerSecond = 0.01f;
+  params.seed = 1337u;
+
+  app.add_option("-e,--entities", params.entityCounts,
+                 "Server entity counts to run (one player each)");
+  app.add_option("-s,--seconds", params.seconds, "Simulated seconds per run");
+  app.add_option("--tick_hz", params.tickHz,
+                 "Server tick and client frame rate");
+  app.add_option("--snapshot_hz", params.snapshotHz,
+                 "Rate snapshots are sent to the client");
+  app.add_option("--latency", params.latencySeconds,
+                 "Seconds between a snapshot being taken and received");
+  app.add_option("--delay", params.interpolationDelaySeconds,
+                 "Interpolation delay for remote entities");
+  app.add_option("--churn", params.churnPerSecond,
+                 "Fraction of entities replaced every second");
+  app.add_option("--seed", params.seed, "Entity placement/path RNG seed");
+  app.add_flag("--json", json_output, "Write results as JSON to stdout");
+  app.add_option("--json_out", json_out_path,
+                 "Write JSON results to this file (in addition to stdout)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  params.tickHz = std::max(params.tickHz, 1.f);
+  params.snapshotHz = std::clamp(params.snapshotHz, 1.f, params.tickHz);
+  params.seconds = std::max(params.seconds, 1.f / params.tickHz);
+
+  auto results = NetsyncBenchmark::Run(params);
+
+  if (json_output) {
+    NetsyncBenchmark::write_json(std::cout, results);
+  } else {
+    NetsyncBenchmark::write_text(std::cout, results);
+  }
+
+  if (json_out_path != "") {
+    std::ofstream fout(json_out_path);
+    if (!fout) {
+      Logger::err(kLogLabel) << "Could not open " << json_out_path;
+      return -1;
+    }
+    NetsyncBenchmark::write_json(fout, results);
+  }
+
+  return 0;
+}
@@ -0,0 +1,527 @@
+#include "netsync_benchmark.h"
+
+#include <igcore/bimap.h>
+#include <igcore/maybe.h>
+#include <net/reconcile_net_state_system.h>
+#include <sanctify-game-common/gameplay/locomotion.h>
+#include <sanctify-game-common/gameplay/locomotion_components.h>
+#include <sanctify-game-common/gameplay/net_sync_components.h>
+#include <sanctify-game-common/gameplay/player_definition_components.h>
+#include <sanctify-game-common/net/entt_snapshot_translator.h>
+#include <sanctify-game-common/net/game_snapshot.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <iomanip>
+#include <random>
+#include <unordered_map>
+
+using namespace sanctify;
+using namespace bench;
+using namespace indigo;
+using namespace core;
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr float kArenaHalfSize = 60.f;
+constexpr uint32_t kWaypointsPerPath = 3u;
+constexpr float kMinMovementSpeed = 2.f;
+constexpr float kMaxMovementSpeed = 6.f;
+
+// Same step the client uses (GameScene::advance_simulation)
+constexpr float kMaxFrameTime = 1.f / 60.f;
+
+// Server positions are kept for this many ticks, for the error measurements
+constexpr uint32_t kHistoryTicks = 64u;
+
+double seconds_since(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void simulate(system::LocomotionSystem& locomotion, entt::registry& world,
+              float dt) {
+  while (dt > kMaxFrameTime) {
+    locomotion.apply_standard_locomotion(world, kMaxFrameTime);
+    dt -= kMaxFrameTime;
+  }
+  locomotion.apply_standard_locomotion(world, dt);
+}
+
+//
+// Server
+//
+struct ServerWorld {
+  entt::registry world;
+  system::LocomotionSystem locomotion;
+
+  // [0] is the player
+  std::vector<entt::entity> entities;
+  uint32_t nextNetSyncId;
+  uint32_t nextSnapshotId;
+  std::mt19937 rng;
+};
+
+glm::vec2 random_point(std::mt19937& rng) {
+  std::uniform_real_distribution<float> dist(-kArenaHalfSize, kArenaHalfSize);
+  float x = dist(rng);
+  float z = dist(rng);
+  return glm::vec2(x, z);
+}
+
+void give_new_path(entt::registry& world, entt::entity e,
+                   std::mt19937& rng) {
+  component::NavWaypointList waypoints{};
+  for (uint32_t i = 0; i < kWaypointsPerPath; i++) {
+    waypoints.Targets.push_back(::random_point(rng));
+  }
+  world.emplace_or_replace<component::NavWaypointList>(e,
+                                                       std::move(waypoints));
+}
+
+entt::entity spawn(ServerWorld& server, bool is_player) {
+  std::uniform_real_distribution<float> speed_dist(kMinMovementSpeed,
+                                                   kMaxMovementSpeed);
+
+  entt::entity e = server.world.create();
+  server.world.emplace<component::NetSyncId>(e, server.nextNetSyncId++);
+  server.locomotion.attach_basic_locomotion_components(
+      server.world, e, ::random_point(server.rng), speed_dist(server.rng));
+  ::give_new_path(server.world, e, server.rng);
+  if (is_player) {
+    server.world.emplace<component::BasicPlayerComponent>(e);
+  }
+
+  return e;
+}
+
+void tick_server(ServerWorld& server, float dt) {
+  ::simulate(server.locomotion, server.world, dt);
+
+  // Anything that finished its path wanders somewhere else
+  std::vector<entt::entity> idle;
+  auto view = server.world.view<const component::MapLocation>(
+      entt::exclude<component::NavWaypointList>);
+  for (auto e : view) {
+    idle.push_back(e);
+  }
+  for (auto e : idle) {
+    ::give_new_path(server.world, e, server.rng);
+  }
+}
+
+void churn(ServerWorld& server, uint32_t count) {
+  if (server.entities.size() < 2u) {
+    return;
+  }
+
+  std::uniform_int_distribution<size_t> idx_dist(1u,
+                                                 server.entities.size() - 1u);
+  for (uint32_t i = 0; i < count; i++) {
+    size_t idx = idx_dist(server.rng);
+    server.world.destroy(server.entities[idx]);
+    server.entities[idx] = ::spawn(server, false);
+  }
+}
+
+// Same as the PvE game server (send_client_messages_system.cc)
+GameSnapshot gen_snapshot(entt::registry& world, float sim_time,
+                          uint32_t snapshot_id) {
+  GameSnapshot snapshot{};
+  snapshot.snapshot_time(sim_time);
+  snapshot.snapshot_id(snapshot_id);
+
+  auto view = world.view<const component::NetSyncId>();
+  for (auto [entity, net_sync] : view.each()) {
+    component::MapLocation* map_location =
+        world.try_get<component::MapLocation>(entity);
+    component::NavWaypointList* nav_waypoint =
+        world.try_get<component::NavWaypointList>(entity);
+    component::StandardNavigationParams* nav_params =
+        world.try_get<component::StandardNavigationParams>(entity);
+    bool has_basic_player =
+        world.all_of<component::BasicPlayerComponent>(entity);
+    component::OrientationComponent* orientation =
+        world.try_get<component::OrientationComponent>(entity);
+
+    snapshot.add(net_sync.Id, maybe_from_nullable_ptr(map_location));
+    snapshot.add(net_sync.Id, maybe_from_nullable_ptr(nav_waypoint));
+    snapshot.add(net_sync.Id, maybe_from_nullable_ptr(nav_params));
+    snapshot.add(net_sync.Id, maybe_from_nullable_ptr(orientation));
+
+    if (has_basic_player) {
+      snapshot.add(net_sync.Id, component::BasicPlayerComponent{});
+    }
+  }
+
+  return snapshot;
+}
+
+typedef std::unordered_map<uint32_t, glm::vec2> PositionHistoryEntry;
+
+void record_positions(entt::registry& world, PositionHistoryEntry& o) {
+  o.clear();
+  auto view =
+      world.view<const component::NetSyncId, const component::MapLocation>();
+  for (auto [e, net_sync, map_location] : view.each()) {
+    o.emplace(net_sync.Id, map_location.XZ);
+  }
+}
+
+//
+// Client
+//
+
+template <typename T>
+void maybe_upsert(entt::entity entity, entt::registry& world,
+                  Maybe<T> component) {
+  if (component.has_value()) {
+    auto& c = world.emplace_or_replace<T>(entity);
+    c = component.move();
+  }
+}
+
+// The client netsync path before the interpolation buffer - every snapshot
+//  rebuilds and re-simulates the whole world, and the whole client world is
+//  read back and diffed against it
+class LegacyReconciler {
+ public:
+  void reconcile(entt::registry& client_world, float client_sim_time,
+                 const GameSnapshot& server_snapshot) {
+    translator_.write_fresh_game_state(server_state_, server_snapshot);
+    ::simulate(locomotion_, server_state_,
+               client_sim_time - server_snapshot.snapshot_time());
+
+    GameSnapshot current_server_snapshot =
+        translator_.read_all_game_state(server_state_, 0, client_sim_time)
+            .gameSnapshot;
+    auto current_client_state =
+        translator_.read_all_game_state(client_world, 0, client_sim_time);
+
+    GameSnapshotDiff diff = GameSnapshot::CreateDiff(
+        current_client_state.gameSnapshot, current_server_snapshot);
+    auto& entity_bimap = current_client_state.entityBimap;
+
+    PodVector<uint32_t> deleted_entities = diff.deleted_entities();
+    for (int i = 0; i < deleted_entities.size(); i++) {
+      auto it = entity_bimap.find_l(deleted_entities[i]);
+      if (it != entity_bimap.end()) {
+        client_world.destroy(*it);
+      }
+    }
+
+    PodVector<uint32_t> upserted_entities = diff.upserted_entities();
+    for (int i = 0; i < upserted_entities.size(); i++) {
+      uint32_t id = upserted_entities[i];
+
+      entt::entity e = entt::null;
+      auto it = entity_bimap.find_l(id);
+      if (it == entity_bimap.end()) {
+        e = client_world.create();
+        client_world.emplace<component::NetSyncId>(e, id);
+        entity_bimap.insert(id, e);
+      } else {
+        e = *it;
+      }
+
+      PodVector<GameSnapshotDiff::ComponentType> deleted_components =
+          diff.deleted_components(id);
+      for (int j = 0; j < deleted_components.size(); j++) {
+        switch (deleted_components[j]) {
+          case GameSnapshotDiff::ComponentType::MapLocation:
+            client_world.remove<component::MapLocation>(e);
+            break;
+          case GameSnapshotDiff::ComponentType::NavWaypointList:
+            client_world.remove<component::NavWaypointList>(e);
+            break;
+          case GameSnapshotDiff::ComponentType::StandardNavigationParams:
+            client_world.remove<component::StandardNavigationParams>(e);
+            break;
+          case GameSnapshotDiff::ComponentType::BasicPlayerComponent:
+            client_world.remove<component::BasicPlayerComponent>(e);
+            break;
+          case GameSnapshotDiff::ComponentType::Orientation:
+            client_world.remove<component::OrientationComponent>(e);
+            break;
+          default:
+            break;
+        }
+      }
+
+      ::maybe_upsert(e, client_world, diff.nav_waypoint_list(id));
+      ::maybe_upsert(e, client_world, diff.standard_navigation_params(id));
+      if (diff.basic_player_component(id).has_value()) {
+        client_world.emplace_or_replace<component::BasicPlayerComponent>(e);
+      }
+      ::maybe_upsert(e, client_world, diff.map_location(id));
+      ::maybe_upsert(e, client_world, diff.orientation(id));
+    }
+  }
+
+ private:
+  entt::registry server_state_;
+  system::LocomotionSystem locomotion_;
+  EnttSnapshotTranslator translator_;
+};
+
+struct RunTotals {
+  double registerSeconds = 0.;
+  double netsyncSeconds = 0.;
+  double simulateSeconds = 0.;
+
+  double errorSum = 0.;
+  float maxError = 0.f;
+  uint64_t errorCount = 0u;
+};
+
+// Predicted entities are compared against "predicted_positions", everything
+//  else against "remote_positions" (null if that time is not in the history)
+void accumulate_error(entt::registry& client_world,
+                      const PositionHistoryEntry& predicted_positions,
+                      const PositionHistoryEntry* remote_positions,
+                      bool predict_all, RunTotals& totals) {
+  auto view = client_world.view<const component::NetSyncId,
+                                const component::MapLocation>();
+  for (auto [e, net_sync, map_location] : view.each()) {
+    bool is_predicted =
+        predict_all ||
+        client_world.all_of<component::BasicPlayerComponent>(e);
+    const PositionHistoryEntry* positions =
+        is_predicted ? &predicted_positions : remote_positions;
+    if (positions == nullptr) {
+      continue;
+    }
+
+    auto it = positions->find(net_sync.Id);
+    if (it == positions->end()) {
+      continue;
+    }
+
+    float error = glm::length(it->second - map_location.XZ);
+    totals.errorSum += error;
+    totals.maxError = std::max(totals.maxError, error);
+    totals.errorCount++;
+  }
+}
+
+NetsyncBenchmarkRun to_run(const char* name, uint32_t entity_count,
+                           const RunTotals& totals, uint32_t snapshot_count,
+                           uint32_t frame_count, entt::registry& client_world,
+                           uint32_t snapshot_entity_count) {
+  NetsyncBenchmarkRun run{};
+  run.name = name;
+  run.entityCount = entity_count;
+
+  const double snapshots = std::max(snapshot_count, 1u);
+  const double frames = std::max(frame_count, 1u);
+  run.usPerSnapshot =
+      (totals.registerSeconds + totals.netsyncSeconds) * 1000000. / snapshots;
+  run.registerUsPerSnapshot = totals.registerSeconds * 1000000. / snapshots;
+  run.netsyncUsPerFrame = totals.netsyncSeconds * 1000000. / frames;
+  run.simulateUsPerFrame = totals.simulateSeconds * 1000000. / frames;
+
+  run.maxPositionError = totals.maxError;
+  run.meanPositionError =
+      totals.errorCount > 0u
+          ? static_cast<float>(totals.errorSum / totals.errorCount)
+          : 0.f;
+
+  run.clientEntityCount = static_cast<uint32_t>(
+      client_world.view<const component::NetSyncId>().size());
+  run.snapshotEntityCount = snapshot_entity_count;
+
+  return run;
+}
+
+void run_entity_count(const NetsyncBenchmarkParams& params,
+                      uint32_t entity_count,
+                      std::vector<NetsyncBenchmarkRun>& o_runs) {
+  const float dt = 1.f / params.tickHz;
+  const uint32_t tick_count =
+      static_cast<uint32_t>(std::lround(params.seconds * params.tickHz));
+  const uint32_t ticks_per_snapshot =
+      std::max(1u, static_cast<uint32_t>(
+                       std::lround(params.tickHz / params.snapshotHz)));
+  const uint32_t latency_ticks =
+      static_cast<uint32_t>(std::lround(params.latencySeconds * params.tickHz));
+  const uint32_t delay_ticks = std::min(
+      kHistoryTicks - 1u,
+      static_cast<uint32_t>(
+          std::lround(params.interpolationDelaySeconds * params.tickHz)));
+  const float churn_per_snapshot = entity_count * params.churnPerSecond /
+                                   params.tickHz * ticks_per_snapshot;
+
+  ServerWorld server{};
+  server.nextNetSyncId = 1u;
+  server.nextSnapshotId = 1u;
+  server.rng.seed(params.seed);
+  server.entities.push_back(::spawn(server, true));
+  for (uint32_t i = 1; i < entity_count; i++) {
+    server.entities.push_back(::spawn(server, false));
+  }
+
+  std::vector<PositionHistoryEntry> history(kHistoryTicks);
+  std::deque<std::pair<uint32_t, GameSnapshot>> in_flight;
+  float churn_accumulator = 0.f;
+
+  entt::registry legacy_world;
+  LegacyReconciler legacy;
+  system::LocomotionSystem legacy_locomotion;
+  RunTotals legacy_totals{};
+
+  entt::registry interpolated_world;
+  ReconcileNetStateSystem interpolated(params.interpolationDelaySeconds);
+  system::LocomotionSystem interpolated_locomotion;
+  RunTotals interpolated_totals{};
+  auto interpolated_cb = [&interpolated_locomotion](entt::registry& world,
+                                                    float dt) {
+    ::simulate(interpolated_locomotion, world, dt);
+  };
+
+  uint32_t snapshot_count = 0u;
+  uint32_t snapshot_entity_count = 0u;
+
+  for (uint32_t tick = 1; tick <= tick_count; tick++) {
+    const float t = tick * dt;
+
+    //
+    // Server
+    //
+    ::tick_server(server, dt);
+    if (tick % ticks_per_snapshot == 0u) {
+      churn_accumulator += churn_per_snapshot;
+      uint32_t churn_count = static_cast<uint32_t>(churn_accumulator);
+      churn_accumulator -= churn_count;
+      ::churn(server, churn_count);
+
+      in_flight.emplace_back(
+          tick + latency_ticks,
+          ::gen_snapshot(server.world, t, server.nextSnapshotId++));
+    }
+    ::record_positions(server.world, history[tick % kHistoryTicks]);
+
+    //
+    // Clients - local simulation, then netsync up to the client time
+    //
+    auto start = Clock::now();
+    ::simulate(legacy_locomotion, legacy_world, dt);
+    legacy_totals.simulateSeconds += ::seconds_since(start);
+
+    start = Clock::now();
+    ::simulate(interpolated_locomotion, interpolated_world, dt);
+    interpolated_totals.simulateSeconds += ::seconds_since(start);
+
+    while (!in_flight.empty() && in_flight.front().first <= tick) {
+      const GameSnapshot& snapshot = in_flight.front().second;
+
+      start = Clock::now();
+      legacy.reconcile(legacy_world, t, snapshot);
+      legacy_totals.netsyncSeconds += ::seconds_since(start);
+
+      start = Clock::now();
+      interpolated.register_server_snapshot(snapshot, t);
+      interpolated_totals.registerSeconds += ::seconds_since(start);
+
+      snapshot_entity_count =
+          static_cast<uint32_t>(snapshot.alive_entities().size());
+      snapshot_count++;
+      in_flight.pop_front();
+    }
+
+    start = Clock::now();
+    interpolated.advance_time_to_and_maybe_reconcile(interpolated_world,
+                                                     interpolated_cb, t);
+    interpolated_totals.netsyncSeconds += ::seconds_since(start);
+
+    //
+    // Errors (untimed)
+    //
+    const PositionHistoryEntry& now = history[tick % kHistoryTicks];
+    const PositionHistoryEntry* interpolation_time =
+        tick > delay_ticks
+            ? &history[(tick - delay_ticks) % kHistoryTicks]
+            : nullptr;
+    ::accumulate_error(legacy_world, now, nullptr, true, legacy_totals);
+    ::accumulate_error(interpolated_world, now, interpolation_time, false,
+                       interpolated_totals);
+  }
+
+  o_runs.push_back(::to_run("legacy_full_resimulation", entity_count,
+                            legacy_totals, snapshot_count, tick_count,
+                            legacy_world, snapshot_entity_count));
+  o_runs.push_back(::to_run("interpolated", entity_count, interpolated_totals,
+                            snapshot_count, tick_count, interpolated_world,
+                            snapshot_entity_count));
+}
+
+}  // namespace
+
+NetsyncBenchmarkResults NetsyncBenchmark::Run(NetsyncBenchmarkParams params) {
+  NetsyncBenchmarkResults results{};
+  results.params = params;
+
+  for (uint32_t entity_count : params.entityCounts) {
+    ::run_entity_count(params, std::max(entity_count, 1u), results.runs);
+  }
+
+  return results;
+}
+
+void NetsyncBenchmark::write_text(std::ostream& o,
+                                  const NetsyncBenchmarkResults& results) {
+  const auto& p = results.params;
+  o << "Client netsync: " << p.seconds << "s at " << p.tickHz << "Hz, "
+    << p.snapshotHz << "Hz snapshots, " << p.latencySeconds * 1000.f
+    << "ms latency, " << p.interpolationDelaySeconds * 1000.f
+    << "ms interpolation delay, " << p.churnPerSecond * 100.f
+    << "% churn/s\n";
+  o << std::fixed << std::setprecision(3);
+  for (const auto& run : results.runs) {
+    o << "  " << std::left << std::setw(26) << run.name << std::right
+      << std::setw(6) << run.entityCount << " entities  " << std::setw(11)
+      << run.usPerSnapshot << " us/snapshot  " << std::setw(10)
+      << run.registerUsPerSnapshot << " us/snapshot register  "
+      << std::setw(10) << run.netsyncUsPerFrame << " us/frame netsync  "
+      << std::setw(10) << run.simulateUsPerFrame << " us/frame simulate  "
+      << std::setw(8) << run.maxPositionError << " max error  "
+      << std::setw(8) << run.meanPositionError << " mean error  "
+      << run.clientEntityCount << "/" << run.snapshotEntityCount
+      << " entities\n";
+  }
+}
+
+void NetsyncBenchmark::write_json(std::ostream& o,
+                                  const NetsyncBenchmarkResults& results) {
+  const auto& p = results.params;
+  o << std::setprecision(6);
+  o << "{\n";
+  o << "  \"seconds\": " << p.seconds << ",\n";
+  o << "  \"tick_hz\": " << p.tickHz << ",\n";
+  o << "  \"snapshot_hz\": " << p.snapshotHz << ",\n";
+  o << "  \"latency_seconds\": " << p.latencySeconds << ",\n";
+  o << "  \"interpolation_delay_seconds\": " << p.interpolationDelaySeconds
+    << ",\n";
+  o << "  \"churn_per_second\": " << p.churnPerSecond << ",\n";
+  o << "  \"seed\": " << p.seed << ",\n";
+  o << "  \"runs\": [\n";
+  for (size_t i = 0; i < results.runs.size(); i++) {
+    const auto& run = results.runs[i];
+    o << "    {\"name\": \"" << run.name
+      << "\", \"entity_count\": " << run.entityCount
+      << ", \"us_per_snapshot\": " << run.usPerSnapshot
+      << ", \"register_us_per_snapshot\": " << run.registerUsPerSnapshot
+      << ", \"netsync_us_per_frame\": " << run.netsyncUsPerFrame
+      << ", \"simulate_us_per_frame\": " << run.simulateUsPerFrame
+      << ", \"max_position_error\": " << run.maxPositionError
+      << ", \"mean_position_error\": " << run.meanPositionError
+      << ", \"client_entity_count\": " << run.clientEntityCount
+      << ", \"snapshot_entity_count\": " << run.snapshotEntityCount << "}"
+      << (i + 1 < results.runs.size() ? "," : "") << "\n";
+  }
+  o << "  ]\n";
+  o << "}\n";
+}
@@ -0,0 +1,82 @@
+#ifndef SANCTIFY_GAME_CLIENT_NETSYNC_BENCHMARK_NETSYNC_BENCHMARK_H
+#define SANCTIFY_GAME_CLIENT_NETSYNC_BENCHMARK_NETSYNC_BENCHMARK_H
+
+/**
+ * Client netsync benchmark - runs a server world of wandering entities, sends
+ *  the client a full snapshot at the server snapshot rate (with a fixed
+ *  latency), and measures the client CPU spent turning those snapshots into
+ *  client world state two ways:
+ *
+ * - legacy: every snapshot rebuilds the whole server world, re-simulates it
+ *   up to the client time, and diffs it against the whole client world
+ * - interpolated: ReconcileNetStateSystem - only predicted entities are
+ *   re-simulated, everything else is written to a SnapshotInterpolationBuffer
+ *   and sampled every frame
+ *
+ * No assets, GPU or network are needed.
+ */
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace sanctify::bench {
+
+struct NetsyncBenchmarkParams {
+  std::vector<uint32_t> entityCounts;
+  float seconds;
+  float tickHz;
+  float snapshotHz;
+  float latencySeconds;
+  float interpolationDelaySeconds;
+
+  // Fraction of entities despawned (and replaced) per second
+  float churnPerSecond;
+  uint32_t seed;
+};
+
+struct NetsyncBenchmarkRun {
+  std::string name;
+  uint32_t entityCount;
+
+  // Client CPU per received snapshot - everything the netsync code did
+  //  between two snapshots (registration, reconciliation and per-frame
+  //  interpolation), divided by the number of snapshots
+  double usPerSnapshot;
+  double registerUsPerSnapshot;
+  double netsyncUsPerFrame;
+
+  // Local client simulation (locomotion) per frame - remote entities are not
+  //  simulated on the client in the interpolated run
+  double simulateUsPerFrame;
+
+  // Distance between each client entity and the server entity at the time
+  //  the client means to show it (the client time when predicted, the
+  //  interpolation time otherwise)
+  float maxPositionError;
+  float meanPositionError;
+
+  // At the end of the run - should match
+  uint32_t clientEntityCount;
+  uint32_t snapshotEntityCount;
+};
+
+struct NetsyncBenchmarkResults {
+  NetsyncBenchmarkParams params;
+  std::vector<NetsyncBenchmarkRun> runs;
+};
+
+class NetsyncBenchmark {
+ public:
+  static NetsyncBenchmarkResults Run(NetsyncBenchmarkParams params);
+
+  static void write_text(std::ostream& o,
+                         const NetsyncBenchmarkResults& results);
+  static void write_json(std::ostream& o,
+                         const NetsyncBenchmarkResults& results);
+};
+
+}  // namespace sanctify::bench
+
+#endif
@@ -15,6 +15,7 @@
 
 #include <GLFW/glfw3.h>
 #include <igcore/either.h>
+#include <iggpu/render_pipeline_cache.h>
 #include <webgpu/webgpu_cpp.h>
 
 #include <memory>
@@ -60,7 +61,8 @@ struct AppBase {
         Queue(queue),
         SwapChain(swap_chain),
         Width(width),
-        Height(height) {}
+        Height(height),
+        PipelineCache(std::make_shared<indigo::iggpu::RenderPipelineCache>()) {}
 
   ~AppBase();
 
@@ -79,6 +81,9 @@ struct AppBase {
   wgpu::SwapChain SwapChain;
   uint32_t Width;
   uint32_t Height;
+
+  // Shared by every scene created against this device
+  std::shared_ptr<indigo::iggpu::RenderPipelineCache> PipelineCache;
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef SANCTIFY_GAME_CLIENT_SRC_ECS_COMPONENTS_DEBUG_GEO_RENDER_COMPONENTS_H
 #define SANCTIFY_GAME_CLIENT_SRC_ECS_COMPONENTS_DEBUG_GEO_RENDER_COMPONENTS_H
 
+#include <common/render/debug_draw/debug_draw_list.h>
+#include <render/debug_geo/debug_draw_pipeline.h>
 #include <render/debug_geo/debug_geo.h>
 #include <render/debug_geo/debug_geo_pipeline.h>
 #include <util/resource_registry.h>
@@ -38,6 +40,26 @@ struct DebugGeoRenderable {
   glm::vec3 objectColor;
 };
 
+/** Immediate mode debug draw pipeline builder + pipeline (see above) */
+struct CtxDebugDrawPipelineBuilder {
+  debug_geo::DebugDrawPipelineBuilder pipelineBuilder;
+};
+
+struct CtxDebugDrawPipeline {
+  debug_geo::DebugDrawPipeline pipeline;
+  wgpu::TextureFormat swapChainFormat;
+};
+
+/**
+ * Immediate mode debug primitives - anything can record into the draw list
+ *  (from any thread) during a frame, it is uploaded, drawn and cleared when the
+ *  frame is rendered.
+ */
+struct CtxDebugDraw {
+  std::shared_ptr<render::DebugDrawList> drawList;
+  debug_geo::DebugDrawBuffers buffers;
+};
+
 }  // namespace sanctify::ecs
 
 #endif
@@ -0,0 +1,80 @@
+#ifndef SANCTIFY_GAME_CLIENT_SRC_ECS_COMPONENTS_OZZ_ANIMATION_COMPONENTS_H
+#define SANCTIFY_GAME_CLIENT_SRC_ECS_COMPONENTS_OZZ_ANIMATION_COMPONENTS_H
+
+#include <ozz/animation/runtime/animation.h>
+#include <ozz/animation/runtime/skeleton.h>
+#include <ozz/base/maths/simd_math.h>
+#include <util/resource_registry.h>
+
+#include <cstdint>
+
+/**
+ * CPU-side skeletal animation components - no GPU types in here, so that
+ *  animation sampling can be built and benchmarked without a device.
+ *
+ * See solid_animated_components.h for how these relate to renderables.
+ */
+
+namespace sanctify::ecs {
+
+struct OzzAnimationStateComponent {
+  ReadonlyResourceRegistry<ozz::animation::Skeleton>::Key skeletonKey;
+  ReadonlyResourceRegistry<ozz::animation::Animation>::Key animationKey;
+
+  float animationTime;
+  float animationTimeRatio;
+};
+
+struct OzzAnimationLayer {
+  ReadonlyResourceRegistry<ozz::animation::Animation>::Key animationKey;
+
+  float animationTime;
+  float animationTimeRatio;
+
+  // Crossfades move weight towards targetWeight by weightRate per second
+  float weight;
+  float targetWeight;
+  float weightRate;
+};
+
+/**
+ * Weighted blend of up to kMaxLayers clips on one skeleton - an alternative to
+ *  OzzAnimationStateComponent for entities that need blending or crossfades.
+ *
+ * Drive with OzzAnimationBlendUtil. Layers with zero weight are not sampled,
+ *  and a blend with only one weighted layer costs the same as a single clip.
+ */
+struct OzzAnimationBlendComponent {
+  static constexpr uint32_t kMaxLayers = 4u;
+
+  explicit OzzAnimationBlendComponent(
+      ReadonlyResourceRegistry<ozz::animation::Skeleton>::Key skeleton_key)
+      : skeletonKey(skeleton_key), layers{}, layerCount(0u) {}
+
+  ReadonlyResourceRegistry<ozz::animation::Skeleton>::Key skeletonKey;
+  OzzAnimationLayer layers[kMaxLayers];
+  uint32_t layerCount;
+};
+
+/**
+ * Model space joint transforms for this frame (generated by
+ *  BatchedOzzAnimationSystem).
+ *
+ * Points into the animation system's frame arena, and may be shared with other
+ *  entities playing the same clip at the same time - read only, and only valid
+ *  until the next animation update.
+ */
+struct OzzAnimationPoseComponent {
+  const ozz::math::Float4x4* models;
+  uint32_t numJoints;
+};
+
+/**
+ * Tag for animated entities that are not visible this frame - they keep their
+ *  animation state, but are not sampled and have no pose.
+ */
+struct OzzAnimationCulledTag {};
+
+}  // namespace sanctify::ecs
+
+#endif
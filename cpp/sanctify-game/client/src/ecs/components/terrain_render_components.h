@@ -1,6 +1,7 @@
 #ifndef SANCTIFY_GAME_CLIENT_SRC_ECS_COMPONENTS_TERRAIN_RENDER_COMPONENTS_H
 #define SANCTIFY_GAME_CLIENT_SRC_ECS_COMPONENTS_TERRAIN_RENDER_COMPONENTS_H
 
+#include <common/picking/triangle_bvh.h>
 #include <igasset/igpack_loader.h>
 #include <igcore/vector.h>
 #include <render/terrain/terrain_geo.h>
@@ -35,6 +36,11 @@ struct CtxTerrainRenderableResources {
   ReadonlyResourceRegistry<terrain_pipeline::MaterialPipelineInputs>
       materialRegistry;
   terrain_pipeline::TerrainInstanceBufferStore instanceBufferStore;
+
+  // Picking BVHs of loaded terrain geo (by geoRegistry raw key), built from
+  //  the same vertex data as the GPU buffers
+  std::unordered_map<uint32_t, std::shared_ptr<const picking::TriangleBvh>>
+      pickBvhs;
 };
 
 /**
@@ -47,6 +53,7 @@ struct CtxTerrainRenderableResources {
 struct CtxTerrainPipeline {
   terrain_pipeline::TerrainPipelineBuilder pipelineBuilder;
   indigo::core::Maybe<terrain_pipeline::TerrainPipeline> pipeline;
+  std::shared_ptr<indigo::iggpu::RenderPipelineCache> pipelineCache;
 };
 
 }  // namespace sanctify::ecs
@@ -0,0 +1,416 @@
+#include <ecs/systems/batched_animation_system.h>
+#include <igcore/log.h>
+#include <ozz/animation/runtime/blending_job.h>
+#include <ozz/animation/runtime/local_to_model_job.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <thread>
+
+using namespace sanctify;
+using namespace ecs;
+using namespace indigo;
+
+namespace {
+const char* kLogLabel = "BatchedOzzAnimationSystem";
+
+// Layers at or below this weight contribute nothing visible - skip sampling
+const float kMinLayerWeight = 0.001f;
+}
+
+BatchedOzzAnimationParams BatchedOzzAnimationSystem::DefaultParams() {
+  BatchedOzzAnimationParams params{};
+  params.shareSampleRateHz = 60.f;
+  params.samplesPerChunk = 16u;
+  params.workerThreadCount =
+      std::min(4u, std::thread::hardware_concurrency() / 2u);
+  return params;
+}
+
+BatchedOzzAnimationSystem::BatchedOzzAnimationSystem(
+    std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Skeleton>>
+        skeleton_registry,
+    std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Animation>>
+        animation_registry,
+    BatchedOzzAnimationParams params)
+    : skeleton_registry_(skeleton_registry),
+      animation_registry_(animation_registry),
+      params_(params),
+      samples_(64),
+      sample_order_(64),
+      poses_(64),
+      entity_poses_(64),
+      locals_size_(0u),
+      models_size_(0u),
+      locals_arena_(64),
+      models_arena_(256),
+      failed_samples_(0u),
+      chunk_task_list_(std::make_shared<core::TaskList>()),
+      last_update_stats_{} {
+  if (params_.samplesPerChunk == 0u) {
+    params_.samplesPerChunk = 1u;
+  }
+
+#ifdef IG_ENABLE_THREADS
+  for (uint32_t i = 0; i < params_.workerThreadCount; i++) {
+    auto executor = std::make_shared<core::ExecutorThread>();
+    executor->add_task_list(chunk_task_list_);
+    worker_threads_.push_back(executor);
+  }
+#endif
+}
+
+BatchedOzzAnimationSystem::~BatchedOzzAnimationSystem() {
+#ifdef IG_ENABLE_THREADS
+  for (int i = 0; i < worker_threads_.size(); i++) {
+    worker_threads_[i]->clear_all_task_lists();
+  }
+#endif
+}
+
+void BatchedOzzAnimationSystem::update(entt::registry& world) {
+  BatchedOzzAnimationStats stats{};
+
+  sample_lookup_.clear();
+  samples_.resize(0);
+  sample_order_.resize(0);
+  poses_.resize(0);
+  entity_poses_.resize(0);
+  locals_size_ = 0u;
+  models_size_ = 0u;
+
+  // Last frame's poses point into the arena that is about to be rewritten
+  world.clear<OzzAnimationPoseComponent>();
+
+  auto culled_view = world.view<const OzzAnimationStateComponent,
+                                const OzzAnimationCulledTag>();
+  auto culled_blend_view = world.view<const OzzAnimationBlendComponent,
+                                      const OzzAnimationCulledTag>();
+  stats.culledEntities = static_cast<uint32_t>(
+      std::distance(culled_view.begin(), culled_view.end()) +
+      std::distance(culled_blend_view.begin(), culled_blend_view.end()));
+
+  //
+  // Gather unique samples and poses
+  //
+  auto view = world.view<OzzAnimationStateComponent>(
+      entt::exclude<OzzAnimationCulledTag>);
+  for (auto [e, state] : view.each()) {
+    const auto* skeleton = skeleton_registry_->get(state.skeletonKey);
+    const auto* animation = animation_registry_->get(state.animationKey);
+    if (!skeleton || !animation ||
+        animation->num_tracks() != skeleton->num_joints()) {
+      continue;
+    }
+
+    const uint32_t sample_idx =
+        get_sample(skeleton, state.skeletonKey, animation, state.animationKey,
+                   state.animationTime, state.animationTimeRatio);
+    entity_poses_.push_back({e, get_single_pose(sample_idx)});
+  }
+
+  auto blend_view = world.view<OzzAnimationBlendComponent>(
+      entt::exclude<OzzAnimationCulledTag>);
+  for (auto [e, blend] : blend_view.each()) {
+    const auto* skeleton = skeleton_registry_->get(blend.skeletonKey);
+    if (!skeleton) {
+      continue;
+    }
+
+    uint32_t layer_samples[kMaxLayers];
+    float layer_weights[kMaxLayers];
+    uint32_t layer_count = 0u;
+    for (uint32_t i = 0; i < blend.layerCount && i < kMaxLayers; i++) {
+      OzzAnimationLayer& layer = blend.layers[i];
+      if (layer.weight <= kMinLayerWeight) {
+        continue;
+      }
+
+      const auto* animation = animation_registry_->get(layer.animationKey);
+      if (!animation || animation->num_tracks() != skeleton->num_joints()) {
+        continue;
+      }
+
+      layer_samples[layer_count] =
+          get_sample(skeleton, blend.skeletonKey, animation, layer.animationKey,
+                     layer.animationTime, layer.animationTimeRatio);
+      layer_weights[layer_count] = layer.weight;
+      layer_count++;
+    }
+
+    if (layer_count == 0u) {
+      continue;
+    }
+
+    // One weighted layer looks exactly like its clip - no blend needed
+    const uint32_t pose_idx =
+        (layer_count == 1u)
+            ? get_single_pose(layer_samples[0])
+            : add_blended_pose(skeleton, layer_samples, layer_weights,
+                               layer_count);
+    entity_poses_.push_back({e, pose_idx});
+    if (layer_count > 1u) {
+      stats.blendedPoses++;
+    }
+  }
+
+  //
+  // Lay out poses - resizing only reallocates when the arena outgrows every
+  //  previous frame, and no pointers into it have been handed out yet
+  //
+  locals_arena_.resize(locals_size_);
+  models_arena_.resize(models_size_);
+
+  for (int i = 0; i < entity_poses_.size(); i++) {
+    const EntityPose& entity_pose = entity_poses_[i];
+    const Pose& pose = poses_[entity_pose.poseIdx];
+    world.emplace<OzzAnimationPoseComponent>(
+        entity_pose.entity, models_arena_.raw() + pose.modelsOffset,
+        static_cast<uint32_t>(pose.skeleton->num_joints()));
+  }
+
+  // Samples of the same clip next to each other, in time order, so that each
+  //  chunk's sampling context can reuse its keyframe cursors
+  std::sort(sample_order_.raw(), sample_order_.raw() + sample_order_.size(),
+            [this](uint32_t a, uint32_t b) {
+              const Sample& sa = samples_[a];
+              const Sample& sb = samples_[b];
+              if (sa.animation != sb.animation) {
+                return sa.animation < sb.animation;
+              }
+              return sa.ratio < sb.ratio;
+            });
+
+  //
+  // Sample, then blend and convert to model space - every sample is finished
+  //  before any pose reads it
+  //
+  const uint32_t sample_count = static_cast<uint32_t>(samples_.size());
+  const uint32_t pose_count = static_cast<uint32_t>(poses_.size());
+  const uint32_t sample_chunk_count =
+      (sample_count + params_.samplesPerChunk - 1u) / params_.samplesPerChunk;
+  const uint32_t pose_chunk_count =
+      (pose_count + params_.samplesPerChunk - 1u) / params_.samplesPerChunk;
+  while (chunk_contexts_.size() < sample_chunk_count) {
+    chunk_contexts_.push_back(
+        std::make_unique<ozz::animation::SamplingJob::Context>());
+  }
+
+  failed_samples_ = 0u;
+  run_chunks(sample_chunk_count, &BatchedOzzAnimationSystem::sample_chunk);
+  run_chunks(pose_chunk_count, &BatchedOzzAnimationSystem::pose_chunk);
+
+  const uint32_t failed_samples = failed_samples_;
+  if (failed_samples > 0u) {
+    core::Logger::err(kLogLabel)
+        << failed_samples << " of " << (sample_count + pose_count)
+        << " animation samples and poses failed this frame";
+  }
+
+  stats.animatedEntities = static_cast<uint32_t>(entity_poses_.size());
+  stats.uniqueSamples = sample_count;
+  stats.uniquePoses = pose_count;
+  stats.sampleChunks = sample_chunk_count;
+  stats.poseChunks = pose_chunk_count;
+  stats.poseArenaBytes =
+      static_cast<uint64_t>(locals_size_) * sizeof(ozz::math::SoaTransform) +
+      static_cast<uint64_t>(models_size_) * sizeof(ozz::math::Float4x4);
+  last_update_stats_ = stats;
+}
+
+uint32_t BatchedOzzAnimationSystem::get_sample(
+    const ozz::animation::Skeleton* skeleton,
+    ReadonlyResourceRegistry<ozz::animation::Skeleton>::Key skeleton_key,
+    const ozz::animation::Animation* animation,
+    ReadonlyResourceRegistry<ozz::animation::Animation>::Key animation_key,
+    float& animation_time, float animation_time_ratio) {
+  const float duration = animation->duration();
+  float ratio = 0.f;
+  if (duration > 0.f) {
+    if (animation_time > duration) {
+      animation_time = std::fmod(animation_time, duration);
+    }
+    ratio = std::clamp(animation_time * animation_time_ratio / duration, 0.f,
+                       1.f);
+  }
+
+  SampleKey key{};
+  bool is_shared = params_.shareSampleRateHz > 0.f;
+  if (is_shared) {
+    const float frame_count = duration * params_.shareSampleRateHz;
+    key = SampleKey{skeleton_key.get_raw_key(), animation_key.get_raw_key(),
+                    static_cast<uint32_t>(std::round(ratio * frame_count))};
+
+    auto it = sample_lookup_.find(key);
+    if (it != sample_lookup_.end()) {
+      return it->second;
+    }
+
+    if (frame_count > 0.f) {
+      ratio = std::min(1.f, key.frame / frame_count);
+    }
+  }
+
+  const uint32_t sample_idx = static_cast<uint32_t>(samples_.size());
+  samples_.push_back({skeleton, animation, ratio, locals_size_, kNoPose});
+  sample_order_.push_back(sample_idx);
+  if (is_shared) {
+    sample_lookup_.emplace(key, sample_idx);
+  }
+
+  locals_size_ += static_cast<uint32_t>(skeleton->num_soa_joints());
+  return sample_idx;
+}
+
+uint32_t BatchedOzzAnimationSystem::get_single_pose(uint32_t sample_idx) {
+  Sample& sample = samples_[sample_idx];
+  if (sample.singlePoseIdx != kNoPose) {
+    return sample.singlePoseIdx;
+  }
+
+  Pose pose{};
+  pose.skeleton = sample.skeleton;
+  pose.layerCount = 1u;
+  pose.layerSamples[0] = sample_idx;
+  pose.layerWeights[0] = 1.f;
+  pose.localsOffset = sample.localsOffset;
+  pose.modelsOffset = models_size_;
+
+  models_size_ += static_cast<uint32_t>(sample.skeleton->num_joints());
+
+  sample.singlePoseIdx = static_cast<uint32_t>(poses_.size());
+  poses_.push_back(pose);
+  return sample.singlePoseIdx;
+}
+
+uint32_t BatchedOzzAnimationSystem::add_blended_pose(
+    const ozz::animation::Skeleton* skeleton, const uint32_t* layer_samples,
+    const float* layer_weights, uint32_t layer_count) {
+  Pose pose{};
+  pose.skeleton = skeleton;
+  pose.layerCount = layer_count;
+  for (uint32_t i = 0; i < layer_count; i++) {
+    pose.layerSamples[i] = layer_samples[i];
+    pose.layerWeights[i] = layer_weights[i];
+  }
+  pose.localsOffset = locals_size_;
+  pose.modelsOffset = models_size_;
+
+  locals_size_ += static_cast<uint32_t>(skeleton->num_soa_joints());
+  models_size_ += static_cast<uint32_t>(skeleton->num_joints());
+
+  const uint32_t pose_idx = static_cast<uint32_t>(poses_.size());
+  poses_.push_back(pose);
+  return pose_idx;
+}
+
+void BatchedOzzAnimationSystem::run_chunks(
+    uint32_t chunk_count,
+    void (BatchedOzzAnimationSystem::*chunk_fn)(uint32_t)) {
+#ifdef IG_ENABLE_THREADS
+  if (chunk_count > 1u && worker_threads_.size() > 0) {
+    std::atomic_uint32_t remaining(chunk_count);
+    for (uint32_t i = 0; i < chunk_count; i++) {
+      chunk_task_list_->add_task(
+          core::Task::of([this, chunk_fn, i, &remaining]() {
+            (this->*chunk_fn)(i);
+            remaining--;
+          }));
+    }
+
+    // The calling thread works too, instead of just waiting on the others
+    while (remaining > 0u) {
+      if (!chunk_task_list_->execute_next()) {
+        std::this_thread::yield();
+      }
+    }
+    return;
+  }
+#endif
+
+  for (uint32_t i = 0; i < chunk_count; i++) {
+    (this->*chunk_fn)(i);
+  }
+}
+
+void BatchedOzzAnimationSystem::sample_chunk(uint32_t chunk_idx) {
+  const uint32_t begin = chunk_idx * params_.samplesPerChunk;
+  const uint32_t end =
+      std::min(begin + params_.samplesPerChunk,
+               static_cast<uint32_t>(sample_order_.size()));
+  ozz::animation::SamplingJob::Context* context =
+      chunk_contexts_[chunk_idx].get();
+
+  for (uint32_t i = begin; i < end; i++) {
+    const Sample& sample = samples_[sample_order_[i]];
+    const int num_soa_joints = sample.skeleton->num_soa_joints();
+
+    if (context->max_tracks() < sample.animation->num_tracks()) {
+      context->Resize(sample.animation->num_tracks());
+    }
+
+    auto locals =
+        ozz::span(locals_arena_.raw() + sample.localsOffset, num_soa_joints);
+
+    ozz::animation::SamplingJob sampling_job;
+    sampling_job.animation = sample.animation;
+    sampling_job.context = context;
+    sampling_job.ratio = sample.ratio;
+    sampling_job.output = locals;
+
+    if (!sampling_job.Run()) {
+      // Poses read these locals later - rest pose beats garbage
+      const auto rest_pose = sample.skeleton->joint_rest_poses();
+      std::copy(rest_pose.begin(), rest_pose.end(), locals.begin());
+      failed_samples_++;
+    }
+  }
+}
+
+void BatchedOzzAnimationSystem::pose_chunk(uint32_t chunk_idx) {
+  const uint32_t begin = chunk_idx * params_.samplesPerChunk;
+  const uint32_t end = std::min(begin + params_.samplesPerChunk,
+                                static_cast<uint32_t>(poses_.size()));
+
+  for (uint32_t i = begin; i < end; i++) {
+    const Pose& pose = poses_[i];
+    const int num_soa_joints = pose.skeleton->num_soa_joints();
+    const int num_joints = pose.skeleton->num_joints();
+
+    auto locals =
+        ozz::span(locals_arena_.raw() + pose.localsOffset, num_soa_joints);
+    auto models =
+        ozz::span(models_arena_.raw() + pose.modelsOffset, num_joints);
+
+    bool is_ok = true;
+    if (pose.layerCount > 1u) {
+      ozz::animation::BlendingJob::Layer layers[kMaxLayers];
+      for (uint32_t l = 0; l < pose.layerCount; l++) {
+        const Sample& sample = samples_[pose.layerSamples[l]];
+        layers[l].weight = pose.layerWeights[l];
+        layers[l].transform = ozz::span<const ozz::math::SoaTransform>(
+            locals_arena_.raw() + sample.localsOffset, num_soa_joints);
+      }
+
+      ozz::animation::BlendingJob blending_job;
+      blending_job.layers = ozz::span<const ozz::animation::BlendingJob::Layer>(
+          layers, pose.layerCount);
+      blending_job.rest_pose = pose.skeleton->joint_rest_poses();
+      blending_job.output = locals;
+      is_ok = blending_job.Run();
+    }
+
+    ozz::animation::LocalToModelJob ltm_job;
+    ltm_job.skeleton = pose.skeleton;
+    ltm_job.input = locals;
+    ltm_job.output = models;
+
+    if (!is_ok || !ltm_job.Run()) {
+      // Entities already point at this pose - bind pose beats garbage
+      std::fill(models.begin(), models.end(),
+                ozz::math::Float4x4::identity());
+      failed_samples_++;
+    }
+  }
+}
@@ -0,0 +1,195 @@
+#ifndef SANCTIFY_GAME_CLIENT_SRC_ECS_SYSTEMS_BATCHED_ANIMATION_SYSTEM_H
+#define SANCTIFY_GAME_CLIENT_SRC_ECS_SYSTEMS_BATCHED_ANIMATION_SYSTEM_H
+
+#include <ecs/components/ozz_animation_components.h>
+#include <igasync/task_list.h>
+#include <igcore/config.h>
+#include <igcore/pod_vector.h>
+#include <igcore/vector.h>
+#include <ozz/animation/runtime/sampling_job.h>
+#include <ozz/base/maths/soa_transform.h>
+
+#include <atomic>
+#include <entt/entt.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifdef IG_ENABLE_THREADS
+#include <igasync/executor_thread.h>
+#endif
+
+/**
+ * BatchedOzzAnimationSystem - samples every visible animated entity, writing
+ *  OzzAnimationPoseComponent.
+ *
+ * Entities animate with either OzzAnimationStateComponent (one clip) or
+ *  OzzAnimationBlendComponent (weighted layers). Sampling happens in four
+ *  steps:
+ * 1. (calling thread) Gather visible entities and the unique (skeleton, clip,
+ *    quantized time) samples they need - entities playing the same clip at the
+ *    same quantized time share one sample, and so do blend layers. Layers with
+ *    zero weight are skipped.
+ * 2. (calling thread) Lay out local transforms per unique sample and model
+ *    transforms per pose in a frame arena that is reused every frame, and point
+ *    each entity at its pose. Single clip poses are shared like samples, every
+ *    blend of 2+ layers gets its own pose.
+ * 3. (calling thread + workers) Run SamplingJob for the unique samples in
+ *    chunks, ordered by clip so sampling contexts stay warm.
+ * 4. (calling thread + workers) Run BlendingJob for blended poses, and
+ *    LocalToModelJob for every pose, in chunks.
+ *
+ * Entities tagged with OzzAnimationCulledTag are skipped entirely.
+ */
+
+namespace sanctify::ecs {
+
+struct BatchedOzzAnimationParams {
+  /**
+   * Sampling times are rounded to this rate before looking for samples to
+   *  share - 0 samples every entity at its exact time, and shares nothing.
+   */
+  float shareSampleRateHz;
+
+  /** Unique samples (or poses) handed to a worker at once */
+  uint32_t samplesPerChunk;
+
+  /** Threads used in addition to the calling thread (threaded builds only) */
+  uint32_t workerThreadCount;
+};
+
+struct BatchedOzzAnimationStats {
+  uint32_t animatedEntities;
+  uint32_t culledEntities;
+  uint32_t uniqueSamples;
+  uint32_t uniquePoses;
+  uint32_t blendedPoses;
+  uint32_t sampleChunks;
+  uint32_t poseChunks;
+  uint64_t poseArenaBytes;
+};
+
+class BatchedOzzAnimationSystem {
+ public:
+  static BatchedOzzAnimationParams DefaultParams();
+
+  BatchedOzzAnimationSystem(
+      std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Skeleton>>
+          skeleton_registry,
+      std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Animation>>
+          animation_registry,
+      BatchedOzzAnimationParams params = DefaultParams());
+  ~BatchedOzzAnimationSystem();
+
+  BatchedOzzAnimationSystem(const BatchedOzzAnimationSystem&) = delete;
+  BatchedOzzAnimationSystem& operator=(const BatchedOzzAnimationSystem&) =
+      delete;
+
+  void update(entt::registry& world);
+
+  const BatchedOzzAnimationStats& last_update_stats() const {
+    return last_update_stats_;
+  }
+
+ private:
+  struct SampleKey {
+    uint32_t skeletonKey;
+    uint32_t animationKey;
+    uint32_t frame;
+
+    bool operator==(const SampleKey& o) const {
+      return skeletonKey == o.skeletonKey && animationKey == o.animationKey &&
+             frame == o.frame;
+    }
+  };
+
+  struct SampleKeyHash {
+    size_t operator()(const SampleKey& k) const {
+      uint64_t h = (static_cast<uint64_t>(k.skeletonKey) << 32) ^
+                   (static_cast<uint64_t>(k.animationKey) << 16) ^ k.frame;
+      return std::hash<uint64_t>{}(h);
+    }
+  };
+
+  static constexpr uint32_t kMaxLayers =
+      OzzAnimationBlendComponent::kMaxLayers;
+  static constexpr uint32_t kNoPose = 0xFFFFFFFFu;
+
+  struct Sample {
+    const ozz::animation::Skeleton* skeleton;
+    const ozz::animation::Animation* animation;
+    float ratio;
+    uint32_t localsOffset;
+
+    // Pose of entities playing only this sample, kNoPose until one needs it
+    uint32_t singlePoseIdx;
+  };
+
+  struct Pose {
+    const ozz::animation::Skeleton* skeleton;
+    uint32_t layerCount;
+    uint32_t layerSamples[kMaxLayers];
+    float layerWeights[kMaxLayers];
+
+    // Blended local transforms (blended poses only)
+    uint32_t localsOffset;
+    uint32_t modelsOffset;
+  };
+
+  struct EntityPose {
+    entt::entity entity;
+    uint32_t poseIdx;
+  };
+
+  uint32_t get_sample(
+      const ozz::animation::Skeleton* skeleton,
+      ReadonlyResourceRegistry<ozz::animation::Skeleton>::Key skeleton_key,
+      const ozz::animation::Animation* animation,
+      ReadonlyResourceRegistry<ozz::animation::Animation>::Key animation_key,
+      float& animation_time, float animation_time_ratio);
+  uint32_t get_single_pose(uint32_t sample_idx);
+  uint32_t add_blended_pose(const ozz::animation::Skeleton* skeleton,
+                            const uint32_t* layer_samples,
+                            const float* layer_weights, uint32_t layer_count);
+
+  void sample_chunk(uint32_t chunk_idx);
+  void pose_chunk(uint32_t chunk_idx);
+  void run_chunks(uint32_t chunk_count,
+                  void (BatchedOzzAnimationSystem::*chunk_fn)(uint32_t));
+
+  std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Skeleton>>
+      skeleton_registry_;
+  std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Animation>>
+      animation_registry_;
+  BatchedOzzAnimationParams params_;
+
+  // Per-frame scratch - cleared, not freed, between frames
+  std::unordered_map<SampleKey, uint32_t, SampleKeyHash> sample_lookup_;
+  indigo::core::PodVector<Sample> samples_;
+  indigo::core::PodVector<uint32_t> sample_order_;
+  indigo::core::PodVector<Pose> poses_;
+  indigo::core::PodVector<EntityPose> entity_poses_;
+  uint32_t locals_size_;
+  uint32_t models_size_;
+
+  // Frame arena - exactly sized locals per sample / blend and models per pose
+  indigo::core::PodVector<ozz::math::SoaTransform> locals_arena_;
+  indigo::core::PodVector<ozz::math::Float4x4> models_arena_;
+
+  // One sampling context per chunk, kept across frames
+  std::vector<std::unique_ptr<ozz::animation::SamplingJob::Context>>
+      chunk_contexts_;
+  std::atomic_uint32_t failed_samples_;
+
+  std::shared_ptr<indigo::core::TaskList> chunk_task_list_;
+#ifdef IG_ENABLE_THREADS
+  indigo::core::Vector<std::shared_ptr<indigo::core::ExecutorThread>>
+      worker_threads_;
+#endif
+
+  BatchedOzzAnimationStats last_update_stats_;
+};
+
+}  // namespace sanctify::ecs
+
+#endif
@@ -0,0 +1,89 @@
+#include <ecs/components/parent_entity_component.h>
+#include <ecs/systems/cull_solid_animated_system.h>
+
+using namespace sanctify;
+using namespace ecs;
+
+using namespace indigo;
+using namespace core;
+
+CullSolidAnimatedSystem::CullSolidAnimatedSystem(
+    std::shared_ptr<ReadonlyResourceRegistry<solid_animated::SolidAnimatedGeo>>
+        solid_animated_geo_registry)
+    : solid_animated_geo_registry_(solid_animated_geo_registry),
+      entities_(64),
+      center_x_(64),
+      center_y_(64),
+      center_z_(64),
+      radius_(64),
+      visible_masks_(2),
+      visible_renderables_(64) {}
+
+void CullSolidAnimatedSystem::update(entt::registry& world,
+                                     const glm::mat4& mat_view_proj) {
+  entities_.resize(0);
+  center_x_.resize(0);
+  center_y_.resize(0);
+  center_z_.resize(0);
+  radius_.resize(0);
+  visible_renderables_.resize(0);
+
+  //
+  // Gather world bounds (SoA) - renderables without geometry are skipped, they
+  //  can't be drawn anyways
+  //
+  auto view = world.view<const ParentEntityComponent,
+                         const SolidAnimatedRenderableComponent>();
+  for (auto [e, parent_entity, renderable] : view.each()) {
+    auto* geo = solid_animated_geo_registry_->get(renderable.geoKey);
+    if (!geo) {
+      continue;
+    }
+
+    render::BoundingSphere skinned_bounds{
+        geo->bounds.center, geo->bounds.radius * kSkinnedBoundsScale};
+    render::BoundingSphere world_bounds =
+        skinned_bounds.transformed(renderable.matWorld);
+
+    entities_.push_back(e);
+    center_x_.push_back(world_bounds.center.x);
+    center_y_.push_back(world_bounds.center.y);
+    center_z_.push_back(world_bounds.center.z);
+    radius_.push_back(world_bounds.radius);
+  }
+
+  const uint32_t count = static_cast<uint32_t>(entities_.size());
+  visible_masks_.resize((count + 31u) / 32u);
+  render::FrustumCullKernel::cull(
+      render::Frustum::from_view_proj(mat_view_proj), center_x_.raw(),
+      center_y_.raw(), center_z_.raw(), radius_.raw(), count,
+      visible_masks_.raw());
+
+  //
+  // Every animated parent starts culled, and is un-culled by a visible child
+  //
+  for (auto e : world.view<const OzzAnimationBlendComponent>()) {
+    world.emplace_or_replace<OzzAnimationCulledTag>(e);
+  }
+  for (auto e : world.view<const OzzAnimationStateComponent>()) {
+    world.emplace_or_replace<OzzAnimationCulledTag>(e);
+  }
+
+  for (int word_idx = 0; word_idx < visible_masks_.size(); word_idx++) {
+    uint32_t mask = visible_masks_[word_idx];
+    for (uint32_t bit = 0u; mask != 0u; bit++, mask >>= 1u) {
+      if ((mask & 1u) == 0u) {
+        continue;
+      }
+
+      entt::entity e = entities_[word_idx * 32u + bit];
+      visible_renderables_.push_back(e);
+
+      entt::entity parent = view.get<const ParentEntityComponent>(e)
+                                .parentEntity;
+      if (world.valid(parent)) {
+        world.remove<OzzAnimationCulledTag>(parent);
+      }
+    }
+  }
+}
@@ -0,0 +1,60 @@
+#ifndef SANCTIFY_GAME_CLIENT_SRC_ECS_SYSTEMS_CULL_SOLID_ANIMATED_SYSTEM_H
+#define SANCTIFY_GAME_CLIENT_SRC_ECS_SYSTEMS_CULL_SOLID_ANIMATED_SYSTEM_H
+
+#include <common/render/visibility/frustum_cull.h>
+#include <ecs/components/solid_animated_components.h>
+#include <igcore/pod_vector.h>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <memory>
+
+/**
+ * CullSolidAnimatedSystem - tests every solid animated renderable against the
+ *  camera frustum (see FrustumCullKernel), and writes the visible ones to a
+ *  compact list in view order.
+ *
+ * Animated parents with no visible children are tagged OzzAnimationCulledTag,
+ *  so they are not sampled. Run before BatchedOzzAnimationSystem, and pass
+ *  the visible list on to skin palette packing.
+ */
+
+namespace sanctify::ecs {
+
+class CullSolidAnimatedSystem {
+ public:
+  // Skinned vertices move away from the bind pose they were bounded in
+  static constexpr float kSkinnedBoundsScale = 1.5f;
+
+  CullSolidAnimatedSystem(
+      std::shared_ptr<
+          ReadonlyResourceRegistry<solid_animated::SolidAnimatedGeo>>
+          solid_animated_geo_registry);
+
+  void update(entt::registry& world, const glm::mat4& mat_view_proj);
+
+  const indigo::core::PodVector<entt::entity>& visible_renderables() const {
+    return visible_renderables_;
+  }
+  uint32_t tested_count() const {
+    return static_cast<uint32_t>(entities_.size());
+  }
+
+ private:
+  std::shared_ptr<ReadonlyResourceRegistry<solid_animated::SolidAnimatedGeo>>
+      solid_animated_geo_registry_;
+
+  // Per-frame scratch - cleared, not freed, between frames
+  indigo::core::PodVector<entt::entity> entities_;
+  indigo::core::PodVector<float> center_x_;
+  indigo::core::PodVector<float> center_y_;
+  indigo::core::PodVector<float> center_z_;
+  indigo::core::PodVector<float> radius_;
+  indigo::core::PodVector<uint32_t> visible_masks_;
+
+  indigo::core::PodVector<entt::entity> visible_renderables_;
+};
+
+}  // namespace sanctify::ecs
+
+#endif
@@ -1,21 +1,25 @@
 #include <ecs/components/parent_entity_component.h>
 #include <ecs/components/solid_animated_components.h>
 #include <ecs/systems/solid_animation_systems.h>
-#include <ozz/animation/runtime/local_to_model_job.h>
+#include <ecs/utils/ozz_animation_blend_utils.h>
 #include <render/solid_animated/solid_animated_pipeline.h>
 #include <sanctify-game-common/gameplay/locomotion_components.h>
 #include <sanctify-game-common/gameplay/player_definition_components.h>
 
+#include <algorithm>
+
 using namespace sanctify;
 using namespace ecs;
 
 SetOzzAnimationKeysSystem::SetOzzAnimationKeysSystem(
     ReadonlyResourceRegistry<ozz::animation::Skeleton>::Key ybot_skeleton_key,
     ReadonlyResourceRegistry<ozz::animation::Animation>::Key ybot_idle_key,
-    ReadonlyResourceRegistry<ozz::animation::Animation>::Key ybot_walk_key)
+    ReadonlyResourceRegistry<ozz::animation::Animation>::Key ybot_walk_key,
+    float crossfade_seconds)
     : ybot_skeleton_key_(ybot_skeleton_key),
       ybot_idle_key_(ybot_idle_key),
-      ybot_walk_key_(ybot_walk_key) {}
+      ybot_walk_key_(ybot_walk_key),
+      crossfade_seconds_(crossfade_seconds) {}
 
 void SetOzzAnimationKeysSystem::update(entt::registry& world, float dt) const {
   auto view = world.view<const component::MapLocation,
@@ -25,143 +29,74 @@ void SetOzzAnimationKeysSystem::update(entt::registry& world, float dt) const {
     component::NavWaypointList* waypoints =
         world.try_get<component::NavWaypointList>(entity);
 
-    auto& animation_state_component =
-        world.get_or_emplace<OzzAnimationStateComponent>(
-            entity, ybot_skeleton_key_, ybot_idle_key_, 0.f, 1.f);
-
-    if (waypoints != nullptr) {
-      if (animation_state_component.animationKey == ybot_idle_key_) {
-        animation_state_component.animationTime = 0.f;
-      } else {
-        animation_state_component.animationTime += dt;
-      }
-
-      animation_state_component.animationKey = ybot_walk_key_;
-    } else {
-      if (animation_state_component.animationKey == ybot_walk_key_) {
-        animation_state_component.animationTime = 0.f;
-      } else {
-        animation_state_component.animationTime += dt;
-      }
-
-      animation_state_component.animationKey = ybot_idle_key_;
+    auto& blend = world.get_or_emplace<OzzAnimationBlendComponent>(
+        entity, ybot_skeleton_key_);
+    if (blend.layerCount == 0u) {
+      OzzAnimationBlendUtil::play(blend, ybot_idle_key_);
+    }
+
+    auto target_key = (waypoints != nullptr) ? ybot_walk_key_ : ybot_idle_key_;
+    int target_idx = OzzAnimationBlendUtil::find_layer(blend, target_key);
+    if (target_idx < 0 || blend.layers[target_idx].targetWeight < 1.f) {
+      OzzAnimationBlendUtil::crossfade_to(blend, target_key,
+                                          crossfade_seconds_);
     }
+
+    OzzAnimationBlendUtil::advance(blend, dt);
   }
 }
 
 UpdateOzzAnimationBuffersSystem::UpdateOzzAnimationBuffersSystem(
-    std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Skeleton>>
-        skeleton_registry,
-    std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Animation>>
-        animation_registry,
     std::shared_ptr<ReadonlyResourceRegistry<solid_animated::SolidAnimatedGeo>>
         solid_animated_geo_registry)
-    : skeleton_registry_(skeleton_registry),
-      animation_registry_(animation_registry),
-      solid_animated_geo_registry_(solid_animated_geo_registry) {}
-
-void UpdateOzzAnimationBuffersSystem::update_cpu_buffers(
-    entt::registry& world) const {
-  auto view = world.view<OzzAnimationStateComponent>();
-
-  for (auto [e, animation_state] : view.each()) {
-    // TODO (sessamekesh): Early out if this entity is not visible in the scene
-
-    OzzAnimationCpuBuffersComponent& buffers =
-        world.get_or_emplace<OzzAnimationCpuBuffersComponent>(
-            e, (uint32_t)solid_animated::SolidAnimatedPipeline::kMaxBonesCount);
-
-    auto* skeleton = skeleton_registry_->get(animation_state.skeletonKey);
-    auto* animation = animation_registry_->get(animation_state.animationKey);
-
-    if (!skeleton || !animation) {
-      // TODO (sessamekesh): propagate errors to an accumulator, or return from
-      // this method (also do this for job run methods below)
-      continue;
-    }
-
-    while (animation_state.animationTime > animation->duration()) {
-      animation_state.animationTime -= animation->duration();
-    }
-
-    ozz::animation::SamplingJob sampling_job;
-    sampling_job.animation = animation;
-    sampling_job.context = buffers.context.get();
-    sampling_job.ratio =
-        (animation_state.animationTime * animation_state.animationTimeRatio) /
-        animation->duration();
-    sampling_job.output =
-        ozz::span(buffers.locals.raw(), buffers.locals.size());
-    if (!sampling_job.Run()) {
-      continue;
-    }
-
-    ozz::animation::LocalToModelJob ltm_job;
-    ltm_job.skeleton = skeleton;
-    ltm_job.input = ozz::span(buffers.locals.raw(), buffers.locals.size());
-    ltm_job.output = ozz::span(buffers.models.raw(), buffers.models.size());
-    if (!ltm_job.Run()) {
-      continue;
-    }
-  }
-}
+    : solid_animated_geo_registry_(solid_animated_geo_registry),
+      palette_(1024u),
+      animation_inputs_{} {}
 
 void UpdateOzzAnimationBuffersSystem::update_gpu_buffers(
     entt::registry& world,
+    const indigo::core::PodVector<entt::entity>& visible_renderables,
     const solid_animated::SolidAnimatedPipeline& pipeline,
-    const wgpu::Device& device) const {
+    const wgpu::Device& device) {
+  palette_.reset();
+  world.clear<SkinPaletteOffsetComponent>();
+
   auto view = world.view<const ParentEntityComponent,
                          const SolidAnimatedRenderableComponent>();
 
-  for (auto [e, parent_entity, solid_animated_renderable] : view.each()) {
-    // TODO (sessamekesh): Early out if this entity is not visible in the scene
-
-    if (!world.valid(parent_entity.parentEntity)) {
+  for (int i = 0; i < visible_renderables.size(); i++) {
+    entt::entity e = visible_renderables[i];
+    if (!view.contains(e)) {
       continue;
     }
 
-    auto* anim_buffers = world.try_get<OzzAnimationCpuBuffersComponent>(
-        parent_entity.parentEntity);
-    auto* anim_keys =
-        world.try_get<OzzAnimationStateComponent>(parent_entity.parentEntity);
-
-    if (!anim_buffers || !anim_keys) {
+    auto [parent_entity, solid_animated_renderable] = view.get(e);
+    if (!world.valid(parent_entity.parentEntity)) {
       continue;
     }
 
-    auto* skeleton = skeleton_registry_->get(anim_keys->skeletonKey);
+    // No pose if the parent was culled or could not be sampled this frame
+    auto* pose =
+        world.try_get<OzzAnimationPoseComponent>(parent_entity.parentEntity);
     auto* geo =
         solid_animated_geo_registry_->get(solid_animated_renderable.geoKey);
 
-    if (!skeleton || !geo) {
+    if (!pose || !geo) {
       continue;
     }
 
-    OzzAnimationGpuBuffersComponent& gpu_buffers =
-        world.get_or_emplace<OzzAnimationGpuBuffersComponent>(
-            e, device, pipeline,
-            solid_animated::SolidAnimatedPipeline::kMaxBonesCount);
-
-    for (int i = 0; i < skeleton->num_joints(); i++) {
-      const auto& ozz_model = anim_buffers->models[i];
-      // TODO (sessamekesh): More elegantly extract values to GLM,
-      // or just construct and do math in OZZ space
-      glm::mat4 model(((float*)&ozz_model)[0], ((float*)&ozz_model)[1],
-                      ((float*)&ozz_model)[2], ((float*)&ozz_model)[3],
-                      ((float*)&ozz_model)[4], ((float*)&ozz_model)[5],
-                      ((float*)&ozz_model)[6], ((float*)&ozz_model)[7],
-                      ((float*)&ozz_model)[8], ((float*)&ozz_model)[9],
-                      ((float*)&ozz_model)[10], ((float*)&ozz_model)[11],
-                      ((float*)&ozz_model)[12], ((float*)&ozz_model)[13],
-                      ((float*)&ozz_model)[14], ((float*)&ozz_model)[15]);
-      glm::mat4 inv_bind = geo->invBindPoses[i];
-
-      gpu_buffers.shaderValues[i] = model * inv_bind;
-    }
+    const uint32_t joint_count = std::min<uint32_t>(
+        pose->numJoints, static_cast<uint32_t>(geo->invBindPoses.size()));
+    const uint32_t palette_offset =
+        palette_.add(pose->models, geo->invBindPoses.raw(), joint_count);
+    world.emplace<SkinPaletteOffsetComponent>(e, palette_offset);
+  }
 
-    gpu_buffers.animationPipelineInputs.SkinMatricesUbo.update(
-        device, gpu_buffers.shaderValues);
+  if (!animation_inputs_.AnimationBindGroup) {
+    animation_inputs_ =
+        pipeline.create_animation_inputs(device, palette_.size());
   }
+  pipeline.update_animation_inputs(device, animation_inputs_, palette_);
 }
 
 RenderSolidRenderablesSystem::RenderSolidRenderablesSystem(
@@ -171,49 +106,102 @@ RenderSolidRenderablesSystem::RenderSolidRenderablesSystem(
         ReadonlyResourceRegistry<solid_animated::MaterialPipelineInputs>>
         solid_animated_material_registry)
     : solid_animated_geo_registry_(solid_animated_geo_registry),
-      solid_animated_material_registry_(solid_animated_material_registry) {}
+      solid_animated_material_registry_(solid_animated_material_registry),
+      render_queue_(64u),
+      queued_entities_(64u),
+      instances_(64u),
+      last_frame_stats_{} {}
 
 void RenderSolidRenderablesSystem::render(
     entt::registry& world, const wgpu::Device& device,
     const wgpu::RenderPassEncoder& pass,
     const solid_animated::SolidAnimatedPipeline& pipeline,
     const solid_animated::ScenePipelineInputs& scene_inputs,
-    const solid_animated::FramePipelineInputs& frame_inputs) {
+    const solid_animated::FramePipelineInputs& frame_inputs,
+    const solid_animated::AnimationPipelineInputs& animation_inputs) {
+  last_frame_stats_ = FrameStats{};
+
   auto view = world.view<const SolidAnimatedRenderableComponent,
-                         OzzAnimationGpuBuffersComponent>();
+                         const SkinPaletteOffsetComponent>();
+
+  //
+  // Sort
+  //
+  render_queue_.begin_frame();
+  queued_entities_.resize(0);
+  for (auto [e, solid_animated_renderable, skin_palette_offset] :
+       view.each()) {
+    render_queue_.add(indigo::iggpu::RenderSortKey::make(
+        0u, solid_animated_renderable.materialKey.get_raw_index(),
+        solid_animated_renderable.geoKey.get_raw_index()));
+    queued_entities_.push_back(e);
+  }
 
-  if (view.size_hint() == 0u) {
+  if (render_queue_.size() == 0u) {
     return;
   }
+  render_queue_.sort();
+
+  //
+  // Upload every instance of the frame at once, in draw order
+  //
+  instances_.resize(0);
+  for (uint32_t i = 0; i < render_queue_.size(); i++) {
+    auto [solid_animated_renderable, skin_palette_offset] =
+        view.get(queued_entities_[render_queue_.sorted_item(i)]);
+    instances_.push_back({solid_animated_renderable.matWorld,
+                          skin_palette_offset.paletteOffset});
+  }
 
-  solid_animated::RenderUtil render_util(pass, pipeline);
-  render_util.set_scene_inputs(scene_inputs).set_frame_inputs(frame_inputs);
-
-  indigo::core::PodVector<solid_animated::MatWorldInstanceData> instances(4);
-
-  for (auto [e, solid_animated_renderable, gpu_buffers] : view.each()) {
-    const solid_animated::MaterialPipelineInputs* mat_inputs =
-        solid_animated_material_registry_->get(
-            solid_animated_renderable.materialKey);
-    auto* geo =
-        solid_animated_geo_registry_->get(solid_animated_renderable.geoKey);
-
-    if (!mat_inputs || !geo) {
-      continue;
-    }
-
-    auto& instance_buffer =
-        world.get_or_emplace<SolidAnimatedRenderableInstanceBufferComponent>(
-            e, device);
-
-    instances.resize(0);
-    instances.push_back({solid_animated_renderable.matWorld});
-    instance_buffer.buffer.update_index_data(device, instances);
-
-    render_util.set_material_inputs(*mat_inputs)
-        .set_instances(instance_buffer.buffer)
-        .set_animation_inputs(gpu_buffers.animationPipelineInputs)
-        .set_geometry(*geo)
-        .draw();
+  if (instance_buffer_ == nullptr) {
+    instance_buffer_ =
+        std::make_unique<solid_animated::MatWorldInstanceBuffer>(device);
   }
+  instance_buffer_->update_index_data(device, instances_);
+
+  //
+  // Draw each batch, skipping binds that have not changed since the last one
+  //
+  solid_animated::RenderUtil render_util(pass, pipeline);
+  render_util.set_scene_inputs(scene_inputs)
+      .set_frame_inputs(frame_inputs)
+      .set_animation_inputs(animation_inputs)
+      .set_instances(*instance_buffer_);
+
+  const solid_animated::MaterialPipelineInputs* mat_inputs = nullptr;
+  const solid_animated::SolidAnimatedGeo* geo = nullptr;
+  FrameStats& stats = last_frame_stats_;
+  stats.renderableCount = render_queue_.size();
+
+  render_queue_.for_each_batch(
+      [&](const indigo::iggpu::RenderQueue::Batch& batch) {
+        const auto& solid_animated_renderable =
+            view.get<const SolidAnimatedRenderableComponent>(
+                queued_entities_[render_queue_.sorted_item(batch.firstItem)]);
+
+        if (batch.materialChanged) {
+          mat_inputs = solid_animated_material_registry_->get(
+              solid_animated_renderable.materialKey);
+          if (mat_inputs) {
+            render_util.set_material_inputs(*mat_inputs);
+            stats.materialBindCount++;
+          }
+        }
+
+        if (batch.geometryChanged) {
+          geo = solid_animated_geo_registry_->get(
+              solid_animated_renderable.geoKey);
+          if (geo) {
+            render_util.set_geometry(*geo);
+            stats.geometryBindCount++;
+          }
+        }
+
+        if (!mat_inputs || !geo) {
+          return;
+        }
+
+        render_util.set_instance_range(batch.firstItem, batch.numItems).draw();
+        stats.drawCount++;
+      });
 }
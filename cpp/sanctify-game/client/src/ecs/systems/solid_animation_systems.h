@@ -2,17 +2,24 @@
 #define SANCTIFY_GAME_CLIENT_SRC_ECS_SYSTEMS_SOLID_ANIMATION_SYSTEMS_H
 
 #include <ecs/components/solid_animated_components.h>
+#include <iggpu/render_queue.h>
 
 #include <entt/entt.hpp>
+#include <memory>
 
 namespace sanctify::ecs {
 
+/**
+ * Picks idle / walk animations for players, crossfading over
+ *  "crossfade_seconds" when a player starts or stops moving
+ */
 class SetOzzAnimationKeysSystem {
  public:
   SetOzzAnimationKeysSystem(
       ReadonlyResourceRegistry<ozz::animation::Skeleton>::Key ybot_skeleton_key,
       ReadonlyResourceRegistry<ozz::animation::Animation>::Key ybot_idle_key,
-      ReadonlyResourceRegistry<ozz::animation::Animation>::Key ybot_walk_key);
+      ReadonlyResourceRegistry<ozz::animation::Animation>::Key ybot_walk_key,
+      float crossfade_seconds = 0.2f);
 
  public:
   void update(entt::registry& world, float dt) const;
@@ -21,35 +28,59 @@ class SetOzzAnimationKeysSystem {
   ReadonlyResourceRegistry<ozz::animation::Skeleton>::Key ybot_skeleton_key_;
   ReadonlyResourceRegistry<ozz::animation::Animation>::Key ybot_idle_key_;
   ReadonlyResourceRegistry<ozz::animation::Animation>::Key ybot_walk_key_;
+  float crossfade_seconds_;
 };
 
+/**
+ * Packs sampled poses (see BatchedOzzAnimationSystem) of every visible animated
+ *  renderable (see CullSolidAnimatedSystem) into one skin palette, and uploads
+ *  it in a single write. Renderables left out get no SkinPaletteOffsetComponent
+ *  and are not drawn.
+ */
 class UpdateOzzAnimationBuffersSystem {
  public:
   UpdateOzzAnimationBuffersSystem(
-      std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Skeleton>>
-          skeleton_registry,
-      std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Animation>>
-          animation_registry,
       std::shared_ptr<
           ReadonlyResourceRegistry<solid_animated::SolidAnimatedGeo>>
           solid_animated_geo_registry);
 
-  void update_cpu_buffers(entt::registry& world) const;
-  void update_gpu_buffers(entt::registry& world,
-                          const solid_animated::SolidAnimatedPipeline& pipeline,
-                          const wgpu::Device& device) const;
+  void update_gpu_buffers(
+      entt::registry& world,
+      const indigo::core::PodVector<entt::entity>& visible_renderables,
+      const solid_animated::SolidAnimatedPipeline& pipeline,
+      const wgpu::Device& device);
+
+  // Bound once for every animated renderable (see SkinPaletteOffsetComponent)
+  const solid_animated::AnimationPipelineInputs& animation_inputs() const {
+    return animation_inputs_;
+  }
 
  private:
-  std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Skeleton>>
-      skeleton_registry_;
-  std::shared_ptr<ReadonlyResourceRegistry<ozz::animation::Animation>>
-      animation_registry_;
   std::shared_ptr<ReadonlyResourceRegistry<solid_animated::SolidAnimatedGeo>>
       solid_animated_geo_registry_;
+
+  solid_animated::SkinPalette palette_;
+  solid_animated::AnimationPipelineInputs animation_inputs_;
 };
 
+/**
+ * Draws every posed animated renderable (see SkinPaletteOffsetComponent).
+ *
+ * Renderables are sorted by (material, geometry) in a RenderQueue, every
+ *  instance of the frame is uploaded to one shared instance buffer in sorted
+ *  order, and each run of renderables sharing material and geometry is drawn
+ *  with a single instanced call. Material and geometry are only re-bound
+ *  when they change between runs.
+ */
 class RenderSolidRenderablesSystem {
  public:
+  struct FrameStats {
+    uint32_t renderableCount;
+    uint32_t drawCount;
+    uint32_t materialBindCount;
+    uint32_t geometryBindCount;
+  };
+
   RenderSolidRenderablesSystem(
       std::shared_ptr<
           ReadonlyResourceRegistry<solid_animated::SolidAnimatedGeo>>
@@ -62,7 +93,10 @@ class RenderSolidRenderablesSystem {
               const wgpu::RenderPassEncoder& pass,
               const solid_animated::SolidAnimatedPipeline& pipeline,
               const solid_animated::ScenePipelineInputs& scene_inputs,
-              const solid_animated::FramePipelineInputs& frame_inputs);
+              const solid_animated::FramePipelineInputs& frame_inputs,
+              const solid_animated::AnimationPipelineInputs& animation_inputs);
+
+  const FrameStats& last_frame_stats() const { return last_frame_stats_; }
 
  private:
   std::shared_ptr<ReadonlyResourceRegistry<solid_animated::SolidAnimatedGeo>>
@@ -70,6 +104,16 @@ class RenderSolidRenderablesSystem {
   std::shared_ptr<
       ReadonlyResourceRegistry<solid_animated::MaterialPipelineInputs>>
       solid_animated_material_registry_;
+
+  // Per-frame scratch - cleared, not freed, between frames
+  indigo::iggpu::RenderQueue render_queue_;
+  indigo::core::PodVector<entt::entity> queued_entities_;
+  indigo::core::PodVector<solid_animated::MatWorldInstanceData> instances_;
+
+  // Created on first use (needs a device), grows as needed
+  std::unique_ptr<solid_animated::MatWorldInstanceBuffer> instance_buffer_;
+
+  FrameStats last_frame_stats_;
 };
 
 }  // namespace sanctify::ecs
@@ -10,53 +10,71 @@ using namespace core;
 
 namespace {
 const char* kLogLabel = "DebugGeoRenderUtil";
-}
 
-std::shared_ptr<Promise<Maybe<DebugGeoRenderUtil::LoadError>>>
-DebugGeoRenderUtil::init_pipeline_builder(
+// Shared by the debug geo and debug draw pipeline builders - both are built
+//  out of one VS and one FS source
+template <typename CtxBuilderT, typename BuilderT>
+std::shared_ptr<Promise<Maybe<DebugGeoRenderUtil::LoadError>>> init_builder(
     entt::registry& world, const wgpu::Device& device,
     asset::IgpackLoader::ExtractWgslShaderPromiseT vs_src_promise,
     asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
-    std::shared_ptr<TaskList> main_thread_task_list) {
+    std::shared_ptr<TaskList> main_thread_task_list, const char* help_name) {
+  using LoadError = DebugGeoRenderUtil::LoadError;
+
   auto combiner = PromiseCombiner::Create();
 
   auto vs_key = combiner->add(vs_src_promise, main_thread_task_list);
   auto fs_key = combiner->add(fs_src_promise, main_thread_task_list);
 
   return combiner->combine()->then<Maybe<LoadError>>(
-      [vs_key, fs_key, &world,
-       device](const PromiseCombiner::PromiseCombinerResult& rsl)
+      [vs_key, fs_key, &world, device,
+       help_name](const PromiseCombiner::PromiseCombinerResult& rsl)
           -> Maybe<LoadError> {
         const auto& vs_src_rsl = rsl.get(vs_key);
         const auto& fs_src_rsl = rsl.get(fs_key);
 
         if (vs_src_rsl.is_right()) {
-          Logger::err(kLogLabel) << "Could not load VS from source";
+          Logger::err(kLogLabel)
+              << "Could not load " << help_name << " VS from source";
           return LoadError::VsSrcNotFound;
         }
 
         if (fs_src_rsl.is_right()) {
-          Logger::err(kLogLabel) << "Could not load FS from source";
+          Logger::err(kLogLabel)
+              << "Could not load " << help_name << " FS from source";
           return LoadError::FsSrcNotFound;
         }
 
-        Maybe<debug_geo::DebugGeoPipelineBuilder> maybe_pipeline_builder =
-            debug_geo::DebugGeoPipelineBuilder::Create(
-                device, vs_src_rsl.get_left(), fs_src_rsl.get_left());
+        Maybe<BuilderT> maybe_pipeline_builder = BuilderT::Create(
+            device, vs_src_rsl.get_left(), fs_src_rsl.get_left());
 
         if (maybe_pipeline_builder.is_empty()) {
           Logger::err(kLogLabel)
-              << "Failed to build the debug geo pipeline builder";
+              << "Failed to build the " << help_name << " pipeline builder";
           return LoadError::BuildFail;
         }
 
-        world.set<CtxDebugGeoPipelineBuilder>(maybe_pipeline_builder.move());
+        world.set<CtxBuilderT>(maybe_pipeline_builder.move());
 
         return empty_maybe{};
       },
       main_thread_task_list);
 }
 
+}  // namespace
+
+std::shared_ptr<Promise<Maybe<DebugGeoRenderUtil::LoadError>>>
+DebugGeoRenderUtil::init_pipeline_builder(
+    entt::registry& world, const wgpu::Device& device,
+    asset::IgpackLoader::ExtractWgslShaderPromiseT vs_src_promise,
+    asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
+    std::shared_ptr<TaskList> main_thread_task_list) {
+  return ::init_builder<CtxDebugGeoPipelineBuilder,
+                        debug_geo::DebugGeoPipelineBuilder>(
+      world, device, vs_src_promise, fs_src_promise, main_thread_task_list,
+      "debug geo");
+}
+
 void DebugGeoRenderUtil::init_pipeline(entt::registry& world,
                                        const wgpu::Device& device,
                                        wgpu::TextureFormat swap_chain_format) {
@@ -100,11 +118,13 @@ void DebugGeoRenderUtil::render_all_debug_geo_renderables(
   renderable_resources.instanceBufferStore.finalize(
       device, [&renderable_resources, &render_util](
                   const debug_geo::InstanceKey& key, const wgpu::Buffer& ib,
-                  uint32_t num_instances) {
+                  uint64_t offset, uint32_t num_instances) {
         auto* geo = renderable_resources.geoRegistry.get(key.geoKey);
         if (!geo) return;
 
-        render_util.set_geometry(*geo).set_instances(ib, num_instances).draw();
+        render_util.set_geometry(*geo)
+            .set_instances(ib, num_instances, offset)
+            .draw();
       });
 }
 
@@ -117,6 +137,73 @@ DebugGeoRenderUtil::register_unit_cube(entt::registry& world,
       debug_geo::DebugGeo::CreateDebugUnitCube(device));
 }
 
+std::shared_ptr<Promise<Maybe<DebugGeoRenderUtil::LoadError>>>
+DebugGeoRenderUtil::init_debug_draw_pipeline_builder(
+    entt::registry& world, const wgpu::Device& device,
+    asset::IgpackLoader::ExtractWgslShaderPromiseT vs_src_promise,
+    asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
+    std::shared_ptr<TaskList> main_thread_task_list) {
+  return ::init_builder<CtxDebugDrawPipelineBuilder,
+                        debug_geo::DebugDrawPipelineBuilder>(
+      world, device, vs_src_promise, fs_src_promise, main_thread_task_list,
+      "debug draw");
+}
+
+void DebugGeoRenderUtil::init_debug_draw_pipeline(
+    entt::registry& world, const wgpu::Device& device,
+    wgpu::TextureFormat swap_chain_format) {
+  auto& builder = world.ctx<CtxDebugDrawPipelineBuilder>().pipelineBuilder;
+  auto* ctx_pipeline = world.try_ctx<CtxDebugDrawPipeline>();
+
+  // Lazy set pipeline
+  if (!ctx_pipeline) {
+    world.set<CtxDebugDrawPipeline>(
+        builder.create_pipeline(device, swap_chain_format), swap_chain_format);
+  } else if (ctx_pipeline->swapChainFormat != swap_chain_format) {
+    ctx_pipeline->pipeline = builder.create_pipeline(device, swap_chain_format);
+    ctx_pipeline->swapChainFormat = swap_chain_format;
+  }
+
+  if (!world.try_ctx<CtxDebugDraw>()) {
+    world.set<CtxDebugDraw>(std::make_shared<render::DebugDrawList>(),
+                            debug_geo::DebugDrawBuffers());
+  }
+}
+
+debug_geo::DebugDrawPipeline& DebugGeoRenderUtil::get_debug_draw_pipeline(
+    entt::registry& world) {
+  return world.ctx<CtxDebugDrawPipeline>().pipeline;
+}
+
+render::DebugDrawList* DebugGeoRenderUtil::get_debug_draw_list(
+    entt::registry& world) {
+  auto* ctx_debug_draw = world.try_ctx<CtxDebugDraw>();
+  if (!ctx_debug_draw) {
+    return nullptr;
+  }
+
+  return ctx_debug_draw->drawList.get();
+}
+
+void DebugGeoRenderUtil::render_debug_draw(
+    const wgpu::RenderPassEncoder& pass, entt::registry& world,
+    const wgpu::Device& device,
+    const debug_geo::DebugDrawFrameInputs& frame_inputs) {
+  auto& ctx_debug_draw = world.ctx<CtxDebugDraw>();
+  auto& draw_list = *ctx_debug_draw.drawList;
+
+  if (draw_list.dropped_count() > 0u) {
+    Logger::log(kLogLabel) << "Dropped " << draw_list.dropped_count()
+                           << " debug draw primitives this frame";
+  }
+
+  ctx_debug_draw.buffers.upload(device, draw_list);
+  ctx_debug_draw.buffers.draw(pass, get_debug_draw_pipeline(world),
+                              frame_inputs);
+
+  draw_list.begin_frame();
+}
+
 std::string ecs::to_string(const DebugGeoRenderUtil::LoadError& err) {
   switch (err) {
     case DebugGeoRenderUtil::LoadError::VsSrcNotFound:
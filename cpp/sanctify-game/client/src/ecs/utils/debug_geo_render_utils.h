@@ -40,6 +40,33 @@ class DebugGeoRenderUtil {
 
   static ReadonlyResourceRegistry<debug_geo::DebugGeo>::Key register_unit_cube(
       entt::registry& world, const wgpu::Device& device);
+
+  //
+  // Immediate mode debug draw (lines, circles, boxes)
+  //
+  static std::shared_ptr<indigo::core::Promise<indigo::core::Maybe<LoadError>>>
+  init_debug_draw_pipeline_builder(
+      entt::registry& world, const wgpu::Device& device,
+      indigo::asset::IgpackLoader::ExtractWgslShaderPromiseT vs_src_promise,
+      indigo::asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
+      std::shared_ptr<indigo::core::TaskList> main_thread_task_list);
+
+  /** Also creates the (empty) debug draw list, if it does not exist yet */
+  static void init_debug_draw_pipeline(entt::registry& world,
+                                       const wgpu::Device& device,
+                                       wgpu::TextureFormat swap_chain_format);
+
+  static debug_geo::DebugDrawPipeline& get_debug_draw_pipeline(
+      entt::registry& world);
+
+  /** Null until init_debug_draw_pipeline has been called */
+  static render::DebugDrawList* get_debug_draw_list(entt::registry& world);
+
+  /** Upload + draw everything recorded this frame, then start the next one */
+  static void render_debug_draw(
+      const wgpu::RenderPassEncoder& pass, entt::registry& world,
+      const wgpu::Device& device,
+      const debug_geo::DebugDrawFrameInputs& frame_inputs);
 };
 
 static std::string to_string(const DebugGeoRenderUtil::LoadError& err);
@@ -0,0 +1,141 @@
+#include "ozz_animation_blend_utils.h"
+
+#include <algorithm>
+
+using namespace sanctify;
+using namespace ecs;
+
+namespace {
+
+OzzAnimationLayer new_layer(OzzAnimationBlendUtil::AnimationKey animation_key,
+                            float time_ratio) {
+  OzzAnimationLayer layer{};
+  layer.animationKey = animation_key;
+  layer.animationTime = 0.f;
+  layer.animationTimeRatio = time_ratio;
+  layer.weight = 0.f;
+  layer.targetWeight = 0.f;
+  layer.weightRate = 0.f;
+  return layer;
+}
+
+void remove_faded_layers(OzzAnimationBlendComponent& blend) {
+  // Order is kept, so that layer indices stay stable for the remaining clips
+  uint32_t write_idx = 0u;
+  for (uint32_t i = 0; i < blend.layerCount; i++) {
+    const OzzAnimationLayer& layer = blend.layers[i];
+    if (layer.weight <= 0.f && layer.targetWeight <= 0.f) {
+      continue;
+    }
+    blend.layers[write_idx++] = layer;
+  }
+  blend.layerCount = write_idx;
+}
+
+int add_layer(OzzAnimationBlendComponent& blend,
+              OzzAnimationBlendUtil::AnimationKey animation_key,
+              float time_ratio, bool drop_lightest) {
+  if (blend.layerCount >= OzzAnimationBlendComponent::kMaxLayers) {
+    if (!drop_lightest) {
+      return -1;
+    }
+
+    uint32_t lightest = 0u;
+    for (uint32_t i = 1; i < blend.layerCount; i++) {
+      if (blend.layers[i].weight < blend.layers[lightest].weight) {
+        lightest = i;
+      }
+    }
+    for (uint32_t i = lightest + 1; i < blend.layerCount; i++) {
+      blend.layers[i - 1] = blend.layers[i];
+    }
+    blend.layerCount--;
+  }
+
+  blend.layers[blend.layerCount] = new_layer(animation_key, time_ratio);
+  return static_cast<int>(blend.layerCount++);
+}
+
+}  // namespace
+
+int OzzAnimationBlendUtil::find_layer(const OzzAnimationBlendComponent& blend,
+                                      AnimationKey animation_key) {
+  for (uint32_t i = 0; i < blend.layerCount; i++) {
+    if (blend.layers[i].animationKey.get_raw_key() ==
+        animation_key.get_raw_key()) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void OzzAnimationBlendUtil::play(OzzAnimationBlendComponent& blend,
+                                 AnimationKey animation_key,
+                                 float time_ratio) {
+  blend.layers[0] = new_layer(animation_key, time_ratio);
+  blend.layers[0].weight = 1.f;
+  blend.layers[0].targetWeight = 1.f;
+  blend.layerCount = 1u;
+}
+
+void OzzAnimationBlendUtil::crossfade_to(OzzAnimationBlendComponent& blend,
+                                         AnimationKey animation_key,
+                                         float duration, float time_ratio) {
+  int target_idx = find_layer(blend, animation_key);
+  if (target_idx < 0) {
+    target_idx = add_layer(blend, animation_key, time_ratio, true);
+  }
+  blend.layers[target_idx].animationTimeRatio = time_ratio;
+
+  // Every layer moves at the same rate, so a half-finished fade back to a
+  //  previous clip takes half the time
+  const float rate = duration > 0.f ? 1.f / duration : 0.f;
+  for (uint32_t i = 0; i < blend.layerCount; i++) {
+    OzzAnimationLayer& layer = blend.layers[i];
+    layer.targetWeight = (i == static_cast<uint32_t>(target_idx)) ? 1.f : 0.f;
+    layer.weightRate = rate;
+    if (duration <= 0.f) {
+      layer.weight = layer.targetWeight;
+    }
+  }
+
+  if (duration <= 0.f) {
+    remove_faded_layers(blend);
+  }
+}
+
+bool OzzAnimationBlendUtil::set_layer_weight(OzzAnimationBlendComponent& blend,
+                                             AnimationKey animation_key,
+                                             float weight, float time_ratio) {
+  int idx = find_layer(blend, animation_key);
+  if (idx < 0) {
+    idx = add_layer(blend, animation_key, time_ratio, false);
+    if (idx < 0) {
+      return false;
+    }
+  }
+
+  OzzAnimationLayer& layer = blend.layers[idx];
+  layer.animationTimeRatio = time_ratio;
+  layer.weight = std::clamp(weight, 0.f, 1.f);
+  layer.targetWeight = layer.weight;
+  layer.weightRate = 0.f;
+  return true;
+}
+
+void OzzAnimationBlendUtil::advance(OzzAnimationBlendComponent& blend,
+                                    float dt) {
+  for (uint32_t i = 0; i < blend.layerCount; i++) {
+    OzzAnimationLayer& layer = blend.layers[i];
+    layer.animationTime += dt;
+
+    const float step = layer.weightRate * dt;
+    if (layer.weight < layer.targetWeight) {
+      layer.weight = std::min(layer.targetWeight, layer.weight + step);
+    } else if (layer.weight > layer.targetWeight) {
+      layer.weight = std::max(layer.targetWeight, layer.weight - step);
+    }
+  }
+
+  remove_faded_layers(blend);
+}
@@ -0,0 +1,44 @@
+#ifndef SANCTIFY_GAME_CLIENT_SRC_ECS_UTILS_OZZ_ANIMATION_BLEND_UTILS_H
+#define SANCTIFY_GAME_CLIENT_SRC_ECS_UTILS_OZZ_ANIMATION_BLEND_UTILS_H
+
+#include <ecs/components/ozz_animation_components.h>
+
+namespace sanctify::ecs {
+
+class OzzAnimationBlendUtil {
+ public:
+  using AnimationKey = ReadonlyResourceRegistry<ozz::animation::Animation>::Key;
+
+  /** Index of the layer playing "animation_key", or -1 */
+  static int find_layer(const OzzAnimationBlendComponent& blend,
+                        AnimationKey animation_key);
+
+  /** Play "animation_key" at full weight right away, dropping other layers */
+  static void play(OzzAnimationBlendComponent& blend,
+                   AnimationKey animation_key, float time_ratio = 1.f);
+
+  /**
+   * Fade "animation_key" in to full weight over "duration" seconds, and every
+   *  other layer out. A clip that is already playing keeps its time, a new one
+   *  starts from the beginning - if every layer is in use, the lightest one is
+   *  dropped to make room.
+   */
+  static void crossfade_to(OzzAnimationBlendComponent& blend,
+                           AnimationKey animation_key, float duration,
+                           float time_ratio = 1.f);
+
+  /**
+   * Set the weight of the layer playing "animation_key" (adding it if needed)
+   *  without fading. Returns false if every layer is in use.
+   */
+  static bool set_layer_weight(OzzAnimationBlendComponent& blend,
+                               AnimationKey animation_key, float weight,
+                               float time_ratio = 1.f);
+
+  /** Advance clip times and crossfades, dropping layers that faded out */
+  static void advance(OzzAnimationBlendComponent& blend, float dt);
+};
+
+}  // namespace sanctify::ecs
+
+#endif
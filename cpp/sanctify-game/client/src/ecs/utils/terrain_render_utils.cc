@@ -26,6 +26,7 @@ ecs::create_ctx_terrain_pipeline(
     entt::registry& world, const wgpu::Device& device,
     asset::IgpackLoader::ExtractWgslShaderPromiseT vs_src_promise,
     asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
+    std::shared_ptr<iggpu::RenderPipelineCache> pipeline_cache,
     std::shared_ptr<indigo::core::TaskList> main_thread_task_list) {
   auto combiner = PromiseCombiner::Create();
 
@@ -33,7 +34,7 @@ ecs::create_ctx_terrain_pipeline(
   auto fs_key = combiner->add(fs_src_promise, main_thread_task_list);
 
   return combiner->combine()->then<Maybe<CreateCtxTerrainRenderableError>>(
-      [vs_key, fs_key, device,
+      [vs_key, fs_key, device, pipeline_cache,
        &world](const PromiseCombiner::PromiseCombinerResult& rsl)
           -> Maybe<CreateCtxTerrainRenderableError> {
         const auto& vs_rsl = rsl.get(vs_key);
@@ -61,7 +62,8 @@ ecs::create_ctx_terrain_pipeline(
           return CreateCtxTerrainRenderableError::PipelineBuildError;
         }
 
-        world.set<CtxTerrainPipeline>(pipeline_builder.move(), empty_maybe{});
+        world.set<CtxTerrainPipeline>(pipeline_builder.move(), empty_maybe{},
+                                      pipeline_cache);
         return empty_maybe{};
       },
       main_thread_task_list);
@@ -77,8 +79,9 @@ terrain_pipeline::TerrainPipeline& ecs::get_terrain_pipeline(
   if (ctx_terrain_pipeline.pipeline.is_empty() ||
       ctx_terrain_pipeline.pipeline.get().OutputFormat != swap_chain_format) {
     ctx_terrain_pipeline.pipeline =
-        ctx_terrain_pipeline.pipelineBuilder.create_pipeline(device,
-                                                             swap_chain_format);
+        ctx_terrain_pipeline.pipelineBuilder.create_pipeline(
+            device, ctx_terrain_pipeline.pipelineCache.get(),
+            swap_chain_format);
   }
 
   return ctx_terrain_pipeline.pipeline.get();
@@ -149,19 +152,28 @@ void ecs::render_all_terrain_renderables(
   }
 }
 
+namespace {
+struct ExtractedTerrainGeo {
+  PodVector<asset::PositionNormalVertexData> Vertices;
+  PodVector<uint32_t> Indices;
+  std::shared_ptr<const picking::TriangleBvh> PickBvh;
+};
+}  // namespace
+
 std::shared_ptr<
     Promise<Either<ReadonlyResourceRegistry<terrain_pipeline::TerrainGeo>::Key,
                    LoadTerrainGeoError>>>
 ecs::load_terrain_geo(
     entt::registry& world, const wgpu::Device& device,
     indigo::asset::IgpackLoader::ExtractDracoBufferPromiseT geo_promise,
-    std::shared_ptr<TaskList> main_thread_task_list) {
-  return geo_promise->then<
-      Either<ReadonlyResourceRegistry<terrain_pipeline::TerrainGeo>::Key,
-             LoadTerrainGeoError>>(
-      [&device, &world](const asset::IgpackLoader::ExtractDracoBufferT& rsl)
-          -> Either<ReadonlyResourceRegistry<terrain_pipeline::TerrainGeo>::Key,
-                    LoadTerrainGeoError> {
+    std::shared_ptr<TaskList> main_thread_task_list,
+    std::shared_ptr<TaskList> async_task_list) {
+  // Vertex/index extraction is independent per mesh, so it stays on the async
+  //  task list - only the GPU upload happens on the main thread
+  auto extract_promise = geo_promise->then<
+      Either<ExtractedTerrainGeo, LoadTerrainGeoError>>(
+      [](const asset::IgpackLoader::ExtractDracoBufferT& rsl)
+          -> Either<ExtractedTerrainGeo, LoadTerrainGeoError> {
         if (rsl.is_right()) {
           Logger::err("ecs::load_terrain_geo")
               << "Asset load error: " << asset::to_string(rsl.get_right());
@@ -170,25 +182,89 @@ ecs::load_terrain_geo(
 
         const auto& decoder = rsl.get_left();
 
-        auto pos_norm_rsl = decoder->get_pos_norm_data();
-        auto indices_rsl = decoder->get_index_data();
+        // Decoded straight into the arrays that are uploaded and picked
+        //  against - the picking BVH needs a CPU copy anyway
+        PodVector<asset::PositionNormalVertexData> vertices(
+            decoder->num_vertices());
+        vertices.resize(decoder->num_vertices());
+        PodVector<uint32_t> indices(decoder->num_indices());
+        indices.resize(decoder->num_indices());
 
-        if (pos_norm_rsl.is_right()) {
+        auto pos_norm_rsl = decoder->write_pos_norm_data(vertices.raw());
+        if (pos_norm_rsl != asset::DracoDecoderResult::Ok) {
           Logger::err("ecs::load_terrain_geo")
               << "Pos-norm vertex buffer extract error: "
-              << asset::to_string(pos_norm_rsl.get_right());
+              << asset::to_string(pos_norm_rsl);
           return right(LoadTerrainGeoError::AssetExtractError);
         }
-        if (indices_rsl.is_right()) {
+        auto indices_rsl = decoder->write_index_data(indices.raw());
+        if (indices_rsl != asset::DracoDecoderResult::Ok) {
           Logger::err("ecs::load_terrain_geo")
               << "Index buffer extract error: "
-              << asset::to_string(pos_norm_rsl.get_right());
+              << asset::to_string(indices_rsl);
           return right(LoadTerrainGeoError::AssetExtractError);
         }
 
+        // Picking BVH build is the slow part of loading terrain - build it here
+        //  while the data is already off the main thread
+        auto pick_bvh = std::make_shared<const picking::TriangleBvh>(
+            picking::TriangleBvh::build(vertices, indices));
+
+        return left(ExtractedTerrainGeo{std::move(vertices),
+                                        std::move(indices),
+                                        std::move(pick_bvh)});
+      },
+      async_task_list);
+
+  return extract_promise->then<
+      Either<ReadonlyResourceRegistry<terrain_pipeline::TerrainGeo>::Key,
+             LoadTerrainGeoError>>(
+      [&device,
+       &world](const Either<ExtractedTerrainGeo, LoadTerrainGeoError>& rsl)
+          -> Either<ReadonlyResourceRegistry<terrain_pipeline::TerrainGeo>::Key,
+                    LoadTerrainGeoError> {
+        if (rsl.is_right()) {
+          return right(rsl.get_right());
+        }
+
+        const ExtractedTerrainGeo& geo = rsl.get_left();
         auto& reg = world.ctx_or_set<CtxTerrainRenderableResources>();
-        return left(reg.geoRegistry.add_resource(terrain_pipeline::TerrainGeo(
-            device, pos_norm_rsl.get_left(), indices_rsl.get_left())));
+        auto key = reg.geoRegistry.add_resource(
+            terrain_pipeline::TerrainGeo(device, geo.Vertices, geo.Indices));
+        reg.pickBvhs[key.get_raw_key()] = geo.PickBvh;
+        return left(key);
       },
       main_thread_task_list);
 }
+
+Maybe<glm::vec3> ecs::pick_terrain(entt::registry& world,
+                                   const picking::PickRay& ray) {
+  auto* reg = world.try_ctx<CtxTerrainRenderableResources>();
+  if (!reg) {
+    return empty_maybe{};
+  }
+
+  // Hit distances are in multiples of the ray direction, which transforming
+  //  the ray into object space preserves - so they compare across renderables
+  float best_t = picking::kNoHit;
+  auto view =
+      world.view<const TerrainRenderableComponent, const MatWorldComponent>();
+  for (auto [e, renderable_component, mat_world] : view.each()) {
+    auto it = reg->pickBvhs.find(renderable_component.geoKey.get_raw_key());
+    if (it == reg->pickBvhs.end() || it->second == nullptr) {
+      continue;
+    }
+
+    auto hit = it->second->raycast(
+        ray.transformed(glm::inverse(mat_world.matWorld)), best_t);
+    if (hit.has_value()) {
+      best_t = hit.get().t;
+    }
+  }
+
+  if (best_t == picking::kNoHit) {
+    return empty_maybe{};
+  }
+
+  return ray.at(best_t);
+}
@@ -1,6 +1,7 @@
 #ifndef SANCTIFY_GAME_CLIENT_SRC_ECS_UTILS_TERRAIN_RENDER_UTILS_H
 #define SANCTIFY_GAME_CLIENT_SRC_ECS_UTILS_TERRAIN_RENDER_UTILS_H
 
+#include <common/picking/pick_ray.h>
 #include <igasset/igpack_loader.h>
 #include <igasync/promise.h>
 #include <igcore/maybe.h>
@@ -30,7 +31,8 @@ std::string to_string(const CreateCtxTerrainRenderableError& err);
 
 /**
  * Method to build a terrain pipeline, and return a promise with either the
- *  error state or resolve empty if pipeline was successfully inserted
+ *  error state or resolve empty if pipeline was successfully inserted.
+ *  Pipelines are created through (and shared with) "pipeline_cache".
  */
 std::shared_ptr<
     indigo::core::Promise<indigo::core::Maybe<CreateCtxTerrainRenderableError>>>
@@ -38,11 +40,13 @@ create_ctx_terrain_pipeline(
     entt::registry& world, const wgpu::Device& device,
     indigo::asset::IgpackLoader::ExtractWgslShaderPromiseT vs_src_promise,
     indigo::asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
+    std::shared_ptr<indigo::iggpu::RenderPipelineCache> pipeline_cache,
     std::shared_ptr<indigo::core::TaskList> main_thread_task_list);
 
 /**
  * Get the current terrain pipeline, re-creating it if the swap chain format has
- *  changed (which under the initial version of WebGPU, it should never do)
+ *  changed (which under the initial version of WebGPU, it should never do).
+ *  Switching back to a format seen before re-uses the cached pipeline.
  */
 terrain_pipeline::TerrainPipeline& get_terrain_pipeline(
     entt::registry& world, const wgpu::Device& device,
@@ -70,7 +74,15 @@ std::shared_ptr<indigo::core::Promise<indigo::core::Either<
 load_terrain_geo(
     entt::registry& world, const wgpu::Device& device,
     indigo::asset::IgpackLoader::ExtractDracoBufferPromiseT geo_promise,
-    std::shared_ptr<indigo::core::TaskList> main_thread_task_list);
+    std::shared_ptr<indigo::core::TaskList> main_thread_task_list,
+    std::shared_ptr<indigo::core::TaskList> async_task_list);
+
+/**
+ * Closest point where "ray" (in world space) hits a terrain renderable, using
+ *  the picking BVHs built by load_terrain_geo. Empty if no terrain is hit.
+ */
+indigo::core::Maybe<glm::vec3> pick_terrain(entt::registry& world,
+                                            const picking::PickRay& ray);
 
 }  // namespace sanctify::ecs
 
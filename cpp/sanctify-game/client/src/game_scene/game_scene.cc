@@ -236,9 +236,15 @@ void GameScene::render() {
   // ECS render system execution (pre-pass buffer updates)
   //
   attach_player_renderables_system_->run(world_);
-  update_ozz_animation_buffers_system_->update_cpu_buffers(world_);
+  {
+    const auto& camera_vs_params = camera_common_vs_ubo_.get_immutable();
+    cull_solid_animated_system_->update(
+        world_, camera_vs_params.matProj * camera_vs_params.matView);
+  }
+  batched_ozz_animation_system_->update(world_);
   update_ozz_animation_buffers_system_->update_gpu_buffers(
-      world_, solid_animated_gpu_.pipeline, device);
+      world_, cull_solid_animated_system_->visible_renderables(),
+      solid_animated_gpu_.pipeline, device);
 
   //
   // MAIN RENDER PASS execution
@@ -278,7 +284,8 @@ void GameScene::render() {
 
   render_solid_renderables_system_->render(
       world_, device, static_geo_pass, solid_animated_gpu_.pipeline,
-      solid_animated_gpu_.sceneInputs, solid_animated_gpu_.frameInputs);
+      solid_animated_gpu_.sceneInputs, solid_animated_gpu_.frameInputs,
+      update_ozz_animation_buffers_system_->animation_inputs());
 
   // TODO (sessamekesh): Run render systems for the player here!
 
@@ -370,9 +377,14 @@ void GameScene::setup_render_systems() {
           game_geometry_key_set_.ybotSkeletonKey,
           game_geometry_key_set_.ybotIdleAnimationKey,
           game_geometry_key_set_.ybotWalkAnimationKey);
+  cull_solid_animated_system_ =
+      std::make_shared<ecs::CullSolidAnimatedSystem>(
+          solid_animated_geo_registry_);
+  batched_ozz_animation_system_ =
+      std::make_shared<ecs::BatchedOzzAnimationSystem>(
+          ozz_skeleton_registry_, ozz_animation_registry_);
   update_ozz_animation_buffers_system_ =
       std::make_shared<ecs::UpdateOzzAnimationBuffersSystem>(
-          ozz_skeleton_registry_, ozz_animation_registry_,
           solid_animated_geo_registry_);
   render_solid_renderables_system_ =
       std::make_shared<ecs::RenderSolidRenderablesSystem>(
@@ -2,6 +2,8 @@
 #define SANCTIFY_GAME_CLIENT_SRC_GAME_SCENE_GAME_SCENE_H
 
 #include <ecs/systems/attach_player_renderables.h>
+#include <ecs/systems/batched_animation_system.h>
+#include <ecs/systems/cull_solid_animated_system.h>
 #include <ecs/systems/destroy_children_system.h>
 #include <ecs/systems/solid_animation_systems.h>
 #include <game_scene/systems/player_move_indicator_render_system.h>
@@ -197,6 +199,9 @@ class GameScene : public ISceneBase,
   ecs::DestroyChildrenSystem destroy_children_system_;
   std::shared_ptr<ecs::SetOzzAnimationKeysSystem>
       set_ozz_animation_keys_system_;
+  std::shared_ptr<ecs::CullSolidAnimatedSystem> cull_solid_animated_system_;
+  std::shared_ptr<ecs::BatchedOzzAnimationSystem>
+      batched_ozz_animation_system_;
   std::shared_ptr<ecs::UpdateOzzAnimationBuffersSystem>
       update_ozz_animation_buffers_system_;
   std::shared_ptr<ecs::RenderSolidRenderablesSystem>
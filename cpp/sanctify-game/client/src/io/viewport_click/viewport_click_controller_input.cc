@@ -18,7 +18,7 @@ void IViewportClickControllerInput::fire_click_event(ClickSurfaceEvent evt) {
 
 Maybe<NavigateToMapLocation> ViewportClickInput::get_frame_action(
     float fovy, float aspect, glm::vec3 camera_direction,
-    glm::vec3 camera_position, glm::vec3 camera_up) {
+    glm::vec3 camera_position, glm::vec3 camera_up, const PickFn& pick_fn) {
   auto maybe_click_evt = input_->get_last_click();
 
   if (maybe_click_evt.is_empty()) {
@@ -31,6 +31,15 @@ Maybe<NavigateToMapLocation> ViewportClickInput::get_frame_action(
       fovy, aspect, camera_direction, camera_up, click_evt.xPercent,
       click_evt.yPercent);
 
+  if (pick_fn) {
+    Maybe<glm::vec3> pick_point =
+        pick_fn(picking::PickRay{camera_position, pick_ray_direction});
+    if (pick_point.has_value()) {
+      return NavigateToMapLocation{
+          glm::vec2{pick_point.get().x, pick_point.get().z}};
+    }
+  }
+
   Maybe<glm::vec3> xz_point =
       camera_util::pick_to_xz_plane(0.f, camera_position, pick_ray_direction);
 
@@ -1,8 +1,10 @@
 #ifndef SANCTIFY_GAME_CLIENT_SRC_IO_VIEWPORT_CLICK_VIEWPORT_CLICK_CONTROLLER_INPUT_H
 #define SANCTIFY_GAME_CLIENT_SRC_IO_VIEWPORT_CLICK_VIEWPORT_CLICK_CONTROLLER_INPUT_H
 
+#include <common/picking/pick_ray.h>
 #include <igcore/maybe.h>
 
+#include <functional>
 #include <glm/glm.hpp>
 #include <memory>
 #include <variant>
@@ -34,12 +36,25 @@ struct NavigateToMapLocation {
 
 class ViewportClickInput {
  public:
+  /**
+   * World space point a pick ray hits (e.g. terrain), or empty if the ray hits
+   *  nothing pickable
+   */
+  using PickFn = std::function<indigo::core::Maybe<glm::vec3>(
+      const picking::PickRay& ray)>;
+
   ViewportClickInput(std::shared_ptr<IViewportClickControllerInput> input)
       : input_(input) {}
 
+  /**
+   * Map location of the last click - the point "pick_fn" finds under the
+   *  cursor, or the point under the cursor on the y=0 plane if there is no
+   *  pick function or it does not find anything
+   */
   indigo::core::Maybe<NavigateToMapLocation> get_frame_action(
       float fovy, float aspect, glm::vec3 camera_direction,
-      glm::vec3 camera_position, glm::vec3 camera_up);
+      glm::vec3 camera_position, glm::vec3 camera_up,
+      const PickFn& pick_fn = nullptr);
 
   void attach();
   void detach();
@@ -1,6 +1,8 @@
 #include <igcore/maybe.h>
 #include <net/reconcile_net_state_system.h>
 
+#include <limits>
+
 using namespace sanctify;
 using namespace indigo;
 using namespace core;
@@ -24,60 +26,120 @@ void maybe_tag(entt::entity entity, entt::registry& world, Maybe<T> tag) {
   }
 }
 
+// Copy of "snapshot" that only holds predicted entities
+GameSnapshot predicted_subset(const GameSnapshot& snapshot) {
+  GameSnapshot subset{};
+  subset.snapshot_time(snapshot.snapshot_time());
+  subset.snapshot_id(snapshot.snapshot_id());
+
+  for (uint32_t id : snapshot.alive_entities()) {
+    if (!ReconcileNetStateSystem::is_predicted(snapshot, id)) {
+      continue;
+    }
+
+    subset.add(id, snapshot.map_location(id));
+    subset.add(id, snapshot.nav_waypoint_list(id));
+    subset.add(id, snapshot.standard_navigation_params(id));
+    subset.add(id, snapshot.basic_player_component(id));
+    subset.add(id, snapshot.orientation(id));
+  }
+
+  return subset;
+}
+
+// Same as EnttSnapshotTranslator::read_all_game_state, but only for predicted
+//  entities (remote entities are never reconciled)
+EnttSnapshotTranslator::ReadAllGameStateResult read_predicted_client_state(
+    entt::registry& world, float simulation_time) {
+  GameSnapshot snapshot{};
+  snapshot.snapshot_time(simulation_time);
+  snapshot.snapshot_id(0);
+
+  Bimap<uint32_t, entt::entity> entityBimap;
+
+  auto view = world.view<const component::BasicPlayerComponent,
+                         const component::NetSyncId>();
+
+  for (auto [entity, net_sync] : view.each()) {
+    snapshot.add(net_sync.Id,
+                 maybe_from_nullable_ptr(
+                     world.try_get<component::MapLocation>(entity)));
+    snapshot.add(net_sync.Id,
+                 maybe_from_nullable_ptr(
+                     world.try_get<component::NavWaypointList>(entity)));
+    snapshot.add(net_sync.Id,
+                 maybe_from_nullable_ptr(
+                     world.try_get<component::StandardNavigationParams>(
+                         entity)));
+    snapshot.add(net_sync.Id, Maybe<component::BasicPlayerComponent>(
+                                  component::BasicPlayerComponent{}));
+    snapshot.add(net_sync.Id,
+                 maybe_from_nullable_ptr(
+                     world.try_get<component::OrientationComponent>(entity)));
+
+    entityBimap.insert(net_sync.Id, entity);
+  }
+
+  return {snapshot, entityBimap};
+}
+
 }  // namespace
 
-ReconcileNetStateSystem::ReconcileNetStateSystem() {}
+ReconcileNetStateSystem::ReconcileNetStateSystem(
+    float interpolation_delay_seconds)
+    : interpolation_delay_seconds_(interpolation_delay_seconds),
+      newest_snapshot_time_(std::numeric_limits<float>::lowest()),
+      pending_predicted_snapshot_(empty_maybe{}),
+      slot_entities_(64),
+      sampled_positions_(64),
+      sampled_orientations_(64) {}
+
+bool ReconcileNetStateSystem::is_predicted(const GameSnapshot& snapshot,
+                                           uint32_t net_sync_id) {
+  // The protocol does not say which player is local, so every player is
+  //  predicted - they are also the only entities with client-side animation
+  //  driven by their nav waypoints
+  return snapshot.basic_player_component(net_sync_id).has_value();
+}
 
 void ReconcileNetStateSystem::advance_time_to_and_maybe_reconcile(
     entt::registry& client_world,
     std::function<void(entt::registry& server_sim, float dt)>
         update_client_sim_cb,
     float client_sim_time) {
-  auto last_matching_it = snapshots_.end();
-
-  for (auto it = snapshots_.begin(); it != snapshots_.end();) {
-    if (it->snapshot.snapshot_time() <= client_sim_time) {
-      last_matching_it = it++;
-      if (it != snapshots_.end() &&
-          it->snapshot.snapshot_time() <= client_sim_time) {
-        snapshots_.erase(last_matching_it);
-        last_matching_it = snapshots_.end();
-      }
-    } else {
-      break;
-    }
+  if (pending_predicted_snapshot_.has_value() &&
+      pending_predicted_snapshot_.get().snapshot_time() <= client_sim_time) {
+    reconcile_client_state(client_world, client_sim_time, update_client_sim_cb,
+                           pending_predicted_snapshot_.get());
+    pending_predicted_snapshot_ = empty_maybe{};
   }
 
-  if (last_matching_it == snapshots_.end()) {
-    // No snapshots found before the future point
-    return;
-  }
-
-  reconcile_client_state(client_world, client_sim_time, update_client_sim_cb,
-                         last_matching_it->snapshot);
+  interpolate_remote_entities(client_world, client_sim_time);
 }
 
 void ReconcileNetStateSystem::register_server_snapshot(
     const GameSnapshot& server_snapshot, float client_sim_time) {
-  // If this snapshot is in the past and there is a more recent snapshot,
-  // discard this one
-  for (auto it = snapshots_.begin(); it != snapshots_.end(); it++) {
-    if (it->snapshot.snapshot_time() <= client_sim_time &&
-        it->snapshot.snapshot_time() > server_snapshot.snapshot_time()) {
-      // Snapshot is in the past, but we have a more recent snapshot - discard
-      // this one
-      return;
-    }
+  // Only the newest snapshot is ever reconciled, and the interpolation buffer
+  //  only takes snapshots in order - anything older than what has already
+  //  been seen is useless
+  if (server_snapshot.snapshot_time() <= newest_snapshot_time_) {
+    return;
+  }
+  newest_snapshot_time_ = server_snapshot.snapshot_time();
 
-    if (it->snapshot.snapshot_time() > client_sim_time) {
-      // Future snapshots should be rare, and also not considered here. This
-      // snapshot should be added.
-      break;
+  if (interpolation_buffer_.begin_snapshot(server_snapshot.snapshot_time())) {
+    for (uint32_t id : server_snapshot.alive_entities()) {
+      if (is_predicted(server_snapshot, id)) {
+        continue;
+      }
+
+      interpolation_buffer_.add(id, server_snapshot.map_location(id),
+                                server_snapshot.orientation(id));
     }
+    interpolation_buffer_.end_snapshot();
   }
 
-  // TODO (sessamekesh): This sorting takes too long!
-  snapshots_.insert({server_snapshot});
+  pending_predicted_snapshot_ = ::predicted_subset(server_snapshot);
 }
 
 void ReconcileNetStateSystem::reconcile_client_state(
@@ -94,8 +156,8 @@ void ReconcileNetStateSystem::reconcile_client_state(
       snapshot_translator_
           .read_all_game_state(server_state_, 0, client_sim_time)
           .gameSnapshot;
-  auto current_client_state = snapshot_translator_.read_all_game_state(
-      client_world, 0, client_sim_time);
+  auto current_client_state =
+      ::read_predicted_client_state(client_world, client_sim_time);
 
   GameSnapshotDiff client_diff = GameSnapshot::CreateDiff(
       current_client_state.gameSnapshot, current_server_snapshot);
@@ -181,12 +243,77 @@ void ReconcileNetStateSystem::reconcile_client_state(
   }
 }
 
-bool ReconcileNetStateSystem::TimeSnapshot::operator<(
-    const ReconcileNetStateSystem::TimeSnapshot& o) const {
-  return snapshot.snapshot_time() < o.snapshot.snapshot_time();
-}
+void ReconcileNetStateSystem::interpolate_remote_entities(
+    entt::registry& client_world, float client_sim_time) {
+  // Entities stay until the interpolated time reaches the snapshot that
+  //  dropped them, so they are drawn all the way to their last known state
+  const float sample_time = client_sim_time - interpolation_delay_seconds_;
+  interpolation_buffer_.release_departed(sample_time);
 
-bool ReconcileNetStateSystem::TimeSnapshot::operator==(
-    const ReconcileNetStateSystem::TimeSnapshot& o) const {
-  return snapshot.snapshot_time() == o.snapshot.snapshot_time();
+  //
+  // Spawn/despawn - releases first, an ID can come back in the same batch
+  //
+  const PodVector<uint32_t>& removed_ids = interpolation_buffer_.removed_ids();
+  for (int i = 0; i < removed_ids.size(); i++) {
+    auto it = remote_entities_.find(removed_ids[i]);
+    if (it == remote_entities_.end()) {
+      continue;
+    }
+
+    if (client_world.valid(it->second)) {
+      client_world.destroy(it->second);
+    }
+    remote_entities_.erase(it);
+  }
+
+  slot_entities_.resize(interpolation_buffer_.slot_count());
+
+  const PodVector<uint32_t>& added_ids = interpolation_buffer_.added_ids();
+  for (int i = 0; i < added_ids.size(); i++) {
+    uint32_t net_sync_id = added_ids[i];
+    uint32_t slot = interpolation_buffer_.slot_of(net_sync_id);
+    if (slot == SnapshotInterpolationBuffer::kNoSlot ||
+        remote_entities_.count(net_sync_id) > 0) {
+      continue;
+    }
+
+    entt::entity e = client_world.create();
+    client_world.emplace<component::NetSyncId>(e, net_sync_id);
+    client_world.emplace<component::MapLocation>(e, glm::vec2(0.f));
+    client_world.emplace<component::OrientationComponent>(e, 0.f);
+
+    remote_entities_.emplace(net_sync_id, e);
+    slot_entities_[slot] = e;
+  }
+
+  interpolation_buffer_.clear_changes();
+
+  if (interpolation_buffer_.snapshot_count() == 0u) {
+    return;
+  }
+
+  //
+  // Move every remote entity to the interpolated state
+  //
+  interpolation_buffer_.sample(sample_time, sampled_positions_,
+                               sampled_orientations_);
+
+  for (uint32_t slot = 0; slot < interpolation_buffer_.slot_count(); slot++) {
+    if (!interpolation_buffer_.is_live(slot)) {
+      continue;
+    }
+
+    entt::entity e = slot_entities_[slot];
+    if (!client_world.valid(e)) {
+      continue;
+    }
+
+    if (auto* map_location = client_world.try_get<component::MapLocation>(e)) {
+      map_location->XZ = sampled_positions_[slot];
+    }
+    if (auto* orientation =
+            client_world.try_get<component::OrientationComponent>(e)) {
+      orientation->orientation = sampled_orientations_[slot];
+    }
+  }
 }
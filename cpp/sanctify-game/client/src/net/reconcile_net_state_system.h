@@ -2,19 +2,37 @@
 #define SANCTIFY_GAME_CLIENT_SRC_GAME_SCENE_NET_RECONCILE_NET_STATE_SYSTEM_H
 
 #include <igcore/bimap.h>
+#include <igcore/maybe.h>
 #include <igcore/vector.h>
 #include <sanctify-game-common/gameplay/net_sync_components.h>
 #include <sanctify-game-common/net/entt_snapshot_translator.h>
 #include <sanctify-game-common/net/game_snapshot.h>
+#include <sanctify-game-common/net/snapshot_interpolation_buffer.h>
 
 #include <entt/entt.hpp>
-#include <set>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * Applies server snapshots to the client world.
+ *
+ * Predicted entities (players - see is_predicted) are re-simulated from the
+ *  most recent snapshot up to the client time and reconciled with the client
+ *  world. Every other (remote) entity is placed from an interpolation buffer of
+ *  recent snapshots, a fixed delay behind the client time, so receiving a
+ *  snapshot only costs a write into the buffer for them.
+ */
 
 namespace sanctify {
 
 class ReconcileNetStateSystem {
  public:
-  ReconcileNetStateSystem();
+  // Remote entities are drawn this far behind the client clock, so that there
+  //  is usually a snapshot on either side of the render time
+  static constexpr float kDefaultInterpolationDelaySeconds = 0.1f;
+
+  ReconcileNetStateSystem(
+      float interpolation_delay_seconds = kDefaultInterpolationDelaySeconds);
 
   void advance_time_to_and_maybe_reconcile(
       entt::registry& client_world,
@@ -24,24 +42,45 @@ class ReconcileNetStateSystem {
   void register_server_snapshot(const GameSnapshot& server_snapshot,
                                 float client_sim_time);
 
+  /**
+   * Re-simulate "server_snapshot" up to the client time, and correct the
+   *  client world to match. Every entity in it is treated as predicted - pass
+   *  the predicted subset that register_server_snapshot keeps.
+   */
   void reconcile_client_state(
       entt::registry& client_world, float client_sim_time,
       std::function<void(entt::registry& server_sim, float dt)>
           update_client_sim_cb,
       const GameSnapshot& server_snapshot);
 
+  /** Spawn/despawn remote entities and move them to the interpolated state */
+  void interpolate_remote_entities(entt::registry& client_world,
+                                   float client_sim_time);
+
+  /** Predicted entities are fully simulated on the client */
+  static bool is_predicted(const GameSnapshot& snapshot, uint32_t net_sync_id);
+
+  const SnapshotInterpolationBuffer& interpolation_buffer() const {
+    return interpolation_buffer_;
+  }
+
  private:
   entt::registry server_state_;
 
- public:
-  struct TimeSnapshot {
-    GameSnapshot snapshot;
+  float interpolation_delay_seconds_;
+  float newest_snapshot_time_;
 
-    bool operator<(const TimeSnapshot& o) const;
-    bool operator==(const TimeSnapshot& o) const;
-  };
+  // Predicted entities of the newest snapshot that has not been reconciled
+  //  yet (if any)
+  indigo::core::Maybe<GameSnapshot> pending_predicted_snapshot_;
 
-  std::set<TimeSnapshot> snapshots_;
+  // Remote entities - client entity by net sync ID, and by interpolation
+  //  buffer slot for the per-frame update
+  SnapshotInterpolationBuffer interpolation_buffer_;
+  std::unordered_map<uint32_t, entt::entity> remote_entities_;
+  indigo::core::PodVector<entt::entity> slot_entities_;
+  indigo::core::PodVector<glm::vec2> sampled_positions_;
+  indigo::core::PodVector<float> sampled_orientations_;
 
   EnttSnapshotTranslator snapshot_translator_;
 };
@@ -1,13 +1,8 @@
 #include "movement_indicator_render_system.h"
 
-#include <ecs/components/common_render_components.h>
-#include <ecs/components/debug_geo_render_components.h>
+#include <ecs/utils/debug_geo_render_utils.h>
 #include <pve_game_scene/ecs/client_config.h>
 #include <pve_game_scene/ecs/utils.h>
-#include <pve_game_scene/render/debug_geo_resources.h>
-#include <render/debug_geo/debug_geo.h>
-
-#include <glm/gtc/matrix_transform.hpp>
 
 using namespace sanctify;
 using namespace pve;
@@ -17,35 +12,10 @@ struct MovementIndicator {
   float t;
   glm::vec3 location;
 };
-
-ecs::DebugGeoRenderable& get_renderable(entt::registry& world, entt::entity e) {
-  ecs::DebugGeoRenderable* renderable =
-      world.try_get<ecs::DebugGeoRenderable>(e);
-  if (renderable != nullptr) {
-    return *renderable;
-  }
-
-  auto& resources = world.ctx<pve::CtxDebugGeoGeoResources>();
-  return world.emplace<ecs::DebugGeoRenderable>(e, resources.unitCubeKey);
-}
-
-ecs::MatWorldComponent& get_mat_world(entt::registry& world, entt::entity e) {
-  ecs::MatWorldComponent* c = world.try_get<ecs::MatWorldComponent>(e);
-
-  if (c != nullptr) {
-    return *c;
-  }
-
-  return world.emplace<ecs::MatWorldComponent>(e, glm::mat4(1.f));
-}
-
 }  // namespace
 
 bool MovementIndicatorRenderSystem::is_ready(entt::registry& world) {
-  bool has_debug_geo_geo_resources =
-      world.try_ctx<pve::CtxDebugGeoGeoResources>();
-
-  return has_debug_geo_geo_resources;
+  return ecs::DebugGeoRenderUtil::get_debug_draw_list(world) != nullptr;
 }
 
 void MovementIndicatorRenderSystem::add_indicator(entt::registry& world,
@@ -61,6 +31,8 @@ void MovementIndicatorRenderSystem::add_indicator(entt::registry& world,
 void MovementIndicatorRenderSystem::update(entt::registry& world, float dt) {
   auto& config = world.ctx_or_set<ClientConfigComponent>();
 
+  auto* draw_list = ecs::DebugGeoRenderUtil::get_debug_draw_list(world);
+
   auto view = world.view<::MovementIndicator>();
 
   for (auto [e, movement_indicator] : view.each()) {
@@ -70,8 +42,9 @@ void MovementIndicatorRenderSystem::update(entt::registry& world, float dt) {
       continue;
     }
 
-    auto& renderable = ::get_renderable(world, e);
-    auto& mat_world_component = ::get_mat_world(world, e);
+    if (draw_list == nullptr) {
+      continue;
+    }
 
     float t = 1.f - movement_indicator.t /
                         config.moveIndicatorRenderParams.lifetimeSeconds;
@@ -80,10 +53,7 @@ void MovementIndicatorRenderSystem::update(entt::registry& world, float dt) {
     glm::vec3 color = t * config.moveIndicatorRenderParams.endColor +
                       (1.f - t) * config.moveIndicatorRenderParams.startColor;
 
-    mat_world_component.matWorld =
-        glm::translate(glm::mat4(1.f), movement_indicator.location);
-    mat_world_component.matWorld =
-        glm::scale(mat_world_component.matWorld, glm::vec3(scale));
-    renderable.objectColor = color;
+    draw_list->box(movement_indicator.location, glm::vec3(scale),
+                   render::DebugDrawList::pack_color(color));
   }
 }
@@ -1,6 +1,7 @@
 #include "glfw_io_system.h"
 
 #include <GLFW/glfw3.h>
+#include <ecs/utils/terrain_render_utils.h>
 #include <igcore/log.h>
 #include <io/arena_camera_controller/arena_camera_mouse_input_listener.h>
 #include <io/glfw_event_emitter.h>
@@ -112,5 +113,8 @@ Maybe<NavigateToMapLocation> GlfwIoSystem::get_map_nav_event(
   return listeners->viewportClickInput->get_frame_action(
       camera->fovy, camera->aspectRatio,
       camera->arenaCamera.look_at() - camera->arenaCamera.position(),
-      camera->arenaCamera.position(), camera->arenaCamera.screen_up());
+      camera->arenaCamera.position(), camera->arenaCamera.screen_up(),
+      [&world](const picking::PickRay& ray) {
+        return ecs::pick_terrain(world, ray);
+      });
 }
@@ -62,7 +62,8 @@ std::shared_ptr<Promise<bool>> pve::load_pve_scene(
   indigo::asset::IgpackLoader base_shaders_igpack_loader(
       "resources/base-shader-sources.igpack", async_task_list);
   indigo::asset::IgpackLoader terrain_igpack_loader(
-      "resources/pve-terrain-geo.igpack", async_task_list);
+      "resources/pve-terrain-geo.igpack", async_task_list,
+      indigo::asset::IgpackLoader::StreamingParams{});
   indigo::asset::IgpackLoader terrain_shaders_loader(
       "resources/terrain-shaders.igpack", async_task_list);
 
@@ -79,17 +80,21 @@ std::shared_ptr<Promise<bool>> pve::load_pve_scene(
       "debug3dVertWgsl", async_task_list);
   auto debug_geo_fs_promise = base_shaders_igpack_loader.extract_wgsl_shader(
       "debug3dFragWgsl", async_task_list);
+  auto debug_draw_vs_promise = base_shaders_igpack_loader.extract_wgsl_shader(
+      "debugDrawVertWgsl", async_task_list);
+  auto debug_draw_fs_promise = base_shaders_igpack_loader.extract_wgsl_shader(
+      "debugDrawFragWgsl", async_task_list);
 
   //
   // Run all the preliminary setup actions
   //
   auto ctx_pipeline_promise = ecs::create_ctx_terrain_pipeline(
       world, app_base->Device, terrain_vs_promise, terrain_fs_promise,
-      main_thread_task_list);
+      app_base->PipelineCache, main_thread_task_list);
   auto terrain_base_geo_resources_promise = ctx_pipeline_promise->then_chain<
       Maybe<LoadCtxTerrainBaseGeoResourceError>>(
-      [app_base, &world, terrain_base_geo_promise,
-       main_thread_task_list](const auto& rsl) {
+      [app_base, &world, terrain_base_geo_promise, main_thread_task_list,
+       async_task_list](const auto& rsl) {
         if (rsl.has_value()) {
           return Promise<Maybe<LoadCtxTerrainBaseGeoResourceError>>::immediate(
               LoadCtxTerrainBaseGeoResourceError::PipelineMissingError);
@@ -98,13 +103,18 @@ std::shared_ptr<Promise<bool>> pve::load_pve_scene(
         return pve::load_ctx_terrain_base_geo_resources(
             app_base->Device, world,
             app_base->preferred_swap_chain_texture_format(),
-            terrain_base_geo_promise, main_thread_task_list);
+            terrain_base_geo_promise, main_thread_task_list,
+            async_task_list);
       },
       async_task_list);
   auto debug_geo_pipeline_promise =
       ecs::DebugGeoRenderUtil::init_pipeline_builder(
           world, app_base->Device, debug_geo_vs_promise, debug_geo_fs_promise,
           main_thread_task_list);
+  auto debug_draw_pipeline_promise =
+      ecs::DebugGeoRenderUtil::init_debug_draw_pipeline_builder(
+          world, app_base->Device, debug_draw_vs_promise,
+          debug_draw_fs_promise, main_thread_task_list);
 
   //
   // Synchronous work (setup sync resources). Do this on main thread promises to
@@ -130,13 +140,15 @@ std::shared_ptr<Promise<bool>> pve::load_pve_scene(
       combiner->add(ctx_pipeline_promise, async_task_list);
   auto debug_geo_pipeline_key =
       combiner->add(debug_geo_pipeline_promise, async_task_list);
+  auto debug_draw_pipeline_key =
+      combiner->add(debug_draw_pipeline_promise, async_task_list);
   auto terrain_base_geo_key =
       combiner->add(terrain_base_geo_resources_promise, async_task_list);
   combiner->add(main_thread_work, main_thread_task_list);
 
   return combiner->combine()->then<bool>(
       [terrain_pipeline_key, terrain_base_geo_key, debug_geo_pipeline_key,
-       &world,
+       debug_draw_pipeline_key, &world,
        app_base](const PromiseCombiner::PromiseCombinerResult& rsl) -> bool {
         bool has_error = false;
 
@@ -144,6 +156,8 @@ std::shared_ptr<Promise<bool>> pve::load_pve_scene(
         ::load_check(rsl, terrain_base_geo_key, has_error, "terrain_base_geo");
         ::load_check(rsl, debug_geo_pipeline_key, has_error,
                      "debug_geo_pipeline");
+        ::load_check(rsl, debug_draw_pipeline_key, has_error,
+                     "debug_draw_pipeline");
 
         // If an upstream dependency has failed entirely, don't even bother
         // trying to do any of the creation stuff.
@@ -157,6 +171,9 @@ std::shared_ptr<Promise<bool>> pve::load_pve_scene(
         ecs::DebugGeoRenderUtil::init_pipeline(
             world, app_base->Device,
             app_base->preferred_swap_chain_texture_format());
+        ecs::DebugGeoRenderUtil::init_debug_draw_pipeline(
+            world, app_base->Device,
+            app_base->preferred_swap_chain_texture_format());
         pve::DebugGeoResourceUtil::initialize_debug_geo_ctx(world,
                                                             app_base->Device);
         pve::DebugGeoResourceUtil::initialize_debug_geo_geo_resources(
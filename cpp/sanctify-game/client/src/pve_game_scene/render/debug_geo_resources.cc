@@ -16,6 +16,11 @@ void DebugGeoResourceUtil::initialize_debug_geo_ctx(
       pipeline.create_scene_inputs(device, common_resources.commonLightingUbo),
       pipeline.create_frame_inputs(device, common_resources.cameraCommonVsUbo,
                                    common_resources.cameraCommonFsUbo));
+
+  auto& debug_draw_pipeline =
+      ecs::DebugGeoRenderUtil::get_debug_draw_pipeline(world);
+  world.set<CtxDebugDrawBindGroups>(debug_draw_pipeline.create_frame_inputs(
+      device, common_resources.cameraCommonVsUbo));
 }
 
 void DebugGeoResourceUtil::initialize_debug_geo_geo_resources(
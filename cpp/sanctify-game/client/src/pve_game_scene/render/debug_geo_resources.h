@@ -1,6 +1,7 @@
 #ifndef SANCTIFY_GAME_CLIENT_PVE_GAME_SCENE_RENDER_DEBUG_GEO_RESOURCES_H
 #define SANCTIFY_GAME_CLIENT_PVE_GAME_SCENE_RENDER_DEBUG_GEO_RESOURCES_H
 
+#include <render/debug_geo/debug_draw_pipeline.h>
 #include <render/debug_geo/debug_geo.h>
 #include <render/debug_geo/debug_geo_pipeline.h>
 #include <util/resource_registry.h>
@@ -24,6 +25,10 @@ struct CtxDebugGeoBindGroups {
   debug_geo::FramePipelineInputs frameInputs;
 };
 
+struct CtxDebugDrawBindGroups {
+  debug_geo::DebugDrawFrameInputs frameInputs;
+};
+
 class DebugGeoResourceUtil {
  public:
   static void initialize_debug_geo_ctx(entt::registry& world,
@@ -99,6 +99,12 @@ void GameRenderSystem::render(const wgpu::Device& device, entt::registry& world,
     ecs::DebugGeoRenderUtil::render_all_debug_geo_renderables(util, world,
                                                               device);
   }
+  // Immediate mode debug primitives...
+  {
+    auto& bind_groups = world.ctx<CtxDebugDrawBindGroups>();
+    ecs::DebugGeoRenderUtil::render_debug_draw(main_pass, world, device,
+                                               bind_groups.frameInputs);
+  }
   // TODO (sessamekesh): Create
 
   main_pass.End();
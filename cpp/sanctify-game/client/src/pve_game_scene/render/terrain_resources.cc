@@ -14,12 +14,14 @@ pve::load_ctx_terrain_base_geo_resources(
     const wgpu::Device& device, entt::registry& world,
     wgpu::TextureFormat swap_chain_format,
     asset::IgpackLoader::ExtractDracoBufferPromiseT pve_arena_promise,
-    std::shared_ptr<TaskList> main_thread_task_list) {
+    std::shared_ptr<TaskList> main_thread_task_list,
+    std::shared_ptr<TaskList> async_task_list) {
   auto combiner = PromiseCombiner::Create();
 
   auto arena_base_key =
       combiner->add(ecs::load_terrain_geo(world, device, pve_arena_promise,
-                                          main_thread_task_list),
+                                          main_thread_task_list,
+                                          async_task_list),
                     main_thread_task_list);
 
   return combiner->combine()->then<Maybe<LoadCtxTerrainBaseGeoResourceError>>(
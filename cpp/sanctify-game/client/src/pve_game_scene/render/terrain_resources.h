@@ -30,7 +30,8 @@ load_ctx_terrain_base_geo_resources(
     const wgpu::Device& device, entt::registry& world,
     wgpu::TextureFormat swap_chain_format,
     indigo::asset::IgpackLoader::ExtractDracoBufferPromiseT pve_arena_promise,
-    std::shared_ptr<indigo::core::TaskList> main_thread_task_list);
+    std::shared_ptr<indigo::core::TaskList> main_thread_task_list,
+    std::shared_ptr<indigo::core::TaskList> async_task_list);
 
 //
 // Frame/scene bind groups
@@ -0,0 +1,204 @@
+#include <iggpu/util.h>
+#include <render/debug_geo/debug_draw_pipeline.h>
+
+using namespace sanctify;
+using namespace debug_geo;
+
+using namespace indigo;
+using namespace core;
+using namespace iggpu;
+
+namespace {
+// Line list vertices per instance - see debug_draw.vert.wgsl
+const uint32_t kLineVertexCount = 2u;
+const uint32_t kCircleVertexCount = render::DebugDrawList::kCircleSegments * 2u;
+const uint32_t kBoxVertexCount = 24u;
+
+wgpu::BindGroup create_camera_bind_group(
+    const wgpu::Device& device, const wgpu::RenderPipeline& pipeline,
+    const render::CameraCommonVsUbo& camera_common_vs_ubo, const char* label) {
+  Vector<wgpu::BindGroupEntry> bind_group_entries(1);
+  bind_group_entries.push_back(::buffer_bind_group_entry(
+      0, camera_common_vs_ubo.buffer(), camera_common_vs_ubo.size()));
+
+  auto bind_group_desc = ::bind_group_desc(
+      bind_group_entries, pipeline.GetBindGroupLayout(0), label);
+
+  return device.CreateBindGroup(&bind_group_desc);
+}
+
+uint32_t get_instance_capacity(uint32_t count) {
+  uint32_t capacity = 256u;
+  while (capacity < count) {
+    capacity *= 2u;
+  }
+  return capacity;
+}
+
+}  // namespace
+
+DebugDrawFrameInputs DebugDrawPipeline::create_frame_inputs(
+    const wgpu::Device& device,
+    const render::CameraCommonVsUbo& camera_common_vs_ubo) const {
+  return DebugDrawFrameInputs{
+      ::create_camera_bind_group(device, linePipeline, camera_common_vs_ubo,
+                                 "debug-draw-line-frame-inputs"),
+      ::create_camera_bind_group(device, circlePipeline, camera_common_vs_ubo,
+                                 "debug-draw-circle-frame-inputs"),
+      ::create_camera_bind_group(device, boxPipeline, camera_common_vs_ubo,
+                                 "debug-draw-box-frame-inputs")};
+}
+
+Maybe<DebugDrawPipelineBuilder> DebugDrawPipelineBuilder::Create(
+    const wgpu::Device& device, const indigo::asset::pb::WgslSource& vs_src,
+    const indigo::asset::pb::WgslSource& fs_src) {
+  return DebugDrawPipelineBuilder(
+      ::create_shader_module(device, vs_src.shader_source()),
+      ::create_shader_module(device, fs_src.shader_source()),
+      fs_src.entry_point());
+}
+
+DebugDrawPipelineBuilder::DebugDrawPipelineBuilder(
+    wgpu::ShaderModule vert_module, wgpu::ShaderModule frag_module,
+    std::string fs_entry_point)
+    : vert_module_(vert_module),
+      frag_module_(frag_module),
+      fs_entry_point_(fs_entry_point) {}
+
+DebugDrawPipeline DebugDrawPipelineBuilder::create_pipeline(
+    const wgpu::Device& device, wgpu::TextureFormat swap_chain_format) const {
+  using render::DebugBoxInstance;
+  using render::DebugCircleInstance;
+  using render::DebugLineInstance;
+
+  PodVector<wgpu::VertexAttribute> line_attributes(3);
+  line_attributes.push_back(::vertex_attribute(
+      0, wgpu::VertexFormat::Float32x3, offsetof(DebugLineInstance, start)));
+  line_attributes.push_back(::vertex_attribute(
+      1, wgpu::VertexFormat::Float32x3, offsetof(DebugLineInstance, end)));
+  line_attributes.push_back(::vertex_attribute(
+      2, wgpu::VertexFormat::Unorm8x4, offsetof(DebugLineInstance, color)));
+
+  PodVector<wgpu::VertexAttribute> circle_attributes(3);
+  circle_attributes.push_back(::vertex_attribute(
+      0, wgpu::VertexFormat::Float32x3, offsetof(DebugCircleInstance, center)));
+  circle_attributes.push_back(::vertex_attribute(
+      1, wgpu::VertexFormat::Float32, offsetof(DebugCircleInstance, radius)));
+  circle_attributes.push_back(::vertex_attribute(
+      2, wgpu::VertexFormat::Unorm8x4, offsetof(DebugCircleInstance, color)));
+
+  PodVector<wgpu::VertexAttribute> box_attributes(3);
+  box_attributes.push_back(::vertex_attribute(
+      0, wgpu::VertexFormat::Float32x3, offsetof(DebugBoxInstance, center)));
+  box_attributes.push_back(
+      ::vertex_attribute(1, wgpu::VertexFormat::Float32x3,
+                         offsetof(DebugBoxInstance, halfExtents)));
+  box_attributes.push_back(::vertex_attribute(
+      2, wgpu::VertexFormat::Unorm8x4, offsetof(DebugBoxInstance, color)));
+
+  DebugDrawPipeline pipeline{};
+  pipeline.outputFormat = swap_chain_format;
+  pipeline.linePipeline = create_primitive_pipeline(
+      device, swap_chain_format, "DebugDrawLinePipeline", kLineEntryPoint,
+      ::vertex_buffer_layout(line_attributes, sizeof(DebugLineInstance),
+                             wgpu::VertexStepMode::Instance));
+  pipeline.circlePipeline = create_primitive_pipeline(
+      device, swap_chain_format, "DebugDrawCirclePipeline",
+      kCircleEntryPoint,
+      ::vertex_buffer_layout(circle_attributes, sizeof(DebugCircleInstance),
+                             wgpu::VertexStepMode::Instance));
+  pipeline.boxPipeline = create_primitive_pipeline(
+      device, swap_chain_format, "DebugDrawBoxPipeline", kBoxEntryPoint,
+      ::vertex_buffer_layout(box_attributes, sizeof(DebugBoxInstance),
+                             wgpu::VertexStepMode::Instance));
+
+  return pipeline;
+}
+
+wgpu::RenderPipeline DebugDrawPipelineBuilder::create_primitive_pipeline(
+    const wgpu::Device& device, wgpu::TextureFormat swap_chain_format,
+    const char* label, const char* vs_entry_point,
+    const wgpu::VertexBufferLayout& instance_layout) const {
+  wgpu::ColorTargetState color_target_state{};
+  color_target_state.format = swap_chain_format;
+
+  wgpu::FragmentState fragment_state = ::standard_fragment_state(
+      color_target_state, frag_module_, fs_entry_point_.c_str());
+
+  wgpu::DepthStencilState depth_stencil_state =
+      ::depth_stencil_state_standard();
+
+  wgpu::RenderPipelineDescriptor desc{};
+  desc.label = label;
+  desc.vertex.buffers = &instance_layout;
+  desc.vertex.bufferCount = 1;
+  desc.vertex.module = vert_module_;
+  desc.vertex.entryPoint = vs_entry_point;
+  desc.fragment = &fragment_state;
+  desc.primitive.topology = wgpu::PrimitiveTopology::LineList;
+  desc.depthStencil = &depth_stencil_state;
+  desc.primitive.cullMode = wgpu::CullMode::None;
+
+  return device.CreateRenderPipeline(&desc);
+}
+
+DebugDrawBuffers::DebugDrawBuffers()
+    : lines_{nullptr, 0u, 0u},
+      circles_{nullptr, 0u, 0u},
+      boxes_{nullptr, 0u, 0u} {}
+
+void DebugDrawBuffers::upload(const wgpu::Device& device,
+                              const render::DebugDrawList& list) {
+  upload_instances(device, lines_, list.lines().data(), list.lines().size(),
+                   sizeof(render::DebugLineInstance));
+  upload_instances(device, circles_, list.circles().data(),
+                   list.circles().size(), sizeof(render::DebugCircleInstance));
+  upload_instances(device, boxes_, list.boxes().data(), list.boxes().size(),
+                   sizeof(render::DebugBoxInstance));
+}
+
+void DebugDrawBuffers::upload_instances(const wgpu::Device& device,
+                                        InstanceBuffer& instance_buffer,
+                                        const void* data, uint32_t count,
+                                        uint32_t stride) {
+  instance_buffer.count = count;
+  if (count == 0u) {
+    return;
+  }
+
+  if (count > instance_buffer.capacity) {
+    instance_buffer.capacity = ::get_instance_capacity(count);
+    instance_buffer.buffer = iggpu::create_empty_buffer(
+        device, instance_buffer.capacity * stride, wgpu::BufferUsage::Vertex);
+  }
+
+  // WriteBuffer sizes must be a multiple of 4 bytes, which every instance
+  //  stride is
+  device.GetQueue().WriteBuffer(instance_buffer.buffer, 0, data,
+                                static_cast<uint64_t>(count) * stride);
+}
+
+void DebugDrawBuffers::draw(const wgpu::RenderPassEncoder& pass,
+                            const DebugDrawPipeline& pipeline,
+                            const DebugDrawFrameInputs& frame_inputs) const {
+  if (lines_.count > 0u) {
+    pass.SetPipeline(pipeline.linePipeline);
+    pass.SetBindGroup(0, frame_inputs.lineBindGroup);
+    pass.SetVertexBuffer(0, lines_.buffer);
+    pass.Draw(::kLineVertexCount, lines_.count);
+  }
+
+  if (circles_.count > 0u) {
+    pass.SetPipeline(pipeline.circlePipeline);
+    pass.SetBindGroup(0, frame_inputs.circleBindGroup);
+    pass.SetVertexBuffer(0, circles_.buffer);
+    pass.Draw(::kCircleVertexCount, circles_.count);
+  }
+
+  if (boxes_.count > 0u) {
+    pass.SetPipeline(pipeline.boxPipeline);
+    pass.SetBindGroup(0, frame_inputs.boxBindGroup);
+    pass.SetVertexBuffer(0, boxes_.buffer);
+    pass.Draw(::kBoxVertexCount, boxes_.count);
+  }
+}
@@ -0,0 +1,100 @@
+#ifndef SANCTIFY_GAME_CLIENT_SRC_RENDER_DEBUG_GEO_DEBUG_DRAW_PIPELINE_H
+#define SANCTIFY_GAME_CLIENT_SRC_RENDER_DEBUG_GEO_DEBUG_DRAW_PIPELINE_H
+
+#include <common/render/debug_draw/debug_draw_list.h>
+#include <igasset/proto/igasset.pb.h>
+#include <igcore/maybe.h>
+#include <render/common/camera_ubo.h>
+#include <webgpu/webgpu_cpp.h>
+
+#include <string>
+
+/**
+ * Draws the contents of a render::DebugDrawList - one line list pipeline per
+ *  primitive type, expanded from per-instance data in the vertex shader so
+ *  each primitive type is one instanced draw call with no geometry buffers.
+ */
+
+namespace sanctify::debug_geo {
+
+struct DebugDrawFrameInputs {
+  wgpu::BindGroup lineBindGroup;
+  wgpu::BindGroup circleBindGroup;
+  wgpu::BindGroup boxBindGroup;
+};
+
+struct DebugDrawPipeline {
+  wgpu::TextureFormat outputFormat;
+  wgpu::RenderPipeline linePipeline;
+  wgpu::RenderPipeline circlePipeline;
+  wgpu::RenderPipeline boxPipeline;
+
+  DebugDrawFrameInputs create_frame_inputs(
+      const wgpu::Device& device,
+      const render::CameraCommonVsUbo& camera_common_vs_ubo) const;
+};
+
+class DebugDrawPipelineBuilder {
+ public:
+  // Vertex shader entry points - all three live in the same WGSL source
+  static constexpr const char* kLineEntryPoint = "line_main";
+  static constexpr const char* kCircleEntryPoint = "circle_main";
+  static constexpr const char* kBoxEntryPoint = "box_main";
+
+  static indigo::core::Maybe<DebugDrawPipelineBuilder> Create(
+      const wgpu::Device& device, const indigo::asset::pb::WgslSource& vs_src,
+      const indigo::asset::pb::WgslSource& fs_src);
+
+  DebugDrawPipelineBuilder(wgpu::ShaderModule vert_module,
+                           wgpu::ShaderModule frag_module,
+                           std::string fs_entry_point);
+
+  DebugDrawPipeline create_pipeline(
+      const wgpu::Device& device, wgpu::TextureFormat swap_chain_format) const;
+
+ private:
+  wgpu::RenderPipeline create_primitive_pipeline(
+      const wgpu::Device& device, wgpu::TextureFormat swap_chain_format,
+      const char* label, const char* vs_entry_point,
+      const wgpu::VertexBufferLayout& instance_layout) const;
+
+  wgpu::ShaderModule vert_module_;
+  wgpu::ShaderModule frag_module_;
+
+  std::string fs_entry_point_;
+};
+
+/**
+ * GPU copies of a DebugDrawList's instance arrays - each is re-uploaded with
+ *  one buffer write per frame, and only re-allocated when it grows
+ */
+class DebugDrawBuffers {
+ public:
+  DebugDrawBuffers();
+
+  void upload(const wgpu::Device& device, const render::DebugDrawList& list);
+
+  void draw(const wgpu::RenderPassEncoder& pass,
+            const DebugDrawPipeline& pipeline,
+            const DebugDrawFrameInputs& frame_inputs) const;
+
+ private:
+  struct InstanceBuffer {
+    wgpu::Buffer buffer;
+    uint32_t capacity;
+    uint32_t count;
+  };
+
+  static void upload_instances(const wgpu::Device& device,
+                               InstanceBuffer& instance_buffer,
+                               const void* data, uint32_t count,
+                               uint32_t stride);
+
+  InstanceBuffer lines_;
+  InstanceBuffer circles_;
+  InstanceBuffer boxes_;
+};
+
+}  // namespace sanctify::debug_geo
+
+#endif
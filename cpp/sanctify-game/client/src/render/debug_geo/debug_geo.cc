@@ -113,8 +113,8 @@ InstanceBuffer::InstanceBuffer(const wgpu::Device& device)
       numInstances(0),
       capacity(4) {}
 
-std::string InstanceKey::get_key() const {
-  return std::to_string(geoKey.get_raw_key()) + ":" + std::to_string(lifetime);
-}
+uint32_t InstanceKey::get_slot() const { return geoKey.get_raw_index(); }
+
+uint32_t InstanceKey::get_generation() const { return geoKey.get_raw_key(); }
 
 int InstanceKey::get_lifetime() const { return lifetime; }
@@ -44,7 +44,8 @@ struct InstanceKey {
   ReadonlyResourceRegistry<debug_geo::DebugGeo>::Key geoKey;
   int lifetime;
 
-  std::string get_key() const;
+  uint32_t get_slot() const;
+  uint32_t get_generation() const;
   int get_lifetime() const;
 };
 
@@ -170,8 +170,9 @@ RenderUtil& RenderUtil::set_instances(const InstanceBuffer& instance_buffer) {
 }
 
 RenderUtil& RenderUtil::set_instances(const wgpu::Buffer& buffer,
-                                      uint32_t num_instances) {
-  pass_.SetVertexBuffer(1, buffer);
+                                      uint32_t num_instances,
+                                      uint64_t offset) {
+  pass_.SetVertexBuffer(1, buffer, offset);
   num_instances_ = num_instances;
   return *this;
 }
@@ -67,7 +67,8 @@ class RenderUtil {
   RenderUtil& set_frame_inputs(const FramePipelineInputs& inputs);
   RenderUtil& set_geometry(const DebugGeo& geo);
   RenderUtil& set_instances(const InstanceBuffer& instances);
-  RenderUtil& set_instances(const wgpu::Buffer& buffer, uint32_t num_instances);
+  RenderUtil& set_instances(const wgpu::Buffer& buffer, uint32_t num_instances,
+                            uint64_t offset = 0u);
   RenderUtil& draw();
 
  private:
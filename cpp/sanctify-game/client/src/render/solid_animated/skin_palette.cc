@@ -0,0 +1,37 @@
+#include <render/solid_animated/skin_palette.h>
+
+using namespace sanctify;
+using namespace solid_animated;
+
+SkinPalette::SkinPalette(uint32_t initial_capacity)
+    : matrices_(initial_capacity) {}
+
+void SkinPalette::reset() { matrices_.resize(0); }
+
+uint32_t SkinPalette::add(const ozz::math::Float4x4* models,
+                          const glm::mat4* inv_bind_poses,
+                          uint32_t joint_count) {
+  const uint32_t offset = static_cast<uint32_t>(matrices_.size());
+  matrices_.resize(offset + joint_count);
+  SkinMatrix4x3* out = matrices_.raw() + offset;
+
+  for (uint32_t i = 0; i < joint_count; i++) {
+    // glm and ozz are both column major, glm is just not SIMD aligned
+    const float* inv_bind_cols = &inv_bind_poses[i][0][0];
+    const ozz::math::Float4x4 inv_bind = {
+        {ozz::math::simd_float4::LoadPtrU(inv_bind_cols),
+         ozz::math::simd_float4::LoadPtrU(inv_bind_cols + 4),
+         ozz::math::simd_float4::LoadPtrU(inv_bind_cols + 8),
+         ozz::math::simd_float4::LoadPtrU(inv_bind_cols + 12)}};
+
+    // Columns of the transpose are rows of the skin matrix - the last row is
+    //  always (0, 0, 0, 1) and is dropped
+    const ozz::math::Float4x4 skin =
+        ozz::math::Transpose(models[i] * inv_bind);
+    ozz::math::StorePtrU(skin.cols[0], out[i].rows[0]);
+    ozz::math::StorePtrU(skin.cols[1], out[i].rows[1]);
+    ozz::math::StorePtrU(skin.cols[2], out[i].rows[2]);
+  }
+
+  return offset;
+}
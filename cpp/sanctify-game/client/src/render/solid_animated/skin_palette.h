@@ -0,0 +1,52 @@
+#ifndef SANCTIFY_GAME_CLIENT_SRC_RENDER_SOLID_ANIMATED_SKIN_PALETTE_H
+#define SANCTIFY_GAME_CLIENT_SRC_RENDER_SOLID_ANIMATED_SKIN_PALETTE_H
+
+#include <igcore/pod_vector.h>
+#include <ozz/base/maths/simd_math.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+/**
+ * Skinning matrix palette for one frame - the skin matrices (model space joint
+ *  transform * inverse bind pose) of every animated renderable, back to back,
+ *  so the whole frame goes to the GPU in one write.
+ *
+ * Skin matrices are affine, so only the top three rows are stored (48 bytes
+ *  instead of 64). No GPU types in here - see
+ *  SolidAnimatedPipeline::update_animation_inputs for the upload.
+ */
+
+namespace sanctify::solid_animated {
+
+// Rows of a row-major 4x3 affine transform - matches SkinMatrix in
+//  solid_animated.vert.wgsl
+struct SkinMatrix4x3 {
+  float rows[3][4];
+};
+
+class SkinPalette {
+ public:
+  SkinPalette(uint32_t initial_capacity = 256u);
+
+  void reset();
+
+  /**
+   * Append "joint_count" skin matrices, returns the index of the first (the
+   *  palette offset the renderable's bone indices are relative to)
+   */
+  uint32_t add(const ozz::math::Float4x4* models,
+               const glm::mat4* inv_bind_poses, uint32_t joint_count);
+
+  uint32_t size() const { return static_cast<uint32_t>(matrices_.size()); }
+  const indigo::core::PodVector<SkinMatrix4x3>& matrices() const {
+    return matrices_;
+  }
+
+ private:
+  indigo::core::PodVector<SkinMatrix4x3> matrices_;
+};
+
+}  // namespace sanctify::solid_animated
+
+#endif
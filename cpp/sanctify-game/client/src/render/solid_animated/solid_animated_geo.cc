@@ -41,7 +41,8 @@ SolidAnimatedGeo::SolidAnimatedGeo(
           iggpu::buffer_from_data(device, indices, wgpu::BufferUsage::Index)),
       NumIndices(indices.size()),
       IndexFormat(wgpu::IndexFormat::Uint32),
-      invBindPoses(std::move(inv_bind_poses)) {}
+      invBindPoses(std::move(inv_bind_poses)),
+      bounds(render::BoundingSphere::from_positions(vertices)) {}
 
 void MatWorldInstanceBuffer::update_index_data(
     const wgpu::Device& device,
@@ -1,6 +1,7 @@
 #ifndef SANCTIFY_GAME_CLIENT_SRC_RENDER_SOLID_ANIMATED_SOLID_ANIMATED_GEO_H
 #define SANCTIFY_GAME_CLIENT_SRC_RENDER_SOLID_ANIMATED_SOLID_ANIMATED_GEO_H
 
+#include <common/render/visibility/frustum_cull.h>
 #include <igasset/vertex_formats.h>
 #include <igcore/pod_vector.h>
 #include <webgpu/webgpu_cpp.h>
@@ -16,6 +17,9 @@ struct SolidAnimatedGeo {
 
   indigo::core::PodVector<glm::mat4> invBindPoses;
 
+  // Model space bounds of the bind pose (from vertex positions)
+  render::BoundingSphere bounds;
+
   SolidAnimatedGeo(
       const wgpu::Device& device,
       const indigo::core::PodVector<indigo::asset::PositionNormalVertexData>&
@@ -28,6 +32,9 @@ struct SolidAnimatedGeo {
 
 struct MatWorldInstanceData {
   glm::mat4 MatWorld;
+
+  // Index of this instance's first skin matrix in the frame's SkinPalette
+  uint32_t SkinPaletteOffset;
 };
 
 struct MatWorldInstanceBuffer {
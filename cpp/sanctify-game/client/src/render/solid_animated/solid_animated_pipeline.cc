@@ -1,6 +1,8 @@
 #include <igcore/pod_vector.h>
 #include <render/solid_animated/solid_animated_pipeline.h>
 
+#include <algorithm>
+
 using namespace indigo;
 using namespace iggpu;
 using namespace sanctify;
@@ -70,22 +72,42 @@ MaterialPipelineInputs SolidAnimatedPipeline::create_material_inputs(
 }
 
 AnimationPipelineInputs SolidAnimatedPipeline::create_animation_inputs(
-    const wgpu::Device& device) const {
+    const wgpu::Device& device, uint32_t capacity) const {
   wgpu::BindGroupLayout per_skin_layout = Pipeline.GetBindGroupLayout(3);
 
-  ThinUbo skin_matrices_ubo(
-      sizeof(glm::mat4) * SolidAnimatedPipeline::kMaxBonesCount, device);
+  capacity = std::max(capacity, 1u);
+  wgpu::Buffer skin_palette_buffer = create_empty_buffer(
+      device, capacity * sizeof(SkinMatrix4x3), wgpu::BufferUsage::Storage);
 
   core::Vector<wgpu::BindGroupEntry> bind_group_entries(1);
   bind_group_entries.push_back(::buffer_bind_group_entry(
-      0, skin_matrices_ubo.buffer(), skin_matrices_ubo.size()));
+      0, skin_palette_buffer, capacity * sizeof(SkinMatrix4x3)));
   auto bind_group_desc =
       ::bind_group_desc(bind_group_entries, per_skin_layout,
                         "solid-animated-pipeline-animation-inputs");
 
   wgpu::BindGroup bind_group = device.CreateBindGroup(&bind_group_desc);
 
-  return AnimationPipelineInputs{bind_group, std::move(skin_matrices_ubo)};
+  return AnimationPipelineInputs{bind_group, skin_palette_buffer, capacity};
+}
+
+void SolidAnimatedPipeline::update_animation_inputs(
+    const wgpu::Device& device, AnimationPipelineInputs& inputs,
+    const SkinPalette& palette) const {
+  if (palette.size() == 0u) {
+    return;
+  }
+
+  if (palette.size() > inputs.Capacity) {
+    // Grow by half again, so a slowly growing crowd does not re-create the
+    //  buffer every frame
+    inputs = create_animation_inputs(device,
+                                     palette.size() + palette.size() / 2u);
+  }
+
+  device.GetQueue().WriteBuffer(inputs.SkinPaletteBuffer, 0,
+                                palette.matrices().raw(),
+                                palette.matrices().raw_size());
 }
 
 RenderUtil::RenderUtil(const wgpu::RenderPassEncoder& pass,
@@ -97,7 +119,8 @@ RenderUtil::RenderUtil(const wgpu::RenderPassEncoder& pass,
       animation_inputs_set_(false),
       material_inputs_set_(false),
       num_indices_(-1),
-      num_instances_(-1) {
+      num_instances_(-1),
+      first_instance_(0u) {
   pass_.SetPipeline(pipeline.Pipeline);
 }
 
@@ -139,13 +162,21 @@ RenderUtil& RenderUtil::set_instances(
     const MatWorldInstanceBuffer& instance_buffer) {
   pass_.SetVertexBuffer(1, instance_buffer.InstanceBuffer);
   num_instances_ = instance_buffer.NumInstances;
+  first_instance_ = 0u;
+  return *this;
+}
+
+RenderUtil& RenderUtil::set_instance_range(uint32_t first_instance,
+                                           uint32_t num_instances) {
+  first_instance_ = first_instance;
+  num_instances_ = static_cast<int32_t>(num_instances);
   return *this;
 }
 
 RenderUtil& RenderUtil::draw() {
   if (frame_inputs_set_ && scene_inputs_set_ && material_inputs_set_ &&
       animation_inputs_set_ && num_indices_ > 0 && num_instances_ > 0) {
-    pass_.DrawIndexed(num_indices_, num_instances_);
+    pass_.DrawIndexed(num_indices_, num_instances_, 0, 0, first_instance_);
   }
 
   return *this;
@@ -183,7 +214,7 @@ SolidAnimatedPipeline SolidAnimatedPipelineBuilder::create_pipeline(
 
   core::PodVector<wgpu::VertexAttribute> geo_attributes(2);
   core::PodVector<wgpu::VertexAttribute> anim_attributes(2);
-  core::PodVector<wgpu::VertexAttribute> mat_world_instance_attributes(4);
+  core::PodVector<wgpu::VertexAttribute> mat_world_instance_attributes(5);
 
   geo_attributes.push_back(
       ::vertex_attribute(0, wgpu::VertexFormat::Float32x3, 0));
@@ -209,9 +240,12 @@ SolidAnimatedPipeline SolidAnimatedPipelineBuilder::create_pipeline(
       ::vertex_attribute(4, wgpu::VertexFormat::Float32x4, 32));
   mat_world_instance_attributes.push_back(
       ::vertex_attribute(5, wgpu::VertexFormat::Float32x4, 48));
+  mat_world_instance_attributes.push_back(
+      ::vertex_attribute(8, wgpu::VertexFormat::Uint32, 64));
 
   wgpu::VertexBufferLayout mat_world_layout = ::vertex_buffer_layout(
-      mat_world_instance_attributes, 64, wgpu::VertexStepMode::Instance);
+      mat_world_instance_attributes, sizeof(MatWorldInstanceData),
+      wgpu::VertexStepMode::Instance);
 
   wgpu::VertexBufferLayout vb_layouts[] = {geo_layout, mat_world_layout,
                                            anim_layout};
@@ -6,6 +6,7 @@
 #include <iggpu/thin_ubo.h>
 #include <iggpu/ubo_base.h>
 #include <render/common/camera_ubo.h>
+#include <render/solid_animated/skin_palette.h>
 #include <render/solid_animated/solid_animated_geo.h>
 #include <webgpu/webgpu_cpp.h>
 
@@ -44,11 +45,13 @@ struct MaterialPipelineInputs {
   indigo::iggpu::UboBase<SolidColorParamsUboData> SolidColorParams;
 };
 
-// Pipeline inputs that change per animation state (skeleton params)
+// Pipeline inputs that change per frame with animation (the skin matrices of
+//  every animated renderable, see SkinPalette)
 struct AnimationPipelineInputs {
   wgpu::BindGroup AnimationBindGroup;
 
-  indigo::iggpu::ThinUbo SkinMatricesUbo;
+  wgpu::Buffer SkinPaletteBuffer;
+  uint32_t Capacity;
 };
 
 struct SolidAnimatedPipeline {
@@ -68,8 +71,14 @@ struct SolidAnimatedPipeline {
                                           float specular_power) const;
   MaterialPipelineInputs create_material_inputs(const wgpu::Device& device,
                                                 glm::vec3 object_color) const;
-  AnimationPipelineInputs create_animation_inputs(
-      const wgpu::Device& device) const;
+  AnimationPipelineInputs create_animation_inputs(const wgpu::Device& device,
+                                                  uint32_t capacity) const;
+
+  // One buffer write for the whole palette - re-creates the inputs (and bind
+  //  group) if the palette has outgrown them
+  void update_animation_inputs(const wgpu::Device& device,
+                               AnimationPipelineInputs& inputs,
+                               const SkinPalette& palette) const;
 };
 
 class SolidAnimatedPipelineBuilder {
@@ -109,6 +118,10 @@ class RenderUtil {
   RenderUtil& set_animation_inputs(const AnimationPipelineInputs& inputs);
   RenderUtil& set_geometry(const SolidAnimatedGeo& geo);
   RenderUtil& set_instances(const MatWorldInstanceBuffer& instances);
+
+  // Draw only part of the bound instance buffer (e.g. one RenderQueue batch)
+  RenderUtil& set_instance_range(uint32_t first_instance,
+                                 uint32_t num_instances);
   RenderUtil& draw();
 
  private:
@@ -122,6 +135,7 @@ class RenderUtil {
 
   int32_t num_indices_;
   int32_t num_instances_;
+  uint32_t first_instance_;
 };
 
 }  // namespace sanctify::solid_animated
@@ -125,20 +125,27 @@ core::Maybe<TerrainPipelineBuilder> TerrainPipelineBuilder::Create(
   return TerrainPipelineBuilder(
       ::create_shader_module(device, vs_src.shader_source()),
       ::create_shader_module(device, fs_src.shader_source()),
-      vs_src.entry_point(), fs_src.entry_point());
+      vs_src.entry_point(), fs_src.entry_point(),
+      iggpu::RenderPipelineCache::hash_source(vs_src.shader_source()),
+      iggpu::RenderPipelineCache::hash_source(fs_src.shader_source()));
 }
 
 TerrainPipelineBuilder::TerrainPipelineBuilder(wgpu::ShaderModule vert_module,
                                                wgpu::ShaderModule frag_module,
                                                std::string vs_entry_point,
-                                               std::string fs_entry_point)
+                                               std::string fs_entry_point,
+                                               uint64_t vs_src_hash,
+                                               uint64_t fs_src_hash)
     : vert_module_(vert_module),
       frag_module_(frag_module),
       vs_entry_point_(vs_entry_point),
-      fs_entry_point_(fs_entry_point) {}
+      fs_entry_point_(fs_entry_point),
+      vs_src_hash_(vs_src_hash),
+      fs_src_hash_(fs_src_hash) {}
 
 TerrainPipeline TerrainPipelineBuilder::create_pipeline(
-    const wgpu::Device& device, wgpu::TextureFormat swap_chain_format) const {
+    const wgpu::Device& device, iggpu::RenderPipelineCache* cache,
+    wgpu::TextureFormat swap_chain_format) const {
   wgpu::ColorTargetState color_target_state{};
   color_target_state.format = swap_chain_format;
 
@@ -191,7 +198,9 @@ TerrainPipeline TerrainPipelineBuilder::create_pipeline(
   desc.primitive.cullMode = wgpu::CullMode::Back;
   desc.primitive.frontFace = wgpu::FrontFace::CCW;
 
-  auto gpu_pipeline = device.CreateRenderPipeline(&desc);
+  uint64_t key =
+      iggpu::RenderPipelineCache::key_of(desc, vs_src_hash_, fs_src_hash_);
+  auto gpu_pipeline = cache->get_or_create(device, desc, key);
 
   TerrainPipeline pipeline{};
   pipeline.OutputFormat = swap_chain_format;
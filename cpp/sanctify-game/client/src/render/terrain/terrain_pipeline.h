@@ -3,6 +3,7 @@
 
 #include <igasset/proto/igasset.pb.h>
 #include <igcore/either.h>
+#include <iggpu/render_pipeline_cache.h>
 #include <iggpu/ubo_base.h>
 #include <render/common/camera_ubo.h>
 #include <render/terrain/terrain_geo.h>
@@ -96,9 +97,12 @@ class TerrainPipelineBuilder {
   TerrainPipelineBuilder(wgpu::ShaderModule vert_module,
                          wgpu::ShaderModule frag_module,
                          std::string vs_entry_point,
-                         std::string fs_entry_point);
+                         std::string fs_entry_point, uint64_t vs_src_hash,
+                         uint64_t fs_src_hash);
 
+  // Blocks until built, unless "cache" already has an identical pipeline
   TerrainPipeline create_pipeline(const wgpu::Device& device,
+                                  indigo::iggpu::RenderPipelineCache* cache,
                                   wgpu::TextureFormat swap_chain_format) const;
 
  private:
@@ -107,6 +111,10 @@ class TerrainPipelineBuilder {
 
   std::string vs_entry_point_;
   std::string fs_entry_point_;
+
+  // See RenderPipelineCache::key_of
+  uint64_t vs_src_hash_;
+  uint64_t fs_src_hash_;
 };
 
 }  // namespace sanctify::terrain_pipeline
@@ -37,6 +37,10 @@ class ReadonlyResourceRegistry {
     // Careful using this directly
     uint32_t get_raw_key() const { return key_; }
 
+    // Slot in the registry - re-used once the resource is removed, so pair it
+    //  with get_raw_key() to tell resources apart
+    uint32_t get_raw_index() const { return index_; }
+
     bool operator==(const Key& o) { return ~key_ && (key_ == o.key_); }
 
     friend class ReadonlyResourceRegistry;
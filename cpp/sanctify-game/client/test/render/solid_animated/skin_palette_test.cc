@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <render/solid_animated/skin_palette.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+using namespace sanctify;
+using namespace solid_animated;
+
+namespace {
+
+// Column major, same as glm
+ozz::math::Float4x4 to_ozz(const glm::mat4& m) {
+  const float* cols = &m[0][0];
+  return ozz::math::Float4x4{{ozz::math::simd_float4::LoadPtrU(cols),
+                              ozz::math::simd_float4::LoadPtrU(cols + 4),
+                              ozz::math::simd_float4::LoadPtrU(cols + 8),
+                              ozz::math::simd_float4::LoadPtrU(cols + 12)}};
+}
+
+// A skeleton's worth of distinct joint transforms - rotated, scaled and
+//  translated differently for every joint and frame
+struct TestJoints {
+  std::vector<glm::mat4> models;
+  std::vector<ozz::math::Float4x4> ozzModels;
+  std::vector<glm::mat4> invBindPoses;
+};
+
+TestJoints make_joints(uint32_t count, float seed) {
+  TestJoints joints;
+  for (uint32_t i = 0; i < count; i++) {
+    float t = seed + static_cast<float>(i);
+    glm::mat4 model = glm::translate(glm::mat4(1.f),
+                                     glm::vec3(t, 2.f * t, -0.5f * t));
+    model = glm::rotate(model, 0.3f * t, glm::vec3(0.f, 1.f, 0.f));
+    model = glm::scale(model, glm::vec3(1.f + 0.1f * t));
+
+    glm::mat4 bind = glm::translate(glm::mat4(1.f),
+                                    glm::vec3(0.f, 0.25f * t, 0.f));
+    bind = glm::rotate(bind, -0.2f * t, glm::vec3(1.f, 0.f, 0.f));
+
+    joints.models.push_back(model);
+    joints.ozzModels.push_back(::to_ozz(model));
+    joints.invBindPoses.push_back(glm::inverse(bind));
+  }
+  return joints;
+}
+
+void expect_packed(const SkinPalette& palette, uint32_t offset,
+                   const TestJoints& joints) {
+  for (uint32_t i = 0; i < joints.models.size(); i++) {
+    // Model space joint transform * inverse bind pose, top three rows
+    const glm::mat4 expected = joints.models[i] * joints.invBindPoses[i];
+    const SkinMatrix4x3& packed = palette.matrices()[offset + i];
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 4; col++) {
+        EXPECT_NEAR(packed.rows[row][col], expected[col][row], 1e-4f)
+            << "joint " << i << ", row " << row << ", col " << col;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(SkinPalette, PacksSkinMatrixRows) {
+  SkinPalette palette(16u);
+  TestJoints joints = ::make_joints(5u, 0.f);
+
+  uint32_t offset = palette.add(joints.ozzModels.data(),
+                                joints.invBindPoses.data(), 5u);
+
+  EXPECT_EQ(offset, 0u);
+  ASSERT_EQ(palette.size(), 5u);
+  ::expect_packed(palette, 0u, joints);
+}
+
+TEST(SkinPalette, RenderablesAreBackToBack) {
+  SkinPalette palette(16u);
+  TestJoints a = ::make_joints(3u, 1.f);
+  TestJoints b = ::make_joints(4u, 7.f);
+
+  uint32_t a_offset =
+      palette.add(a.ozzModels.data(), a.invBindPoses.data(), 3u);
+  uint32_t b_offset =
+      palette.add(b.ozzModels.data(), b.invBindPoses.data(), 4u);
+
+  EXPECT_EQ(a_offset, 0u);
+  EXPECT_EQ(b_offset, 3u);
+  ASSERT_EQ(palette.size(), 7u);
+  ::expect_packed(palette, a_offset, a);
+  ::expect_packed(palette, b_offset, b);
+}
+
+TEST(SkinPalette, GrowsAcrossFrames) {
+  // Starts far too small for any frame below
+  SkinPalette palette(2u);
+
+  // Frame 1 - grows past the initial capacity mid-frame
+  TestJoints first = ::make_joints(3u, 0.f);
+  TestJoints second = ::make_joints(6u, 3.f);
+  palette.add(first.ozzModels.data(), first.invBindPoses.data(), 3u);
+  uint32_t second_offset =
+      palette.add(second.ozzModels.data(), second.invBindPoses.data(), 6u);
+  ASSERT_EQ(palette.size(), 9u);
+  ::expect_packed(palette, 0u, first);
+  ::expect_packed(palette, second_offset, second);
+
+  // Frame 2 - starts over, and grows further than frame 1 did
+  palette.reset();
+  EXPECT_EQ(palette.size(), 0u);
+
+  TestJoints big = ::make_joints(40u, 11.f);
+  uint32_t big_offset =
+      palette.add(big.ozzModels.data(), big.invBindPoses.data(), 40u);
+  EXPECT_EQ(big_offset, 0u);
+  ASSERT_EQ(palette.size(), 40u);
+  ::expect_packed(palette, 0u, big);
+
+  // Frame 3 - smaller again, nothing left over from earlier frames
+  palette.reset();
+  TestJoints small = ::make_joints(2u, 5.f);
+  palette.add(small.ozzModels.data(), small.invBindPoses.data(), 2u);
+  ASSERT_EQ(palette.size(), 2u);
+  ::expect_packed(palette, 0u, small);
+}
@@ -25,6 +25,9 @@ struct OrientationComponent {
 struct NavWaypointList {
   indigo::core::PodVector<glm::vec2> Targets;
 
+  // Index of the next target - reached targets are skipped, not erased
+  uint32_t Cursor = 0u;
+
   bool operator==(const NavWaypointList& o) const;
 };
 
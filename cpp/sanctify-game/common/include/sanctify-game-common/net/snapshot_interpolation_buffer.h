@@ -0,0 +1,151 @@
+#ifndef SANCTIFY_GAME_COMMON_INCLUDE_SANCTIFY_GAME_COMMON_NET_SNAPSHOT_INTERPOLATION_BUFFER_H
+#define SANCTIFY_GAME_COMMON_INCLUDE_SANCTIFY_GAME_COMMON_NET_SNAPSHOT_INTERPOLATION_BUFFER_H
+
+/**
+ * Snapshot interpolation buffer - keeps the map location and orientation of
+ *  every entity in the last few server snapshots, so that entities the client
+ *  does not predict can be placed between the two snapshots around the render
+ *  time (or extrapolated a short way past the newest one) instead of
+ *  re-simulating the whole world every time a snapshot arrives.
+ *
+ * State is stored SoA: one array per field, with a row per snapshot (in a ring
+ *  of the last N snapshots) and a column ("slot") per entity. Slots are looked
+ *  up by net sync ID when a snapshot is written. An entity missing from the
+ *  newest snapshot keeps its slot until the sample time passes that snapshot,
+ *  so it is drawn up to its last known state. Sampling walks the columns of
+ *  two rows.
+ */
+
+#include <igcore/maybe.h>
+#include <igcore/pod_vector.h>
+#include <sanctify-game-common/gameplay/locomotion_components.h>
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+
+namespace sanctify {
+
+class SnapshotInterpolationBuffer {
+ public:
+  static constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+
+  SnapshotInterpolationBuffer(uint32_t history_length = 8u,
+                              float max_extrapolation_seconds = 0.25f);
+
+  //
+  // Writing - begin a snapshot, add every entity in it, then end it. Entities
+  //  that are not added depart at that snapshot's time, and are released by
+  //  the first release_departed call at or past it.
+  //
+
+  /**
+   * Returns false (and ignores every add until the next begin_snapshot) if
+   *  the snapshot is not newer than the newest one already in the buffer
+   */
+  bool begin_snapshot(float snapshot_time);
+  void add(uint32_t net_sync_id,
+           const indigo::core::Maybe<component::MapLocation>& map_location,
+           const indigo::core::Maybe<component::OrientationComponent>&
+               orientation);
+  void end_snapshot();
+
+  /**
+   * Release entities that departed in a snapshot at or before "time" (the
+   *  time about to be sampled) - they show up in removed_ids
+   */
+  void release_departed(float time);
+
+  /** Forget every snapshot and entity */
+  void clear();
+
+  //
+  // Sampling
+  //
+
+  /**
+   * Interpolate every live entity to "time" - outputs are indexed by slot, and
+   *  entries for slots that are not live are left untouched. Times past the
+   *  newest snapshot are extrapolated from the last two snapshots (up to the
+   *  max extrapolation time), times before the oldest snapshot are clamped.
+   */
+  void sample(float time, indigo::core::PodVector<glm::vec2>& o_positions,
+              indigo::core::PodVector<float>& o_orientations) const;
+
+  //
+  // Entities (slots) and snapshots
+  //
+  uint32_t slot_count() const { return slot_ids_.size(); }
+  bool is_live(uint32_t slot) const { return slot_live_[slot] != kSlotFree; }
+  uint32_t net_sync_id(uint32_t slot) const { return slot_ids_[slot]; }
+  uint32_t slot_of(uint32_t net_sync_id) const;
+  uint32_t live_count() const {
+    return static_cast<uint32_t>(slot_of_id_.size());
+  }
+
+  uint32_t snapshot_count() const { return row_count_; }
+  float newest_time() const;
+  float oldest_time() const;
+
+  /**
+   * Net sync IDs that became live / were released since the last call to
+   *  clear_changes. An ID that was released and came back shows up in both,
+   *  and an ID that came and went shows up in both but is not live - apply
+   *  releases first, then check is_live for additions.
+   */
+  const indigo::core::PodVector<uint32_t>& added_ids() const {
+    return added_ids_;
+  }
+  const indigo::core::PodVector<uint32_t>& removed_ids() const {
+    return removed_ids_;
+  }
+  void clear_changes();
+
+ private:
+  // Per-row flags (one byte per slot per row) - kPresent is set on every
+  //  entity added to the row, whatever components it has
+  static constexpr uint8_t kHasLocation = 0b001;
+  static constexpr uint8_t kHasOrientation = 0b010;
+  static constexpr uint8_t kPresent = 0b100;
+
+  // slot_live_ values - departing slots are still sampled
+  static constexpr uint8_t kSlotFree = 0u;
+  static constexpr uint8_t kSlotLive = 1u;
+  static constexpr uint8_t kSlotDeparting = 2u;
+
+  uint32_t allocate_slot(uint32_t net_sync_id);
+  void grow_slots(uint32_t slot_capacity);
+
+  uint32_t row(uint32_t age) const;
+  uint32_t cell(uint32_t row, uint32_t slot) const {
+    return row * slot_capacity_ + slot;
+  }
+
+  uint32_t history_length_;
+  float max_extrapolation_seconds_;
+
+  // Rows - "head_" is the newest snapshot, older ones wrap backwards
+  indigo::core::PodVector<float> row_times_;
+  uint32_t head_;
+  uint32_t row_count_;
+  bool writing_;
+
+  // [row * slot_capacity_ + slot]
+  uint32_t slot_capacity_;
+  indigo::core::PodVector<glm::vec2> positions_;
+  indigo::core::PodVector<float> orientations_;
+  indigo::core::PodVector<uint8_t> flags_;
+
+  // Columns
+  indigo::core::PodVector<uint32_t> slot_ids_;
+  indigo::core::PodVector<uint8_t> slot_live_;
+  indigo::core::PodVector<float> slot_departed_at_;
+  indigo::core::PodVector<uint32_t> free_slots_;
+  std::unordered_map<uint32_t, uint32_t> slot_of_id_;
+
+  indigo::core::PodVector<uint32_t> added_ids_;
+  indigo::core::PodVector<uint32_t> removed_ids_;
+};
+
+}  // namespace sanctify
+
+#endif
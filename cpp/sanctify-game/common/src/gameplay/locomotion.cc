@@ -27,11 +27,12 @@ void LocomotionSystem::apply_standard_locomotion(entt::registry& world,
     float remaining_distance = dt * standard_nav_params.MovementSpeed;
 
     while (remaining_distance > 0.f) {
-      if (nav_waypoints.Targets.size() == 0u) {
+      if (nav_waypoints.Cursor >= nav_waypoints.Targets.size()) {
         break;
       }
 
-      const glm::vec2& next_target = nav_waypoints.Targets[0];
+      const glm::vec2& next_target =
+          nav_waypoints.Targets[nav_waypoints.Cursor];
       glm::vec2 direction = next_target - map_location.XZ;
       float length = glm::length(direction);
       glm::vec2 normal = direction / length;
@@ -41,18 +42,19 @@ void LocomotionSystem::apply_standard_locomotion(entt::registry& world,
         break;
       }
 
-      map_location.XZ = nav_waypoints.Targets[0];
-      nav_waypoints.Targets.delete_at(0, true);
+      map_location.XZ = next_target;
+      nav_waypoints.Cursor++;
       remaining_distance -= length;
     }
 
-    if (nav_waypoints.Targets.size() == 0) {
+    if (nav_waypoints.Cursor >= nav_waypoints.Targets.size()) {
       world.remove<component::NavWaypointList>(entity);
     } else {
       // TODO (sessamekesh): Is this correct?
-      orientation.orientation =
-          glm::atan(nav_waypoints.Targets[0].r - map_location.XZ.x,
-                    nav_waypoints.Targets[0].g - map_location.XZ.g);
+      const glm::vec2& next_target =
+          nav_waypoints.Targets[nav_waypoints.Cursor];
+      orientation.orientation = glm::atan(next_target.r - map_location.XZ.x,
+                                          next_target.g - map_location.XZ.g);
     }
   }
 }
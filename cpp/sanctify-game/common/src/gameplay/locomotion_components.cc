@@ -6,11 +6,17 @@ using namespace component;
 bool MapLocation::operator==(const MapLocation& o) const { return XZ == o.XZ; }
 
 bool NavWaypointList::operator==(const NavWaypointList& o) const {
-  if (Targets.size() != o.Targets.size()) {
+  size_t remaining = Targets.size() - Cursor;
+  if (remaining != o.Targets.size() - o.Cursor) {
     return false;
   }
 
-  return memcmp(&Targets[0], &o.Targets[0], Targets.raw_size()) == 0;
+  if (remaining == 0) {
+    return true;
+  }
+
+  return memcmp(&Targets[Cursor], &o.Targets[o.Cursor],
+                remaining * sizeof(glm::vec2)) == 0;
 }
 
 bool OrientationComponent::operator==(const OrientationComponent& o) const {
@@ -67,7 +67,7 @@ GameSnapshotDiff::ComponentType from_proto(
 
 template <typename T>
 Maybe<T> extract(uint32_t net_sync_id,
-                 const std::unordered_map<uint32_t, T> map) {
+                 const std::unordered_map<uint32_t, T>& map) {
   auto it = map.find(net_sync_id);
   if (it == map.end()) {
     return empty_maybe{};
@@ -115,7 +115,8 @@ void maybe_add_to_proto(pb::ComponentData* mut_component_data,
   pb::NavWaypointList* mut_waypoints =
       mut_component_data->mutable_nav_waypoints();
 
-  for (int i = 0; i < waypoints.get().Targets.size(); i++) {
+  for (int i = waypoints.get().Cursor; i < waypoints.get().Targets.size();
+       i++) {
     const auto& target = waypoints.get().Targets[i];
     ::set_vec2(mut_waypoints->add_nav_waypoints(), target);
   }
@@ -219,10 +220,9 @@ generate_map_location_diff(uint32_t net_sync_id, const GameSnapshot& base,
     return EitherType(right(GameSnapshotDiff::ComponentType::MapLocation));
   }
 
-  // Dest value must be present, but we don't care if base value is present or
-  // not by this code path
+  // Dest value must be present - base value may not be (new entity)
 
-  if (base_value.get() == dest_value.get()) {
+  if (base_value.has_value() && base_value.get() == dest_value.get()) {
     return empty_maybe{};
   }
 
@@ -259,7 +259,7 @@ generate_waypoint_diff(uint32_t net_sync_id, const GameSnapshot& base,
     return EitherType(right(GameSnapshotDiff::ComponentType::NavWaypointList));
   }
 
-  if (base_value.get() == dest_value.get()) {
+  if (base_value.has_value() && base_value.get() == dest_value.get()) {
     return empty_maybe{};
   }
 
@@ -298,7 +298,7 @@ generate_nav_params_diff(uint32_t net_sync_id, const GameSnapshot& base,
         right(GameSnapshotDiff::ComponentType::StandardNavigationParams));
   }
 
-  if (base_value.get() == dest_value.get()) {
+  if (base_value.has_value() && base_value.get() == dest_value.get()) {
     return empty_maybe{};
   }
 
@@ -337,7 +337,7 @@ generate_basic_player_diff(uint32_t net_sync_id, const GameSnapshot& base,
         right(GameSnapshotDiff::ComponentType::BasicPlayerComponent));
   }
 
-  if (base_value.get() == dest_value.get()) {
+  if (base_value.has_value() && base_value.get() == dest_value.get()) {
     return empty_maybe{};
   }
 
@@ -377,7 +377,7 @@ generate_orientation_diff(uint32_t net_sync_id, const GameSnapshot& base,
     return EitherType(right(GameSnapshotDiff::ComponentType::Orientation));
   }
 
-  if (base_value.get() == dest_value.get()) {
+  if (base_value.has_value() && base_value.get() == dest_value.get()) {
     return empty_maybe{};
   }
 
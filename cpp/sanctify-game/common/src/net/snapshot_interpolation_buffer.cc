@@ -0,0 +1,309 @@
+#include <sanctify-game-common/net/snapshot_interpolation_buffer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <glm/gtc/constants.hpp>
+
+using namespace sanctify;
+using namespace indigo;
+using namespace core;
+
+namespace {
+const uint32_t kInitialSlotCapacity = 64u;
+
+// Shortest way around from "a" to "b"
+float lerp_angle(float a, float b, float t) {
+  float delta = b - a;
+  delta -= glm::two_pi<float>() *
+           glm::floor((delta + glm::pi<float>()) / glm::two_pi<float>());
+  return a + delta * t;
+}
+}  // namespace
+
+SnapshotInterpolationBuffer::SnapshotInterpolationBuffer(
+    uint32_t history_length, float max_extrapolation_seconds)
+    : history_length_(std::max(history_length, 2u)),
+      max_extrapolation_seconds_(max_extrapolation_seconds),
+      row_times_(std::max(history_length, 2u)),
+      head_(0u),
+      row_count_(0u),
+      writing_(false),
+      slot_capacity_(0u),
+      positions_(1u),
+      orientations_(1u),
+      flags_(1u),
+      slot_ids_(kInitialSlotCapacity),
+      slot_live_(kInitialSlotCapacity),
+      slot_departed_at_(kInitialSlotCapacity),
+      free_slots_(kInitialSlotCapacity),
+      added_ids_(kInitialSlotCapacity),
+      removed_ids_(kInitialSlotCapacity) {
+  row_times_.resize(history_length_);
+  grow_slots(kInitialSlotCapacity);
+}
+
+bool SnapshotInterpolationBuffer::begin_snapshot(float snapshot_time) {
+  if (row_count_ > 0u && snapshot_time <= row_times_[head_]) {
+    writing_ = false;
+    return false;
+  }
+
+  head_ = (row_count_ == 0u) ? 0u : (head_ + 1u) % history_length_;
+  row_count_ = std::min(row_count_ + 1u, history_length_);
+  row_times_[head_] = snapshot_time;
+
+  // The row being overwritten may hold an older snapshot
+  memset(&flags_[cell(head_, 0u)], 0x00, slot_capacity_);
+
+  writing_ = true;
+  return true;
+}
+
+void SnapshotInterpolationBuffer::add(
+    uint32_t net_sync_id, const Maybe<component::MapLocation>& map_location,
+    const Maybe<component::OrientationComponent>& orientation) {
+  if (!writing_) {
+    return;
+  }
+
+  uint32_t slot = slot_of(net_sync_id);
+  if (slot == kNoSlot) {
+    slot = allocate_slot(net_sync_id);
+  } else {
+    // Back before it was released - keep the same slot
+    slot_live_[slot] = kSlotLive;
+  }
+
+  uint32_t idx = cell(head_, slot);
+  uint8_t flags = kPresent;
+  if (map_location.has_value()) {
+    positions_[idx] = map_location.get().XZ;
+    flags |= kHasLocation;
+  }
+  if (orientation.has_value()) {
+    orientations_[idx] = orientation.get().orientation;
+    flags |= kHasOrientation;
+  }
+  flags_[idx] = flags;
+}
+
+void SnapshotInterpolationBuffer::end_snapshot() {
+  if (!writing_) {
+    return;
+  }
+  writing_ = false;
+
+  // Anything that was not in this snapshot is gone as of this snapshot - but
+  //  is still sampled until release_departed passes it
+  const uint8_t* head_flags = &flags_[cell(head_, 0u)];
+  for (uint32_t slot = 0; slot < slot_ids_.size(); slot++) {
+    if (slot_live_[slot] != kSlotLive || (head_flags[slot] & kPresent) != 0u) {
+      continue;
+    }
+
+    slot_live_[slot] = kSlotDeparting;
+    slot_departed_at_[slot] = row_times_[head_];
+  }
+}
+
+void SnapshotInterpolationBuffer::release_departed(float time) {
+  for (uint32_t slot = 0; slot < slot_ids_.size(); slot++) {
+    if (slot_live_[slot] != kSlotDeparting ||
+        slot_departed_at_[slot] > time) {
+      continue;
+    }
+
+    slot_live_[slot] = kSlotFree;
+    slot_of_id_.erase(slot_ids_[slot]);
+    free_slots_.push_back(slot);
+    removed_ids_.push_back(slot_ids_[slot]);
+  }
+}
+
+void SnapshotInterpolationBuffer::clear() {
+  for (uint32_t slot = 0; slot < slot_ids_.size(); slot++) {
+    if (slot_live_[slot] != kSlotFree) {
+      removed_ids_.push_back(slot_ids_[slot]);
+    }
+  }
+
+  row_count_ = 0u;
+  head_ = 0u;
+  writing_ = false;
+  slot_ids_.resize(0);
+  slot_live_.resize(0);
+  slot_departed_at_.resize(0);
+  free_slots_.resize(0);
+  slot_of_id_.clear();
+}
+
+void SnapshotInterpolationBuffer::sample(
+    float time, PodVector<glm::vec2>& o_positions,
+    PodVector<float>& o_orientations) const {
+  const uint32_t slot_count = slot_ids_.size();
+  o_positions.resize(slot_count);
+  o_orientations.resize(slot_count);
+
+  if (row_count_ == 0u) {
+    return;
+  }
+
+  //
+  // Pick the two rows to blend between (the same for every entity)
+  //
+  uint32_t from_row = head_;
+  uint32_t to_row = head_;
+  float t = 0.f;
+
+  if (row_count_ == 1u) {
+    // Nothing to blend with - hold the only snapshot
+  } else if (time >= row_times_[head_]) {
+    // Extrapolate forward from the last two snapshots
+    from_row = row(1u);
+    float span = row_times_[to_row] - row_times_[from_row];
+    float clamped_time =
+        std::min(time, row_times_[to_row] + max_extrapolation_seconds_);
+    t = (clamped_time - row_times_[from_row]) / span;
+  } else {
+    // Newest row at or before "time" (clamped to the oldest row)
+    uint32_t age = 1u;
+    while (age < row_count_ - 1u && row_times_[row(age)] > time) {
+      age++;
+    }
+    from_row = row(age);
+    to_row = row(age - 1u);
+    float span = row_times_[to_row] - row_times_[from_row];
+    t = std::max(time - row_times_[from_row], 0.f) / span;
+  }
+
+  //
+  // Blend every live column
+  //
+  const glm::vec2* from_positions = &positions_[cell(from_row, 0u)];
+  const glm::vec2* to_positions = &positions_[cell(to_row, 0u)];
+  const float* from_orientations = &orientations_[cell(from_row, 0u)];
+  const float* to_orientations = &orientations_[cell(to_row, 0u)];
+  const uint8_t* from_flags = &flags_[cell(from_row, 0u)];
+  const uint8_t* to_flags = &flags_[cell(to_row, 0u)];
+
+  // Entities that only showed up after "to_row" sit at the newest state
+  const glm::vec2* head_positions = &positions_[cell(head_, 0u)];
+  const float* head_orientations = &orientations_[cell(head_, 0u)];
+  const uint8_t* head_flags = &flags_[cell(head_, 0u)];
+
+  // Don't extrapolate rotation
+  const float orientation_t = std::min(t, 1.f);
+
+  glm::vec2* out_positions = o_positions.raw();
+  float* out_orientations = o_orientations.raw();
+  for (uint32_t slot = 0; slot < slot_count; slot++) {
+    if (slot_live_[slot] == kSlotFree) {
+      continue;
+    }
+
+    const uint8_t both = from_flags[slot] & to_flags[slot];
+
+    if ((both & kHasLocation) != 0u) {
+      out_positions[slot] = from_positions[slot] +
+                            (to_positions[slot] - from_positions[slot]) * t;
+    } else if ((to_flags[slot] & kHasLocation) != 0u) {
+      out_positions[slot] = to_positions[slot];
+    } else if ((from_flags[slot] & kHasLocation) != 0u) {
+      out_positions[slot] = from_positions[slot];
+    } else if ((head_flags[slot] & kHasLocation) != 0u) {
+      out_positions[slot] = head_positions[slot];
+    }
+
+    if ((both & kHasOrientation) != 0u) {
+      out_orientations[slot] = ::lerp_angle(
+          from_orientations[slot], to_orientations[slot], orientation_t);
+    } else if ((to_flags[slot] & kHasOrientation) != 0u) {
+      out_orientations[slot] = to_orientations[slot];
+    } else if ((from_flags[slot] & kHasOrientation) != 0u) {
+      out_orientations[slot] = from_orientations[slot];
+    } else if ((head_flags[slot] & kHasOrientation) != 0u) {
+      out_orientations[slot] = head_orientations[slot];
+    }
+  }
+}
+
+uint32_t SnapshotInterpolationBuffer::slot_of(uint32_t net_sync_id) const {
+  auto it = slot_of_id_.find(net_sync_id);
+  if (it == slot_of_id_.end()) {
+    return kNoSlot;
+  }
+  return it->second;
+}
+
+float SnapshotInterpolationBuffer::newest_time() const {
+  return row_count_ > 0u ? row_times_[head_] : 0.f;
+}
+
+float SnapshotInterpolationBuffer::oldest_time() const {
+  return row_count_ > 0u ? row_times_[row(row_count_ - 1u)] : 0.f;
+}
+
+void SnapshotInterpolationBuffer::clear_changes() {
+  added_ids_.resize(0);
+  removed_ids_.resize(0);
+}
+
+uint32_t SnapshotInterpolationBuffer::allocate_slot(uint32_t net_sync_id) {
+  uint32_t slot = 0u;
+  if (free_slots_.size() > 0u) {
+    slot = free_slots_[free_slots_.size() - 1u];
+    free_slots_.resize(free_slots_.size() - 1u);
+    slot_ids_[slot] = net_sync_id;
+    slot_live_[slot] = kSlotLive;
+  } else {
+    slot = slot_ids_.size();
+    if (slot >= slot_capacity_) {
+      grow_slots(slot_capacity_ * 2u);
+    }
+    slot_ids_.push_back(net_sync_id);
+    slot_live_.push_back(kSlotLive);
+    slot_departed_at_.push_back(0.f);
+  }
+
+  // Older rows may still hold the last owner of this slot
+  for (uint32_t r = 0; r < history_length_; r++) {
+    flags_[cell(r, slot)] = 0u;
+  }
+
+  slot_of_id_.emplace(net_sync_id, slot);
+  added_ids_.push_back(net_sync_id);
+
+  return slot;
+}
+
+void SnapshotInterpolationBuffer::grow_slots(uint32_t slot_capacity) {
+  const uint32_t old_capacity = slot_capacity_;
+  const uint32_t cell_count = history_length_ * slot_capacity;
+
+  PodVector<glm::vec2> positions(cell_count);
+  PodVector<float> orientations(cell_count);
+  PodVector<uint8_t> flags(cell_count);
+  positions.resize(cell_count);
+  orientations.resize(cell_count);
+  flags.resize(cell_count);
+  memset(flags.raw(), 0x00, cell_count);
+
+  // Same slot indices, wider rows
+  for (uint32_t r = 0; r < history_length_ && old_capacity > 0u; r++) {
+    memcpy(&positions[r * slot_capacity], &positions_[r * old_capacity],
+           old_capacity * sizeof(glm::vec2));
+    memcpy(&orientations[r * slot_capacity], &orientations_[r * old_capacity],
+           old_capacity * sizeof(float));
+    memcpy(&flags[r * slot_capacity], &flags_[r * old_capacity],
+           old_capacity);
+  }
+
+  positions_ = std::move(positions);
+  orientations_ = std::move(orientations);
+  flags_ = std::move(flags);
+  slot_capacity_ = slot_capacity;
+}
+
+uint32_t SnapshotInterpolationBuffer::row(uint32_t age) const {
+  return (head_ + history_length_ - age) % history_length_;
+}
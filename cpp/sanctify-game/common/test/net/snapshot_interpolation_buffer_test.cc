@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include <sanctify-game-common/net/snapshot_interpolation_buffer.h>
+
+#include <glm/gtc/constants.hpp>
+
+using namespace sanctify;
+using namespace indigo;
+using namespace core;
+
+namespace {
+void add_entity(SnapshotInterpolationBuffer& buffer, uint32_t net_sync_id,
+                glm::vec2 position, float orientation) {
+  buffer.add(net_sync_id, component::MapLocation{position},
+             component::OrientationComponent{orientation});
+}
+}  // namespace
+
+TEST(SnapshotInterpolationBuffer, InterpolatesBetweenSnapshots) {
+  SnapshotInterpolationBuffer buffer(4u);
+
+  ASSERT_TRUE(buffer.begin_snapshot(1.f));
+  ::add_entity(buffer, 10u, glm::vec2(0.f, 0.f), 0.f);
+  ::add_entity(buffer, 20u, glm::vec2(5.f, 5.f), 1.f);
+  buffer.end_snapshot();
+
+  ASSERT_TRUE(buffer.begin_snapshot(2.f));
+  ::add_entity(buffer, 10u, glm::vec2(4.f, 0.f), 1.f);
+  ::add_entity(buffer, 20u, glm::vec2(5.f, 9.f), 1.f);
+  buffer.end_snapshot();
+
+  PodVector<glm::vec2> positions;
+  PodVector<float> orientations;
+  buffer.sample(1.25f, positions, orientations);
+
+  uint32_t a = buffer.slot_of(10u);
+  uint32_t b = buffer.slot_of(20u);
+  ASSERT_NE(a, SnapshotInterpolationBuffer::kNoSlot);
+  ASSERT_NE(b, SnapshotInterpolationBuffer::kNoSlot);
+  ASSERT_EQ(positions.size(), buffer.slot_count());
+
+  EXPECT_FLOAT_EQ(positions[a].x, 1.f);
+  EXPECT_FLOAT_EQ(positions[a].y, 0.f);
+  EXPECT_FLOAT_EQ(orientations[a], 0.25f);
+  EXPECT_FLOAT_EQ(positions[b].x, 5.f);
+  EXPECT_FLOAT_EQ(positions[b].y, 6.f);
+  EXPECT_FLOAT_EQ(orientations[b], 1.f);
+}
+
+TEST(SnapshotInterpolationBuffer, PicksBracketingSnapshotsInRing) {
+  SnapshotInterpolationBuffer buffer(3u);
+
+  // Wraps the ring - only times 3, 4 and 5 are kept
+  for (int i = 1; i <= 5; i++) {
+    ASSERT_TRUE(buffer.begin_snapshot((float)i));
+    ::add_entity(buffer, 1u, glm::vec2(i * 10.f, 0.f), 0.f);
+    buffer.end_snapshot();
+  }
+
+  EXPECT_EQ(buffer.snapshot_count(), 3u);
+  EXPECT_FLOAT_EQ(buffer.oldest_time(), 3.f);
+  EXPECT_FLOAT_EQ(buffer.newest_time(), 5.f);
+
+  PodVector<glm::vec2> positions;
+  PodVector<float> orientations;
+  uint32_t slot = buffer.slot_of(1u);
+
+  buffer.sample(3.5f, positions, orientations);
+  EXPECT_FLOAT_EQ(positions[slot].x, 35.f);
+
+  buffer.sample(4.5f, positions, orientations);
+  EXPECT_FLOAT_EQ(positions[slot].x, 45.f);
+
+  // Clamped to the oldest snapshot
+  buffer.sample(1.f, positions, orientations);
+  EXPECT_FLOAT_EQ(positions[slot].x, 30.f);
+}
+
+TEST(SnapshotInterpolationBuffer, ExtrapolatesUpToLimit) {
+  SnapshotInterpolationBuffer buffer(4u, 0.5f);
+
+  buffer.begin_snapshot(1.f);
+  ::add_entity(buffer, 1u, glm::vec2(0.f, 0.f), 0.f);
+  buffer.end_snapshot();
+  buffer.begin_snapshot(2.f);
+  ::add_entity(buffer, 1u, glm::vec2(2.f, 0.f), 1.f);
+  buffer.end_snapshot();
+
+  PodVector<glm::vec2> positions;
+  PodVector<float> orientations;
+  uint32_t slot = buffer.slot_of(1u);
+
+  buffer.sample(2.25f, positions, orientations);
+  EXPECT_FLOAT_EQ(positions[slot].x, 2.5f);
+  EXPECT_FLOAT_EQ(orientations[slot], 1.f);
+
+  buffer.sample(10.f, positions, orientations);
+  EXPECT_FLOAT_EQ(positions[slot].x, 3.f);
+}
+
+TEST(SnapshotInterpolationBuffer, OrientationTakesShortestArc) {
+  SnapshotInterpolationBuffer buffer(4u);
+
+  const float kPi = glm::pi<float>();
+  buffer.begin_snapshot(0.f);
+  ::add_entity(buffer, 1u, glm::vec2(0.f), kPi - 0.1f);
+  buffer.end_snapshot();
+  buffer.begin_snapshot(1.f);
+  ::add_entity(buffer, 1u, glm::vec2(0.f), -kPi + 0.1f);
+  buffer.end_snapshot();
+
+  PodVector<glm::vec2> positions;
+  PodVector<float> orientations;
+  buffer.sample(0.5f, positions, orientations);
+
+  EXPECT_NEAR(orientations[buffer.slot_of(1u)], kPi, 0.0001f);
+}
+
+TEST(SnapshotInterpolationBuffer, TracksAddedAndRemovedEntities) {
+  SnapshotInterpolationBuffer buffer(4u);
+
+  buffer.begin_snapshot(1.f);
+  ::add_entity(buffer, 1u, glm::vec2(0.f), 0.f);
+  ::add_entity(buffer, 2u, glm::vec2(0.f), 0.f);
+  buffer.end_snapshot();
+
+  EXPECT_EQ(buffer.added_ids().size(), 2u);
+  EXPECT_EQ(buffer.removed_ids().size(), 0u);
+  EXPECT_EQ(buffer.live_count(), 2u);
+  buffer.clear_changes();
+
+  uint32_t released_slot = buffer.slot_of(1u);
+
+  // Entity 1 leaves, entity 3 arrives and takes over its slot
+  buffer.begin_snapshot(2.f);
+  ::add_entity(buffer, 2u, glm::vec2(0.f), 0.f);
+  buffer.end_snapshot();
+  buffer.release_departed(2.f);
+  buffer.begin_snapshot(3.f);
+  ::add_entity(buffer, 2u, glm::vec2(0.f), 0.f);
+  ::add_entity(buffer, 3u, glm::vec2(8.f, 8.f), 0.f);
+  buffer.end_snapshot();
+
+  ASSERT_EQ(buffer.removed_ids().size(), 1u);
+  EXPECT_EQ(buffer.removed_ids()[0], 1u);
+  ASSERT_EQ(buffer.added_ids().size(), 1u);
+  EXPECT_EQ(buffer.added_ids()[0], 3u);
+  EXPECT_EQ(buffer.slot_of(1u), SnapshotInterpolationBuffer::kNoSlot);
+  EXPECT_EQ(buffer.slot_of(3u), released_slot);
+  EXPECT_EQ(buffer.net_sync_id(released_slot), 3u);
+  EXPECT_EQ(buffer.live_count(), 2u);
+
+  // The new owner of the slot does not blend with the old one, and sits at
+  //  its first known position before it showed up
+  PodVector<glm::vec2> positions;
+  PodVector<float> orientations;
+  buffer.sample(1.5f, positions, orientations);
+  EXPECT_FLOAT_EQ(positions[released_slot].x, 8.f);
+}
+
+TEST(SnapshotInterpolationBuffer, KeepsDepartedEntitiesUntilSampledPast) {
+  SnapshotInterpolationBuffer buffer(4u);
+
+  buffer.begin_snapshot(1.f);
+  ::add_entity(buffer, 1u, glm::vec2(0.f), 0.f);
+  buffer.end_snapshot();
+  buffer.begin_snapshot(2.f);
+  ::add_entity(buffer, 1u, glm::vec2(4.f, 0.f), 0.f);
+  buffer.end_snapshot();
+  buffer.clear_changes();
+
+  // Entity 1 is not in the newest snapshot, but is still drawn behind it
+  buffer.begin_snapshot(3.f);
+  buffer.end_snapshot();
+
+  uint32_t slot = buffer.slot_of(1u);
+  ASSERT_NE(slot, SnapshotInterpolationBuffer::kNoSlot);
+  buffer.release_departed(1.5f);
+  EXPECT_EQ(buffer.removed_ids().size(), 0u);
+  EXPECT_TRUE(buffer.is_live(slot));
+
+  PodVector<glm::vec2> positions;
+  PodVector<float> orientations;
+  buffer.sample(1.5f, positions, orientations);
+  EXPECT_FLOAT_EQ(positions[slot].x, 2.f);
+
+  // Coming back before it is released keeps the same slot
+  buffer.begin_snapshot(4.f);
+  ::add_entity(buffer, 1u, glm::vec2(6.f, 0.f), 0.f);
+  buffer.end_snapshot();
+  buffer.release_departed(3.5f);
+  EXPECT_EQ(buffer.removed_ids().size(), 0u);
+  EXPECT_EQ(buffer.added_ids().size(), 0u);
+  EXPECT_EQ(buffer.slot_of(1u), slot);
+
+  // Gone again - released once the sample time reaches that snapshot
+  buffer.begin_snapshot(5.f);
+  buffer.end_snapshot();
+  buffer.release_departed(4.5f);
+  EXPECT_EQ(buffer.removed_ids().size(), 0u);
+  buffer.release_departed(5.f);
+  ASSERT_EQ(buffer.removed_ids().size(), 1u);
+  EXPECT_EQ(buffer.removed_ids()[0], 1u);
+  EXPECT_FALSE(buffer.is_live(slot));
+  EXPECT_EQ(buffer.slot_of(1u), SnapshotInterpolationBuffer::kNoSlot);
+  EXPECT_EQ(buffer.live_count(), 0u);
+}
+
+TEST(SnapshotInterpolationBuffer, IgnoresOutOfOrderSnapshots) {
+  SnapshotInterpolationBuffer buffer(4u);
+
+  ASSERT_TRUE(buffer.begin_snapshot(2.f));
+  ::add_entity(buffer, 1u, glm::vec2(2.f, 0.f), 0.f);
+  buffer.end_snapshot();
+
+  EXPECT_FALSE(buffer.begin_snapshot(1.f));
+  ::add_entity(buffer, 1u, glm::vec2(100.f, 0.f), 0.f);
+  ::add_entity(buffer, 2u, glm::vec2(100.f, 0.f), 0.f);
+  buffer.end_snapshot();
+
+  EXPECT_EQ(buffer.snapshot_count(), 1u);
+  EXPECT_EQ(buffer.live_count(), 1u);
+
+  PodVector<glm::vec2> positions;
+  PodVector<float> orientations;
+  buffer.sample(2.f, positions, orientations);
+  EXPECT_FLOAT_EQ(positions[buffer.slot_of(1u)].x, 2.f);
+}
+
+TEST(SnapshotInterpolationBuffer, GrowsPastInitialCapacity) {
+  SnapshotInterpolationBuffer buffer(4u);
+
+  for (int s = 0; s < 2; s++) {
+    buffer.begin_snapshot((float)s);
+    for (uint32_t i = 0; i < 1000u; i++) {
+      ::add_entity(buffer, i, glm::vec2(i + s * 2.f, 0.f), 0.f);
+    }
+    buffer.end_snapshot();
+  }
+
+  EXPECT_EQ(buffer.live_count(), 1000u);
+
+  PodVector<glm::vec2> positions;
+  PodVector<float> orientations;
+  buffer.sample(0.5f, positions, orientations);
+  for (uint32_t i = 0; i < 1000u; i++) {
+    ASSERT_FLOAT_EQ(positions[buffer.slot_of(i)].x, i + 1.f);
+  }
+}
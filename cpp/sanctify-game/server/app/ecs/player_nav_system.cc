@@ -27,8 +27,13 @@ void system::PlayerNavSystem::update(entt::registry& world,
                          component::BasicPlayerComponent>();
 
   for (auto [e, map_location, nav_request] : view.each()) {
-    // TODO (sessamekesh): consider saving off previously allocated query?
-    dtNavMeshQuery* dt_query = dtAllocNavMeshQuery();
+    // Owned by this thread and reused - the navmesh itself may be shared with
+    //  other matches running on other threads
+    dtNavMeshQuery* dt_query = navmesh.thread_query(512);
+    if (dt_query == nullptr) {
+      Logger::err(kLogLabel) << "Could not create navmesh query";
+      return;
+    }
     dtQueryFilter filter;
 
     glm::vec3 half_extents(20.f, 2.f, 20.f);
@@ -41,8 +46,6 @@ void system::PlayerNavSystem::update(entt::registry& world,
                                     nav_request.requestPosition.y);
     glm::vec3 actual_dest{};
 
-    dt_query->init(navmesh.raw(), 512);
-
     dtStatus start_status =
         dt_query->findNearestPoly(&current_player_pos.x, &half_extents.x,
                                   &filter, &start_ref, &start_pos.x);
@@ -51,7 +54,6 @@ void system::PlayerNavSystem::update(entt::registry& world,
                                   &filter, &end_ref, &actual_dest.x);
 
     if (dtStatusFailed(start_status) || dtStatusFailed(end_status)) {
-      dtFreeNavMeshQuery(dt_query);
       Logger::log(kLogLabel)
           << "Failed to find start and/or end pos from ["
           << current_player_pos.x << ", " << current_player_pos.y << ", "
@@ -68,7 +70,6 @@ void system::PlayerNavSystem::update(entt::registry& world,
                            &filter, path, &poly_count, kMaxPolys);
 
     if (dtStatusFailed(pathfind_status) || poly_count == 0) {
-      dtFreeNavMeshQuery(dt_query);
       Logger::log(kLogLabel)
           << "Failed to find path polys from [" << start_pos.x << ", "
           << start_pos.y << ", " << start_pos.z << "] to [" << actual_dest.x
@@ -83,7 +84,6 @@ void system::PlayerNavSystem::update(entt::registry& world,
         &start_pos.x, &actual_dest.x, path, poly_count, &straight_path[0].x,
         nullptr, nullptr, &num_path_points, kMaxPolys);
     if (dtStatusFailed(straight_path_status) || num_path_points == 0u) {
-      dtFreeNavMeshQuery(dt_query);
       Logger::log(kLogLabel)
           << "Failed to find straight path from [" << start_pos.x << ", "
           << start_pos.y << ", " << start_pos.z << "] to [" << actual_dest.x
@@ -96,8 +96,6 @@ void system::PlayerNavSystem::update(entt::registry& world,
       waypoints.push_back(glm::vec2(straight_path[i].x, straight_path[i].z));
     }
 
-    dtFreeNavMeshQuery(dt_query);
-
     Logger::log(kLogLabel) << "Created new nav point for player "
                            << ecs::PlayerUtil::player_id(world, e).Id
                            << " - endpoint <" << waypoints.last().x << ", "
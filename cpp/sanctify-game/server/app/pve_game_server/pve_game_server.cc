@@ -1,7 +1,7 @@
 #include <app/pve_game_server/ecs/context_components.h>
 #include <app/pve_game_server/ecs/netstate_components.h>
 #include <app/pve_game_server/pve_game_server.h>
-#include <igasset/igpack_loader.h>
+#include <igasset/shared_asset_store.h>
 #include <igasync/promise_combiner.h>
 #include <sanctify-game-common/gameplay/locomotion_components.h>
 #include <sanctify-game-common/gameplay/net_sync_components.h>
@@ -21,6 +21,14 @@ const char* kLogLabel = "PveGameServer";
 //  configuration thing)
 const int kMaxPlayers = 5;
 
+// Simulation tick length, and how many ticks may be simulated back to back to
+//  catch up after an overrun before ticks are dropped instead
+const float kTickSeconds = 8.f / 1000.f;
+const uint32_t kMaxCatchupTicks = 4u;
+
+// How often the game thread logs tick timing telemetry
+const float kTickStatsReportInterval = 30.f;
+
 std::string to_string(PveGameServer::ServerStage stage) {
   switch (stage) {
     case PveGameServer::ServerStage::Initializing:
@@ -39,15 +47,17 @@ std::string to_string(PveGameServer::ServerStage stage) {
 }  // namespace
 
 std::shared_ptr<PveGameServer> PveGameServer::Create(
-    std::shared_ptr<TaskList> async_task_list, bool use_fixed_timestamp) {
-  auto server = std::shared_ptr<PveGameServer>(
-      new PveGameServer(async_task_list, use_fixed_timestamp));
+    std::shared_ptr<TaskList> async_task_list, bool use_fixed_timestamp,
+    std::chrono::microseconds tick_spin_window) {
+  auto server = std::shared_ptr<PveGameServer>(new PveGameServer(
+      async_task_list, use_fixed_timestamp, tick_spin_window));
   server->initialize();
   return server;
 }
 
 PveGameServer::PveGameServer(std::shared_ptr<TaskList> async_task_list,
-                             bool use_fixed_timestamp)
+                             bool use_fixed_timestamp,
+                             std::chrono::microseconds tick_spin_window)
     : use_fixed_timestamp_(use_fixed_timestamp),
       server_stage_(ServerStage::Initializing),
       main_thread_task_list_(std::make_shared<TaskList>()),
@@ -58,35 +68,53 @@ PveGameServer::PveGameServer(std::shared_ptr<TaskList> async_task_list,
       net_event_organizer_(::kMaxPlayers),
       is_running_(false),
       next_net_sync_id_(1u),
+      tick_driver_(::kTickSeconds, ::kMaxCatchupTicks),
+      tick_spin_window_(tick_spin_window),
       game_thread_([this]() {
         Logger::log(kLogLabel)
             << "Beginning simulation on thread " << std::this_thread::get_id();
         is_running_ = true;
 
+        using FpSeconds =
+            std::chrono::duration<float, std::chrono::seconds::period>;
+
         auto last_frame = hrclock::now();
+        float time_since_stats_report = 0.f;
         std::this_thread::sleep_for(2ms);
         while (is_running_) {
           auto this_frame = hrclock::now();
-
-          using FpSeconds =
-              std::chrono::duration<float, std::chrono::seconds::period>;
-          float dt = FpSeconds(this_frame - last_frame).count();
+          float wall_dt = FpSeconds(this_frame - last_frame).count();
           last_frame = this_frame;
 
-          if (use_fixed_timestamp_) {
-            dt = 8.f / 1000.f;
+          // Fixed timestamp mode runs exactly one tick per loop regardless of
+          //  how long the last one took (no catch-up, fully reproducible)
+          uint32_t ticks = tick_driver_.advance(
+              use_fixed_timestamp_ ? tick_driver_.tick_dt() : wall_dt);
+          for (uint32_t i = 0; i < ticks; i++) {
+            auto tick_start = hrclock::now();
+            this->update(tick_driver_.tick_dt());
+            tick_driver_.record_tick_duration(
+                FpSeconds(hrclock::now() - tick_start).count());
           }
 
-          this->update(dt);
+          time_since_stats_report += wall_dt;
+          if (time_since_stats_report > ::kTickStatsReportInterval) {
+            Logger::log(kLogLabel) << tick_driver_.stats_report();
+            tick_driver_.reset_stats();
+            time_since_stats_report = 0.f;
+          }
 
-          // Wait for the next game tick (8ms - make this configurable)
           // Execute main thread tasks as long as there are tasks to execute,
           //  and then delay until the next tick when tasks are exhausted.
-          auto next_tick = this_frame + 8ms;
+          auto next_tick =
+              this_frame +
+              std::chrono::duration_cast<hrclock::duration>(FpSeconds(
+                  use_fixed_timestamp_ ? tick_driver_.tick_dt()
+                                       : tick_driver_.seconds_until_next_tick()));
           while (hrclock::now() < next_tick &&
                  main_thread_task_list_->execute_next()) {
           }
-          std::this_thread::sleep_until(next_tick);
+          logic::FixedStepDriver::wait_until(next_tick, tick_spin_window_);
         }
       }) {}
 
@@ -105,11 +133,11 @@ void PveGameServer::initialize() {
 
   combiner->add(player_cb_set_, async_task_list_);
 
-  asset::IgpackLoader loader("resources/terrain-pve.igpack", async_task_list_);
-
-  auto navmesh_key = combiner->add(
-      loader.extract_detour_navmesh("pve-arena-navmesh", async_task_list_),
-      async_task_list_);
+  auto navmesh_key =
+      combiner->add(asset::SharedAssetStore::Global()->detour_navmesh(
+                        "resources/terrain-pve.igpack", "pve-arena-navmesh",
+                        async_task_list_),
+                    async_task_list_);
 
   combiner->combine()->on_success(
       [this, navmesh_key](const PromiseCombiner::PromiseCombinerResult& rsl) {
@@ -120,8 +148,9 @@ void PveGameServer::initialize() {
           return;
         }
 
-        asset::IgpackLoader::ExtractDetourNavmeshDataT navmesh =
-            rsl.move(navmesh_key);
+        // Shared with other matches loading the same navmesh - copy, don't move
+        asset::SharedAssetStore::AssetT<nav::DetourNavmesh> navmesh =
+            rsl.get(navmesh_key);
 
         if (navmesh.is_right()) {
           Logger::err(kLogLabel)
@@ -323,7 +352,7 @@ void PveGameServer::update_running() {
 
   // Handle server logic (including sending out messages to clients!)
   net_state_update_system_.update(world_, net_event_organizer_);
-  player_nav_system_.update(world_, navmesh_.get());
+  player_nav_system_.update(world_, *navmesh_);
   locomotion_system_.apply_standard_locomotion(world_, ecs::frame_time(world_));
   queue_client_messages_system_.update(world_, ecs::sim_time(world_));
 }
@@ -14,6 +14,7 @@
 #include <app/pve_game_server/ecs/send_client_messages_system.h>
 #include <app/pve_game_server/net_event_organizer.h>
 #include <app/systems/locomotion.h>
+#include <common/logic/update_common/fixed_step_driver.h>
 #include <igcore/bimap.h>
 #include <ignav/detour_navmesh.h>
 #include <net/net_server.h>
@@ -21,6 +22,7 @@
 #include <sanctify-game-common/proto/sanctify-net.pb.h>
 #include <util/types.h>
 
+#include <chrono>
 #include <entt/entt.hpp>
 #include <memory>
 #include <vector>
@@ -50,9 +52,15 @@ class PveGameServer : public std::enable_shared_from_this<PveGameServer> {
   };
 
  public:
+  /**
+   * tick_spin_window: how long before each tick deadline the game thread stops
+   *  sleeping and busy-waits instead. Zero disables spinning.
+   */
   static std::shared_ptr<PveGameServer> Create(
       std::shared_ptr<indigo::core::TaskList> async_task_list,
-      bool use_fixed_timestamp);
+      bool use_fixed_timestamp,
+      std::chrono::microseconds tick_spin_window =
+          std::chrono::microseconds(0));
 
   // Netcomms (outside interface)
   void receive_message_for_player(PlayerId player_id,
@@ -69,7 +77,8 @@ class PveGameServer : public std::enable_shared_from_this<PveGameServer> {
 
  private:
   PveGameServer(std::shared_ptr<indigo::core::TaskList> async_task_list,
-                bool use_fixed_timestamp);
+                bool use_fixed_timestamp,
+                std::chrono::microseconds tick_spin_window);
   void initialize();
 
   void update(float dt);
@@ -98,6 +107,8 @@ class PveGameServer : public std::enable_shared_from_this<PveGameServer> {
   uint32_t next_net_sync_id_;
 
   // Simulation internals
+  sanctify::logic::FixedStepDriver tick_driver_;
+  std::chrono::microseconds tick_spin_window_;
   std::thread game_thread_;
   bool is_running_;  // Not guarded - set once to end game, no races (careful!)
   entt::registry world_;
@@ -108,8 +119,9 @@ class PveGameServer : public std::enable_shared_from_this<PveGameServer> {
   system::LocomotionSystem locomotion_system_;
   ecs::QueueClientMessagesSystem queue_client_messages_system_;
 
-  // Game server resources (logic helpers)
-  indigo::core::Maybe<indigo::nav::DetourNavmesh> navmesh_;
+  // Game server resources (logic helpers) - shared read-only with every other
+  //  match in this process, see asset::SharedAssetStore
+  std::shared_ptr<const indigo::nav::DetourNavmesh> navmesh_;
 };
 
 }  // namespace sanctify
@@ -25,9 +25,10 @@ Maybe<glm::vec2> ServerLocomotionSystem::handle_player_movement_event(
     return empty_maybe{};
   }
 
-  // TODO (sessamekesh) - pathfinding query should be allocated once, and
-  //  this system should have a consumed reference to the navmesh?
-  dtNavMeshQuery* pathfinding_query = dtAllocNavMeshQuery();
+  dtNavMeshQuery* pathfinding_query = navmesh.thread_query(2048);
+  if (pathfinding_query == nullptr) {
+    return empty_maybe{};
+  }
   dtQueryFilter filter;
   glm::vec3 center(loc->XZ.x, 0.f, loc->XZ.y);
   glm::vec3 half_extents(20.f, 2.f, 20.f);
@@ -39,8 +40,6 @@ Maybe<glm::vec2> ServerLocomotionSystem::handle_player_movement_event(
   dtPolyRef end_ref{};
   glm::vec3 actual_dest{};
 
-  pathfinding_query->init(navmesh.raw(), 2048);
-
   dtStatus start_status = pathfinding_query->findNearestPoly(
       &center.x, &half_extents.x, &filter, &start_ref, &start_pt.x);
   dtStatus end_status = pathfinding_query->findNearestPoly(
@@ -48,7 +47,6 @@ Maybe<glm::vec2> ServerLocomotionSystem::handle_player_movement_event(
       &actual_dest.x);
 
   if (dtStatusFailed(start_status) || dtStatusFailed(end_status)) {
-    dtFreeNavMeshQuery(pathfinding_query);
     return empty_maybe{};
   }
 
@@ -59,7 +57,6 @@ Maybe<glm::vec2> ServerLocomotionSystem::handle_player_movement_event(
       start_ref, end_ref, &start_pt.x, &actual_dest.x, &filter, path,
       &poly_count, kMaxPolys);
   if (dtStatusFailed(pathfind_status) || poly_count == 0) {
-    dtFreeNavMeshQuery(pathfinding_query);
     return empty_maybe{};
   }
 
@@ -70,7 +67,6 @@ Maybe<glm::vec2> ServerLocomotionSystem::handle_player_movement_event(
       &start_pt.x, &actual_dest.x, path, poly_count, &straight_path[0].x,
       nullptr, nullptr, &num_path_points, kMaxPolys);
   if (dtStatusFailed(straight_path_status) || num_path_points == 0) {
-    dtFreeNavMeshQuery(pathfinding_query);
     return empty_maybe{};
   }
 
@@ -90,7 +86,5 @@ Maybe<glm::vec2> ServerLocomotionSystem::handle_player_movement_event(
   world.emplace_or_replace<component::NavWaypointList>(player_entity,
                                                        std::move(waypoints));
 
-  dtFreeNavMeshQuery(pathfinding_query);
-
   return glm::vec2(actual_dest.x, actual_dest.z);
 }
@@ -30,6 +30,7 @@ int main(int argc, const char** argv) {
   TokenExchangerType token_exchanger_type = TokenExchangerType::Dummy;
   bool allow_json_messages = false;
   bool use_fixed_timestamp = false;
+  uint32_t tick_spin_us = 0u;
 
   app.add_option("-g,--game_token_exchanger", token_exchanger_type,
                  "Game token exchanger type")
@@ -41,6 +42,10 @@ int main(int argc, const char** argv) {
          "--use_fixed_timestamp", use_fixed_timestamp,
          "Use a fixed 8ms tick timestamp for this simulation (defaults true)")
       ->default_val(true);
+  app.add_option("--tick_spin_us", tick_spin_us,
+                 "Busy-wait this many microseconds before each game tick "
+                 "instead of sleeping, to reduce tick jitter (defaults 0)")
+      ->default_val(0u);
 
   CLI11_PARSE(app, argc, argv);
 
@@ -65,7 +70,8 @@ int main(int argc, const char** argv) {
                         35000u, ws_port, allow_json_messages);
 
   auto pve_game_server =
-      PveGameServer::Create(async_task_list, use_fixed_timestamp);
+      PveGameServer::Create(async_task_list, use_fixed_timestamp,
+                            std::chrono::microseconds(tick_spin_us));
 
   //
   // Wire everything together...
@@ -13,12 +13,15 @@ bool OrientationComponent::operator==(const OrientationComponent& o) const {
 
 bool NavWaypointListComponent::operator==(
     const NavWaypointListComponent& o) const {
-  if (targets.size() != o.targets.size()) {
+  uint32_t remaining = LocomotionUtil::remaining_waypoint_count(*this);
+  if (remaining != LocomotionUtil::remaining_waypoint_count(o)) {
     return false;
   }
 
-  for (int i = 0; i < targets.size(); i++) {
-    if (targets[i] != o.targets[i]) {
+  const glm::vec2* targets = LocomotionUtil::remaining_waypoints(*this);
+  const glm::vec2* o_targets = LocomotionUtil::remaining_waypoints(o);
+  for (uint32_t i = 0; i < remaining; i++) {
+    if (targets[i] != o_targets[i]) {
       return false;
     }
   }
@@ -40,10 +43,64 @@ void LocomotionUtil::attach_locomotion_components(
 }
 
 void LocomotionUtil::set_waypoints(indigo::igecs::WorldView* world,
-                                   entt::entity e,
-                                   indigo::core::PodVector<glm::vec2> targets) {
+                                   entt::entity e, const glm::vec2* targets,
+                                   uint32_t count) {
+  std::shared_ptr<NavWaypointArena> arena = nullptr;
+  if (count > NavWaypointListComponent::kInlineCapacity) {
+    if (!world->ctx_has<CtxNavWaypointArena>()) {
+      world->attach_ctx<CtxNavWaypointArena>(
+          CtxNavWaypointArena{NavWaypointArena::Create()});
+    }
+    arena = world->mut_ctx<CtxNavWaypointArena>().arena;
+  }
+
   world->remove<NavWaypointListComponent>(e);
-  world->attach<NavWaypointListComponent>(e, std::move(targets));
+  world->attach<NavWaypointListComponent>(
+      e, build_waypoint_list(targets, count, arena));
+}
+
+void LocomotionUtil::set_waypoints(
+    indigo::igecs::WorldView* world, entt::entity e,
+    const indigo::core::PodVector<glm::vec2>& targets) {
+  set_waypoints(world, e, targets.size() > 0 ? &targets[0] : nullptr,
+                static_cast<uint32_t>(targets.size()));
+}
+
+NavWaypointListComponent LocomotionUtil::build_waypoint_list(
+    const glm::vec2* targets, uint32_t count,
+    const std::shared_ptr<NavWaypointArena>& arena) {
+  NavWaypointListComponent waypoints{};
+  waypoints.count = count;
+  waypoints.cursor = 0u;
+
+  if (count <= NavWaypointListComponent::kInlineCapacity) {
+    for (uint32_t i = 0; i < count; i++) {
+      waypoints.inlineTargets[i] = targets[i];
+    }
+  } else {
+    waypoints.spilledTargets = arena->allocate(targets, count);
+  }
+
+  return waypoints;
+}
+
+NavWaypointListComponent LocomotionUtil::build_waypoint_list(
+    const indigo::core::PodVector<glm::vec2>& targets) {
+  return build_waypoint_list(targets.size() > 0 ? &targets[0] : nullptr,
+                             static_cast<uint32_t>(targets.size()));
+}
+
+const glm::vec2* LocomotionUtil::remaining_waypoints(
+    const NavWaypointListComponent& waypoints) {
+  const glm::vec2* targets = waypoints.spilledTargets.is_empty()
+                                 ? waypoints.inlineTargets
+                                 : waypoints.spilledTargets.data();
+  return targets + waypoints.cursor;
+}
+
+uint32_t LocomotionUtil::remaining_waypoint_count(
+    const NavWaypointListComponent& waypoints) {
+  return waypoints.count - waypoints.cursor;
 }
 
 glm::vec2 LocomotionUtil::get_map_position(indigo::igecs::WorldView* world,
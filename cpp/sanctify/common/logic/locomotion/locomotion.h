@@ -1,6 +1,7 @@
 #ifndef SANCTIFY_COMMON_LOGIC_LOCOMOTION_LOCOMOTION_H
 #define SANCTIFY_COMMON_LOGIC_LOCOMOTION_LOCOMOTION_H
 
+#include <common/logic/locomotion/nav_waypoint_arena.h>
 #include <igcore/pod_vector.h>
 #include <igecs/world_view.h>
 
@@ -21,12 +22,34 @@ struct OrientationComponent {
   bool operator==(const OrientationComponent& o) const;
 };
 
+/**
+ * Remaining waypoints of a navigation path. Short paths (the overwhelming
+ *  majority) are stored inline, longer ones live in a NavWaypointArena block.
+ *
+ * Reached waypoints are skipped by advancing "cursor" rather than erased, so
+ *  the waypoint storage is never written after the list is built. Use the
+ *  LocomotionUtil waypoint accessors instead of reading fields directly.
+ */
 struct NavWaypointListComponent {
-  indigo::core::PodVector<glm::vec2> targets;
+  static constexpr uint32_t kInlineCapacity = 8u;
 
+  glm::vec2 inlineTargets[kInlineCapacity];
+
+  // Holds the whole path if it did not fit inline, empty otherwise
+  NavWaypointSpan spilledTargets;
+
+  uint32_t count;
+  uint32_t cursor;
+
+  // Compares remaining waypoints only
   bool operator==(const NavWaypointListComponent& o) const;
 };
 
+/** Per-world arena for long paths, see LocomotionUtil::set_waypoints */
+struct CtxNavWaypointArena {
+  std::shared_ptr<NavWaypointArena> arena;
+};
+
 struct StandardNavigationParamsComponent {
   float movementSpeed;
 
@@ -41,8 +64,29 @@ class LocomotionUtil {
                                            float movement_speed,
                                            float orientation = 0.f);
 
+  /**
+   * Replace the waypoints of an entity. Long paths spill into the world's
+   *  CtxNavWaypointArena, which is created on first use - callers need
+   *  ctx_writes<CtxNavWaypointArena> and writes<NavWaypointListComponent>.
+   */
+  static void set_waypoints(indigo::igecs::WorldView* world, entt::entity e,
+                            const glm::vec2* targets, uint32_t count);
   static void set_waypoints(indigo::igecs::WorldView* world, entt::entity e,
-                            indigo::core::PodVector<glm::vec2> targets);
+                            const indigo::core::PodVector<glm::vec2>& targets);
+
+  /** Build a waypoint list outside of a world (snapshots, tests) */
+  static NavWaypointListComponent build_waypoint_list(
+      const glm::vec2* targets, uint32_t count,
+      const std::shared_ptr<NavWaypointArena>& arena =
+          NavWaypointArena::Detached());
+  static NavWaypointListComponent build_waypoint_list(
+      const indigo::core::PodVector<glm::vec2>& targets);
+
+  /** Contiguous run of not-yet-reached waypoints, next target first */
+  static const glm::vec2* remaining_waypoints(
+      const NavWaypointListComponent& waypoints);
+  static uint32_t remaining_waypoint_count(
+      const NavWaypointListComponent& waypoints);
 
   static glm::vec2 get_map_position(indigo::igecs::WorldView* world,
                                     entt::entity entity);
@@ -0,0 +1,248 @@
+#include "locomotion_kernel.h"
+
+#include <cmath>
+
+#if defined(IG_ENABLE_SIMD) && defined(__AVX2__)
+#define SANCTIFY_LOCOMOTION_AVX2
+#include <immintrin.h>
+#elif defined(IG_ENABLE_SIMD) &&                      \
+    (defined(__SSE2__) || defined(_M_X64) ||          \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SANCTIFY_LOCOMOTION_SSE2
+#include <emmintrin.h>
+#elif defined(IG_ENABLE_SIMD) && defined(__wasm_simd128__)
+#define SANCTIFY_LOCOMOTION_WASM_SIMD
+#include <wasm_simd128.h>
+#endif
+
+using namespace sanctify;
+using namespace logic;
+
+namespace {
+
+// Coefficients for atan(x) on [0, 1], odd minimax polynomial in x
+//  (max absolute error ~1e-5 radians)
+constexpr float kAtanC0 = 0.99997726f;
+constexpr float kAtanC1 = -0.33262347f;
+constexpr float kAtanC2 = 0.19354346f;
+constexpr float kAtanC3 = -0.11643287f;
+constexpr float kAtanC4 = 0.05265332f;
+constexpr float kAtanC5 = -0.01172120f;
+
+constexpr float kHalfPi = 1.57079632679f;
+constexpr float kPi = 3.14159265359f;
+
+// Avoids a 0/0 in the atan2 range reduction - only reachable for zero-length
+//  directions, which are always reported as "reached" anyway
+constexpr float kMinDenominator = 1e-30f;
+
+//
+// Per-instruction set wrappers - each exposes the same handful of operations,
+//  so the kernel itself is written once (see advance_lanes below)
+//
+#if defined(SANCTIFY_LOCOMOTION_AVX2)
+struct SimdOps {
+  using F = __m256;
+  static constexpr uint32_t kWidth = 8u;
+
+  static F load(const float* p) { return _mm256_loadu_ps(p); }
+  static void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+  static F set1(float v) { return _mm256_set1_ps(v); }
+  static F add(F a, F b) { return _mm256_add_ps(a, b); }
+  static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+  static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+  static F div(F a, F b) { return _mm256_div_ps(a, b); }
+  static F sqrt(F a) { return _mm256_sqrt_ps(a); }
+  static F min(F a, F b) { return _mm256_min_ps(a, b); }
+  static F max(F a, F b) { return _mm256_max_ps(a, b); }
+  static F sign_bit(F a) { return _mm256_and_ps(a, set1(-0.f)); }
+  static F abs(F a) { return _mm256_andnot_ps(set1(-0.f), a); }
+  static F xor_bits(F a, F b) { return _mm256_xor_ps(a, b); }
+  static F less_equal(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+  static F greater(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+  static F less(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  static F select(F mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+  static uint32_t mask_bits(F mask) {
+    return static_cast<uint32_t>(_mm256_movemask_ps(mask));
+  }
+};
+#elif defined(SANCTIFY_LOCOMOTION_SSE2)
+struct SimdOps {
+  using F = __m128;
+  static constexpr uint32_t kWidth = 4u;
+
+  static F load(const float* p) { return _mm_loadu_ps(p); }
+  static void store(float* p, F v) { _mm_storeu_ps(p, v); }
+  static F set1(float v) { return _mm_set1_ps(v); }
+  static F add(F a, F b) { return _mm_add_ps(a, b); }
+  static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+  static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+  static F div(F a, F b) { return _mm_div_ps(a, b); }
+  static F sqrt(F a) { return _mm_sqrt_ps(a); }
+  static F min(F a, F b) { return _mm_min_ps(a, b); }
+  static F max(F a, F b) { return _mm_max_ps(a, b); }
+  static F sign_bit(F a) { return _mm_and_ps(a, set1(-0.f)); }
+  static F abs(F a) { return _mm_andnot_ps(set1(-0.f), a); }
+  static F xor_bits(F a, F b) { return _mm_xor_ps(a, b); }
+  static F less_equal(F a, F b) { return _mm_cmple_ps(a, b); }
+  static F greater(F a, F b) { return _mm_cmpgt_ps(a, b); }
+  static F less(F a, F b) { return _mm_cmplt_ps(a, b); }
+  static F select(F mask, F a, F b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+  static uint32_t mask_bits(F mask) {
+    return static_cast<uint32_t>(_mm_movemask_ps(mask));
+  }
+};
+#elif defined(SANCTIFY_LOCOMOTION_WASM_SIMD)
+struct SimdOps {
+  using F = v128_t;
+  static constexpr uint32_t kWidth = 4u;
+
+  static F load(const float* p) { return wasm_v128_load(p); }
+  static void store(float* p, F v) { wasm_v128_store(p, v); }
+  static F set1(float v) { return wasm_f32x4_splat(v); }
+  static F add(F a, F b) { return wasm_f32x4_add(a, b); }
+  static F sub(F a, F b) { return wasm_f32x4_sub(a, b); }
+  static F mul(F a, F b) { return wasm_f32x4_mul(a, b); }
+  static F div(F a, F b) { return wasm_f32x4_div(a, b); }
+  static F sqrt(F a) { return wasm_f32x4_sqrt(a); }
+  static F min(F a, F b) { return wasm_f32x4_pmin(a, b); }
+  static F max(F a, F b) { return wasm_f32x4_pmax(a, b); }
+  static F sign_bit(F a) { return wasm_v128_and(a, set1(-0.f)); }
+  static F abs(F a) { return wasm_f32x4_abs(a); }
+  static F xor_bits(F a, F b) { return wasm_v128_xor(a, b); }
+  static F less_equal(F a, F b) { return wasm_f32x4_le(a, b); }
+  static F greater(F a, F b) { return wasm_f32x4_gt(a, b); }
+  static F less(F a, F b) { return wasm_f32x4_lt(a, b); }
+  static F select(F mask, F a, F b) { return wasm_v128_bitselect(a, b, mask); }
+  static uint32_t mask_bits(F mask) {
+    return static_cast<uint32_t>(wasm_i32x4_bitmask(mask));
+  }
+};
+#endif
+
+#if defined(SANCTIFY_LOCOMOTION_AVX2) || defined(SANCTIFY_LOCOMOTION_SSE2) || \
+    defined(SANCTIFY_LOCOMOTION_WASM_SIMD)
+#define SANCTIFY_LOCOMOTION_HAS_SIMD
+
+using F = SimdOps::F;
+
+// atan2(y, x) - octant reduction to atan(a) on a in [0, 1], then fix-up
+F atan2_approx(F y, F x) {
+  F ay = SimdOps::abs(y);
+  F ax = SimdOps::abs(x);
+  F lo = SimdOps::min(ax, ay);
+  F hi = SimdOps::max(SimdOps::max(ax, ay), SimdOps::set1(kMinDenominator));
+  F a = SimdOps::div(lo, hi);
+  F s = SimdOps::mul(a, a);
+
+  F p = SimdOps::set1(kAtanC5);
+  p = SimdOps::add(SimdOps::mul(p, s), SimdOps::set1(kAtanC4));
+  p = SimdOps::add(SimdOps::mul(p, s), SimdOps::set1(kAtanC3));
+  p = SimdOps::add(SimdOps::mul(p, s), SimdOps::set1(kAtanC2));
+  p = SimdOps::add(SimdOps::mul(p, s), SimdOps::set1(kAtanC1));
+  p = SimdOps::add(SimdOps::mul(p, s), SimdOps::set1(kAtanC0));
+  F r = SimdOps::mul(p, a);
+
+  r = SimdOps::select(SimdOps::greater(ay, ax),
+                      SimdOps::sub(SimdOps::set1(kHalfPi), r), r);
+  r = SimdOps::select(SimdOps::less(x, SimdOps::set1(0.f)),
+                      SimdOps::sub(SimdOps::set1(kPi), r), r);
+
+  // atan2 takes the sign of y (including -0)
+  return SimdOps::xor_bits(r, SimdOps::sign_bit(y));
+}
+
+// Advance "kWidth" lanes starting at "offset", return the reached lane mask
+//  (relative to lane 0 of the batch)
+uint32_t advance_lanes(LocomotionBatch* batch, uint32_t offset) {
+  F px = SimdOps::load(batch->positionX + offset);
+  F py = SimdOps::load(batch->positionY + offset);
+  F dx = SimdOps::sub(SimdOps::load(batch->targetX + offset), px);
+  F dy = SimdOps::sub(SimdOps::load(batch->targetY + offset), py);
+  F step = SimdOps::load(batch->step + offset);
+
+  F length = SimdOps::sqrt(
+      SimdOps::add(SimdOps::mul(dx, dx), SimdOps::mul(dy, dy)));
+  F reached = SimdOps::less_equal(length, step);
+
+  // Reached lanes divide by 1 instead of a (possibly zero) length, and keep
+  //  their original position - the scalar path takes them from here.
+  F safe_length = SimdOps::select(reached, SimdOps::set1(1.f), length);
+  F t = SimdOps::select(reached, SimdOps::set1(0.f),
+                        SimdOps::div(step, safe_length));
+
+  SimdOps::store(batch->positionX + offset,
+                 SimdOps::add(px, SimdOps::mul(dx, t)));
+  SimdOps::store(batch->positionY + offset,
+                 SimdOps::add(py, SimdOps::mul(dy, t)));
+  SimdOps::store(batch->orientation + offset, ::atan2_approx(dx, dy));
+
+  return SimdOps::mask_bits(reached) << offset;
+}
+#endif
+
+}  // namespace
+
+const char* LocomotionKernel::instruction_set() {
+#if defined(SANCTIFY_LOCOMOTION_AVX2)
+  return "avx2";
+#elif defined(SANCTIFY_LOCOMOTION_SSE2)
+  return "sse2";
+#elif defined(SANCTIFY_LOCOMOTION_WASM_SIMD)
+  return "wasm-simd128";
+#else
+  return "scalar";
+#endif
+}
+
+uint32_t LocomotionKernel::lane_width() {
+#ifdef SANCTIFY_LOCOMOTION_HAS_SIMD
+  return SimdOps::kWidth;
+#else
+  return 1u;
+#endif
+}
+
+uint32_t LocomotionKernel::advance(LocomotionBatch* batch) {
+#ifdef SANCTIFY_LOCOMOTION_HAS_SIMD
+  // Partial batches are padded with lanes that are already at their target,
+  //  which always report as reached and are masked off below
+  for (uint32_t i = batch->size; i < LocomotionBatch::kCapacity; i++) {
+    batch->positionX[i] = batch->positionY[i] = 0.f;
+    batch->targetX[i] = batch->targetY[i] = 0.f;
+    batch->step[i] = 0.f;
+  }
+
+  uint32_t reached = 0u;
+  for (uint32_t offset = 0u; offset < batch->size; offset += SimdOps::kWidth) {
+    reached |= ::advance_lanes(batch, offset);
+  }
+
+  return reached & ((1u << batch->size) - 1u);
+#else
+  return advance_scalar(batch);
+#endif
+}
+
+uint32_t LocomotionKernel::advance_scalar(LocomotionBatch* batch) {
+  uint32_t reached = 0u;
+  for (uint32_t i = 0u; i < batch->size; i++) {
+    float dx = batch->targetX[i] - batch->positionX[i];
+    float dy = batch->targetY[i] - batch->positionY[i];
+    float length = std::sqrt(dx * dx + dy * dy);
+
+    if (length <= batch->step[i]) {
+      reached |= (1u << i);
+      continue;
+    }
+
+    float t = batch->step[i] / length;
+    batch->positionX[i] += dx * t;
+    batch->positionY[i] += dy * t;
+    batch->orientation[i] = std::atan2(dx, dy);
+  }
+
+  return reached;
+}
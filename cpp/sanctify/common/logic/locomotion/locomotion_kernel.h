@@ -0,0 +1,67 @@
+#ifndef SANCTIFY_COMMON_LOGIC_LOCOMOTION_LOCOMOTION_KERNEL_H
+#define SANCTIFY_COMMON_LOGIC_LOCOMOTION_LOCOMOTION_KERNEL_H
+
+/**
+ * Batched (SoA) locomotion step, used by LocomotionSystem for the common case
+ *  of an entity walking towards a waypoint it will not reach this tick.
+ *
+ * The instruction set is picked at compile time - AVX2 (8 lanes) if the
+ *  compiler targets it, SSE2 (4 lanes) on other x86 builds, WASM SIMD128 (4
+ *  lanes) on web builds with -msimd128, and a plain scalar loop otherwise. See
+ *  IG_ENABLE_SIMD / IG_ENABLE_AVX2 in the root CMakeLists.txt.
+ *
+ * Vector results differ slightly from the scalar path, which normalizes the
+ *  direction before scaling it and uses an exact atan2:
+ *  - Positions are within kPositionTolerance, relative to max(1, |position|)
+ *  - Orientations are within kOrientationTolerance radians (polynomial atan2)
+ */
+
+#include <cstdint>
+
+namespace sanctify::logic {
+
+struct LocomotionBatch {
+  static constexpr uint32_t kCapacity = 8u;
+
+  // Inputs (positions are updated in place)
+  float positionX[kCapacity];
+  float positionY[kCapacity];
+  float targetX[kCapacity];
+  float targetY[kCapacity];
+  float step[kCapacity];
+
+  // Outputs
+  float orientation[kCapacity];
+
+  uint32_t size;
+};
+
+class LocomotionKernel {
+ public:
+  static constexpr float kPositionTolerance = 1e-4f;
+  static constexpr float kOrientationTolerance = 1e-4f;
+
+  /**
+   * Instruction set compiled into "advance" - one of "avx2", "sse2",
+   *  "wasm-simd128" or "scalar"
+   */
+  static const char* instruction_set();
+
+  /** Number of entities processed per vector instruction */
+  static uint32_t lane_width();
+
+  /**
+   * Move every lane "step" units towards its target, and write the resulting
+   *  orientation. Returns a bitmask of lanes that reach (or would pass) their
+   *  target this tick - those lanes are left unmodified and should be stepped
+   *  by the scalar path, which handles waypoint advancement.
+   */
+  static uint32_t advance(LocomotionBatch* batch);
+
+  /** Scalar reference implementation of "advance" */
+  static uint32_t advance_scalar(LocomotionBatch* batch);
+};
+
+}  // namespace sanctify::logic
+
+#endif
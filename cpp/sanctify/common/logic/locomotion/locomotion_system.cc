@@ -1,6 +1,8 @@
 #include "locomotion_system.h"
 
+#include <common/logic/locomotion/locomotion_kernel.h>
 #include <common/logic/update_common/tick_time_elapsed.h>
+#include <igcore/pod_vector.h>
 
 using namespace sanctify;
 using namespace logic;
@@ -17,6 +19,83 @@ WorldView::Decl build_locomotion_system_decl() {
       .writes<NavWaypointListComponent>();
 }
 const WorldView::Decl kLocomotionSystemDecl = ::build_locomotion_system_decl();
+
+// Walk an entity along its waypoint list. Returns true if the last waypoint
+//  was reached (and the waypoint list should be removed).
+bool step_entity(MapLocationComponent& map_location,
+                 NavWaypointListComponent& nav_waypoints,
+                 OrientationComponent& orientation, float remaining_distance) {
+  // Waypoint storage is read-only here - reached waypoints just move the
+  //  cursor forward, no per-waypoint shifting or reallocation
+  const glm::vec2* targets = LocomotionUtil::remaining_waypoints(nav_waypoints);
+  uint32_t remaining_targets =
+      LocomotionUtil::remaining_waypoint_count(nav_waypoints);
+
+  while (remaining_distance > 0.f) {
+    if (remaining_targets == 0u) {
+      break;
+    }
+
+    const glm::vec2& next_target = targets[0];
+    glm::vec2 direction = next_target - map_location.position;
+    float length = glm::length(direction);
+    glm::vec2 normal = direction / length;
+
+    if (length > remaining_distance) {
+      map_location.position += normal * remaining_distance;
+
+      // Face along the leg direction from before the move - the leftover
+      //  vector to the target can be arbitrarily short (and noisy) here
+      orientation.orientation = glm::atan(direction.x, direction.y);
+      return false;
+    }
+
+    map_location.position = next_target;
+    targets++;
+    remaining_targets--;
+    nav_waypoints.cursor++;
+    remaining_distance -= length;
+  }
+
+  if (remaining_targets == 0u) {
+    return true;
+  }
+
+  orientation.orientation = glm::atan(targets[0].x - map_location.position.x,
+                                      targets[0].y - map_location.position.y);
+  return false;
+}
+
+struct BatchEntity {
+  entt::entity e;
+  MapLocationComponent* mapLocation;
+  NavWaypointListComponent* navWaypoints;
+  OrientationComponent* orientation;
+};
+
+// Run the vector kernel over a full (or final partial) batch, then finish off
+//  any entities that reached a waypoint with the scalar step
+void flush_batch(LocomotionBatch* batch, BatchEntity* entities,
+                 indigo::core::PodVector<entt::entity>* finished) {
+  uint32_t reached = LocomotionKernel::advance(batch);
+
+  for (uint32_t i = 0; i < batch->size; i++) {
+    BatchEntity& entity = entities[i];
+    if ((reached & (1u << i)) == 0u) {
+      entity.mapLocation->position =
+          glm::vec2(batch->positionX[i], batch->positionY[i]);
+      entity.orientation->orientation = batch->orientation[i];
+      continue;
+    }
+
+    if (::step_entity(*entity.mapLocation, *entity.navWaypoints,
+                      *entity.orientation, batch->step[i])) {
+      finished->push_back(entity.e);
+    }
+  }
+
+  batch->size = 0u;
+}
 }  // namespace
 
 const WorldView::Decl& LocomotionSystem::decl() {
@@ -30,36 +109,56 @@ void LocomotionSystem::update(WorldView* wv) {
       wv->view<MapLocationComponent, NavWaypointListComponent,
                OrientationComponent, const StandardNavigationParamsComponent>();
 
+  // Entities are gathered into SoA batches and stepped together. Waypoint
+  //  list removal is deferred until after iteration, since a batch may finish
+  //  entities other than the one currently being visited.
+  LocomotionBatch batch{};
+  BatchEntity batch_entities[LocomotionBatch::kCapacity];
+  core::PodVector<entt::entity> finished(8);
+
   for (auto [e, map_location, nav_waypoints, orientation, standard_nav_params] :
        view.each()) {
-    float remaining_distance = dt * standard_nav_params.movementSpeed;
-
-    while (remaining_distance > 0.f) {
-      if (nav_waypoints.targets.size() == 0u) {
-        break;
-      }
-
-      const glm::vec2& next_target = nav_waypoints.targets[0];
-      glm::vec2 direction = next_target - map_location.position;
-      float length = glm::length(direction);
-      glm::vec2 normal = direction / length;
-
-      if (length > remaining_distance) {
-        map_location.position += normal * remaining_distance;
-        break;
-      }
-
-      map_location.position = nav_waypoints.targets[0];
-      nav_waypoints.targets.delete_at(0, true);
-      remaining_distance -= length;
+    if (LocomotionUtil::remaining_waypoint_count(nav_waypoints) == 0u) {
+      finished.push_back(e);
+      continue;
+    }
+
+    const glm::vec2& target =
+        LocomotionUtil::remaining_waypoints(nav_waypoints)[0];
+    uint32_t lane = batch.size++;
+    batch.positionX[lane] = map_location.position.x;
+    batch.positionY[lane] = map_location.position.y;
+    batch.targetX[lane] = target.x;
+    batch.targetY[lane] = target.y;
+    batch.step[lane] = dt * standard_nav_params.movementSpeed;
+    batch_entities[lane] = {e, &map_location, &nav_waypoints, &orientation};
+
+    if (batch.size == LocomotionBatch::kCapacity) {
+      ::flush_batch(&batch, batch_entities, &finished);
     }
+  }
+
+  if (batch.size > 0u) {
+    ::flush_batch(&batch, batch_entities, &finished);
+  }
+
+  for (int i = 0; i < finished.size(); i++) {
+    wv->remove<NavWaypointListComponent>(finished[i]);
+  }
+}
+
+void LocomotionSystem::update_scalar(WorldView* wv) {
+  float dt = FrameTimeElapsedUtil::dt(wv);
+
+  auto view =
+      wv->view<MapLocationComponent, NavWaypointListComponent,
+               OrientationComponent, const StandardNavigationParamsComponent>();
 
-    if (nav_waypoints.targets.size() == 0u) {
+  for (auto [e, map_location, nav_waypoints, orientation, standard_nav_params] :
+       view.each()) {
+    if (::step_entity(map_location, nav_waypoints, orientation,
+                      dt * standard_nav_params.movementSpeed)) {
       wv->remove<NavWaypointListComponent>(e);
-    } else {
-      orientation.orientation =
-          glm::atan(nav_waypoints.targets[0].x - map_location.position.x,
-                    nav_waypoints.targets[0].y - map_location.position.y);
     }
   }
 }
@@ -11,6 +11,12 @@ class LocomotionSystem {
  public:
   static const indigo::igecs::WorldView::Decl& decl();
   static void update(indigo::igecs::WorldView* world);
+
+  /**
+   * Reference implementation that steps one entity at a time - "update"
+   *  should match it within LocomotionKernel tolerances
+   */
+  static void update_scalar(indigo::igecs::WorldView* world);
 };
 
 }  // namespace sanctify::logic
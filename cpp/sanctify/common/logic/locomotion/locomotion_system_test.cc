@@ -1,9 +1,11 @@
 #include "locomotion_system.h"
 
+#include <common/logic/locomotion/locomotion_kernel.h>
 #include <common/logic/update_common/tick_time_elapsed.h>
 #include <gtest/gtest.h>
 
 #include <glm/gtc/constants.hpp>
+#include <random>
 
 using namespace sanctify;
 using namespace logic;
@@ -53,7 +55,7 @@ TEST(LocomotionSystem_Update, TravelsPartWayToFirstWaypoint) {
   expected_waypoints.push_back(glm::vec2(10.f, 0.f));
 
   EXPECT_EQ(*remaining_waypoints,
-            NavWaypointListComponent{std::move(expected_waypoints)});
+            LocomotionUtil::build_waypoint_list(expected_waypoints));
 }
 
 TEST(LocomotionSystem, TraversesMultipleWaypointsSmoothly) {
@@ -83,7 +85,7 @@ TEST(LocomotionSystem, TraversesMultipleWaypointsSmoothly) {
   expected_waypoints.push_back(glm::vec2{10.f, 10.f});
 
   EXPECT_EQ(*remaining_waypoints,
-            NavWaypointListComponent{std::move(expected_waypoints)});
+            LocomotionUtil::build_waypoint_list(expected_waypoints));
 }
 
 TEST(LocomotionSystem, FinishesLocomotionAtLastWaypoint) {
@@ -149,3 +151,116 @@ TEST(LocomotionSystem, UpdatesOrientationOnWalk) {
   LocomotionSystem::update(&wv);
   EXPECT_EQ(wv.read<OrientationComponent>(e).orientation, 2.f);
 }
+
+TEST(LocomotionSystem, TraversesSpilledWaypointList) {
+  entt::registry world;
+  WorldView thin_view = WorldView::Thin(&world);
+
+  auto e = world.create();
+  LocomotionUtil::attach_locomotion_components(&thin_view, e,
+                                               glm::vec2{0.f, 0.f}, 1.f);
+
+  // Longer than the inline buffer - should end up in the world arena
+  PodVector<glm::vec2> waypoints(12);
+  for (int i = 1; i <= 12; i++) {
+    waypoints.push_back(glm::vec2{static_cast<float>(i), 0.f});
+  }
+  LocomotionUtil::set_waypoints(&thin_view, e, waypoints);
+
+  const auto& arena = thin_view.ctx<CtxNavWaypointArena>().arena;
+  EXPECT_EQ(arena->live_blocks(), 1u);
+
+  FrameTimeElapsedUtil::mark_time_elapsed(&thin_view, 10.5f);
+  WorldView wv = LocomotionSystem::decl().create(&world);
+  LocomotionSystem::update(&wv);
+
+  EXPECT_EQ(LocomotionUtil::get_map_position(&thin_view, e),
+            glm::vec2(10.5f, 0.f));
+
+  const NavWaypointListComponent& remaining =
+      world.get<NavWaypointListComponent>(e);
+  ASSERT_EQ(LocomotionUtil::remaining_waypoint_count(remaining), 2u);
+  EXPECT_EQ(LocomotionUtil::remaining_waypoints(remaining)[0],
+            glm::vec2(11.f, 0.f));
+
+  // Copies (e.g. for snapshots) share the arena block instead of allocating
+  NavWaypointListComponent copy = remaining;
+  EXPECT_EQ(copy, remaining);
+  EXPECT_EQ(arena->live_blocks(), 1u);
+
+  FrameTimeElapsedUtil::mark_time_elapsed(&thin_view, 5.f);
+  LocomotionSystem::update(&wv);
+  EXPECT_FALSE(world.all_of<NavWaypointListComponent>(e));
+  EXPECT_EQ(arena->live_blocks(), 1u);
+}
+
+namespace {
+void build_random_walkers(entt::registry* world, uint32_t seed,
+                          uint32_t count) {
+  WorldView wv = WorldView::Thin(world);
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> coord(-50.f, 50.f);
+  std::uniform_real_distribution<float> speed(0.5f, 8.f);
+  std::uniform_int_distribution<int> path_length(1, 12);
+
+  for (uint32_t i = 0; i < count; i++) {
+    auto e = world->create();
+    LocomotionUtil::attach_locomotion_components(
+        &wv, e, glm::vec2(coord(rng), coord(rng)), speed(rng));
+
+    int num_waypoints = path_length(rng);
+    PodVector<glm::vec2> waypoints(num_waypoints);
+    for (int j = 0; j < num_waypoints; j++) {
+      waypoints.push_back(glm::vec2(coord(rng), coord(rng)));
+    }
+    LocomotionUtil::set_waypoints(&wv, e, waypoints);
+  }
+}
+
+float angle_difference(float a, float b) {
+  float d = glm::abs(a - b);
+  return glm::min(d, glm::two_pi<float>() - d);
+}
+}  // namespace
+
+TEST(LocomotionSystem, BatchedUpdateMatchesScalarUpdate) {
+  // Odd entity count so the last batch is a partial one
+  constexpr uint32_t kEntityCount = 203u;
+  constexpr int kTickCount = 400;
+
+  entt::registry batched_world, scalar_world;
+  ::build_random_walkers(&batched_world, 42u, kEntityCount);
+  ::build_random_walkers(&scalar_world, 42u, kEntityCount);
+
+  WorldView batched_thin = WorldView::Thin(&batched_world);
+  WorldView scalar_thin = WorldView::Thin(&scalar_world);
+  WorldView batched_wv = LocomotionSystem::decl().create(&batched_world);
+  WorldView scalar_wv = LocomotionSystem::decl().create(&scalar_world);
+
+  for (int tick = 0; tick < kTickCount; tick++) {
+    FrameTimeElapsedUtil::mark_time_elapsed(&batched_thin, 1.f / 60.f);
+    FrameTimeElapsedUtil::mark_time_elapsed(&scalar_thin, 1.f / 60.f);
+    LocomotionSystem::update(&batched_wv);
+    LocomotionSystem::update_scalar(&scalar_wv);
+  }
+
+  // Errors do not compound across waypoints, since every reached waypoint
+  //  snaps the entity to that waypoint's exact position
+  auto view = scalar_world.view<const MapLocationComponent,
+                                const OrientationComponent>();
+  for (auto [e, scalar_location, scalar_orientation] : view.each()) {
+    const auto& batched_location = batched_world.get<MapLocationComponent>(e);
+    const auto& batched_orientation =
+        batched_world.get<OrientationComponent>(e);
+
+    float position_scale =
+        glm::max(1.f, glm::length(scalar_location.position));
+    EXPECT_LE(glm::length(batched_location.position - scalar_location.position),
+              LocomotionKernel::kPositionTolerance * position_scale);
+    EXPECT_LE(::angle_difference(batched_orientation.orientation,
+                                 scalar_orientation.orientation),
+              LocomotionKernel::kOrientationTolerance);
+    EXPECT_EQ(batched_world.all_of<NavWaypointListComponent>(e),
+              scalar_world.all_of<NavWaypointListComponent>(e));
+  }
+}
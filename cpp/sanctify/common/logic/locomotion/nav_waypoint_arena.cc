@@ -0,0 +1,176 @@
+#include "nav_waypoint_arena.h"
+
+#include <cstring>
+#include <new>
+
+using namespace sanctify;
+using namespace logic;
+
+namespace {
+uint32_t capacity_for_class(uint32_t size_class) {
+  return NavWaypointArena::kMinBlockCapacity << size_class;
+}
+}  // namespace
+
+//
+// NavWaypointSpan
+//
+NavWaypointSpan::NavWaypointSpan() : arena_(nullptr), block_(nullptr) {}
+
+NavWaypointSpan::NavWaypointSpan(std::shared_ptr<NavWaypointArena> arena,
+                                 BlockHeader* block)
+    : arena_(std::move(arena)), block_(block) {}
+
+NavWaypointSpan::~NavWaypointSpan() { release(); }
+
+NavWaypointSpan::NavWaypointSpan(const NavWaypointSpan& o)
+    : arena_(o.arena_), block_(o.block_) {
+  if (block_) {
+    block_->refs.fetch_add(1u, std::memory_order_relaxed);
+  }
+}
+
+NavWaypointSpan& NavWaypointSpan::operator=(const NavWaypointSpan& o) {
+  if (this == &o) {
+    return *this;
+  }
+
+  if (o.block_) {
+    o.block_->refs.fetch_add(1u, std::memory_order_relaxed);
+  }
+  release();
+  arena_ = o.arena_;
+  block_ = o.block_;
+
+  return *this;
+}
+
+NavWaypointSpan::NavWaypointSpan(NavWaypointSpan&& o) noexcept
+    : arena_(std::move(o.arena_)), block_(o.block_) {
+  o.block_ = nullptr;
+}
+
+NavWaypointSpan& NavWaypointSpan::operator=(NavWaypointSpan&& o) noexcept {
+  if (this == &o) {
+    return *this;
+  }
+
+  release();
+  arena_ = std::move(o.arena_);
+  block_ = o.block_;
+  o.block_ = nullptr;
+
+  return *this;
+}
+
+const glm::vec2* NavWaypointSpan::data() const {
+  if (!block_) {
+    return nullptr;
+  }
+
+  return reinterpret_cast<const glm::vec2*>(block_ + 1);
+}
+
+uint32_t NavWaypointSpan::size() const { return block_ ? block_->count : 0u; }
+
+bool NavWaypointSpan::is_empty() const { return block_ == nullptr; }
+
+void NavWaypointSpan::release() {
+  if (block_ &&
+      block_->refs.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+    arena_->release(block_);
+  }
+
+  block_ = nullptr;
+  arena_ = nullptr;
+}
+
+//
+// NavWaypointArena
+//
+std::shared_ptr<NavWaypointArena> NavWaypointArena::Create() {
+  return std::make_shared<NavWaypointArena>();
+}
+
+std::shared_ptr<NavWaypointArena> NavWaypointArena::Detached() {
+  static std::shared_ptr<NavWaypointArena> detached_arena = Create();
+  return detached_arena;
+}
+
+NavWaypointArena::NavWaypointArena()
+    : chunk_cursor_(nullptr), chunk_remaining_(0u), live_blocks_(0u) {}
+
+NavWaypointSpan NavWaypointArena::allocate(const glm::vec2* waypoints,
+                                           uint32_t count) {
+  if (count == 0u) {
+    return NavWaypointSpan();
+  }
+
+  uint32_t size_class = 0u;
+  while (size_class < kNumSizeClasses &&
+         capacity_for_class(size_class) < count) {
+    size_class++;
+  }
+
+  BlockHeader* block = nullptr;
+  {
+    std::lock_guard<std::mutex> l(mut_);
+    live_blocks_++;
+
+    if (size_class == kOversizeClass) {
+      // Nothing this long comes out of Detour in practice - give it a
+      //  dedicated allocation instead of wasting a whole chunk on it
+      uint8_t* raw =
+          new uint8_t[sizeof(BlockHeader) + sizeof(glm::vec2) * count];
+      block = reinterpret_cast<BlockHeader*>(raw);
+    } else if (!free_lists_[size_class].empty()) {
+      block = free_lists_[size_class].back();
+      free_lists_[size_class].pop_back();
+    } else {
+      size_t bytes = sizeof(BlockHeader) +
+                     sizeof(glm::vec2) * capacity_for_class(size_class);
+      if (chunk_remaining_ < bytes) {
+        chunks_.push_back(std::make_unique<uint8_t[]>(kChunkSizeBytes));
+        chunk_cursor_ = chunks_.back().get();
+        chunk_remaining_ = kChunkSizeBytes;
+      }
+      block = reinterpret_cast<BlockHeader*>(chunk_cursor_);
+      chunk_cursor_ += bytes;
+      chunk_remaining_ -= bytes;
+    }
+  }
+
+  new (block) BlockHeader{};
+  block->refs.store(1u, std::memory_order_relaxed);
+  block->sizeClass = size_class;
+  block->count = count;
+  std::memcpy(reinterpret_cast<glm::vec2*>(block + 1), waypoints,
+              sizeof(glm::vec2) * count);
+
+  return NavWaypointSpan(shared_from_this(), block);
+}
+
+uint32_t NavWaypointArena::live_blocks() const {
+  std::lock_guard<std::mutex> l(mut_);
+  return live_blocks_;
+}
+
+size_t NavWaypointArena::reserved_bytes() const {
+  std::lock_guard<std::mutex> l(mut_);
+  return chunks_.size() * kChunkSizeBytes;
+}
+
+void NavWaypointArena::release(BlockHeader* block) {
+  uint32_t size_class = block->sizeClass;
+  block->~BlockHeader();
+
+  std::lock_guard<std::mutex> l(mut_);
+  live_blocks_--;
+
+  if (size_class == kOversizeClass) {
+    delete[] reinterpret_cast<uint8_t*>(block);
+    return;
+  }
+
+  free_lists_[size_class].push_back(block);
+}
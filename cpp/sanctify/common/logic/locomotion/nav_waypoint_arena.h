@@ -0,0 +1,109 @@
+#ifndef SANCTIFY_COMMON_LOGIC_LOCOMOTION_NAV_WAYPOINT_ARENA_H
+#define SANCTIFY_COMMON_LOGIC_LOCOMOTION_NAV_WAYPOINT_ARENA_H
+
+/**
+ * Backing storage for navigation paths that are too long to fit inline in a
+ *  NavWaypointListComponent.
+ *
+ * Paths are copied into fixed size-class blocks carved out of large chunks, so
+ *  a world's long paths sit next to each other in memory instead of being
+ *  scattered across individual heap allocations. Blocks are immutable once
+ *  written and reference counted - copying a span (e.g. into a snapshot) only
+ *  bumps a counter, and the block goes back on the free list when the last
+ *  span referencing it is destroyed.
+ *
+ * Spans keep their arena alive, so a span copied out of a world stays valid
+ *  after the world (and its CtxNavWaypointArena) is gone.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sanctify::logic {
+
+class NavWaypointArena;
+
+class NavWaypointSpan {
+ public:
+  NavWaypointSpan();
+  ~NavWaypointSpan();
+  NavWaypointSpan(const NavWaypointSpan& o);
+  NavWaypointSpan& operator=(const NavWaypointSpan& o);
+  NavWaypointSpan(NavWaypointSpan&& o) noexcept;
+  NavWaypointSpan& operator=(NavWaypointSpan&& o) noexcept;
+
+  const glm::vec2* data() const;
+  uint32_t size() const;
+  bool is_empty() const;
+
+ private:
+  friend class NavWaypointArena;
+
+  struct BlockHeader {
+    std::atomic<uint32_t> refs;
+    uint32_t sizeClass;
+    uint32_t count;
+    uint32_t padding;
+  };
+
+  NavWaypointSpan(std::shared_ptr<NavWaypointArena> arena, BlockHeader* block);
+  void release();
+
+  std::shared_ptr<NavWaypointArena> arena_;
+  BlockHeader* block_;
+};
+
+class NavWaypointArena
+    : public std::enable_shared_from_this<NavWaypointArena> {
+ public:
+  /** Smallest block capacity, in waypoints - each size class doubles it */
+  static constexpr uint32_t kMinBlockCapacity = 16u;
+  static constexpr uint32_t kNumSizeClasses = 7u;
+  static constexpr uint32_t kChunkSizeBytes = 64u * 1024u;
+
+  static std::shared_ptr<NavWaypointArena> Create();
+
+  /**
+   * Shared arena for waypoint lists built outside of any world (network
+   *  deserialization, tests)
+   */
+  static std::shared_ptr<NavWaypointArena> Detached();
+
+  NavWaypointArena();
+  NavWaypointArena(const NavWaypointArena&) = delete;
+  NavWaypointArena& operator=(const NavWaypointArena&) = delete;
+
+  /** Copy "count" waypoints into a new block owned by this arena */
+  NavWaypointSpan allocate(const glm::vec2* waypoints, uint32_t count);
+
+  /** Number of blocks currently referenced by at least one span */
+  uint32_t live_blocks() const;
+
+  /** Bytes held in chunks (live, free and not yet carved) */
+  size_t reserved_bytes() const;
+
+ private:
+  friend class NavWaypointSpan;
+
+  using BlockHeader = NavWaypointSpan::BlockHeader;
+
+  /** Size class used for blocks too large for any chunk */
+  static constexpr uint32_t kOversizeClass = kNumSizeClasses;
+
+  void release(BlockHeader* block);
+
+  mutable std::mutex mut_;
+  std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+  uint8_t* chunk_cursor_;
+  size_t chunk_remaining_;
+  std::vector<BlockHeader*> free_lists_[kNumSizeClasses];
+  uint32_t live_blocks_;
+};
+
+}  // namespace sanctify::logic
+
+#endif
@@ -0,0 +1,86 @@
+#include "nav_waypoint_arena.h"
+
+#include <gtest/gtest.h>
+
+using namespace sanctify;
+using namespace logic;
+
+namespace {
+std::vector<glm::vec2> build_path(uint32_t count) {
+  std::vector<glm::vec2> path;
+  for (uint32_t i = 0; i < count; i++) {
+    path.push_back(glm::vec2(static_cast<float>(i), 1.f));
+  }
+  return path;
+}
+}  // namespace
+
+TEST(NavWaypointArena, CopiesWaypointsIntoBlock) {
+  auto arena = NavWaypointArena::Create();
+  auto path = ::build_path(20u);
+
+  NavWaypointSpan span = arena->allocate(&path[0], 20u);
+
+  ASSERT_FALSE(span.is_empty());
+  EXPECT_EQ(span.size(), 20u);
+  for (uint32_t i = 0; i < 20u; i++) {
+    EXPECT_EQ(span.data()[i], path[i]);
+  }
+  EXPECT_EQ(arena->live_blocks(), 1u);
+}
+
+TEST(NavWaypointArena, CopiesShareBlock) {
+  auto arena = NavWaypointArena::Create();
+  auto path = ::build_path(20u);
+
+  NavWaypointSpan span = arena->allocate(&path[0], 20u);
+  NavWaypointSpan copy = span;
+
+  EXPECT_EQ(copy.data(), span.data());
+  EXPECT_EQ(arena->live_blocks(), 1u);
+
+  span = NavWaypointSpan();
+  EXPECT_EQ(arena->live_blocks(), 1u);
+
+  copy = NavWaypointSpan();
+  EXPECT_EQ(arena->live_blocks(), 0u);
+}
+
+TEST(NavWaypointArena, ReusesFreedBlocks) {
+  auto arena = NavWaypointArena::Create();
+  auto path = ::build_path(30u);
+
+  const glm::vec2* first_data = nullptr;
+  {
+    NavWaypointSpan span = arena->allocate(&path[0], 30u);
+    first_data = span.data();
+  }
+
+  NavWaypointSpan span = arena->allocate(&path[0], 17u);
+  EXPECT_EQ(span.data(), first_data);
+  EXPECT_EQ(arena->reserved_bytes(), NavWaypointArena::kChunkSizeBytes);
+}
+
+TEST(NavWaypointArena, HandlesOversizedPaths) {
+  auto arena = NavWaypointArena::Create();
+  auto path = ::build_path(5000u);
+
+  NavWaypointSpan span = arena->allocate(&path[0], 5000u);
+
+  ASSERT_EQ(span.size(), 5000u);
+  EXPECT_EQ(span.data()[4999], path[4999]);
+  EXPECT_EQ(arena->reserved_bytes(), 0u);
+
+  span = NavWaypointSpan();
+  EXPECT_EQ(arena->live_blocks(), 0u);
+}
+
+TEST(NavWaypointArena, SpanOutlivesArenaOwner) {
+  auto arena = NavWaypointArena::Create();
+  auto path = ::build_path(20u);
+
+  NavWaypointSpan span = arena->allocate(&path[0], 20u);
+  arena = nullptr;
+
+  EXPECT_EQ(span.data()[19], path[19]);
+}
@@ -12,7 +12,7 @@ NavWaypointListComponent build_test_nav_waypoint_component() {
   indigo::core::PodVector<glm::vec2> waypoints(2);
   waypoints.push_back(glm::vec2(5.f, 0.f));
   waypoints.push_back(glm::vec2(5.f, 10.f));
-  return NavWaypointListComponent{std::move(waypoints)};
+  return LocomotionUtil::build_waypoint_list(waypoints);
 }
 }  // namespace
 
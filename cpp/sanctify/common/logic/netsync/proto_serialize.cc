@@ -48,18 +48,31 @@ OrientationComponent logic::deserialize(
 // NavWaypointListComponent
 void logic::serialize(common::proto::NavWaypointListComponent* mut_cb,
                       const NavWaypointListComponent& val) {
-  for (int i = 0; i < val.targets.size(); i++) {
-    ::serialize(mut_cb->add_targets(), val.targets[i]);
+  const glm::vec2* targets = LocomotionUtil::remaining_waypoints(val);
+  uint32_t count = LocomotionUtil::remaining_waypoint_count(val);
+  for (uint32_t i = 0; i < count; i++) {
+    ::serialize(mut_cb->add_targets(), targets[i]);
   }
 }
 
 NavWaypointListComponent logic::deserialize(
     const common::proto::NavWaypointListComponent& pb) {
+  // Short paths decode straight into inline storage without a temp buffer
+  uint32_t count = static_cast<uint32_t>(pb.targets_size());
+  if (count <= NavWaypointListComponent::kInlineCapacity) {
+    NavWaypointListComponent waypoints{};
+    waypoints.count = count;
+    for (int i = 0; i < pb.targets_size(); i++) {
+      waypoints.inlineTargets[i] = ::deserialize(pb.targets(i));
+    }
+    return waypoints;
+  }
+
   indigo::core::PodVector<glm::vec2> waypoints(pb.targets_size());
   for (int i = 0; i < pb.targets_size(); i++) {
     waypoints.push_back(::deserialize(pb.targets(i)));
   }
-  return {std::move(waypoints)};
+  return LocomotionUtil::build_waypoint_list(waypoints);
 }
 
 // StandardNavigationParamsComponent
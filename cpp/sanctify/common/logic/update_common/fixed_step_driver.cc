@@ -0,0 +1,117 @@
+#include "fixed_step_driver.h"
+
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace sanctify;
+using namespace logic;
+using namespace indigo;
+
+FixedStepDriver::FixedStepDriver(float tick_seconds, uint32_t max_catchup_ticks)
+    : tick_seconds_(tick_seconds),
+      max_catchup_ticks_(max_catchup_ticks < 1u ? 1u : max_catchup_ticks),
+      accumulator_(0.f),
+      stats_{} {}
+
+uint32_t FixedStepDriver::advance(float wall_dt) {
+  if (wall_dt > 0.f) {
+    accumulator_ += wall_dt;
+  }
+
+  // Count ticks off the accumulator with subtraction rather than a division -
+  //  the leftover is carried forward exactly, which keeps tick counts stable
+  //  for identical wall_dt sequences.
+  uint32_t ticks = 0u;
+  while (accumulator_ >= tick_seconds_ && ticks < max_catchup_ticks_) {
+    accumulator_ -= tick_seconds_;
+    ticks++;
+  }
+
+  // Anything left beyond a full tick after the catch-up limit is dropped
+  if (accumulator_ >= tick_seconds_) {
+    uint64_t dropped = static_cast<uint64_t>(accumulator_ / tick_seconds_);
+    stats_.missedTicks += dropped;
+    accumulator_ -= dropped * tick_seconds_;
+  }
+
+  return ticks;
+}
+
+float FixedStepDriver::tick_dt() const { return tick_seconds_; }
+
+float FixedStepDriver::accumulator() const { return accumulator_; }
+
+float FixedStepDriver::interpolation_alpha() const {
+  return accumulator_ / tick_seconds_;
+}
+
+float FixedStepDriver::seconds_until_next_tick() const {
+  return tick_seconds_ - accumulator_;
+}
+
+void FixedStepDriver::record_tick_duration(float seconds) {
+  stats_.ticksRun++;
+
+  if (seconds > tick_seconds_) {
+    stats_.overrunTicks++;
+  }
+
+  if (seconds > stats_.longestTickSeconds) {
+    stats_.longestTickSeconds = seconds;
+  }
+
+  size_t bucket = FixedStepTickStats::kNumBuckets - 1;
+  for (size_t i = 0; i < FixedStepTickStats::kBucketTickFractions.size(); i++) {
+    if (seconds <= FixedStepTickStats::kBucketTickFractions[i] * tick_seconds_) {
+      bucket = i;
+      break;
+    }
+  }
+  stats_.durationHistogram[bucket]++;
+}
+
+const FixedStepTickStats& FixedStepDriver::stats() const { return stats_; }
+
+void FixedStepDriver::reset_stats() { stats_ = FixedStepTickStats{}; }
+
+std::string FixedStepDriver::stats_report() const {
+  std::stringstream ss;
+  ss << std::setprecision(3) << "Ticks: " << stats_.ticksRun
+     << " (overrun: " << stats_.overrunTicks
+     << ", missed: " << stats_.missedTicks
+     << ", longest: " << stats_.longestTickSeconds * 1000.f << "ms)";
+
+  float lower_ms = 0.f;
+  for (size_t i = 0; i < FixedStepTickStats::kNumBuckets; i++) {
+    ss << "\n  ";
+    if (i < FixedStepTickStats::kBucketTickFractions.size()) {
+      float upper_ms =
+          FixedStepTickStats::kBucketTickFractions[i] * tick_seconds_ * 1000.f;
+      ss << lower_ms << "-" << upper_ms << "ms: ";
+      lower_ms = upper_ms;
+    } else {
+      ss << ">" << lower_ms << "ms: ";
+    }
+    ss << stats_.durationHistogram[i];
+  }
+
+  return ss.str();
+}
+
+void FixedStepDriver::wait_until(Clock::time_point deadline,
+                                 Clock::duration spin_window) {
+  if (spin_window <= Clock::duration::zero()) {
+    std::this_thread::sleep_until(deadline);
+    return;
+  }
+
+  auto sleep_deadline = deadline - spin_window;
+  if (Clock::now() < sleep_deadline) {
+    std::this_thread::sleep_until(sleep_deadline);
+  }
+
+  while (Clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+}
@@ -0,0 +1,120 @@
+#ifndef SANCTIFY_COMMON_LOGIC_UPDATE_COMMON_FIXED_STEP_DRIVER_H
+#define SANCTIFY_COMMON_LOGIC_UPDATE_COMMON_FIXED_STEP_DRIVER_H
+
+/**
+ * Fixed-timestep tick driver shared by the game server and offline client.
+ *
+ * Wall clock time is fed in via "advance", which accumulates it and returns how
+ *  many fixed-size simulation ticks should be run to keep sim time in step with
+ *  wall time. If the simulation falls too far behind (e.g. a long GC pause or a
+ *  breakpoint), catch-up is bounded and the extra ticks are dropped and counted
+ *  as missed instead of spiralling.
+ *
+ * Each simulation tick should be run with "tick_dt()" as its time elapsed (see
+ *  FrameTimeElapsedUtil::mark_time_elapsed), so simulation results depend only
+ *  on the number of ticks run and not on the host frame rate.
+ */
+
+#include <common/logic/update_common/tick_time_elapsed.h>
+#include <igecs/world_view.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace sanctify::logic {
+
+struct FixedStepTickStats {
+  /** Upper bounds (in multiples of the tick length) of each histogram bucket */
+  static constexpr std::array<float, 5> kBucketTickFractions = {
+      0.125f, 0.25f, 0.5f, 1.f, 2.f};
+  static constexpr size_t kNumBuckets = kBucketTickFractions.size() + 1;
+
+  /** Tick duration histogram - last bucket is everything over 2x tick length */
+  std::array<uint32_t, kNumBuckets> durationHistogram;
+
+  uint64_t ticksRun;
+
+  /** Ticks that took longer than the tick length to simulate */
+  uint64_t overrunTicks;
+
+  /** Ticks dropped because the catch-up limit was reached */
+  uint64_t missedTicks;
+
+  float longestTickSeconds;
+};
+
+class FixedStepDriver {
+ public:
+  using Clock = std::chrono::high_resolution_clock;
+
+  FixedStepDriver(float tick_seconds, uint32_t max_catchup_ticks);
+
+  /**
+   * Accumulate wall clock time, and return the number of fixed ticks that
+   *  should be simulated this frame (at most max_catchup_ticks)
+   */
+  uint32_t advance(float wall_dt);
+
+  /** Length of a single simulation tick, in seconds */
+  float tick_dt() const;
+
+  /** Time left on the accumulator after the ticks returned by "advance" */
+  float accumulator() const;
+
+  /** Fraction of a tick on the accumulator - for render interpolation */
+  float interpolation_alpha() const;
+
+  /** How much wall time until the accumulator holds another full tick */
+  float seconds_until_next_tick() const;
+
+  /** Report how long a single tick took to simulate (for telemetry only) */
+  void record_tick_duration(float seconds);
+
+  const FixedStepTickStats& stats() const;
+  void reset_stats();
+  std::string stats_report() const;
+
+  /**
+   * Hybrid wait: OS sleep until "spin_window" before the deadline, then busy
+   *  wait the remainder. OS sleeps routinely overshoot by a millisecond or more,
+   *  so spinning the tail end gives sub-millisecond tick jitter at the expense
+   *  of some CPU. A zero spin window is a plain sleep_until.
+   */
+  static void wait_until(Clock::time_point deadline,
+                         Clock::duration spin_window);
+
+  /**
+   * Convenience for ECS callers - run the driver for a frame, and call the
+   *  tick function once for every fixed step after marking tick time elapsed
+   */
+  template <typename TickFnT>
+  uint32_t run_frame(indigo::igecs::WorldView* wv, float wall_dt,
+                     TickFnT&& tick_fn);
+
+ private:
+  float tick_seconds_;
+  uint32_t max_catchup_ticks_;
+  float accumulator_;
+
+  FixedStepTickStats stats_;
+};
+
+template <typename TickFnT>
+uint32_t FixedStepDriver::run_frame(indigo::igecs::WorldView* wv, float wall_dt,
+                                    TickFnT&& tick_fn) {
+  uint32_t ticks = advance(wall_dt);
+  for (uint32_t i = 0; i < ticks; i++) {
+    auto tick_start = Clock::now();
+    FrameTimeElapsedUtil::mark_time_elapsed(wv, tick_seconds_);
+    tick_fn();
+    record_tick_duration(
+        std::chrono::duration<float>(Clock::now() - tick_start).count());
+  }
+  return ticks;
+}
+
+}  // namespace sanctify::logic
+
+#endif
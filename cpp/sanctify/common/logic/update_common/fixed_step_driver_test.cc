@@ -0,0 +1,81 @@
+#include "fixed_step_driver.h"
+
+#include <gtest/gtest.h>
+
+using namespace sanctify;
+using namespace logic;
+using namespace indigo;
+
+TEST(FixedStepDriver, AccumulatesPartialFrames) {
+  FixedStepDriver driver(0.25f, 4u);
+
+  EXPECT_EQ(driver.advance(0.125f), 0u);
+  EXPECT_FLOAT_EQ(driver.interpolation_alpha(), 0.5f);
+
+  EXPECT_EQ(driver.advance(0.125f), 1u);
+  EXPECT_FLOAT_EQ(driver.accumulator(), 0.f);
+
+  EXPECT_EQ(driver.advance(0.625f), 2u);
+  EXPECT_FLOAT_EQ(driver.accumulator(), 0.125f);
+  EXPECT_FLOAT_EQ(driver.seconds_until_next_tick(), 0.125f);
+}
+
+TEST(FixedStepDriver, CatchesUpOverrunTicks) {
+  FixedStepDriver driver(0.25f, 4u);
+
+  // A single long frame is made up on the next call rather than lost
+  EXPECT_EQ(driver.advance(0.75f), 3u);
+  EXPECT_EQ(driver.stats().missedTicks, 0u);
+}
+
+TEST(FixedStepDriver, BoundsCatchUpAndCountsMissedTicks) {
+  FixedStepDriver driver(0.25f, 4u);
+
+  EXPECT_EQ(driver.advance(2.125f), 4u);
+  EXPECT_EQ(driver.stats().missedTicks, 4u);
+
+  // Leftover partial tick is kept, dropped ticks are not
+  EXPECT_FLOAT_EQ(driver.accumulator(), 0.125f);
+  EXPECT_EQ(driver.advance(0.f), 0u);
+}
+
+TEST(FixedStepDriver, RecordsTickDurationHistogram) {
+  FixedStepDriver driver(1.f, 4u);
+
+  driver.record_tick_duration(0.1f);
+  driver.record_tick_duration(0.2f);
+  driver.record_tick_duration(0.9f);
+  driver.record_tick_duration(1.5f);
+  driver.record_tick_duration(3.f);
+
+  const auto& stats = driver.stats();
+  EXPECT_EQ(stats.ticksRun, 5u);
+  EXPECT_EQ(stats.overrunTicks, 2u);
+  EXPECT_FLOAT_EQ(stats.longestTickSeconds, 3.f);
+  EXPECT_EQ(stats.durationHistogram[0], 1u);
+  EXPECT_EQ(stats.durationHistogram[1], 1u);
+  EXPECT_EQ(stats.durationHistogram[2], 0u);
+  EXPECT_EQ(stats.durationHistogram[3], 1u);
+  EXPECT_EQ(stats.durationHistogram[4], 1u);
+  EXPECT_EQ(stats.durationHistogram[5], 1u);
+
+  driver.reset_stats();
+  EXPECT_EQ(driver.stats().ticksRun, 0u);
+}
+
+TEST(FixedStepDriver, RunFrameAdvancesSimTimeInFixedSteps) {
+  entt::registry world;
+  auto wv = igecs::WorldView::Thin(&world);
+  FixedStepDriver driver(0.25f, 8u);
+
+  uint32_t tick_count = 0u;
+  auto tick_fn = [&tick_count]() { tick_count++; };
+
+  EXPECT_EQ(driver.run_frame(&wv, 0.375f, tick_fn), 1u);
+  EXPECT_EQ(driver.run_frame(&wv, 0.375f, tick_fn), 2u);
+  EXPECT_EQ(tick_count, 3u);
+
+  EXPECT_FLOAT_EQ(FrameTimeElapsedUtil::dt(&wv), 0.25f);
+  EXPECT_FLOAT_EQ(FrameTimeElapsedUtil::get_sim_time(&wv), 0.75f);
+  EXPECT_EQ(driver.stats().ticksRun, 3u);
+}
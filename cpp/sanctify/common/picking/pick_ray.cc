@@ -0,0 +1,114 @@
+#include "pick_ray.h"
+
+#include <algorithm>
+
+using namespace sanctify;
+using namespace picking;
+
+PickRay PickRay::from_screen(const glm::mat4& mat_view_proj,
+                             const glm::vec3& camera_position, float x_pct,
+                             float y_pct) {
+  glm::vec4 far_ndc(x_pct * 2.f - 1.f, 1.f - y_pct * 2.f, 1.f, 1.f);
+  glm::vec4 far_world = glm::inverse(mat_view_proj) * far_ndc;
+
+  return PickRay{camera_position,
+                 glm::vec3(far_world) / far_world.w - camera_position};
+}
+
+PickRay PickRay::transformed(const glm::mat4& mat) const {
+  return PickRay{glm::vec3(mat * glm::vec4(origin, 1.f)),
+                 glm::vec3(mat * glm::vec4(direction, 0.f))};
+}
+
+bool picking::intersect_triangle(const PickRay& ray, const glm::vec3& a,
+                                 const glm::vec3& b, const glm::vec3& c,
+                                 float max_t, float* o_t) {
+  return intersect_triangle_edges(ray, a, b - a, c - a, max_t, o_t);
+}
+
+bool picking::intersect_triangle_edges(const PickRay& ray, const glm::vec3& v0,
+                                       const glm::vec3& e1,
+                                       const glm::vec3& e2, float max_t,
+                                       float* o_t) {
+  const float kEpsilon = 1e-9f;
+
+  glm::vec3 p = glm::cross(ray.direction, e2);
+  float det = glm::dot(e1, p);
+  if (det > -kEpsilon && det < kEpsilon) {
+    return false;
+  }
+
+  float inv_det = 1.f / det;
+  glm::vec3 s = ray.origin - v0;
+  float u = glm::dot(s, p) * inv_det;
+  if (u < 0.f || u > 1.f) {
+    return false;
+  }
+
+  glm::vec3 q = glm::cross(s, e1);
+  float v = glm::dot(ray.direction, q) * inv_det;
+  if (v < 0.f || u + v > 1.f) {
+    return false;
+  }
+
+  float t = glm::dot(e2, q) * inv_det;
+  if (t < 0.f || t >= max_t) {
+    return false;
+  }
+
+  *o_t = t;
+  return true;
+}
+
+bool picking::intersect_sphere(const PickRay& ray, const glm::vec3& center,
+                               float radius, float max_t, float* o_t) {
+  glm::vec3 oc = ray.origin - center;
+  float a = glm::dot(ray.direction, ray.direction);
+  float half_b = glm::dot(oc, ray.direction);
+  float c = glm::dot(oc, oc) - radius * radius;
+
+  float discriminant = half_b * half_b - a * c;
+  if (discriminant < 0.f || a <= 0.f) {
+    return false;
+  }
+
+  float sqrt_d = glm::sqrt(discriminant);
+  float t_far = (-half_b + sqrt_d) / a;
+  if (t_far < 0.f) {
+    return false;
+  }
+
+  float t = std::max((-half_b - sqrt_d) / a, 0.f);
+  if (t >= max_t) {
+    return false;
+  }
+
+  *o_t = t;
+  return true;
+}
+
+bool picking::intersect_aabb(const glm::vec3& origin,
+                             const glm::vec3& inv_direction,
+                             const glm::vec3& box_min,
+                             const glm::vec3& box_max, float max_t,
+                             float* o_t_enter, float* o_t_exit) {
+  glm::vec3 t0 = (box_min - origin) * inv_direction;
+  glm::vec3 t1 = (box_max - origin) * inv_direction;
+  glm::vec3 t_near = glm::min(t0, t1);
+  glm::vec3 t_far = glm::max(t0, t1);
+
+  float t_enter =
+      std::max(std::max(t_near.x, t_near.y), std::max(t_near.z, 0.f));
+  float t_exit =
+      std::min(std::min(t_far.x, t_far.y), std::min(t_far.z, max_t));
+
+  if (t_enter > t_exit) {
+    return false;
+  }
+
+  *o_t_enter = t_enter;
+  if (o_t_exit) {
+    *o_t_exit = t_exit;
+  }
+  return true;
+}
@@ -0,0 +1,81 @@
+#ifndef SANCTIFY_COMMON_PICKING_PICK_RAY_H
+#define SANCTIFY_COMMON_PICKING_PICK_RAY_H
+
+/**
+ * Rays and the primitive intersection tests picking is built on.
+ *
+ * No GPU or ECS types in here (or anywhere in picking), so clients and the
+ *  game server can answer the same ray queries - a client picks what was
+ *  clicked, the server can check a click target against the same geometry.
+ */
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+
+namespace sanctify::picking {
+
+/**
+ * Ray with a direction that does not need to be normalized - hit distances
+ *  ("t") are in multiples of the direction length, so transforming a ray into
+ *  object space (non-uniform scale and all) keeps distances comparable.
+ */
+struct PickRay {
+  glm::vec3 origin;
+  glm::vec3 direction;
+
+  /**
+   * Ray from the camera through a point on screen - x_pct/y_pct are in [0, 1]
+   *  from the top left of the viewport (like a click event). Works for either
+   *  depth range convention, only the far plane is un-projected.
+   */
+  static PickRay from_screen(const glm::mat4& mat_view_proj,
+                             const glm::vec3& camera_position, float x_pct,
+                             float y_pct);
+
+  /** Same ray in the space "mat" transforms into (e.g. inverse world) */
+  PickRay transformed(const glm::mat4& mat) const;
+
+  glm::vec3 at(float t) const { return origin + direction * t; }
+};
+
+/** Closest hit - "id" is a triangle index or unit ID, depending on the query */
+struct RayHit {
+  float t;
+  uint32_t id;
+};
+
+constexpr float kNoHit = std::numeric_limits<float>::infinity();
+
+/**
+ * Two-sided ray/triangle test (Moller-Trumbore) - writes the hit distance to
+ *  "o_t" and returns true on a hit in [0, max_t)
+ */
+bool intersect_triangle(const PickRay& ray, const glm::vec3& a,
+                        const glm::vec3& b, const glm::vec3& c, float max_t,
+                        float* o_t);
+
+/**
+ * Same test against a triangle given as one vertex and the two edges leaving
+ *  it (b - a, c - a), for callers that store triangles that way
+ */
+bool intersect_triangle_edges(const PickRay& ray, const glm::vec3& v0,
+                              const glm::vec3& e1, const glm::vec3& e2,
+                              float max_t, float* o_t);
+
+/** Ray/sphere test - a ray starting inside the sphere hits at t = 0 */
+bool intersect_sphere(const PickRay& ray, const glm::vec3& center,
+                      float radius, float max_t, float* o_t);
+
+/**
+ * Slab test against an axis aligned box, with the reciprocal of the ray
+ *  direction precomputed - writes the entry (and optionally exit) distance of
+ *  the part of the ray in [0, max_t) that is inside the box
+ */
+bool intersect_aabb(const glm::vec3& origin, const glm::vec3& inv_direction,
+                    const glm::vec3& box_min, const glm::vec3& box_max,
+                    float max_t, float* o_t_enter, float* o_t_exit = nullptr);
+
+}  // namespace sanctify::picking
+
+#endif
@@ -0,0 +1,82 @@
+#include "pick_ray.h"
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace sanctify;
+using namespace picking;
+
+namespace {
+const float kEpsilon = 0.0001f;
+}
+
+TEST(PickRay, ScreenCenterRayFollowsCameraDirection) {
+  glm::vec3 camera_pos(3.f, 10.f, 5.f);
+  glm::vec3 look_at(3.f, 0.f, -5.f);
+  glm::mat4 mat_view = glm::lookAt(camera_pos, look_at, glm::vec3(0, 1, 0));
+  glm::mat4 mat_proj = glm::perspective(glm::radians(60.f), 1.5f, 0.1f, 100.f);
+
+  PickRay ray = PickRay::from_screen(mat_proj * mat_view, camera_pos, 0.5f,
+                                     0.5f);
+
+  EXPECT_NEAR(glm::distance(ray.origin, camera_pos), 0.f, kEpsilon);
+  glm::vec3 expected = glm::normalize(look_at - camera_pos);
+  EXPECT_NEAR(glm::dot(glm::normalize(ray.direction), expected), 1.f,
+              kEpsilon);
+}
+
+TEST(PickRay, ScreenTopLeftRayPointsUpAndLeft) {
+  glm::vec3 camera_pos(0.f, 0.f, 0.f);
+  glm::mat4 mat_view =
+      glm::lookAt(camera_pos, glm::vec3(0, 0, -1), glm::vec3(0, 1, 0));
+  glm::mat4 mat_proj = glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f);
+
+  PickRay ray =
+      PickRay::from_screen(mat_proj * mat_view, camera_pos, 0.f, 0.f);
+
+  // 90 degree fov - corner of the screen is 45 degrees off center both ways
+  glm::vec3 dir = ray.direction / -ray.direction.z;
+  EXPECT_NEAR(dir.x, -1.f, kEpsilon);
+  EXPECT_NEAR(dir.y, 1.f, kEpsilon);
+}
+
+TEST(PickRay, TriangleHitIsTwoSided) {
+  glm::vec3 a(-1.f, 0.f, -1.f), b(1.f, 0.f, -1.f), c(0.f, 0.f, 1.f);
+
+  float t_down = 0.f, t_up = 0.f;
+  EXPECT_TRUE(intersect_triangle(PickRay{{0, 5, 0}, {0, -2, 0}}, a, b, c,
+                                 kNoHit, &t_down));
+  EXPECT_TRUE(intersect_triangle(PickRay{{0, -5, 0}, {0, 1, 0}}, a, b, c,
+                                 kNoHit, &t_up));
+
+  // t is in multiples of the (unnormalized) direction
+  EXPECT_NEAR(t_down, 2.5f, kEpsilon);
+  EXPECT_NEAR(t_up, 5.f, kEpsilon);
+}
+
+TEST(PickRay, TriangleMissesOutsideAndPastMaxT) {
+  glm::vec3 a(-1.f, 0.f, -1.f), b(1.f, 0.f, -1.f), c(0.f, 0.f, 1.f);
+
+  float t = 0.f;
+  EXPECT_FALSE(intersect_triangle(PickRay{{2, 5, 0}, {0, -1, 0}}, a, b, c,
+                                  kNoHit, &t));
+  EXPECT_FALSE(intersect_triangle(PickRay{{0, 5, 0}, {0, 1, 0}}, a, b, c,
+                                  kNoHit, &t));
+  EXPECT_FALSE(intersect_triangle(PickRay{{0, 5, 0}, {0, -1, 0}}, a, b, c,
+                                  4.f, &t));
+}
+
+TEST(PickRay, SphereHitFromOutsideAndInside) {
+  float t = -1.f;
+  EXPECT_TRUE(intersect_sphere(PickRay{{0, 0, -10}, {0, 0, 1}},
+                               glm::vec3(0.f), 2.f, kNoHit, &t));
+  EXPECT_NEAR(t, 8.f, kEpsilon);
+
+  EXPECT_TRUE(intersect_sphere(PickRay{{0, 0.5f, 0}, {1, 0, 0}},
+                               glm::vec3(0.f), 2.f, kNoHit, &t));
+  EXPECT_NEAR(t, 0.f, kEpsilon);
+
+  EXPECT_FALSE(intersect_sphere(PickRay{{0, 0, 10}, {0, 0, 1}},
+                                glm::vec3(0.f), 2.f, kNoHit, &t));
+}
@@ -0,0 +1,336 @@
+#include "triangle_bvh.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace sanctify;
+using namespace picking;
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+const uint32_t kSahBinCount = 12u;
+
+struct Aabb {
+  glm::vec3 min;
+  glm::vec3 max;
+
+  static Aabb empty() {
+    return Aabb{glm::vec3(std::numeric_limits<float>::max()),
+                glm::vec3(std::numeric_limits<float>::lowest())};
+  }
+
+  void grow(const glm::vec3& p) {
+    min = glm::min(min, p);
+    max = glm::max(max, p);
+  }
+
+  void grow(const Aabb& o) {
+    min = glm::min(min, o.min);
+    max = glm::max(max, o.max);
+  }
+
+  float half_area() const {
+    glm::vec3 e = max - min;
+    return e.x * e.y + e.y * e.z + e.z * e.x;
+  }
+};
+
+struct BuildTask {
+  uint32_t nodeIdx;
+  uint32_t depth;
+};
+
+struct SahSplit {
+  uint32_t axis;
+  float position;
+  float cost;
+};
+
+// Best binned SAH split of the centroids of tris[first, first + count)
+SahSplit find_sah_split(const std::vector<Aabb>& tri_bounds,
+                        const std::vector<glm::vec3>& centroids,
+                        const std::vector<uint32_t>& tris, uint32_t first,
+                        uint32_t count) {
+  SahSplit best{0u, 0.f, std::numeric_limits<float>::max()};
+
+  Aabb centroid_bounds = Aabb::empty();
+  for (uint32_t i = first; i < first + count; i++) {
+    centroid_bounds.grow(centroids[tris[i]]);
+  }
+
+  for (uint32_t axis = 0; axis < 3; axis++) {
+    float lo = centroid_bounds.min[axis];
+    float hi = centroid_bounds.max[axis];
+    if (hi <= lo) {
+      continue;
+    }
+
+    Aabb bin_bounds[kSahBinCount];
+    uint32_t bin_counts[kSahBinCount] = {};
+    for (uint32_t b = 0; b < kSahBinCount; b++) {
+      bin_bounds[b] = Aabb::empty();
+    }
+
+    float scale = kSahBinCount / (hi - lo);
+    for (uint32_t i = first; i < first + count; i++) {
+      uint32_t tri = tris[i];
+      uint32_t b = std::min(kSahBinCount - 1u,
+                            (uint32_t)((centroids[tri][axis] - lo) * scale));
+      bin_counts[b]++;
+      bin_bounds[b].grow(tri_bounds[tri]);
+    }
+
+    // Sweep from both ends - plane i splits bins [0, i] from [i + 1, n)
+    float left_cost[kSahBinCount - 1];
+    Aabb acc = Aabb::empty();
+    uint32_t acc_count = 0u;
+    for (uint32_t i = 0; i < kSahBinCount - 1; i++) {
+      acc_count += bin_counts[i];
+      if (bin_counts[i] > 0u) acc.grow(bin_bounds[i]);
+      left_cost[i] = acc_count > 0u ? acc_count * acc.half_area() : 0.f;
+    }
+
+    acc = Aabb::empty();
+    acc_count = 0u;
+    for (uint32_t i = kSahBinCount - 1; i > 0; i--) {
+      acc_count += bin_counts[i];
+      if (bin_counts[i] > 0u) acc.grow(bin_bounds[i]);
+      float right_cost = acc_count > 0u ? acc_count * acc.half_area() : 0.f;
+
+      float cost = left_cost[i - 1] + right_cost;
+      if (cost < best.cost) {
+        best = SahSplit{axis, lo + i / scale, cost};
+      }
+    }
+  }
+
+  return best;
+}
+
+}  // namespace
+
+TriangleBvh TriangleBvh::build(const PodVector<glm::vec3>& positions,
+                               const PodVector<uint32_t>& indices) {
+  TriangleBvh bvh;
+
+  const uint32_t tri_count = indices.size() / 3u;
+  if (tri_count == 0u) {
+    return bvh;
+  }
+
+  std::vector<Aabb> tri_bounds(tri_count);
+  std::vector<glm::vec3> centroids(tri_count);
+  std::vector<uint32_t> tris(tri_count);
+  for (uint32_t i = 0; i < tri_count; i++) {
+    Aabb bounds = Aabb::empty();
+    bounds.grow(positions[indices[i * 3u]]);
+    bounds.grow(positions[indices[i * 3u + 1u]]);
+    bounds.grow(positions[indices[i * 3u + 2u]]);
+    tri_bounds[i] = bounds;
+    centroids[i] = (bounds.min + bounds.max) * 0.5f;
+    tris[i] = i;
+  }
+
+  // Upper bound on node count for leaves of one triangle - reserve up front so
+  //  the node list is never re-allocated during the build
+  bvh.nodes_.resize(tri_count * 2u);
+  uint32_t nodes_used = 1u;
+
+  Node& root = bvh.nodes_[0];
+  root.leftOrFirst = 0u;
+  root.count = tri_count;
+
+  std::vector<BuildTask> tasks;
+  tasks.push_back(BuildTask{0u, 0u});
+  while (!tasks.empty()) {
+    BuildTask task = tasks.back();
+    tasks.pop_back();
+
+    Node& node = bvh.nodes_[task.nodeIdx];
+    Aabb bounds = Aabb::empty();
+    for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count;
+         i++) {
+      bounds.grow(tri_bounds[tris[i]]);
+    }
+    node.boundsMin = bounds.min;
+    node.boundsMax = bounds.max;
+
+    if (node.count <= kMaxLeafTriangles || task.depth >= kMaxDepth) {
+      continue;
+    }
+
+    SahSplit split = ::find_sah_split(tri_bounds, centroids, tris,
+                                      node.leftOrFirst, node.count);
+    if (split.cost >= node.count * bounds.half_area()) {
+      continue;
+    }
+
+    auto mid = std::partition(
+        tris.begin() + node.leftOrFirst,
+        tris.begin() + node.leftOrFirst + node.count,
+        [&](uint32_t tri) {
+          return centroids[tri][split.axis] < split.position;
+        });
+    uint32_t left_count =
+        (uint32_t)(mid - tris.begin()) - node.leftOrFirst;
+    if (left_count == 0u || left_count == node.count) {
+      continue;
+    }
+
+    uint32_t left_idx = nodes_used;
+    nodes_used += 2u;
+
+    Node& left = bvh.nodes_[left_idx];
+    left.leftOrFirst = node.leftOrFirst;
+    left.count = left_count;
+
+    Node& right = bvh.nodes_[left_idx + 1u];
+    right.leftOrFirst = node.leftOrFirst + left_count;
+    right.count = node.count - left_count;
+
+    node.leftOrFirst = left_idx;
+    node.count = 0u;
+
+    tasks.push_back(BuildTask{left_idx, task.depth + 1u});
+    tasks.push_back(BuildTask{left_idx + 1u, task.depth + 1u});
+  }
+  bvh.nodes_.resize(nodes_used);
+
+  bvh.triangles_.resize(tri_count);
+  bvh.triangle_ids_.resize(tri_count);
+  for (uint32_t i = 0; i < tri_count; i++) {
+    uint32_t tri = tris[i];
+    const glm::vec3& a = positions[indices[tri * 3u]];
+    const glm::vec3& b = positions[indices[tri * 3u + 1u]];
+    const glm::vec3& c = positions[indices[tri * 3u + 2u]];
+    bvh.triangles_[i] = Triangle{a, b - a, c - a};
+    bvh.triangle_ids_[i] = tri;
+  }
+
+  return bvh;
+}
+
+TriangleBvh TriangleBvh::build(
+    const PodVector<asset::PositionNormalVertexData>& vertices,
+    const PodVector<uint32_t>& indices) {
+  PodVector<glm::vec3> positions(vertices.size());
+  positions.resize(vertices.size());
+  for (uint32_t i = 0; i < vertices.size(); i++) {
+    positions[i] = vertices[i].Position;
+  }
+
+  return build(positions, indices);
+}
+
+Maybe<RayHit> TriangleBvh::raycast(const PickRay& ray, float max_t) const {
+  if (nodes_.size() == 0u) {
+    return empty_maybe{};
+  }
+
+  struct StackEntry {
+    uint32_t nodeIdx;
+    float tEnter;
+  };
+
+  const glm::vec3 inv_direction = 1.f / ray.direction;
+
+  float best_t = max_t;
+  uint32_t best_idx = 0xFFFFFFFFu;
+
+  StackEntry stack[kMaxDepth + 1u];
+  uint32_t stack_size = 0u;
+
+  float t_enter;
+  if (intersect_aabb(ray.origin, inv_direction, nodes_[0].boundsMin,
+                     nodes_[0].boundsMax, best_t, &t_enter)) {
+    stack[stack_size++] = StackEntry{0u, t_enter};
+  }
+
+  while (stack_size > 0u) {
+    StackEntry entry = stack[--stack_size];
+    if (entry.tEnter >= best_t) {
+      continue;
+    }
+
+    uint32_t node_idx = entry.nodeIdx;
+    while (true) {
+      const Node& node = nodes_[node_idx];
+
+      if (node.count > 0u) {
+        for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count;
+             i++) {
+          const Triangle& tri = triangles_[i];
+          float t;
+          if (intersect_triangle_edges(ray, tri.v0, tri.e1, tri.e2, best_t,
+                                       &t)) {
+            best_t = t;
+            best_idx = i;
+          }
+        }
+        break;
+      }
+
+      uint32_t near_idx = node.leftOrFirst;
+      uint32_t far_idx = near_idx + 1u;
+      float t_near, t_far;
+      bool hit_near =
+          intersect_aabb(ray.origin, inv_direction, nodes_[near_idx].boundsMin,
+                         nodes_[near_idx].boundsMax, best_t, &t_near);
+      bool hit_far =
+          intersect_aabb(ray.origin, inv_direction, nodes_[far_idx].boundsMin,
+                         nodes_[far_idx].boundsMax, best_t, &t_far);
+
+      if (hit_near && hit_far) {
+        if (t_far < t_near) {
+          std::swap(near_idx, far_idx);
+          std::swap(t_near, t_far);
+        }
+        stack[stack_size++] = StackEntry{far_idx, t_far};
+        node_idx = near_idx;
+      } else if (hit_near) {
+        node_idx = near_idx;
+      } else if (hit_far) {
+        node_idx = far_idx;
+      } else {
+        break;
+      }
+    }
+  }
+
+  if (best_idx == 0xFFFFFFFFu) {
+    return empty_maybe{};
+  }
+
+  return RayHit{best_t, triangle_ids_[best_idx]};
+}
+
+Maybe<RayHit> TriangleBvh::raycast_brute_force(const PickRay& ray,
+                                               float max_t) const {
+  float best_t = max_t;
+  uint32_t best_idx = 0xFFFFFFFFu;
+
+  for (uint32_t i = 0; i < triangles_.size(); i++) {
+    const Triangle& tri = triangles_[i];
+    float t;
+    if (intersect_triangle_edges(ray, tri.v0, tri.e1, tri.e2, best_t, &t)) {
+      best_t = t;
+      best_idx = i;
+    }
+  }
+
+  if (best_idx == 0xFFFFFFFFu) {
+    return empty_maybe{};
+  }
+
+  return RayHit{best_t, triangle_ids_[best_idx]};
+}
+
+glm::vec3 TriangleBvh::bounds_min() const {
+  return nodes_.size() > 0u ? nodes_[0].boundsMin : glm::vec3(0.f);
+}
+
+glm::vec3 TriangleBvh::bounds_max() const {
+  return nodes_.size() > 0u ? nodes_[0].boundsMax : glm::vec3(0.f);
+}
@@ -0,0 +1,90 @@
+#ifndef SANCTIFY_COMMON_PICKING_TRIANGLE_BVH_H
+#define SANCTIFY_COMMON_PICKING_TRIANGLE_BVH_H
+
+/**
+ * Bounding volume hierarchy over a static triangle mesh, for ray picking
+ *  against terrain (or any other geometry that does not move).
+ *
+ * Built once when the geometry is loaded (binned SAH, a few ms for an arena
+ *  sized mesh) - meant to be built on an async task list alongside the GPU
+ *  buffers, from the same decoded vertex/index data.
+ */
+
+#include <igasset/vertex_formats.h>
+#include <igcore/maybe.h>
+#include <igcore/pod_vector.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "pick_ray.h"
+
+namespace sanctify::picking {
+
+class TriangleBvh {
+ public:
+  // Leaves are split until they hold at most this many triangles (or until
+  //  splitting does not pay off by the surface area heuristic)
+  static constexpr uint32_t kMaxLeafTriangles = 4u;
+
+  // Deeper nodes are forced to be leaves, which bounds the traversal stack
+  static constexpr uint32_t kMaxDepth = 48u;
+
+  /**
+   * 32 bytes, so two siblings share a cache line. Interior nodes have a count
+   *  of 0 and children at leftOrFirst and leftOrFirst + 1, leaves hold
+   *  "count" triangles starting at leftOrFirst.
+   */
+  struct Node {
+    glm::vec3 boundsMin;
+    uint32_t leftOrFirst;
+    glm::vec3 boundsMax;
+    uint32_t count;
+  };
+
+  TriangleBvh() = default;
+
+  /** Build over an indexed triangle list (three indices per triangle) */
+  static TriangleBvh build(const indigo::core::PodVector<glm::vec3>& positions,
+                           const indigo::core::PodVector<uint32_t>& indices);
+
+  /** Build over the position stream of decoded render geometry */
+  static TriangleBvh build(
+      const indigo::core::PodVector<indigo::asset::PositionNormalVertexData>&
+          vertices,
+      const indigo::core::PodVector<uint32_t>& indices);
+
+  /**
+   * Closest hit in [0, max_t) - RayHit::id is the index of the triangle in the
+   *  index list the BVH was built from (first index / 3)
+   */
+  indigo::core::Maybe<RayHit> raycast(const PickRay& ray,
+                                      float max_t = kNoHit) const;
+
+  /** Reference implementation of "raycast" that tests every triangle */
+  indigo::core::Maybe<RayHit> raycast_brute_force(const PickRay& ray,
+                                                  float max_t = kNoHit) const;
+
+  uint32_t triangle_count() const { return triangle_ids_.size(); }
+  uint32_t node_count() const { return nodes_.size(); }
+
+  glm::vec3 bounds_min() const;
+  glm::vec3 bounds_max() const;
+
+ private:
+  // Triangles are stored in leaf order as one vertex and two edges, which is
+  //  what the intersection test wants anyways
+  struct Triangle {
+    glm::vec3 v0;
+    glm::vec3 e1;
+    glm::vec3 e2;
+  };
+
+  indigo::core::PodVector<Node> nodes_;
+  indigo::core::PodVector<Triangle> triangles_;
+  indigo::core::PodVector<uint32_t> triangle_ids_;
+};
+
+}  // namespace sanctify::picking
+
+#endif
@@ -0,0 +1,154 @@
+#include "triangle_bvh.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+using namespace sanctify;
+using namespace picking;
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+const float kEpsilon = 0.0001f;
+
+// Bumpy (size x size) quad heightfield over [-size, size] on XZ
+void make_heightfield(uint32_t size, PodVector<glm::vec3>& positions,
+                      PodVector<uint32_t>& indices) {
+  for (uint32_t z = 0; z <= size; z++) {
+    for (uint32_t x = 0; x <= size; x++) {
+      float fx = x * 2.f - size, fz = z * 2.f - size;
+      positions.push_back(
+          glm::vec3(fx, std::sin(fx * 0.3f) * std::cos(fz * 0.2f) * 3.f, fz));
+    }
+  }
+
+  for (uint32_t z = 0; z < size; z++) {
+    for (uint32_t x = 0; x < size; x++) {
+      uint32_t i = z * (size + 1) + x;
+      indices.push_back(i, i + size + 1, i + 1);
+      indices.push_back(i + 1, i + size + 1, i + size + 2);
+    }
+  }
+}
+
+// Reference - test every triangle of the original mesh
+Maybe<RayHit> reference_raycast(const PodVector<glm::vec3>& positions,
+                                const PodVector<uint32_t>& indices,
+                                const PickRay& ray) {
+  float best_t = kNoHit;
+  uint32_t best_id = 0u;
+  bool hit = false;
+  for (uint32_t i = 0; i < indices.size() / 3; i++) {
+    float t;
+    if (intersect_triangle(ray, positions[indices[i * 3]],
+                           positions[indices[i * 3 + 1]],
+                           positions[indices[i * 3 + 2]], best_t, &t)) {
+      best_t = t;
+      best_id = i;
+      hit = true;
+    }
+  }
+
+  if (!hit) return empty_maybe{};
+  return RayHit{best_t, best_id};
+}
+
+}  // namespace
+
+TEST(TriangleBvh, EmptyMeshHasNoHits) {
+  PodVector<glm::vec3> positions;
+  PodVector<uint32_t> indices;
+
+  auto bvh = TriangleBvh::build(positions, indices);
+
+  EXPECT_EQ(bvh.triangle_count(), 0u);
+  EXPECT_TRUE(bvh.raycast(PickRay{{0, 5, 0}, {0, -1, 0}}).is_empty());
+}
+
+TEST(TriangleBvh, SingleTriangleReportsDistanceAndId) {
+  PodVector<glm::vec3> positions;
+  positions.push_back(glm::vec3(-1, 2, -1), glm::vec3(1, 2, -1),
+                      glm::vec3(0, 2, 1));
+  PodVector<uint32_t> indices;
+  indices.push_back(0, 1, 2);
+
+  auto bvh = TriangleBvh::build(positions, indices);
+  auto hit = bvh.raycast(PickRay{{0, 5, 0}, {0, -1, 0}});
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_NEAR(hit.get().t, 3.f, kEpsilon);
+  EXPECT_EQ(hit.get().id, 0u);
+
+  EXPECT_TRUE(bvh.raycast(PickRay{{0, 5, 0}, {0, -1, 0}}, 2.f).is_empty());
+}
+
+TEST(TriangleBvh, SplitsLargeMeshesIntoSmallLeaves) {
+  PodVector<glm::vec3> positions;
+  PodVector<uint32_t> indices;
+  ::make_heightfield(32, positions, indices);
+
+  auto bvh = TriangleBvh::build(positions, indices);
+
+  EXPECT_EQ(bvh.triangle_count(), 32u * 32u * 2u);
+  EXPECT_GT(bvh.node_count(),
+            bvh.triangle_count() / TriangleBvh::kMaxLeafTriangles);
+  EXPECT_LT(bvh.node_count(), bvh.triangle_count() * 2u);
+  EXPECT_NEAR(bvh.bounds_min().x, -32.f, kEpsilon);
+  EXPECT_NEAR(bvh.bounds_max().z, 32.f, kEpsilon);
+}
+
+TEST(TriangleBvh, MatchesReferenceForRandomRays) {
+  PodVector<glm::vec3> positions;
+  PodVector<uint32_t> indices;
+  ::make_heightfield(48, positions, indices);
+
+  auto bvh = TriangleBvh::build(positions, indices);
+
+  std::mt19937 rng(1234u);
+  std::uniform_real_distribution<float> pos(-60.f, 60.f);
+  std::uniform_real_distribution<float> height(-5.f, 30.f);
+  std::uniform_real_distribution<float> dir(-1.f, 1.f);
+
+  uint32_t hit_count = 0u;
+  for (int i = 0; i < 2000; i++) {
+    PickRay ray{glm::vec3(pos(rng), height(rng), pos(rng)),
+                glm::vec3(dir(rng), dir(rng) - 0.5f, dir(rng)) * 2.f};
+
+    auto expected = ::reference_raycast(positions, indices, ray);
+    auto actual = bvh.raycast(ray);
+    auto brute_force = bvh.raycast_brute_force(ray);
+
+    ASSERT_EQ(expected.has_value(), actual.has_value()) << "Ray " << i;
+    ASSERT_EQ(expected.has_value(), brute_force.has_value()) << "Ray " << i;
+    if (!expected.has_value()) continue;
+
+    hit_count++;
+    EXPECT_NEAR(expected.get().t, actual.get().t, kEpsilon) << "Ray " << i;
+    EXPECT_NEAR(expected.get().t, brute_force.get().t, kEpsilon)
+        << "Ray " << i;
+  }
+
+  // Sanity check that the test is testing something
+  EXPECT_GT(hit_count, 500u);
+}
+
+TEST(TriangleBvh, BuildsFromRenderVertices) {
+  PodVector<asset::PositionNormalVertexData> vertices;
+  vertices.push_back({glm::vec3(-1, 0, -1), glm::vec4(0, 0, 0, 1)});
+  vertices.push_back({glm::vec3(1, 0, -1), glm::vec4(0, 0, 0, 1)});
+  vertices.push_back({glm::vec3(0, 0, 1), glm::vec4(0, 0, 0, 1)});
+  vertices.push_back({glm::vec3(0, -1, 0), glm::vec4(0, 0, 0, 1)});
+  PodVector<uint32_t> indices;
+  indices.push_back(3, 0, 1);
+  indices.push_back(0, 1, 2);
+
+  auto bvh = TriangleBvh::build(vertices, indices);
+  auto hit = bvh.raycast(PickRay{{0, 5, 0}, {0, -1, 0}});
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit.get().id, 1u);
+  EXPECT_NEAR(hit.get().t, 5.f, kEpsilon);
+}
@@ -0,0 +1,215 @@
+#include "unit_pick_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace sanctify;
+using namespace picking;
+
+using namespace indigo;
+using namespace core;
+
+UnitPickGrid::UnitPickGrid(float cell_size)
+    : requested_cell_size_(cell_size),
+      cell_size_(cell_size),
+      bounds_min_(0.f),
+      bounds_max_(0.f),
+      cells_x_(0u),
+      cells_z_(0u) {}
+
+void UnitPickGrid::clear() {
+  units_.resize(0u);
+  cell_starts_.resize(0u);
+  cell_units_.resize(0u);
+  cells_x_ = 0u;
+  cells_z_ = 0u;
+}
+
+void UnitPickGrid::add_unit(uint32_t id, const glm::vec3& center,
+                            float radius) {
+  units_.push_back(Unit{center, radius, id});
+}
+
+void UnitPickGrid::build() {
+  cell_starts_.resize(0u);
+  cell_units_.resize(0u);
+  cells_x_ = 0u;
+  cells_z_ = 0u;
+
+  if (units_.size() == 0u) {
+    return;
+  }
+
+  bounds_min_ = units_[0].center - glm::vec3(units_[0].radius);
+  bounds_max_ = units_[0].center + glm::vec3(units_[0].radius);
+  for (uint32_t i = 1; i < units_.size(); i++) {
+    const Unit& unit = units_[i];
+    bounds_min_ = glm::min(bounds_min_, unit.center - glm::vec3(unit.radius));
+    bounds_max_ = glm::max(bounds_max_, unit.center + glm::vec3(unit.radius));
+  }
+
+  float extent = std::max(bounds_max_.x - bounds_min_.x,
+                          bounds_max_.z - bounds_min_.z);
+  cell_size_ = std::max(requested_cell_size_, extent / kMaxCellsPerAxis);
+  if (cell_size_ <= 0.f) {
+    cell_size_ = 1.f;
+  }
+
+  cells_x_ = std::min(
+      kMaxCellsPerAxis,
+      std::max(1u, (uint32_t)std::ceil((bounds_max_.x - bounds_min_.x) /
+                                       cell_size_)));
+  cells_z_ = std::min(
+      kMaxCellsPerAxis,
+      std::max(1u, (uint32_t)std::ceil((bounds_max_.z - bounds_min_.z) /
+                                       cell_size_)));
+
+  // Counting sort - count units per cell, prefix sum into cell start offsets,
+  //  then scatter unit indices using the starts as write cursors
+  const uint32_t cell_count = cells_x_ * cells_z_;
+  cell_starts_.resize(cell_count + 1u);
+  for (uint32_t i = 0; i <= cell_count; i++) {
+    cell_starts_[i] = 0u;
+  }
+
+  for (uint32_t i = 0; i < units_.size(); i++) {
+    uint32_t x0, x1, z0, z1;
+    cell_range(units_[i], &x0, &x1, &z0, &z1);
+    for (uint32_t z = z0; z <= z1; z++) {
+      for (uint32_t x = x0; x <= x1; x++) {
+        cell_starts_[z * cells_x_ + x + 1u]++;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < cell_count; i++) {
+    cell_starts_[i + 1u] += cell_starts_[i];
+  }
+  cell_units_.resize(cell_starts_[cell_count]);
+
+  for (uint32_t i = 0; i < units_.size(); i++) {
+    uint32_t x0, x1, z0, z1;
+    cell_range(units_[i], &x0, &x1, &z0, &z1);
+    for (uint32_t z = z0; z <= z1; z++) {
+      for (uint32_t x = x0; x <= x1; x++) {
+        cell_units_[cell_starts_[z * cells_x_ + x]++] = i;
+      }
+    }
+  }
+
+  // The scatter advanced every start to the start of the next cell
+  for (uint32_t i = cell_count; i > 0u; i--) {
+    cell_starts_[i] = cell_starts_[i - 1u];
+  }
+  cell_starts_[0] = 0u;
+}
+
+Maybe<RayHit> UnitPickGrid::raycast(const PickRay& ray, float max_t) const {
+  if (cells_x_ == 0u || cells_z_ == 0u) {
+    return empty_maybe{};
+  }
+
+  float t_enter, t_exit;
+  if (!intersect_aabb(ray.origin, 1.f / ray.direction, bounds_min_,
+                      bounds_max_, max_t, &t_enter, &t_exit)) {
+    return empty_maybe{};
+  }
+
+  // 2D DDA over the XZ cells the ray passes through between entering and
+  //  leaving the grid bounds
+  glm::vec3 start = ray.at(t_enter);
+  int32_t x = std::clamp((int32_t)std::floor((start.x - bounds_min_.x) /
+                                             cell_size_),
+                         0, (int32_t)cells_x_ - 1);
+  int32_t z = std::clamp((int32_t)std::floor((start.z - bounds_min_.z) /
+                                             cell_size_),
+                         0, (int32_t)cells_z_ - 1);
+
+  int32_t step_x = ray.direction.x >= 0.f ? 1 : -1;
+  int32_t step_z = ray.direction.z >= 0.f ? 1 : -1;
+
+  float t_next_x = kNoHit, t_delta_x = kNoHit;
+  if (ray.direction.x != 0.f) {
+    float boundary = bounds_min_.x + (x + (step_x > 0 ? 1 : 0)) * cell_size_;
+    t_next_x = t_enter + (boundary - start.x) / ray.direction.x;
+    t_delta_x = cell_size_ / std::abs(ray.direction.x);
+  }
+  float t_next_z = kNoHit, t_delta_z = kNoHit;
+  if (ray.direction.z != 0.f) {
+    float boundary = bounds_min_.z + (z + (step_z > 0 ? 1 : 0)) * cell_size_;
+    t_next_z = t_enter + (boundary - start.z) / ray.direction.z;
+    t_delta_z = cell_size_ / std::abs(ray.direction.z);
+  }
+
+  float best_t = max_t;
+  uint32_t best_idx = 0xFFFFFFFFu;
+  while (true) {
+    uint32_t cell = (uint32_t)z * cells_x_ + (uint32_t)x;
+    for (uint32_t i = cell_starts_[cell]; i < cell_starts_[cell + 1u]; i++) {
+      const Unit& unit = units_[cell_units_[i]];
+      float t;
+      if (intersect_sphere(ray, unit.center, unit.radius, best_t, &t)) {
+        best_t = t;
+        best_idx = cell_units_[i];
+      }
+    }
+
+    // A hit before the ray leaves this cell can't be beaten by a later cell
+    float t_cell_exit = std::min(std::min(t_next_x, t_next_z), t_exit);
+    if (best_t <= t_cell_exit || t_cell_exit >= t_exit) {
+      break;
+    }
+
+    if (t_next_x < t_next_z) {
+      x += step_x;
+      t_next_x += t_delta_x;
+    } else {
+      z += step_z;
+      t_next_z += t_delta_z;
+    }
+
+    if (x < 0 || x >= (int32_t)cells_x_ || z < 0 || z >= (int32_t)cells_z_) {
+      break;
+    }
+  }
+
+  if (best_idx == 0xFFFFFFFFu) {
+    return empty_maybe{};
+  }
+
+  return RayHit{best_t, units_[best_idx].id};
+}
+
+Maybe<RayHit> UnitPickGrid::raycast_brute_force(const PickRay& ray,
+                                                float max_t) const {
+  float best_t = max_t;
+  uint32_t best_idx = 0xFFFFFFFFu;
+
+  for (uint32_t i = 0; i < units_.size(); i++) {
+    const Unit& unit = units_[i];
+    float t;
+    if (intersect_sphere(ray, unit.center, unit.radius, best_t, &t)) {
+      best_t = t;
+      best_idx = i;
+    }
+  }
+
+  if (best_idx == 0xFFFFFFFFu) {
+    return empty_maybe{};
+  }
+
+  return RayHit{best_t, units_[best_idx].id};
+}
+
+void UnitPickGrid::cell_range(const Unit& unit, uint32_t* o_x0, uint32_t* o_x1,
+                              uint32_t* o_z0, uint32_t* o_z1) const {
+  auto to_cell = [this](float v, float lo, uint32_t cells) {
+    int32_t c = (int32_t)std::floor((v - lo) / cell_size_);
+    return (uint32_t)std::clamp(c, 0, (int32_t)cells - 1);
+  };
+
+  *o_x0 = to_cell(unit.center.x - unit.radius, bounds_min_.x, cells_x_);
+  *o_x1 = to_cell(unit.center.x + unit.radius, bounds_min_.x, cells_x_);
+  *o_z0 = to_cell(unit.center.z - unit.radius, bounds_min_.z, cells_z_);
+  *o_z1 = to_cell(unit.center.z + unit.radius, bounds_min_.z, cells_z_);
+}
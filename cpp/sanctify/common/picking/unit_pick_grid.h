@@ -0,0 +1,78 @@
+#ifndef SANCTIFY_COMMON_PICKING_UNIT_PICK_GRID_H
+#define SANCTIFY_COMMON_PICKING_UNIT_PICK_GRID_H
+
+/**
+ * Uniform grid over the XZ plane for ray picking against moving units.
+ *
+ * Rebuilt from scratch every frame (clear, add_unit for every pickable unit,
+ *  build) - a counting sort into cells, which is cheaper than refitting a
+ *  tree for thousands of units that all move every tick. Units are picked by
+ *  their bounding spheres.
+ */
+
+#include <igcore/maybe.h>
+#include <igcore/pod_vector.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "pick_ray.h"
+
+namespace sanctify::picking {
+
+class UnitPickGrid {
+ public:
+  // Cells are grown past the requested size if the units are spread out far
+  //  enough that the grid would have more cells than this along either axis
+  static constexpr uint32_t kMaxCellsPerAxis = 256u;
+
+  explicit UnitPickGrid(float cell_size = 4.f);
+
+  /** Remove all units (start of a frame) */
+  void clear();
+
+  /** Add a unit - "id" is reported back in RayHit::id */
+  void add_unit(uint32_t id, const glm::vec3& center, float radius);
+
+  /** Bin all added units into cells - call before raycast */
+  void build();
+
+  /** Closest unit hit in [0, max_t) */
+  indigo::core::Maybe<RayHit> raycast(const PickRay& ray,
+                                      float max_t = kNoHit) const;
+
+  /** Reference implementation of "raycast" that tests every unit */
+  indigo::core::Maybe<RayHit> raycast_brute_force(const PickRay& ray,
+                                                  float max_t = kNoHit) const;
+
+  uint32_t unit_count() const { return units_.size(); }
+
+ private:
+  struct Unit {
+    glm::vec3 center;
+    float radius;
+    uint32_t id;
+  };
+
+  void cell_range(const Unit& unit, uint32_t* o_x0, uint32_t* o_x1,
+                  uint32_t* o_z0, uint32_t* o_z1) const;
+
+  float requested_cell_size_;
+  float cell_size_;
+
+  indigo::core::PodVector<Unit> units_;
+
+  glm::vec3 bounds_min_;
+  glm::vec3 bounds_max_;
+  uint32_t cells_x_;
+  uint32_t cells_z_;
+
+  // Units overlapping cell (x, z) are at cell_units_[cell_starts_[i]] up to
+  //  cell_units_[cell_starts_[i + 1]], with i = z * cells_x_ + x
+  indigo::core::PodVector<uint32_t> cell_starts_;
+  indigo::core::PodVector<uint32_t> cell_units_;
+};
+
+}  // namespace sanctify::picking
+
+#endif
@@ -0,0 +1,104 @@
+#include "unit_pick_grid.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace sanctify;
+using namespace picking;
+
+namespace {
+const float kEpsilon = 0.0001f;
+}
+
+TEST(UnitPickGrid, EmptyGridHasNoHits) {
+  UnitPickGrid grid;
+  grid.build();
+
+  EXPECT_TRUE(grid.raycast(PickRay{{0, 5, 0}, {0, -1, 0}}).is_empty());
+}
+
+TEST(UnitPickGrid, HitsNearestUnitAlongRay) {
+  UnitPickGrid grid(2.f);
+  grid.add_unit(10u, glm::vec3(20.f, 1.f, 0.f), 1.f);
+  grid.add_unit(11u, glm::vec3(5.f, 1.f, 0.f), 1.f);
+  grid.add_unit(12u, glm::vec3(-5.f, 1.f, 0.f), 1.f);
+  grid.add_unit(13u, glm::vec3(5.f, 1.f, 10.f), 1.f);
+  grid.build();
+
+  auto hit = grid.raycast(PickRay{{0, 1, 0}, {1, 0, 0}});
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit.get().id, 11u);
+  EXPECT_NEAR(hit.get().t, 4.f, kEpsilon);
+
+  EXPECT_TRUE(grid.raycast(PickRay{{0, 1, 0}, {1, 0, 0}}, 3.f).is_empty());
+  EXPECT_TRUE(grid.raycast(PickRay{{0, 5, 0}, {1, 0, 0}}).is_empty());
+}
+
+TEST(UnitPickGrid, ClearRemovesUnits) {
+  UnitPickGrid grid;
+  grid.add_unit(1u, glm::vec3(0.f), 1.f);
+  grid.build();
+  ASSERT_TRUE(grid.raycast(PickRay{{0, 5, 0}, {0, -1, 0}}).has_value());
+
+  grid.clear();
+  grid.add_unit(2u, glm::vec3(10.f, 0.f, 0.f), 1.f);
+  grid.build();
+
+  EXPECT_EQ(grid.unit_count(), 1u);
+  EXPECT_TRUE(grid.raycast(PickRay{{0, 5, 0}, {0, -1, 0}}).is_empty());
+  auto hit = grid.raycast(PickRay{{10, 5, 0}, {0, -1, 0}});
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit.get().id, 2u);
+}
+
+TEST(UnitPickGrid, MatchesBruteForceForRandomRays) {
+  std::mt19937 rng(4321u);
+  std::uniform_real_distribution<float> pos(-50.f, 50.f);
+  std::uniform_real_distribution<float> radius(0.3f, 2.5f);
+  std::uniform_real_distribution<float> height(0.f, 2.f);
+  std::uniform_real_distribution<float> dir(-1.f, 1.f);
+
+  UnitPickGrid grid(3.f);
+  for (uint32_t i = 0; i < 1000; i++) {
+    grid.add_unit(i, glm::vec3(pos(rng), height(rng), pos(rng)), radius(rng));
+  }
+  grid.build();
+
+  uint32_t hit_count = 0u;
+  for (int i = 0; i < 2000; i++) {
+    // Mix of rays from above (like a camera) and rays from inside the field
+    float y = (i % 2 == 0) ? 40.f : height(rng);
+    PickRay ray{glm::vec3(pos(rng), y, pos(rng)),
+                glm::vec3(dir(rng), (i % 2 == 0) ? -1.f : 0.f, dir(rng))};
+
+    auto expected = grid.raycast_brute_force(ray);
+    auto actual = grid.raycast(ray);
+
+    ASSERT_EQ(expected.has_value(), actual.has_value()) << "Ray " << i;
+    if (!expected.has_value()) continue;
+
+    hit_count++;
+    EXPECT_NEAR(expected.get().t, actual.get().t, kEpsilon) << "Ray " << i;
+  }
+
+  EXPECT_GT(hit_count, 500u);
+}
+
+TEST(UnitPickGrid, SpreadOutUnitsStillResolve) {
+  UnitPickGrid grid(1.f);
+  grid.add_unit(1u, glm::vec3(-5000.f, 0.f, -5000.f), 1.f);
+  grid.add_unit(2u, glm::vec3(5000.f, 0.f, 5000.f), 1.f);
+  grid.add_unit(3u, glm::vec3(0.f, 0.f, 0.f), 1.f);
+  grid.build();
+
+  auto hit = grid.raycast(PickRay{{5000, 10, 5000}, {0, -1, 0}});
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit.get().id, 2u);
+
+  hit = grid.raycast(PickRay{{-5010, 0, -5000}, {1, 0, 0}});
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit.get().id, 1u);
+  EXPECT_NEAR(hit.get().t, 9.f, kEpsilon);
+}
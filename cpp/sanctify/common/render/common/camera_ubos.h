@@ -1,7 +1,7 @@
 #ifndef SANCTIFY_COMMON_RENDER_COMMON_CAMERA_UBOS_H
 #define SANCTIFY_COMMON_RENDER_COMMON_CAMERA_UBOS_H
 
-#include <iggpu/ubo_base.h>
+#include <iggpu/uniform_staging_buffer.h>
 
 #include <glm/glm.hpp>
 
@@ -23,9 +23,10 @@ struct CommonLightingParamsData {
   float specularPower;
 };
 
-typedef indigo::iggpu::UboBase<CameraCommonVsBufferData> CameraCommonVsUbo;
-typedef indigo::iggpu::UboBase<CameraCommonFsBufferData> CameraCommonFsUbo;
-typedef indigo::iggpu::UboBase<CommonLightingParamsData> CommonLightingUbo;
+// All three share one UniformStagingBuffer (see CtxMainCameraCommonUbos)
+typedef indigo::iggpu::StagedUbo<CameraCommonVsBufferData> CameraCommonVsUbo;
+typedef indigo::iggpu::StagedUbo<CameraCommonFsBufferData> CameraCommonFsUbo;
+typedef indigo::iggpu::StagedUbo<CommonLightingParamsData> CommonLightingUbo;
 
 }  // namespace sanctify::render
 
@@ -1,9 +1,11 @@
 #ifndef SANCTIFY_COMMON_RENDER_COMMON_RENDER_COMPONENTS_H
 #define SANCTIFY_COMMON_RENDER_COMMON_RENDER_COMPONENTS_H
 
+#include <iggpu/render_pipeline_cache.h>
 #include <webgpu/webgpu_cpp.h>
 
 #include <glm/glm.hpp>
+#include <memory>
 
 #include "camera_ubos.h"
 
@@ -25,9 +27,15 @@ struct CtxPlatformObjects {
   wgpu::TextureView swapChainBackbuffer;
   uint32_t viewportWidth;
   uint32_t viewportHeight;
+
+  // Shared across scenes, see SimpleClientAppBase
+  std::shared_ptr<indigo::iggpu::RenderPipelineCache> pipelineCache;
 };
 
+// Systems write the UBOs as they please - "staging" is flushed once per
+//  frame (UpdateArenaCameraSystem), in a single queue write
 struct CtxMainCameraCommonUbos {
+  std::shared_ptr<indigo::iggpu::UniformStagingBuffer> staging;
   CameraCommonVsUbo cameraVsUbo;
   CameraCommonFsUbo cameraFsUbo;
   CommonLightingUbo lightingUbo;
@@ -0,0 +1,75 @@
+#include "debug_draw_list.h"
+
+#include <algorithm>
+
+using namespace sanctify;
+using namespace render;
+
+DebugDrawList::DebugDrawList(uint32_t initial_capacity)
+    : lines_(initial_capacity),
+      circles_(initial_capacity),
+      boxes_(initial_capacity) {}
+
+uint32_t DebugDrawList::pack_color(const glm::vec4& color) {
+  auto channel = [](float v) -> uint32_t {
+    return static_cast<uint32_t>(std::clamp(v, 0.f, 1.f) * 255.f + 0.5f);
+  };
+
+  // Byte order matches an Unorm8x4 vertex attribute (r in the lowest byte)
+  return channel(color.x) | (channel(color.y) << 8u) |
+         (channel(color.z) << 16u) | (channel(color.w) << 24u);
+}
+
+uint32_t DebugDrawList::pack_color(const glm::vec3& color) {
+  return pack_color(glm::vec4(color, 1.f));
+}
+
+void DebugDrawList::begin_frame() {
+  lines_.reset();
+  circles_.reset();
+  boxes_.reset();
+}
+
+void DebugDrawList::line(const glm::vec3& start, const glm::vec3& end,
+                         uint32_t color) {
+  DebugLineInstance* slot = lines_.reserve(1u);
+  if (slot) {
+    *slot = DebugLineInstance{start, end, color};
+  }
+}
+
+void DebugDrawList::path(const glm::vec3* points, uint32_t count,
+                         uint32_t color) {
+  if (count < 2u) {
+    return;
+  }
+
+  DebugLineInstance* slots = lines_.reserve(count - 1u);
+  if (!slots) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < count - 1u; i++) {
+    slots[i] = DebugLineInstance{points[i], points[i + 1u], color};
+  }
+}
+
+void DebugDrawList::circle(const glm::vec3& center, float radius,
+                           uint32_t color) {
+  DebugCircleInstance* slot = circles_.reserve(1u);
+  if (slot) {
+    *slot = DebugCircleInstance{center, radius, color};
+  }
+}
+
+void DebugDrawList::box(const glm::vec3& center, const glm::vec3& half_extents,
+                        uint32_t color) {
+  DebugBoxInstance* slot = boxes_.reserve(1u);
+  if (slot) {
+    *slot = DebugBoxInstance{center, half_extents, color};
+  }
+}
+
+uint32_t DebugDrawList::dropped_count() const {
+  return lines_.dropped() + circles_.dropped() + boxes_.dropped();
+}
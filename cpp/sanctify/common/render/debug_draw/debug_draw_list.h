@@ -0,0 +1,161 @@
+#ifndef SANCTIFY_COMMON_RENDER_DEBUG_DRAW_DEBUG_DRAW_LIST_H
+#define SANCTIFY_COMMON_RENDER_DEBUG_DRAW_DEBUG_DRAW_LIST_H
+
+/**
+ * Immediate mode debug drawing - lines, paths, circles and boxes are recorded
+ *  every frame into flat per-primitive instance arrays, which a renderer
+ *  uploads once and draws with one instanced draw call per primitive type.
+ *
+ * Recording is lock-free and may happen from any thread (e.g. from inside a
+ *  parallel system) between begin_frame and the renderer reading the lists.
+ *  Each primitive type has a fixed capacity for the frame, reserved with a
+ *  compare-and-swap per call - primitives that do not fit are dropped and
+ *  counted, and the arena is grown to fit at the next begin_frame.
+ *
+ * No GPU or ECS types in here, so it can be shared by every renderer.
+ */
+
+#include <igcore/pod_vector.h>
+
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace sanctify::render {
+
+/** Line segment, drawn as two line list vertices */
+struct DebugLineInstance {
+  glm::vec3 start;
+  glm::vec3 end;
+  uint32_t color;
+};
+
+/** Circle in the XZ plane (e.g. a unit radius or a movement target) */
+struct DebugCircleInstance {
+  glm::vec3 center;
+  float radius;
+  uint32_t color;
+};
+
+/** Wireframe axis aligned box */
+struct DebugBoxInstance {
+  glm::vec3 center;
+  glm::vec3 halfExtents;
+  uint32_t color;
+};
+
+/**
+ * Fixed capacity per-frame array with a lock-free append - "reserve" hands
+ *  out a range of slots with a compare-and-swap on the size, and the caller
+ *  fills them in. A range that does not fit is never handed out (so every
+ *  slot below size() has been written), and is counted as dropped instead.
+ */
+template <typename T>
+class DebugDrawArena {
+ public:
+  explicit DebugDrawArena(uint32_t initial_capacity)
+      : storage_(initial_capacity), size_(0u), dropped_(0u) {
+    storage_.resize(initial_capacity);
+  }
+
+  /** Not thread safe - grow to fit last frame's demand, and clear */
+  void reset() {
+    uint32_t demand = requested();
+    if (demand > storage_.size()) {
+      uint32_t capacity = storage_.size() > 0u ? storage_.size() : 1u;
+      while (capacity < demand) {
+        capacity *= 2u;
+      }
+      storage_.resize(capacity);
+    }
+    size_.store(0u, std::memory_order_relaxed);
+    dropped_.store(0u, std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns the first of "count" consecutive slots to write to, or nullptr if
+   *  they don't all fit this frame
+   */
+  T* reserve(uint32_t count) {
+    uint32_t capacity = storage_.size();
+    uint32_t first = size_.load(std::memory_order_relaxed);
+    do {
+      if (count > capacity - first) {
+        dropped_.fetch_add(count, std::memory_order_relaxed);
+        return nullptr;
+      }
+    } while (!size_.compare_exchange_weak(first, first + count,
+                                          std::memory_order_relaxed));
+    return storage_.raw() + first;
+  }
+
+  /** Readers only - all recording must have finished */
+  const T* data() const { return storage_.raw(); }
+  uint32_t size() const { return size_.load(std::memory_order_relaxed); }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  /** Slots asked for this frame, whether they fit or not */
+  uint32_t requested() const { return size() + dropped(); }
+  uint32_t capacity() const { return storage_.size(); }
+
+ private:
+  indigo::core::PodVector<T> storage_;
+  std::atomic<uint32_t> size_;
+  std::atomic<uint32_t> dropped_;
+};
+
+class DebugDrawList {
+ public:
+  // Segment count of circles - renderers should draw circles with the same
+  //  number of segments
+  static constexpr uint32_t kCircleSegments = 32u;
+
+  explicit DebugDrawList(uint32_t initial_capacity = 1024u);
+
+  /** Pack a linear [0, 1] RGBA color into an RGBA8 instance color */
+  static uint32_t pack_color(const glm::vec4& color);
+  static uint32_t pack_color(const glm::vec3& color);
+
+  /**
+   * Start recording a new frame - not thread safe, call once per frame before
+   *  any recording and after the renderer is done with the last frame
+   */
+  void begin_frame();
+
+  //
+  // Recording - safe to call from any number of threads at once
+  //
+  void line(const glm::vec3& start, const glm::vec3& end, uint32_t color);
+
+  /** Connected segments through "count" points (count - 1 segments) */
+  void path(const glm::vec3* points, uint32_t count, uint32_t color);
+
+  void circle(const glm::vec3& center, float radius, uint32_t color);
+
+  void box(const glm::vec3& center, const glm::vec3& half_extents,
+           uint32_t color);
+
+  //
+  // Reading - only once all recording for the frame has finished
+  //
+  const DebugDrawArena<DebugLineInstance>& lines() const { return lines_; }
+  const DebugDrawArena<DebugCircleInstance>& circles() const {
+    return circles_;
+  }
+  const DebugDrawArena<DebugBoxInstance>& boxes() const { return boxes_; }
+
+  /**
+   * Primitives recorded this frame that did not fit - the arenas grow to fit
+   *  this frame's demand at the next begin_frame
+   */
+  uint32_t dropped_count() const;
+
+ private:
+  DebugDrawArena<DebugLineInstance> lines_;
+  DebugDrawArena<DebugCircleInstance> circles_;
+  DebugDrawArena<DebugBoxInstance> boxes_;
+};
+
+}  // namespace sanctify::render
+
+#endif
@@ -0,0 +1,140 @@
+#include "debug_draw_list.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace sanctify;
+using namespace render;
+
+TEST(DebugDrawList, RecordsPrimitivesByType) {
+  DebugDrawList list(16u);
+  list.begin_frame();
+
+  list.line(glm::vec3(0.f), glm::vec3(1.f, 0.f, 0.f), 0xFF0000FFu);
+  list.circle(glm::vec3(2.f, 0.f, 2.f), 1.5f, 0xFF00FF00u);
+  list.box(glm::vec3(0.f, 1.f, 0.f), glm::vec3(0.5f), 0xFFFF0000u);
+
+  ASSERT_EQ(list.lines().size(), 1u);
+  ASSERT_EQ(list.circles().size(), 1u);
+  ASSERT_EQ(list.boxes().size(), 1u);
+  EXPECT_EQ(list.lines().data()[0].end.x, 1.f);
+  EXPECT_EQ(list.lines().data()[0].color, 0xFF0000FFu);
+  EXPECT_EQ(list.circles().data()[0].radius, 1.5f);
+  EXPECT_EQ(list.boxes().data()[0].halfExtents.y, 0.5f);
+  EXPECT_EQ(list.dropped_count(), 0u);
+}
+
+TEST(DebugDrawList, PathRecordsConnectedSegments) {
+  DebugDrawList list(16u);
+  list.begin_frame();
+
+  glm::vec3 points[] = {glm::vec3(0.f), glm::vec3(1.f, 0.f, 0.f),
+                        glm::vec3(1.f, 0.f, 1.f), glm::vec3(2.f, 0.f, 1.f)};
+  list.path(points, 4u, 0xFFFFFFFFu);
+  list.path(points, 1u, 0xFFFFFFFFu);
+
+  ASSERT_EQ(list.lines().size(), 3u);
+  for (uint32_t i = 0; i < 3u; i++) {
+    EXPECT_EQ(list.lines().data()[i].start.x, points[i].x);
+    EXPECT_EQ(list.lines().data()[i].end.z, points[i + 1u].z);
+  }
+}
+
+TEST(DebugDrawList, BeginFrameClearsLastFrame) {
+  DebugDrawList list(16u);
+  list.begin_frame();
+  list.line(glm::vec3(0.f), glm::vec3(1.f), 0u);
+  list.circle(glm::vec3(0.f), 1.f, 0u);
+
+  list.begin_frame();
+
+  EXPECT_EQ(list.lines().size(), 0u);
+  EXPECT_EQ(list.circles().size(), 0u);
+}
+
+TEST(DebugDrawList, OverflowIsDroppedThenGrown) {
+  DebugDrawList list(4u);
+  list.begin_frame();
+  for (int i = 0; i < 10; i++) {
+    list.line(glm::vec3(0.f), glm::vec3(static_cast<float>(i)), 0u);
+  }
+
+  EXPECT_EQ(list.lines().size(), 4u);
+  EXPECT_EQ(list.dropped_count(), 6u);
+
+  list.begin_frame();
+  EXPECT_GE(list.lines().capacity(), 10u);
+  for (int i = 0; i < 10; i++) {
+    list.line(glm::vec3(0.f), glm::vec3(static_cast<float>(i)), 0u);
+  }
+
+  EXPECT_EQ(list.lines().size(), 10u);
+  EXPECT_EQ(list.dropped_count(), 0u);
+}
+
+TEST(DebugDrawList, PathCrossingCapacityIsDroppedWhole) {
+  DebugDrawList list(4u);
+  list.begin_frame();
+  for (int i = 0; i < 3; i++) {
+    list.line(glm::vec3(0.f), glm::vec3(static_cast<float>(i)), 1u);
+  }
+
+  glm::vec3 points[] = {glm::vec3(0.f), glm::vec3(1.f), glm::vec3(2.f),
+                        glm::vec3(3.f)};
+  list.path(points, 4u, 2u);
+
+  // None of the path's 3 segments are written, so none may be drawn
+  EXPECT_EQ(list.lines().size(), 3u);
+  EXPECT_EQ(list.dropped_count(), 3u);
+
+  // ... and the slot it did not use is still free
+  list.line(glm::vec3(0.f), glm::vec3(4.f), 3u);
+  ASSERT_EQ(list.lines().size(), 4u);
+  EXPECT_EQ(list.lines().data()[3].color, 3u);
+  EXPECT_EQ(list.dropped_count(), 3u);
+
+  list.begin_frame();
+  EXPECT_GE(list.lines().capacity(), 7u);
+}
+
+TEST(DebugDrawList, ConcurrentRecordingKeepsEveryLine) {
+  const uint32_t kThreadCount = 4u;
+  const uint32_t kLinesPerThread = 10000u;
+
+  DebugDrawList list(kThreadCount * kLinesPerThread);
+  list.begin_frame();
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < kThreadCount; t++) {
+    threads.emplace_back([&list, t, kLinesPerThread]() {
+      for (uint32_t i = 0; i < kLinesPerThread; i++) {
+        list.line(glm::vec3(static_cast<float>(i)), glm::vec3(0.f), t);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(list.lines().size(), kThreadCount * kLinesPerThread);
+
+  std::vector<uint32_t> per_thread(kThreadCount, 0u);
+  for (uint32_t i = 0; i < list.lines().size(); i++) {
+    uint32_t color = list.lines().data()[i].color;
+    ASSERT_LT(color, kThreadCount);
+    per_thread[color]++;
+  }
+  for (uint32_t count : per_thread) {
+    EXPECT_EQ(count, kLinesPerThread);
+  }
+}
+
+TEST(DebugDrawList, PacksColorsAsRgba8) {
+  EXPECT_EQ(DebugDrawList::pack_color(glm::vec4(1.f, 0.f, 0.f, 1.f)),
+            0xFF0000FFu);
+  EXPECT_EQ(DebugDrawList::pack_color(glm::vec3(0.f, 1.f, 0.f)), 0xFF00FF00u);
+  EXPECT_EQ(DebugDrawList::pack_color(glm::vec4(2.f, -1.f, 0.f, 0.f)),
+            0x000000FFu);
+}
@@ -0,0 +1,285 @@
+#include "frame_graph.h"
+
+#include <igasync/task_group.h>
+
+#include <algorithm>
+
+using namespace sanctify;
+using namespace render;
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+constexpr uint32_t kInvalidHandle = 0xFFFFFFFFu;
+}  // namespace
+
+std::string render::to_string(const FrameGraphCompileError& e) {
+  switch (e) {
+    case FrameGraphCompileError::NoOutputs:
+      return "NoOutputs";
+    case FrameGraphCompileError::ReadBeforeWrite:
+      return "ReadBeforeWrite";
+    case FrameGraphCompileError::InvalidHandle:
+      return "InvalidHandle";
+  }
+
+  return "<<FrameGraphCompileError - unknown>>";
+}
+
+FrameGraph::PassBuilder::PassBuilder(FrameGraph* graph, PassId pass_id)
+    : graph_(graph), pass_id_(pass_id) {}
+
+FrameGraph::PassBuilder& FrameGraph::PassBuilder::reads(ResourceId resource) {
+  if (resource >= graph_->resources_.size()) {
+    graph_->has_invalid_handle_ = true;
+    return *this;
+  }
+
+  graph_->passes_[pass_id_].reads.push_back(resource);
+  return *this;
+}
+
+FrameGraph::PassBuilder& FrameGraph::PassBuilder::writes(ResourceId resource) {
+  if (resource >= graph_->resources_.size()) {
+    graph_->has_invalid_handle_ = true;
+    return *this;
+  }
+
+  graph_->passes_[pass_id_].writes.push_back(resource);
+  return *this;
+}
+
+FrameGraph::PassBuilder& FrameGraph::PassBuilder::prepare(
+    std::function<void()> cb) {
+  graph_->passes_[pass_id_].prepare = std::move(cb);
+  return *this;
+}
+
+FrameGraph::PassBuilder& FrameGraph::PassBuilder::execute(
+    std::function<void()> cb) {
+  graph_->passes_[pass_id_].execute = std::move(cb);
+  return *this;
+}
+
+FrameGraph::PassId FrameGraph::PassBuilder::build() { return pass_id_; }
+
+FrameGraph::FrameGraph()
+    : resources_(8), passes_(8), has_invalid_handle_(false) {}
+
+FrameGraph::ResourceId FrameGraph::create_texture(std::string name,
+                                                  FrameGraphTextureDesc desc) {
+  ResourceId id = static_cast<ResourceId>(resources_.size());
+  resources_.push_back(Resource{std::move(name), false, false, desc});
+  return id;
+}
+
+FrameGraph::ResourceId FrameGraph::import_texture(std::string name) {
+  ResourceId id = static_cast<ResourceId>(resources_.size());
+  resources_.push_back(
+      Resource{std::move(name), true, false, FrameGraphTextureDesc{}});
+  return id;
+}
+
+void FrameGraph::mark_output(ResourceId resource) {
+  if (resource >= resources_.size()) {
+    has_invalid_handle_ = true;
+    return;
+  }
+
+  resources_[resource].isOutput = true;
+}
+
+FrameGraph::PassBuilder FrameGraph::add_pass(std::string name) {
+  PassId id = static_cast<PassId>(passes_.size());
+  Pass pass{};
+  pass.name = std::move(name);
+  passes_.push_back(std::move(pass));
+  return PassBuilder(this, id);
+}
+
+Either<CompiledFrameGraph, FrameGraphCompileError> FrameGraph::compile()
+    const {
+  if (has_invalid_handle_) {
+    return right(FrameGraphCompileError::InvalidHandle);
+  }
+
+  const uint32_t resource_count = this->resource_count();
+  const uint32_t pass_count = this->pass_count();
+
+  //
+  // Cull - walk passes backwards from the outputs. A pass lives if it writes
+  //  something that is still needed, and then needs everything it reads. A
+  //  live writer satisfies the need, so earlier writers of the same resource
+  //  are only kept if this pass also reads it (e.g. load instead of clear).
+  //
+  PodVector<uint8_t> is_needed(resource_count);
+  is_needed.resize(resource_count);
+  bool has_output = false;
+  for (uint32_t i = 0; i < resource_count; i++) {
+    is_needed[i] = resources_[i].isOutput ? 1u : 0u;
+    has_output = has_output || resources_[i].isOutput;
+  }
+
+  if (!has_output) {
+    return right(FrameGraphCompileError::NoOutputs);
+  }
+
+  PodVector<uint8_t> is_live(pass_count);
+  is_live.resize(pass_count);
+  for (int32_t p = static_cast<int32_t>(pass_count) - 1; p >= 0; p--) {
+    const Pass& pass = passes_[p];
+
+    bool writes_needed = false;
+    for (int i = 0; i < pass.writes.size(); i++) {
+      writes_needed = writes_needed || is_needed[pass.writes[i]] != 0u;
+    }
+
+    is_live[p] = writes_needed ? 1u : 0u;
+    if (!writes_needed) {
+      continue;
+    }
+
+    for (int i = 0; i < pass.writes.size(); i++) {
+      // Outputs stay needed - they are read after the graph is done
+      if (!resources_[pass.writes[i]].isOutput) {
+        is_needed[pass.writes[i]] = 0u;
+      }
+    }
+    for (int i = 0; i < pass.reads.size(); i++) {
+      is_needed[pass.reads[i]] = 1u;
+    }
+  }
+
+  CompiledFrameGraph compiled{};
+  for (uint32_t p = 0; p < pass_count; p++) {
+    if (is_live[p]) {
+      compiled.passOrder.push_back(p);
+    }
+  }
+
+  //
+  // Lifetimes (in passOrder positions) - and catch reads of transients that
+  //  nothing has written yet
+  //
+  compiled.firstUse.resize(resource_count);
+  compiled.lastUse.resize(resource_count);
+  PodVector<uint8_t> is_written(resource_count);
+  is_written.resize(resource_count);
+  for (uint32_t i = 0; i < resource_count; i++) {
+    compiled.firstUse[i] = CompiledFrameGraph::kNoTexture;
+    compiled.lastUse[i] = CompiledFrameGraph::kNoTexture;
+    is_written[i] = 0u;
+  }
+
+  auto mark_use = [&compiled](ResourceId r, uint32_t order_idx) {
+    if (compiled.firstUse[r] == CompiledFrameGraph::kNoTexture) {
+      compiled.firstUse[r] = order_idx;
+    }
+    compiled.lastUse[r] = order_idx;
+  };
+
+  for (uint32_t o = 0; o < compiled.passOrder.size(); o++) {
+    const Pass& pass = passes_[compiled.passOrder[o]];
+    for (int i = 0; i < pass.reads.size(); i++) {
+      ResourceId r = pass.reads[i];
+      if (!resources_[r].isImported && !is_written[r]) {
+        return right(FrameGraphCompileError::ReadBeforeWrite);
+      }
+      mark_use(r, o);
+    }
+    for (int i = 0; i < pass.writes.size(); i++) {
+      is_written[pass.writes[i]] = 1u;
+      mark_use(pass.writes[i], o);
+    }
+  }
+
+  //
+  // Aliasing - in order of first use, give each transient the first physical
+  //  texture with the same description that is free by then
+  //
+  PodVector<ResourceId> transients(resource_count);
+  for (uint32_t i = 0; i < resource_count; i++) {
+    if (!resources_[i].isImported &&
+        compiled.firstUse[i] != CompiledFrameGraph::kNoTexture) {
+      transients.push_back(i);
+    }
+  }
+  std::stable_sort(transients.raw(), transients.raw() + transients.size(),
+                   [&compiled](ResourceId a, ResourceId b) {
+                     return compiled.firstUse[a] < compiled.firstUse[b];
+                   });
+
+  compiled.physicalTextureIdx.resize(resource_count);
+  for (uint32_t i = 0; i < resource_count; i++) {
+    compiled.physicalTextureIdx[i] = CompiledFrameGraph::kNoTexture;
+  }
+
+  // Last passOrder position using each physical texture so far. Outputs are
+  //  read after the graph finishes, so their textures are never free again
+  //  (kNoTexture is later than any position).
+  PodVector<uint32_t> physical_last_use(4);
+  for (int t = 0; t < transients.size(); t++) {
+    const ResourceId r = transients[t];
+    const Resource& resource = resources_[r];
+
+    uint32_t physical_idx = kInvalidHandle;
+    for (uint32_t p = 0; p < compiled.physicalTextures.size(); p++) {
+      if (compiled.physicalTextures[p] == resource.desc &&
+          physical_last_use[p] < compiled.firstUse[r]) {
+        physical_idx = p;
+        break;
+      }
+    }
+
+    const uint32_t last_use = resource.isOutput ? CompiledFrameGraph::kNoTexture
+                                                : compiled.lastUse[r];
+    if (physical_idx == kInvalidHandle) {
+      physical_idx = static_cast<uint32_t>(compiled.physicalTextures.size());
+      compiled.physicalTextures.push_back(resource.desc);
+      physical_last_use.push_back(last_use);
+    } else {
+      physical_last_use[physical_idx] = last_use;
+    }
+
+    compiled.physicalTextureIdx[r] = physical_idx;
+  }
+
+  return left(std::move(compiled));
+}
+
+void FrameGraph::run(const CompiledFrameGraph& compiled,
+                     std::shared_ptr<TaskList> any_thread) const {
+  //
+  // Prepare (in parallel)
+  //
+  PodVector<PassId> to_prepare(compiled.passOrder.size());
+  for (int i = 0; i < compiled.passOrder.size(); i++) {
+    if (passes_[compiled.passOrder[i]].prepare) {
+      to_prepare.push_back(compiled.passOrder[i]);
+    }
+  }
+
+  if (to_prepare.size() > 1 && any_thread != nullptr) {
+    TaskGroup prepare_group;
+    for (int i = 0; i < to_prepare.size(); i++) {
+      const Pass* pass = &passes_[to_prepare[i]];
+      prepare_group.add([pass]() { pass->prepare(); });
+    }
+    prepare_group.run_and_wait(any_thread);
+  } else {
+    for (int i = 0; i < to_prepare.size(); i++) {
+      passes_[to_prepare[i]].prepare();
+    }
+  }
+
+  //
+  // Execute (in order)
+  //
+  for (int i = 0; i < compiled.passOrder.size(); i++) {
+    const Pass& pass = passes_[compiled.passOrder[i]];
+    if (pass.execute) {
+      pass.execute();
+    }
+  }
+}
@@ -0,0 +1,157 @@
+#ifndef SANCTIFY_COMMON_RENDER_FRAME_GRAPH_FRAME_GRAPH_H
+#define SANCTIFY_COMMON_RENDER_FRAME_GRAPH_FRAME_GRAPH_H
+
+#include <igasync/task_list.h>
+#include <igcore/either.h>
+#include <igcore/pod_vector.h>
+#include <igcore/vector.h>
+#include <webgpu/webgpu_cpp.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+/**
+ * Frame graph - declares the render passes of a frame, and the textures each
+ *  one reads and writes (attachments, sampled textures), then works out:
+ * - Which passes actually contribute to an output (the rest are culled)
+ * - How long each transient texture lives, and which transient textures can
+ *   share one physical texture (same description, non-overlapping lifetimes)
+ *
+ * Nothing in here touches the GPU - physical textures are handed out by the
+ *  caller (see TransientResourceCache), so compilation and aliasing can be
+ *  tested on their own.
+ *
+ * Passes may have a "prepare" callback for CPU work that produces draw data
+ *  (instance recording, sorting) and an "execute" callback that encodes GPU
+ *  commands. "run" prepares every live pass that has a prepare callback in
+ *  parallel (see core::TaskGroup), then executes them in order on the calling
+ *  thread. Prepare callbacks must only touch data owned by their own pass.
+ */
+
+namespace sanctify::render {
+
+struct FrameGraphTextureDesc {
+  uint32_t width;
+  uint32_t height;
+  wgpu::TextureFormat format;
+  wgpu::TextureUsage usage;
+
+  bool operator==(const FrameGraphTextureDesc& o) const {
+    return width == o.width && height == o.height && format == o.format &&
+           usage == o.usage;
+  }
+  bool operator!=(const FrameGraphTextureDesc& o) const {
+    return !(*this == o);
+  }
+};
+
+enum class FrameGraphCompileError {
+  // No resource was marked as an output, so every pass would be culled
+  NoOutputs,
+
+  // A live pass reads a transient texture that no earlier pass writes
+  ReadBeforeWrite,
+
+  // A pass or resource id that was not returned by this graph
+  InvalidHandle,
+};
+
+std::string to_string(const FrameGraphCompileError& e);
+
+struct CompiledFrameGraph {
+  static constexpr uint32_t kNoTexture = 0xFFFFFFFFu;
+
+  // Live passes, in execution order
+  indigo::core::PodVector<uint32_t> passOrder;
+
+  // Per resource id - index into physicalTextures, or kNoTexture for
+  //  imported and unused textures
+  indigo::core::PodVector<uint32_t> physicalTextureIdx;
+
+  // Textures the caller needs to provide this frame
+  indigo::core::PodVector<FrameGraphTextureDesc> physicalTextures;
+
+  // Per resource id - first and last position in passOrder that uses it
+  //  (kNoTexture for unused resources)
+  indigo::core::PodVector<uint32_t> firstUse;
+  indigo::core::PodVector<uint32_t> lastUse;
+};
+
+class FrameGraph {
+ public:
+  typedef uint32_t ResourceId;
+  typedef uint32_t PassId;
+
+  class PassBuilder {
+   public:
+    PassBuilder& reads(ResourceId resource);
+    PassBuilder& writes(ResourceId resource);
+    PassBuilder& prepare(std::function<void()> cb);
+    PassBuilder& execute(std::function<void()> cb);
+    PassId build();
+
+   private:
+    friend class FrameGraph;
+    PassBuilder(FrameGraph* graph, PassId pass_id);
+
+    FrameGraph* graph_;
+    PassId pass_id_;
+  };
+
+  FrameGraph();
+
+  // Texture owned by the graph - may share memory with other transients
+  ResourceId create_texture(std::string name, FrameGraphTextureDesc desc);
+
+  // Texture owned by somebody else (e.g. the swap chain backbuffer)
+  ResourceId import_texture(std::string name);
+
+  // Passes that do not (eventually) write to an output are culled
+  void mark_output(ResourceId resource);
+
+  // Passes may only depend on passes added before them
+  PassBuilder add_pass(std::string name);
+
+  indigo::core::Either<CompiledFrameGraph, FrameGraphCompileError> compile()
+      const;
+
+  /**
+   * Prepare every live pass (in parallel with "any_thread" executors, or
+   *  inline if it is null or there is only one pass to prepare), wait for all
+   *  of them, then execute live passes in order. Only this frame's prepare
+   *  work ever runs on the calling thread.
+   */
+  void run(const CompiledFrameGraph& compiled,
+           std::shared_ptr<indigo::core::TaskList> any_thread) const;
+
+  uint32_t pass_count() const { return static_cast<uint32_t>(passes_.size()); }
+  uint32_t resource_count() const {
+    return static_cast<uint32_t>(resources_.size());
+  }
+  const std::string& pass_name(PassId pass) const { return passes_[pass].name; }
+
+ private:
+  struct Resource {
+    std::string name;
+    bool isImported;
+    bool isOutput;
+    FrameGraphTextureDesc desc;
+  };
+
+  struct Pass {
+    std::string name;
+    indigo::core::PodVector<ResourceId> reads;
+    indigo::core::PodVector<ResourceId> writes;
+    std::function<void()> prepare;
+    std::function<void()> execute;
+  };
+
+  indigo::core::Vector<Resource> resources_;
+  indigo::core::Vector<Pass> passes_;
+  bool has_invalid_handle_;
+};
+
+}  // namespace sanctify::render
+
+#endif
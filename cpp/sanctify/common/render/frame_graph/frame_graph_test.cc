@@ -0,0 +1,274 @@
+#include "frame_graph.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace sanctify;
+using namespace render;
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+
+FrameGraphTextureDesc hdr_desc(uint32_t width = 1280u,
+                               uint32_t height = 720u) {
+  return FrameGraphTextureDesc{width, height, wgpu::TextureFormat::RGBA16Float,
+                               wgpu::TextureUsage::RenderAttachment |
+                                   wgpu::TextureUsage::TextureBinding};
+}
+
+FrameGraphTextureDesc depth_desc(uint32_t width = 1280u,
+                                 uint32_t height = 720u) {
+  return FrameGraphTextureDesc{width, height,
+                               wgpu::TextureFormat::Depth24PlusStencil8,
+                               wgpu::TextureUsage::RenderAttachment};
+}
+
+}  // namespace
+
+TEST(FrameGraph, OrdersAndKeepsPassesFeedingOutput) {
+  FrameGraph graph;
+  auto hdr = graph.create_texture("hdr", ::hdr_desc());
+  auto depth = graph.create_texture("depth", ::depth_desc());
+  auto backbuffer = graph.import_texture("backbuffer");
+  graph.mark_output(backbuffer);
+
+  auto geo = graph.add_pass("geo").writes(hdr).writes(depth).build();
+  auto tonemap = graph.add_pass("tonemap").reads(hdr).writes(backbuffer).build();
+
+  auto rsl = graph.compile();
+  ASSERT_TRUE(rsl.is_left());
+  const auto& compiled = rsl.get_left();
+
+  ASSERT_EQ(compiled.passOrder.size(), 2);
+  EXPECT_EQ(compiled.passOrder[0], geo);
+  EXPECT_EQ(compiled.passOrder[1], tonemap);
+
+  EXPECT_EQ(compiled.physicalTextures.size(), 2);
+  EXPECT_NE(compiled.physicalTextureIdx[hdr], compiled.physicalTextureIdx[depth]);
+  EXPECT_EQ(compiled.physicalTextureIdx[backbuffer],
+            CompiledFrameGraph::kNoTexture);
+}
+
+TEST(FrameGraph, CullsPassesThatDoNotReachOutput) {
+  FrameGraph graph;
+  auto hdr = graph.create_texture("hdr", ::hdr_desc());
+  auto debug = graph.create_texture("debug", ::hdr_desc());
+  auto backbuffer = graph.import_texture("backbuffer");
+  graph.mark_output(backbuffer);
+
+  graph.add_pass("debug_overlay").writes(debug).build();
+  auto geo = graph.add_pass("geo").writes(hdr).build();
+  auto tonemap = graph.add_pass("tonemap").reads(hdr).writes(backbuffer).build();
+
+  auto rsl = graph.compile();
+  ASSERT_TRUE(rsl.is_left());
+  const auto& compiled = rsl.get_left();
+
+  ASSERT_EQ(compiled.passOrder.size(), 2);
+  EXPECT_EQ(compiled.passOrder[0], geo);
+  EXPECT_EQ(compiled.passOrder[1], tonemap);
+
+  // Unused transients get no physical texture at all
+  EXPECT_EQ(compiled.physicalTextureIdx[debug], CompiledFrameGraph::kNoTexture);
+  EXPECT_EQ(compiled.physicalTextures.size(), 1);
+}
+
+TEST(FrameGraph, OverwrittenResultsCullEarlierWriter) {
+  FrameGraph graph;
+  auto hdr = graph.create_texture("hdr", ::hdr_desc());
+  auto backbuffer = graph.import_texture("backbuffer");
+  graph.mark_output(backbuffer);
+
+  // Clears and fully re-draws hdr without reading it - "first" is wasted
+  graph.add_pass("first").writes(hdr).build();
+  auto second = graph.add_pass("second").writes(hdr).build();
+  auto tonemap = graph.add_pass("tonemap").reads(hdr).writes(backbuffer).build();
+
+  auto rsl = graph.compile();
+  ASSERT_TRUE(rsl.is_left());
+  const auto& compiled = rsl.get_left();
+
+  ASSERT_EQ(compiled.passOrder.size(), 2);
+  EXPECT_EQ(compiled.passOrder[0], second);
+  EXPECT_EQ(compiled.passOrder[1], tonemap);
+}
+
+TEST(FrameGraph, AliasesTransientsWithDisjointLifetimes) {
+  FrameGraph graph;
+  auto scene = graph.create_texture("scene", ::hdr_desc());
+  auto bloom_a = graph.create_texture("bloom_a", ::hdr_desc());
+  auto bloom_b = graph.create_texture("bloom_b", ::hdr_desc());
+  auto small = graph.create_texture("small", ::hdr_desc(640u, 360u));
+  auto backbuffer = graph.import_texture("backbuffer");
+  graph.mark_output(backbuffer);
+
+  // scene: [0, 1], bloom_a: [1, 2], bloom_b: [2, 3], small: [3, 4]
+  graph.add_pass("geo").writes(scene).build();
+  graph.add_pass("bloom_extract").reads(scene).writes(bloom_a).build();
+  graph.add_pass("bloom_blur").reads(bloom_a).writes(bloom_b).build();
+  graph.add_pass("downsample").reads(bloom_b).writes(small).build();
+  graph.add_pass("composite").reads(small).writes(backbuffer).build();
+
+  auto rsl = graph.compile();
+  ASSERT_TRUE(rsl.is_left());
+  const auto& compiled = rsl.get_left();
+
+  // scene is dead by the time bloom_b is written, so they share memory -
+  //  bloom_a overlaps both. small has a different size, so gets its own.
+  EXPECT_EQ(compiled.physicalTextureIdx[scene],
+            compiled.physicalTextureIdx[bloom_b]);
+  EXPECT_NE(compiled.physicalTextureIdx[scene],
+            compiled.physicalTextureIdx[bloom_a]);
+  EXPECT_NE(compiled.physicalTextureIdx[small],
+            compiled.physicalTextureIdx[scene]);
+  EXPECT_NE(compiled.physicalTextureIdx[small],
+            compiled.physicalTextureIdx[bloom_a]);
+  EXPECT_EQ(compiled.physicalTextures.size(), 3);
+
+  EXPECT_EQ(compiled.firstUse[bloom_a], 1u);
+  EXPECT_EQ(compiled.lastUse[bloom_a], 2u);
+
+  // A transient output is still read once the graph has run - nothing that
+  //  starts after its last pass may take its texture
+  {
+    FrameGraph graph;
+    auto hdr = graph.create_texture("hdr", ::hdr_desc());
+    auto debug_view = graph.create_texture("debug_view", ::hdr_desc());
+    auto scratch = graph.create_texture("scratch", ::hdr_desc());
+    auto backbuffer = graph.import_texture("backbuffer");
+    graph.mark_output(debug_view);
+    graph.mark_output(backbuffer);
+
+    // debug_view: [1, 1], scratch: [2, 3]
+    graph.add_pass("geo").writes(hdr).build();
+    graph.add_pass("debug").reads(hdr).writes(debug_view).build();
+    graph.add_pass("post").reads(hdr).writes(scratch).build();
+    graph.add_pass("composite").reads(scratch).writes(backbuffer).build();
+
+    auto rsl = graph.compile();
+    ASSERT_TRUE(rsl.is_left());
+    const auto& compiled = rsl.get_left();
+
+    ASSERT_LT(compiled.lastUse[debug_view], compiled.firstUse[scratch]);
+    EXPECT_NE(compiled.physicalTextureIdx[debug_view],
+              compiled.physicalTextureIdx[scratch]);
+    EXPECT_NE(compiled.physicalTextureIdx[debug_view],
+              compiled.physicalTextureIdx[hdr]);
+  }
+}
+
+TEST(FrameGraph, ReportsReadBeforeWrite) {
+  FrameGraph graph;
+  auto hdr = graph.create_texture("hdr", ::hdr_desc());
+  auto backbuffer = graph.import_texture("backbuffer");
+  graph.mark_output(backbuffer);
+
+  graph.add_pass("tonemap").reads(hdr).writes(backbuffer).build();
+
+  auto rsl = graph.compile();
+  ASSERT_TRUE(rsl.is_right());
+  EXPECT_EQ(rsl.get_right(), FrameGraphCompileError::ReadBeforeWrite);
+}
+
+TEST(FrameGraph, ReportsMissingOutputAndBadHandles) {
+  {
+    FrameGraph graph;
+    auto hdr = graph.create_texture("hdr", ::hdr_desc());
+    graph.add_pass("geo").writes(hdr).build();
+
+    auto rsl = graph.compile();
+    ASSERT_TRUE(rsl.is_right());
+    EXPECT_EQ(rsl.get_right(), FrameGraphCompileError::NoOutputs);
+  }
+
+  {
+    FrameGraph graph;
+    auto backbuffer = graph.import_texture("backbuffer");
+    graph.mark_output(backbuffer);
+    graph.add_pass("geo").writes(backbuffer).reads(42u).build();
+
+    auto rsl = graph.compile();
+    ASSERT_TRUE(rsl.is_right());
+    EXPECT_EQ(rsl.get_right(), FrameGraphCompileError::InvalidHandle);
+  }
+}
+
+TEST(FrameGraph, RunPreparesEverythingBeforeExecutingInOrder) {
+  FrameGraph graph;
+  auto hdr = graph.create_texture("hdr", ::hdr_desc());
+  auto shadow = graph.create_texture("shadow", ::depth_desc(1024u, 1024u));
+  auto unused = graph.create_texture("unused", ::hdr_desc());
+  auto backbuffer = graph.import_texture("backbuffer");
+  graph.mark_output(backbuffer);
+
+  std::atomic_uint32_t prepared_count(0u);
+  std::vector<std::string> executed;
+  bool all_prepared_before_execute = true;
+
+  auto add_pass = [&](const char* name, std::vector<uint32_t> reads,
+                      std::vector<uint32_t> writes) {
+    auto builder = graph.add_pass(name);
+    for (auto r : reads) builder.reads(r);
+    for (auto w : writes) builder.writes(w);
+    builder.prepare([&prepared_count]() { prepared_count++; })
+        .execute([&, name]() {
+          all_prepared_before_execute =
+              all_prepared_before_execute && prepared_count == 3u;
+          executed.push_back(name);
+        })
+        .build();
+  };
+
+  add_pass("shadow", {}, {shadow});
+  add_pass("geo", {shadow}, {hdr});
+  add_pass("culled", {}, {unused});
+  add_pass("tonemap", {hdr}, {backbuffer});
+
+  auto rsl = graph.compile();
+  ASSERT_TRUE(rsl.is_left());
+
+  // No worker threads - the calling thread drains the task list itself
+  graph.run(rsl.get_left(), std::make_shared<TaskList>());
+
+  EXPECT_EQ(prepared_count, 3u);
+  EXPECT_TRUE(all_prepared_before_execute);
+  ASSERT_EQ(executed.size(), 3u);
+  EXPECT_EQ(executed[0], "shadow");
+  EXPECT_EQ(executed[1], "geo");
+  EXPECT_EQ(executed[2], "tonemap");
+}
+
+TEST(FrameGraph, RunOnlyExecutesItsOwnPrepareWork) {
+  FrameGraph graph;
+  auto hdr = graph.create_texture("hdr", ::hdr_desc());
+  auto backbuffer = graph.import_texture("backbuffer");
+  graph.mark_output(backbuffer);
+
+  std::atomic_uint32_t prepared_count(0u);
+  graph.add_pass("geo")
+      .writes(hdr)
+      .prepare([&prepared_count]() { prepared_count++; })
+      .build();
+  graph.add_pass("tonemap")
+      .reads(hdr)
+      .writes(backbuffer)
+      .prepare([&prepared_count]() { prepared_count++; })
+      .build();
+
+  auto rsl = graph.compile();
+  ASSERT_TRUE(rsl.is_left());
+
+  // Unrelated work already queued on the shared list stays there
+  auto any_thread = std::make_shared<TaskList>();
+  bool ran_unrelated = false;
+  any_thread->add_task(Task::of([&ran_unrelated]() { ran_unrelated = true; }));
+
+  graph.run(rsl.get_left(), any_thread);
+
+  EXPECT_EQ(prepared_count, 2u);
+  EXPECT_FALSE(ran_unrelated);
+}
@@ -0,0 +1,88 @@
+#ifndef SANCTIFY_COMMON_RENDER_FRAME_GRAPH_TRANSIENT_RESOURCE_CACHE_H
+#define SANCTIFY_COMMON_RENDER_FRAME_GRAPH_TRANSIENT_RESOURCE_CACHE_H
+
+#include <igcore/vector.h>
+
+#include "frame_graph.h"
+
+/**
+ * Keeps the physical textures of a compiled FrameGraph alive across frames,
+ *  keyed by description (size, format, usage) - so attachments like the HDR
+ *  buffer and depth-stencil are only re-created when the viewport or format
+ *  actually changes.
+ *
+ * Each frame, "begin_frame", then "acquire" once per physical texture, then
+ *  "end_frame". Acquiring the same description twice in one frame hands out
+ *  two different resources. Resources not acquired for more than
+ *  "max_idle_frames" frames are dropped (e.g. old sizes after a resize).
+ *
+ * ResourceT is whatever the caller creates for a description - it is copied
+ *  out of "acquire", so cheap handle types (wgpu::TextureView) work best.
+ */
+
+namespace sanctify::render {
+
+template <typename ResourceT>
+class TransientResourceCache {
+ public:
+  TransientResourceCache(uint32_t max_idle_frames = 2u)
+      : max_idle_frames_(max_idle_frames), frame_(0u), entries_(4) {}
+
+  void begin_frame() {
+    frame_++;
+    for (int i = 0; i < entries_.size(); i++) {
+      entries_[i].acquiredThisFrame = false;
+    }
+  }
+
+  template <typename CreateFnT>
+  ResourceT acquire(const FrameGraphTextureDesc& desc, CreateFnT&& create_fn) {
+    for (int i = 0; i < entries_.size(); i++) {
+      Entry& entry = entries_[i];
+      if (!entry.acquiredThisFrame && entry.desc == desc) {
+        entry.acquiredThisFrame = true;
+        entry.lastAcquiredFrame = frame_;
+        return entry.resource;
+      }
+    }
+
+    Entry entry{};
+    entry.desc = desc;
+    entry.resource = create_fn(desc);
+    entry.acquiredThisFrame = true;
+    entry.lastAcquiredFrame = frame_;
+    entries_.push_back(entry);
+    created_count_++;
+    return entries_.last().resource;
+  }
+
+  void end_frame() {
+    for (int i = 0; i < entries_.size(); i++) {
+      if (frame_ - entries_[i].lastAcquiredFrame > max_idle_frames_) {
+        entries_.delete_at(i--, false);
+      }
+    }
+  }
+
+  uint32_t size() const { return static_cast<uint32_t>(entries_.size()); }
+
+  // Total resources ever created - stays flat while nothing is resized
+  uint64_t created_count() const { return created_count_; }
+
+ private:
+  struct Entry {
+    FrameGraphTextureDesc desc;
+    ResourceT resource;
+    bool acquiredThisFrame;
+    uint64_t lastAcquiredFrame;
+  };
+
+  uint32_t max_idle_frames_;
+  uint64_t frame_;
+  uint64_t created_count_ = 0u;
+  indigo::core::Vector<Entry> entries_;
+};
+
+}  // namespace sanctify::render
+
+#endif
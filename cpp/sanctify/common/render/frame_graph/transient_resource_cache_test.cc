@@ -0,0 +1,113 @@
+#include "transient_resource_cache.h"
+
+#include <gtest/gtest.h>
+
+using namespace sanctify;
+using namespace render;
+
+namespace {
+
+FrameGraphTextureDesc hdr_desc(uint32_t width, uint32_t height) {
+  return FrameGraphTextureDesc{width, height, wgpu::TextureFormat::RGBA16Float,
+                               wgpu::TextureUsage::RenderAttachment |
+                                   wgpu::TextureUsage::TextureBinding};
+}
+
+// Stand-in for a GPU texture - every created resource gets a new id
+struct FakeTexture {
+  uint32_t id;
+  uint32_t width;
+};
+
+struct FakeTextureFactory {
+  uint32_t nextId = 1u;
+
+  FakeTexture operator()(const FrameGraphTextureDesc& desc) {
+    return FakeTexture{nextId++, desc.width};
+  }
+};
+
+}  // namespace
+
+TEST(TransientResourceCache, ReusesResourcesAcrossFrames) {
+  TransientResourceCache<FakeTexture> cache;
+  FakeTextureFactory factory;
+
+  cache.begin_frame();
+  FakeTexture first = cache.acquire(::hdr_desc(1280u, 720u), factory);
+  cache.end_frame();
+
+  for (int frame = 0; frame < 10; frame++) {
+    cache.begin_frame();
+    FakeTexture again = cache.acquire(::hdr_desc(1280u, 720u), factory);
+    cache.end_frame();
+
+    EXPECT_EQ(again.id, first.id);
+  }
+
+  EXPECT_EQ(cache.created_count(), 1u);
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(TransientResourceCache, SameDescriptionTwiceInOneFrameIsTwoResources) {
+  TransientResourceCache<FakeTexture> cache;
+  FakeTextureFactory factory;
+
+  for (int frame = 0; frame < 3; frame++) {
+    cache.begin_frame();
+    FakeTexture a = cache.acquire(::hdr_desc(1280u, 720u), factory);
+    FakeTexture b = cache.acquire(::hdr_desc(1280u, 720u), factory);
+    cache.end_frame();
+
+    EXPECT_NE(a.id, b.id);
+  }
+
+  EXPECT_EQ(cache.created_count(), 2u);
+}
+
+TEST(TransientResourceCache, ResizeCreatesNewAndDropsIdle) {
+  TransientResourceCache<FakeTexture> cache(2u);
+  FakeTextureFactory factory;
+
+  cache.begin_frame();
+  cache.acquire(::hdr_desc(1280u, 720u), factory);
+  cache.end_frame();
+
+  // Viewport resized - the old size is kept for a couple of frames in case
+  //  the resize bounces back, then dropped
+  for (int frame = 0; frame < 2; frame++) {
+    cache.begin_frame();
+    FakeTexture resized = cache.acquire(::hdr_desc(1920u, 1080u), factory);
+    cache.end_frame();
+    EXPECT_EQ(resized.width, 1920u);
+  }
+  EXPECT_EQ(cache.size(), 2u);
+
+  cache.begin_frame();
+  cache.acquire(::hdr_desc(1920u, 1080u), factory);
+  cache.end_frame();
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.created_count(), 2u);
+}
+
+TEST(TransientResourceCache, FormatAndUsageArePartOfTheKey) {
+  TransientResourceCache<FakeTexture> cache;
+  FakeTextureFactory factory;
+
+  FrameGraphTextureDesc color = ::hdr_desc(1280u, 720u);
+  FrameGraphTextureDesc depth = color;
+  depth.format = wgpu::TextureFormat::Depth24PlusStencil8;
+  FrameGraphTextureDesc attachment_only = color;
+  attachment_only.usage = wgpu::TextureUsage::RenderAttachment;
+
+  cache.begin_frame();
+  uint32_t color_id = cache.acquire(color, factory).id;
+  uint32_t depth_id = cache.acquire(depth, factory).id;
+  uint32_t attachment_id = cache.acquire(attachment_only, factory).id;
+  cache.end_frame();
+
+  EXPECT_NE(color_id, depth_id);
+  EXPECT_NE(color_id, attachment_id);
+  EXPECT_NE(depth_id, attachment_id);
+  EXPECT_EQ(cache.created_count(), 3u);
+}
@@ -1,6 +1,7 @@
 #include "ecs_util.h"
 
 #include <common/render/common/render_components.h>
+#include <common/render/visibility/visibility_system.h>
 #include <igasync/promise_combiner.h>
 #include <igcore/log.h>
 
@@ -13,6 +14,37 @@ using namespace core;
 
 namespace {
 const char* kLogLabel = "s::r::solid_static::EcsUtil";
+
+void record_instance(InstanceStore& instance_store,
+                     const RenderableComponent& renderable,
+                     const MatWorldComponent& mat_world) {
+  InstanceData instance_data{};
+  instance_data.matWorld = mat_world.matWorld;
+  instance_data.albedo = renderable.albedo;
+  instance_data.ambientOcclusion = renderable.ao;
+  instance_data.metallic = renderable.metallic;
+  instance_data.roughness = renderable.roughness;
+
+  instance_store.add_instance(InstanceKey{renderable.geoKey}, instance_data);
+}
+
+void draw_instances(InstanceStore& instance_store,
+                    const ReadonlyResourceRegistry<Geo>& geo_registry,
+                    const wgpu::Device& device, RenderUtil* render_util) {
+  instance_store.finalize(device, [render_util, &geo_registry](
+                                      const auto& key,
+                                      const wgpu::Buffer& buffer,
+                                      uint64_t offset, uint32_t num_instances) {
+    auto* geo = geo_registry.get(key.geo_key());
+    if (!geo) {
+      return;
+    }
+
+    render_util->set_geometry(*geo)
+        .set_instances(buffer, num_instances, offset)
+        .draw();
+  });
+}
 }  // namespace
 
 bool EcsUtil::prepare_world(indigo::igecs::WorldView* wv) {
@@ -32,11 +64,20 @@ void EcsUtil::attach_renderable(igecs::WorldView* wv, entt::entity e,
   wv->attach<RenderableComponent>(
       e, geo_key, instance_data.albedo, instance_data.metallic,
       instance_data.roughness, instance_data.ambientOcclusion);
+
+  if (wv->ctx_has<CtxResourceRegistries>()) {
+    const auto* geo = wv->ctx<CtxResourceRegistries>().geoRegistry.get(geo_key);
+    if (geo) {
+      VisibilitySystem::set_world_bounds(wv, e, geo->bounds,
+                                         instance_data.matWorld);
+    }
+  }
 }
 
 void EcsUtil::detach_renderable(igecs::WorldView* wv, entt::entity e) {
   wv->remove<MatWorldComponent>(e);
   wv->remove<RenderableComponent>(e);
+  wv->remove<WorldBoundsComponent>(e);
 }
 
 std::shared_ptr<Promise<Maybe<PipelineBuildError>>>
@@ -45,43 +86,70 @@ EcsUtil::create_ctx_pipeline(
     asset::IgpackLoader::ExtractWgslShaderPromiseT vs_src_promise,
     asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
     std::shared_ptr<TaskList> main_thread_task_list) {
+  typedef std::shared_ptr<Promise<Maybe<PipelineBuildError>>> BuildPromiseT;
+
   auto combiner = PromiseCombiner::Create();
 
   auto vs_key = combiner->add(vs_src_promise, main_thread_task_list);
   auto fs_key = combiner->add(fs_src_promise, main_thread_task_list);
 
-  return combiner->combine<Maybe<PipelineBuildError>>(
-      [vs_key, fs_key, device,
-       world](const PromiseCombiner::PromiseCombinerResult& rsl)
-          -> Maybe<PipelineBuildError> {
-        const auto& vs_rsl = rsl.get(vs_key);
-        const auto& fs_rsl = rsl.get(fs_key);
-
-        if (vs_rsl.is_right()) {
-          Logger::err(kLogLabel) << "Failed to load vertex shader: "
-                                 << asset::to_string(vs_rsl.get_right());
-          return PipelineBuildError::VsLoadError;
-        }
-        if (fs_rsl.is_right()) {
-          Logger::err(kLogLabel) << "Failed to load fragment shader: "
-                                 << asset::to_string(fs_rsl.get_right());
-          return PipelineBuildError::FsLoadError;
-        }
-
-        auto pipeline_builder = PipelineBuilder::Create(
-            device, vs_rsl.get_left(), fs_rsl.get_left());
-
-        wgpu::TextureFormat hdr_format =
-            world->ctx<CtxHdrFramebufferParams>().format;
-
-        auto pipeline = pipeline_builder.create_pipeline(device, hdr_format);
-
-        world->set<CtxPipeline>(std::move(pipeline_builder),
-                                std::move(pipeline));
-
-        return empty_maybe{};
-      },
-      main_thread_task_list);
+  return combiner
+      ->combine<BuildPromiseT>(
+          [vs_key, fs_key, device, world, main_thread_task_list](
+              const PromiseCombiner::PromiseCombinerResult& rsl)
+              -> BuildPromiseT {
+            const auto& vs_rsl = rsl.get(vs_key);
+            const auto& fs_rsl = rsl.get(fs_key);
+
+            if (vs_rsl.is_right()) {
+              Logger::err(kLogLabel) << "Failed to load vertex shader: "
+                                     << asset::to_string(vs_rsl.get_right());
+              return Promise<Maybe<PipelineBuildError>>::immediate(
+                  PipelineBuildError::VsLoadError);
+            }
+            if (fs_rsl.is_right()) {
+              Logger::err(kLogLabel) << "Failed to load fragment shader: "
+                                     << asset::to_string(fs_rsl.get_right());
+              return Promise<Maybe<PipelineBuildError>>::immediate(
+                  PipelineBuildError::FsLoadError);
+            }
+
+            auto pipeline_builder = PipelineBuilder::Create(
+                device, vs_rsl.get_left(), fs_rsl.get_left());
+
+            wgpu::TextureFormat hdr_format =
+                world->ctx<CtxHdrFramebufferParams>().format;
+            auto pipeline_cache =
+                world->ctx<CtxPlatformObjects>().pipelineCache;
+
+            auto pending = pipeline_builder.create_pipeline_async(
+                device, pipeline_cache.get(), hdr_format);
+
+            world->set<CtxPipeline>(std::move(pipeline_builder),
+                                    Pipeline{hdr_format, nullptr},
+                                    pipeline_cache, pending.key);
+
+            return pending.promise->then<Maybe<PipelineBuildError>>(
+                [world,
+                 hdr_format](const wgpu::RenderPipeline& gpu_pipeline)
+                    -> Maybe<PipelineBuildError> {
+                  if (!gpu_pipeline) {
+                    return PipelineBuildError::PipelineBuildError;
+                  }
+
+                  auto& pipeline_ctx = world->ctx<CtxPipeline>();
+                  if (pipeline_ctx.currentPipeline.outputFormat ==
+                      hdr_format) {
+                    pipeline_ctx.currentPipeline.pipeline = gpu_pipeline;
+                  }
+                  return empty_maybe{};
+                },
+                main_thread_task_list);
+          },
+          main_thread_task_list)
+      ->then_chain<Maybe<PipelineBuildError>>(
+          [](const BuildPromiseT& build_promise) { return build_promise; },
+          main_thread_task_list);
 }
 
 void EcsUtil::update_pipeline(indigo::igecs::WorldView* wv,
@@ -89,9 +157,21 @@ void EcsUtil::update_pipeline(indigo::igecs::WorldView* wv,
   wgpu::TextureFormat hdr_format = wv->ctx<CtxHdrFramebufferParams>().format;
   auto& pipeline_ctx = wv->mut_ctx<CtxPipeline>();
 
+  // Never rebuild in the middle of a frame - request the new format, and skip
+  //  drawing until it is ready
   if (pipeline_ctx.currentPipeline.outputFormat != hdr_format) {
-    pipeline_ctx.currentPipeline =
-        pipeline_ctx.builder.create_pipeline(device, hdr_format);
+    auto pending = pipeline_ctx.builder.create_pipeline_async(
+        device, pipeline_ctx.pipelineCache.get(), hdr_format);
+    pipeline_ctx.currentPipeline = Pipeline{hdr_format, nullptr};
+    pipeline_ctx.pendingKey = pending.key;
+  }
+
+  if (!pipeline_ctx.currentPipeline.pipeline) {
+    auto ready =
+        pipeline_ctx.pipelineCache->get_if_ready(pipeline_ctx.pendingKey);
+    if (ready.has_value()) {
+      pipeline_ctx.currentPipeline.pipeline = ready.get();
+    }
   }
 }
 
@@ -122,6 +202,7 @@ const igecs::WorldView::Decl& EcsUtil::render_decl() {
       igecs::WorldView::Decl()
           .reads<RenderableComponent>()
           .reads<MatWorldComponent>()
+          .ctx_reads<CtxVisibleList>()
           .ctx_writes<CtxResourceRegistries>();
 
   return kRenderDecl;
@@ -143,25 +224,46 @@ void EcsUtil::render_matching(igecs::WorldView* wv, const wgpu::Device& device,
   for (auto [e, renderable, mat_world] : view.each()) {
     if (!predicate(e)) continue;
 
-    InstanceData instance_data{};
-    instance_data.matWorld = mat_world.matWorld;
-    instance_data.albedo = renderable.albedo;
-    instance_data.ambientOcclusion = renderable.ao;
-    instance_data.metallic = renderable.metallic;
-    instance_data.roughness = renderable.roughness;
-
-    instance_store.add_instance(InstanceKey{renderable.geoKey}, instance_data);
+    ::record_instance(instance_store, renderable, mat_world);
   }
 
-  instance_store.finalize(device, [render_util, &geo_registry](
-                                      const auto& key,
-                                      const wgpu::Buffer& buffer,
-                                      uint32_t num_instances) {
-    auto* geo = geo_registry.get(key.geo_key());
-    if (!geo) {
-      return;
+  ::draw_instances(instance_store, geo_registry, device, render_util);
+}
+
+void EcsUtil::render_visible(igecs::WorldView* wv, const wgpu::Device& device,
+                             RenderUtil* render_util) {
+  prepare_visible(wv);
+  draw_prepared(wv, device, render_util);
+}
+
+void EcsUtil::prepare_visible(igecs::WorldView* wv) {
+  auto view = wv->view<const RenderableComponent, const MatWorldComponent>();
+  auto& instance_store = wv->mut_ctx<CtxResourceRegistries>().instanceStore;
+
+  instance_store.begin_frame();
+
+  // Nothing has been culled yet - draw everything instead
+  if (!wv->ctx_has<CtxVisibleList>()) {
+    for (auto [e, renderable, mat_world] : view.each()) {
+      ::record_instance(instance_store, renderable, mat_world);
+    }
+  } else {
+    const auto& visible = wv->ctx<CtxVisibleList>().visible;
+    for (int i = 0; i < visible.size(); i++) {
+      entt::entity e = visible[i];
+      if (!view.contains(e)) continue;
+
+      auto [renderable, mat_world] = view.get(e);
+      ::record_instance(instance_store, renderable, mat_world);
     }
+  }
 
-    render_util->set_geometry(*geo).set_instances(buffer, num_instances).draw();
-  });
+  instance_store.pack();
+}
+
+void EcsUtil::draw_prepared(igecs::WorldView* wv, const wgpu::Device& device,
+                            RenderUtil* render_util) {
+  auto& ctx_resource_registries = wv->mut_ctx<CtxResourceRegistries>();
+  ::draw_instances(ctx_resource_registries.instanceStore,
+                   ctx_resource_registries.geoRegistry, device, render_util);
 }
@@ -37,7 +37,12 @@ struct CtxResourceRegistries {
 /** Pipeline (asynchronously created) */
 struct CtxPipeline {
   PipelineBuilder builder;
+
+  // Null while the pipeline for its output format is still being built
   Pipeline currentPipeline;
+
+  std::shared_ptr<indigo::iggpu::RenderPipelineCache> pipelineCache;
+  uint64_t pendingKey;
 };
 
 /** Utility methods for dealing with SolidStatic rendering */
@@ -47,14 +52,18 @@ struct EcsUtil {
   //  attach the pipeline, which must be done asynchronously!
   static bool prepare_world(indigo::igecs::WorldView* wv);
 
-  // Individual renderables
+  // Individual renderables - world bounds (see VisibilitySystem) are set from
+  //  the geo if it is already registered
   static void attach_renderable(indigo::igecs::WorldView* wv, entt::entity e,
                                 ReadonlyResourceRegistry<Geo>::Key geo_key,
                                 InstanceData instance_data);
   static void detach_renderable(indigo::igecs::WorldView* wv, entt::entity e);
 
   // Pipeline creation and fetching
-  // Notice: these require CtxHdrFramebufferParams to have been set
+  // Notice: these require CtxHdrFramebufferParams and CtxPlatformObjects to
+  //  have been set. The pipeline is built asynchronously through
+  //  CtxPlatformObjects::pipelineCache - the returned promise resolves once it
+  //  is ready, and get_pipeline returns a null pipeline until then.
   static std::shared_ptr<
       indigo::core::Promise<indigo::core::Maybe<PipelineBuildError>>>
   create_ctx_pipeline(
@@ -82,6 +91,19 @@ struct EcsUtil {
                               const wgpu::Device& device,
                               RenderUtil* render_util,
                               std::function<bool(entt::entity)> predicate);
+
+  // Renders only the entities of CtxVisibleList (see VisibilitySystem)
+  static void render_visible(indigo::igecs::WorldView* wv,
+                             const wgpu::Device& device,
+                             RenderUtil* render_util);
+
+  // render_visible, split in two - "prepare_visible" records and batches
+  //  instances without touching the device (so it may run off of the main
+  //  thread, see FrameGraph), "draw_prepared" uploads and draws them
+  static void prepare_visible(indigo::igecs::WorldView* wv);
+  static void draw_prepared(indigo::igecs::WorldView* wv,
+                            const wgpu::Device& device,
+                            RenderUtil* render_util);
 };
 
 }  // namespace sanctify::render::solid_static
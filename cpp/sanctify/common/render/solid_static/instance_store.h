@@ -25,12 +25,12 @@ class InstanceKey {
 
   // InstanceBufferStore key type
   ReadonlyResourceRegistry<Geo>::Key geo_key() const;
-  std::string get_key() const;
+  uint32_t get_slot() const;
+  uint32_t get_generation() const;
   int get_lifetime() const;
 
  private:
   ReadonlyResourceRegistry<Geo>::Key geo_key_;
-  std::string str_key_;
 };
 
 typedef indigo::iggpu::InstanceBufferStore<InstanceKey, InstanceData>
@@ -17,9 +17,11 @@ FrameInputs Pipeline::create_frame_inputs(
 
   Vector<wgpu::BindGroupEntry> bind_group_entries(2);
   bind_group_entries.push_back(iggpu::buffer_bind_group_entry(
-      0, camera_common_vs_ubo.buffer(), camera_common_vs_ubo.size()));
+      0, camera_common_vs_ubo.buffer(), camera_common_vs_ubo.size(),
+      camera_common_vs_ubo.offset()));
   bind_group_entries.push_back(iggpu::buffer_bind_group_entry(
-      1, camera_common_fs_ubo.buffer(), camera_common_fs_ubo.size()));
+      1, camera_common_fs_ubo.buffer(), camera_common_fs_ubo.size(),
+      camera_common_fs_ubo.offset()));
 
   auto bind_group_desc = iggpu::bind_group_desc(
       bind_group_entries, per_frame_layout, "sold_static-frame-inputs-bg");
@@ -35,7 +37,8 @@ SceneInputs Pipeline::create_scene_inputs(
 
   core::Vector<wgpu::BindGroupEntry> bind_group_entries(1);
   bind_group_entries.push_back(iggpu::buffer_bind_group_entry(
-      0, common_lighting_ubo.buffer(), common_lighting_ubo.size()));
+      0, common_lighting_ubo.buffer(), common_lighting_ubo.size(),
+      common_lighting_ubo.offset()));
   auto bind_group_desc = iggpu::bind_group_desc(
       bind_group_entries, per_scene_layout, "sold_static-scene-inputs-bg");
 
@@ -50,11 +53,14 @@ PipelineBuilder PipelineBuilder::Create(
   return PipelineBuilder(
       iggpu::create_shader_module(device, vs_src.shader_source()),
       iggpu::create_shader_module(device, fs_src.shader_source()),
-      vs_src.entry_point(), fs_src.entry_point());
+      vs_src.entry_point(), fs_src.entry_point(),
+      iggpu::RenderPipelineCache::hash_source(vs_src.shader_source()),
+      iggpu::RenderPipelineCache::hash_source(fs_src.shader_source()));
 }
 
-Pipeline PipelineBuilder::create_pipeline(
-    const wgpu::Device& device, wgpu::TextureFormat output_format) const {
+iggpu::RenderPipelineCache::Pending PipelineBuilder::create_pipeline_async(
+    const wgpu::Device& device, iggpu::RenderPipelineCache* cache,
+    wgpu::TextureFormat output_format) const {
   wgpu::ColorTargetState color_target_state{};
   color_target_state.format = output_format;
 
@@ -130,19 +136,22 @@ Pipeline PipelineBuilder::create_pipeline(
   desc.primitive.cullMode = wgpu::CullMode::Back;
   desc.primitive.frontFace = wgpu::FrontFace::CCW;
 
-  auto gpu_pipeline = device.CreateRenderPipeline(&desc);
-
-  return Pipeline{output_format, gpu_pipeline};
+  uint64_t key =
+      iggpu::RenderPipelineCache::key_of(desc, vs_src_hash_, fs_src_hash_);
+  return cache->get_or_create_async(device, desc, key);
 }
 
 PipelineBuilder::PipelineBuilder(wgpu::ShaderModule vert_module,
                                  wgpu::ShaderModule frag_module,
                                  std::string vs_entry_point,
-                                 std::string fs_entry_point)
+                                 std::string fs_entry_point,
+                                 uint64_t vs_src_hash, uint64_t fs_src_hash)
     : vert_module_(vert_module),
       frag_module_(frag_module),
       vs_entry_point_(vs_entry_point),
-      fs_entry_point_(fs_entry_point) {}
+      fs_entry_point_(fs_entry_point),
+      vs_src_hash_(vs_src_hash),
+      fs_src_hash_(fs_src_hash) {}
 
 RenderUtil::RenderUtil(const wgpu::RenderPassEncoder* pass,
                        const Pipeline* pipeline)
@@ -175,8 +184,9 @@ RenderUtil& RenderUtil::set_geometry(const Geo& geo) {
 }
 
 RenderUtil& RenderUtil::set_instances(const wgpu::Buffer& buffer,
-                                      uint32_t num_instances) {
-  pass_->SetVertexBuffer(1, buffer);
+                                      uint32_t num_instances,
+                                      uint64_t offset) {
+  pass_->SetVertexBuffer(1, buffer, offset);
   num_instances_ = num_instances;
   return *this;
 }
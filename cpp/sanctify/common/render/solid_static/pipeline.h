@@ -5,6 +5,7 @@
 #include <igasset/proto/igasset.pb.h>
 #include <igasync/promise.h>
 #include <igcore/maybe.h>
+#include <iggpu/render_pipeline_cache.h>
 #include <webgpu/webgpu_cpp.h>
 
 #include "solid_static_geo.h"
@@ -39,10 +40,14 @@ class PipelineBuilder {
 
   PipelineBuilder(wgpu::ShaderModule vert_module,
                   wgpu::ShaderModule frag_module, std::string vs_entry_point,
-                  std::string fs_entry_point);
+                  std::string fs_entry_point, uint64_t vs_src_hash,
+                  uint64_t fs_src_hash);
 
-  Pipeline create_pipeline(const wgpu::Device& device,
-                           wgpu::TextureFormat output_format) const;
+  // Starts building (or finds in "cache") the pipeline for "output_format",
+  //  without waiting for it
+  indigo::iggpu::RenderPipelineCache::Pending create_pipeline_async(
+      const wgpu::Device& device, indigo::iggpu::RenderPipelineCache* cache,
+      wgpu::TextureFormat output_format) const;
 
  private:
   wgpu::ShaderModule vert_module_;
@@ -50,6 +55,10 @@ class PipelineBuilder {
 
   std::string vs_entry_point_;
   std::string fs_entry_point_;
+
+  // See RenderPipelineCache::key_of
+  uint64_t vs_src_hash_;
+  uint64_t fs_src_hash_;
 };
 
 // Utility used to actually submit draw calls, and make rendering a bit more
@@ -62,7 +71,8 @@ class RenderUtil {
   RenderUtil& set_scene_inputs(const SceneInputs& inputs);
   RenderUtil& set_frame_inputs(const FrameInputs& inputs);
   RenderUtil& set_geometry(const Geo& geo);
-  RenderUtil& set_instances(const wgpu::Buffer& buffer, uint32_t num_instances);
+  RenderUtil& set_instances(const wgpu::Buffer& buffer, uint32_t num_instances,
+                            uint64_t offset = 0u);
   RenderUtil& draw(bool* o_success = nullptr);
 
  private:
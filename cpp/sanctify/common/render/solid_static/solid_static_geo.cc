@@ -18,4 +18,5 @@ Geo::Geo(const wgpu::Device& device,
       indexBuffer(
           iggpu::buffer_from_data(device, indices, wgpu::BufferUsage::Index)),
       numIndices(indices.size()),
-      indexFormat(wgpu::IndexFormat::Uint32) {}
+      indexFormat(wgpu::IndexFormat::Uint32),
+      bounds(BoundingSphere::from_positions(vertices)) {}
@@ -2,6 +2,7 @@
 #define SANCTIFY_COMMON_RENDER_SOLID_STATIC_SOLID_STATIC_GEO_H
 
 #include <common/render/common/camera_ubos.h>
+#include <common/render/visibility/frustum_cull.h>
 #include <igasset/vertex_formats.h>
 #include <igcore/pod_vector.h>
 #include <webgpu/webgpu_cpp.h>
@@ -32,6 +33,9 @@ struct Geo {
   int32_t numIndices;
   wgpu::IndexFormat indexFormat;
 
+  // Model space bounds (from vertex positions)
+  BoundingSphere bounds;
+
   Geo(const wgpu::Device& device,
       const indigo::core::PodVector<indigo::asset::PositionNormalVertexData>&
           vertices,
@@ -0,0 +1,82 @@
+#include "terrain_chunk_selector.h"
+
+#include <algorithm>
+
+using namespace sanctify;
+using namespace render;
+
+using namespace indigo;
+using namespace core;
+
+TerrainChunkSelector::Params TerrainChunkSelector::default_params() {
+  return Params{{60.f, 110.f, 200.f}};
+}
+
+uint32_t TerrainChunkSelector::select_lod(const Params& params,
+                                          const TerrainChunkDesc& chunk,
+                                          const glm::vec3& camera_pos) {
+  if (chunk.lodCount == 0u) {
+    return 0u;
+  }
+
+  const glm::vec3 nearest =
+      glm::min(glm::max(camera_pos, chunk.boundsMin), chunk.boundsMax);
+  const glm::vec3 d = camera_pos - nearest;
+  const float dist_sq = glm::dot(d, d);
+
+  uint32_t lod = 0u;
+  while (lod + 1u < chunk.lodCount &&
+         dist_sq >= params.lodDistances[lod] * params.lodDistances[lod]) {
+    lod++;
+  }
+  return lod;
+}
+
+TerrainChunkSelector::TerrainChunkSelector(Params params)
+    : params_(params), stats_{} {}
+
+uint32_t TerrainChunkSelector::add_chunk(const TerrainChunkDesc& chunk) {
+  const uint32_t idx = chunk_count();
+  chunks_.push_back(chunk);
+
+  const glm::vec3 center = (chunk.boundsMin + chunk.boundsMax) * 0.5f;
+  center_x_.push_back(center.x);
+  center_y_.push_back(center.y);
+  center_z_.push_back(center.z);
+  radius_.push_back(glm::length(chunk.boundsMax - center));
+
+  visible_masks_.resize((chunk_count() + 31u) / 32u);
+  return idx;
+}
+
+void TerrainChunkSelector::select(const Frustum& frustum,
+                                  const glm::vec3& camera_pos) {
+  const uint32_t count = chunk_count();
+  selection_.resize(0);
+  stats_ = Stats{};
+
+  if (count == 0u) {
+    return;
+  }
+
+  FrustumCullKernel::cull(frustum, center_x_.raw(), center_y_.raw(),
+                          center_z_.raw(), radius_.raw(), count,
+                          visible_masks_.raw());
+
+  for (uint32_t i = 0; i < count; i++) {
+    if ((visible_masks_[i / 32u] & (1u << (i % 32u))) == 0u) {
+      stats_.culledChunks++;
+      continue;
+    }
+
+    const TerrainChunkDesc& chunk = chunks_[i];
+    const uint32_t lod = select_lod(params_, chunk, camera_pos);
+    selection_.push_back(Selection{i, lod});
+
+    stats_.visibleChunks++;
+    stats_.chunksPerLod[lod]++;
+    if (lod < chunk.lodCount) {
+      stats_.trianglesSubmitted += chunk.triangleCount[lod];
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#ifndef SANCTIFY_COMMON_RENDER_TERRAIN_TERRAIN_CHUNK_SELECTOR_H
+#define SANCTIFY_COMMON_RENDER_TERRAIN_TERRAIN_CHUNK_SELECTOR_H
+
+/**
+ * Per-frame terrain chunk selection - culls chunks (see igpack-gen
+ *  AssimpToTerrainChunksAction) against the camera frustum, and picks a level
+ *  of detail for each remaining chunk by the distance from the camera to the
+ *  nearest point of the chunk's bounds.
+ *
+ * No GPU or ECS types in here - TerrainLodSystem applies the picked LODs to
+ *  chunk renderables.
+ */
+
+#include <igcore/pod_vector.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "../visibility/frustum_cull.h"
+
+namespace sanctify::render {
+
+struct TerrainChunkDesc {
+  static constexpr uint32_t kMaxLods = 4u;
+
+  glm::vec3 boundsMin;
+  glm::vec3 boundsMax;
+
+  uint32_t lodCount;
+  uint32_t triangleCount[kMaxLods];
+};
+
+class TerrainChunkSelector {
+ public:
+  struct Params {
+    // Camera distance at which LOD i + 1 takes over from LOD i
+    float lodDistances[TerrainChunkDesc::kMaxLods - 1u];
+  };
+
+  struct Selection {
+    uint32_t chunkIdx;
+    uint32_t lod;
+  };
+
+  struct Stats {
+    uint32_t visibleChunks;
+    uint32_t culledChunks;
+    uint64_t trianglesSubmitted;
+
+    // Visible chunks drawn at each LOD
+    uint32_t chunksPerLod[TerrainChunkDesc::kMaxLods];
+  };
+
+  // Tuned against the PvE arena at the default camera zoom - chunks the
+  //  camera is looking at stay at full detail
+  static Params default_params();
+
+  static uint32_t select_lod(const Params& params,
+                             const TerrainChunkDesc& chunk,
+                             const glm::vec3& camera_pos);
+
+  TerrainChunkSelector(Params params = default_params());
+
+  uint32_t add_chunk(const TerrainChunkDesc& chunk);
+  uint32_t chunk_count() const {
+    return static_cast<uint32_t>(chunks_.size());
+  }
+  const TerrainChunkDesc& chunk(uint32_t idx) const { return chunks_[idx]; }
+
+  const Params& params() const { return params_; }
+  void set_params(const Params& params) { params_ = params; }
+
+  /** Visible chunks (in chunk order) and their LODs go to "selection" */
+  void select(const Frustum& frustum, const glm::vec3& camera_pos);
+
+  const indigo::core::PodVector<Selection>& selection() const {
+    return selection_;
+  }
+  const Stats& stats() const { return stats_; }
+
+ private:
+  Params params_;
+  indigo::core::PodVector<TerrainChunkDesc> chunks_;
+
+  // Bounding spheres of chunks_ (SoA, for FrustumCullKernel)
+  indigo::core::PodVector<float> center_x_;
+  indigo::core::PodVector<float> center_y_;
+  indigo::core::PodVector<float> center_z_;
+  indigo::core::PodVector<float> radius_;
+  indigo::core::PodVector<uint32_t> visible_masks_;
+
+  indigo::core::PodVector<Selection> selection_;
+  Stats stats_;
+};
+
+}  // namespace sanctify::render
+
+#endif
@@ -0,0 +1,131 @@
+#include "terrain_chunk_selector.h"
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace sanctify;
+using namespace render;
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+
+// Camera at (0, 0, 10) looking down -Z, 90 degree field of view
+Frustum test_frustum() {
+  glm::mat4 mat_view = glm::lookAt(glm::vec3(0.f, 0.f, 10.f),
+                                   glm::vec3(0.f, 0.f, 0.f),
+                                   glm::vec3(0.f, 1.f, 0.f));
+  glm::mat4 mat_proj =
+      glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f);
+  return Frustum::from_view_proj(mat_proj * mat_view);
+}
+
+// Flat 2x2 unit chunk centered on (x, 0, z), with LODs of 512/128/32 triangles
+TerrainChunkDesc chunk_at(float x, float z, uint32_t lod_count = 3u) {
+  TerrainChunkDesc chunk{};
+  chunk.boundsMin = glm::vec3(x - 1.f, 0.f, z - 1.f);
+  chunk.boundsMax = glm::vec3(x + 1.f, 0.f, z + 1.f);
+  chunk.lodCount = lod_count;
+  for (uint32_t i = 0; i < lod_count; i++) {
+    chunk.triangleCount[i] = 512u >> (2u * i);
+  }
+  return chunk;
+}
+
+TerrainChunkSelector::Params test_params() {
+  return TerrainChunkSelector::Params{{10.f, 20.f, 40.f}};
+}
+
+}  // namespace
+
+TEST(TerrainChunkSelector, LodByDistanceToNearestBoundsPoint) {
+  auto params = ::test_params();
+  auto chunk = ::chunk_at(0.f, 0.f);
+
+  // Inside (or right above) the chunk is always full detail
+  EXPECT_EQ(TerrainChunkSelector::select_lod(params, chunk,
+                                             glm::vec3(0.f, 5.f, 0.f)),
+            0u);
+
+  // 9 units from the chunk edge, not the center (which is 10 away)
+  EXPECT_EQ(TerrainChunkSelector::select_lod(params, chunk,
+                                             glm::vec3(10.f, 0.f, 0.f)),
+            0u);
+  EXPECT_EQ(TerrainChunkSelector::select_lod(params, chunk,
+                                             glm::vec3(12.f, 0.f, 0.f)),
+            1u);
+  EXPECT_EQ(TerrainChunkSelector::select_lod(params, chunk,
+                                             glm::vec3(0.f, 0.f, -25.f)),
+            2u);
+
+  // Past the last threshold, but there is no fourth LOD to pick
+  EXPECT_EQ(TerrainChunkSelector::select_lod(params, chunk,
+                                             glm::vec3(100.f, 0.f, 0.f)),
+            2u);
+}
+
+TEST(TerrainChunkSelector, SingleLodChunksNeverChange) {
+  auto params = ::test_params();
+  auto chunk = ::chunk_at(0.f, 0.f, 1u);
+
+  EXPECT_EQ(TerrainChunkSelector::select_lod(params, chunk,
+                                             glm::vec3(500.f, 0.f, 0.f)),
+            0u);
+}
+
+TEST(TerrainChunkSelector, CullsChunksOutsideFrustum) {
+  TerrainChunkSelector selector(::test_params());
+
+  uint32_t in_front = selector.add_chunk(::chunk_at(0.f, 0.f));
+  selector.add_chunk(::chunk_at(0.f, 30.f));  // Behind the camera
+  selector.add_chunk(::chunk_at(200.f, -5.f));  // Far off to the side
+  uint32_t far_ahead = selector.add_chunk(::chunk_at(0.f, -40.f));
+
+  selector.select(::test_frustum(), glm::vec3(0.f, 0.f, 10.f));
+
+  const auto& selection = selector.selection();
+  ASSERT_EQ(selection.size(), 2);
+  EXPECT_EQ(selection[0].chunkIdx, in_front);
+  EXPECT_EQ(selection[0].lod, 0u);
+  EXPECT_EQ(selection[1].chunkIdx, far_ahead);
+  EXPECT_EQ(selection[1].lod, 2u);
+
+  const auto& stats = selector.stats();
+  EXPECT_EQ(stats.visibleChunks, 2u);
+  EXPECT_EQ(stats.culledChunks, 2u);
+  EXPECT_EQ(stats.trianglesSubmitted, 512u + 32u);
+  EXPECT_EQ(stats.chunksPerLod[0], 1u);
+  EXPECT_EQ(stats.chunksPerLod[1], 0u);
+  EXPECT_EQ(stats.chunksPerLod[2], 1u);
+}
+
+TEST(TerrainChunkSelector, ManyChunksSubmitFewerTrianglesThanFullDetail) {
+  TerrainChunkSelector selector(::test_params());
+
+  // 40x40 grid of chunks around the camera - spans several cull mask words
+  uint64_t full_detail_triangles = 0u;
+  for (int z = -20; z < 20; z++) {
+    for (int x = -20; x < 20; x++) {
+      auto chunk = ::chunk_at(x * 2.f + 1.f, z * 2.f + 1.f);
+      full_detail_triangles += chunk.triangleCount[0];
+      selector.add_chunk(chunk);
+    }
+  }
+  ASSERT_EQ(selector.chunk_count(), 1600u);
+
+  selector.select(::test_frustum(), glm::vec3(0.f, 0.f, 10.f));
+
+  const auto& stats = selector.stats();
+  EXPECT_EQ(stats.visibleChunks + stats.culledChunks, 1600u);
+  EXPECT_GT(stats.visibleChunks, 0u);
+  EXPECT_GT(stats.culledChunks, 0u);
+  EXPECT_GT(stats.chunksPerLod[1] + stats.chunksPerLod[2], 0u);
+  EXPECT_LT(stats.trianglesSubmitted, full_detail_triangles);
+
+  // Re-selecting from the same spot gives the same answer
+  uint64_t first_triangles = stats.trianglesSubmitted;
+  selector.select(::test_frustum(), glm::vec3(0.f, 0.f, 10.f));
+  EXPECT_EQ(selector.stats().trianglesSubmitted, first_triangles);
+}
@@ -0,0 +1,67 @@
+#include "terrain_lod_system.h"
+
+#include <common/render/common/render_components.h>
+
+using namespace sanctify;
+using namespace render;
+
+using namespace indigo;
+using namespace core;
+
+entt::entity TerrainLodSystem::add_chunk(
+    igecs::WorldView* wv, const TerrainChunkDesc& chunk,
+    const solid_static::ReadonlyResourceRegistry<solid_static::Geo>::Key*
+        lod_geo_keys,
+    solid_static::InstanceData instance_data) {
+  auto& terrain = wv->mut_ctx_or_set<CtxTerrainChunks>();
+
+  entt::entity e = wv->create();
+  solid_static::EcsUtil::attach_renderable(wv, e, lod_geo_keys[0],
+                                           instance_data);
+
+  auto& chunk_component = wv->attach<TerrainChunkComponent>(e);
+  chunk_component.chunkIdx = terrain.selector.add_chunk(chunk);
+  for (uint32_t i = 0; i < chunk.lodCount && i < TerrainChunkDesc::kMaxLods;
+       i++) {
+    chunk_component.lodGeoKeys[i] = lod_geo_keys[i];
+  }
+  terrain.chunkEntities.push_back(e);
+
+  return e;
+}
+
+const igecs::WorldView::Decl& TerrainLodSystem::update_decl() {
+  static const igecs::WorldView::Decl kUpdateDecl =
+      igecs::WorldView::Decl()
+          .ctx_reads<CtxMainCameraCommonUbos>()
+          .ctx_writes<CtxTerrainChunks>()
+          .reads<TerrainChunkComponent>()
+          .writes<solid_static::RenderableComponent>();
+
+  return kUpdateDecl;
+}
+
+void TerrainLodSystem::update(igecs::WorldView* wv) {
+  if (!wv->ctx_has<CtxTerrainChunks>()) {
+    return;
+  }
+
+  const auto& ubos = wv->ctx<CtxMainCameraCommonUbos>();
+  const auto& vs_params = ubos.cameraVsUbo.get_immutable();
+  const glm::vec3 camera_pos = ubos.cameraFsUbo.get_immutable().cameraPos;
+
+  auto& terrain = wv->mut_ctx<CtxTerrainChunks>();
+  terrain.selector.select(
+      Frustum::from_view_proj(vs_params.matProj * vs_params.matView),
+      camera_pos);
+
+  // Culled chunks keep whatever LOD they last had - VisibilitySystem skips
+  //  them anyways, and they get a fresh one as soon as they come into view
+  const auto& selection = terrain.selector.selection();
+  for (int i = 0; i < selection.size(); i++) {
+    entt::entity e = terrain.chunkEntities[selection[i].chunkIdx];
+    const auto& chunk = wv->read<TerrainChunkComponent>(e);
+    wv->write<solid_static::RenderableComponent>(e).geoKey =
+        chunk.lodGeoKeys[selection[i].lod];
+  }
+}
@@ -0,0 +1,49 @@
+#ifndef SANCTIFY_COMMON_RENDER_TERRAIN_TERRAIN_LOD_SYSTEM_H
+#define SANCTIFY_COMMON_RENDER_TERRAIN_TERRAIN_LOD_SYSTEM_H
+
+#include <common/render/solid_static/ecs_util.h>
+#include <igcore/pod_vector.h>
+#include <igecs/world_view.h>
+
+#include "terrain_chunk_selector.h"
+
+/**
+ * Swaps the geometry of terrain chunk renderables to the LOD picked by
+ *  TerrainChunkSelector for the main camera. Chunks are regular solid static
+ *  renderables otherwise - VisibilitySystem culls them like anything else.
+ */
+
+namespace sanctify::render {
+
+struct TerrainChunkComponent {
+  uint32_t chunkIdx;
+  solid_static::ReadonlyResourceRegistry<solid_static::Geo>::Key
+      lodGeoKeys[TerrainChunkDesc::kMaxLods];
+};
+
+struct CtxTerrainChunks {
+  TerrainChunkSelector selector;
+
+  // Indexed by chunk index of "selector"
+  indigo::core::PodVector<entt::entity> chunkEntities;
+};
+
+class TerrainLodSystem {
+ public:
+  /**
+   * Create a renderable for a chunk, starting at full detail. "lod_geo_keys"
+   *  must have one registered geo per LOD of "chunk".
+   */
+  static entt::entity add_chunk(
+      indigo::igecs::WorldView* wv, const TerrainChunkDesc& chunk,
+      const solid_static::ReadonlyResourceRegistry<solid_static::Geo>::Key*
+          lod_geo_keys,
+      solid_static::InstanceData instance_data);
+
+  static const indigo::igecs::WorldView::Decl& update_decl();
+  static void update(indigo::igecs::WorldView* wv);
+};
+
+}  // namespace sanctify::render
+
+#endif
@@ -19,57 +19,99 @@ EcsUtil::create_ctx_pipeline(
     asset::IgpackLoader::ExtractWgslShaderPromiseT vs_src_promise,
     asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
     std::shared_ptr<TaskList> main_thread_task_list) {
+  typedef std::shared_ptr<Promise<Maybe<PipelineBuildError>>> BuildPromiseT;
+
   auto combiner = PromiseCombiner::Create();
 
   auto vs_key = combiner->add(vs_src_promise, main_thread_task_list);
   auto fs_key = combiner->add(fs_src_promise, main_thread_task_list);
 
-  return combiner->combine<Maybe<PipelineBuildError>>(
-      [vs_key, fs_key, device,
-       world](const PromiseCombiner::PromiseCombinerResult& rsl)
-          -> Maybe<PipelineBuildError> {
-        const auto& vs_rsl = rsl.get(vs_key);
-        const auto& fs_rsl = rsl.get(fs_key);
-
-        if (vs_rsl.is_right()) {
-          Logger::err(kLogLabel) << "Failed to load vertex shader: "
-                                 << asset::to_string(vs_rsl.get_right());
-          return PipelineBuildError::VsLoadError;
-        }
-        if (fs_rsl.is_right()) {
-          Logger::err(kLogLabel) << "Failed to load fragment shader: "
-                                 << asset::to_string(fs_rsl.get_right());
-          return PipelineBuildError::FsLoadError;
-        }
-
-        auto pipeline_builder = iggpu::PipelineBuilder::Create(
-            device, vs_rsl.get_left(), fs_rsl.get_left());
-
-        // TODO (sessamekesh): Everything above here can be made a general
-        //  promise for PipelineBuilder construction, nothing unique so far.
-
-        wgpu::TextureFormat swap_chain_format =
-            world->ctx<CtxPlatformObjects>().swapChainFormat;
-
-        auto pipeline =
-            Pipeline::FromBuilder(device, pipeline_builder, swap_chain_format);
-
-        world->set<CtxPipeline>(std::move(pipeline_builder),
-                                std::move(pipeline));
-
-        return empty_maybe{};
-      },
-      main_thread_task_list);
+  return combiner
+      ->combine<BuildPromiseT>(
+          [vs_key, fs_key, device, world, main_thread_task_list](
+              const PromiseCombiner::PromiseCombinerResult& rsl)
+              -> BuildPromiseT {
+            const auto& vs_rsl = rsl.get(vs_key);
+            const auto& fs_rsl = rsl.get(fs_key);
+
+            if (vs_rsl.is_right()) {
+              Logger::err(kLogLabel) << "Failed to load vertex shader: "
+                                     << asset::to_string(vs_rsl.get_right());
+              return Promise<Maybe<PipelineBuildError>>::immediate(
+                  PipelineBuildError::VsLoadError);
+            }
+            if (fs_rsl.is_right()) {
+              Logger::err(kLogLabel) << "Failed to load fragment shader: "
+                                     << asset::to_string(fs_rsl.get_right());
+              return Promise<Maybe<PipelineBuildError>>::immediate(
+                  PipelineBuildError::FsLoadError);
+            }
+
+            auto pipeline_builder = iggpu::PipelineBuilder::Create(
+                device, vs_rsl.get_left(), fs_rsl.get_left());
+
+            // TODO (sessamekesh): Everything above here can be made a general
+            //  promise for PipelineBuilder construction, nothing unique so far.
+
+            const auto& platform_objects = world->ctx<CtxPlatformObjects>();
+            wgpu::TextureFormat swap_chain_format =
+                platform_objects.swapChainFormat;
+
+            auto pending = Pipeline::FromBuilderAsync(
+                device, platform_objects.pipelineCache.get(), pipeline_builder,
+                swap_chain_format);
+
+            world->set<CtxPipeline>(std::move(pipeline_builder),
+                                    Pipeline{swap_chain_format, nullptr},
+                                    platform_objects.pipelineCache,
+                                    pending.key);
+
+            return pending.promise->then<Maybe<PipelineBuildError>>(
+                [world, swap_chain_format](
+                    const wgpu::RenderPipeline& gpu_pipeline)
+                    -> Maybe<PipelineBuildError> {
+                  if (!gpu_pipeline) {
+                    return PipelineBuildError::PipelineBuildError;
+                  }
+
+                  // The swap chain format may have changed while building -
+                  //  update_pipeline picks up the right one in that case
+                  auto& pipeline_ctx = world->ctx<CtxPipeline>();
+                  if (pipeline_ctx.currentPipeline.outputFormat ==
+                      swap_chain_format) {
+                    pipeline_ctx.currentPipeline.pipeline = gpu_pipeline;
+                  }
+                  return empty_maybe{};
+                },
+                main_thread_task_list);
+          },
+          main_thread_task_list)
+      ->then_chain<Maybe<PipelineBuildError>>(
+          [](const BuildPromiseT& build_promise) { return build_promise; },
+          main_thread_task_list);
 }
 
 void EcsUtil::update_pipeline(indigo::igecs::WorldView* wv) {
   const auto& platform_objects = wv->ctx<CtxPlatformObjects>();
   auto& pipeline_ctx = wv->mut_ctx<CtxPipeline>();
 
+  // Never rebuild in the middle of a frame - request the new format, and skip
+  //  tonemapping until it is ready
   if (pipeline_ctx.currentPipeline.outputFormat !=
       platform_objects.swapChainFormat) {
+    auto pending = Pipeline::FromBuilderAsync(
+        platform_objects.device, pipeline_ctx.pipelineCache.get(),
+        pipeline_ctx.builder, platform_objects.swapChainFormat);
     pipeline_ctx.currentPipeline =
-        Pipeline::FromBuilder(platform_objects.device, pipeline_ctx.builder,
-                              platform_objects.swapChainFormat);
+        Pipeline{platform_objects.swapChainFormat, nullptr};
+    pipeline_ctx.pendingKey = pending.key;
+  }
+
+  if (!pipeline_ctx.currentPipeline.pipeline) {
+    auto ready =
+        pipeline_ctx.pipelineCache->get_if_ready(pipeline_ctx.pendingKey);
+    if (ready.has_value()) {
+      pipeline_ctx.currentPipeline.pipeline = ready.get();
+    }
   }
 }
@@ -13,12 +13,19 @@ namespace sanctify::render::tonemap {
 
 struct CtxPipeline {
   indigo::iggpu::PipelineBuilder builder;
+
+  // Null while the pipeline for its output format is still being built
   Pipeline currentPipeline;
+
+  std::shared_ptr<indigo::iggpu::RenderPipelineCache> pipelineCache;
+  uint64_t pendingKey;
 };
 
 /** Utility methods for dealing with Tonemap rendering */
 struct EcsUtil {
-  // Pipeline creation and fetching
+  // Pipeline creation and fetching - the pipeline is built asynchronously
+  //  through CtxPlatformObjects::pipelineCache, the returned promise resolves
+  //  once it is ready
   static std::shared_ptr<
       indigo::core::Promise<indigo::core::Maybe<PipelineBuildError>>>
   create_ctx_pipeline(
@@ -27,6 +34,9 @@ struct EcsUtil {
       indigo::asset::IgpackLoader::ExtractWgslShaderPromiseT fs_src_promise,
       std::shared_ptr<indigo::core::TaskList> main_thread_task_list);
 
+
+  // Re-requests the pipeline if the swap chain format changed - it is left
+  //  null (and tonemapping should be skipped) until the new one is built
   static void update_pipeline(indigo::igecs::WorldView* wv);
 };
 
@@ -53,9 +53,10 @@ HdrTextureInputs Pipeline::create_hdr_texture_inputs(
   return HdrTextureInputs{device.CreateBindGroup(&desc)};
 }
 
-Pipeline Pipeline::FromBuilder(const wgpu::Device& device,
-                               const iggpu::PipelineBuilder& pipeline_builder,
-                               wgpu::TextureFormat output_format) {
+iggpu::RenderPipelineCache::Pending Pipeline::FromBuilderAsync(
+    const wgpu::Device& device, iggpu::RenderPipelineCache* cache,
+    const iggpu::PipelineBuilder& pipeline_builder,
+    wgpu::TextureFormat output_format) {
   wgpu::ColorTargetState color_target_state{};
   color_target_state.format = output_format;
 
@@ -73,9 +74,9 @@ Pipeline Pipeline::FromBuilder(const wgpu::Device& device,
   desc.primitive.cullMode = wgpu::CullMode::None;
   desc.primitive.frontFace = wgpu::FrontFace::CCW;
 
-  auto gpu_pipeline = device.CreateRenderPipeline(&desc);
-
-  return Pipeline{output_format, gpu_pipeline};
+  uint64_t key = iggpu::RenderPipelineCache::key_of(
+      desc, pipeline_builder.vsSourceHash, pipeline_builder.fsSourceHash);
+  return cache->get_or_create_async(device, desc, key);
 }
 
 RenderUtil::RenderUtil(const wgpu::RenderPassEncoder* pass,
@@ -3,6 +3,7 @@
 
 #include <igasset/proto/igasset.pb.h>
 #include <iggpu/pipeline_builder.h>
+#include <iggpu/render_pipeline_cache.h>
 #include <iggpu/texture.h>
 #include <iggpu/ubo_base.h>
 
@@ -29,8 +30,10 @@ struct Pipeline {
   wgpu::TextureFormat outputFormat;
   wgpu::RenderPipeline pipeline;
 
-  static Pipeline FromBuilder(
-      const wgpu::Device& device,
+  // Starts building (or finds in "cache") the pipeline for "output_format",
+  //  without waiting for it
+  static indigo::iggpu::RenderPipelineCache::Pending FromBuilderAsync(
+      const wgpu::Device& device, indigo::iggpu::RenderPipelineCache* cache,
       const indigo::iggpu::PipelineBuilder& pipeline_builder,
       wgpu::TextureFormat output_format);
 
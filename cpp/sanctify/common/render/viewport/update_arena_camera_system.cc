@@ -11,6 +11,11 @@ using namespace indigo;
 
 namespace {
 
+// TODO (sessamekesh): Pass in configuration state...
+const float kEdgePanSpeed = 10.f;
+const float kEdgePanThresholdX = 0.2f;
+const float kEdgePanThresholdY = 0.2f;
+
 struct CtxPerspectiveParams {
   float lastAspectRatio;
 };
@@ -65,16 +70,10 @@ void UpdateArenaCameraSystem::update(indigo::igecs::WorldView* wv) {
   auto& updates = wv->mut_ctx<CtxArenaCameraInputs>();
 
   float aspect_ratio = (float)vp_width / (float)vp_height;
-  if (updates.lookAtAdjustment != glm::vec3(0.f, 0.f, 0.f) ||
-      updates.radiusAdjustment != 0.f ||
+  bool camera_moved = apply_inputs(camera, updates);
+  if (camera_moved ||
       ubos.cameraVsUbo.get_immutable().matView[3][3] == 0.f ||
       aspect_ratio != ctx_perspective.lastAspectRatio) {
-    camera.set_radius(camera.radius() + updates.radiusAdjustment);
-    camera.set_look_at(camera.look_at() + updates.lookAtAdjustment);
-
-    updates.lookAtAdjustment = glm::vec3(0.f, 0.f, 0.f);
-    updates.radiusAdjustment = 0.f;
-
     auto& vs_params = ubos.cameraVsUbo.get_mutable();
     auto& fs_params = ubos.cameraFsUbo.get_mutable();
 
@@ -87,7 +86,51 @@ void UpdateArenaCameraSystem::update(indigo::igecs::WorldView* wv) {
     ctx_perspective.lastAspectRatio = aspect_ratio;
   }
 
-  ubos.lightingUbo.sync(platform.device);
-  ubos.cameraFsUbo.sync(platform.device);
-  ubos.cameraVsUbo.sync(platform.device);
+  ubos.staging->flush(platform.device);
+}
+
+glm::vec3 UpdateArenaCameraSystem::edge_pan(const logic::ArenaCamera& camera,
+                                            glm::vec2 screen_pct, float dt) {
+  glm::vec3 adjustment(0.f, 0.f, 0.f);
+  float xpct = screen_pct.x;
+  float ypct = screen_pct.y;
+
+  // TODO (sessamekesh): Adjust these formulas to be correct!
+  if (xpct < ::kEdgePanThresholdX) {
+    float scroll_strength = glm::sqrt(1.f - (xpct / ::kEdgePanThresholdX));
+    adjustment +=
+        camera.screen_right() * ::kEdgePanSpeed * dt * scroll_strength;
+  } else if (xpct > (1.f - ::kEdgePanThresholdX)) {
+    float scroll_strength =
+        glm::sqrt((xpct - (1.f - ::kEdgePanThresholdX)) / ::kEdgePanThresholdX);
+    adjustment -=
+        camera.screen_right() * ::kEdgePanSpeed * dt * scroll_strength;
+  }
+
+  if (ypct < ::kEdgePanThresholdY) {
+    float scroll_strength = glm::sqrt(1.f - (ypct / ::kEdgePanThresholdY));
+    adjustment += camera.screen_up() * ::kEdgePanSpeed * dt * scroll_strength;
+  } else if (ypct > (1.f - ::kEdgePanThresholdY)) {
+    float scroll_strength =
+        glm::sqrt((ypct - (1.f - ::kEdgePanThresholdY)) / ::kEdgePanThresholdY);
+    adjustment -= camera.screen_up() * ::kEdgePanSpeed * dt * scroll_strength;
+  }
+
+  return adjustment;
+}
+
+bool UpdateArenaCameraSystem::apply_inputs(logic::ArenaCamera& camera,
+                                           CtxArenaCameraInputs& inputs) {
+  if (inputs.lookAtAdjustment == glm::vec3(0.f, 0.f, 0.f) &&
+      inputs.radiusAdjustment == 0.f) {
+    return false;
+  }
+
+  camera.set_radius(camera.radius() + inputs.radiusAdjustment);
+  camera.set_look_at(camera.look_at() + inputs.lookAtAdjustment);
+
+  inputs.lookAtAdjustment = glm::vec3(0.f, 0.f, 0.f);
+  inputs.radiusAdjustment = 0.f;
+
+  return true;
 }
@@ -31,6 +31,21 @@ class UpdateArenaCameraSystem {
   static const indigo::igecs::WorldView::Decl& update_decl();
 
   static void update(indigo::igecs::WorldView* wv);
+
+  /**
+   * Look-at adjustment for panning the camera over "dt" seconds with the mouse
+   *  at "screen_pct" (0-1 across the viewport) - zero unless the mouse is near
+   *  the edge of the screen. Input systems should add this to
+   *  CtxArenaCameraInputs once per frame; adjustments are held until the
+   *  camera applies them, so frames that do not update the camera lose
+   *  nothing.
+   */
+  static glm::vec3 edge_pan(const logic::ArenaCamera& camera,
+                            glm::vec2 screen_pct, float dt);
+
+  /** Apply (and clear) pending camera inputs - true if the camera moved */
+  static bool apply_inputs(logic::ArenaCamera& camera,
+                           CtxArenaCameraInputs& inputs);
 };
 
 }  // namespace sanctify::render
@@ -0,0 +1,67 @@
+#include "update_arena_camera_system.h"
+
+#include <gtest/gtest.h>
+
+using namespace sanctify;
+using namespace render;
+
+namespace {
+logic::ArenaCamera test_camera() {
+  return logic::ArenaCamera(glm::vec3(0.f, 0.f, 0.f), glm::radians(30.f), 0.f,
+                            20.f);
+}
+
+// Mouse held against the left edge of the screen for "seconds", with input
+//  and the camera update both running once per frame
+float pan_distance(float fps, float seconds) {
+  logic::ArenaCamera camera = ::test_camera();
+  CtxArenaCameraInputs inputs{glm::vec3(0.f, 0.f, 0.f), 0.f};
+
+  const float dt = 1.f / fps;
+  const uint32_t frame_count = static_cast<uint32_t>(seconds * fps + 0.5f);
+  for (uint32_t i = 0; i < frame_count; i++) {
+    inputs.lookAtAdjustment += UpdateArenaCameraSystem::edge_pan(
+        camera, glm::vec2(0.05f, 0.5f), dt);
+    UpdateArenaCameraSystem::apply_inputs(camera, inputs);
+  }
+
+  return glm::length(camera.look_at());
+}
+}  // namespace
+
+TEST(UpdateArenaCameraSystem, EdgePanDistanceIsFrameRateIndependent) {
+  float pan_30 = ::pan_distance(30.f, 2.f);
+  float pan_60 = ::pan_distance(60.f, 2.f);
+  float pan_144 = ::pan_distance(144.f, 2.f);
+
+  EXPECT_GT(pan_30, 1.f);
+  EXPECT_NEAR(pan_30, pan_60, 0.001f);
+  EXPECT_NEAR(pan_30, pan_144, 0.001f);
+}
+
+TEST(UpdateArenaCameraSystem, EdgePanIsZeroAwayFromScreenEdges) {
+  logic::ArenaCamera camera = ::test_camera();
+
+  glm::vec3 adjustment = UpdateArenaCameraSystem::edge_pan(
+      camera, glm::vec2(0.5f, 0.5f), 1.f / 60.f);
+
+  EXPECT_EQ(adjustment, glm::vec3(0.f, 0.f, 0.f));
+}
+
+TEST(UpdateArenaCameraSystem, HoldsInputsUntilCameraApplies) {
+  logic::ArenaCamera camera = ::test_camera();
+  CtxArenaCameraInputs inputs{glm::vec3(0.f, 0.f, 0.f), 0.f};
+
+  // Two input frames, only one camera update
+  glm::vec3 frame_pan =
+      UpdateArenaCameraSystem::edge_pan(camera, glm::vec2(0.05f, 0.5f), 0.1f);
+  inputs.lookAtAdjustment += frame_pan;
+  inputs.lookAtAdjustment += frame_pan;
+
+  EXPECT_TRUE(UpdateArenaCameraSystem::apply_inputs(camera, inputs));
+  EXPECT_NEAR(glm::length(camera.look_at()), 2.f * glm::length(frame_pan),
+              0.0001f);
+  EXPECT_EQ(inputs.lookAtAdjustment, glm::vec3(0.f, 0.f, 0.f));
+
+  EXPECT_FALSE(UpdateArenaCameraSystem::apply_inputs(camera, inputs));
+}
@@ -0,0 +1,250 @@
+#include "frustum_cull.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(IG_ENABLE_SIMD) && defined(__AVX2__)
+#define SANCTIFY_FRUSTUM_CULL_AVX2
+#include <immintrin.h>
+#elif defined(IG_ENABLE_SIMD) &&                      \
+    (defined(__SSE2__) || defined(_M_X64) ||          \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SANCTIFY_FRUSTUM_CULL_SSE2
+#include <emmintrin.h>
+#elif defined(IG_ENABLE_SIMD) && defined(__wasm_simd128__)
+#define SANCTIFY_FRUSTUM_CULL_WASM_SIMD
+#include <wasm_simd128.h>
+#endif
+
+using namespace sanctify;
+using namespace render;
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+
+bool sphere_visible(const Frustum& frustum, float x, float y, float z,
+                    float r) {
+  for (int i = 0; i < 6; i++) {
+    const glm::vec4& p = frustum.planes[i];
+    if (p.x * x + p.y * y + p.z * z + p.w < -r) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void clear_masks(uint32_t count, uint32_t* visible_masks) {
+  std::memset(visible_masks, 0x00, ((count + 31u) / 32u) * sizeof(uint32_t));
+}
+
+//
+// Per-instruction set wrappers (see locomotion_kernel.cc for the pattern)
+//
+#if defined(SANCTIFY_FRUSTUM_CULL_AVX2)
+struct SimdOps {
+  using F = __m256;
+  static constexpr uint32_t kWidth = 8u;
+
+  static F load(const float* p) { return _mm256_loadu_ps(p); }
+  static F set1(float v) { return _mm256_set1_ps(v); }
+  static F add(F a, F b) { return _mm256_add_ps(a, b); }
+  static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+  static F neg(F a) { return _mm256_xor_ps(a, set1(-0.f)); }
+  static F and_bits(F a, F b) { return _mm256_and_ps(a, b); }
+  static F greater_equal(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+  static uint32_t mask_bits(F mask) {
+    return static_cast<uint32_t>(_mm256_movemask_ps(mask));
+  }
+};
+#elif defined(SANCTIFY_FRUSTUM_CULL_SSE2)
+struct SimdOps {
+  using F = __m128;
+  static constexpr uint32_t kWidth = 4u;
+
+  static F load(const float* p) { return _mm_loadu_ps(p); }
+  static F set1(float v) { return _mm_set1_ps(v); }
+  static F add(F a, F b) { return _mm_add_ps(a, b); }
+  static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+  static F neg(F a) { return _mm_xor_ps(a, set1(-0.f)); }
+  static F and_bits(F a, F b) { return _mm_and_ps(a, b); }
+  static F greater_equal(F a, F b) { return _mm_cmpge_ps(a, b); }
+  static uint32_t mask_bits(F mask) {
+    return static_cast<uint32_t>(_mm_movemask_ps(mask));
+  }
+};
+#elif defined(SANCTIFY_FRUSTUM_CULL_WASM_SIMD)
+struct SimdOps {
+  using F = v128_t;
+  static constexpr uint32_t kWidth = 4u;
+
+  static F load(const float* p) { return wasm_v128_load(p); }
+  static F set1(float v) { return wasm_f32x4_splat(v); }
+  static F add(F a, F b) { return wasm_f32x4_add(a, b); }
+  static F mul(F a, F b) { return wasm_f32x4_mul(a, b); }
+  static F neg(F a) { return wasm_f32x4_neg(a); }
+  static F and_bits(F a, F b) { return wasm_v128_and(a, b); }
+  static F greater_equal(F a, F b) { return wasm_f32x4_ge(a, b); }
+  static uint32_t mask_bits(F mask) {
+    return static_cast<uint32_t>(wasm_i32x4_bitmask(mask));
+  }
+};
+#endif
+
+#if defined(SANCTIFY_FRUSTUM_CULL_AVX2) ||  \
+    defined(SANCTIFY_FRUSTUM_CULL_SSE2) || \
+    defined(SANCTIFY_FRUSTUM_CULL_WASM_SIMD)
+#define SANCTIFY_FRUSTUM_CULL_HAS_SIMD
+
+using F = SimdOps::F;
+
+// 32 is a multiple of every lane width, so a batch never straddles two words
+static_assert(32u % SimdOps::kWidth == 0u);
+
+F plane_distance(const glm::vec4& plane, F x, F y, F z) {
+  return SimdOps::add(
+      SimdOps::add(SimdOps::mul(SimdOps::set1(plane.x), x),
+                   SimdOps::mul(SimdOps::set1(plane.y), y)),
+      SimdOps::add(SimdOps::mul(SimdOps::set1(plane.z), z),
+                   SimdOps::set1(plane.w)));
+}
+#endif
+
+}  // namespace
+
+BoundingSphere BoundingSphere::from_positions(
+    const PodVector<asset::PositionNormalVertexData>& vertices) {
+  if (vertices.size() == 0) {
+    return BoundingSphere{glm::vec3(0.f), 0.f};
+  }
+
+  glm::vec3 min_pos = vertices[0].Position;
+  glm::vec3 max_pos = vertices[0].Position;
+  for (int i = 1; i < vertices.size(); i++) {
+    min_pos = glm::min(min_pos, vertices[i].Position);
+    max_pos = glm::max(max_pos, vertices[i].Position);
+  }
+
+  const glm::vec3 center = (min_pos + max_pos) * 0.5f;
+  float radius_sq = 0.f;
+  for (int i = 0; i < vertices.size(); i++) {
+    glm::vec3 d = vertices[i].Position - center;
+    radius_sq = std::max(radius_sq, glm::dot(d, d));
+  }
+
+  return BoundingSphere{center, std::sqrt(radius_sq)};
+}
+
+BoundingSphere BoundingSphere::transformed(const glm::mat4& mat_world) const {
+  const float max_scale_sq =
+      std::max({glm::dot(glm::vec3(mat_world[0]), glm::vec3(mat_world[0])),
+                glm::dot(glm::vec3(mat_world[1]), glm::vec3(mat_world[1])),
+                glm::dot(glm::vec3(mat_world[2]), glm::vec3(mat_world[2]))});
+
+  return BoundingSphere{glm::vec3(mat_world * glm::vec4(center, 1.f)),
+                        radius * std::sqrt(max_scale_sq)};
+}
+
+Frustum Frustum::from_view_proj(const glm::mat4& m) {
+  // Rows of the (column major) matrix - Gribb/Hartmann plane extraction
+  const glm::vec4 r0(m[0][0], m[1][0], m[2][0], m[3][0]);
+  const glm::vec4 r1(m[0][1], m[1][1], m[2][1], m[3][1]);
+  const glm::vec4 r2(m[0][2], m[1][2], m[2][2], m[3][2]);
+  const glm::vec4 r3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+  Frustum frustum{};
+  frustum.planes[0] = r3 + r0;  // left
+  frustum.planes[1] = r3 - r0;  // right
+  frustum.planes[2] = r3 + r1;  // bottom
+  frustum.planes[3] = r3 - r1;  // top
+  frustum.planes[4] = r3 + r2;  // near
+  frustum.planes[5] = r3 - r2;  // far
+
+  for (int i = 0; i < 6; i++) {
+    float len = glm::length(glm::vec3(frustum.planes[i]));
+    if (len > 0.f) {
+      frustum.planes[i] /= len;
+    }
+  }
+
+  return frustum;
+}
+
+bool Frustum::test_sphere(const BoundingSphere& sphere) const {
+  return ::sphere_visible(*this, sphere.center.x, sphere.center.y,
+                          sphere.center.z, sphere.radius);
+}
+
+const char* FrustumCullKernel::instruction_set() {
+#if defined(SANCTIFY_FRUSTUM_CULL_AVX2)
+  return "avx2";
+#elif defined(SANCTIFY_FRUSTUM_CULL_SSE2)
+  return "sse2";
+#elif defined(SANCTIFY_FRUSTUM_CULL_WASM_SIMD)
+  return "wasm-simd128";
+#else
+  return "scalar";
+#endif
+}
+
+uint32_t FrustumCullKernel::lane_width() {
+#ifdef SANCTIFY_FRUSTUM_CULL_HAS_SIMD
+  return SimdOps::kWidth;
+#else
+  return 1u;
+#endif
+}
+
+void FrustumCullKernel::cull(const Frustum& frustum, const float* center_x,
+                             const float* center_y, const float* center_z,
+                             const float* radius, uint32_t count,
+                             uint32_t* visible_masks) {
+#ifdef SANCTIFY_FRUSTUM_CULL_HAS_SIMD
+  ::clear_masks(count, visible_masks);
+
+  uint32_t i = 0u;
+  for (; i + SimdOps::kWidth <= count; i += SimdOps::kWidth) {
+    F x = SimdOps::load(center_x + i);
+    F y = SimdOps::load(center_y + i);
+    F z = SimdOps::load(center_z + i);
+    F neg_r = SimdOps::neg(SimdOps::load(radius + i));
+
+    F visible = SimdOps::greater_equal(
+        ::plane_distance(frustum.planes[0], x, y, z), neg_r);
+    for (int p = 1; p < 6; p++) {
+      visible = SimdOps::and_bits(
+          visible, SimdOps::greater_equal(
+                       ::plane_distance(frustum.planes[p], x, y, z), neg_r));
+    }
+
+    visible_masks[i / 32u] |= SimdOps::mask_bits(visible) << (i % 32u);
+  }
+
+  for (; i < count; i++) {
+    if (::sphere_visible(frustum, center_x[i], center_y[i], center_z[i],
+                         radius[i])) {
+      visible_masks[i / 32u] |= 1u << (i % 32u);
+    }
+  }
+#else
+  cull_scalar(frustum, center_x, center_y, center_z, radius, count,
+              visible_masks);
+#endif
+}
+
+void FrustumCullKernel::cull_scalar(const Frustum& frustum,
+                                    const float* center_x,
+                                    const float* center_y,
+                                    const float* center_z, const float* radius,
+                                    uint32_t count, uint32_t* visible_masks) {
+  ::clear_masks(count, visible_masks);
+
+  for (uint32_t i = 0u; i < count; i++) {
+    if (::sphere_visible(frustum, center_x[i], center_y[i], center_z[i],
+                         radius[i])) {
+      visible_masks[i / 32u] |= 1u << (i % 32u);
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#ifndef SANCTIFY_COMMON_RENDER_VISIBILITY_FRUSTUM_CULL_H
+#define SANCTIFY_COMMON_RENDER_VISIBILITY_FRUSTUM_CULL_H
+
+/**
+ * Bounding spheres, view frustums, and a batched (SoA) sphere/frustum test.
+ *
+ * The instruction set of the batched test is picked at compile time in the
+ *  same way as the locomotion kernel - AVX2 (8 lanes), SSE2 (4 lanes), WASM
+ *  SIMD128 (4 lanes) or a plain scalar loop. See IG_ENABLE_SIMD /
+ *  IG_ENABLE_AVX2 in the root CMakeLists.txt.
+ *
+ * No GPU or ECS types in here, so it can be shared by every renderer.
+ */
+
+#include <igasset/vertex_formats.h>
+#include <igcore/pod_vector.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace sanctify::render {
+
+struct BoundingSphere {
+  glm::vec3 center;
+  float radius;
+
+  /** Sphere around the bounding box of a set of vertex positions */
+  static BoundingSphere from_positions(
+      const indigo::core::PodVector<indigo::asset::PositionNormalVertexData>&
+          vertices);
+
+  /**
+   * Sphere that contains this one after transformation by "mat_world" -
+   *  non-uniform scale grows the radius by the largest axis scale
+   */
+  BoundingSphere transformed(const glm::mat4& mat_world) const;
+};
+
+/**
+ * Six normalized planes (xyz = inward facing normal, w = distance), extracted
+ *  from a view-projection matrix with an OpenGL style [-1, 1] depth range (the
+ *  glm::perspective default)
+ */
+struct Frustum {
+  glm::vec4 planes[6];
+
+  static Frustum from_view_proj(const glm::mat4& mat_view_proj);
+
+  /** True if any part of the sphere may be inside the frustum */
+  bool test_sphere(const BoundingSphere& sphere) const;
+};
+
+class FrustumCullKernel {
+ public:
+  /**
+   * Instruction set compiled into "cull" - one of "avx2", "sse2",
+   *  "wasm-simd128" or "scalar"
+   */
+  static const char* instruction_set();
+
+  /** Number of spheres tested per vector instruction */
+  static uint32_t lane_width();
+
+  /**
+   * Test "count" spheres (SoA center + radius arrays) against the frustum,
+   *  setting bit (i % 32) of visible_masks[i / 32] for every sphere that may
+   *  be visible. visible_masks must hold (count + 31) / 32 words - they are
+   *  overwritten, not OR'd into.
+   *
+   * Callers splitting work between threads should split on multiples of 32
+   *  spheres, so that no two threads write the same mask word.
+   */
+  static void cull(const Frustum& frustum, const float* center_x,
+                   const float* center_y, const float* center_z,
+                   const float* radius, uint32_t count,
+                   uint32_t* visible_masks);
+
+  /** Scalar reference implementation of "cull" */
+  static void cull_scalar(const Frustum& frustum, const float* center_x,
+                          const float* center_y, const float* center_z,
+                          const float* radius, uint32_t count,
+                          uint32_t* visible_masks);
+};
+
+}  // namespace sanctify::render
+
+#endif
@@ -0,0 +1,132 @@
+#include "frustum_cull.h"
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+using namespace sanctify;
+using namespace render;
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+
+// Camera at (0, 0, 10) looking down -Z, 90 degree field of view
+Frustum test_frustum() {
+  glm::mat4 mat_view = glm::lookAt(glm::vec3(0.f, 0.f, 10.f),
+                                   glm::vec3(0.f, 0.f, 0.f),
+                                   glm::vec3(0.f, 1.f, 0.f));
+  glm::mat4 mat_proj =
+      glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f);
+  return Frustum::from_view_proj(mat_proj * mat_view);
+}
+
+bool is_visible(const uint32_t* masks, uint32_t i) {
+  return (masks[i / 32u] & (1u << (i % 32u))) != 0u;
+}
+
+}  // namespace
+
+TEST(FrustumCull, SphereFromPositionsContainsEveryVertex) {
+  PodVector<asset::PositionNormalVertexData> vertices(4);
+  vertices.push_back({glm::vec3(-1.f, 0.f, 0.f), glm::vec4(0.f)});
+  vertices.push_back({glm::vec3(3.f, 2.f, 0.f), glm::vec4(0.f)});
+  vertices.push_back({glm::vec3(1.f, -2.f, 4.f), glm::vec4(0.f)});
+
+  BoundingSphere sphere = BoundingSphere::from_positions(vertices);
+
+  for (int i = 0; i < vertices.size(); i++) {
+    EXPECT_LE(glm::length(vertices[i].Position - sphere.center),
+              sphere.radius + 0.0001f);
+  }
+}
+
+TEST(FrustumCull, TransformedSphereUsesLargestScale) {
+  BoundingSphere sphere{glm::vec3(1.f, 0.f, 0.f), 2.f};
+
+  glm::mat4 mat_world =
+      glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(0.f, 5.f, 0.f)),
+                 glm::vec3(1.f, 3.f, 2.f));
+  BoundingSphere transformed = sphere.transformed(mat_world);
+
+  EXPECT_NEAR(transformed.center.x, 1.f, 0.0001f);
+  EXPECT_NEAR(transformed.center.y, 5.f, 0.0001f);
+  EXPECT_NEAR(transformed.center.z, 0.f, 0.0001f);
+  EXPECT_NEAR(transformed.radius, 6.f, 0.0001f);
+}
+
+TEST(FrustumCull, SpheresInsideAndOutside) {
+  Frustum frustum = ::test_frustum();
+
+  // In front of the camera
+  EXPECT_TRUE(frustum.test_sphere({glm::vec3(0.f, 0.f, 0.f), 1.f}));
+
+  // Behind the camera
+  EXPECT_FALSE(frustum.test_sphere({glm::vec3(0.f, 0.f, 20.f), 1.f}));
+
+  // Past the far plane
+  EXPECT_FALSE(frustum.test_sphere({glm::vec3(0.f, 0.f, -200.f), 1.f}));
+
+  // Off to the side, but large enough to poke into view
+  EXPECT_FALSE(frustum.test_sphere({glm::vec3(30.f, 0.f, 0.f), 1.f}));
+  EXPECT_TRUE(frustum.test_sphere({glm::vec3(30.f, 0.f, 0.f), 25.f}));
+}
+
+TEST(FrustumCull, KernelMatchesScalar) {
+  Frustum frustum = ::test_frustum();
+
+  // Not a multiple of any lane width, to exercise the tail
+  const uint32_t kCount = 1000u + 3u;
+
+  std::mt19937 rng(1337u);
+  std::uniform_real_distribution<float> coord(-60.f, 60.f);
+  std::uniform_real_distribution<float> radius(0.f, 5.f);
+
+  PodVector<float> x(kCount), y(kCount), z(kCount), r(kCount);
+  for (uint32_t i = 0; i < kCount; i++) {
+    x.push_back(coord(rng));
+    y.push_back(coord(rng));
+    z.push_back(coord(rng));
+    r.push_back(radius(rng));
+  }
+
+  const uint32_t word_count = (kCount + 31u) / 32u;
+  PodVector<uint32_t> masks(word_count);
+  PodVector<uint32_t> scalar_masks(word_count);
+  masks.resize(word_count);
+  scalar_masks.resize(word_count);
+
+  FrustumCullKernel::cull(frustum, x.raw(), y.raw(), z.raw(), r.raw(), kCount,
+                          masks.raw());
+  FrustumCullKernel::cull_scalar(frustum, x.raw(), y.raw(), z.raw(), r.raw(),
+                                 kCount, scalar_masks.raw());
+
+  uint32_t visible_count = 0u;
+  for (uint32_t i = 0; i < kCount; i++) {
+    bool expected = frustum.test_sphere(
+        {glm::vec3(x[i], y[i], z[i]), r[i]});
+    EXPECT_EQ(::is_visible(masks.raw(), i), expected) << "Sphere " << i;
+    EXPECT_EQ(::is_visible(scalar_masks.raw(), i), expected) << "Sphere " << i;
+    visible_count += expected ? 1u : 0u;
+  }
+
+  // Sanity check that the test cloud is actually partially culled
+  EXPECT_GT(visible_count, 0u);
+  EXPECT_LT(visible_count, kCount);
+}
+
+TEST(FrustumCull, KernelOverwritesStaleMasks) {
+  Frustum frustum = ::test_frustum();
+
+  float x[] = {0.f, 500.f};
+  float y[] = {0.f, 0.f};
+  float z[] = {0.f, 0.f};
+  float r[] = {1.f, 1.f};
+
+  uint32_t mask = 0xFFFFFFFFu;
+  FrustumCullKernel::cull(frustum, x, y, z, r, 2u, &mask);
+
+  EXPECT_EQ(mask, 0x1u);
+}
@@ -0,0 +1,139 @@
+#include "visibility_system.h"
+
+#include <common/render/common/render_components.h>
+#include <igasync/task_group.h>
+
+#include <algorithm>
+
+using namespace sanctify;
+using namespace render;
+
+using namespace indigo;
+using namespace core;
+
+namespace {
+
+// Bounds of every tested entity, laid out for FrustumCullKernel - kept
+//  between frames so that culling does not allocate once warmed up
+struct CtxVisibilityScratch {
+  PodVector<entt::entity> entities;
+  PodVector<float> centerX;
+  PodVector<float> centerY;
+  PodVector<float> centerZ;
+  PodVector<float> radius;
+  PodVector<uint32_t> visibleMasks;
+};
+
+void cull_chunk(const Frustum& frustum, CtxVisibilityScratch& scratch,
+                uint32_t chunk_idx) {
+  const uint32_t start = chunk_idx * VisibilitySystem::kEntitiesPerChunk;
+  const uint32_t count =
+      std::min(VisibilitySystem::kEntitiesPerChunk,
+               static_cast<uint32_t>(scratch.entities.size()) - start);
+
+  FrustumCullKernel::cull(
+      frustum, scratch.centerX.raw() + start, scratch.centerY.raw() + start,
+      scratch.centerZ.raw() + start, scratch.radius.raw() + start, count,
+      scratch.visibleMasks.raw() + start / 32u);
+}
+
+}  // namespace
+
+static_assert(VisibilitySystem::kEntitiesPerChunk % 32u == 0u,
+              "Culling chunks must not share visibility mask words");
+
+void VisibilitySystem::set_world_bounds(igecs::WorldView* wv, entt::entity e,
+                                        const BoundingSphere& local_bounds,
+                                        const glm::mat4& mat_world) {
+  wv->attach_or_replace<WorldBoundsComponent>(e).bounds =
+      local_bounds.transformed(mat_world);
+}
+
+const igecs::WorldView::Decl& VisibilitySystem::update_decl() {
+  static const igecs::WorldView::Decl kUpdateDecl =
+      igecs::WorldView::Decl()
+          .ctx_reads<CtxMainCameraCommonUbos>()
+          .merge_in_decl(cull_decl());
+
+  return kUpdateDecl;
+}
+
+void VisibilitySystem::update(igecs::WorldView* wv,
+                              std::shared_ptr<TaskList> any_thread) {
+  const auto& camera_params =
+      wv->ctx<CtxMainCameraCommonUbos>().cameraVsUbo.get_immutable();
+
+  cull(wv,
+       Frustum::from_view_proj(camera_params.matProj * camera_params.matView),
+       any_thread);
+}
+
+const igecs::WorldView::Decl& VisibilitySystem::cull_decl() {
+  static const igecs::WorldView::Decl kCullDecl =
+      igecs::WorldView::Decl()
+          .reads<WorldBoundsComponent>()
+          .ctx_writes<::CtxVisibilityScratch>()
+          .ctx_writes<CtxVisibleList>();
+
+  return kCullDecl;
+}
+
+void VisibilitySystem::cull(igecs::WorldView* wv, const Frustum& frustum,
+                            std::shared_ptr<TaskList> any_thread) {
+  auto& scratch = wv->mut_ctx_or_set<::CtxVisibilityScratch>();
+  auto& visible_list = wv->mut_ctx_or_set<CtxVisibleList>();
+
+  //
+  // Gather bounds (SoA)
+  //
+  scratch.entities.resize(0);
+  scratch.centerX.resize(0);
+  scratch.centerY.resize(0);
+  scratch.centerZ.resize(0);
+  scratch.radius.resize(0);
+
+  auto view = wv->view<const WorldBoundsComponent>();
+  for (auto [e, world_bounds] : view.each()) {
+    scratch.entities.push_back(e);
+    scratch.centerX.push_back(world_bounds.bounds.center.x);
+    scratch.centerY.push_back(world_bounds.bounds.center.y);
+    scratch.centerZ.push_back(world_bounds.bounds.center.z);
+    scratch.radius.push_back(world_bounds.bounds.radius);
+  }
+
+  const uint32_t count = static_cast<uint32_t>(scratch.entities.size());
+  scratch.visibleMasks.resize((count + 31u) / 32u);
+
+  //
+  // Test (in parallel chunks)
+  //
+  const uint32_t chunk_count =
+      (count + kEntitiesPerChunk - 1u) / kEntitiesPerChunk;
+  if (chunk_count > 1u && any_thread != nullptr) {
+    TaskGroup cull_group;
+    for (uint32_t i = 0u; i < chunk_count; i++) {
+      cull_group.add([&frustum, &scratch, i]() {
+        ::cull_chunk(frustum, scratch, i);
+      });
+    }
+    cull_group.run_and_wait(any_thread);
+  } else {
+    for (uint32_t i = 0u; i < chunk_count; i++) {
+      ::cull_chunk(frustum, scratch, i);
+    }
+  }
+
+  //
+  // Compact
+  //
+  visible_list.visible.resize(0);
+  visible_list.testedCount = count;
+  for (int word_idx = 0; word_idx < scratch.visibleMasks.size(); word_idx++) {
+    uint32_t mask = scratch.visibleMasks[word_idx];
+    for (uint32_t bit = 0u; mask != 0u; bit++, mask >>= 1u) {
+      if (mask & 1u) {
+        visible_list.visible.push_back(scratch.entities[word_idx * 32u + bit]);
+      }
+    }
+  }
+}
@@ -0,0 +1,62 @@
+#ifndef SANCTIFY_COMMON_RENDER_VISIBILITY_VISIBILITY_SYSTEM_H
+#define SANCTIFY_COMMON_RENDER_VISIBILITY_VISIBILITY_SYSTEM_H
+
+#include <igasync/task_list.h>
+#include <igcore/pod_vector.h>
+#include <igecs/world_view.h>
+
+#include <memory>
+
+#include "frustum_cull.h"
+
+/**
+ * Frustum culling for renderables - every entity with a WorldBoundsComponent
+ *  is tested against the main camera frustum once per frame, and the ones
+ *  that may be visible are written (in view order) to CtxVisibleList.
+ *
+ * Render systems should record instances from CtxVisibleList instead of
+ *  iterating every renderable.
+ */
+
+namespace sanctify::render {
+
+/** World space bounds - keep up to date when the renderable moves */
+struct WorldBoundsComponent {
+  BoundingSphere bounds;
+};
+
+struct CtxVisibleList {
+  indigo::core::PodVector<entt::entity> visible;
+
+  // Number of entities tested to produce "visible"
+  uint32_t testedCount;
+};
+
+class VisibilitySystem {
+ public:
+  /** Entities handed to a single task - a multiple of 32 (see cull) */
+  static constexpr uint32_t kEntitiesPerChunk = 2048u;
+
+  static void set_world_bounds(indigo::igecs::WorldView* wv, entt::entity e,
+                               const BoundingSphere& local_bounds,
+                               const glm::mat4& mat_world);
+
+  /** Cull against the frustum of CtxMainCameraCommonUbos */
+  static const indigo::igecs::WorldView::Decl& update_decl();
+  static void update(indigo::igecs::WorldView* wv,
+                     std::shared_ptr<indigo::core::TaskList> any_thread);
+
+  /**
+   * Cull against an arbitrary frustum. Chunks of kEntitiesPerChunk entities
+   *  are tested in parallel by "any_thread" executors (if given) and the
+   *  calling thread, which only ever runs culling chunks while it waits (see
+   *  core::TaskGroup).
+   */
+  static const indigo::igecs::WorldView::Decl& cull_decl();
+  static void cull(indigo::igecs::WorldView* wv, const Frustum& frustum,
+                   std::shared_ptr<indigo::core::TaskList> any_thread);
+};
+
+}  // namespace sanctify::render
+
+#endif
@@ -0,0 +1,96 @@
+#include "visibility_system.h"
+
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+using namespace sanctify;
+using namespace render;
+using namespace indigo;
+using namespace core;
+using namespace igecs;
+
+namespace {
+
+Frustum test_frustum() {
+  glm::mat4 mat_view = glm::lookAt(glm::vec3(0.f, 0.f, 10.f),
+                                   glm::vec3(0.f, 0.f, 0.f),
+                                   glm::vec3(0.f, 1.f, 0.f));
+  glm::mat4 mat_proj =
+      glm::perspective(glm::radians(90.f), 1.f, 0.1f, 100.f);
+  return Frustum::from_view_proj(mat_proj * mat_view);
+}
+
+}  // namespace
+
+TEST(VisibilitySystem, ListsOnlyVisibleEntities) {
+  entt::registry world;
+  WorldView thin_view = WorldView::Thin(&world);
+
+  BoundingSphere unit_sphere{glm::vec3(0.f, 0.f, 0.f), 1.f};
+
+  auto visible = world.create();
+  VisibilitySystem::set_world_bounds(&thin_view, visible, unit_sphere,
+                                     glm::mat4(1.f));
+
+  auto behind_camera = world.create();
+  VisibilitySystem::set_world_bounds(
+      &thin_view, behind_camera, unit_sphere,
+      glm::translate(glm::mat4(1.f), glm::vec3(0.f, 0.f, 20.f)));
+
+  auto no_bounds = world.create();
+
+  WorldView wv = VisibilitySystem::cull_decl().create(&world);
+  VisibilitySystem::cull(&wv, ::test_frustum(), nullptr);
+
+  const auto& visible_list = world.ctx<CtxVisibleList>();
+  EXPECT_EQ(visible_list.testedCount, 2u);
+  ASSERT_EQ(visible_list.visible.size(), 1);
+  EXPECT_EQ(visible_list.visible[0], visible);
+}
+
+TEST(VisibilitySystem, ParallelChunksMatchSerial) {
+  // Several chunks, the last one partial
+  const uint32_t kEntityCount = VisibilitySystem::kEntitiesPerChunk * 3u + 77u;
+
+  entt::registry world;
+  WorldView thin_view = WorldView::Thin(&world);
+
+  std::mt19937 rng(1337u);
+  std::uniform_real_distribution<float> coord(-60.f, 60.f);
+  BoundingSphere unit_sphere{glm::vec3(0.f, 0.f, 0.f), 1.f};
+
+  PodVector<entt::entity> expected_visible(kEntityCount);
+  Frustum frustum = ::test_frustum();
+  for (uint32_t i = 0; i < kEntityCount; i++) {
+    auto e = world.create();
+    VisibilitySystem::set_world_bounds(
+        &thin_view, e, unit_sphere,
+        glm::translate(glm::mat4(1.f),
+                       glm::vec3(coord(rng), coord(rng), coord(rng))));
+  }
+
+  // Serial reference, in view order
+  for (auto [e, world_bounds] : world.view<const WorldBoundsComponent>().each()) {
+    if (frustum.test_sphere(world_bounds.bounds)) {
+      expected_visible.push_back(e);
+    }
+  }
+
+  // No worker threads - the calling thread culls every chunk itself, and
+  //  leaves unrelated work on the task list alone
+  auto task_list = std::make_shared<TaskList>();
+  bool ran_unrelated = false;
+  task_list->add_task(Task::of([&ran_unrelated]() { ran_unrelated = true; }));
+  WorldView wv = VisibilitySystem::cull_decl().create(&world);
+  VisibilitySystem::cull(&wv, frustum, task_list);
+  EXPECT_FALSE(ran_unrelated);
+
+  const auto& visible_list = world.ctx<CtxVisibleList>();
+  EXPECT_EQ(visible_list.testedCount, kEntityCount);
+  ASSERT_EQ(visible_list.visible.size(), expected_visible.size());
+  for (int i = 0; i < expected_visible.size(); i++) {
+    EXPECT_EQ(visible_list.visible[i], expected_visible[i]);
+  }
+}
@@ -24,6 +24,7 @@ SimpleClientAppBase::SimpleClientAppBase(GLFWwindow* window,
       width(width),
       height(height),
       swapChainFormat(swap_chain_format),
+      pipelineCache(std::make_shared<iggpu::RenderPipelineCache>()),
       listeners_(1)
 #ifdef IG_ENABLE_THREADS
       ,
@@ -24,6 +24,7 @@
 #include <igasync/task_list.h>
 #include <igcore/either.h>
 #include <igcore/vector.h>
+#include <iggpu/render_pipeline_cache.h>
 #include <webgpu/webgpu_cpp.h>
 
 #include <glm/glm.hpp>
@@ -108,6 +109,10 @@ class SimpleClientAppBase {
   // Mouse
   bool is_mouse_down(MouseButtonCode button);
 
+  // Deliver finished asynchronous GPU work (pipeline creation, buffer maps) -
+  //  call once per frame. Native Dawn only fires callbacks from in here.
+  void process_gpu_events();
+
  public:
   GLFWwindow* window;
   wgpu::Device device;
@@ -117,6 +122,9 @@ class SimpleClientAppBase {
   uint32_t height;
   wgpu::TextureFormat swapChainFormat;
 
+  // Shared by every scene created against this device
+  std::shared_ptr<indigo::iggpu::RenderPipelineCache> pipelineCache;
+
  private:
   indigo::core::Vector<std::shared_ptr<ISimpleClientEventListener>> listeners_;
 
@@ -192,6 +192,8 @@ void SimpleClientAppBase::resize_swap_chain(uint32_t width, uint32_t height) {
   fire_swap_chain_resized_events(width, height);
 }
 
+void SimpleClientAppBase::process_gpu_events() { device.Tick(); }
+
 glm::uvec2 SimpleClientAppBase::get_suggested_window_size() {
   int i_width = 0, i_height = 0;
   auto primary_monitor = glfwGetPrimaryMonitor();
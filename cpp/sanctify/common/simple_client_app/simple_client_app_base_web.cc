@@ -47,6 +47,10 @@ void SimpleClientAppBase::resize_swap_chain(uint32_t width, uint32_t height) {
   fire_swap_chain_resized_events(width, height);
 }
 
+void SimpleClientAppBase::process_gpu_events() {
+  // Nothing to do - the browser delivers WebGPU callbacks on its own event loop
+}
+
 glm::uvec2 SimpleClientAppBase::get_suggested_window_size() {
   int w, h;
   emscripten_get_canvas_element_size("#app_canvas", &w, &h);
@@ -4,6 +4,7 @@
 #include <common/render/common/camera_ubos.h>
 #include <common/render/common/render_components.h>
 #include <common/render/solid_static/ecs_util.h>
+#include <common/render/terrain/terrain_lod_system.h>
 #include <common/render/viewport/update_arena_camera_system.h>
 #include <igasset/igpack_loader.h>
 #include <igasync/promise_combiner.h>
@@ -18,6 +19,111 @@ using namespace pve;
 using namespace indigo;
 using namespace core;
 
+namespace {
+// Match the game server tick so offline and online simulations line up
+const float kTickSeconds = 8.f / 1000.f;
+const uint32_t kMaxCatchupTicks = 4u;
+
+float ms_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<float, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+struct TerrainLodGeo {
+  PodVector<asset::PositionNormalVertexData> vertices;
+  PodVector<uint32_t> indices;
+};
+typedef Either<TerrainLodGeo, std::string> TerrainLodGeoT;
+
+// Decodes every LOD of every chunk in "def" (in parallel), then registers the
+//  geo and creates the chunk renderables on the main thread
+std::shared_ptr<Promise<Maybe<std::string>>> load_terrain_chunks(
+    entt::registry* world, const wgpu::Device& device,
+    const asset::IgpackLoader& loader, asset::pb::TerrainChunksDef def,
+    std::shared_ptr<TaskList> main_thread_task_list,
+    std::shared_ptr<TaskList> async_task_list) {
+  auto combiner = PromiseCombiner::Create();
+  std::vector<PromiseCombiner::PromiseCombinerKey<TerrainLodGeoT>> lod_keys;
+
+  for (const auto& chunk : def.chunks()) {
+    for (int lod = 0; lod < chunk.lods_size() &&
+                      lod < render::TerrainChunkDesc::kMaxLods;
+         lod++) {
+      const std::string& geo_name = chunk.lods(lod).geo_igasset_name();
+      auto lod_promise =
+          loader.extract_draco_geo(geo_name, async_task_list)
+              ->then<TerrainLodGeoT>(
+                  [geo_name](const asset::IgpackLoader::ExtractDracoBufferT&
+                                 rsl) -> TerrainLodGeoT {
+                    if (rsl.is_right()) {
+                      return right("Failed to load terrain LOD " + geo_name);
+                    }
+
+                    auto pos_norm_rsl = rsl.get_left()->get_pos_norm_data();
+                    auto indices_rsl = rsl.get_left()->get_index_data();
+                    if (pos_norm_rsl.is_right() || indices_rsl.is_right()) {
+                      return right("Failed to extract terrain LOD " +
+                                   geo_name);
+                    }
+
+                    return left(TerrainLodGeo{pos_norm_rsl.left_move(),
+                                              indices_rsl.left_move()});
+                  },
+                  async_task_list);
+      lod_keys.push_back(combiner->add(lod_promise, async_task_list));
+    }
+  }
+
+  return combiner->combine<Maybe<std::string>>(
+      [world, device, def = std::move(def),
+       lod_keys](PromiseCombiner::PromiseCombinerResult rsl)
+          -> Maybe<std::string> {
+        auto wv = igecs::WorldView::Thin(world);
+
+        size_t next_lod_key = 0u;
+        for (const auto& chunk : def.chunks()) {
+          render::TerrainChunkDesc desc{};
+          desc.boundsMin =
+              glm::vec3(chunk.min_x(), chunk.min_y(), chunk.min_z());
+          desc.boundsMax =
+              glm::vec3(chunk.max_x(), chunk.max_y(), chunk.max_z());
+
+          render::solid_static::ReadonlyResourceRegistry<
+              render::solid_static::Geo>::Key
+              geo_keys[render::TerrainChunkDesc::kMaxLods];
+          for (int lod = 0; lod < chunk.lods_size() &&
+                            lod < render::TerrainChunkDesc::kMaxLods;
+               lod++) {
+            const auto& lod_geo = rsl.get(lod_keys[next_lod_key++]);
+            if (lod_geo.is_right()) {
+              return lod_geo.get_right();
+            }
+
+            geo_keys[lod] = render::solid_static::EcsUtil::register_geo(
+                &wv, device, lod_geo.get_left().vertices,
+                lod_geo.get_left().indices);
+            desc.triangleCount[lod] = chunk.lods(lod).triangle_count();
+            desc.lodCount++;
+          }
+
+          if (desc.lodCount == 0u) {
+            continue;
+          }
+
+          render::TerrainLodSystem::add_chunk(
+              &wv, desc, geo_keys,
+              render::solid_static::InstanceData{glm::mat4(1.f),
+                                                 glm::vec3(1.f, 1.f, 1.f),
+                                                 0.01f, 0.3f, 0.f});
+        }
+
+        return empty_maybe{};
+      },
+      main_thread_task_list);
+}
+}  // namespace
+
 ////////////////////////////////////////////////////////////////////////////////////
 //                               SCENE LOADING
 // TODO (sessamekesh): Move this out into a separate file! It's cluttered here!!
@@ -40,7 +146,16 @@ PveOfflineGameScene::Create(std::shared_ptr<SimpleClientAppBase> app_base,
   asset::IgpackLoader shader_loader("resources/common-shaders.igpack",
                                     async_task_list);
   asset::IgpackLoader arena_base_loader("resources/arena-base.igpack",
-                                        async_task_list);
+                                        async_task_list,
+                                        asset::IgpackLoader::StreamingParams{});
+
+  const auto& cache_settings = client_config.asset_cache_settings();
+  if (!cache_settings.directory().empty()) {
+    auto asset_cache = asset::DecodedAssetCache::Create(
+        cache_settings.directory(),
+        cache_settings.max_size_mb() * 1024ull * 1024ull);
+    arena_base_loader.set_decoded_asset_cache(asset_cache);
+  }
 
   const wgpu::Device& device = game_scene->base_->device;
   entt::registry& client_world = game_scene->client_world_;
@@ -53,7 +168,7 @@ PveOfflineGameScene::Create(std::shared_ptr<SimpleClientAppBase> app_base,
   world->set<render::CtxPlatformObjects>(
       device, app_base->swapChainFormat,
       app_base->swapChain.GetCurrentTextureView(), app_base->width,
-      app_base->height);
+      app_base->height, app_base->pipelineCache);
 
   auto common_ubo_hdr_promise =
       CommonRenderLoadingUtil::setup_ubos_and_hdr_state(
@@ -69,43 +184,21 @@ PveOfflineGameScene::Create(std::shared_ptr<SimpleClientAppBase> app_base,
           &shader_loader, "tonemapVs", "tonemapFs");
 
   auto load_terrain_base_promise =
-      arena_base_loader.extract_draco_geo("terrainBaseGeo", async_task_list)
+      arena_base_loader
+          .extract_terrain_chunks_def("arenaTerrainChunks", async_task_list)
           ->then_chain<Maybe<std::string>>(
-              [world, device, main_thread_task_list](
-                  const asset::IgpackLoader::ExtractDracoBufferT& rsl) {
+              [world, device, arena_base_loader, main_thread_task_list,
+               async_task_list](
+                  const asset::IgpackLoader::ExtractTerrainChunksDefT& rsl) {
                 if (rsl.is_right()) {
                   return Promise<Maybe<std::string>>::immediate(
-                      {"Failed to load Draco result"});
+                      {"Failed to load terrain chunks"});
                 }
 
-                const auto& decoder = rsl.get_left();
-
-                auto pos_norm_rsl = decoder->get_pos_norm_data();
-                auto indices_rsl = decoder->get_index_data();
-
-                if (pos_norm_rsl.is_right() || indices_rsl.is_right()) {
-                  return Promise<Maybe<std::string>>::immediate(
-                      {"Failed to extract pos/norm/indices from Draco"});
-                }
-
-                return Promise<Maybe<std::string>>::schedule(
-                    main_thread_task_list,
-                    [world, pn = pos_norm_rsl.left_move(),
-                     idc = indices_rsl.left_move(), device]() {
-                      auto wv = indigo::igecs::WorldView::Thin(world);
-
-                      auto geo_key =
-                          render::solid_static::EcsUtil::register_geo(
-                              &wv, device, pn, idc);
-
-                      render::solid_static::EcsUtil::attach_renderable(
-                          &wv, wv.create(), geo_key,
-                          render::solid_static::InstanceData{
-                              glm::mat4(1.f), glm::vec3(1.f, 1.f, 1.f), 0.01f,
-                              0.3f, 0.f});
-
-                      return empty_maybe{};
-                    });
+                return ::load_terrain_chunks(world, device, arena_base_loader,
+                                             rsl.get_left(),
+                                             main_thread_task_list,
+                                             async_task_list);
               },
               async_task_list);
 
@@ -146,7 +239,12 @@ PveOfflineGameScene::Create(std::shared_ptr<SimpleClientAppBase> app_base,
                      glm::normalize(glm::vec3(1.f, -4.f, 1.2f)), 0.45f,
                      glm::vec3(1.f, 1.f, 1.f), 20.f});
 
-        Logger::log("PveOfflineClient") << "Loading finished!";
+        Logger::log("PveOfflineClient")
+            << "Loading finished! (" << ::ms_since(game_scene->load_start_)
+            << "ms)";
+        Logger::log("PveOfflineClient")
+            << "Render pipelines: "
+            << game_scene->base_->pipelineCache->stats();
         return left<std::shared_ptr<ISceneBase>>(game_scene);
       },
       main_thread_task_list);
@@ -160,11 +258,16 @@ PveOfflineGameScene::PveOfflineGameScene(
     : base_(app_base),
       main_thread_task_list_(main_thread_task_list),
       any_thread_task_list_(std::make_shared<TaskList>()),
+      tick_driver_(::kTickSeconds, ::kMaxCatchupTicks),
       async_task_list_(async_task_list),
       config_(std::move(config)),
       should_quit_(false),
-      update_client_scheduler_(pve::UpdateClientScheduler::build()),
-      render_client_scheduler_(pve::build_render_client_scheduler()) {}
+      update_frame_scheduler_(pve::UpdateClientScheduler::build_frame()),
+      update_tick_scheduler_(pve::UpdateClientScheduler::build_tick()),
+      render_client_scheduler_(
+          pve::build_render_client_scheduler(any_thread_task_list_)),
+      load_start_(std::chrono::steady_clock::now()),
+      has_rendered_frame_(false) {}
 
 ///////////////////////////////////////////////////////////////////////////////////////
 //                                  SCENE UPDATING
@@ -176,13 +279,20 @@ void PveOfflineGameScene::update(float dt) {
   const auto& device = base_->device;
   client_world_.set<render::CtxPlatformObjects>(
       device, base_->swapChainFormat, base_->swapChain.GetCurrentTextureView(),
-      base_->width, base_->height);
+      base_->width, base_->height, base_->pipelineCache);
   indigo::igecs::WorldView thinview =
       indigo::igecs::WorldView::Thin(&client_world_);
-  logic::FrameTimeElapsedUtil::mark_time_elapsed(&thinview, dt);
 
   base_->attach_async_task_list(any_thread_task_list_);
-  update_client_scheduler_.execute(any_thread_task_list_, &client_world_);
+
+  // Input and camera follow the frame rate, simulation follows the tick rate
+  logic::FrameTimeElapsedUtil::mark_time_elapsed(&thinview, dt,
+                                                 /* advance_sim= */ false);
+  update_frame_scheduler_.execute(any_thread_task_list_, &client_world_);
+
+  tick_driver_.run_frame(&thinview, dt, [this]() {
+    update_tick_scheduler_.execute(any_thread_task_list_, &client_world_);
+  });
   base_->detach_async_task_list(any_thread_task_list_);
 }
 
@@ -191,13 +301,20 @@ void PveOfflineGameScene::render() {
 
   client_world_.set<render::CtxPlatformObjects>(
       device, base_->swapChainFormat, base_->swapChain.GetCurrentTextureView(),
-      base_->width, base_->height);
+      base_->width, base_->height, base_->pipelineCache);
 
   base_->attach_async_task_list(any_thread_task_list_);
   render_client_scheduler_.execute(any_thread_task_list_, &client_world_);
   base_->detach_async_task_list(any_thread_task_list_);
 
   base_->swapChain.Present();
+
+  if (!has_rendered_frame_) {
+    has_rendered_frame_ = true;
+    Logger::log("PveOfflineClient")
+        << "First frame rendered " << ::ms_since(load_start_)
+        << "ms after scene load started";
+  }
 }
 
 bool PveOfflineGameScene::should_quit() { return should_quit_; }
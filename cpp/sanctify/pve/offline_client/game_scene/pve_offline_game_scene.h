@@ -1,6 +1,7 @@
 #ifndef SANCTIFY_PVE_OFFLINE_CLIENT_GAME_SCENE_PVE_OFFLINE_GAME_SCENE_H
 #define SANCTIFY_PVE_OFFLINE_CLIENT_GAME_SCENE_PVE_OFFLINE_GAME_SCENE_H
 
+#include <common/logic/update_common/fixed_step_driver.h>
 #include <common/scene/scene_base.h>
 #include <common/simple_client_app/simple_client_app_base.h>
 #include <igasync/promise.h>
@@ -8,6 +9,7 @@
 #include <igecs/scheduler.h>
 #include <pve/offline_client/pb/pve_offline_client_config.pb.h>
 
+#include <chrono>
 #include <entt/entt.hpp>
 #include <memory>
 
@@ -47,12 +49,18 @@ class PveOfflineGameScene : public ISceneBase,
   entt::registry server_world_;
 
   std::shared_ptr<indigo::core::TaskList> any_thread_task_list_;
-  indigo::igecs::Scheduler update_client_scheduler_;
+  logic::FixedStepDriver tick_driver_;
+  indigo::igecs::Scheduler update_frame_scheduler_;
+  indigo::igecs::Scheduler update_tick_scheduler_;
   indigo::igecs::Scheduler render_client_scheduler_;
 
   // Miscellaneous
   pb::PveOfflineClientConfig config_;
   bool should_quit_;
+
+  // Startup timing (cold vs. warm asset cache)
+  std::chrono::steady_clock::time_point load_start_;
+  bool has_rendered_frame_;
 };
 
 }  // namespace sanctify::pve
@@ -1,10 +1,13 @@
 #include "pve_offline_render.h"
 
 #include <common/render/common/render_components.h>
+#include <common/render/frame_graph/frame_graph.h>
+#include <common/render/frame_graph/transient_resource_cache.h>
 #include <common/render/solid_static/ecs_util.h>
 #include <common/render/solid_static/pipeline.h>
 #include <common/render/tonemap/ecs_util.h>
 #include <common/render/tonemap/pipeline.h>
+#include <igcore/log.h>
 
 using namespace sanctify;
 using namespace pve;
@@ -15,81 +18,50 @@ namespace {
 
 const float kAvgLuminosity = 0.2f;
 
-struct CtxDepthStencil {
-  iggpu::Texture depthTexture;
-  wgpu::TextureView depthView;
-};
-
-struct CtxHdrBuffer {
+struct FrameGraphTexture {
   iggpu::Texture texture;
   wgpu::TextureView view;
 };
 
+// Attachments (HDR buffer, depth-stencil) survive across frames in here, and
+//  are only re-created when their size or format changes
+struct CtxFrameGraphResources {
+  render::TransientResourceCache<FrameGraphTexture> textures;
+};
+
 struct CtxSolidGeoInputs {
+  // Bind groups come from the pipeline layout - rebuilt with the pipeline
+  wgpu::RenderPipeline pipeline;
   render::solid_static::SceneInputs sceneInputs;
   render::solid_static::FrameInputs frameInputs;
 };
 
 struct CtxTonemappingInputs {
-  bool is_dirty;
+  // HDR view and pipeline the inputs were created against
+  wgpu::TextureView hdrView;
+  wgpu::RenderPipeline pipeline;
   render::tonemap::TonemappingArgsInputs tonemappingInputs;
   render::tonemap::HdrTextureInputs hdrTextureInputs;
 };
 
-wgpu::TextureView get_depth_view(
-    const render::CtxPlatformObjects& platform_objects, igecs::WorldView* wv) {
-  if (!wv->ctx_has<CtxDepthStencil>() ||
-      wv->ctx<CtxDepthStencil>().depthTexture.Width !=
-          platform_objects.viewportWidth ||
-      wv->ctx<CtxDepthStencil>().depthTexture.Height !=
-          platform_objects.viewportHeight) {
-    iggpu::Texture depth_texture = iggpu::create_empty_texture_2d(
-        platform_objects.device, platform_objects.viewportWidth,
-        platform_objects.viewportHeight, 1,
-        wgpu::TextureFormat::Depth24PlusStencil8,
-        wgpu::TextureUsage::RenderAttachment);
-
-    auto depth_view_desc = iggpu::view_desc_of(depth_texture);
-    wgpu::TextureView depth_view =
-        depth_texture.GpuTexture.CreateView(&depth_view_desc);
-    wv->attach_ctx<CtxDepthStencil>(std::move(depth_texture),
-                                    std::move(depth_view));
-  }
-
-  return wv->ctx<CtxDepthStencil>().depthView;
-}
-
-wgpu::TextureView get_hdr_buffer(
-    const render::CtxPlatformObjects& platform_objects,
-    const render::CtxHdrFramebufferParams& hdr_params, igecs::WorldView* wv) {
-  if (!wv->ctx_has<CtxHdrBuffer>() ||
-      wv->ctx<CtxHdrBuffer>().texture.Width != hdr_params.width ||
-      wv->ctx<CtxHdrBuffer>().texture.Height != hdr_params.height ||
-      wv->ctx<CtxHdrBuffer>().texture.Format != hdr_params.format) {
-    iggpu::Texture hdr_tex = iggpu::create_empty_texture_2d(
-        platform_objects.device, hdr_params.width, hdr_params.height, 1,
-        hdr_params.format,
-        wgpu::TextureUsage::RenderAttachment |
-            wgpu::TextureUsage::TextureBinding);
-
-    auto view_desc = iggpu::view_desc_of(hdr_tex);
-    wgpu::TextureView hdr_view = hdr_tex.GpuTexture.CreateView(&view_desc);
-    wv->attach_ctx<CtxHdrBuffer>(std::move(hdr_tex), std::move(hdr_view));
-
-    if (wv->ctx_has<CtxTonemappingInputs>()) {
-      wv->mut_ctx<CtxTonemappingInputs>().is_dirty = true;
-    }
-  }
+FrameGraphTexture create_frame_graph_texture(
+    const wgpu::Device& device, const render::FrameGraphTextureDesc& desc) {
+  iggpu::Texture texture = iggpu::create_empty_texture_2d(
+      device, desc.width, desc.height, 1, desc.format, desc.usage);
 
-  return wv->ctx<CtxHdrBuffer>().view;
+  auto view_desc = iggpu::view_desc_of(texture);
+  wgpu::TextureView view = texture.GpuTexture.CreateView(&view_desc);
+  return FrameGraphTexture{std::move(texture), std::move(view)};
 }
 
 CtxSolidGeoInputs& get_solid_geo_inputs(
     const wgpu::Device& device,
     const render::CtxMainCameraCommonUbos& camera_ubos,
     const render::solid_static::Pipeline& pipeline, igecs::WorldView* wv) {
-  if (!wv->ctx_has<CtxSolidGeoInputs>()) {
+  if (!wv->ctx_has<CtxSolidGeoInputs>() ||
+      wv->ctx<CtxSolidGeoInputs>().pipeline.Get() != pipeline.pipeline.Get()) {
     wv->attach_ctx<CtxSolidGeoInputs>(
+        pipeline.pipeline,
         pipeline.create_scene_inputs(device, camera_ubos.lightingUbo),
         pipeline.create_frame_inputs(device, camera_ubos.cameraVsUbo,
                                      camera_ubos.cameraFsUbo));
@@ -100,18 +72,18 @@ CtxSolidGeoInputs& get_solid_geo_inputs(
 
 CtxTonemappingInputs& get_tonemapping_inputs(
     const render::CtxPlatformObjects& platform_objects,
-    const render::CtxHdrFramebufferParams& hdr_params,
+    const wgpu::TextureView& hdr_view,
     const render::tonemap::Pipeline& pipeline, igecs::WorldView* wv) {
   if (!wv->ctx_has<CtxTonemappingInputs>() ||
-      wv->ctx<CtxTonemappingInputs>().is_dirty) {
+      wv->ctx<CtxTonemappingInputs>().hdrView.Get() != hdr_view.Get() ||
+      wv->ctx<CtxTonemappingInputs>().pipeline.Get() !=
+          pipeline.pipeline.Get()) {
     wv->attach_ctx<CtxTonemappingInputs>(
-        false,
+        hdr_view, pipeline.pipeline,
         pipeline.create_tonemapping_args_inputs(
             platform_objects.device,
             render::tonemap::TonemappingArgumentsData{::kAvgLuminosity}),
-        pipeline.create_hdr_texture_inputs(
-            platform_objects.device,
-            ::get_hdr_buffer(platform_objects, hdr_params, wv)));
+        pipeline.create_hdr_texture_inputs(platform_objects.device, hdr_view));
   }
 
   return wv->mut_ctx<CtxTonemappingInputs>();
@@ -124,8 +96,7 @@ const igecs::WorldView::Decl& PveOfflineRenderSystem::render_decl() {
       igecs::WorldView::Decl()
           .ctx_reads<render::CtxHdrFramebufferParams>()
           .ctx_reads<render::CtxPlatformObjects>()
-          .ctx_writes<CtxDepthStencil>()
-          .ctx_writes<CtxHdrBuffer>()
+          .ctx_writes<CtxFrameGraphResources>()
           .ctx_writes<render::solid_static::CtxPipeline>()
           .ctx_reads<render::CtxMainCameraCommonUbos>()
           .ctx_writes<CtxSolidGeoInputs>()
@@ -135,7 +106,8 @@ const igecs::WorldView::Decl& PveOfflineRenderSystem::render_decl() {
   return kRenderDecl;
 }
 
-void PveOfflineRenderSystem::render(igecs::WorldView* wv) {
+void PveOfflineRenderSystem::render(
+    igecs::WorldView* wv, std::shared_ptr<core::TaskList> any_thread) {
   const auto& ctx_platform = wv->ctx<render::CtxPlatformObjects>();
   const auto& ctx_hdr_params = wv->ctx<render::CtxHdrFramebufferParams>();
   const auto& ctx_main_camera_ubos = wv->ctx<render::CtxMainCameraCommonUbos>();
@@ -148,77 +120,155 @@ void PveOfflineRenderSystem::render(igecs::WorldView* wv) {
   render::solid_static::EcsUtil::update_pipeline(wv, device);
   render::tonemap::EcsUtil::update_pipeline(wv);
 
+  //
+  // Declare passes
+  //
+  render::FrameGraph graph;
+  auto depth = graph.create_texture(
+      "depth", render::FrameGraphTextureDesc{
+                   ctx_platform.viewportWidth, ctx_platform.viewportHeight,
+                   wgpu::TextureFormat::Depth24PlusStencil8,
+                   wgpu::TextureUsage::RenderAttachment});
+  auto hdr = graph.create_texture(
+      "hdr", render::FrameGraphTextureDesc{
+                 ctx_hdr_params.width, ctx_hdr_params.height,
+                 ctx_hdr_params.format,
+                 wgpu::TextureUsage::RenderAttachment |
+                     wgpu::TextureUsage::TextureBinding});
+  auto backbuffer = graph.import_texture("backbuffer");
+  graph.mark_output(backbuffer);
+
+  // Filled in once the graph is compiled, before any pass executes
+  wgpu::TextureView depth_view;
+  wgpu::TextureView hdr_view;
+
   //
   // HDR GEO PASS
   //
-  {
-    wgpu::RenderPassDepthStencilAttachment depth_attachment{};
-    depth_attachment.depthClearValue = 1.f;
-    depth_attachment.stencilClearValue = 0x00;
-    depth_attachment.depthLoadOp = wgpu::LoadOp::Clear;
-    depth_attachment.depthStoreOp = wgpu::StoreOp::Store;
-    depth_attachment.stencilLoadOp = wgpu::LoadOp::Clear;
-    depth_attachment.stencilStoreOp = wgpu::StoreOp::Discard;
-    depth_attachment.view = ::get_depth_view(ctx_platform, wv);
-
-    wgpu::RenderPassColorAttachment color_attachment{};
-    color_attachment.clearValue = {0.2f, 0.1f, 0.1f, 1.f};
-    color_attachment.loadOp = wgpu::LoadOp::Clear;
-    color_attachment.storeOp = wgpu::StoreOp::Store;
-    color_attachment.view = ::get_hdr_buffer(ctx_platform, ctx_hdr_params, wv);
-
-    wgpu::RenderPassDescriptor hdr_geo_pass_desc{};
-    hdr_geo_pass_desc.colorAttachments = &color_attachment;
-    hdr_geo_pass_desc.colorAttachmentCount = 1;
-    hdr_geo_pass_desc.depthStencilAttachment = &depth_attachment;
-
-    auto pass = main_pass_command_encoder.BeginRenderPass(&hdr_geo_pass_desc);
-    const auto& pipeline = render::solid_static::EcsUtil::get_pipeline(wv);
-
-    auto& inputs =
-        ::get_solid_geo_inputs(device, ctx_main_camera_ubos, pipeline, wv);
-
-    sanctify::render::solid_static::RenderUtil util(&pass, &pipeline);
-    util.set_frame_inputs(inputs.frameInputs)
-        .set_scene_inputs(inputs.sceneInputs);
-
-    sanctify::render::solid_static::EcsUtil::render_matching(
-        wv, ctx_platform.device, &util, [](auto) { return true; });
-
-    pass.End();
-  }
+  // The only pass with CPU-side prepare work so far - tonemapping has nothing
+  //  to record (its bind groups need the device, so they stay in execute).
+  //  With one pass to prepare, FrameGraph::run prepares it inline.
+  graph.add_pass("hdr_geo")
+      .writes(hdr)
+      .writes(depth)
+      .prepare([wv]() {
+        sanctify::render::solid_static::EcsUtil::prepare_visible(wv);
+      })
+      .execute([&]() {
+        wgpu::RenderPassDepthStencilAttachment depth_attachment{};
+        depth_attachment.depthClearValue = 1.f;
+        depth_attachment.stencilClearValue = 0x00;
+        depth_attachment.depthLoadOp = wgpu::LoadOp::Clear;
+        depth_attachment.depthStoreOp = wgpu::StoreOp::Store;
+        depth_attachment.stencilLoadOp = wgpu::LoadOp::Clear;
+        depth_attachment.stencilStoreOp = wgpu::StoreOp::Discard;
+        depth_attachment.view = depth_view;
+
+        wgpu::RenderPassColorAttachment color_attachment{};
+        color_attachment.clearValue = {0.2f, 0.1f, 0.1f, 1.f};
+        color_attachment.loadOp = wgpu::LoadOp::Clear;
+        color_attachment.storeOp = wgpu::StoreOp::Store;
+        color_attachment.view = hdr_view;
+
+        wgpu::RenderPassDescriptor hdr_geo_pass_desc{};
+        hdr_geo_pass_desc.colorAttachments = &color_attachment;
+        hdr_geo_pass_desc.colorAttachmentCount = 1;
+        hdr_geo_pass_desc.depthStencilAttachment = &depth_attachment;
+
+        auto pass =
+            main_pass_command_encoder.BeginRenderPass(&hdr_geo_pass_desc);
+        const auto& pipeline = render::solid_static::EcsUtil::get_pipeline(wv);
+
+        // Still building - leave the cleared HDR buffer as a placeholder
+        if (!pipeline.pipeline) {
+          pass.End();
+          return;
+        }
+
+        auto& inputs =
+            ::get_solid_geo_inputs(device, ctx_main_camera_ubos, pipeline, wv);
+
+        sanctify::render::solid_static::RenderUtil util(&pass, &pipeline);
+        util.set_frame_inputs(inputs.frameInputs)
+            .set_scene_inputs(inputs.sceneInputs);
+
+        sanctify::render::solid_static::EcsUtil::draw_prepared(wv, device,
+                                                               &util);
+
+        pass.End();
+      })
+      .build();
 
   //
   // TONEMAPPING PASS
   //
-  {
-    wgpu::RenderPassColorAttachment color_attachment{};
-    color_attachment.clearValue = {0.f, 0.f, 0.f, 1.f};
-    color_attachment.loadOp = wgpu::LoadOp::Clear;
-    color_attachment.storeOp = wgpu::StoreOp::Store;
-    color_attachment.view = ctx_platform.swapChainBackbuffer;
-
-    wgpu::RenderPassDescriptor ldr_tonemap_pass_desc{};
-    ldr_tonemap_pass_desc.colorAttachmentCount = 1;
-    ldr_tonemap_pass_desc.colorAttachments = &color_attachment;
-
-    auto pass =
-        main_pass_command_encoder.BeginRenderPass(&ldr_tonemap_pass_desc);
-    const auto& pipeline =
-        wv->ctx<render::tonemap::CtxPipeline>().currentPipeline;
-
-    auto& inputs =
-        ::get_tonemapping_inputs(ctx_platform, ctx_hdr_params, pipeline, wv);
+  graph.add_pass("tonemap")
+      .reads(hdr)
+      .writes(backbuffer)
+      .execute([&]() {
+        wgpu::RenderPassColorAttachment color_attachment{};
+        color_attachment.clearValue = {0.f, 0.f, 0.f, 1.f};
+        color_attachment.loadOp = wgpu::LoadOp::Clear;
+        color_attachment.storeOp = wgpu::StoreOp::Store;
+        color_attachment.view = ctx_platform.swapChainBackbuffer;
+
+        wgpu::RenderPassDescriptor ldr_tonemap_pass_desc{};
+        ldr_tonemap_pass_desc.colorAttachmentCount = 1;
+        ldr_tonemap_pass_desc.colorAttachments = &color_attachment;
+
+        auto pass =
+            main_pass_command_encoder.BeginRenderPass(&ldr_tonemap_pass_desc);
+        const auto& pipeline =
+            wv->ctx<render::tonemap::CtxPipeline>().currentPipeline;
+
+        if (!pipeline.pipeline) {
+          pass.End();
+          return;
+        }
+
+        auto& inputs =
+            ::get_tonemapping_inputs(ctx_platform, hdr_view, pipeline, wv);
+
+        render::tonemap::RenderUtil util(&pass, &pipeline);
+
+        bool is_success = false;
+        util.set_hdr_texture_inputs(inputs.hdrTextureInputs)
+            .set_tonemapping_args_inputs(inputs.tonemappingInputs)
+            .draw(&is_success);
+
+        pass.End();
+      })
+      .build();
+
+  auto compile_rsl = graph.compile();
+  if (compile_rsl.is_right()) {
+    core::Logger::err("PveOfflineRenderSystem")
+        << "Failed to compile frame graph: "
+        << render::to_string(compile_rsl.get_right());
+    return;
+  }
+  const auto& compiled = compile_rsl.get_left();
 
-    render::tonemap::RenderUtil util(&pass, &pipeline);
+  //
+  // Hand out (cached) physical textures
+  //
+  auto& textures = wv->mut_ctx_or_set<CtxFrameGraphResources>().textures;
+  core::Vector<FrameGraphTexture> physical_textures(
+      compiled.physicalTextures.size());
+  textures.begin_frame();
+  for (int i = 0; i < compiled.physicalTextures.size(); i++) {
+    physical_textures.push_back(textures.acquire(
+        compiled.physicalTextures[i],
+        [&device](const render::FrameGraphTextureDesc& desc) {
+          return ::create_frame_graph_texture(device, desc);
+        }));
+  }
+  textures.end_frame();
 
-    bool is_success = false;
-    util.set_hdr_texture_inputs(inputs.hdrTextureInputs)
-        .set_tonemapping_args_inputs(inputs.tonemappingInputs)
-        .draw(&is_success);
+  depth_view = physical_textures[compiled.physicalTextureIdx[depth]].view;
+  hdr_view = physical_textures[compiled.physicalTextureIdx[hdr]].view;
 
-    pass.End();
-  }
+  graph.run(compiled, any_thread);
 
   auto commands = main_pass_command_encoder.Finish();
   device.GetQueue().Submit(1, &commands);
@@ -1,14 +1,21 @@
 #ifndef SANCTIFY_PVE_OFFLINE_CLIENT_GAME_SCENE_PVE_OFFLINE_RENDER_H
 #define SANCTIFY_PVE_OFFLINE_CLIENT_GAME_SCENE_PVE_OFFLINE_RENDER_H
 
+#include <igasync/task_list.h>
 #include <igecs/world_view.h>
 
+#include <memory>
+
 namespace sanctify::pve {
 
 class PveOfflineRenderSystem {
  public:
   static const indigo::igecs::WorldView::Decl& render_decl();
-  static void render(indigo::igecs::WorldView* wv);
+
+  // Independent passes prepare their draw data in parallel on "any_thread"
+  //  before commands are encoded on the calling (main) thread
+  static void render(indigo::igecs::WorldView* wv,
+                     std::shared_ptr<indigo::core::TaskList> any_thread);
 };
 
 }  // namespace sanctify::pve
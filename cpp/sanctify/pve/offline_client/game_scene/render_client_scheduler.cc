@@ -2,7 +2,9 @@
 
 #include <common/render/common/render_components.h>
 #include <common/render/solid_static/ecs_util.h>
+#include <common/render/terrain/terrain_lod_system.h>
 #include <common/render/viewport/update_arena_camera_system.h>
+#include <common/render/visibility/visibility_system.h>
 
 #include "pve_offline_render.h"
 
@@ -11,7 +13,8 @@ using namespace sanctify;
 using namespace indigo;
 using namespace core;
 
-igecs::Scheduler pve::build_render_client_scheduler() {
+igecs::Scheduler pve::build_render_client_scheduler(
+    std::shared_ptr<TaskList> any_thread_task_list) {
   auto builder = igecs::Scheduler::Builder();
   builder.max_spin_time(std::chrono::milliseconds(50));
 
@@ -27,12 +30,33 @@ igecs::Scheduler pve::build_render_client_scheduler() {
             return Promise<EmptyPromiseRsl>::immediate({});
           });
 
+  auto cull_renderables =
+      builder.add_node()
+          .with_decl(render::VisibilitySystem::update_decl())
+          .depends_on(update_common_ubos)
+          .build([any_thread_task_list](igecs::WorldView* wv) {
+            render::VisibilitySystem::update(wv, any_thread_task_list);
+            return Promise<EmptyPromiseRsl>::immediate({});
+          });
+
+  auto select_terrain_lods =
+      builder.add_node()
+          .with_decl(render::TerrainLodSystem::update_decl())
+          .depends_on(update_common_ubos)
+          .build([](igecs::WorldView* wv) {
+            render::TerrainLodSystem::update(wv);
+            return Promise<EmptyPromiseRsl>::immediate({});
+          });
+
   auto render_scene = builder.add_node()
                           .main_thread_only()
                           .with_decl(PveOfflineRenderSystem::render_decl())
-                          .depends_on(update_common_ubos)
-                          .build([](igecs::WorldView* wv) {
-                            PveOfflineRenderSystem::render(wv);
+                          .depends_on(cull_renderables)
+                          .depends_on(select_terrain_lods)
+                          .build([any_thread_task_list](
+                                     igecs::WorldView* wv) {
+                            PveOfflineRenderSystem::render(
+                                wv, any_thread_task_list);
                             return Promise<EmptyPromiseRsl>::immediate({});
                           });
 
@@ -1,11 +1,17 @@
 #ifndef SANCTIFY_PVE_OFFLINE_CLIENT_GAME_SCENE_RENDER_CLIENT_SCHEDULER_H
 #define SANCTIFY_PVE_OFFLINE_CLIENT_GAME_SCENE_RENDER_CLIENT_SCHEDULER_H
 
+#include <igasync/task_list.h>
 #include <igecs/scheduler.h>
 
+#include <memory>
+
 namespace sanctify::pve {
 
-indigo::igecs::Scheduler build_render_client_scheduler();
+// "any_thread_task_list" is used for work that nodes split up internally
+//  (e.g. culling chunks) - pass the same list the scheduler executes on
+indigo::igecs::Scheduler build_render_client_scheduler(
+    std::shared_ptr<indigo::core::TaskList> any_thread_task_list);
 
 }
 
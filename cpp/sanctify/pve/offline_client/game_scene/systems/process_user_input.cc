@@ -30,43 +30,16 @@ void ProcessUserInputSystem::update(indigo::igecs::WorldView* wv) {
   const auto& ctx_camera = wv->ctx<render::CtxArenaCamera>();
   const auto& dt = logic::FrameTimeElapsedUtil::dt(wv);
 
-  ctx_camera_inputs.lookAtAdjustment = glm::vec3(0.f, 0.f, 0.f);
-
-  // Pan the camera if the mouse is near the edge of the screen...
+  // Runs once per frame (not per simulation tick) - the adjustment is held
+  //  until the camera update applies it
   Maybe<glm::vec2> mouse_pos = io::EcsUtil::get_mouse_pos(wv);
   if (mouse_pos.has_value()) {
-    float xpct = mouse_pos.get().x / ctx_render_components.viewportWidth;
-    float ypct = mouse_pos.get().y / ctx_render_components.viewportHeight;
-
-    // TODO (sessamekesh): Pass in configuration state...
-    const float mvt_speed = 10.f;
-    const float screen_threshold_x = 0.2f;
-    const float screen_threshold_y = 0.2f;
-
-    // TODO (sessamekesh): Adjust these formulas to be correct!
-    if (xpct < screen_threshold_x) {
-      float scroll_strength = glm::sqrt(1.f - (xpct / screen_threshold_x));
-      ctx_camera_inputs.lookAtAdjustment +=
-          ctx_camera.arenaCamera.screen_right() * mvt_speed * dt *
-          scroll_strength;
-    } else if (xpct > (1.f - screen_threshold_x)) {
-      float scroll_strength =
-          glm::sqrt((xpct - (1.f - screen_threshold_x)) / screen_threshold_x);
-      ctx_camera_inputs.lookAtAdjustment -=
-          ctx_camera.arenaCamera.screen_right() * mvt_speed * dt *
-          scroll_strength;
-    }
-
-    if (ypct < screen_threshold_y) {
-      float scroll_strength = glm::sqrt(1.f - (ypct / screen_threshold_y));
-      ctx_camera_inputs.lookAtAdjustment +=
-          ctx_camera.arenaCamera.screen_up() * mvt_speed * dt * scroll_strength;
-    } else if (ypct > (1.f - screen_threshold_y)) {
-      float scroll_strength =
-          glm::sqrt((ypct - (1.f - screen_threshold_y)) / screen_threshold_y);
-      ctx_camera_inputs.lookAtAdjustment -=
-          ctx_camera.arenaCamera.screen_up() * mvt_speed * dt * scroll_strength;
-    }
+    glm::vec2 screen_pct(
+        mouse_pos.get().x / ctx_render_components.viewportWidth,
+        mouse_pos.get().y / ctx_render_components.viewportHeight);
+    ctx_camera_inputs.lookAtAdjustment +=
+        render::UpdateArenaCameraSystem::edge_pan(ctx_camera.arenaCamera,
+                                                  screen_pct, dt);
   }
 
   // Handle events...
@@ -8,18 +8,26 @@ using namespace pve;
 using namespace indigo;
 using namespace core;
 
-indigo::igecs::Scheduler UpdateClientScheduler::build() {
+indigo::igecs::Scheduler UpdateClientScheduler::build_frame() {
   auto builder = igecs::Scheduler::Builder();
   builder.max_spin_time(std::chrono::milliseconds(20));
 
-  auto process_user_input = builder.add_node()
-                                .with_decl(ProcessUserInputSystem::decl())
-                                .build(ProcessUserInputSystem::update);
+  builder.add_node()
+      .with_decl(ProcessUserInputSystem::decl())
+      .build(ProcessUserInputSystem::update);
 
-  auto stage_client_messages = builder.add_node()
-                                   .with_decl(StageClientMessageSystem::decl())
-                                   .depends_on(process_user_input)
-                                   .build(StageClientMessageSystem::run);
+  return builder.build();
+}
+
+indigo::igecs::Scheduler UpdateClientScheduler::build_tick() {
+  auto builder = igecs::Scheduler::Builder();
+  builder.max_spin_time(std::chrono::milliseconds(20));
+
+  // Messages enqueued by the frame scheduler wait in the event queue until the
+  //  next tick
+  builder.add_node()
+      .with_decl(StageClientMessageSystem::decl())
+      .build(StageClientMessageSystem::run);
 
   return builder.build();
 }
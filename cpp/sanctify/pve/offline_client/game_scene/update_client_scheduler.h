@@ -7,7 +7,11 @@ namespace sanctify::pve {
 
 class UpdateClientScheduler {
  public:
-  static indigo::igecs::Scheduler build();
+  /** Runs once per rendered frame, with the frame time elapsed (user input) */
+  static indigo::igecs::Scheduler build_frame();
+
+  /** Runs once per fixed simulation tick, with the tick time elapsed */
+  static indigo::igecs::Scheduler build_tick();
 };
 
 }  // namespace sanctify::pve
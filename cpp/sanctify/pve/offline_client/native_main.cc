@@ -79,6 +79,8 @@ int main() {
   sanctify::pve::pb::PveOfflineClientConfig config{};
   config.mutable_render_settings()->set_swap_chain_resize_latency(0.5f);
   config.mutable_debug_settings()->set_frame_time(1.f / 60.f);
+  config.mutable_asset_cache_settings()->set_directory(".igcache");
+  config.mutable_asset_cache_settings()->set_max_size_mb(512u);
 
   auto app =
       sanctify::pve::OfflineClientApp::Create(config.SerializeAsString());
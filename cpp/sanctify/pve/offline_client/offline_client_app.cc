@@ -93,6 +93,8 @@ void OfflineClientApp::update(float dt) {
 }
 
 void OfflineClientApp::render() {
+  base_->process_gpu_events();
+
   int vp_w = 0, vp_h = 0;
 #ifdef EMSCRIPTEN
   emscripten_get_canvas_element_size("#app_canvas", &vp_w, &vp_h);
@@ -29,10 +29,12 @@ CommonRenderLoadingUtil::setup_ubos_and_hdr_state(
           return {"Failed to prepare solid_static world state"};
         }
 
+        auto staging = std::make_shared<iggpu::UniformStagingBuffer>(
+            device, 3u * iggpu::UniformArena::kDefaultAlignment);
         world->set<render::CtxMainCameraCommonUbos>(
-            render::CameraCommonVsUbo(device),
-            render::CameraCommonFsUbo(device),
-            render::CommonLightingUbo(device));
+            staging, render::CameraCommonVsUbo(staging),
+            render::CameraCommonFsUbo(staging),
+            render::CommonLightingUbo(staging));
 
         return empty_maybe{};
       });
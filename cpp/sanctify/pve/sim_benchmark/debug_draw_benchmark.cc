@@ -0,0 +1,232 @@
+#include "debug_draw_benchmark.h"
+
+#include <common/render/debug_draw/debug_draw_list.h>
+#include <igasync/task_list.h>
+#include <igcore/config.h>
+#include <igcore/pod_vector.h>
+
+#ifdef IG_ENABLE_THREADS
+#include <igasync/executor_thread.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+using namespace sanctify;
+using namespace pve;
+using namespace indigo;
+using namespace core;
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr float kArenaHalfSize = 400.f;
+
+// Lines recorded by one task - large enough that the task list overhead is
+//  noise, small enough to spread 100k lines over a handful of workers
+constexpr uint32_t kLinesPerChunk = 4096u;
+
+struct LineSource {
+  PodVector<glm::vec3> points;
+  PodVector<uint32_t> colors;
+};
+
+// Generated up front so the RNG is not part of the timed recording
+LineSource make_lines(const DebugDrawBenchmarkParams& params) {
+  std::mt19937 rng(params.seed);
+  std::uniform_real_distribution<float> coord(-kArenaHalfSize, kArenaHalfSize);
+  std::uniform_real_distribution<float> offset(-4.f, 4.f);
+  std::uniform_int_distribution<uint32_t> color(0u, 0xFFFFFFFFu);
+
+  LineSource source;
+  source.points.resize(params.lineCount * 2u);
+  source.colors.resize(params.lineCount);
+  for (uint32_t i = 0; i < params.lineCount; i++) {
+    glm::vec3 start(coord(rng), 0.f, coord(rng));
+    source.points[i * 2u] = start;
+    source.points[i * 2u + 1u] =
+        start + glm::vec3(offset(rng), offset(rng), offset(rng));
+    source.colors[i] = color(rng);
+  }
+
+  return source;
+}
+
+void record_chunk(render::DebugDrawList& list, const LineSource& source,
+                  uint32_t chunk, uint32_t line_count) {
+  uint32_t first = chunk * kLinesPerChunk;
+  uint32_t last = std::min(first + kLinesPerChunk, line_count);
+  for (uint32_t i = first; i < last; i++) {
+    list.line(source.points[i * 2u], source.points[i * 2u + 1u],
+              source.colors[i]);
+  }
+}
+
+void record_frame(render::DebugDrawList& list, const LineSource& source,
+                  uint32_t line_count, std::shared_ptr<TaskList> any_thread) {
+  const uint32_t chunk_count =
+      (line_count + kLinesPerChunk - 1u) / kLinesPerChunk;
+  if (chunk_count > 1u && any_thread != nullptr) {
+    std::atomic_uint32_t remaining(chunk_count - 1u);
+    for (uint32_t i = 1u; i < chunk_count; i++) {
+      any_thread->add_task(
+          Task::of([&list, &source, &remaining, i, line_count]() {
+            ::record_chunk(list, source, i, line_count);
+            remaining--;
+          }));
+    }
+
+    ::record_chunk(list, source, 0u, line_count);
+    while (remaining > 0u) {
+      if (!any_thread->execute_next()) {
+        std::this_thread::yield();
+      }
+    }
+  } else {
+    for (uint32_t i = 0u; i < chunk_count; i++) {
+      ::record_chunk(list, source, i, line_count);
+    }
+  }
+}
+
+// Stand-in for DebugDrawBuffers::upload - one contiguous copy per primitive
+//  type, straight out of the draw list arenas
+uint64_t flush(const render::DebugDrawList& list, PodVector<uint8_t>& staging) {
+  uint64_t line_bytes =
+      static_cast<uint64_t>(list.lines().size()) *
+      sizeof(render::DebugLineInstance);
+  uint64_t circle_bytes =
+      static_cast<uint64_t>(list.circles().size()) *
+      sizeof(render::DebugCircleInstance);
+  uint64_t box_bytes = static_cast<uint64_t>(list.boxes().size()) *
+                       sizeof(render::DebugBoxInstance);
+
+  uint64_t total_bytes = line_bytes + circle_bytes + box_bytes;
+  if (staging.size() < total_bytes) {
+    staging.resize(static_cast<uint32_t>(total_bytes));
+  }
+
+  uint8_t* out = staging.raw();
+  std::memcpy(out, list.lines().data(), line_bytes);
+  std::memcpy(out + line_bytes, list.circles().data(), circle_bytes);
+  std::memcpy(out + line_bytes + circle_bytes, list.boxes().data(), box_bytes);
+
+  return total_bytes;
+}
+
+double ms_since(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+DebugDrawBenchmarkResults DebugDrawBenchmark::Run(
+    DebugDrawBenchmarkParams params) {
+  DebugDrawBenchmarkResults results{};
+  results.params = params;
+
+  LineSource source = ::make_lines(params);
+
+  auto any_thread = std::make_shared<TaskList>();
+#ifdef IG_ENABLE_THREADS
+  Vector<std::shared_ptr<ExecutorThread>> workers(params.workerCount);
+  for (uint32_t i = 0; i < params.workerCount; i++) {
+    workers.push_back(std::make_shared<ExecutorThread>());
+    workers[i]->add_task_list(any_thread);
+  }
+#else
+  results.params.workerCount = 0u;
+  any_thread = nullptr;
+#endif
+
+  render::DebugDrawList list;
+  PodVector<uint8_t> staging;
+
+  // Warmup - lets the draw list grow to fit a whole frame
+  ::record_frame(list, source, params.lineCount, nullptr);
+  list.begin_frame();
+
+  double serial_ms = 0.;
+  double parallel_ms = 0.;
+  double flush_ms = 0.;
+  uint32_t dropped_count = 0u;
+  for (uint32_t frame = 0; frame < params.frameCount; frame++) {
+    auto start = Clock::now();
+    ::record_frame(list, source, params.lineCount, nullptr);
+    serial_ms += ::ms_since(start);
+    dropped_count += list.dropped_count();
+    list.begin_frame();
+
+    start = Clock::now();
+    ::record_frame(list, source, params.lineCount, any_thread);
+    parallel_ms += ::ms_since(start);
+    dropped_count += list.dropped_count();
+
+    start = Clock::now();
+    results.flushBytesPerFrame = ::flush(list, staging);
+    flush_ms += ::ms_since(start);
+    list.begin_frame();
+  }
+
+#ifdef IG_ENABLE_THREADS
+  for (int i = 0; i < workers.size(); i++) {
+    workers[i]->clear_all_task_lists();
+  }
+#endif
+
+  double frames = params.frameCount > 0u ? params.frameCount : 1.;
+  results.serialRecordMs = serial_ms / frames;
+  results.parallelRecordMs = parallel_ms / frames;
+  results.flushMs = flush_ms / frames;
+  results.serialNsPerLine =
+      params.lineCount > 0u
+          ? results.serialRecordMs * 1000000. / params.lineCount
+          : 0.;
+  results.parallelNsPerLine =
+      params.lineCount > 0u
+          ? results.parallelRecordMs * 1000000. / params.lineCount
+          : 0.;
+  results.droppedCount = dropped_count;
+
+  return results;
+}
+
+void DebugDrawBenchmark::write_text(std::ostream& o,
+                                    const DebugDrawBenchmarkResults& results) {
+  o << std::fixed << std::setprecision(3);
+  o << "Debug draw lines: " << results.params.lineCount
+    << ", frames: " << results.params.frameCount
+    << ", workers: " << results.params.workerCount << "\n";
+  o << "  record (serial):   " << results.serialRecordMs << "ms/frame ("
+    << results.serialNsPerLine << " ns/line)\n";
+  o << "  record (parallel): " << results.parallelRecordMs << "ms/frame ("
+    << results.parallelNsPerLine << " ns/line)\n";
+  o << "  flush:             " << results.flushMs << "ms/frame ("
+    << results.flushBytesPerFrame << " bytes)\n";
+  o << "Dropped: " << results.droppedCount << "\n";
+  o << std::defaultfloat;
+}
+
+void DebugDrawBenchmark::write_json(std::ostream& o,
+                                    const DebugDrawBenchmarkResults& results) {
+  o << std::setprecision(6);
+  o << "{\n";
+  o << "  \"line_count\": " << results.params.lineCount << ",\n";
+  o << "  \"frame_count\": " << results.params.frameCount << ",\n";
+  o << "  \"worker_count\": " << results.params.workerCount << ",\n";
+  o << "  \"seed\": " << results.params.seed << ",\n";
+  o << "  \"serial_record_ms\": " << results.serialRecordMs << ",\n";
+  o << "  \"parallel_record_ms\": " << results.parallelRecordMs << ",\n";
+  o << "  \"flush_ms\": " << results.flushMs << ",\n";
+  o << "  \"serial_ns_per_line\": " << results.serialNsPerLine << ",\n";
+  o << "  \"parallel_ns_per_line\": " << results.parallelNsPerLine << ",\n";
+  o << "  \"flush_bytes_per_frame\": " << results.flushBytesPerFrame << ",\n";
+  o << "  \"dropped_count\": " << results.droppedCount << "\n";
+  o << "}\n";
+}
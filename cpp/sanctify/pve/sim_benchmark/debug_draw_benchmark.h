@@ -0,0 +1,54 @@
+#ifndef SANCTIFY_PVE_SIM_BENCHMARK_DEBUG_DRAW_BENCHMARK_H
+#define SANCTIFY_PVE_SIM_BENCHMARK_DEBUG_DRAW_BENCHMARK_H
+
+/**
+ * Debug draw microbenchmark - records line segments into a DebugDrawList
+ *  every frame, from one thread and then split across worker threads, and
+ *  times the per-frame flush (copying every recorded instance into one staging
+ *  buffer, which is what the client hands to a single GPU buffer write).
+ *  Does not need a GPU or any assets.
+ */
+
+#include <cstdint>
+#include <ostream>
+
+namespace sanctify::pve {
+
+struct DebugDrawBenchmarkParams {
+  uint32_t lineCount;
+  uint32_t frameCount;
+  uint32_t workerCount;
+  uint32_t seed;
+};
+
+struct DebugDrawBenchmarkResults {
+  DebugDrawBenchmarkParams params;
+
+  // Averaged over every frame
+  double serialRecordMs;
+  double parallelRecordMs;
+  double flushMs;
+
+  double serialNsPerLine;
+  double parallelNsPerLine;
+
+  uint64_t flushBytesPerFrame;
+
+  // Lines that did not fit in the draw list after the warmup frame (should
+  //  always be 0, the list grows to the last frame's demand)
+  uint32_t droppedCount;
+};
+
+class DebugDrawBenchmark {
+ public:
+  static DebugDrawBenchmarkResults Run(DebugDrawBenchmarkParams params);
+
+  static void write_text(std::ostream& o,
+                         const DebugDrawBenchmarkResults& results);
+  static void write_json(std::ostream& o,
+                         const DebugDrawBenchmarkResults& results);
+};
+
+}  // namespace sanctify::pve
+
+#endif
@@ -0,0 +1,163 @@
+#include "locomotion_kernel_benchmark.h"
+
+#include <common/logic/locomotion/locomotion_kernel.h>
+#include <common/logic/locomotion/locomotion_system.h>
+#include <common/logic/update_common/tick_time_elapsed.h>
+#include <igcore/pod_vector.h>
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+using namespace sanctify;
+using namespace pve;
+using namespace indigo;
+using namespace core;
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr float kArenaHalfSize = 100.f;
+constexpr uint32_t kWaypointsPerPath = 6u;
+
+struct WalkerWorld {
+  entt::registry world;
+  std::mt19937 rng;
+  PodVector<entt::entity> entities;
+};
+
+void give_path(WalkerWorld* w, igecs::WorldView* wv, entt::entity e) {
+  std::uniform_real_distribution<float> coord(-kArenaHalfSize, kArenaHalfSize);
+
+  glm::vec2 waypoints[kWaypointsPerPath];
+  for (uint32_t i = 0; i < kWaypointsPerPath; i++) {
+    waypoints[i] = glm::vec2(coord(w->rng), coord(w->rng));
+  }
+  logic::LocomotionUtil::set_waypoints(wv, e, waypoints, kWaypointsPerPath);
+}
+
+void setup_world(WalkerWorld* w,
+                 const LocomotionKernelBenchmarkParams& params) {
+  w->rng.seed(params.seed);
+  std::uniform_real_distribution<float> coord(-kArenaHalfSize, kArenaHalfSize);
+  std::uniform_real_distribution<float> speed(2.f, 8.f);
+
+  auto wv = igecs::WorldView::Thin(&w->world);
+  for (uint32_t i = 0; i < params.entityCount; i++) {
+    auto e = w->world.create();
+    logic::LocomotionUtil::attach_locomotion_components(
+        &wv, e, glm::vec2(coord(w->rng), coord(w->rng)), speed(w->rng));
+    ::give_path(w, &wv, e);
+    w->entities.push_back(e);
+  }
+}
+
+// Keep every entity walking, so each tick processes the full entity count.
+//  Both worlds repath in the same order from the same seed, so they stay in
+//  lockstep (up to kernel tolerance).
+void repath_idle_entities(WalkerWorld* w) {
+  auto wv = igecs::WorldView::Thin(&w->world);
+  for (int i = 0; i < w->entities.size(); i++) {
+    entt::entity e = w->entities[i];
+    if (!w->world.all_of<logic::NavWaypointListComponent>(e)) {
+      ::give_path(w, &wv, e);
+    }
+  }
+}
+
+template <typename UpdateFnT>
+double run_ticks(WalkerWorld* w, const LocomotionKernelBenchmarkParams& params,
+                 UpdateFnT update_fn) {
+  auto thin_wv = igecs::WorldView::Thin(&w->world);
+  auto wv = logic::LocomotionSystem::decl().create(&w->world);
+
+  double total_ms = 0.;
+  for (uint32_t tick = 0; tick < params.tickCount; tick++) {
+    logic::FrameTimeElapsedUtil::mark_time_elapsed(&thin_wv,
+                                                   params.tickSeconds);
+
+    auto start = Clock::now();
+    update_fn(&wv);
+    total_ms +=
+        std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    ::repath_idle_entities(w);
+  }
+
+  return total_ms;
+}
+}  // namespace
+
+LocomotionKernelBenchmarkResults LocomotionKernelBenchmark::Run(
+    LocomotionKernelBenchmarkParams params) {
+  WalkerWorld batched{}, scalar{};
+  ::setup_world(&batched, params);
+  ::setup_world(&scalar, params);
+
+  LocomotionKernelBenchmarkResults results{};
+  results.params = params;
+  results.instructionSet = logic::LocomotionKernel::instruction_set();
+  results.laneWidth = logic::LocomotionKernel::lane_width();
+
+  results.batchedMs =
+      ::run_ticks(&batched, params, logic::LocomotionSystem::update);
+  results.scalarMs =
+      ::run_ticks(&scalar, params, logic::LocomotionSystem::update_scalar);
+
+  double entity_updates =
+      static_cast<double>(params.entityCount) * params.tickCount;
+  results.batchedEntitiesPerMs =
+      results.batchedMs > 0. ? entity_updates / results.batchedMs : 0.;
+  results.scalarEntitiesPerMs =
+      results.scalarMs > 0. ? entity_updates / results.scalarMs : 0.;
+
+  results.maxPositionError = 0.f;
+  for (int i = 0; i < batched.entities.size(); i++) {
+    glm::vec2 batched_pos =
+        batched.world.get<logic::MapLocationComponent>(batched.entities[i])
+            .position;
+    glm::vec2 scalar_pos =
+        scalar.world.get<logic::MapLocationComponent>(scalar.entities[i])
+            .position;
+    results.maxPositionError = glm::max(results.maxPositionError,
+                                        glm::length(batched_pos - scalar_pos));
+  }
+
+  return results;
+}
+
+void LocomotionKernelBenchmark::write_text(
+    std::ostream& o, const LocomotionKernelBenchmarkResults& results) {
+  o << std::fixed << std::setprecision(2);
+  o << "Locomotion kernel: " << results.instructionSet << " ("
+    << results.laneWidth << " lanes)\n";
+  o << "Entities: " << results.params.entityCount
+    << ", ticks: " << results.params.tickCount << "\n";
+  o << "  batched: " << results.batchedMs << "ms ("
+    << results.batchedEntitiesPerMs << " entities/ms)\n";
+  o << "  scalar:  " << results.scalarMs << "ms ("
+    << results.scalarEntitiesPerMs << " entities/ms)\n";
+  o << std::scientific << std::setprecision(3)
+    << "Max position error: " << results.maxPositionError << "\n";
+  o << std::defaultfloat;
+}
+
+void LocomotionKernelBenchmark::write_json(
+    std::ostream& o, const LocomotionKernelBenchmarkResults& results) {
+  o << std::setprecision(6);
+  o << "{\n";
+  o << "  \"instruction_set\": \"" << results.instructionSet << "\",\n";
+  o << "  \"lane_width\": " << results.laneWidth << ",\n";
+  o << "  \"entity_count\": " << results.params.entityCount << ",\n";
+  o << "  \"tick_count\": " << results.params.tickCount << ",\n";
+  o << "  \"tick_seconds\": " << results.params.tickSeconds << ",\n";
+  o << "  \"seed\": " << results.params.seed << ",\n";
+  o << "  \"batched_ms\": " << results.batchedMs << ",\n";
+  o << "  \"scalar_ms\": " << results.scalarMs << ",\n";
+  o << "  \"batched_entities_per_ms\": " << results.batchedEntitiesPerMs
+    << ",\n";
+  o << "  \"scalar_entities_per_ms\": " << results.scalarEntitiesPerMs
+    << ",\n";
+  o << "  \"max_position_error\": " << results.maxPositionError << "\n";
+  o << "}\n";
+}
@@ -0,0 +1,51 @@
+#ifndef SANCTIFY_PVE_SIM_BENCHMARK_LOCOMOTION_KERNEL_BENCHMARK_H
+#define SANCTIFY_PVE_SIM_BENCHMARK_LOCOMOTION_KERNEL_BENCHMARK_H
+
+/**
+ * Locomotion-only microbenchmark - compares the batched (SIMD) locomotion
+ *  update against the one-entity-at-a-time scalar reference on identical
+ *  worlds of randomly walking entities. Does not need a navmesh.
+ */
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace sanctify::pve {
+
+struct LocomotionKernelBenchmarkParams {
+  uint32_t entityCount;
+  uint32_t tickCount;
+  float tickSeconds;
+  uint32_t seed;
+};
+
+struct LocomotionKernelBenchmarkResults {
+  LocomotionKernelBenchmarkParams params;
+
+  std::string instructionSet;
+  uint32_t laneWidth;
+
+  double batchedMs;
+  double scalarMs;
+  double batchedEntitiesPerMs;
+  double scalarEntitiesPerMs;
+
+  // Largest position difference between the two worlds at the end of the run
+  float maxPositionError;
+};
+
+class LocomotionKernelBenchmark {
+ public:
+  static LocomotionKernelBenchmarkResults Run(
+      LocomotionKernelBenchmarkParams params);
+
+  static void write_text(std::ostream& o,
+                         const LocomotionKernelBenchmarkResults& results);
+  static void write_json(std::ostream& o,
+                         const LocomotionKernelBenchmarkResults& results);
+};
+
+}  // namespace sanctify::pve
+
+#endif
@@ -0,0 +1,440 @@
+#include <igasset/igpack_loader.h>
+#include <igasync/task_list.h>
+#include <igcore/log.h>
+
+#include <CLI/CLI.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include "debug_draw_benchmark.h"
+#include "locomotion_kernel_benchmark.h"
+#include "picking_benchmark.h"
+#include "sim_benchmark.h"
+#include "terrain_lod_benchmark.h"
+#include "visibility_benchmark.h"
+
+using namespace indigo;
+using namespace core;
+using namespace sanctify;
+using namespace pve;
+
+//
+// Global allocation counting - this binary exists only for measurement, so
+//  replacing the global operator new is acceptable here (and only here!)
+//
+namespace {
+std::atomic<uint64_t> gAllocationCount{0};
+
+uint64_t allocation_count() {
+  return gAllocationCount.load(std::memory_order_relaxed);
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+  gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+const char* kLogLabel = "sim-benchmark";
+
+// The benchmark is single threaded - spin the loading task list on this thread
+//  until "finished" is set by a loading callback
+void run_until_finished(TaskList& task_list, const bool& finished) {
+  while (!finished) {
+    if (!task_list.execute_next()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+Maybe<asset::pb::TerrainChunksDef> load_terrain_chunks_def(
+    const asset::IgpackLoader& loader, const std::string& chunks_name,
+    std::shared_ptr<TaskList> task_list) {
+  Maybe<asset::pb::TerrainChunksDef> chunks_def;
+  bool load_finished = false;
+  loader.extract_terrain_chunks_def(chunks_name, task_list)
+      ->consume(
+          [&chunks_def, &load_finished,
+           &chunks_name](asset::IgpackLoader::ExtractTerrainChunksDefT rsl) {
+            load_finished = true;
+            if (rsl.is_right()) {
+              Logger::err(kLogLabel)
+                  << "Failed to load terrain chunks " << chunks_name << ": "
+                  << asset::to_string(rsl.get_right());
+              return;
+            }
+            chunks_def = rsl.left_move();
+          },
+          task_list);
+
+  run_until_finished(*task_list, load_finished);
+  return chunks_def;
+}
+
+// Decode LOD 0 of every terrain chunk into one triangle list
+bool load_terrain_lod0_geo(const asset::IgpackLoader& loader,
+                           const asset::pb::TerrainChunksDef& chunks_def,
+                           std::shared_ptr<TaskList> task_list,
+                           PodVector<glm::vec3>& o_positions,
+                           PodVector<uint32_t>& o_indices) {
+  for (const auto& chunk : chunks_def.chunks()) {
+    if (chunk.lods_size() == 0) {
+      continue;
+    }
+
+    const std::string& geo_name = chunk.lods(0).geo_igasset_name();
+    bool load_finished = false;
+    bool load_failed = false;
+    loader.extract_draco_geo(geo_name, task_list)
+        ->consume(
+            [&](asset::IgpackLoader::ExtractDracoBufferT rsl) {
+              load_finished = true;
+              if (rsl.is_right()) {
+                load_failed = true;
+                return;
+              }
+
+              auto pos_norm_rsl = rsl.get_left()->get_pos_norm_data();
+              auto indices_rsl = rsl.get_left()->get_index_data();
+              if (pos_norm_rsl.is_right() || indices_rsl.is_right()) {
+                load_failed = true;
+                return;
+              }
+
+              const auto& vertices = pos_norm_rsl.get_left();
+              const auto& indices = indices_rsl.get_left();
+              uint32_t base_vertex = o_positions.size();
+              for (int i = 0; i < vertices.size(); i++) {
+                o_positions.push_back(vertices[i].Position);
+              }
+              for (int i = 0; i < indices.size(); i++) {
+                o_indices.push_back(base_vertex + indices[i]);
+              }
+            },
+            task_list);
+
+    run_until_finished(*task_list, load_finished);
+    if (load_failed) {
+      Logger::err(kLogLabel) << "Failed to load terrain geo " << geo_name;
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  CLI::App app{"Sanctify headless simulation benchmark"};
+
+  std::string igpack_path = "resources/terrain-pve.igpack";
+  std::string navmesh_name = "pve-arena-navmesh";
+  std::string json_out_path = "";
+  bool json_output = false;
+
+  SimBenchmarkParams params{};
+  params.agentCount = 500u;
+  params.tickCount = 5000u;
+  params.warmupTickCount = 250u;
+  params.tickSeconds = 8.f / 1000.f;
+  params.seed = 1337u;
+  params.snapshotInterval = 1u;
+  params.maxNavRequestsPerTick = 64u;
+
+  app.add_option("--igpack", igpack_path, "Asset pack containing the navmesh");
+  app.add_option("--navmesh", navmesh_name, "Navmesh asset name in the pack");
+  app.add_option("-a,--agents", params.agentCount, "Scripted agent count");
+  app.add_option("-n,--ticks", params.tickCount, "Measured tick count");
+  app.add_option("--warmup_ticks", params.warmupTickCount,
+                 "Ticks to run before measurement starts");
+  app.add_option("--tick_seconds", params.tickSeconds,
+                 "Simulated length of a single tick");
+  app.add_option("--seed", params.seed, "Agent spawn/destination RNG seed");
+  app.add_option("--snapshot_interval", params.snapshotInterval,
+                 "Capture a netsync snapshot every this many ticks");
+  app.add_option("--max_nav_requests_per_tick", params.maxNavRequestsPerTick,
+                 "Cap on navmesh path queries issued per tick");
+  bool locomotion_kernel_only = false;
+  app.add_flag("--locomotion_kernel", locomotion_kernel_only,
+               "Only compare batched/scalar locomotion updates (no navmesh)");
+  bool visibility_only = false;
+  VisibilityBenchmarkParams visibility_params{};
+  visibility_params.entityCount = 50000u;
+  visibility_params.frameCount = 1000u;
+  visibility_params.workerCount =
+      std::max(std::thread::hardware_concurrency(), 2u) - 1u;
+  app.add_flag("--visibility", visibility_only,
+               "Only measure frustum culling of renderables (no navmesh)");
+  app.add_option("--renderables", visibility_params.entityCount,
+                 "Renderable count for --visibility");
+  app.add_option("--frames", visibility_params.frameCount,
+                 "Measured frame count for --visibility, --terrain, "
+                 "--picking and --debug_draw");
+  app.add_option("--workers", visibility_params.workerCount,
+                 "Worker thread count for --visibility parallel culling and "
+                 "--debug_draw parallel recording");
+  bool terrain_only = false;
+  std::string terrain_igpack_path = "resources/arena-base.igpack";
+  std::string terrain_chunks_name = "arenaTerrainChunks";
+  TerrainLodBenchmarkParams terrain_params{};
+  terrain_params.frameCount = 1000u;
+  // Half, default, and double the offline client zoom
+  terrain_params.zoomRadii = {22.5f, 45.f, 90.f};
+  app.add_flag("--terrain", terrain_only,
+               "Only measure terrain triangles submitted per frame, with and "
+               "without chunk culling and LOD selection (no navmesh)");
+  app.add_option("--terrain_igpack", terrain_igpack_path,
+                 "Asset pack containing the terrain chunks for --terrain and "
+                 "--picking");
+  app.add_option("--terrain_chunks", terrain_chunks_name,
+                 "Terrain chunks asset name in the pack for --terrain and "
+                 "--picking");
+  app.add_option("--zooms", terrain_params.zoomRadii,
+                 "Arena camera radii measured by --terrain");
+  bool picking_only = false;
+  PickingBenchmarkParams picking_params{};
+  picking_params.rayCount = 1000000u;
+  picking_params.bruteForceRayCount = 10000u;
+  app.add_flag("--picking", picking_only,
+               "Only measure ray picking against the terrain BVH and a unit "
+               "grid of --agents units (no navmesh)");
+  app.add_option("--rays", picking_params.rayCount,
+                 "Number of rays cast by --picking");
+  bool debug_draw_only = false;
+  DebugDrawBenchmarkParams debug_draw_params{};
+  debug_draw_params.lineCount = 100000u;
+  app.add_flag("--debug_draw", debug_draw_only,
+               "Only measure recording and flushing debug draw lines (no "
+               "navmesh)");
+  app.add_option("--lines", debug_draw_params.lineCount,
+                 "Line segments recorded per frame by --debug_draw");
+  app.add_flag("--json", json_output, "Write results as JSON to stdout");
+  app.add_option("--json_out", json_out_path,
+                 "Write JSON results to this file (in addition to stdout)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  if (params.snapshotInterval == 0u) {
+    params.snapshotInterval = 1u;
+  }
+
+  if (locomotion_kernel_only) {
+    LocomotionKernelBenchmarkParams kernel_params{};
+    kernel_params.entityCount = params.agentCount;
+    kernel_params.tickCount = params.tickCount;
+    kernel_params.tickSeconds = params.tickSeconds;
+    kernel_params.seed = params.seed;
+
+    auto kernel_results = LocomotionKernelBenchmark::Run(kernel_params);
+    if (json_output) {
+      LocomotionKernelBenchmark::write_json(std::cout, kernel_results);
+    } else {
+      LocomotionKernelBenchmark::write_text(std::cout, kernel_results);
+    }
+
+    if (json_out_path != "") {
+      std::ofstream fout(json_out_path);
+      if (!fout) {
+        Logger::err(kLogLabel) << "Could not open " << json_out_path;
+        return -1;
+      }
+      LocomotionKernelBenchmark::write_json(fout, kernel_results);
+    }
+
+    return 0;
+  }
+
+  if (visibility_only) {
+    visibility_params.seed = params.seed;
+
+    auto visibility_results = VisibilityBenchmark::Run(visibility_params);
+    if (json_output) {
+      VisibilityBenchmark::write_json(std::cout, visibility_results);
+    } else {
+      VisibilityBenchmark::write_text(std::cout, visibility_results);
+    }
+
+    if (json_out_path != "") {
+      std::ofstream fout(json_out_path);
+      if (!fout) {
+        Logger::err(kLogLabel) << "Could not open " << json_out_path;
+        return -1;
+      }
+      VisibilityBenchmark::write_json(fout, visibility_results);
+    }
+
+    return 0;
+  }
+
+  if (terrain_only) {
+    terrain_params.frameCount = visibility_params.frameCount;
+
+    auto task_list = std::make_shared<TaskList>();
+    asset::IgpackLoader loader(terrain_igpack_path, task_list);
+
+    auto chunks_def =
+        ::load_terrain_chunks_def(loader, terrain_chunks_name, task_list);
+    if (chunks_def.is_empty()) {
+      return -1;
+    }
+
+    auto terrain_results =
+        TerrainLodBenchmark::Run(terrain_params, chunks_def.get());
+    if (json_output) {
+      TerrainLodBenchmark::write_json(std::cout, terrain_results);
+    } else {
+      TerrainLodBenchmark::write_text(std::cout, terrain_results);
+    }
+
+    if (json_out_path != "") {
+      std::ofstream fout(json_out_path);
+      if (!fout) {
+        Logger::err(kLogLabel) << "Could not open " << json_out_path;
+        return -1;
+      }
+      TerrainLodBenchmark::write_json(fout, terrain_results);
+    }
+
+    return 0;
+  }
+
+  if (picking_only) {
+    picking_params.unitCount = params.agentCount;
+    picking_params.frameCount = visibility_params.frameCount;
+    picking_params.seed = params.seed;
+
+    auto task_list = std::make_shared<TaskList>();
+    asset::IgpackLoader loader(terrain_igpack_path, task_list);
+
+    auto chunks_def =
+        ::load_terrain_chunks_def(loader, terrain_chunks_name, task_list);
+    if (chunks_def.is_empty()) {
+      return -1;
+    }
+
+    PodVector<glm::vec3> terrain_positions;
+    PodVector<uint32_t> terrain_indices;
+    if (!::load_terrain_lod0_geo(loader, chunks_def.get(), task_list,
+                                 terrain_positions, terrain_indices)) {
+      return -1;
+    }
+
+    auto picking_results = PickingBenchmark::Run(
+        picking_params, terrain_positions, terrain_indices);
+    if (json_output) {
+      PickingBenchmark::write_json(std::cout, picking_results);
+    } else {
+      PickingBenchmark::write_text(std::cout, picking_results);
+    }
+
+    if (json_out_path != "") {
+      std::ofstream fout(json_out_path);
+      if (!fout) {
+        Logger::err(kLogLabel) << "Could not open " << json_out_path;
+        return -1;
+      }
+      PickingBenchmark::write_json(fout, picking_results);
+    }
+
+    return 0;
+  }
+
+  if (debug_draw_only) {
+    debug_draw_params.frameCount = visibility_params.frameCount;
+    debug_draw_params.workerCount = visibility_params.workerCount;
+    debug_draw_params.seed = params.seed;
+
+    auto debug_draw_results = DebugDrawBenchmark::Run(debug_draw_params);
+    if (json_output) {
+      DebugDrawBenchmark::write_json(std::cout, debug_draw_results);
+    } else {
+      DebugDrawBenchmark::write_text(std::cout, debug_draw_results);
+    }
+
+    if (json_out_path != "") {
+      std::ofstream fout(json_out_path);
+      if (!fout) {
+        Logger::err(kLogLabel) << "Could not open " << json_out_path;
+        return -1;
+      }
+      DebugDrawBenchmark::write_json(fout, debug_draw_results);
+    }
+
+    return 0;
+  }
+
+  //
+  // Load the navmesh - the benchmark is single threaded, so spin the loading
+  //  task list on this thread until it finishes.
+  //
+  auto task_list = std::make_shared<TaskList>();
+  asset::IgpackLoader loader(igpack_path, task_list);
+
+  Maybe<nav::DetourNavmesh> navmesh;
+  bool load_finished = false;
+  loader.extract_detour_navmesh(navmesh_name, task_list)
+      ->consume(
+          [&navmesh, &load_finished, &navmesh_name](
+              asset::IgpackLoader::ExtractDetourNavmeshDataT rsl) {
+            load_finished = true;
+            if (rsl.is_right()) {
+              Logger::err(kLogLabel)
+                  << "Failed to load navmesh " << navmesh_name << ": "
+                  << asset::to_string(rsl.get_right());
+              return;
+            }
+            navmesh = rsl.left_move();
+          },
+          task_list);
+
+  while (!load_finished) {
+    if (!task_list->execute_next()) {
+      std::this_thread::yield();
+    }
+  }
+
+  if (navmesh.is_empty()) {
+    return -1;
+  }
+
+  SimBenchmark benchmark(params, navmesh.get().raw(), ::allocation_count);
+  if (!benchmark.setup()) {
+    Logger::err(kLogLabel) << "Benchmark setup failed";
+    return -1;
+  }
+
+  SimBenchmarkResults results = benchmark.run();
+
+  if (json_output) {
+    SimBenchmark::write_json(std::cout, results);
+  } else {
+    SimBenchmark::write_text(std::cout, results);
+  }
+
+  if (json_out_path != "") {
+    std::ofstream fout(json_out_path);
+    if (!fout) {
+      Logger::err(kLogLabel) << "Could not open " << json_out_path;
+      return -1;
+    }
+    SimBenchmark::write_json(fout, results);
+  }
+
+  return 0;
+}
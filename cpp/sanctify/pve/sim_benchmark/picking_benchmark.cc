@@ -0,0 +1,257 @@
+#include "picking_benchmark.h"
+
+#include <common/logic/viewport/arena_camera.h>
+#include <common/picking/triangle_bvh.h>
+#include <common/picking/unit_pick_grid.h>
+
+#include <algorithm>
+#include <chrono>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+using namespace sanctify;
+using namespace pve;
+using namespace indigo;
+using namespace core;
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+// Same arena extents and camera as the terrain LOD benchmark (see
+//  terrain_lod_benchmark.cc), at the default offline client zoom
+constexpr float kArenaMinX = -172.f;
+constexpr float kArenaMaxX = 5.f;
+constexpr float kArenaHalfDepth = 16.f;
+
+const float kTiltAngle = glm::radians(35.f);
+const float kSpinAngle = glm::radians(45.f);
+const float kFovy = glm::radians(40.f);
+constexpr float kAspectRatio = 16.f / 9.f;
+constexpr float kNear = 0.1f;
+constexpr float kFar = 1000.f;
+constexpr float kCameraRadius = 45.f;
+
+constexpr float kUnitMinRadius = 0.5f;
+constexpr float kUnitMaxRadius = 1.2f;
+constexpr float kUnitWanderRadius = 2.f;
+
+logic::ArenaCamera camera_at(uint32_t frame, uint32_t frame_count) {
+  float t = static_cast<float>(frame) / std::max(frame_count - 1u, 1u);
+  glm::vec3 look_at(kArenaMinX + (kArenaMaxX - kArenaMinX) * t, 0.f,
+                    glm::sin(t * glm::two_pi<float>() * 4.f) * kArenaHalfDepth);
+  return logic::ArenaCamera(look_at, kTiltAngle, kSpinAngle, kCameraRadius);
+}
+
+struct BenchUnit {
+  glm::vec3 home;
+  float radius;
+  float phase;
+};
+
+bool same_hit(const Maybe<picking::RayHit>& a,
+              const Maybe<picking::RayHit>& b) {
+  if (a.has_value() != b.has_value()) {
+    return false;
+  }
+  if (a.is_empty()) {
+    return true;
+  }
+  return glm::abs(a.get().t - b.get().t) <=
+         0.0001f * std::max(1.f, a.get().t);
+}
+
+}  // namespace
+
+PickingBenchmarkResults PickingBenchmark::Run(
+    PickingBenchmarkParams params,
+    const PodVector<glm::vec3>& terrain_positions,
+    const PodVector<uint32_t>& terrain_indices) {
+  PickingBenchmarkResults results{};
+  results.params = params;
+
+  auto build_start = Clock::now();
+  auto bvh = picking::TriangleBvh::build(terrain_positions, terrain_indices);
+  results.bvhBuildMs = std::chrono::duration<double, std::milli>(
+                           Clock::now() - build_start)
+                           .count();
+  results.triangleCount = bvh.triangle_count();
+  results.bvhNodeCount = bvh.node_count();
+
+  //
+  // Scatter units over the walkable part of the arena, standing on the terrain
+  //
+  std::mt19937 rng(params.seed);
+  std::uniform_real_distribution<float> x_dist(kArenaMinX, kArenaMaxX);
+  std::uniform_real_distribution<float> z_dist(-kArenaHalfDepth,
+                                               kArenaHalfDepth);
+  std::uniform_real_distribution<float> radius_dist(kUnitMinRadius,
+                                                    kUnitMaxRadius);
+  std::uniform_real_distribution<float> unit_dist(0.f, 1.f);
+
+  const float sky_y = bvh.bounds_max().y + 10.f;
+  std::vector<BenchUnit> units(params.unitCount);
+  for (auto& unit : units) {
+    glm::vec3 pos(x_dist(rng), sky_y, z_dist(rng));
+    auto ground = bvh.raycast(picking::PickRay{pos, glm::vec3(0.f, -1.f, 0.f)});
+    pos.y = ground.has_value() ? pos.y - ground.get().t : 0.f;
+
+    unit.radius = radius_dist(rng);
+    unit.home = pos + glm::vec3(0.f, unit.radius, 0.f);
+    unit.phase = unit_dist(rng) * glm::two_pi<float>();
+  }
+
+  //
+  // Cast rays, a frame at a time
+  //
+  const uint32_t frame_count = std::max(params.frameCount, 1u);
+  const uint32_t rays_per_frame =
+      std::max((params.rayCount + frame_count - 1u) / frame_count, 1u);
+  glm::mat4 mat_proj = glm::perspective(kFovy, kAspectRatio, kNear, kFar);
+
+  picking::UnitPickGrid grid;
+  std::vector<picking::PickRay> rays;
+  rays.reserve(rays_per_frame);
+
+  double grid_build_ms = 0., terrain_ms = 0., unit_ms = 0., combined_ms = 0.;
+  uint64_t terrain_hits = 0u, unit_hits = 0u, combined_unit_hits = 0u;
+  uint32_t rays_cast = 0u;
+
+  for (uint32_t frame = 0; frame < frame_count && rays_cast < params.rayCount;
+       frame++) {
+    logic::ArenaCamera camera = ::camera_at(frame, frame_count);
+    glm::mat4 mat_view_proj = mat_proj * camera.mat_view();
+
+    uint32_t frame_rays = std::min(rays_per_frame, params.rayCount - rays_cast);
+    rays.clear();
+    for (uint32_t i = 0; i < frame_rays; i++) {
+      rays.push_back(picking::PickRay::from_screen(
+          mat_view_proj, camera.position(), unit_dist(rng), unit_dist(rng)));
+    }
+
+    float wander_angle = frame * 0.05f;
+    auto grid_start = Clock::now();
+    grid.clear();
+    for (uint32_t i = 0; i < units.size(); i++) {
+      const auto& unit = units[i];
+      float angle = wander_angle + unit.phase;
+      grid.add_unit(i,
+                    unit.home + glm::vec3(glm::cos(angle), 0.f,
+                                          glm::sin(angle)) *
+                                    kUnitWanderRadius,
+                    unit.radius);
+    }
+    grid.build();
+    grid_build_ms += std::chrono::duration<double, std::milli>(
+                         Clock::now() - grid_start)
+                         .count();
+
+    auto terrain_start = Clock::now();
+    for (const auto& ray : rays) {
+      if (bvh.raycast(ray).has_value()) terrain_hits++;
+    }
+    auto unit_start = Clock::now();
+    for (const auto& ray : rays) {
+      if (grid.raycast(ray).has_value()) unit_hits++;
+    }
+    auto combined_start = Clock::now();
+    for (const auto& ray : rays) {
+      auto terrain_hit = bvh.raycast(ray);
+      float max_t = terrain_hit.has_value() ? terrain_hit.get().t
+                                            : picking::kNoHit;
+      if (grid.raycast(ray, max_t).has_value()) combined_unit_hits++;
+    }
+    auto combined_end = Clock::now();
+
+    terrain_ms += std::chrono::duration<double, std::milli>(unit_start -
+                                                            terrain_start)
+                      .count();
+    unit_ms += std::chrono::duration<double, std::milli>(combined_start -
+                                                         unit_start)
+                   .count();
+    combined_ms += std::chrono::duration<double, std::milli>(combined_end -
+                                                             combined_start)
+                       .count();
+
+    for (uint32_t i = 0;
+         i < frame_rays && rays_cast + i < params.bruteForceRayCount; i++) {
+      if (!::same_hit(bvh.raycast(rays[i]),
+                      bvh.raycast_brute_force(rays[i])) ||
+          !::same_hit(grid.raycast(rays[i]),
+                      grid.raycast_brute_force(rays[i]))) {
+        results.mismatchCount++;
+      }
+    }
+
+    rays_cast += frame_rays;
+  }
+
+  const double ray_count = std::max(rays_cast, 1u);
+  results.gridBuildMs = grid_build_ms;
+  results.terrainNsPerRay = terrain_ms * 1000000. / ray_count;
+  results.unitNsPerRay = unit_ms * 1000000. / ray_count;
+  results.combinedNsPerRay = combined_ms * 1000000. / ray_count;
+  results.terrainHitFraction = terrain_hits / ray_count;
+  results.unitHitFraction = unit_hits / ray_count;
+  results.combinedUnitHitFraction = combined_unit_hits / ray_count;
+
+  return results;
+}
+
+void PickingBenchmark::write_text(std::ostream& o,
+                                  const PickingBenchmarkResults& results) {
+  auto rays_per_sec = [](double ns_per_ray) {
+    return ns_per_ray > 0. ? 1000000000. / ns_per_ray : 0.;
+  };
+
+  o << std::fixed << std::setprecision(2);
+  o << "Terrain BVH: " << results.triangleCount << " triangles, "
+    << results.bvhNodeCount << " nodes, built in " << results.bvhBuildMs
+    << "ms\n";
+  o << "Units: " << results.params.unitCount
+    << ", frames: " << results.params.frameCount
+    << ", rays: " << results.params.rayCount << "\n";
+  o << "  unit grid build: " << results.gridBuildMs << "ms total\n";
+  o << std::setprecision(1);
+  o << "  terrain:  " << results.terrainNsPerRay << "ns/ray ("
+    << rays_per_sec(results.terrainNsPerRay) << " rays/sec)\n";
+  o << "  units:    " << results.unitNsPerRay << "ns/ray ("
+    << rays_per_sec(results.unitNsPerRay) << " rays/sec)\n";
+  o << "  combined: " << results.combinedNsPerRay << "ns/ray ("
+    << rays_per_sec(results.combinedNsPerRay) << " rays/sec)\n";
+  o << std::setprecision(2);
+  o << "Hits: terrain " << results.terrainHitFraction * 100. << "%, units "
+    << results.unitHitFraction * 100. << "%, units in front of terrain "
+    << results.combinedUnitHitFraction * 100. << "%\n";
+  o << "Mismatches: " << results.mismatchCount << " (of "
+    << std::min(results.params.bruteForceRayCount, results.params.rayCount)
+    << " brute force checked rays)\n";
+  o << std::defaultfloat;
+}
+
+void PickingBenchmark::write_json(std::ostream& o,
+                                  const PickingBenchmarkResults& results) {
+  o << std::setprecision(6);
+  o << "{\n";
+  o << "  \"ray_count\": " << results.params.rayCount << ",\n";
+  o << "  \"unit_count\": " << results.params.unitCount << ",\n";
+  o << "  \"frame_count\": " << results.params.frameCount << ",\n";
+  o << "  \"seed\": " << results.params.seed << ",\n";
+  o << "  \"triangle_count\": " << results.triangleCount << ",\n";
+  o << "  \"bvh_node_count\": " << results.bvhNodeCount << ",\n";
+  o << "  \"bvh_build_ms\": " << results.bvhBuildMs << ",\n";
+  o << "  \"grid_build_ms\": " << results.gridBuildMs << ",\n";
+  o << "  \"terrain_ns_per_ray\": " << results.terrainNsPerRay << ",\n";
+  o << "  \"unit_ns_per_ray\": " << results.unitNsPerRay << ",\n";
+  o << "  \"combined_ns_per_ray\": " << results.combinedNsPerRay << ",\n";
+  o << "  \"terrain_hit_fraction\": " << results.terrainHitFraction << ",\n";
+  o << "  \"unit_hit_fraction\": " << results.unitHitFraction << ",\n";
+  o << "  \"combined_unit_hit_fraction\": "
+    << results.combinedUnitHitFraction << ",\n";
+  o << "  \"brute_force_ray_count\": " << results.params.bruteForceRayCount
+    << ",\n";
+  o << "  \"mismatch_count\": " << results.mismatchCount << "\n";
+  o << "}\n";
+}
@@ -0,0 +1,75 @@
+#ifndef SANCTIFY_PVE_SIM_BENCHMARK_PICKING_BENCHMARK_H
+#define SANCTIFY_PVE_SIM_BENCHMARK_PICKING_BENCHMARK_H
+
+/**
+ * Picking benchmark - builds a TriangleBvh over the arena terrain (LOD 0 of
+ *  every chunk in arena-base.igpack, the same geometry the offline client
+ *  draws), scatters units over it, and casts rays from random screen points
+ *  of the arena camera against the terrain, a per-frame UnitPickGrid of the
+ *  units, and both (terrain first, then units in front of the terrain hit).
+ *  Needs the terrain geometry, but no GPU.
+ */
+
+#include <igcore/pod_vector.h>
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <ostream>
+
+namespace sanctify::pve {
+
+struct PickingBenchmarkParams {
+  uint32_t rayCount;
+  uint32_t unitCount;
+
+  // Units move and the unit grid is rebuilt once per frame - rays are split
+  //  evenly between frames
+  uint32_t frameCount;
+
+  // Number of rays (from the start of the run) also checked against the brute
+  //  force implementations
+  uint32_t bruteForceRayCount;
+
+  uint32_t seed;
+};
+
+struct PickingBenchmarkResults {
+  PickingBenchmarkParams params;
+
+  uint32_t triangleCount;
+  uint32_t bvhNodeCount;
+  double bvhBuildMs;
+
+  // Total over every frame
+  double gridBuildMs;
+
+  double terrainNsPerRay;
+  double unitNsPerRay;
+  double combinedNsPerRay;
+
+  // Fraction of rays with a terrain/unit hit (combined: unit in front of the
+  //  terrain)
+  double terrainHitFraction;
+  double unitHitFraction;
+  double combinedUnitHitFraction;
+
+  // Rays where the BVH/grid disagreed with the brute force implementation
+  uint32_t mismatchCount;
+};
+
+class PickingBenchmark {
+ public:
+  static PickingBenchmarkResults Run(
+      PickingBenchmarkParams params,
+      const indigo::core::PodVector<glm::vec3>& terrain_positions,
+      const indigo::core::PodVector<uint32_t>& terrain_indices);
+
+  static void write_text(std::ostream& o,
+                         const PickingBenchmarkResults& results);
+  static void write_json(std::ostream& o,
+                         const PickingBenchmarkResults& results);
+};
+
+}  // namespace sanctify::pve
+
+#endif
@@ -0,0 +1,271 @@
+#include "sim_benchmark.h"
+
+#include <common/logic/locomotion/locomotion_system.h>
+#include <common/logic/netsync/netsync.h>
+#include <common/logic/update_common/tick_time_elapsed.h>
+#include <igcore/log.h>
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+
+#include "systems/scripted_agent_nav_system.h"
+#include "systems/snapshot_capture_system.h"
+
+#ifdef _WIN32
+// clang-format off
+#include <windows.h>
+#include <psapi.h>
+// clang-format on
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace sanctify;
+using namespace pve;
+using namespace indigo;
+using namespace core;
+
+namespace {
+const char* kLogLabel = "SimBenchmark";
+
+igecs::Scheduler build_scheduler() {
+  auto builder = igecs::Scheduler::Builder();
+  builder.max_spin_time(std::chrono::seconds(5));
+
+  auto nav_requests = builder.add_node()
+                          .with_name("ScriptedAgentNavSystem")
+                          .with_decl(ScriptedAgentNavSystem::decl())
+                          .build(ScriptedAgentNavSystem::update);
+
+  auto locomotion = builder.add_node()
+                        .with_name("LocomotionSystem")
+                        .with_decl(logic::LocomotionSystem::decl())
+                        .depends_on(nav_requests)
+                        .build(logic::LocomotionSystem::update);
+
+  auto snapshot = builder.add_node()
+                      .with_name("SnapshotCaptureSystem")
+                      .with_decl(SnapshotCaptureSystem::decl())
+                      .depends_on(locomotion)
+                      .build(SnapshotCaptureSystem::update);
+
+  return builder.build();
+}
+
+void hash_bytes(uint64_t* hash, const void* data, size_t len) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < len; i++) {
+    *hash ^= bytes[i];
+    *hash *= 1099511628211ull;
+  }
+}
+
+}  // namespace
+
+SimBenchmark::SimBenchmark(SimBenchmarkParams params, const dtNavMesh* navmesh,
+                           AllocCounterFn alloc_counter)
+    : params_(params),
+      navmesh_(navmesh),
+      alloc_counter_(alloc_counter),
+      scheduler_(::build_scheduler()) {}
+
+SimBenchmark::~SimBenchmark() {
+  auto wv = igecs::WorldView::Thin(&world_);
+  if (wv.ctx_has<CtxBenchmarkNavmesh>()) {
+    ScriptedAgentNavSystem::EcsUtil::free_navmesh_query(&wv);
+  }
+}
+
+bool SimBenchmark::setup() {
+  auto wv = igecs::WorldView::Thin(&world_);
+
+  ScriptedAgentNavSystem::EcsUtil::set_navmesh(&wv, navmesh_,
+                                               params_.maxNavRequestsPerTick);
+  wv.attach_ctx<CtxSnapshotCaptureState>(
+      CtxSnapshotCaptureState{params_.snapshotInterval, 0u, 0ull, 0ull});
+  logic::FrameTimeElapsedUtil::set_sim_time(&wv, 0.f);
+
+  uint32_t spawn_rng = params_.seed == 0u ? 1u : params_.seed;
+  for (uint32_t i = 0; i < params_.agentCount; i++) {
+    glm::vec2 spawn_point{};
+    if (!ScriptedAgentNavSystem::EcsUtil::random_navmesh_point(
+            &wv, &spawn_rng, &spawn_point)) {
+      Logger::err(kLogLabel) << "Failed to find a spawn point for agent " << i;
+      return false;
+    }
+
+    auto e = wv.create();
+    wv.attach<logic::NetSyncId>(e, i + 1u);
+    // Per-agent RNG state must never be zero (xorshift fixed point)
+    wv.attach<ScriptedAgentComponent>(e, (spawn_rng ^ (i * 2654435761u)) | 1u);
+    logic::LocomotionUtil::attach_locomotion_components(&wv, e, spawn_point,
+                                                        3.2f);
+  }
+
+  for (uint32_t i = 0; i < params_.warmupTickCount; i++) {
+    tick();
+  }
+
+  return true;
+}
+
+void SimBenchmark::tick() {
+  auto wv = igecs::WorldView::Thin(&world_);
+  logic::FrameTimeElapsedUtil::mark_time_elapsed(&wv, params_.tickSeconds);
+  scheduler_.execute(nullptr, &world_);
+}
+
+SimBenchmarkResults SimBenchmark::run() {
+  using FpSeconds = std::chrono::duration<double>;
+  using FpMillis = std::chrono::duration<double, std::milli>;
+
+  scheduler_.reset_profile();
+  {
+    auto wv = igecs::WorldView::Thin(&world_);
+    auto& nav = wv.mut_ctx<CtxBenchmarkNavmesh>();
+    nav.requestsIssued = nav.requestsFailed = 0ull;
+    auto& snapshots = wv.mut_ctx<CtxSnapshotCaptureState>();
+    snapshots.snapshotsCaptured = snapshots.bytesSerialized = 0ull;
+  }
+
+  uint64_t allocs_before = alloc_counter_ ? alloc_counter_() : 0ull;
+  auto start = std::chrono::high_resolution_clock::now();
+
+  for (uint32_t i = 0; i < params_.tickCount; i++) {
+    tick();
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  uint64_t allocs_after = alloc_counter_ ? alloc_counter_() : 0ull;
+
+  SimBenchmarkResults results{};
+  results.params = params_;
+  results.wallSeconds = FpSeconds(end - start).count();
+  results.ticksPerSecond =
+      results.wallSeconds > 0. ? params_.tickCount / results.wallSeconds : 0.;
+  results.msPerTick = params_.tickCount > 0
+                          ? results.wallSeconds * 1000. / params_.tickCount
+                          : 0.;
+
+  auto profile = scheduler_.profile();
+  for (int i = 0; i < profile.size(); i++) {
+    results.systemTimings.push_back(SimBenchmarkSystemTiming{
+        profile[i].name, profile[i].runCount,
+        FpMillis(profile[i].totalRunTime).count()});
+  }
+
+  results.allocationsPerTick =
+      (alloc_counter_ && params_.tickCount > 0)
+          ? (double)(allocs_after - allocs_before) / params_.tickCount
+          : -1.;
+  results.peakRssBytes = peak_rss_bytes();
+
+  auto wv = igecs::WorldView::Thin(&world_);
+  const auto& nav = wv.ctx<CtxBenchmarkNavmesh>();
+  results.navRequestsIssued = nav.requestsIssued;
+  results.navRequestsFailed = nav.requestsFailed;
+  const auto& snapshots = wv.ctx<CtxSnapshotCaptureState>();
+  results.snapshotsCaptured = snapshots.snapshotsCaptured;
+  results.snapshotBytes = snapshots.bytesSerialized;
+
+  results.worldChecksum = world_checksum();
+
+  return results;
+}
+
+uint64_t SimBenchmark::world_checksum() {
+  uint64_t hash = 14695981039346656037ull;
+
+  auto view = world_.view<const logic::NetSyncId,
+                          const logic::MapLocationComponent,
+                          const logic::OrientationComponent>();
+  for (auto [e, net_sync_id, map_location, orientation] : view.each()) {
+    ::hash_bytes(&hash, &net_sync_id.id, sizeof(net_sync_id.id));
+    ::hash_bytes(&hash, &map_location.position, sizeof(map_location.position));
+    ::hash_bytes(&hash, &orientation.orientation,
+                 sizeof(orientation.orientation));
+  }
+
+  return hash;
+}
+
+int64_t SimBenchmark::peak_rss_bytes() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS pmc{};
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+    return (int64_t)pmc.PeakWorkingSetSize;
+  }
+  return -1;
+#else
+  struct rusage usage {};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+#ifdef __APPLE__
+  return (int64_t)usage.ru_maxrss;
+#else
+  return (int64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+void SimBenchmark::write_text(std::ostream& o,
+                              const SimBenchmarkResults& results) {
+  o << std::fixed << std::setprecision(3);
+  o << "Agents: " << results.params.agentCount
+    << ", ticks: " << results.params.tickCount << " ("
+    << results.params.tickSeconds * 1000.f << "ms each)\n";
+  o << "  Wall time: " << results.wallSeconds << "s\n";
+  o << "  Ticks/sec: " << results.ticksPerSecond << " (" << results.msPerTick
+    << "ms per tick)\n";
+  o << "  Per-system time:\n";
+  for (int i = 0; i < results.systemTimings.size(); i++) {
+    const auto& timing = results.systemTimings[i];
+    o << "    " << timing.name << ": " << timing.totalMs << "ms total, "
+      << (timing.runCount > 0 ? timing.totalMs / timing.runCount : 0.)
+      << "ms per run\n";
+  }
+  if (results.allocationsPerTick >= 0.) {
+    o << "  Allocations/tick: " << results.allocationsPerTick << "\n";
+  }
+  if (results.peakRssBytes >= 0) {
+    o << "  Peak RSS: " << results.peakRssBytes / (1024. * 1024.) << "MB\n";
+  }
+  o << "  Nav requests: " << results.navRequestsIssued << " ("
+    << results.navRequestsFailed << " failed)\n";
+  o << "  Snapshots: " << results.snapshotsCaptured << " ("
+    << results.snapshotBytes << " bytes)\n";
+  o << "  World checksum: " << std::hex << results.worldChecksum << std::dec
+    << "\n";
+}
+
+void SimBenchmark::write_json(std::ostream& o,
+                              const SimBenchmarkResults& results) {
+  o << std::setprecision(6);
+  o << "{\n";
+  o << "  \"agent_count\": " << results.params.agentCount << ",\n";
+  o << "  \"tick_count\": " << results.params.tickCount << ",\n";
+  o << "  \"tick_seconds\": " << results.params.tickSeconds << ",\n";
+  o << "  \"seed\": " << results.params.seed << ",\n";
+  o << "  \"wall_seconds\": " << results.wallSeconds << ",\n";
+  o << "  \"ticks_per_second\": " << results.ticksPerSecond << ",\n";
+  o << "  \"ms_per_tick\": " << results.msPerTick << ",\n";
+  o << "  \"systems\": [";
+  for (int i = 0; i < results.systemTimings.size(); i++) {
+    const auto& timing = results.systemTimings[i];
+    o << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << timing.name
+      << "\", \"runs\": " << timing.runCount
+      << ", \"total_ms\": " << timing.totalMs << "}";
+  }
+  o << "\n  ],\n";
+  o << "  \"allocations_per_tick\": " << results.allocationsPerTick << ",\n";
+  o << "  \"peak_rss_bytes\": " << results.peakRssBytes << ",\n";
+  o << "  \"nav_requests\": " << results.navRequestsIssued << ",\n";
+  o << "  \"nav_requests_failed\": " << results.navRequestsFailed << ",\n";
+  o << "  \"snapshots\": " << results.snapshotsCaptured << ",\n";
+  o << "  \"snapshot_bytes\": " << results.snapshotBytes << ",\n";
+  o << "  \"world_checksum\": \"" << std::hex << results.worldChecksum
+    << std::dec << "\"\n";
+  o << "}\n";
+}
@@ -0,0 +1,96 @@
+#ifndef SANCTIFY_PVE_SIM_BENCHMARK_SIM_BENCHMARK_H
+#define SANCTIFY_PVE_SIM_BENCHMARK_SIM_BENCHMARK_H
+
+/**
+ * Headless simulation benchmark - builds a world out of the common logic
+ *  systems (scripted nav requests, locomotion, netsync snapshotting), spawns a
+ *  set of scripted agents on a navmesh and runs ticks as fast as possible.
+ *
+ * Runs single threaded and with a fixed tick length, so two runs with the same
+ *  parameters against the same navmesh simulate exactly the same thing (see
+ *  "worldChecksum" in the results).
+ */
+
+#include <DetourNavMesh.h>
+#include <igecs/scheduler.h>
+
+#include <entt/entt.hpp>
+#include <ostream>
+#include <string>
+
+namespace sanctify::pve {
+
+struct SimBenchmarkParams {
+  uint32_t agentCount;
+  uint32_t tickCount;
+  uint32_t warmupTickCount;
+  float tickSeconds;
+  uint32_t seed;
+  uint32_t snapshotInterval;
+  uint32_t maxNavRequestsPerTick;
+};
+
+struct SimBenchmarkSystemTiming {
+  std::string name;
+  uint32_t runCount;
+  double totalMs;
+};
+
+struct SimBenchmarkResults {
+  SimBenchmarkParams params;
+
+  double wallSeconds;
+  double ticksPerSecond;
+  double msPerTick;
+
+  indigo::core::Vector<SimBenchmarkSystemTiming> systemTimings;
+
+  // Allocation counts are only available if the host binary counts them
+  //  (see SimBenchmark::AllocCounterFn), -1 otherwise
+  double allocationsPerTick;
+  int64_t peakRssBytes;
+
+  uint64_t navRequestsIssued;
+  uint64_t navRequestsFailed;
+  uint64_t snapshotsCaptured;
+  uint64_t snapshotBytes;
+
+  uint64_t worldChecksum;
+};
+
+class SimBenchmark {
+ public:
+  /** Returns the number of heap allocations made so far in this process */
+  using AllocCounterFn = uint64_t (*)();
+
+  SimBenchmark(SimBenchmarkParams params, const dtNavMesh* navmesh,
+               AllocCounterFn alloc_counter);
+  ~SimBenchmark();
+
+  SimBenchmark(const SimBenchmark&) = delete;
+  SimBenchmark& operator=(const SimBenchmark&) = delete;
+
+  /** Spawn agents and run warmup ticks - returns false if spawning failed */
+  bool setup();
+
+  SimBenchmarkResults run();
+
+  static void write_text(std::ostream& o, const SimBenchmarkResults& results);
+  static void write_json(std::ostream& o, const SimBenchmarkResults& results);
+
+ private:
+  void tick();
+  uint64_t world_checksum();
+  static int64_t peak_rss_bytes();
+
+  SimBenchmarkParams params_;
+  const dtNavMesh* navmesh_;
+  AllocCounterFn alloc_counter_;
+
+  entt::registry world_;
+  indigo::igecs::Scheduler scheduler_;
+};
+
+}  // namespace sanctify::pve
+
+#endif
@@ -0,0 +1,167 @@
+#include "scripted_agent_nav_system.h"
+
+#include <common/logic/locomotion/locomotion.h>
+
+#include <limits>
+
+using namespace sanctify;
+using namespace pve;
+using namespace indigo;
+using namespace core;
+
+namespace {
+const int kMaxQueryNodes = 2048;
+const int kMaxPathPolys = 64;
+
+// xorshift32 - tiny, fast, and (importantly) identical on every platform
+float next_rand(uint32_t* state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return (x >> 8) * (1.f / 16777216.f);
+}
+
+bool find_nearest(const CtxBenchmarkNavmesh& ctx, glm::vec3 pos,
+                  const dtQueryFilter& filter, dtPolyRef* o_ref,
+                  glm::vec3* o_pos) {
+  glm::vec3 half_extents(2.f, ctx.bbMax.y - ctx.bbMin.y + 1.f, 2.f);
+  dtStatus status = ctx.query->findNearestPoly(&pos.x, &half_extents.x, &filter,
+                                               o_ref, &o_pos->x);
+  return !dtStatusFailed(status) && *o_ref != 0;
+}
+}  // namespace
+
+void ScriptedAgentNavSystem::EcsUtil::set_navmesh(
+    igecs::WorldView* wv, const dtNavMesh* navmesh,
+    uint32_t max_requests_per_tick) {
+  glm::vec3 bb_min(std::numeric_limits<float>::max());
+  glm::vec3 bb_max(std::numeric_limits<float>::lowest());
+  for (int i = 0; i < navmesh->getMaxTiles(); i++) {
+    const dtMeshTile* tile = navmesh->getTile(i);
+    if (tile == nullptr || tile->header == nullptr) {
+      continue;
+    }
+
+    bb_min = glm::min(bb_min, glm::vec3(tile->header->bmin[0],
+                                        tile->header->bmin[1],
+                                        tile->header->bmin[2]));
+    bb_max = glm::max(bb_max, glm::vec3(tile->header->bmax[0],
+                                        tile->header->bmax[1],
+                                        tile->header->bmax[2]));
+  }
+
+  dtNavMeshQuery* query = dtAllocNavMeshQuery();
+  query->init(navmesh, ::kMaxQueryNodes);
+
+  wv->attach_ctx<CtxBenchmarkNavmesh>(CtxBenchmarkNavmesh{
+      navmesh, query, bb_min, bb_max, max_requests_per_tick, 0ull, 0ull});
+}
+
+void ScriptedAgentNavSystem::EcsUtil::free_navmesh_query(igecs::WorldView* wv) {
+  auto& ctx = wv->mut_ctx<CtxBenchmarkNavmesh>();
+  if (ctx.query != nullptr) {
+    dtFreeNavMeshQuery(ctx.query);
+    ctx.query = nullptr;
+  }
+}
+
+bool ScriptedAgentNavSystem::EcsUtil::random_navmesh_point(
+    igecs::WorldView* wv, uint32_t* rng_state, glm::vec2* o_point) {
+  const auto& ctx = wv->ctx<CtxBenchmarkNavmesh>();
+  dtQueryFilter filter;
+
+  float x = ::next_rand(rng_state);
+  float z = ::next_rand(rng_state);
+  glm::vec3 guess(glm::mix(ctx.bbMin.x, ctx.bbMax.x, x),
+                  (ctx.bbMin.y + ctx.bbMax.y) * 0.5f,
+                  glm::mix(ctx.bbMin.z, ctx.bbMax.z, z));
+
+  dtPolyRef ref{};
+  glm::vec3 nearest{};
+  if (!::find_nearest(ctx, guess, filter, &ref, &nearest)) {
+    return false;
+  }
+
+  *o_point = glm::vec2(nearest.x, nearest.z);
+  return true;
+}
+
+const igecs::WorldView::Decl& ScriptedAgentNavSystem::decl() {
+  static const igecs::WorldView::Decl decl =
+      igecs::WorldView::Decl()
+          .ctx_writes<CtxBenchmarkNavmesh>()
+          .writes<ScriptedAgentComponent>()
+          .reads<logic::MapLocationComponent>()
+          .writes<logic::NavWaypointListComponent>()
+          .ctx_writes<logic::CtxNavWaypointArena>();
+
+  return decl;
+}
+
+void ScriptedAgentNavSystem::update(igecs::WorldView* wv) {
+  auto& ctx = wv->mut_ctx<CtxBenchmarkNavmesh>();
+  dtQueryFilter filter;
+
+  auto view = wv->view<ScriptedAgentComponent,
+                       const logic::MapLocationComponent>(
+      entt::exclude<logic::NavWaypointListComponent>);
+
+  uint32_t requests_this_tick = 0u;
+  for (auto [e, agent, map_location] : view.each()) {
+    if (requests_this_tick >= ctx.maxRequestsPerTick) {
+      break;
+    }
+    requests_this_tick++;
+    ctx.requestsIssued++;
+
+    glm::vec2 destination{};
+    if (!EcsUtil::random_navmesh_point(wv, &agent.rngState, &destination)) {
+      ctx.requestsFailed++;
+      continue;
+    }
+
+    glm::vec3 start_guess(map_location.position.x,
+                          (ctx.bbMin.y + ctx.bbMax.y) * 0.5f,
+                          map_location.position.y);
+    glm::vec3 end_guess(destination.x, (ctx.bbMin.y + ctx.bbMax.y) * 0.5f,
+                        destination.y);
+    dtPolyRef start_ref{}, end_ref{};
+    glm::vec3 start_pos{}, end_pos{};
+    if (!::find_nearest(ctx, start_guess, filter, &start_ref, &start_pos) ||
+        !::find_nearest(ctx, end_guess, filter, &end_ref, &end_pos)) {
+      ctx.requestsFailed++;
+      continue;
+    }
+
+    dtPolyRef path[::kMaxPathPolys]{};
+    int poly_count = 0;
+    dtStatus path_status =
+        ctx.query->findPath(start_ref, end_ref, &start_pos.x, &end_pos.x,
+                            &filter, path, &poly_count, ::kMaxPathPolys);
+    if (dtStatusFailed(path_status) || poly_count == 0) {
+      ctx.requestsFailed++;
+      continue;
+    }
+
+    glm::vec3 straight_path[::kMaxPathPolys]{};
+    int num_path_points = 0;
+    dtStatus straight_path_status = ctx.query->findStraightPath(
+        &start_pos.x, &end_pos.x, path, poly_count, &straight_path[0].x,
+        nullptr, nullptr, &num_path_points, ::kMaxPathPolys);
+    if (dtStatusFailed(straight_path_status) || num_path_points < 2) {
+      ctx.requestsFailed++;
+      continue;
+    }
+
+    // First straight path point is the agent's own (snapped) position
+    glm::vec2 waypoints[::kMaxPathPolys]{};
+    for (int i = 1; i < num_path_points; i++) {
+      waypoints[i - 1] = glm::vec2(straight_path[i].x, straight_path[i].z);
+    }
+
+    logic::LocomotionUtil::set_waypoints(wv, e, waypoints,
+                                         num_path_points - 1);
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef SANCTIFY_PVE_SIM_BENCHMARK_SYSTEMS_SCRIPTED_AGENT_NAV_SYSTEM_H
+#define SANCTIFY_PVE_SIM_BENCHMARK_SYSTEMS_SCRIPTED_AGENT_NAV_SYSTEM_H
+
+/**
+ * Scripted agents for the headless simulation benchmark - every agent that has
+ *  finished walking its current path picks a new (pseudo-random, but seeded per
+ *  agent) destination on the navmesh, and issues a Detour path query to it.
+ */
+
+#include <DetourNavMesh.h>
+#include <DetourNavMeshQuery.h>
+#include <igecs/world_view.h>
+
+#include <glm/glm.hpp>
+
+namespace sanctify::pve {
+
+struct ScriptedAgentComponent {
+  uint32_t rngState;
+};
+
+struct CtxBenchmarkNavmesh {
+  const dtNavMesh* navmesh;
+  dtNavMeshQuery* query;
+  glm::vec3 bbMin;
+  glm::vec3 bbMax;
+
+  // Cap on path queries issued each tick, so a synchronized wave of arrivals
+  //  can't turn one tick into a pathological outlier
+  uint32_t maxRequestsPerTick;
+
+  // Telemetry
+  uint64_t requestsIssued;
+  uint64_t requestsFailed;
+};
+
+class ScriptedAgentNavSystem {
+ public:
+  class EcsUtil {
+   public:
+    /**
+     * Attach navmesh and query objects to the world. The navmesh must outlive
+     *  the world, the query is owned by the world context.
+     */
+    static void set_navmesh(indigo::igecs::WorldView* wv,
+                            const dtNavMesh* navmesh,
+                            uint32_t max_requests_per_tick);
+
+    static void free_navmesh_query(indigo::igecs::WorldView* wv);
+
+    /** Pick a random point on the navmesh, advancing the given RNG state */
+    static bool random_navmesh_point(indigo::igecs::WorldView* wv,
+                                     uint32_t* rng_state, glm::vec2* o_point);
+  };
+
+ public:
+  static const indigo::igecs::WorldView::Decl& decl();
+  static void update(indigo::igecs::WorldView* wv);
+};
+
+}  // namespace sanctify::pve
+
+#endif
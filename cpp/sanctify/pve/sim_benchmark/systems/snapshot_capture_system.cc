@@ -0,0 +1,57 @@
+#include "snapshot_capture_system.h"
+
+#include <common/logic/netsync/common_logic_snapshot.h>
+#include <common/logic/netsync/netsync.h>
+
+using namespace sanctify;
+using namespace pve;
+using namespace indigo;
+
+const igecs::WorldView::Decl& SnapshotCaptureSystem::decl() {
+  static const igecs::WorldView::Decl decl =
+      igecs::WorldView::Decl()
+          .ctx_writes<CtxSnapshotCaptureState>()
+          .ctx_reads<logic::CtxSimTime>()
+          .reads<logic::NetSyncId>()
+          .reads<logic::MapLocationComponent>()
+          .reads<logic::OrientationComponent>()
+          .reads<logic::NavWaypointListComponent>()
+          .reads<logic::StandardNavigationParamsComponent>();
+
+  return decl;
+}
+
+void SnapshotCaptureSystem::update(igecs::WorldView* wv) {
+  auto& state = wv->mut_ctx<CtxSnapshotCaptureState>();
+  state.ticksSinceCapture++;
+  if (state.ticksSinceCapture < state.interval) {
+    return;
+  }
+  state.ticksSinceCapture = 0u;
+
+  logic::CommonLogicSnapshot snapshot;
+  snapshot.set(wv->ctx<logic::CtxSimTime>());
+
+  auto view = wv->view<const logic::NetSyncId>();
+  for (auto [e, net_sync_id] : view.each()) {
+    if (wv->has<logic::MapLocationComponent>(e)) {
+      snapshot.add(net_sync_id.id, wv->read<logic::MapLocationComponent>(e));
+    }
+    if (wv->has<logic::OrientationComponent>(e)) {
+      snapshot.add(net_sync_id.id, wv->read<logic::OrientationComponent>(e));
+    }
+    if (wv->has<logic::NavWaypointListComponent>(e)) {
+      snapshot.add(net_sync_id.id,
+                   wv->read<logic::NavWaypointListComponent>(e));
+    }
+    if (wv->has<logic::StandardNavigationParamsComponent>(e)) {
+      snapshot.add(net_sync_id.id,
+                   wv->read<logic::StandardNavigationParamsComponent>(e));
+    }
+  }
+
+  std::string wire_data = snapshot.serialize().SerializeAsString();
+
+  state.snapshotsCaptured++;
+  state.bytesSerialized += wire_data.size();
+}
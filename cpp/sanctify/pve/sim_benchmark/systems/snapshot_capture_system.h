@@ -0,0 +1,33 @@
+#ifndef SANCTIFY_PVE_SIM_BENCHMARK_SYSTEMS_SNAPSHOT_CAPTURE_SYSTEM_H
+#define SANCTIFY_PVE_SIM_BENCHMARK_SYSTEMS_SNAPSHOT_CAPTURE_SYSTEM_H
+
+/**
+ * Stand-in for the server snapshot path - every "interval" ticks, gathers a
+ *  CommonLogicSnapshot of every NetSyncId entity and serializes it to the wire
+ *  format, keeping only the byte count.
+ */
+
+#include <igecs/world_view.h>
+
+#include <cstdint>
+
+namespace sanctify::pve {
+
+struct CtxSnapshotCaptureState {
+  uint32_t interval;
+  uint32_t ticksSinceCapture;
+
+  // Telemetry
+  uint64_t snapshotsCaptured;
+  uint64_t bytesSerialized;
+};
+
+class SnapshotCaptureSystem {
+ public:
+  static const indigo::igecs::WorldView::Decl& decl();
+  static void update(indigo::igecs::WorldView* wv);
+};
+
+}  // namespace sanctify::pve
+
+#endif
@@ -0,0 +1,168 @@
+#include "terrain_lod_benchmark.h"
+
+#include <common/logic/viewport/arena_camera.h>
+#include <common/render/terrain/terrain_chunk_selector.h>
+
+#include <algorithm>
+#include <chrono>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iomanip>
+
+using namespace sanctify;
+using namespace pve;
+using namespace indigo;
+using namespace core;
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+// Walkable extents of the PvE arena (see pve-arena-navmesh) - the camera only
+//  ever looks at points in here
+constexpr float kArenaMinX = -172.f;
+constexpr float kArenaMaxX = 5.f;
+constexpr float kArenaHalfDepth = 16.f;
+
+// Match the offline client camera (see PveOfflineGameScene)
+const float kTiltAngle = glm::radians(35.f);
+const float kSpinAngle = glm::radians(45.f);
+const float kFovy = glm::radians(40.f);
+constexpr float kAspectRatio = 16.f / 9.f;
+constexpr float kNear = 0.1f;
+constexpr float kFar = 1000.f;
+
+// Walks the look-at point down the length of the arena, weaving side to side
+logic::ArenaCamera camera_at(uint32_t frame, uint32_t frame_count,
+                             float radius) {
+  float t = static_cast<float>(frame) / std::max(frame_count - 1u, 1u);
+  glm::vec3 look_at(kArenaMinX + (kArenaMaxX - kArenaMinX) * t, 0.f,
+                    glm::sin(t * glm::two_pi<float>() * 4.f) * kArenaHalfDepth);
+  return logic::ArenaCamera(look_at, kTiltAngle, kSpinAngle, radius);
+}
+
+render::TerrainChunkDesc chunk_desc(
+    const asset::pb::TerrainChunksDef::Chunk& chunk) {
+  render::TerrainChunkDesc desc{};
+  desc.boundsMin = glm::vec3(chunk.min_x(), chunk.min_y(), chunk.min_z());
+  desc.boundsMax = glm::vec3(chunk.max_x(), chunk.max_y(), chunk.max_z());
+  desc.lodCount = std::min(static_cast<uint32_t>(chunk.lods_size()),
+                           render::TerrainChunkDesc::kMaxLods);
+  for (uint32_t i = 0; i < desc.lodCount; i++) {
+    desc.triangleCount[i] = chunk.lods(i).triangle_count();
+  }
+  return desc;
+}
+
+TerrainLodZoomResults run_zoom(render::TerrainChunkSelector& selector,
+                               const TerrainLodBenchmarkParams& params,
+                               uint64_t full_terrain_triangles, float radius) {
+  glm::mat4 mat_proj = glm::perspective(kFovy, kAspectRatio, kNear, kFar);
+
+  uint64_t visible_chunks = 0u;
+  uint64_t culled_triangles = 0u;
+  uint64_t culled_lod_triangles = 0u;
+  double select_ms = 0.;
+
+  for (uint32_t frame = 0; frame < params.frameCount; frame++) {
+    logic::ArenaCamera camera = ::camera_at(frame, params.frameCount, radius);
+    render::Frustum frustum =
+        render::Frustum::from_view_proj(mat_proj * camera.mat_view());
+
+    auto start = Clock::now();
+    selector.select(frustum, camera.position());
+    select_ms +=
+        std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    const auto& selection = selector.selection();
+    for (int i = 0; i < selection.size(); i++) {
+      culled_triangles +=
+          selector.chunk(selection[i].chunkIdx).triangleCount[0];
+    }
+    visible_chunks += selector.stats().visibleChunks;
+    culled_lod_triangles += selector.stats().trianglesSubmitted;
+  }
+
+  const double frames = std::max(params.frameCount, 1u);
+
+  TerrainLodZoomResults results{};
+  results.zoomRadius = radius;
+  results.visibleChunks = visible_chunks / frames;
+  results.fullTerrainTriangles = static_cast<double>(full_terrain_triangles);
+  results.culledTriangles = culled_triangles / frames;
+  results.culledLodTriangles = culled_lod_triangles / frames;
+  results.selectMs = select_ms;
+  return results;
+}
+
+}  // namespace
+
+TerrainLodBenchmarkResults TerrainLodBenchmark::Run(
+    TerrainLodBenchmarkParams params,
+    const asset::pb::TerrainChunksDef& chunks_def) {
+  render::TerrainChunkSelector selector;
+
+  uint64_t full_terrain_triangles = 0u;
+  for (const auto& chunk : chunks_def.chunks()) {
+    auto desc = ::chunk_desc(chunk);
+    if (desc.lodCount == 0u) {
+      continue;
+    }
+    full_terrain_triangles += desc.triangleCount[0];
+    selector.add_chunk(desc);
+  }
+
+  TerrainLodBenchmarkResults results{};
+  results.params = params;
+  results.chunkCount = selector.chunk_count();
+  for (float radius : params.zoomRadii) {
+    results.zooms.push_back(
+        ::run_zoom(selector, params, full_terrain_triangles, radius));
+  }
+
+  return results;
+}
+
+void TerrainLodBenchmark::write_text(
+    std::ostream& o, const TerrainLodBenchmarkResults& results) {
+  o << std::fixed << std::setprecision(1);
+  o << "Terrain chunks: " << results.chunkCount
+    << ", frames per zoom: " << results.params.frameCount << "\n";
+  for (const auto& zoom : results.zooms) {
+    o << "Zoom radius " << zoom.zoomRadius << " ("
+      << zoom.visibleChunks << " chunks visible)\n";
+    o << "  whole terrain:   " << zoom.fullTerrainTriangles
+      << " triangles/frame\n";
+    o << "  culled:          " << zoom.culledTriangles << " triangles/frame\n";
+    o << "  culled + LOD:    " << zoom.culledLodTriangles
+      << " triangles/frame\n";
+    o << std::setprecision(3);
+    o << "  select:          " << zoom.selectMs << "ms total\n";
+    o << std::setprecision(1);
+  }
+  o << std::defaultfloat;
+}
+
+void TerrainLodBenchmark::write_json(
+    std::ostream& o, const TerrainLodBenchmarkResults& results) {
+  o << std::setprecision(6);
+  o << "{\n";
+  o << "  \"chunk_count\": " << results.chunkCount << ",\n";
+  o << "  \"frame_count\": " << results.params.frameCount << ",\n";
+  o << "  \"zooms\": [";
+  for (int i = 0; i < results.zooms.size(); i++) {
+    const auto& zoom = results.zooms[i];
+    o << (i == 0 ? "\n" : ",\n");
+    o << "    {\n";
+    o << "      \"zoom_radius\": " << zoom.zoomRadius << ",\n";
+    o << "      \"visible_chunks\": " << zoom.visibleChunks << ",\n";
+    o << "      \"full_terrain_triangles\": " << zoom.fullTerrainTriangles
+      << ",\n";
+    o << "      \"culled_triangles\": " << zoom.culledTriangles << ",\n";
+    o << "      \"culled_lod_triangles\": " << zoom.culledLodTriangles
+      << ",\n";
+    o << "      \"select_ms\": " << zoom.selectMs << "\n";
+    o << "    }";
+  }
+  o << "\n  ]\n";
+  o << "}\n";
+}
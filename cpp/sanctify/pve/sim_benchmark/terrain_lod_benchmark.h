@@ -0,0 +1,61 @@
+#ifndef SANCTIFY_PVE_SIM_BENCHMARK_TERRAIN_LOD_BENCHMARK_H
+#define SANCTIFY_PVE_SIM_BENCHMARK_TERRAIN_LOD_BENCHMARK_H
+
+/**
+ * Terrain chunking/LOD benchmark - sweeps the arena camera across the PvE
+ *  arena at a few zoom levels, and counts the terrain triangles that would be
+ *  submitted each frame drawing the whole terrain, drawing only the chunks in
+ *  the frustum, and drawing those chunks at the LOD TerrainChunkSelector picks.
+ *  Needs the terrain chunk layout from arena-base.igpack, but no GPU.
+ */
+
+#include <igasset/proto/igasset.pb.h>
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace sanctify::pve {
+
+struct TerrainLodBenchmarkParams {
+  uint32_t frameCount;
+
+  // ArenaCamera radius of each measured zoom level
+  std::vector<float> zoomRadii;
+};
+
+struct TerrainLodZoomResults {
+  float zoomRadius;
+
+  // Per frame averages
+  double visibleChunks;
+  double fullTerrainTriangles;
+  double culledTriangles;
+  double culledLodTriangles;
+
+  // Time spent in TerrainChunkSelector::select, over every frame
+  double selectMs;
+};
+
+struct TerrainLodBenchmarkResults {
+  TerrainLodBenchmarkParams params;
+
+  uint32_t chunkCount;
+  std::vector<TerrainLodZoomResults> zooms;
+};
+
+class TerrainLodBenchmark {
+ public:
+  static TerrainLodBenchmarkResults Run(
+      TerrainLodBenchmarkParams params,
+      const indigo::asset::pb::TerrainChunksDef& chunks_def);
+
+  static void write_text(std::ostream& o,
+                         const TerrainLodBenchmarkResults& results);
+  static void write_json(std::ostream& o,
+                         const TerrainLodBenchmarkResults& results);
+};
+
+}  // namespace sanctify::pve
+
+#endif
@@ -0,0 +1,242 @@
+#include "visibility_benchmark.h"
+
+#include <common/render/visibility/visibility_system.h>
+#include <igasync/task_list.h>
+#include <igcore/config.h>
+#include <igcore/pod_vector.h>
+
+#ifdef IG_ENABLE_THREADS
+#include <igasync/executor_thread.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <iomanip>
+#include <random>
+
+using namespace sanctify;
+using namespace pve;
+using namespace indigo;
+using namespace core;
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr float kArenaHalfSize = 400.f;
+constexpr float kCameraHeight = 120.f;
+constexpr float kCameraDistance = 160.f;
+
+// Orbits the arena center once over the run, looking down at it like the
+//  arena camera does - roughly a third to a half of the field ends up visible
+glm::mat4 camera_view_proj(uint32_t frame, uint32_t frame_count) {
+  float angle = glm::two_pi<float>() * frame / std::max(frame_count, 1u);
+  glm::vec3 target(glm::cos(angle) * kArenaHalfSize * 0.25f, 0.f,
+                   glm::sin(angle) * kArenaHalfSize * 0.25f);
+  glm::vec3 position =
+      target + glm::vec3(glm::cos(angle + glm::pi<float>()) * kCameraDistance,
+                         kCameraHeight,
+                         glm::sin(angle + glm::pi<float>()) * kCameraDistance);
+
+  glm::mat4 mat_view =
+      glm::lookAt(position, target, glm::vec3(0.f, 1.f, 0.f));
+  glm::mat4 mat_proj =
+      glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 4000.f);
+  return mat_proj * mat_view;
+}
+
+void setup_world(entt::registry& world,
+                 const VisibilityBenchmarkParams& params) {
+  std::mt19937 rng(params.seed);
+  std::uniform_real_distribution<float> coord(-kArenaHalfSize, kArenaHalfSize);
+  std::uniform_real_distribution<float> height(0.f, 4.f);
+  std::uniform_real_distribution<float> scale(0.5f, 3.f);
+
+  render::BoundingSphere unit_bounds{glm::vec3(0.f, 1.f, 0.f), 1.f};
+
+  auto wv = igecs::WorldView::Thin(&world);
+  for (uint32_t i = 0; i < params.entityCount; i++) {
+    auto e = world.create();
+    glm::mat4 mat_world = glm::scale(
+        glm::translate(glm::mat4(1.f), glm::vec3(coord(rng), height(rng),
+                                                 coord(rng))),
+        glm::vec3(scale(rng)));
+    render::VisibilitySystem::set_world_bounds(&wv, e, unit_bounds, mat_world);
+  }
+}
+
+double run_frames(entt::registry& world,
+                  const VisibilityBenchmarkParams& params,
+                  std::shared_ptr<TaskList> any_thread,
+                  uint64_t* visible_total) {
+  auto wv = render::VisibilitySystem::cull_decl().create(&world);
+
+  double total_ms = 0.;
+  for (uint32_t frame = 0; frame < params.frameCount; frame++) {
+    render::Frustum frustum = render::Frustum::from_view_proj(
+        ::camera_view_proj(frame, params.frameCount));
+
+    auto start = Clock::now();
+    render::VisibilitySystem::cull(&wv, frustum, any_thread);
+    total_ms +=
+        std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    if (visible_total) {
+      *visible_total += world.ctx<render::CtxVisibleList>().visible.size();
+    }
+  }
+
+  return total_ms;
+}
+
+// Reference pass - one sphere test at a time, straight off of the components
+double run_scalar_frames(entt::registry& world,
+                         const VisibilityBenchmarkParams& params) {
+  PodVector<entt::entity> visible(params.entityCount);
+
+  double total_ms = 0.;
+  for (uint32_t frame = 0; frame < params.frameCount; frame++) {
+    render::Frustum frustum = render::Frustum::from_view_proj(
+        ::camera_view_proj(frame, params.frameCount));
+
+    auto start = Clock::now();
+    visible.resize(0);
+    auto view = world.view<const render::WorldBoundsComponent>();
+    for (auto [e, world_bounds] : view.each()) {
+      if (frustum.test_sphere(world_bounds.bounds)) {
+        visible.push_back(e);
+      }
+    }
+    total_ms +=
+        std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+
+  return total_ms;
+}
+
+uint32_t count_mismatches(entt::registry& world,
+                          const VisibilityBenchmarkParams& params,
+                          std::shared_ptr<TaskList> any_thread) {
+  auto wv = render::VisibilitySystem::cull_decl().create(&world);
+
+  PodVector<uint8_t> is_listed(params.entityCount);
+  is_listed.resize(params.entityCount);
+
+  uint32_t mismatch_count = 0u;
+  for (uint32_t frame = 0; frame < params.frameCount; frame++) {
+    render::Frustum frustum = render::Frustum::from_view_proj(
+        ::camera_view_proj(frame, params.frameCount));
+    render::VisibilitySystem::cull(&wv, frustum, any_thread);
+
+    for (int i = 0; i < is_listed.size(); i++) {
+      is_listed[i] = 0u;
+    }
+    const auto& visible = world.ctx<render::CtxVisibleList>().visible;
+    for (int i = 0; i < visible.size(); i++) {
+      is_listed[entt::to_entity(visible[i])] = 1u;
+    }
+
+    auto view = world.view<const render::WorldBoundsComponent>();
+    for (auto [e, world_bounds] : view.each()) {
+      bool expected = frustum.test_sphere(world_bounds.bounds);
+      if (expected != (is_listed[entt::to_entity(e)] != 0u)) {
+        mismatch_count++;
+      }
+    }
+  }
+
+  return mismatch_count;
+}
+}  // namespace
+
+VisibilityBenchmarkResults VisibilityBenchmark::Run(
+    VisibilityBenchmarkParams params) {
+  entt::registry world;
+  ::setup_world(world, params);
+
+  VisibilityBenchmarkResults results{};
+  results.params = params;
+  results.instructionSet = render::FrustumCullKernel::instruction_set();
+  results.laneWidth = render::FrustumCullKernel::lane_width();
+
+  auto any_thread = std::make_shared<TaskList>();
+#ifdef IG_ENABLE_THREADS
+  Vector<std::shared_ptr<ExecutorThread>> workers(params.workerCount);
+  for (uint32_t i = 0; i < params.workerCount; i++) {
+    workers.push_back(std::make_shared<ExecutorThread>());
+    workers[i]->add_task_list(any_thread);
+  }
+#else
+  results.params.workerCount = 0u;
+#endif
+
+  uint64_t visible_total = 0u;
+  results.serialMs = ::run_frames(world, params, nullptr, &visible_total);
+  results.parallelMs = ::run_frames(world, params, any_thread, nullptr);
+  results.scalarMs = ::run_scalar_frames(world, params);
+  results.mismatchCount = ::count_mismatches(world, params, any_thread);
+
+#ifdef IG_ENABLE_THREADS
+  for (int i = 0; i < workers.size(); i++) {
+    workers[i]->clear_all_task_lists();
+  }
+#endif
+
+  double entity_tests =
+      static_cast<double>(params.entityCount) * params.frameCount;
+  results.serialEntitiesPerMs =
+      results.serialMs > 0. ? entity_tests / results.serialMs : 0.;
+  results.parallelEntitiesPerMs =
+      results.parallelMs > 0. ? entity_tests / results.parallelMs : 0.;
+  results.scalarEntitiesPerMs =
+      results.scalarMs > 0. ? entity_tests / results.scalarMs : 0.;
+  results.visibleFraction =
+      entity_tests > 0. ? static_cast<double>(visible_total) / entity_tests
+                        : 0.;
+
+  return results;
+}
+
+void VisibilityBenchmark::write_text(std::ostream& o,
+                                     const VisibilityBenchmarkResults& results) {
+  o << std::fixed << std::setprecision(2);
+  o << "Frustum cull kernel: " << results.instructionSet << " ("
+    << results.laneWidth << " lanes)\n";
+  o << "Renderables: " << results.params.entityCount
+    << ", frames: " << results.params.frameCount
+    << ", workers: " << results.params.workerCount << "\n";
+  o << "  serial:   " << results.serialMs << "ms ("
+    << results.serialEntitiesPerMs << " entities/ms)\n";
+  o << "  parallel: " << results.parallelMs << "ms ("
+    << results.parallelEntitiesPerMs << " entities/ms)\n";
+  o << "  scalar:   " << results.scalarMs << "ms ("
+    << results.scalarEntitiesPerMs << " entities/ms)\n";
+  o << "Visible: " << results.visibleFraction * 100. << "%\n";
+  o << "Mismatches: " << results.mismatchCount << "\n";
+  o << std::defaultfloat;
+}
+
+void VisibilityBenchmark::write_json(std::ostream& o,
+                                     const VisibilityBenchmarkResults& results) {
+  o << std::setprecision(6);
+  o << "{\n";
+  o << "  \"instruction_set\": \"" << results.instructionSet << "\",\n";
+  o << "  \"lane_width\": " << results.laneWidth << ",\n";
+  o << "  \"entity_count\": " << results.params.entityCount << ",\n";
+  o << "  \"frame_count\": " << results.params.frameCount << ",\n";
+  o << "  \"worker_count\": " << results.params.workerCount << ",\n";
+  o << "  \"seed\": " << results.params.seed << ",\n";
+  o << "  \"serial_ms\": " << results.serialMs << ",\n";
+  o << "  \"parallel_ms\": " << results.parallelMs << ",\n";
+  o << "  \"scalar_ms\": " << results.scalarMs << ",\n";
+  o << "  \"serial_entities_per_ms\": " << results.serialEntitiesPerMs
+    << ",\n";
+  o << "  \"parallel_entities_per_ms\": " << results.parallelEntitiesPerMs
+    << ",\n";
+  o << "  \"scalar_entities_per_ms\": " << results.scalarEntitiesPerMs
+    << ",\n";
+  o << "  \"visible_fraction\": " << results.visibleFraction << ",\n";
+  o << "  \"mismatch_count\": " << results.mismatchCount << "\n";
+  o << "}\n";
+}
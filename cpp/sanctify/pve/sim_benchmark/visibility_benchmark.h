@@ -0,0 +1,56 @@
+#ifndef SANCTIFY_PVE_SIM_BENCHMARK_VISIBILITY_BENCHMARK_H
+#define SANCTIFY_PVE_SIM_BENCHMARK_VISIBILITY_BENCHMARK_H
+
+/**
+ * Visibility-only microbenchmark - culls a field of randomly placed
+ *  renderables against an arena-style camera with VisibilitySystem, serially
+ *  and in parallel chunks, and compares both against the scalar sphere test.
+ *  Does not need a GPU or any assets.
+ */
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace sanctify::pve {
+
+struct VisibilityBenchmarkParams {
+  uint32_t entityCount;
+  uint32_t frameCount;
+  uint32_t workerCount;
+  uint32_t seed;
+};
+
+struct VisibilityBenchmarkResults {
+  VisibilityBenchmarkParams params;
+
+  std::string instructionSet;
+  uint32_t laneWidth;
+
+  double serialMs;
+  double parallelMs;
+  double scalarMs;
+  double serialEntitiesPerMs;
+  double parallelEntitiesPerMs;
+  double scalarEntitiesPerMs;
+
+  // Averaged over every frame, as a fraction of entityCount
+  double visibleFraction;
+
+  // Entities where the visible list disagreed with the scalar sphere test
+  uint32_t mismatchCount;
+};
+
+class VisibilityBenchmark {
+ public:
+  static VisibilityBenchmarkResults Run(VisibilityBenchmarkParams params);
+
+  static void write_text(std::ostream& o,
+                         const VisibilityBenchmarkResults& results);
+  static void write_json(std::ostream& o,
+                         const VisibilityBenchmarkResults& results);
+};
+
+}  // namespace sanctify::pve
+
+#endif
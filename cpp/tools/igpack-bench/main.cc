@@ -0,0 +1,689 @@
+#include <igasset/compressed_texture.h>
+#include <igasset/compressed_texture_encoder.h>
+#include <igasset/draco_decoder.h>
+#include <igasset/igpack_loader.h>
+#include <igasset/indexed_igpack.h>
+#include <igasset/proto/igasset.pb.h>
+#include <igasync/executor_thread.h>
+#include <igcore/log.h>
+#include <igplatform/mapped_file.h>
+#include <igplatform/ranged_file_reader.h>
+
+#include <CLI/App.hpp>
+#include <CLI/Config.hpp>
+#include <CLI/Formatter.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+// windows.h must come first
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * igpack-bench - measures how long it takes to get the first asset out of an
+ *  asset pack, and how much memory that costs, for both pack formats.
+ *
+ * Peak RSS is per process, so run once per format:
+ *   igpack-bench -i resources/terrain-pve.igpack -a <asset> --format protobuf
+ *   igpack-bench -i resources/terrain-pve.igpack -a <asset> --format indexed
+ *
+ * The "download" and "streaming" formats instead simulate a network link
+ *  (--latency_ms, --bandwidth_kbps) and measure time-to-interactive: waiting
+ *  for the whole protobuf pack and then parsing it, vs. streaming the indexed
+ *  pack with IgpackLoader and stopping as soon as the asset resolves. The link
+ *  is modelled as a single connection - transfers do not overlap.
+ *
+ * --draco_load times decoding every Draco mesh in the (indexed) pack into
+ *  GPU-layout vertex/index buffers, on one thread and then on --threads:
+ *   igpack-bench -i resources/arena-base.igpack --draco_load
+ *
+ * --texture_load compares PNG textures against block-compressed ones: decode
+ *  time and resident bytes of the PNG as RGBA8 (no mips), vs. unpacking the
+ *  same image as an LZ4 BC1/BC3 mip chain (encoded up front, not timed) and
+ *  the CPU RGBA8 fallback transcode. Compressed textures already in the pack
+ *  are measured the same way.
+ */
+
+namespace {
+const char* kLogLabel = "igpack-bench";
+
+using Clock = std::chrono::high_resolution_clock;
+
+uint64_t peak_rss_kb() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters{};
+  ::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters));
+  return counters.PeakWorkingSetSize / 1024u;
+#else
+  struct rusage usage {};
+  ::getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return static_cast<uint64_t>(usage.ru_maxrss) / 1024u;
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+// Sum payload bytes, so that the benchmark pays for actually reading them
+uint64_t touch_bytes(std::string_view data) {
+  uint64_t sum = 0u;
+  for (char c : data) {
+    sum += static_cast<uint8_t>(c);
+  }
+  return sum;
+}
+
+bool first_asset_protobuf(const std::string& igpack_path,
+                          const std::string& asset_name, uint64_t* checksum) {
+  std::ifstream fin(igpack_path, std::ios::binary | std::ios::ate);
+  if (!fin) {
+    indigo::core::Logger::err(kLogLabel) << "Could not open " << igpack_path;
+    return false;
+  }
+
+  std::string raw(static_cast<size_t>(fin.tellg()), '\0');
+  fin.seekg(0, std::ios::beg);
+  fin.read(&raw[0], raw.size());
+
+  indigo::asset::pb::AssetPack asset_pack;
+  if (!asset_pack.ParseFromString(raw)) {
+    indigo::core::Logger::err(kLogLabel) << "Could not parse " << igpack_path;
+    return false;
+  }
+
+  for (const auto& asset : asset_pack.assets()) {
+    if (asset.name() == asset_name) {
+      *checksum = ::touch_bytes(
+          indigo::asset::IgpackAsset::FromProto(asset).payload_view());
+      return true;
+    }
+  }
+
+  indigo::core::Logger::err(kLogLabel) << "Asset " << asset_name
+                                       << " not found in " << igpack_path;
+  return false;
+}
+
+bool first_asset_indexed(const std::string& igpack_path,
+                         const std::string& asset_name, uint64_t* checksum) {
+  std::string indexed_path =
+      indigo::asset::IndexedIgpack::IndexedPathFor(igpack_path);
+  auto mapped_file = indigo::core::MappedFile::Open(indexed_path);
+  if (mapped_file.is_right()) {
+    indigo::core::Logger::err(kLogLabel) << "Could not map " << indexed_path;
+    return false;
+  }
+
+  auto file = mapped_file.left_move();
+  auto indexed_pack =
+      indigo::asset::IndexedIgpack::Open(file, file->data(), file->size());
+  if (indexed_pack.is_empty()) {
+    return false;
+  }
+
+  const auto* entry = indexed_pack.get()->find_entry(asset_name);
+  if (entry == nullptr) {
+    indigo::core::Logger::err(kLogLabel) << "Asset " << asset_name
+                                         << " not found in " << indexed_path;
+    return false;
+  }
+
+  auto asset = indexed_pack.get()->read_asset(*entry);
+  if (asset.is_empty()) {
+    return false;
+  }
+
+  *checksum = ::touch_bytes(asset.get().payload_view());
+  return true;
+}
+
+Clock::duration transfer_time(uint32_t latency_ms, uint32_t bandwidth_kbps,
+                              uint64_t bytes) {
+  return std::chrono::milliseconds(latency_ms) +
+         std::chrono::microseconds(bytes * 8000u / bandwidth_kbps);
+}
+
+// Single simulated network connection - each transfer pays "latency_ms",
+//  and transfers share the link's bandwidth one after another
+class SimulatedLink {
+ public:
+  SimulatedLink(uint32_t latency_ms, uint32_t bandwidth_kbps)
+      : latency_ms_(latency_ms),
+        bandwidth_kbps_(bandwidth_kbps),
+        link_free_at_(Clock::now()),
+        is_running_(true),
+        delivery_thread_([this]() { run_deliveries(); }) {}
+
+  ~SimulatedLink() {
+    {
+      std::lock_guard<std::mutex> l(mut_);
+      is_running_ = false;
+    }
+    cv_.notify_one();
+    delivery_thread_.join();
+  }
+
+  // Resolve "rsl" with "data" at the time it would have finished arriving
+  void deliver(std::shared_ptr<indigo::core::FilePromiseT> rsl,
+               indigo::core::FilePromiseResultT data) {
+    uint64_t bytes = data.is_left() ? data.get_left()->size() : 0u;
+    {
+      std::lock_guard<std::mutex> l(mut_);
+      Clock::time_point arrival =
+          std::max(Clock::now() + std::chrono::milliseconds(latency_ms_),
+                   link_free_at_) +
+          ::transfer_time(0u, bandwidth_kbps_, bytes);
+      link_free_at_ = arrival;
+      deliveries_.push_back({arrival, std::move(rsl), std::move(data)});
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  struct Delivery {
+    Clock::time_point Arrival;
+    std::shared_ptr<indigo::core::FilePromiseT> Rsl;
+    indigo::core::FilePromiseResultT Data;
+  };
+
+  void run_deliveries() {
+    std::unique_lock<std::mutex> l(mut_);
+    while (true) {
+      cv_.wait(l, [this]() { return !is_running_ || !deliveries_.empty(); });
+      if (deliveries_.empty()) {
+        return;
+      }
+
+      // Arrival times are in queue order, since the link is shared
+      Delivery delivery = std::move(deliveries_.front());
+      deliveries_.pop_front();
+      l.unlock();
+      std::this_thread::sleep_until(delivery.Arrival);
+      delivery.Rsl->resolve(std::move(delivery.Data));
+      l.lock();
+    }
+  }
+
+  uint32_t latency_ms_;
+  uint32_t bandwidth_kbps_;
+
+  std::mutex mut_;
+  std::condition_variable cv_;
+  Clock::time_point link_free_at_;
+  std::deque<Delivery> deliveries_;
+  bool is_running_;
+  std::thread delivery_thread_;
+};
+
+// Range reads of a local file, delivered over "link"
+class ThrottledRangedReader : public indigo::core::RangedFileReader {
+ public:
+  ThrottledRangedReader(
+      std::shared_ptr<indigo::core::RangedFileReader> reader,
+      std::shared_ptr<indigo::core::TaskList> task_list,
+      std::shared_ptr<SimulatedLink> link)
+      : reader_(std::move(reader)),
+        task_list_(std::move(task_list)),
+        link_(std::move(link)) {}
+
+  std::shared_ptr<indigo::core::FilePromiseT> read_range(
+      uint64_t offset, uint64_t size) override {
+    auto rsl = indigo::core::FilePromiseT::create("ThrottledReadRange");
+    reader_->read_range(offset, size)
+        ->on_success(
+            [rsl, link = link_](const indigo::core::FilePromiseResultT& data) {
+              link->deliver(rsl, data);
+            },
+            task_list_);
+    return rsl;
+  }
+
+ private:
+  std::shared_ptr<indigo::core::RangedFileReader> reader_;
+  std::shared_ptr<indigo::core::TaskList> task_list_;
+  std::shared_ptr<SimulatedLink> link_;
+};
+
+bool wait_for_asset(
+    const indigo::asset::IgpackLoader::ExtractRawAssetPromiseT& promise,
+    const std::shared_ptr<indigo::core::TaskList>& task_list,
+    const std::string& asset_name, uint64_t* checksum) {
+  // Reads resolve on the link thread, so an empty task list is not the end
+  while (!promise->is_finished()) {
+    if (!task_list->execute_next()) {
+      std::this_thread::yield();
+    }
+  }
+
+  if (promise->unsafe_sync_get().is_right()) {
+    indigo::core::Logger::err(kLogLabel) << "Could not extract " << asset_name;
+    return false;
+  }
+
+  *checksum =
+      ::touch_bytes(promise->unsafe_sync_get().get_left()->payload_view());
+  return true;
+}
+
+bool first_asset_download(const std::string& igpack_path,
+                          const std::string& asset_name,
+                          uint32_t latency_ms, uint32_t bandwidth_kbps,
+                          uint64_t* checksum) {
+  std::ifstream fin(igpack_path, std::ios::binary | std::ios::ate);
+  if (!fin) {
+    indigo::core::Logger::err(kLogLabel) << "Could not open " << igpack_path;
+    return false;
+  }
+
+  indigo::core::RawBuffer raw(static_cast<size_t>(fin.tellg()));
+  fin.seekg(0, std::ios::beg);
+  fin.read(reinterpret_cast<char*>(raw.get()), raw.size());
+  std::this_thread::sleep_for(
+      ::transfer_time(latency_ms, bandwidth_kbps, raw.size()));
+
+  auto task_list = std::make_shared<indigo::core::TaskList>();
+  indigo::asset::IgpackLoader loader(raw);
+  return ::wait_for_asset(loader.extract_raw_asset(asset_name, task_list),
+                          task_list, asset_name, checksum);
+}
+
+bool first_asset_streaming(const std::string& igpack_path,
+                           const std::string& asset_name,
+                           uint32_t latency_ms, uint32_t bandwidth_kbps,
+                           uint64_t* checksum) {
+  auto task_list = std::make_shared<indigo::core::TaskList>();
+
+  indigo::asset::IgpackLoader::StreamingParams params{};
+  params.Reader = std::make_shared<ThrottledRangedReader>(
+      indigo::core::RangedFileReader::Create(
+          indigo::asset::IndexedIgpack::IndexedPathFor(igpack_path),
+          task_list),
+      task_list, std::make_shared<SimulatedLink>(latency_ms, bandwidth_kbps));
+  params.PriorityHints[asset_name] = -1;
+
+  indigo::asset::IgpackLoader loader(igpack_path, task_list, params);
+  return ::wait_for_asset(loader.extract_raw_asset(asset_name, task_list),
+                          task_list, asset_name, checksum);
+}
+
+struct DracoLoadTimes {
+  std::atomic_uint64_t DecodeUs{0u};
+  std::atomic_uint64_t WriteUs{0u};
+  std::atomic_uint64_t Vertices{0u};
+};
+
+uint64_t elapsed_us(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                               start)
+      .count();
+}
+
+// Decode a mesh and write it into interleaved staging buffers, as a GPU
+//  upload would
+bool load_draco_mesh(const indigo::asset::IgpackAsset& asset,
+                     DracoLoadTimes* times) {
+  auto start_time = Clock::now();
+
+  // Not written to - RawBuffer just has no const view
+  indigo::core::RawBuffer drc(const_cast<uint8_t*>(asset.payload()),
+                              asset.payload_size(), false);
+  indigo::asset::DracoDecoder decoder;
+  if (decoder.decode(drc) != indigo::asset::DracoDecoderResult::Ok) {
+    indigo::core::Logger::err(kLogLabel)
+        << "Failed to decode " << asset.asset().name();
+    return false;
+  }
+  times->DecodeUs += ::elapsed_us(start_time);
+
+  start_time = Clock::now();
+  std::vector<indigo::asset::PositionNormalVertexData> vertices(
+      decoder.num_vertices());
+  std::vector<uint32_t> indices(decoder.num_indices());
+  if (decoder.write_pos_norm_data(vertices.data()) !=
+          indigo::asset::DracoDecoderResult::Ok ||
+      decoder.write_index_data(indices.data()) !=
+          indigo::asset::DracoDecoderResult::Ok) {
+    indigo::core::Logger::err(kLogLabel)
+        << "Failed to extract vertices from " << asset.asset().name();
+    return false;
+  }
+  times->WriteUs += ::elapsed_us(start_time);
+  times->Vertices += vertices.size();
+
+  return true;
+}
+
+// Load every mesh, spread over "thread_count" threads - returns wall time
+float load_draco_meshes(const std::vector<indigo::asset::IgpackAsset>& meshes,
+                        uint32_t thread_count, DracoLoadTimes* times,
+                        bool* success) {
+  auto start_time = Clock::now();
+  std::atomic_bool all_succeeded(true);
+  std::atomic_size_t remaining(meshes.size());
+
+  auto task_list = std::make_shared<indigo::core::TaskList>();
+  for (const auto& mesh : meshes) {
+    task_list->add_task(indigo::core::Task::of(
+        [&mesh, times, &all_succeeded, &remaining]() {
+          if (!::load_draco_mesh(mesh, times)) {
+            all_succeeded = false;
+          }
+          remaining--;
+        }));
+  }
+
+  std::vector<std::shared_ptr<indigo::core::ExecutorThread>> executor_threads;
+  for (uint32_t i = 1; i < thread_count; i++) {
+    auto executor = std::make_shared<indigo::core::ExecutorThread>();
+    executor->add_task_list(task_list);
+    executor_threads.push_back(executor);
+  }
+
+  while (remaining > 0u) {
+    if (!task_list->execute_next()) {
+      std::this_thread::yield();
+    }
+  }
+
+  for (const auto& executor : executor_threads) {
+    executor->clear_all_task_lists();
+  }
+
+  *success = all_succeeded;
+  return std::chrono::duration<float, std::milli>(Clock::now() - start_time)
+      .count();
+}
+
+bool draco_load(const std::string& igpack_path, uint32_t thread_count) {
+  std::string indexed_path =
+      indigo::asset::IndexedIgpack::IndexedPathFor(igpack_path);
+  auto mapped_file = indigo::core::MappedFile::Open(indexed_path);
+  if (mapped_file.is_right()) {
+    indigo::core::Logger::err(kLogLabel) << "Could not map " << indexed_path;
+    return false;
+  }
+
+  auto file = mapped_file.left_move();
+  auto indexed_pack =
+      indigo::asset::IndexedIgpack::Open(file, file->data(), file->size());
+  if (indexed_pack.is_empty()) {
+    return false;
+  }
+
+  std::vector<indigo::asset::IgpackAsset> meshes;
+  const auto& pack = *indexed_pack.get();
+  for (uint32_t i = 0; i < pack.asset_count(); i++) {
+    const auto* entry = pack.find_entry(pack.asset_name(i));
+    if (entry->AssetType !=
+        static_cast<uint32_t>(indigo::asset::pb::SingleAsset::kDracoGeo)) {
+      continue;
+    }
+
+    auto asset = pack.read_asset(*entry);
+    if (asset.is_empty()) {
+      return false;
+    }
+    meshes.push_back(asset.move());
+  }
+
+  DracoLoadTimes serial_times, parallel_times;
+  bool serial_ok = false, parallel_ok = false;
+  float serial_ms = ::load_draco_meshes(meshes, 1u, &serial_times, &serial_ok);
+  float parallel_ms =
+      ::load_draco_meshes(meshes, thread_count, &parallel_times, &parallel_ok);
+  if (!serial_ok || !parallel_ok) {
+    return false;
+  }
+
+  std::cout << "draco_meshes: " << meshes.size() << "\n"
+            << "draco_vertices: " << serial_times.Vertices << "\n"
+            << "decode_ms: " << serial_times.DecodeUs / 1000.f << "\n"
+            << "write_gpu_layout_ms: " << serial_times.WriteUs / 1000.f << "\n"
+            << "serial_load_ms: " << serial_ms << "\n"
+            << "parallel_load_ms: " << parallel_ms << " (" << thread_count
+            << " threads)\n"
+            << "peak_rss_kb: " << ::peak_rss_kb() << std::endl;
+  return true;
+}
+struct TextureLoadTotals {
+  uint32_t Textures = 0u;
+  double PngDecodeMs = 0.;
+  uint64_t PngResidentBytes = 0u;
+  double BlockUnpackMs = 0.;
+  uint64_t BlockResidentBytes = 0u;
+  double FallbackTranscodeMs = 0.;
+};
+
+double elapsed_ms(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+bool load_compressed_texture(
+    std::shared_ptr<const indigo::asset::IgpackAsset> asset,
+    TextureLoadTotals* totals) {
+  auto start_time = Clock::now();
+  auto texture_rsl = indigo::asset::CompressedTexture::Create(std::move(asset));
+  if (texture_rsl.is_right()) {
+    return false;
+  }
+  totals->BlockUnpackMs += ::elapsed_ms(start_time);
+
+  const auto& texture = *texture_rsl.get_left();
+  totals->BlockResidentBytes += texture.data_size();
+
+  start_time = Clock::now();
+  for (uint32_t mip = 0; mip < texture.mip_count(); mip++) {
+    if (texture.transcode_to_rgba(mip).is_right()) {
+      return false;
+    }
+  }
+  totals->FallbackTranscodeMs += ::elapsed_ms(start_time);
+
+  return true;
+}
+
+bool load_png_texture(const indigo::asset::IgpackAsset& asset,
+                      TextureLoadTotals* totals) {
+  auto start_time = Clock::now();
+  auto image_rsl = indigo::asset::RgbaImage::ParsePNG(asset.payload_view());
+  if (image_rsl.is_right()) {
+    indigo::core::Logger::err(kLogLabel)
+        << "Failed to decode " << asset.asset().name();
+    return false;
+  }
+  totals->PngDecodeMs += ::elapsed_ms(start_time);
+
+  const auto& image = image_rsl.get_left();
+  totals->PngResidentBytes += image.Pixels.raw_size();
+
+  indigo::asset::CompressedTextureEncoder::EncodeSettings settings;
+  settings.IsSrgb = asset.asset().png_texture_def().is_srgb();
+  auto encode_rsl =
+      indigo::asset::CompressedTextureEncoder::encode(image, settings);
+  if (encode_rsl.is_right()) {
+    indigo::core::Logger::log(kLogLabel)
+        << "Skipping " << asset.asset().name() << " (" << image.Width << "x"
+        << image.Height << " cannot be block compressed)";
+    return true;
+  }
+
+  auto compressed = std::make_shared<indigo::asset::pb::SingleAsset>();
+  compressed->set_name(asset.asset().name());
+  *compressed->mutable_compressed_texture_def() = encode_rsl.left_move();
+
+  // Keep the proto alive with the IgpackAsset that points into it
+  auto holder = std::make_shared<std::pair<
+      std::shared_ptr<indigo::asset::pb::SingleAsset>,
+      indigo::asset::IgpackAsset>>(
+      compressed, indigo::asset::IgpackAsset::FromProto(*compressed));
+  return ::load_compressed_texture(
+      std::shared_ptr<const indigo::asset::IgpackAsset>(holder,
+                                                        &holder->second),
+      totals);
+}
+
+bool texture_load(const std::string& igpack_path) {
+  std::string indexed_path =
+      indigo::asset::IndexedIgpack::IndexedPathFor(igpack_path);
+  auto mapped_file = indigo::core::MappedFile::Open(indexed_path);
+  if (mapped_file.is_right()) {
+    indigo::core::Logger::err(kLogLabel) << "Could not map " << indexed_path;
+    return false;
+  }
+
+  auto file = mapped_file.left_move();
+  auto indexed_pack =
+      indigo::asset::IndexedIgpack::Open(file, file->data(), file->size());
+  if (indexed_pack.is_empty()) {
+    return false;
+  }
+
+  TextureLoadTotals png_totals, compressed_totals;
+  const auto& pack = *indexed_pack.get();
+  for (uint32_t i = 0; i < pack.asset_count(); i++) {
+    const auto* entry = pack.find_entry(pack.asset_name(i));
+    auto asset_type =
+        static_cast<indigo::asset::pb::SingleAsset::AssetCase>(
+            entry->AssetType);
+    if (asset_type != indigo::asset::pb::SingleAsset::kPngTextureDef &&
+        asset_type != indigo::asset::pb::SingleAsset::kCompressedTextureDef) {
+      continue;
+    }
+
+    auto asset = pack.read_asset(*entry);
+    if (asset.is_empty()) {
+      return false;
+    }
+
+    if (asset_type == indigo::asset::pb::SingleAsset::kPngTextureDef) {
+      png_totals.Textures++;
+      if (!::load_png_texture(asset.get(), &png_totals)) {
+        return false;
+      }
+    } else {
+      compressed_totals.Textures++;
+      if (!::load_compressed_texture(
+              std::make_shared<const indigo::asset::IgpackAsset>(
+                  asset.move()),
+              &compressed_totals)) {
+        return false;
+      }
+    }
+  }
+
+  std::cout << "png_textures: " << png_totals.Textures << "\n"
+            << "png_decode_ms: " << png_totals.PngDecodeMs << "\n"
+            << "png_rgba8_resident_bytes: " << png_totals.PngResidentBytes
+            << "\n"
+            << "as_bc_unpack_ms: " << png_totals.BlockUnpackMs << "\n"
+            << "as_bc_resident_bytes_with_mips: "
+            << png_totals.BlockResidentBytes << "\n"
+            << "as_bc_rgba8_fallback_ms: " << png_totals.FallbackTranscodeMs
+            << "\n"
+            << "compressed_textures: " << compressed_totals.Textures << "\n"
+            << "compressed_unpack_ms: " << compressed_totals.BlockUnpackMs
+            << "\n"
+            << "compressed_resident_bytes: "
+            << compressed_totals.BlockResidentBytes << "\n"
+            << "compressed_rgba8_fallback_ms: "
+            << compressed_totals.FallbackTranscodeMs << std::endl;
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  CLI::App app{"igpack-bench - time-to-first-asset for Indigo asset packs"};
+
+  std::string igpack_path;
+  app.add_option("-i,--igpack", igpack_path,
+                 "Path of the protobuf asset pack - the indexed pack is "
+                 "expected next to it")
+      ->required(true);
+
+  std::string asset_name;
+  app.add_option("-a,--asset", asset_name, "Name of the asset to read");
+
+  std::string format = "indexed";
+  app.add_option("-f,--format", format, "Pack format to read")
+      ->check(CLI::IsMember({"protobuf", "indexed", "download", "streaming"}));
+
+  uint32_t latency_ms = 50u;
+  app.add_option("--latency_ms", latency_ms,
+                 "Simulated per-request latency (download/streaming)");
+
+  uint32_t bandwidth_kbps = 10000u;
+  app.add_option("--bandwidth_kbps", bandwidth_kbps,
+                 "Simulated link bandwidth (download/streaming)")
+      ->check(CLI::PositiveNumber);
+
+  bool draco_load = false;
+  app.add_flag("--draco_load", draco_load,
+               "Time loading every Draco mesh in the pack instead");
+
+  bool texture_load = false;
+  app.add_flag("--texture_load", texture_load,
+               "Compare PNG and block-compressed texture loads instead");
+
+  uint32_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  app.add_option("-j,--threads", thread_count,
+                 "Threads used for the parallel Draco load")
+      ->check(CLI::PositiveNumber);
+
+  CLI11_PARSE(app, argc, argv);
+
+  if (draco_load) {
+    return ::draco_load(igpack_path, thread_count) ? 0 : -1;
+  }
+
+  if (texture_load) {
+    return ::texture_load(igpack_path) ? 0 : -1;
+  }
+
+  if (asset_name.empty()) {
+    indigo::core::Logger::err(kLogLabel) << "--asset is required";
+    return -1;
+  }
+
+  uint64_t checksum = 0u;
+  auto start_time = Clock::now();
+  bool success = false;
+  if (format == "protobuf") {
+    success = ::first_asset_protobuf(igpack_path, asset_name, &checksum);
+  } else if (format == "indexed") {
+    success = ::first_asset_indexed(igpack_path, asset_name, &checksum);
+  } else if (format == "download") {
+    success = ::first_asset_download(igpack_path, asset_name, latency_ms,
+                                     bandwidth_kbps, &checksum);
+  } else {
+    success = ::first_asset_streaming(igpack_path, asset_name, latency_ms,
+                                      bandwidth_kbps, &checksum);
+  }
+  float elapsed_ms =
+      std::chrono::duration<float, std::milli>(Clock::now() - start_time)
+          .count();
+
+  if (!success) {
+    return -1;
+  }
+
+  std::cout << "format: " << format << "\n"
+            << "asset: " << asset_name << " (checksum " << checksum << ")\n"
+            << "time_to_first_asset_ms: " << elapsed_ms << "\n"
+            << "peak_rss_kb: " << ::peak_rss_kb() << std::endl;
+
+  return 0;
+}
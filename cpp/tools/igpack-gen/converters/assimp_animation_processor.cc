@@ -266,7 +266,10 @@ bool AssimpAnimationProcessor::export_skeleton(
   // Step 5: save off for later if the skeleton is used in animations defined
   //  later in this file.
   //
-  built_skeletons_[action.skeleton_igasset_name()] = std::move(skeleton);
+  {
+    std::lock_guard<std::mutex> l(built_skeletons_mutex_);
+    built_skeletons_[action.skeleton_igasset_name()] = std::move(skeleton);
+  }
 
   RawBuffer raw_buffer(mem_stream.Size());
   mem_stream.Seek(0, ozz::io::MemoryStream::kSet);
@@ -317,15 +320,22 @@ bool AssimpAnimationProcessor::export_animation(
   // Step 2: Find the skeleton to which this animation will be applied, and
   //  prepare mapping from joint name to joint index
   //
-  auto skeleton_it = built_skeletons_.find(action.skeleton_igasset_name());
-  if (skeleton_it == built_skeletons_.end()) {
+  const ozz::animation::Skeleton* skeleton = nullptr;
+  {
+    // Skeletons are never removed once built, so the pointer stays valid
+    std::lock_guard<std::mutex> l(built_skeletons_mutex_);
+    auto skeleton_it = built_skeletons_.find(action.skeleton_igasset_name());
+    if (skeleton_it != built_skeletons_.end()) {
+      skeleton = skeleton_it->second.get();
+    }
+  }
+  if (skeleton == nullptr) {
     Logger::err(kLogLabel) << "Failed to load skeleton "
                            << action.skeleton_igasset_name()
                            << ", cannot construct animation "
                            << action.assimp_animation_name();
     return false;
   }
-  const auto& skeleton = skeleton_it->second;
 
   std::unordered_map<std::string, uint32_t> name_to_index;
   {
@@ -454,7 +464,7 @@ bool AssimpAnimationProcessor::export_animation(
       }
     }
 
-    if (optimizer(raw_animation, *skeleton_it->second, &out_animation)) {
+    if (optimizer(raw_animation, *skeleton, &out_animation)) {
       is_optimized = true;
     } else {
       Logger::err(kLogLabel)
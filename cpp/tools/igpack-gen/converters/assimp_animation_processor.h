@@ -9,10 +9,17 @@
 #include <util/file_cache.h>
 
 #include <map>
+#include <mutex>
 #include <string>
 
 namespace indigo::igpackgen {
 
+/**
+ * Bone registration (preload_animation_bones / validate_bones_exist) must
+ *  finish before any exports start. After that, export_skeleton and
+ *  export_animation may be called from multiple threads, as long as each
+ *  skeleton is exported before any animation that uses it.
+ */
 class AssimpAnimationProcessor {
  private:
   struct SkeletonMetadata {
@@ -42,6 +49,7 @@ class AssimpAnimationProcessor {
  private:
   std::map<std::string, SkeletonMetadata> skeleton_bones_;
 
+  std::mutex built_skeletons_mutex_;
   std::map<std::string, ozz::unique_ptr<ozz::animation::Skeleton>>
       built_skeletons_;
 };
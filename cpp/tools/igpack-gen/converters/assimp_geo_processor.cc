@@ -1,9 +1,12 @@
 #include <converters/assimp_geo_processor.h>
 #include <igasset/draco_encoder.h>
 #include <igasset/proto_converters.h>
+#include <igasset/raw_mesh_encoder.h>
+#include <igasset/terrain_chunker.h>
 #include <igcore/log.h>
 #include <igcore/vector.h>
 
+#include <algorithm>
 #include <glm/gtx/quaternion.hpp>
 
 using namespace indigo;
@@ -90,17 +93,163 @@ core::Maybe<BaseGeoData> extract_base_geo(const aiMesh* mesh) {
                        std::move(index_data)};
 }
 
+core::Maybe<std::string> encode_draco(
+    const core::PodVector<asset::PositionNormalVertexData>& pos_norm_data,
+    const core::PodVector<asset::TexcoordVertexData>* texcoord_data,
+    const core::PodVector<asset::SkeletalAnimationVertexData>* skinning_data,
+    const core::PodVector<uint32_t>& index_data,
+    const pb::DracoConversionParams& params) {
+  asset::DracoEncoder encoder;
+  if (encoder.add_pos_norm_data(pos_norm_data) != asset::DracoEncoderResult::Ok) {
+    return core::empty_maybe{};
+  }
+  if (texcoord_data != nullptr && encoder.add_texcoord_data(*texcoord_data) !=
+                                      asset::DracoEncoderResult::Ok) {
+    return core::empty_maybe{};
+  }
+  if (encoder.add_index_data(index_data) != asset::DracoEncoderResult::Ok) {
+    return core::empty_maybe{};
+  }
+  if (skinning_data != nullptr &&
+      encoder.add_skeletal_animation_data(*skinning_data) !=
+          asset::DracoEncoderResult::Ok) {
+    return core::empty_maybe{};
+  }
+
+  asset::DracoEncoder::EncodeSettings settings{};
+  settings.EncodeSpeed = params.compression_speed();
+  settings.DecodeSpeed = params.decompression_speed();
+
+  auto encode_rsl = encoder.encode(settings);
+  if (encode_rsl.is_right()) {
+    core::Logger::err(kLogLabel) << "DracoEncoder failed to encode data";
+    return core::empty_maybe{};
+  }
+
+  const core::RawBuffer& raw = encode_rsl.get_left();
+  return std::string(reinterpret_cast<const char*>(raw.get()), raw.size());
+}
+
+core::Maybe<asset::pb::RawMeshDef> encode_raw_mesh(
+    const core::PodVector<asset::PositionNormalVertexData>& pos_norm_data,
+    const core::PodVector<asset::TexcoordVertexData>* texcoord_data,
+    const core::PodVector<asset::SkeletalAnimationVertexData>* skinning_data,
+    const core::PodVector<uint32_t>& index_data,
+    const pb::RawMeshParams& params) {
+  asset::RawMeshEncoder encoder;
+  if (encoder.add_pos_norm_data(pos_norm_data) !=
+      asset::RawMeshEncoderResult::Ok) {
+    return core::empty_maybe{};
+  }
+  if (texcoord_data != nullptr && encoder.add_texcoord_data(*texcoord_data) !=
+                                      asset::RawMeshEncoderResult::Ok) {
+    return core::empty_maybe{};
+  }
+  if (encoder.add_index_data(index_data) != asset::RawMeshEncoderResult::Ok) {
+    return core::empty_maybe{};
+  }
+  if (skinning_data != nullptr &&
+      encoder.add_skeletal_animation_data(*skinning_data) !=
+          asset::RawMeshEncoderResult::Ok) {
+    return core::empty_maybe{};
+  }
+
+  asset::RawMeshEncoder::EncodeSettings settings;
+  if (params.position_mantissa_bits() > 0u) {
+    settings.PositionMantissaBits =
+        std::min(params.position_mantissa_bits(), 23u);
+  }
+  if (params.normal_mantissa_bits() > 0u) {
+    settings.NormalMantissaBits = std::min(params.normal_mantissa_bits(), 23u);
+  }
+  settings.Codec = params.skip_lz4() ? asset::pb::RawMeshDef::NONE
+                                     : asset::pb::RawMeshDef::LZ4;
+
+  auto encode_rsl = encoder.encode(settings);
+  if (encode_rsl.is_right()) {
+    core::Logger::err(kLogLabel) << "RawMeshEncoder failed to encode data";
+    return core::empty_maybe{};
+  }
+
+  return encode_rsl.left_move();
+}
+
+/**
+ * Encode a mesh into "new_asset" - as a RawMeshDef if "raw_mesh_params" is
+ *  set, Draco geometry otherwise. Bone names / inverse bind poses are left to
+ *  the caller.
+ */
+bool write_mesh_asset(
+    asset::pb::SingleAsset* new_asset,
+    const core::PodVector<asset::PositionNormalVertexData>& pos_norm_data,
+    const core::PodVector<asset::TexcoordVertexData>* texcoord_data,
+    const core::PodVector<asset::SkeletalAnimationVertexData>* skinning_data,
+    const core::PodVector<uint32_t>& index_data,
+    const pb::DracoConversionParams& draco_params,
+    const pb::RawMeshParams* raw_mesh_params,
+    MeshFormatReport* mesh_report) {
+  core::Maybe<std::string> draco_data;
+  if (raw_mesh_params == nullptr || mesh_report != nullptr) {
+    draco_data = ::encode_draco(pos_norm_data, texcoord_data, skinning_data,
+                                index_data, draco_params);
+    if (draco_data.is_empty()) {
+      return false;
+    }
+  }
+
+  // Reports compare against the default raw mesh settings for Draco meshes
+  core::Maybe<asset::pb::RawMeshDef> raw_mesh_def;
+  if (raw_mesh_params != nullptr || mesh_report != nullptr) {
+    raw_mesh_def = ::encode_raw_mesh(
+        pos_norm_data, texcoord_data, skinning_data, index_data,
+        raw_mesh_params ? *raw_mesh_params : pb::RawMeshParams());
+    if (raw_mesh_def.is_empty()) {
+      return false;
+    }
+  }
+
+  if (mesh_report != nullptr) {
+    const asset::pb::RawMeshDef& def = raw_mesh_def.get();
+    mesh_report->add(MeshFormatReport::Entry{
+        new_asset->name(), def.vertex_count(), def.index_count(),
+        draco_data.get().size(),
+        MeshFormatReport::time_draco_decode_ms(draco_data.get()),
+        def.data().size(), def.uncompressed_size(),
+        MeshFormatReport::time_raw_decode_ms(def)});
+  }
+
+  if (raw_mesh_params != nullptr) {
+    *new_asset->mutable_raw_mesh_def() = raw_mesh_def.move();
+  } else {
+    new_asset->mutable_draco_geo()->set_data(draco_data.move());
+  }
+
+  return true;
+}
+
+template <typename MeshDefT>
+bool add_bone_data(MeshDefT* mesh_def,
+                   const core::Vector<std::string>& bone_names,
+                   const core::PodVector<glm::mat4>& inv_bind_poses) {
+  for (int i = 0; i < bone_names.size(); i++) {
+    mesh_def->add_ozz_bone_names(bone_names[i]);
+    auto* pb_inv_bind = mesh_def->add_inv_bind_pose();
+    if (!asset::write_pb_mat4(pb_inv_bind, inv_bind_poses[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace
 
 bool AssimpGeoProcessor::export_static_draco_geo(
     asset::pb::AssetPack& output_asset_pack,
     const pb::AssimpToStaticDracoGeoAction& action, FileCache& file_cache,
-    AssimpSceneCache& assimp_scene_cache) {
+    AssimpSceneCache& assimp_scene_cache, MeshFormatReport* mesh_report) {
   std::string file_name = action.input_file_path();
   asset::pb::SingleAsset* new_asset = output_asset_pack.add_assets();
-  asset::pb::DracoGeometryDef* draco_pbr_geo_asset =
-      new_asset->mutable_draco_geo();
-
   new_asset->set_name(action.mesh_igasset_name());
 
   bool has_texcoords = false;
@@ -111,7 +260,7 @@ bool AssimpGeoProcessor::export_static_draco_geo(
   for (int i = 0; i < action.assimp_mesh_names_size(); i++) {
     std::string mesh_name = action.assimp_mesh_names(i);
 
-    core::Maybe<aiMesh*> maybe_mesh =
+    core::Maybe<AssimpMeshRef> maybe_mesh =
         assimp_scene_cache.load_mesh(file_cache, file_name, mesh_name);
     if (maybe_mesh.is_empty()) {
       core::Logger::err(kLogLabel)
@@ -119,7 +268,7 @@ bool AssimpGeoProcessor::export_static_draco_geo(
       return false;
     }
 
-    aiMesh* mesh = maybe_mesh.get();
+    aiMesh* mesh = maybe_mesh.get().Mesh;
     if (i == 0) {
       has_texcoords = mesh->HasTextureCoords(0);
     } else {
@@ -141,14 +290,14 @@ bool AssimpGeoProcessor::export_static_draco_geo(
   for (int i = 0; i < action.assimp_mesh_names_size(); i++) {
     std::string mesh_name = action.assimp_mesh_names(i);
 
-    core::Maybe<aiMesh*> maybe_mesh =
+    core::Maybe<AssimpMeshRef> maybe_mesh =
         assimp_scene_cache.load_mesh(file_cache, file_name, mesh_name);
     if (maybe_mesh.is_empty()) {
       // This check should not be necessary, since it's done above
       return false;
     }
 
-    aiMesh* mesh = maybe_mesh.get();
+    aiMesh* mesh = maybe_mesh.get().Mesh;
 
     auto geo_data = ::extract_base_geo(mesh);
     if (geo_data.is_empty()) {
@@ -168,33 +317,112 @@ bool AssimpGeoProcessor::export_static_draco_geo(
     index_offset += mesh->mNumFaces * 3;
   }
 
-  asset::DracoEncoder encoder;
-  encoder.add_pos_norm_data(std::move(pos_norm_data));
-  if (has_texcoords) {
-    encoder.add_texcoord_data(std::move(texcoord_data));
+  return ::write_mesh_asset(
+      new_asset, pos_norm_data, has_texcoords ? &texcoord_data : nullptr,
+      nullptr, index_data, action.draco_params(),
+      action.has_raw_mesh_params() ? &action.raw_mesh_params() : nullptr,
+      mesh_report);
+}
+
+bool AssimpGeoProcessor::export_terrain_chunks(
+    asset::pb::AssetPack& output_asset_pack,
+    const pb::AssimpToTerrainChunksAction& action, FileCache& file_cache,
+    AssimpSceneCache& assimp_scene_cache, MeshFormatReport* mesh_report) {
+  if (action.chunk_size() <= 0.f) {
+    core::Logger::err(kLogLabel)
+        << "Terrain chunks " << action.igasset_name()
+        << " need a positive chunk_size";
+    return false;
   }
-  encoder.add_index_data(std::move(index_data));
 
-  asset::DracoEncoder::EncodeSettings settings{};
-  if (action.has_draco_params()) {
-    settings.EncodeSpeed = action.draco_params().compression_speed();
-    settings.DecodeSpeed = action.draco_params().decompression_speed();
-  } else {
-    settings.EncodeSpeed = 0;
-    settings.DecodeSpeed = 0;
+  core::PodVector<asset::PositionNormalVertexData> pos_norm_data;
+  core::PodVector<uint32_t> index_data;
+  for (int i = 0; i < action.assimp_mesh_names_size(); i++) {
+    core::Maybe<AssimpMeshRef> maybe_mesh = assimp_scene_cache.load_mesh(
+        file_cache, action.input_file_path(), action.assimp_mesh_names(i));
+    if (maybe_mesh.is_empty()) {
+      core::Logger::err(kLogLabel)
+          << "Assimp mesh not found for terrain " << action.igasset_name();
+      return false;
+    }
+
+    auto geo_data = ::extract_base_geo(maybe_mesh.get().Mesh);
+    if (geo_data.is_empty()) {
+      return false;
+    }
+
+    const uint32_t base_vertex = static_cast<uint32_t>(pos_norm_data.size());
+    for (int v = 0; v < geo_data.get().posNormData.size(); v++) {
+      pos_norm_data.push_back(geo_data.get().posNormData[v]);
+    }
+    for (int v = 0; v < geo_data.get().indexData.size(); v++) {
+      index_data.push_back(geo_data.get().indexData[v] + base_vertex);
+    }
   }
 
-  auto encode_rsl = encoder.encode(settings);
-  if (encode_rsl.is_right()) {
-    core::Logger::err(kLogLabel) << "DracoEncoder failed to encode data";
-    return false;
+  asset::TerrainChunker::Params params{};
+  params.chunkSize = action.chunk_size();
+  for (float cell_size : action.lod_cell_sizes()) {
+    params.lodCellSizes.push_back(cell_size);
   }
 
-  auto& raw = encode_rsl.get_left();
+  auto chunks = asset::TerrainChunker::build(pos_norm_data, index_data, params);
+
+  asset::pb::SingleAsset* chunks_asset = output_asset_pack.add_assets();
+  chunks_asset->set_name(action.igasset_name());
+  auto* chunks_def = chunks_asset->mutable_terrain_chunks_def();
+  chunks_def->set_chunk_size(action.chunk_size());
+
+  uint64_t full_detail_tris = 0u;
+  uint64_t coarsest_tris = 0u;
+  for (int c = 0; c < chunks.size(); c++) {
+    const asset::TerrainChunk& chunk = chunks[c];
+    auto* pb_chunk = chunks_def->add_chunks();
+    pb_chunk->set_min_x(chunk.boundsMin.x);
+    pb_chunk->set_min_y(chunk.boundsMin.y);
+    pb_chunk->set_min_z(chunk.boundsMin.z);
+    pb_chunk->set_max_x(chunk.boundsMax.x);
+    pb_chunk->set_max_y(chunk.boundsMax.y);
+    pb_chunk->set_max_z(chunk.boundsMax.z);
+
+    for (int l = 0; l < chunk.lods.size(); l++) {
+      const asset::TerrainChunkMesh& lod = chunk.lods[l];
+
+      // Everything collapsed - coarser LODs are empty too, stop here
+      if (lod.triangle_count() == 0u) {
+        break;
+      }
 
-  std::string* raw_data = draco_pbr_geo_asset->mutable_data();
-  raw_data->resize(raw.size());
-  memcpy(&(*raw_data)[0], raw.get(), raw.size());
+      std::string geo_name = action.igasset_name() + "." + std::to_string(c) +
+                             "." + std::to_string(l);
+
+      asset::pb::SingleAsset* geo_asset = output_asset_pack.add_assets();
+      geo_asset->set_name(geo_name);
+      if (!::write_mesh_asset(
+              geo_asset, lod.vertices, nullptr, nullptr, lod.indices,
+              action.draco_params(),
+              action.has_raw_mesh_params() ? &action.raw_mesh_params()
+                                           : nullptr,
+              mesh_report)) {
+        return false;
+      }
+
+      auto* pb_lod = pb_chunk->add_lods();
+      pb_lod->set_geo_igasset_name(geo_name);
+      pb_lod->set_triangle_count(lod.triangle_count());
+    }
+
+    if (pb_chunk->lods_size() > 0) {
+      full_detail_tris += pb_chunk->lods(0).triangle_count();
+      coarsest_tris +=
+          pb_chunk->lods(pb_chunk->lods_size() - 1).triangle_count();
+    }
+  }
+
+  core::Logger::log(kLogLabel)
+      << "Terrain " << action.igasset_name() << ": " << chunks.size()
+      << " chunks, " << full_detail_tris << " triangles at full detail, "
+      << coarsest_tris << " at the coarsest LOD";
 
   return true;
 }
@@ -207,11 +435,11 @@ bool AssimpGeoProcessor::export_static_draco_geo(
 bool AssimpGeoProcessor::export_skinned_draco_geo(
     asset::pb::AssetPack& output_asset_pack,
     const pb::AssimpExtractSkinnedMeshToDraco& action, FileCache& file_cache,
-    AssimpSceneCache& assimp_scene_cache) {
+    AssimpSceneCache& assimp_scene_cache, MeshFormatReport* mesh_report) {
   std::string file_name = action.input_file_path();
   std::string mesh_name = action.assimp_mesh_name();
 
-  core::Maybe<aiMesh*> maybe_mesh =
+  core::Maybe<AssimpMeshRef> maybe_mesh =
       assimp_scene_cache.load_mesh(file_cache, file_name, mesh_name);
 
   if (maybe_mesh.is_empty()) {
@@ -220,7 +448,7 @@ bool AssimpGeoProcessor::export_skinned_draco_geo(
     return false;
   }
 
-  const aiMesh* mesh = maybe_mesh.get();
+  const aiMesh* mesh = maybe_mesh.get().Mesh;
 
   if (!mesh->HasBones()) {
     core::Logger::err(kLogLabel)
@@ -305,63 +533,29 @@ bool AssimpGeoProcessor::export_skinned_draco_geo(
     }
   }
 
-  asset::DracoEncoder encoder;
-  if (encoder.add_pos_norm_data(base_geo.posNormData) !=
-      asset::DracoEncoderResult::Ok) {
-    return false;
-  }
-  if (base_geo.texcoordData.size() > 0) {
-    if (encoder.add_texcoord_data(base_geo.texcoordData) !=
-        asset::DracoEncoderResult::Ok) {
-      return false;
-    }
-  }
-  if (encoder.add_index_data(base_geo.indexData) !=
-      asset::DracoEncoderResult::Ok) {
-    return false;
-  }
+  asset::pb::SingleAsset* new_asset = output_asset_pack.add_assets();
+  new_asset->set_name(action.mesh_igasset_name());
 
-  if (encoder.add_skeletal_animation_data(skinning_vertices) !=
-      asset::DracoEncoderResult::Ok) {
+  bool has_texcoords = base_geo.texcoordData.size() > 0;
+  if (!::write_mesh_asset(
+          new_asset, base_geo.posNormData,
+          has_texcoords ? &base_geo.texcoordData : nullptr, &skinning_vertices,
+          base_geo.indexData, action.draco_params(),
+          action.has_raw_mesh_params() ? &action.raw_mesh_params() : nullptr,
+          mesh_report)) {
     return false;
   }
 
-  auto encode_rsl = encoder.encode();
-  if (encode_rsl.is_right()) {
-    return false;
+  if (new_asset->has_raw_mesh_def()) {
+    return ::add_bone_data(new_asset->mutable_raw_mesh_def(), bone_names,
+                           inv_bind_poses);
   }
 
-  core::RawBuffer raw = encode_rsl.left_move();
-
-  asset::DracoEncoder::EncodeSettings settings{};
-  if (action.has_draco_params()) {
-    settings.EncodeSpeed = action.draco_params().compression_speed();
-    settings.DecodeSpeed = action.draco_params().decompression_speed();
-  } else {
-    settings.EncodeSpeed = 0;
-    settings.DecodeSpeed = 0;
-  }
-
-  asset::pb::SingleAsset* new_asset = output_asset_pack.add_assets();
   asset::pb::DracoGeometryDef* draco_pbr_geo_asset =
       new_asset->mutable_draco_geo();
-  new_asset->set_name(action.mesh_igasset_name());
-
-  std::string* raw_data = draco_pbr_geo_asset->mutable_data();
-  raw_data->resize(raw.size());
-  memcpy(&(*raw_data)[0], raw.get(), raw.size());
-
   draco_pbr_geo_asset->set_has_bone_data(true);
   draco_pbr_geo_asset->set_has_pos_norm(true);
-  draco_pbr_geo_asset->set_has_texcoords(base_geo.texcoordData.size() > 0);
+  draco_pbr_geo_asset->set_has_texcoords(has_texcoords);
 
-  for (int i = 0; i < bone_names.size(); i++) {
-    draco_pbr_geo_asset->add_ozz_bone_names(bone_names[i]);
-    auto* pb_inv_bind = draco_pbr_geo_asset->add_inv_bind_pose();
-    if (!asset::write_pb_mat4(pb_inv_bind, inv_bind_poses[i])) {
-      return false;
-    }
-  }
-
-  return true;
+  return ::add_bone_data(draco_pbr_geo_asset, bone_names, inv_bind_poses);
 }
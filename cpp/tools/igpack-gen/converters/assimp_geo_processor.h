@@ -5,22 +5,39 @@
 #include <igpack-gen/proto/igpack-plan.pb.h>
 #include <util/assimp_scene_cache.h>
 #include <util/file_cache.h>
+#include <util/mesh_format_report.h>
 
 #include <string>
 
 namespace indigo::igpackgen {
 
+/**
+ * Exports Assimp meshes as Draco geometry, or as a pre-baked RawMeshDef if the
+ *  action has raw_mesh_params. If a mesh format report is given, every mesh
+ *  is also encoded (and timed) in the format that was not picked.
+ *
+ * Terrain meshes may instead be exported as LOD'd chunks (TerrainChunksDef,
+ *  see asset::TerrainChunker).
+ */
 class AssimpGeoProcessor {
  public:
   bool export_static_draco_geo(asset::pb::AssetPack& output_asset_pack,
                                const pb::AssimpToStaticDracoGeoAction& action,
                                FileCache& file_cache,
-                               AssimpSceneCache& assimp_scene_cache);
+                               AssimpSceneCache& assimp_scene_cache,
+                               MeshFormatReport* mesh_report = nullptr);
 
   bool export_skinned_draco_geo(
       asset::pb::AssetPack& output_asset_pack,
       const pb::AssimpExtractSkinnedMeshToDraco& action, FileCache& file_cache,
-      AssimpSceneCache& assimp_scene_cache);
+      AssimpSceneCache& assimp_scene_cache,
+      MeshFormatReport* mesh_report = nullptr);
+
+  bool export_terrain_chunks(asset::pb::AssetPack& output_asset_pack,
+                             const pb::AssimpToTerrainChunksAction& action,
+                             FileCache& file_cache,
+                             AssimpSceneCache& assimp_scene_cache,
+                             MeshFormatReport* mesh_report = nullptr);
 };
 
 }  // namespace indigo::igpackgen
@@ -97,7 +97,7 @@ bool RecastNavmeshProcessor::export_recast_navmesh(
     if (build_op.has_include_assimp_geo()) {
       std::string file_name = build_op.include_assimp_geo().assimp_file_name();
       std::string mesh_name = build_op.include_assimp_geo().assimp_mesh_name();
-      Maybe<aiMesh*> maybe_mesh =
+      Maybe<AssimpMeshRef> maybe_mesh =
           assimp_scene_cache.load_mesh(file_cache, file_name, mesh_name);
       if (maybe_mesh.is_empty()) {
         Logger::err(kLogLabel)
@@ -106,7 +106,7 @@ bool RecastNavmeshProcessor::export_recast_navmesh(
         return false;
       }
 
-      aiMesh* mesh = maybe_mesh.get();
+      aiMesh* mesh = maybe_mesh.get().Mesh;
 
       PodVector<glm::vec3> positions(mesh->mNumVertices);
       PodVector<uint32_t> indices(mesh->mNumFaces * 3);
@@ -0,0 +1,48 @@
+#include <converters/texture_processor.h>
+#include <igasset/compressed_texture_encoder.h>
+#include <igasset/image_data.h>
+#include <igcore/log.h>
+
+using namespace indigo;
+using namespace igpackgen;
+
+namespace {
+const char* kLogLabel = "TextureProcessor";
+}  // namespace
+
+bool TextureProcessor::convert_texture(
+    asset::pb::AssetPack& output_asset_pack,
+    const pb::ConvertTextureAction& action,
+    const std::string& image_data) const {
+  auto image_rsl = asset::RgbaImage::ParsePNG(image_data);
+  if (image_rsl.is_right()) {
+    core::Logger::err(kLogLabel)
+        << "Could not decode image " << action.input_file_path();
+    return false;
+  }
+
+  asset::CompressedTextureEncoder::EncodeSettings settings;
+  settings.IsSrgb = action.is_srgb();
+  settings.GenerateMips = !action.skip_mips();
+  settings.AutoFormat = action.format() == pb::ConvertTextureAction::AUTO;
+  settings.Format = action.format() == pb::ConvertTextureAction::BC3
+                        ? asset::pb::CompressedTextureDef::BC3_RGBA
+                        : asset::pb::CompressedTextureDef::BC1_RGB;
+  settings.Supercompression = action.skip_lz4()
+                                  ? asset::pb::CompressedTextureDef::NONE
+                                  : asset::pb::CompressedTextureDef::LZ4;
+
+  auto encode_rsl =
+      asset::CompressedTextureEncoder::encode(image_rsl.get_left(), settings);
+  if (encode_rsl.is_right()) {
+    core::Logger::err(kLogLabel)
+        << "Could not encode texture " << action.texture_igasset_name();
+    return false;
+  }
+
+  asset::pb::SingleAsset* new_asset = output_asset_pack.add_assets();
+  new_asset->set_name(action.texture_igasset_name());
+  *new_asset->mutable_compressed_texture_def() = encode_rsl.left_move();
+
+  return true;
+}
@@ -0,0 +1,20 @@
+#ifndef TOOLS_IGPACK_GEN_CONVERTERS_TEXTURE_PROCESSOR_H
+#define TOOLS_IGPACK_GEN_CONVERTERS_TEXTURE_PROCESSOR_H
+
+#include <igasset/proto/igasset.pb.h>
+#include <igpack-gen/proto/igpack-plan.pb.h>
+
+#include <string>
+
+namespace indigo::igpackgen {
+
+class TextureProcessor {
+ public:
+  bool convert_texture(asset::pb::AssetPack& output_asset_pack,
+                       const pb::ConvertTextureAction& action,
+                       const std::string& image_data) const;
+};
+
+}  // namespace indigo::igpackgen
+
+#endif
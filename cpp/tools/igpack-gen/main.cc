@@ -38,6 +38,26 @@ int main(int argc, char** argv) {
       ->required(true)
       ->check(CLI::ExistingFile);
 
+  std::string manifest_file_path;
+  app.add_option("-m,--manifest_file", manifest_file_path,
+                 "Path of the incremental build manifest - defaults to "
+                 "<output_asset_path_root>/<plan name>.igpack-manifest");
+
+  uint32_t thread_count = 0u;
+  app.add_option("-j,--threads", thread_count,
+                 "Number of threads used to run plan actions (default: one per "
+                 "hardware thread)");
+
+  bool force_rebuild = false;
+  app.add_flag("-f,--force", force_rebuild,
+               "Rebuild every asset pack, even ones that are up to date");
+
+  std::string mesh_report_path;
+  app.add_option("--mesh_report", mesh_report_path,
+                 "Write a CSV comparing size and decode time of each rebuilt "
+                 "mesh as Draco and as a pre-baked raw mesh (use with -f to "
+                 "cover every pack)");
+
   CLI11_PARSE(app, argc, argv);
 
   //
@@ -88,6 +108,17 @@ int main(int argc, char** argv) {
   plan_desc.InputAssetPathRoot = input_path;
   plan_desc.OutputAssetPathRoot = output_path;
   plan_desc.Plan = std::move(plan);
+  plan_desc.ThreadCount = thread_count;
+  plan_desc.ForceRebuild = force_rebuild;
+  plan_desc.MeshReportPath = mesh_report_path;
+  if (manifest_file_path.empty()) {
+    plan_desc.ManifestPath =
+        output_path / std::filesystem::path(input_plan_file_path)
+                          .stem()
+                          .concat(".igpack-manifest");
+  } else {
+    plan_desc.ManifestPath = manifest_file_path;
+  }
 
   if (!executor.execute_plan(plan_desc)) {
     Logger::err(kLogLabel) << "Plan execution failed!";
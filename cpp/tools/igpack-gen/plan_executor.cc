@@ -1,11 +1,27 @@
+#include <igasset/indexed_igpack.h>
+#include <igasync/task_list.h>
+#include <igcore/config.h>
 #include <igcore/log.h>
+#include <igcore/vector.h>
 #include <plan_executor.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <memory>
+#include <thread>
+
+#ifdef IG_ENABLE_THREADS
+#include <igasync/executor_thread.h>
+#endif
 
 namespace {
 const char* kLogLabel = "PlanExecutor";
-}
+
+// Bump whenever converter output changes, to invalidate existing manifests
+const char* kManifestVersion = "igpack-gen-manifest-2";
+}  // namespace
 
 using namespace indigo;
 using namespace igpackgen;
@@ -16,6 +32,13 @@ PlanExecutor::PlanExecutor(uint32_t max_file_memory_cache)
       recast_navmesh_processor_() {}
 
 bool PlanExecutor::execute_plan(const PlanInvocationDesc& desc) {
+  auto start_time = std::chrono::high_resolution_clock::now();
+  auto elapsed_seconds = [start_time]() {
+    return std::chrono::duration<float>(
+               std::chrono::high_resolution_clock::now() - start_time)
+        .count();
+  };
+
   // Validate all inputs are present
   for (int i = 0; i < desc.Plan.plan_size(); i++) {
     if (!validate_inputs_exist(desc.InputAssetPathRoot, desc.Plan.plan(i))) {
@@ -28,6 +51,63 @@ bool PlanExecutor::execute_plan(const PlanInvocationDesc& desc) {
   FileCache file_cache(desc.InputAssetPathRoot, max_file_memory_cache_);
   AssimpSceneCache assimp_scene_cache(max_file_memory_cache_);
 
+  //
+  // Figure out which asset packs are out of date
+  //
+  PlanManifest manifest;
+  if (!desc.ManifestPath.empty()) {
+    manifest = PlanManifest::Load(desc.ManifestPath);
+  }
+
+  std::map<std::string, uint64_t> file_hashes;
+  std::vector<uint64_t> plan_hashes(desc.Plan.plan_size());
+  std::vector<bool> is_dirty(desc.Plan.plan_size());
+  int dirty_count = 0;
+  for (int plan_idx = 0; plan_idx < desc.Plan.plan_size(); plan_idx++) {
+    const pb::SingleIgpackPlan& plan = desc.Plan.plan(plan_idx);
+    plan_hashes[plan_idx] =
+        plan_content_hash(desc.Plan, plan_idx, file_cache, file_hashes);
+
+    auto last_hash = manifest.get(plan.asset_pack_file_path());
+    is_dirty[plan_idx] =
+        desc.ForceRebuild || desc.ManifestPath.empty() ||
+        last_hash.is_empty() || last_hash.get() != plan_hashes[plan_idx] ||
+        !std::filesystem::exists(desc.OutputAssetPathRoot /
+                                 plan.asset_pack_file_path()) ||
+        !std::filesystem::exists(asset::IndexedIgpack::IndexedPathFor(
+            (desc.OutputAssetPathRoot / plan.asset_pack_file_path())
+                .string()));
+    if (is_dirty[plan_idx]) {
+      dirty_count++;
+    }
+  }
+
+  if (dirty_count == 0) {
+    core::Logger::log(kLogLabel)
+        << "All " << desc.Plan.plan_size() << " asset packs are up to date ("
+        << elapsed_seconds() << "s)";
+    return true;
+  }
+
+  // Skeletons are built once per plan file, and shared with every animation
+  //  that uses them - any skeleton referenced by an out of date pack needs to
+  //  be rebuilt, even if the skeleton action itself lives in another pack.
+  std::set<std::string> needed_skeletons;
+  for (int plan_idx = 0; plan_idx < desc.Plan.plan_size(); plan_idx++) {
+    if (!is_dirty[plan_idx]) {
+      continue;
+    }
+    for (const pb::SingleAction& action : desc.Plan.plan(plan_idx).actions()) {
+      if (action.has_extract_ozz_skeleton()) {
+        needed_skeletons.insert(
+            action.extract_ozz_skeleton().skeleton_igasset_name());
+      } else if (action.has_extract_ozz_animation()) {
+        needed_skeletons.insert(
+            action.extract_ozz_animation().skeleton_igasset_name());
+      }
+    }
+  }
+
   // Pre-register which skeleton bones will be used from each animation in the
   //  file, and make sure that all skeletons loaded are (1) used by animations,
   //  and (2) well-formed
@@ -36,7 +116,9 @@ bool PlanExecutor::execute_plan(const PlanInvocationDesc& desc) {
          action_idx < desc.Plan.plan(plan_idx).actions_size(); action_idx++) {
       const pb::SingleAction& action =
           desc.Plan.plan(plan_idx).actions(action_idx);
-      if (action.has_extract_ozz_animation()) {
+      if (action.has_extract_ozz_animation() &&
+          needed_skeletons.count(
+              action.extract_ozz_animation().skeleton_igasset_name()) > 0) {
         if (!assimp_animation_processor_.preload_animation_bones(
                 action.extract_ozz_animation(), file_cache,
                 assimp_scene_cache)) {
@@ -56,7 +138,9 @@ bool PlanExecutor::execute_plan(const PlanInvocationDesc& desc) {
          action_idx < desc.Plan.plan(plan_idx).actions_size(); action_idx++) {
       const pb::SingleAction& action =
           desc.Plan.plan(plan_idx).actions(action_idx);
-      if (action.has_extract_ozz_skeleton()) {
+      if (action.has_extract_ozz_skeleton() &&
+          needed_skeletons.count(
+              action.extract_ozz_skeleton().skeleton_igasset_name()) > 0) {
         if (!assimp_animation_processor_.validate_bones_exist(
                 action.extract_ozz_skeleton(), file_cache,
                 assimp_scene_cache)) {
@@ -69,80 +153,68 @@ bool PlanExecutor::execute_plan(const PlanInvocationDesc& desc) {
     }
   }
 
-  for (int plan_idx = 0; plan_idx < desc.Plan.plan_size(); plan_idx++) {
-    const pb::SingleIgpackPlan& plan = desc.Plan.plan(plan_idx);
+  //
+  // Run actions - every action writes into its own asset pack, which are
+  //  merged in plan order afterwards so that output does not depend on which
+  //  action happened to finish first.
+  //
+  uint32_t thread_count = desc.ThreadCount;
+  if (thread_count == 0u) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
 
-    asset::pb::AssetPack out_asset_pack;
+  std::unique_ptr<MeshFormatReport> mesh_report;
+  if (!desc.MeshReportPath.empty()) {
+    mesh_report = std::make_unique<MeshFormatReport>();
+  }
 
-    for (int action_idx = 0; action_idx < plan.actions_size(); action_idx++) {
-      const pb::SingleAction& action = plan.actions(action_idx);
+  std::vector<std::vector<asset::pb::AssetPack>> action_outputs(
+      desc.Plan.plan_size());
+  for (int plan_idx = 0; plan_idx < desc.Plan.plan_size(); plan_idx++) {
+    action_outputs[plan_idx].resize(desc.Plan.plan(plan_idx).actions_size());
+  }
 
-      switch (action.request_case()) {
-        case pb::SingleAction::kCopyWgslSource:
-          if (!copy_wgsl_source(out_asset_pack, action.copy_wgsl_source(),
-                                desc.InputAssetPathRoot, file_cache)) {
-            core::Logger::err(kLogLabel)
-                << "Failed to convert WGSL from source "
-                << action.copy_wgsl_source().input_file_path();
-            return false;
-          }
-          break;
-        case pb::SingleAction::kAssimpToStaticDracoGeo:
-          if (!convert_assimp_file(out_asset_pack,
-                                   action.assimp_to_static_draco_geo(),
-                                   file_cache, assimp_scene_cache)) {
-            core::Logger::err(kLogLabel)
-                << "Failed to convert Assimp from source "
-                << action.assimp_to_static_draco_geo().input_file_path();
-            return false;
-          }
-          break;
-        case pb::SingleAction::kAssembleNavmesh:
-          if (!assemble_navmesh(out_asset_pack, action.assemble_navmesh(),
-                                file_cache, assimp_scene_cache)) {
-            core::Logger::err(kLogLabel) << "Failed to assemble navmesh";
-            return false;
-          }
-          break;
-        case pb::SingleAction::kExtractSkinnedDracoGeo:
-          if (!convert_skinned_assimp_file(out_asset_pack,
-                                           action.extract_skinned_draco_geo(),
-                                           file_cache, assimp_scene_cache)) {
-            core::Logger::err(kLogLabel)
-                << "Failed to extract skinned mesh from Assimp source "
-                << action.assimp_to_static_draco_geo().input_file_path();
-            return false;
-          }
-          break;
-        case pb::SingleAction::kExtractOzzAnimation:
-          if (!create_and_export_animation(out_asset_pack,
-                                           action.extract_ozz_animation(),
-                                           file_cache, assimp_scene_cache)) {
-            core::Logger::err(kLogLabel)
-                << "Failed to extract Ozz animation "
-                << action.extract_ozz_animation().animation_igasset_name()
-                << " from Assimp source";
-            return false;
-          }
-          break;
-        case pb::SingleAction::kExtractOzzSkeleton:
-          if (!create_and_export_skeleton(out_asset_pack,
-                                          action.extract_ozz_skeleton(),
-                                          file_cache, assimp_scene_cache)) {
-            core::Logger::err(kLogLabel)
-                << "Failed to extract Ozz skeleton "
-                << action.extract_ozz_skeleton().skeleton_igasset_name()
-                << " from Assimp source";
-            return false;
-          }
-          break;
-        default:
-          core::Logger::err(kLogLabel)
-              << "Warning - plan " << plan_idx << ", action " << action_idx
-              << " is an unrecognized type";
-          return false;
+  // Skeletons first - animations read the built skeletons during export
+  std::vector<std::function<bool()>> skeleton_jobs;
+  std::vector<std::function<bool()>> jobs;
+  for (int plan_idx = 0; plan_idx < desc.Plan.plan_size(); plan_idx++) {
+    for (int action_idx = 0;
+         action_idx < desc.Plan.plan(plan_idx).actions_size(); action_idx++) {
+      const pb::SingleAction& action =
+          desc.Plan.plan(plan_idx).actions(action_idx);
+      asset::pb::AssetPack* out = &action_outputs[plan_idx][action_idx];
+      auto job = [this, out, &action, &desc, &file_cache, &assimp_scene_cache,
+                  report = mesh_report.get()]() {
+        return run_action(*out, action, desc, file_cache, assimp_scene_cache,
+                          report);
+      };
+
+      if (action.has_extract_ozz_skeleton()) {
+        if (needed_skeletons.count(
+                action.extract_ozz_skeleton().skeleton_igasset_name()) > 0) {
+          skeleton_jobs.push_back(std::move(job));
+        }
+      } else if (is_dirty[plan_idx]) {
+        jobs.push_back(std::move(job));
       }
     }
+  }
+
+  if (!run_jobs(skeleton_jobs, thread_count) || !run_jobs(jobs, thread_count)) {
+    return false;
+  }
+
+  for (int plan_idx = 0; plan_idx < desc.Plan.plan_size(); plan_idx++) {
+    if (!is_dirty[plan_idx]) {
+      continue;
+    }
+
+    const pb::SingleIgpackPlan& plan = desc.Plan.plan(plan_idx);
+
+    asset::pb::AssetPack out_asset_pack;
+    for (const asset::pb::AssetPack& action_output : action_outputs[plan_idx]) {
+      out_asset_pack.MergeFrom(action_output);
+    }
 
     std::string pack_bin = out_asset_pack.SerializeAsString();
     if (pack_bin.size() == 0) {
@@ -168,8 +240,283 @@ bool PlanExecutor::execute_plan(const PlanInvocationDesc& desc) {
           << desc.OutputAssetPathRoot / plan.asset_pack_file_path();
       return false;
     }
+
+    // Indexed copy of the same pack, for loaders that can map it and read
+    //  single assets (see igasset/indexed_igpack.h)
+    std::string indexed_bin = asset::IndexedIgpack::Serialize(out_asset_pack);
+    std::string indexed_path =
+        asset::IndexedIgpack::IndexedPathFor(out_path.string());
+    std::ofstream indexed_fout(indexed_path, std::fstream::binary);
+    if (!indexed_fout.write(&indexed_bin[0], indexed_bin.size())) {
+      core::Logger::err(kLogLabel)
+          << "Failed to write indexed pack for plan "
+          << plan.asset_pack_file_path() << " to file path " << indexed_path;
+      return false;
+    }
+
+    manifest.set(plan.asset_pack_file_path(), plan_hashes[plan_idx]);
+  }
+
+  if (mesh_report && !mesh_report->write_csv(desc.MeshReportPath)) {
+    core::Logger::err(kLogLabel)
+        << "Failed to write mesh format report " << desc.MeshReportPath;
+  }
+
+  if (!desc.ManifestPath.empty() && !manifest.save(desc.ManifestPath)) {
+    // Not fatal - the packs themselves are fine, they'll just rebuild next time
+    core::Logger::err(kLogLabel)
+        << "Failed to write build manifest " << desc.ManifestPath;
   }
 
+  core::Logger::log(kLogLabel)
+      << "Built " << dirty_count << " asset packs ("
+      << desc.Plan.plan_size() - dirty_count << " up to date) on "
+      << thread_count << " threads in " << elapsed_seconds() << "s";
+
+  return true;
+}
+
+uint64_t PlanExecutor::plan_content_hash(
+    const pb::IgpackGenPlan& plan_file, int plan_idx, FileCache& file_cache,
+    std::map<std::string, uint64_t>& file_hashes) {
+  auto hash_file = [&file_cache,
+                    &file_hashes](const std::string& file_name) -> uint64_t {
+    auto it = file_hashes.find(file_name);
+    if (it != file_hashes.end()) {
+      return it->second;
+    }
+
+    uint64_t hash =
+        ContentHasher().add(*file_cache.load_file(file_name)).digest();
+    file_hashes.emplace(file_name, hash);
+    return hash;
+  };
+
+  auto add_action = [&hash_file](ContentHasher& hasher,
+                                 const pb::SingleAction& action) {
+    hasher.add(action.SerializeAsString());
+
+    std::vector<std::string> input_files;
+    switch (action.request_case()) {
+      case pb::SingleAction::kCopyWgslSource:
+        input_files.push_back(action.copy_wgsl_source().input_file_path());
+        break;
+      case pb::SingleAction::kAssimpToStaticDracoGeo:
+        input_files.push_back(
+            action.assimp_to_static_draco_geo().input_file_path());
+        break;
+      case pb::SingleAction::kAssimpToTerrainChunks:
+        input_files.push_back(
+            action.assimp_to_terrain_chunks().input_file_path());
+        break;
+      case pb::SingleAction::kAssembleNavmesh:
+        for (const auto& op : action.assemble_navmesh().recast_build_ops()) {
+          if (op.has_include_assimp_geo()) {
+            input_files.push_back(op.include_assimp_geo().assimp_file_name());
+          } else if (op.has_exclude_assimp_geo()) {
+            input_files.push_back(op.exclude_assimp_geo().assimp_file_name());
+          }
+        }
+        break;
+      case pb::SingleAction::kExtractOzzAnimation:
+        input_files.push_back(action.extract_ozz_animation().input_file_path());
+        break;
+      case pb::SingleAction::kExtractOzzSkeleton:
+        input_files.push_back(action.extract_ozz_skeleton().input_file_path());
+        break;
+      case pb::SingleAction::kExtractSkinnedDracoGeo:
+        input_files.push_back(
+            action.extract_skinned_draco_geo().input_file_path());
+        break;
+      case pb::SingleAction::kConvertTexture:
+        input_files.push_back(action.convert_texture().input_file_path());
+        break;
+      default:
+        break;
+    }
+
+    for (const std::string& input_file : input_files) {
+      hasher.add(input_file).add(hash_file(input_file));
+    }
+  };
+
+  ContentHasher hasher;
+  hasher.add(kManifestVersion);
+
+  const pb::SingleIgpackPlan& plan = plan_file.plan(plan_idx);
+  std::set<std::string> skeleton_names;
+  for (const pb::SingleAction& action : plan.actions()) {
+    add_action(hasher, action);
+
+    if (action.has_extract_ozz_skeleton()) {
+      skeleton_names.insert(
+          action.extract_ozz_skeleton().skeleton_igasset_name());
+    } else if (action.has_extract_ozz_animation()) {
+      skeleton_names.insert(
+          action.extract_ozz_animation().skeleton_igasset_name());
+    }
+  }
+
+  // Skeleton bone sets are decided by every animation that uses the skeleton,
+  //  and animations are built against the skeleton - both can live in any pack
+  for (const std::string& skeleton_name : skeleton_names) {
+    hasher.add(skeleton_name);
+    for (const pb::SingleIgpackPlan& other_plan : plan_file.plan()) {
+      for (const pb::SingleAction& action : other_plan.actions()) {
+        if ((action.has_extract_ozz_skeleton() &&
+             action.extract_ozz_skeleton().skeleton_igasset_name() ==
+                 skeleton_name) ||
+            (action.has_extract_ozz_animation() &&
+             action.extract_ozz_animation().skeleton_igasset_name() ==
+                 skeleton_name)) {
+          add_action(hasher, action);
+        }
+      }
+    }
+  }
+
+  return hasher.digest();
+}
+
+bool PlanExecutor::run_action(asset::pb::AssetPack& out_asset_pack,
+                              const pb::SingleAction& action,
+                              const PlanInvocationDesc& desc,
+                              FileCache& file_cache,
+                              AssimpSceneCache& assimp_scene_cache,
+                              MeshFormatReport* mesh_report) {
+  switch (action.request_case()) {
+    case pb::SingleAction::kCopyWgslSource:
+      if (!copy_wgsl_source(out_asset_pack, action.copy_wgsl_source(),
+                            desc.InputAssetPathRoot, file_cache)) {
+        core::Logger::err(kLogLabel)
+            << "Failed to convert WGSL from source "
+            << action.copy_wgsl_source().input_file_path();
+        return false;
+      }
+      return true;
+    case pb::SingleAction::kAssimpToStaticDracoGeo:
+      if (!convert_assimp_file(out_asset_pack,
+                               action.assimp_to_static_draco_geo(), file_cache,
+                               assimp_scene_cache, mesh_report)) {
+        core::Logger::err(kLogLabel)
+            << "Failed to convert Assimp from source "
+            << action.assimp_to_static_draco_geo().input_file_path();
+        return false;
+      }
+      return true;
+    case pb::SingleAction::kAssimpToTerrainChunks:
+      if (!convert_terrain_chunks(out_asset_pack,
+                                  action.assimp_to_terrain_chunks(),
+                                  file_cache, assimp_scene_cache,
+                                  mesh_report)) {
+        core::Logger::err(kLogLabel)
+            << "Failed to chunk terrain from source "
+            << action.assimp_to_terrain_chunks().input_file_path();
+        return false;
+      }
+      return true;
+    case pb::SingleAction::kAssembleNavmesh:
+      if (!assemble_navmesh(out_asset_pack, action.assemble_navmesh(),
+                            file_cache, assimp_scene_cache)) {
+        core::Logger::err(kLogLabel) << "Failed to assemble navmesh";
+        return false;
+      }
+      return true;
+    case pb::SingleAction::kExtractSkinnedDracoGeo:
+      if (!convert_skinned_assimp_file(
+              out_asset_pack, action.extract_skinned_draco_geo(), file_cache,
+              assimp_scene_cache, mesh_report)) {
+        core::Logger::err(kLogLabel)
+            << "Failed to extract skinned mesh from Assimp source "
+            << action.extract_skinned_draco_geo().input_file_path();
+        return false;
+      }
+      return true;
+    case pb::SingleAction::kExtractOzzAnimation:
+      if (!create_and_export_animation(out_asset_pack,
+                                       action.extract_ozz_animation(),
+                                       file_cache, assimp_scene_cache)) {
+        core::Logger::err(kLogLabel)
+            << "Failed to extract Ozz animation "
+            << action.extract_ozz_animation().animation_igasset_name()
+            << " from Assimp source";
+        return false;
+      }
+      return true;
+    case pb::SingleAction::kExtractOzzSkeleton:
+      if (!create_and_export_skeleton(out_asset_pack,
+                                      action.extract_ozz_skeleton(),
+                                      file_cache, assimp_scene_cache)) {
+        core::Logger::err(kLogLabel)
+            << "Failed to extract Ozz skeleton "
+            << action.extract_ozz_skeleton().skeleton_igasset_name()
+            << " from Assimp source";
+        return false;
+      }
+      return true;
+    case pb::SingleAction::kConvertTexture:
+      if (!convert_texture(out_asset_pack, action.convert_texture(),
+                           file_cache)) {
+        core::Logger::err(kLogLabel)
+            << "Failed to convert texture from source "
+            << action.convert_texture().input_file_path();
+        return false;
+      }
+      return true;
+    default:
+      core::Logger::err(kLogLabel)
+          << "Warning - action is an unrecognized type";
+      return false;
+  }
+}
+
+bool PlanExecutor::run_jobs(const std::vector<std::function<bool()>>& jobs,
+                            uint32_t thread_count) {
+#ifdef IG_ENABLE_THREADS
+  if (thread_count > 1u && jobs.size() > 1u) {
+    std::atomic_bool all_succeeded(true);
+    std::atomic_size_t remaining(jobs.size());
+
+    auto task_list = std::make_shared<core::TaskList>();
+    for (const auto& job : jobs) {
+      task_list->add_task(
+          core::Task::of([&job, &all_succeeded, &remaining]() {
+            if (all_succeeded && !job()) {
+              all_succeeded = false;
+            }
+            remaining--;
+          }));
+    }
+
+    core::Vector<std::shared_ptr<core::ExecutorThread>> executor_threads;
+    uint32_t worker_count =
+        std::min<uint32_t>(thread_count, static_cast<uint32_t>(jobs.size()));
+    for (uint32_t i = 1; i < worker_count; i++) {
+      auto executor = std::make_shared<core::ExecutorThread>();
+      executor->add_task_list(task_list);
+      executor_threads.push_back(executor);
+    }
+
+    // The calling thread works too, instead of just waiting on the others
+    while (remaining > 0u) {
+      if (!task_list->execute_next()) {
+        std::this_thread::yield();
+      }
+    }
+
+    for (int i = 0; i < executor_threads.size(); i++) {
+      executor_threads[i]->clear_all_task_lists();
+    }
+
+    return all_succeeded;
+  }
+#endif
+
+  for (const auto& job : jobs) {
+    if (!job()) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -200,6 +547,16 @@ bool PlanExecutor::validate_inputs_exist(
           return false;
         }
         break;
+      case pb::SingleAction::kAssimpToTerrainChunks:
+        if (!peek_file(input_root,
+                       action.assimp_to_terrain_chunks().input_file_path())) {
+          core::Logger::err(kLogLabel)
+              << "Assimp file not found: "
+              << input_root /
+                     action.assimp_to_terrain_chunks().input_file_path();
+          return false;
+        }
+        break;
       case pb::SingleAction::kAssembleNavmesh:
         for (const auto& op : action.assemble_navmesh().recast_build_ops()) {
           if (op.has_include_assimp_geo() &&
@@ -242,6 +599,15 @@ bool PlanExecutor::validate_inputs_exist(
           return false;
         }
         break;
+      case pb::SingleAction::kConvertTexture:
+        if (!peek_file(input_root,
+                       action.convert_texture().input_file_path())) {
+          core::Logger::err(kLogLabel)
+              << "Texture file not found: "
+              << input_root / action.convert_texture().input_file_path();
+          return false;
+        }
+        break;
       default:
         core::Logger::err(kLogLabel)
             << "Unexpected request_case for validate_inputs_exist";
@@ -263,23 +629,39 @@ bool PlanExecutor::copy_wgsl_source(asset::pb::AssetPack& output_asset_pack,
                                     FileCache& file_cache) {
   return wgsl_processor_.copy_wgsl_source(
       output_asset_pack, action,
-      file_cache.load_file(action.input_file_path()));
+      *file_cache.load_file(action.input_file_path()));
 }
 
 bool PlanExecutor::convert_assimp_file(
     asset::pb::AssetPack& output_asset_pack,
     const pb::AssimpToStaticDracoGeoAction& action, FileCache& file_cache,
-    AssimpSceneCache& assimp_scene_cache) {
+    AssimpSceneCache& assimp_scene_cache, MeshFormatReport* mesh_report) {
   return assimp_geo_processor_.export_static_draco_geo(
-      output_asset_pack, action, file_cache, assimp_scene_cache);
+      output_asset_pack, action, file_cache, assimp_scene_cache, mesh_report);
+}
+
+bool PlanExecutor::convert_terrain_chunks(
+    asset::pb::AssetPack& output_asset_pack,
+    const pb::AssimpToTerrainChunksAction& action, FileCache& file_cache,
+    AssimpSceneCache& assimp_scene_cache, MeshFormatReport* mesh_report) {
+  return assimp_geo_processor_.export_terrain_chunks(
+      output_asset_pack, action, file_cache, assimp_scene_cache, mesh_report);
 }
 
 bool PlanExecutor::convert_skinned_assimp_file(
     asset::pb::AssetPack& output_asset_pack,
     const pb::AssimpExtractSkinnedMeshToDraco& action, FileCache& file_cache,
-    AssimpSceneCache& assimp_scene_cache) {
+    AssimpSceneCache& assimp_scene_cache, MeshFormatReport* mesh_report) {
   return assimp_geo_processor_.export_skinned_draco_geo(
-      output_asset_pack, action, file_cache, assimp_scene_cache);
+      output_asset_pack, action, file_cache, assimp_scene_cache, mesh_report);
+}
+
+bool PlanExecutor::convert_texture(asset::pb::AssetPack& output_asset_pack,
+                                   const pb::ConvertTextureAction& action,
+                                   FileCache& file_cache) {
+  return texture_processor_.convert_texture(
+      output_asset_pack, action,
+      *file_cache.load_file(action.input_file_path()));
 }
 
 bool PlanExecutor::assemble_navmesh(
@@ -4,15 +4,21 @@
 #include <converters/assimp_animation_processor.h>
 #include <converters/assimp_geo_processor.h>
 #include <converters/recast_navmesh_processor.h>
+#include <converters/texture_processor.h>
 #include <converters/wgsl_processor.h>
 #include <igasset/proto/igasset.pb.h>
 #include <igpack-gen/proto/igpack-plan.pb.h>
 #include <util/assimp_scene_cache.h>
 #include <util/file_cache.h>
+#include <util/mesh_format_report.h>
+#include <util/plan_manifest.h>
 
 #include <filesystem>
+#include <functional>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace indigo::igpackgen {
 
@@ -20,6 +26,21 @@ struct PlanInvocationDesc {
   pb::IgpackGenPlan Plan;
   std::filesystem::path InputAssetPathRoot;
   std::filesystem::path OutputAssetPathRoot;
+
+  // Manifest of the content hashes each asset pack was last built from. Asset
+  //  packs whose hash is unchanged (and whose output file still exists) are
+  //  skipped. Leave empty to rebuild every asset pack.
+  std::filesystem::path ManifestPath;
+
+  // Number of threads used to run actions (0: one per hardware thread)
+  uint32_t ThreadCount;
+
+  // Rebuild every asset pack, even if the manifest says it is up to date
+  bool ForceRebuild;
+
+  // If set, write a CSV comparing the size and decode time of every mesh in
+  //  the rebuilt packs as Draco and as a pre-baked RawMeshDef
+  std::filesystem::path MeshReportPath;
 };
 
 class PlanExecutor {
@@ -33,6 +54,30 @@ class PlanExecutor {
                              const pb::SingleIgpackPlan& plan) const;
   bool peek_file(std::filesystem::path input_root, std::string file_name) const;
 
+  /**
+   * Hash of everything that goes into building a plan's asset pack - the plan
+   *  actions, the contents of their input files, and any skeleton actions (or
+   *  animations affecting skeleton bones) elsewhere in the plan file that the
+   *  pack's skeletons and animations depend on.
+   */
+  uint64_t plan_content_hash(const pb::IgpackGenPlan& plan_file, int plan_idx,
+                             FileCache& file_cache,
+                             std::map<std::string, uint64_t>& file_hashes);
+
+  /** Run a single action, appending the assets it produces to the pack */
+  bool run_action(asset::pb::AssetPack& output_asset_pack,
+                  const pb::SingleAction& action,
+                  const PlanInvocationDesc& desc, FileCache& file_cache,
+                  AssimpSceneCache& assimp_scene_cache,
+                  MeshFormatReport* mesh_report);
+
+  /**
+   * Run jobs on "thread_count" threads (including the calling thread), return
+   *  false if any job fails. Jobs not yet started when a job fails are skipped.
+   */
+  static bool run_jobs(const std::vector<std::function<bool()>>& jobs,
+                       uint32_t thread_count);
+
  private:
   bool copy_wgsl_source(asset::pb::AssetPack& output_asset_pack,
                         const pb::CopyWgslSourceAction& action,
@@ -42,11 +87,20 @@ class PlanExecutor {
   bool convert_assimp_file(asset::pb::AssetPack& output_asset_pack,
                            const pb::AssimpToStaticDracoGeoAction& action,
                            FileCache& file_cache,
-                           AssimpSceneCache& assimp_scene_cache);
+                           AssimpSceneCache& assimp_scene_cache,
+                           MeshFormatReport* mesh_report);
+  bool convert_terrain_chunks(asset::pb::AssetPack& output_asset_pack,
+                              const pb::AssimpToTerrainChunksAction& action,
+                              FileCache& file_cache,
+                              AssimpSceneCache& assimp_scene_cache,
+                              MeshFormatReport* mesh_report);
   bool convert_skinned_assimp_file(
       asset::pb::AssetPack& output_asset_pack,
       const pb::AssimpExtractSkinnedMeshToDraco& action, FileCache& file_cache,
-      AssimpSceneCache& assimp_scene_cache);
+      AssimpSceneCache& assimp_scene_cache, MeshFormatReport* mesh_report);
+  bool convert_texture(asset::pb::AssetPack& output_asset_pack,
+                       const pb::ConvertTextureAction& action,
+                       FileCache& file_cache);
   bool assemble_navmesh(asset::pb::AssetPack& output_asset_pack,
                         const pb::AssembleRecastNavMeshAction& action,
                         FileCache& file_cache,
@@ -68,6 +122,7 @@ class PlanExecutor {
   AssimpGeoProcessor assimp_geo_processor_;
   AssimpAnimationProcessor assimp_animation_processor_;
   RecastNavmeshProcessor recast_navmesh_processor_;
+  TextureProcessor texture_processor_;
 };
 }  // namespace indigo::igpackgen
 
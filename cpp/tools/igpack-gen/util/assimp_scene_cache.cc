@@ -1,6 +1,8 @@
 #include <igcore/log.h>
 #include <util/assimp_scene_cache.h>
 
+#include <algorithm>
+
 using namespace indigo;
 using namespace igpackgen;
 
@@ -13,73 +15,118 @@ AssimpSceneData::AssimpSceneData() : Importer(nullptr), Scene(nullptr) {}
 AssimpSceneCache::AssimpSceneCache(uint32_t max_cache_size)
     : max_cache_size_(max_cache_size), cache_size_(0u) {}
 
-core::Maybe<AssimpSceneData*> AssimpSceneCache::load_scene(
+core::Maybe<std::shared_ptr<AssimpSceneData>> AssimpSceneCache::load_scene(
     FileCache& file_cache, std::string file_name) {
-  const std::string& raw_data = file_cache.load_file(file_name);
-
-  if (raw_data.size() == 0u) {
-    core::Logger::err(kLogLabel) << "Failed to load read file at " << file_name;
-    return core::Maybe<AssimpSceneData*>::empty();
+  SceneFuture scene_future;
+  std::promise<std::shared_ptr<AssimpSceneData>> scene_promise;
+  bool is_importer = false;
+
+  {
+    std::lock_guard<std::mutex> l(mut_);
+    auto existing_it = loaded_scenes_.find(file_name);
+    if (existing_it != loaded_scenes_.end()) {
+      auto order_it =
+          std::find(load_order_.begin(), load_order_.end(), file_name);
+      if (order_it != load_order_.end()) {
+        load_order_.erase(order_it);
+      }
+      load_order_.push_back(file_name);
+      scene_future = existing_it->second;
+    } else {
+      is_importer = true;
+      scene_future = scene_promise.get_future().share();
+      loaded_scenes_.emplace(file_name, scene_future);
+      load_order_.push_back(file_name);
+    }
   }
 
-  if (loaded_scenes_.count(file_name) > 0) {
-    auto existing_it =
-        std::find(load_order_.begin(), load_order_.end(), file_name);
-    if (existing_it != load_order_.end()) {
-      load_order_.erase(existing_it);
+  if (!is_importer) {
+    auto scene = scene_future.get();
+    if (scene == nullptr) {
+      return core::Maybe<std::shared_ptr<AssimpSceneData>>::empty();
     }
-    load_order_.push_back(file_name);
-    return &loaded_scenes_[file_name];
+    return scene;
   }
 
-  AssimpSceneData data;
-  data.Importer = std::make_shared<Assimp::Importer>();
-  data.Importer->SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, 4);
-  const uint32_t import_flags =
-      aiProcessPreset_TargetRealtime_Quality | aiProcess_FlipUVs;
+  auto scene = import_scene(file_cache, file_name);
+  scene_promise.set_value(scene);
 
-  data.Scene = data.Importer->ReadFileFromMemory(&raw_data[0], raw_data.size(),
-                                                 import_flags);
-  if (!data.Scene) {
-    core::Logger::err(kLogLabel) << "Failed to parse Assimp file (" << file_name
-                                 << "): " << data.Importer->GetErrorString();
-    return core::Maybe<AssimpSceneData*>::empty();
+  std::lock_guard<std::mutex> l(mut_);
+  if (scene == nullptr) {
+    // Leave failed imports out of the cache - waiters already have the result
+    loaded_scenes_.erase(file_name);
+    load_order_.remove(file_name);
+    return core::Maybe<std::shared_ptr<AssimpSceneData>>::empty();
   }
 
   aiMemoryInfo memory_usage;
-  data.Importer->GetMemoryRequirements(memory_usage);
+  scene->Importer->GetMemoryRequirements(memory_usage);
 
+  size_t eviction_candidates = load_order_.size();
   while ((cache_size_ + memory_usage.total) > max_cache_size_ &&
-         loaded_scenes_.size() > 0) {
+         eviction_candidates-- > 0u) {
     std::string file_to_delete = *load_order_.begin();
     load_order_.pop_front();
+    if (file_to_delete == file_name) {
+      load_order_.push_back(file_to_delete);
+      continue;
+    }
 
-    auto scene_it = loaded_scenes_.find(file_to_delete);
-    if (scene_it != loaded_scenes_.end()) {
-      aiMemoryInfo deleted_memory_usage;
-      scene_it->second.Importer->GetMemoryRequirements(deleted_memory_usage);
-      cache_size_ -= deleted_memory_usage.total;
-      loaded_scenes_.erase(scene_it);
+    // Scenes still being imported have no recorded size yet - they are put
+    //  back at the end of the line instead of being evicted
+    auto size_it = scene_sizes_.find(file_to_delete);
+    if (size_it == scene_sizes_.end()) {
+      load_order_.push_back(file_to_delete);
+      continue;
     }
+
+    cache_size_ -= size_it->second;
+    scene_sizes_.erase(size_it);
+    loaded_scenes_.erase(file_to_delete);
   }
 
-  load_order_.push_front(file_name);
-  loaded_scenes_.emplace(file_name, std::move(data));
+  scene_sizes_[file_name] = memory_usage.total;
   cache_size_ += memory_usage.total;
 
-  return &loaded_scenes_[file_name];
+  return scene;
+}
+
+std::shared_ptr<AssimpSceneData> AssimpSceneCache::import_scene(
+    FileCache& file_cache, const std::string& file_name) {
+  auto raw_data = file_cache.load_file(file_name);
+
+  if (raw_data->size() == 0u) {
+    core::Logger::err(kLogLabel) << "Failed to load read file at " << file_name;
+    return nullptr;
+  }
+
+  auto data = std::make_shared<AssimpSceneData>();
+  data->Importer = std::make_shared<Assimp::Importer>();
+  data->Importer->SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, 4);
+  const uint32_t import_flags =
+      aiProcessPreset_TargetRealtime_Quality | aiProcess_FlipUVs;
+
+  data->Scene = data->Importer->ReadFileFromMemory(
+      &(*raw_data)[0], raw_data->size(), import_flags);
+  if (!data->Scene) {
+    core::Logger::err(kLogLabel) << "Failed to parse Assimp file (" << file_name
+                                 << "): " << data->Importer->GetErrorString();
+    return nullptr;
+  }
+
+  return data;
 }
 
-core::Maybe<aiMesh*> AssimpSceneCache::load_mesh(FileCache& file_cache,
-                                                 std::string assimp_file_path,
-                                                 std::string mesh_name) {
-  core::Maybe<AssimpSceneData*> maybe_data =
+core::Maybe<AssimpMeshRef> AssimpSceneCache::load_mesh(
+    FileCache& file_cache, std::string assimp_file_path,
+    std::string mesh_name) {
+  core::Maybe<std::shared_ptr<AssimpSceneData>> maybe_data =
       load_scene(file_cache, assimp_file_path);
 
   if (maybe_data.is_empty()) {
     core::Logger::err(kLogLabel)
         << "No Assimp scene found at " << assimp_file_path;
-    return core::Maybe<aiMesh*>::empty();
+    return core::Maybe<AssimpMeshRef>::empty();
   }
 
   const aiScene* scene = maybe_data.get()->Scene;
@@ -94,12 +141,12 @@ core::Maybe<aiMesh*> AssimpSceneCache::load_mesh(FileCache& file_cache,
     }
 
     if (mesh->mName.C_Str() == mesh_name) {
-      return core::Maybe<aiMesh*>(mesh);
+      return AssimpMeshRef{maybe_data.get(), mesh};
     }
   }
 
   core::Logger::err(kLogLabel)
       << "Mesh " << mesh_name << " not found in Assimp file "
       << assimp_file_path;
-  return core::Maybe<aiMesh*>::empty();
-}
\ No newline at end of file
+  return core::Maybe<AssimpMeshRef>::empty();
+}
@@ -7,7 +7,10 @@
 #include <util/file_cache.h>
 
 #include <assimp/Importer.hpp>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
 
 namespace indigo::igpackgen {
 
@@ -18,21 +21,42 @@ struct AssimpSceneData {
   AssimpSceneData();
 };
 
+/** Mesh inside of a cached scene - keeps the scene alive while held */
+struct AssimpMeshRef {
+  std::shared_ptr<AssimpSceneData> SceneData;
+  aiMesh* Mesh;
+};
+
+/**
+ * Thread-safe, size-bounded cache of imported Assimp scenes.
+ *
+ * Concurrent requests for a scene that is still importing wait on the first
+ *  import instead of importing the file again. Scenes are reference counted,
+ *  so eviction never frees a scene that an action is still reading.
+ */
 class AssimpSceneCache {
  public:
   AssimpSceneCache(uint32_t max_cache_size);
 
-  core::Maybe<AssimpSceneData*> load_scene(FileCache& file_cache,
-                                           std::string assimp_file_path);
+  core::Maybe<std::shared_ptr<AssimpSceneData>> load_scene(
+      FileCache& file_cache, std::string assimp_file_path);
 
-  core::Maybe<aiMesh*> load_mesh(FileCache& file_cache,
-                                 std::string assimp_file_path,
-                                 std::string mesh_name);
+  core::Maybe<AssimpMeshRef> load_mesh(FileCache& file_cache,
+                                       std::string assimp_file_path,
+                                       std::string mesh_name);
 
  private:
+  using SceneFuture = std::shared_future<std::shared_ptr<AssimpSceneData>>;
+
+  std::shared_ptr<AssimpSceneData> import_scene(FileCache& file_cache,
+                                                const std::string& file_name);
+
   uint32_t max_cache_size_;
   uint32_t cache_size_;
-  std::map<std::string, AssimpSceneData> loaded_scenes_;
+
+  std::mutex mut_;
+  std::map<std::string, SceneFuture> loaded_scenes_;
+  std::map<std::string, uint32_t> scene_sizes_;
   std::list<std::string> load_order_;
 };
 
@@ -16,50 +16,66 @@ FileCache::FileCache(std::filesystem::path input_root_path,
     : input_root_path_(input_root_path),
       max_cache_size_(max_cache_size),
       cache_size_(0u),
-      empty_string_("") {}
+      empty_string_(std::make_shared<const std::string>("")) {}
 
-const std::string& FileCache::load_file(std::string relative_path) {
-  if (!std::filesystem::exists(input_root_path_ / relative_path)) {
-    return empty_string_;
+std::shared_ptr<const std::string> FileCache::load_file(
+    std::string relative_path) {
+  {
+    std::lock_guard<std::mutex> l(mut_);
+    auto cached_it = raw_file_contents_.find(relative_path);
+    if (cached_it != raw_file_contents_.end()) {
+      auto existing_it = std::find(file_load_order_.begin(),
+                                   file_load_order_.end(), relative_path);
+      if (existing_it != file_load_order_.end()) {
+        file_load_order_.erase(existing_it);
+      }
+      file_load_order_.push_back(relative_path);
+      return cached_it->second;
+    }
   }
 
-  if (raw_file_contents_.count(relative_path) > 0) {
-    auto existing_it = std::find(file_load_order_.begin(),
-                                 file_load_order_.end(), relative_path);
-    if (existing_it != file_load_order_.end()) {
-      file_load_order_.erase(existing_it);
-    }
-    file_load_order_.push_back(relative_path);
-    return raw_file_contents_[relative_path];
+  if (!std::filesystem::exists(input_root_path_ / relative_path)) {
+    return empty_string_;
   }
 
+  // Read outside of the lock, so that actions reading different files do not
+  //  wait on each other. Two actions racing on the same file both read it, and
+  //  the first one to finish wins the cache slot.
   std::ifstream fin(input_root_path_ / relative_path, std::fstream::binary);
   fin.seekg(0, std::ios::end);
   uint32_t file_size = (uint32_t)fin.tellg();
   fin.seekg(0, std::ios::beg);
 
+  std::string file_data;
+  file_data.resize(file_size);
+  if (!fin.read(reinterpret_cast<char*>(&file_data[0]), file_size)) {
+    core::Logger::err(kLogLabel)
+        << "load_file failed for " << input_root_path_ / relative_path
+        << " - file could not be read";
+    return empty_string_;
+  }
+
+  auto contents = std::make_shared<const std::string>(std::move(file_data));
+
+  std::lock_guard<std::mutex> l(mut_);
+  auto cached_it = raw_file_contents_.find(relative_path);
+  if (cached_it != raw_file_contents_.end()) {
+    return cached_it->second;
+  }
+
   while ((cache_size_ + file_size > max_cache_size_) &&
          raw_file_contents_.size() > 0) {
     std::string file_to_delete = *file_load_order_.begin();
     file_load_order_.pop_front();
     auto file_contents_it = raw_file_contents_.find(file_to_delete);
     if (file_contents_it != raw_file_contents_.end()) {
-      cache_size_ -= file_contents_it->second.size();
+      cache_size_ -= file_contents_it->second->size();
       raw_file_contents_.erase(file_contents_it);
     }
   }
 
-  std::string file_data;
-  file_data.resize(file_size);
-  if (!fin.read(reinterpret_cast<char*>(&file_data[0]), file_size)) {
-    core::Logger::err(kLogLabel)
-        << "load_file failed for " << input_root_path_ / relative_path
-        << " - file could not be read";
-    return empty_string_;
-  }
-
   file_load_order_.push_back(relative_path);
-  cache_size_ += file_data.size();
-  raw_file_contents_.emplace(relative_path, std::move(file_data));
-  return raw_file_contents_[relative_path];
-}
\ No newline at end of file
+  cache_size_ += contents->size();
+  raw_file_contents_.emplace(relative_path, contents);
+  return contents;
+}
@@ -4,14 +4,24 @@
 #include <filesystem>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace indigo::igpackgen {
 
+/**
+ * Thread-safe, size-bounded cache of raw input file contents.
+ *
+ * Returned contents are reference counted - evicting a file from the cache
+ *  never invalidates contents that another action is still reading.
+ */
 class FileCache {
  public:
   FileCache(std::filesystem::path input_root_path, uint32_t max_cache_size);
-  const std::string& load_file(std::string relative_path);
+
+  /** File contents, or an empty string if the file could not be read */
+  std::shared_ptr<const std::string> load_file(std::string relative_path);
 
  private:
   std::filesystem::path input_root_path_;
@@ -19,9 +29,10 @@ class FileCache {
   uint32_t max_cache_size_;
   uint32_t cache_size_;
 
-  std::map<std::string, std::string> raw_file_contents_;
+  std::mutex mut_;
+  std::map<std::string, std::shared_ptr<const std::string>> raw_file_contents_;
   std::list<std::string> file_load_order_;
-  std::string empty_string_;
+  std::shared_ptr<const std::string> empty_string_;
 };
 
 }  // namespace indigo::igpackgen
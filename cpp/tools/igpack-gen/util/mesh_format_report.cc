@@ -0,0 +1,107 @@
+#include <igasset/draco_decoder.h>
+#include <igasset/raw_mesh.h>
+#include <util/mesh_format_report.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+using namespace indigo;
+using namespace igpackgen;
+
+namespace {
+
+template <typename FnT>
+double best_time_ms(int runs, FnT&& fn) {
+  double best = std::numeric_limits<double>::max();
+  for (int i = 0; i < std::max(runs, 1); i++) {
+    auto start = std::chrono::high_resolution_clock::now();
+    fn();
+    best = std::min(best, std::chrono::duration<double, std::milli>(
+                              std::chrono::high_resolution_clock::now() - start)
+                              .count());
+  }
+  return best;
+}
+
+}  // namespace
+
+void MeshFormatReport::add(Entry entry) {
+  std::lock_guard<std::mutex> l(mut_);
+  entries_.push_back(std::move(entry));
+}
+
+bool MeshFormatReport::write_csv(const std::filesystem::path& path) const {
+  std::vector<Entry> entries;
+  {
+    std::lock_guard<std::mutex> l(mut_);
+    entries = entries_;
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return a.AssetName < b.AssetName;
+            });
+
+  std::ofstream fout(path);
+  fout << "asset,vertices,indices,draco_bytes,draco_decode_ms,raw_bytes,"
+          "raw_uncompressed_bytes,raw_decode_ms\n";
+  for (const Entry& e : entries) {
+    fout << e.AssetName << "," << e.VertexCount << "," << e.IndexCount << ","
+         << e.DracoBytes << "," << e.DracoDecodeMs << "," << e.RawBytes << ","
+         << e.RawUncompressedBytes << "," << e.RawDecodeMs << "\n";
+  }
+
+  return static_cast<bool>(fout);
+}
+
+double MeshFormatReport::time_draco_decode_ms(const std::string& draco_data,
+                                              int runs) {
+  return ::best_time_ms(runs, [&draco_data]() {
+    core::RawBuffer buffer(
+        reinterpret_cast<uint8_t*>(const_cast<char*>(draco_data.data())),
+        draco_data.size(), false);
+
+    asset::DracoDecoder decoder;
+    if (decoder.decode(buffer) != asset::DracoDecoderResult::Ok) {
+      return;
+    }
+
+    std::vector<asset::PositionNormalVertexData> pos_norm(
+        decoder.num_vertices());
+    std::vector<asset::TexcoordVertexData> texcoords(decoder.num_vertices());
+    std::vector<uint32_t> indices(decoder.num_indices());
+    decoder.write_pos_norm_data(pos_norm.data());
+    decoder.write_texcoord_data(texcoords.data());
+    decoder.write_index_data(indices.data());
+  });
+}
+
+double MeshFormatReport::time_raw_decode_ms(
+    const asset::pb::RawMeshDef& raw_mesh_def, int runs) {
+  asset::pb::SingleAsset asset;
+  *asset.mutable_raw_mesh_def() = raw_mesh_def;
+
+  return ::best_time_ms(runs, [&asset]() {
+    auto rsl = asset::RawMesh::Create(std::make_shared<const asset::IgpackAsset>(
+        asset::IgpackAsset::FromProto(asset)));
+    if (rsl.is_right()) {
+      return;
+    }
+
+    // Stands in for the copy into a mapped GPU buffer that Draco decodes into
+    const asset::RawMesh& mesh = *rsl.get_left();
+    std::vector<asset::PositionNormalVertexData> pos_norm(mesh.num_vertices());
+    std::vector<uint32_t> indices(mesh.num_indices());
+    std::memcpy(pos_norm.data(), mesh.pos_norm_data(),
+                pos_norm.size() * sizeof(asset::PositionNormalVertexData));
+    std::memcpy(indices.data(), mesh.index_data(),
+                indices.size() * sizeof(uint32_t));
+    if (mesh.texcoord_data() != nullptr) {
+      std::vector<asset::TexcoordVertexData> texcoords(mesh.num_vertices());
+      std::memcpy(texcoords.data(), mesh.texcoord_data(),
+                  texcoords.size() * sizeof(asset::TexcoordVertexData));
+    }
+  });
+}
@@ -0,0 +1,58 @@
+#ifndef TOOLS_IGPACK_GEN_UTIL_MESH_FORMAT_REPORT_H
+#define TOOLS_IGPACK_GEN_UTIL_MESH_FORMAT_REPORT_H
+
+/**
+ * Size vs. decode time of each mesh igpack-gen writes, in both mesh formats
+ *  (Draco geometry and pre-baked RawMeshDef) regardless of which one the plan
+ *  asked for - to help pick a format per mesh.
+ *
+ * Thread-safe, written out as CSV (one row per mesh, sorted by asset name).
+ */
+
+#include <igasset/proto/igasset.pb.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace indigo::igpackgen {
+
+class MeshFormatReport {
+ public:
+  struct Entry {
+    std::string AssetName;
+    uint32_t VertexCount;
+    uint32_t IndexCount;
+
+    size_t DracoBytes;
+    double DracoDecodeMs;
+
+    size_t RawBytes;
+    size_t RawUncompressedBytes;
+    double RawDecodeMs;
+  };
+
+  void add(Entry entry);
+  bool write_csv(const std::filesystem::path& path) const;
+
+  //
+  // Decode timing - best of "runs" decodes, each one all the way into the
+  //  vertex layouts that get uploaded to the GPU (skinning bone remaps are
+  //  left out of both formats)
+  //
+  static double time_draco_decode_ms(const std::string& draco_data,
+                                     int runs = 3);
+  static double time_raw_decode_ms(const asset::pb::RawMeshDef& raw_mesh_def,
+                                   int runs = 3);
+
+ private:
+  mutable std::mutex mut_;
+  std::vector<Entry> entries_;
+};
+
+}  // namespace indigo::igpackgen
+
+#endif
@@ -0,0 +1,94 @@
+#include <igcore/log.h>
+#include <util/plan_manifest.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace indigo;
+using namespace igpackgen;
+
+namespace {
+const char* kLogLabel = "PlanManifest";
+
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+}  // namespace
+
+ContentHasher::ContentHasher() : hash_(kFnvOffsetBasis) {}
+
+ContentHasher& ContentHasher::add(std::string_view data) {
+  // Length prefix, so that ("ab", "c") and ("a", "bc") hash differently
+  add(static_cast<uint64_t>(data.size()));
+  for (char c : data) {
+    hash_ ^= static_cast<uint8_t>(c);
+    hash_ *= kFnvPrime;
+  }
+  return *this;
+}
+
+ContentHasher& ContentHasher::add(uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    hash_ ^= static_cast<uint8_t>(value >> (i * 8));
+    hash_ *= kFnvPrime;
+  }
+  return *this;
+}
+
+uint64_t ContentHasher::digest() const { return hash_; }
+
+PlanManifest PlanManifest::Load(const std::filesystem::path& manifest_path) {
+  PlanManifest manifest;
+
+  std::ifstream fin(manifest_path);
+  if (!fin) {
+    return manifest;
+  }
+
+  std::string line;
+  while (std::getline(fin, line)) {
+    std::istringstream line_stream(line);
+    uint64_t hash = 0ull;
+    std::string asset_pack_path;
+    if (!(line_stream >> std::hex >> hash) ||
+        !std::getline(line_stream >> std::ws, asset_pack_path) ||
+        asset_pack_path.empty()) {
+      core::Logger::err(kLogLabel)
+          << "Ignoring malformed manifest line in " << manifest_path << ": "
+          << line;
+      continue;
+    }
+    manifest.entries_[asset_pack_path] = hash;
+  }
+
+  return manifest;
+}
+
+bool PlanManifest::save(const std::filesystem::path& manifest_path) const {
+  std::ofstream fout(manifest_path);
+  if (!fout) {
+    core::Logger::err(kLogLabel)
+        << "Failed to open manifest " << manifest_path << " for writing";
+    return false;
+  }
+
+  for (const auto& [asset_pack_path, hash] : entries_) {
+    fout << std::hex << std::setw(16) << std::setfill('0') << hash << " "
+         << asset_pack_path << "\n";
+  }
+
+  return static_cast<bool>(fout);
+}
+
+core::Maybe<uint64_t> PlanManifest::get(
+    const std::string& asset_pack_path) const {
+  auto it = entries_.find(asset_pack_path);
+  if (it == entries_.end()) {
+    return core::Maybe<uint64_t>::empty();
+  }
+  return it->second;
+}
+
+void PlanManifest::set(const std::string& asset_pack_path, uint64_t hash) {
+  entries_[asset_pack_path] = hash;
+}
@@ -0,0 +1,52 @@
+#ifndef TOOLS_IGPACK_GEN_UTIL_PLAN_MANIFEST_H
+#define TOOLS_IGPACK_GEN_UTIL_PLAN_MANIFEST_H
+
+/**
+ * Record of the content hash each asset pack was last built from, used to
+ *  skip rebuilding packs whose inputs and plan actions have not changed.
+ *
+ * Stored as a plain text file next to the generated packs, one
+ *  "<hex hash> <asset pack path>" entry per line.
+ */
+
+#include <igcore/maybe.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace indigo::igpackgen {
+
+/** 64-bit FNV-1a - fast, stable across platforms, not cryptographic */
+class ContentHasher {
+ public:
+  ContentHasher();
+
+  ContentHasher& add(std::string_view data);
+  ContentHasher& add(uint64_t value);
+
+  uint64_t digest() const;
+
+ private:
+  uint64_t hash_;
+};
+
+class PlanManifest {
+ public:
+  /** Missing or unreadable manifests load as empty (everything rebuilds) */
+  static PlanManifest Load(const std::filesystem::path& manifest_path);
+
+  bool save(const std::filesystem::path& manifest_path) const;
+
+  core::Maybe<uint64_t> get(const std::string& asset_pack_path) const;
+  void set(const std::string& asset_pack_path, uint64_t hash);
+
+ private:
+  std::map<std::string, uint64_t> entries_;
+};
+
+}  // namespace indigo::igpackgen
+
+#endif